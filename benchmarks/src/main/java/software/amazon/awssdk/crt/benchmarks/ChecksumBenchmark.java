@@ -0,0 +1,88 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.benchmarks;
+
+import java.nio.ByteBuffer;
+import java.util.Random;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import software.amazon.awssdk.crt.checksums.CRC32;
+import software.amazon.awssdk.crt.checksums.CRC32C;
+
+/**
+ * CRC32 and CRC32C over heap arrays and direct buffers, per buffer size. Small sizes are dominated by the JNI
+ * transition, large ones by the native kernel; java.util.zip.CRC32 is the baseline.
+ *
+ * Scores are checksums per second; multiply by the size for bytes per second.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class ChecksumBenchmark {
+
+    @Param({"64", "1024", "16384", "1048576"})
+    public int size;
+
+    private byte[] data;
+    private ByteBuffer directData;
+
+    @Setup
+    public void setup() {
+        data = new byte[size];
+        new Random(42).nextBytes(data);
+        directData = ByteBuffer.allocateDirect(size);
+        directData.put(data).flip();
+    }
+
+    @Benchmark
+    public long crc32Array() {
+        CRC32 crc = new CRC32();
+        crc.update(data, 0, size);
+        return crc.getValue();
+    }
+
+    @Benchmark
+    public long crc32cArray() {
+        CRC32C crc = new CRC32C();
+        crc.update(data, 0, size);
+        return crc.getValue();
+    }
+
+    @Benchmark
+    public long crc32Direct() {
+        CRC32 crc = new CRC32();
+        crc.update(directData.duplicate());
+        return crc.getValue();
+    }
+
+    @Benchmark
+    public long crc32cDirect() {
+        CRC32C crc = new CRC32C();
+        crc.update(directData.duplicate());
+        return crc.getValue();
+    }
+
+    @Benchmark
+    public long jdkCrc32Array() {
+        java.util.zip.CRC32 crc = new java.util.zip.CRC32();
+        crc.update(data, 0, size);
+        return crc.getValue();
+    }
+}
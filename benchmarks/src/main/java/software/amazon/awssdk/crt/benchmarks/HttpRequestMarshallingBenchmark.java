@@ -0,0 +1,61 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.benchmarks;
+
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import software.amazon.awssdk.crt.http.HttpHeader;
+import software.amazon.awssdk.crt.http.HttpRequest;
+
+/**
+ * Marshalling an HttpRequest into the blob handed to native code on every request, by header count. This is pure
+ * Java, so it measures the cost every HTTP and S3 request pays before reaching JNI.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class HttpRequestMarshallingBenchmark {
+
+    @Param({"4", "16", "64"})
+    public int headerCount;
+
+    private HttpHeader[] headers;
+    private HttpRequest request;
+
+    @Setup
+    public void setup() {
+        headers = new HttpHeader[headerCount];
+        headers[0] = new HttpHeader("Host", "examplebucket.s3.us-west-2.amazonaws.com");
+        for (int i = 1; i < headerCount; i++) {
+            headers[i] = new HttpHeader("x-amz-meta-benchmark-" + i, "value-of-benchmark-header-" + i);
+        }
+        request = new HttpRequest("GET", "/path/to/an/object/key", headers, null);
+    }
+
+    @Benchmark
+    public byte[] marshal() {
+        return request.marshalForJni();
+    }
+
+    @Benchmark
+    public byte[] buildAndMarshal() {
+        return new HttpRequest("GET", "/path/to/an/object/key", headers, null).marshalForJni();
+    }
+}
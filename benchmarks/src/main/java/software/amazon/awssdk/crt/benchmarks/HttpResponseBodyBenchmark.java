@@ -0,0 +1,129 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.benchmarks;
+
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+import software.amazon.awssdk.crt.CrtRuntimeException;
+import software.amazon.awssdk.crt.http.HttpClientConnection;
+import software.amazon.awssdk.crt.http.HttpClientConnectionManager;
+import software.amazon.awssdk.crt.http.HttpClientConnectionManagerOptions;
+import software.amazon.awssdk.crt.http.HttpHeader;
+import software.amazon.awssdk.crt.http.HttpRequest;
+import software.amazon.awssdk.crt.http.HttpStream;
+import software.amazon.awssdk.crt.http.HttpStreamResponseHandler;
+import software.amazon.awssdk.crt.io.ClientBootstrap;
+import software.amazon.awssdk.crt.io.EventLoopGroup;
+import software.amazon.awssdk.crt.io.HostResolver;
+import software.amazon.awssdk.crt.io.SocketOptions;
+
+/**
+ * Delivery of HTTP/1.1 response bodies from native code to onResponseBody(), by body size, over a pooled loopback
+ * connection. Small bodies measure the per-request round trip, large ones the per-chunk upcall and copy.
+ *
+ * Scores are requests per second; multiply by the body size for bytes per second.
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class HttpResponseBodyBenchmark {
+
+    @Param({"1024", "65536", "1048576", "16777216"})
+    public int bodySize;
+
+    private LocalObjectServer server;
+    private EventLoopGroup eventLoopGroup;
+    private HostResolver hostResolver;
+    private ClientBootstrap bootstrap;
+    private SocketOptions socketOptions;
+    private HttpClientConnectionManager connectionManager;
+    private HttpRequest request;
+
+    @Setup(Level.Trial)
+    public void setup() throws Exception {
+        server = new LocalObjectServer(bodySize);
+        eventLoopGroup = new EventLoopGroup(1);
+        hostResolver = new HostResolver(eventLoopGroup);
+        bootstrap = new ClientBootstrap(eventLoopGroup, hostResolver);
+        socketOptions = new SocketOptions();
+
+        HttpClientConnectionManagerOptions options = new HttpClientConnectionManagerOptions()
+            .withClientBootstrap(bootstrap)
+            .withSocketOptions(socketOptions)
+            .withUri(server.getUri())
+            .withMaxConnections(4);
+        connectionManager = HttpClientConnectionManager.create(options);
+
+        HttpHeader[] headers = { new HttpHeader("Host", server.getHostHeader()) };
+        request = new HttpRequest("GET", "/object", headers, null);
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() throws Exception {
+        connectionManager.close();
+        connectionManager.getShutdownCompleteFuture().get();
+        socketOptions.close();
+        bootstrap.close();
+        hostResolver.close();
+        eventLoopGroup.close();
+        server.close();
+    }
+
+    @Benchmark
+    public long get() throws Exception {
+        HttpClientConnection connection = connectionManager.acquireConnection().get();
+        try {
+            CompletableFuture<Long> done = new CompletableFuture<>();
+            long[] received = new long[1];
+
+            HttpStreamResponseHandler handler = new HttpStreamResponseHandler() {
+                @Override
+                public void onResponseHeaders(HttpStream stream, int responseStatusCode, int blockType,
+                                              HttpHeader[] nextHeaders) {
+                }
+
+                @Override
+                public int onResponseBody(HttpStream stream, byte[] bodyBytesIn) {
+                    received[0] += bodyBytesIn.length;
+                    return bodyBytesIn.length;
+                }
+
+                @Override
+                public void onResponseComplete(HttpStream stream, int errorCode) {
+                    if (errorCode != 0) {
+                        done.completeExceptionally(new CrtRuntimeException(errorCode));
+                    } else {
+                        done.complete(received[0]);
+                    }
+                }
+            };
+
+            try (HttpStream stream = connection.makeRequest(request, handler)) {
+                stream.activate();
+                return done.get();
+            }
+        } finally {
+            connectionManager.releaseConnection(connection);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.benchmarks;
+
+import java.net.URI;
+import java.util.concurrent.ExecutionException;
+
+import software.amazon.awssdk.crt.io.EventLoopGroup;
+import software.amazon.awssdk.crt.io.ServerBootstrap;
+import software.amazon.awssdk.crt.io.SocketOptions;
+import software.amazon.awssdk.crt.s3.S3LoopbackServer;
+import software.amazon.awssdk.crt.s3.S3LoopbackServerMetrics;
+import software.amazon.awssdk.crt.s3.S3LoopbackServerOptions;
+
+/**
+ * An S3LoopbackServer on event loops of its own, so that its work doesn't compete with the client's for them. Every
+ * GET returns the same synthetic object, honouring Range, and every PUT, multipart or not, is drained and acknowledged.
+ * Requests aren't authenticated.
+ */
+@SuppressWarnings("deprecation")
+final class LocalObjectServer implements AutoCloseable {
+
+    private final EventLoopGroup eventLoopGroup;
+    private final ServerBootstrap bootstrap;
+    private final SocketOptions socketOptions;
+    private final S3LoopbackServer server;
+
+    LocalObjectServer(long objectSize) {
+        this(new S3LoopbackServerOptions().withObjectSize(objectSize), 2);
+    }
+
+    LocalObjectServer(S3LoopbackServerOptions options, int threads) {
+        eventLoopGroup = new EventLoopGroup(threads);
+        bootstrap = new ServerBootstrap(eventLoopGroup);
+        socketOptions = new SocketOptions();
+        server = new S3LoopbackServer(bootstrap, socketOptions, options);
+    }
+
+    URI getUri() {
+        return server.getUri();
+    }
+
+    String getHostHeader() {
+        return server.getHostHeader();
+    }
+
+    S3LoopbackServerMetrics getMetrics() {
+        return server.getMetrics();
+    }
+
+    @Override
+    public void close() throws ExecutionException, InterruptedException {
+        server.close();
+        server.getShutdownCompleteFuture().get();
+        socketOptions.close();
+        bootstrap.close();
+        eventLoopGroup.close();
+    }
+}
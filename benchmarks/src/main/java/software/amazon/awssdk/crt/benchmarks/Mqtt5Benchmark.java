@@ -0,0 +1,162 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.benchmarks;
+
+import java.util.UUID;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+import software.amazon.awssdk.crt.mqtt5.Mqtt5Client;
+import software.amazon.awssdk.crt.mqtt5.Mqtt5ClientOptions;
+import software.amazon.awssdk.crt.mqtt5.OnAttemptingConnectReturn;
+import software.amazon.awssdk.crt.mqtt5.OnConnectionFailureReturn;
+import software.amazon.awssdk.crt.mqtt5.OnConnectionSuccessReturn;
+import software.amazon.awssdk.crt.mqtt5.OnDisconnectionReturn;
+import software.amazon.awssdk.crt.mqtt5.OnStoppedReturn;
+import software.amazon.awssdk.crt.mqtt5.PublishReturn;
+import software.amazon.awssdk.crt.mqtt5.QOS;
+import software.amazon.awssdk.crt.mqtt5.packets.ConnectPacket;
+import software.amazon.awssdk.crt.mqtt5.packets.DisconnectPacket;
+import software.amazon.awssdk.crt.mqtt5.packets.PublishPacket;
+import software.amazon.awssdk.crt.mqtt5.packets.SubscribePacket;
+
+/**
+ * MQTT5 publish and receive rates against a broker, by payload size. The client subscribes to its own topic, so
+ * roundTrip covers the publish, the broker and the delivery back through onMessageReceived().
+ *
+ * There's no broker in process: point it at one with -Daws.crt.benchmark.mqtt5.host and
+ * -Daws.crt.benchmark.mqtt5.port (localhost:1883 by default, e.g. a local mosquitto). Scores include the broker's
+ * latency, so compare runs against the same one.
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class Mqtt5Benchmark {
+
+    private static final long TIMEOUT_SECONDS = 30;
+
+    @Param({"16", "1024", "65536"})
+    public int payloadSize;
+
+    private final String topic = "crt/benchmark/" + UUID.randomUUID();
+    private final CompletableFuture<Void> connected = new CompletableFuture<>();
+    private final CompletableFuture<Void> stopped = new CompletableFuture<>();
+    private volatile CompletableFuture<Void> nextMessage;
+
+    private Mqtt5Client client;
+    private PublishPacket qos0Publish;
+    private PublishPacket qos1Publish;
+
+    @Setup(Level.Trial)
+    public void setup() throws Exception {
+        String host = System.getProperty("aws.crt.benchmark.mqtt5.host", "localhost");
+        long port = Long.parseLong(System.getProperty("aws.crt.benchmark.mqtt5.port", "1883"));
+
+        Mqtt5ClientOptions options = new Mqtt5ClientOptions.Mqtt5ClientOptionsBuilder(host, port)
+            .withConnectOptions(new ConnectPacket.ConnectPacketBuilder()
+                .withClientId("crt-benchmark-" + UUID.randomUUID())
+                .build())
+            .withLifecycleEvents(new Mqtt5ClientOptions.LifecycleEvents() {
+                @Override
+                public void onAttemptingConnect(Mqtt5Client client, OnAttemptingConnectReturn result) {
+                }
+
+                @Override
+                public void onConnectionSuccess(Mqtt5Client client, OnConnectionSuccessReturn result) {
+                    connected.complete(null);
+                }
+
+                @Override
+                public void onConnectionFailure(Mqtt5Client client, OnConnectionFailureReturn result) {
+                    connected.completeExceptionally(new IllegalStateException(
+                        "Could not connect to the MQTT5 broker at " + host + ":" + port));
+                }
+
+                @Override
+                public void onDisconnection(Mqtt5Client client, OnDisconnectionReturn result) {
+                }
+
+                @Override
+                public void onStopped(Mqtt5Client client, OnStoppedReturn result) {
+                    stopped.complete(null);
+                }
+            })
+            .withPublishEvents((client, publishReturn) -> onMessageReceived(publishReturn))
+            .build();
+
+        client = new Mqtt5Client(options);
+        client.start();
+        connected.get(TIMEOUT_SECONDS, TimeUnit.SECONDS);
+
+        client.subscribe(new SubscribePacket.SubscribePacketBuilder()
+            .withSubscription(topic, QOS.AT_MOST_ONCE)
+            .build()).get(TIMEOUT_SECONDS, TimeUnit.SECONDS);
+
+        byte[] payload = new byte[payloadSize];
+        qos0Publish = new PublishPacket.PublishPacketBuilder()
+            .withTopic(topic).withQOS(QOS.AT_MOST_ONCE).withPayload(payload).build();
+        qos1Publish = new PublishPacket.PublishPacketBuilder()
+            .withTopic(topic).withQOS(QOS.AT_LEAST_ONCE).withPayload(payload).build();
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() throws Exception {
+        client.stop(new DisconnectPacket.DisconnectPacketBuilder().build());
+        stopped.get(TIMEOUT_SECONDS, TimeUnit.SECONDS);
+        client.close();
+    }
+
+    private void onMessageReceived(PublishReturn publishReturn) {
+        CompletableFuture<Void> waiter = nextMessage;
+        if (waiter != null) {
+            waiter.complete(null);
+        }
+    }
+
+    /**
+     * QoS 0: completes once the publish is written to the socket.
+     */
+    @Benchmark
+    public Object publishQos0() throws Exception {
+        return client.publish(qos0Publish).get(TIMEOUT_SECONDS, TimeUnit.SECONDS);
+    }
+
+    /**
+     * QoS 1: completes once the broker's PUBACK is received.
+     */
+    @Benchmark
+    public Object publishQos1() throws Exception {
+        return client.publish(qos1Publish).get(TIMEOUT_SECONDS, TimeUnit.SECONDS);
+    }
+
+    /**
+     * Publishes and waits for the broker to deliver the message back.
+     */
+    @Benchmark
+    public void roundTrip() throws Exception {
+        CompletableFuture<Void> received = new CompletableFuture<>();
+        nextMessage = received;
+        client.publish(qos0Publish);
+        received.get(TIMEOUT_SECONDS, TimeUnit.SECONDS);
+        nextMessage = null;
+    }
+}
@@ -0,0 +1,194 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.benchmarks;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+import software.amazon.awssdk.crt.auth.credentials.StaticCredentialsProvider;
+import software.amazon.awssdk.crt.http.HttpHeader;
+import software.amazon.awssdk.crt.http.HttpRequest;
+import software.amazon.awssdk.crt.http.HttpRequestBodyStream;
+import software.amazon.awssdk.crt.io.ClientBootstrap;
+import software.amazon.awssdk.crt.io.EventLoopGroup;
+import software.amazon.awssdk.crt.io.HostResolver;
+import software.amazon.awssdk.crt.s3.CrtS3RuntimeException;
+import software.amazon.awssdk.crt.s3.S3Client;
+import software.amazon.awssdk.crt.s3.S3ClientOptions;
+import software.amazon.awssdk.crt.s3.S3FinishedResponseContext;
+import software.amazon.awssdk.crt.s3.S3MetaRequest;
+import software.amazon.awssdk.crt.s3.S3MetaRequestOptions;
+import software.amazon.awssdk.crt.s3.S3MetaRequestResponseHandler;
+
+/**
+ * Whole-object GET and PUT through the S3Client against a loopback server, by object size. Objects larger than the
+ * part size are split into parallel ranged GETs and multipart uploads, as they would be against S3.
+ *
+ * Scores are seconds per object; divide the size by it for bytes per second.
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations = 2, time = 5)
+@Measurement(iterations = 5, time = 5)
+@Fork(1)
+public class S3LocalServerBenchmark {
+
+    private static final long PART_SIZE = 8L * 1024 * 1024;
+
+    @Param({"1048576", "67108864"})
+    public int objectSize;
+
+    @Param({"4"})
+    public int threads;
+
+    private LocalObjectServer server;
+    private EventLoopGroup eventLoopGroup;
+    private HostResolver hostResolver;
+    private ClientBootstrap bootstrap;
+    private StaticCredentialsProvider credentialsProvider;
+    private S3Client client;
+    private byte[] body;
+
+    @Setup(Level.Trial)
+    public void setup() throws Exception {
+        server = new LocalObjectServer(objectSize);
+        eventLoopGroup = new EventLoopGroup(threads);
+        hostResolver = new HostResolver(eventLoopGroup);
+        bootstrap = new ClientBootstrap(eventLoopGroup, hostResolver);
+        /* the server doesn't check signatures */
+        credentialsProvider = new StaticCredentialsProvider.StaticCredentialsProviderBuilder()
+            .withAccessKeyId("benchmark".getBytes(StandardCharsets.UTF_8))
+            .withSecretAccessKey("benchmark".getBytes(StandardCharsets.UTF_8))
+            .build();
+
+        S3ClientOptions options = new S3ClientOptions()
+            .withRegion("us-west-2")
+            .withClientBootstrap(bootstrap)
+            .withCredentialsProvider(credentialsProvider)
+            .withPartSize(PART_SIZE)
+            .withThroughputTargetGbps(10);
+        client = new S3Client(options);
+
+        body = new byte[objectSize];
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() throws Exception {
+        client.close();
+        client.getShutdownCompleteFuture().get();
+        credentialsProvider.close();
+        bootstrap.close();
+        hostResolver.close();
+        eventLoopGroup.close();
+        server.close();
+    }
+
+    @Benchmark
+    public long getObject() throws Exception {
+        HttpHeader[] headers = { new HttpHeader("Host", server.getHostHeader()) };
+        HttpRequest request = new HttpRequest("GET", "/object", headers, null);
+
+        long[] received = new long[1];
+        CompletableFuture<Long> done = new CompletableFuture<>();
+        S3MetaRequestResponseHandler handler = new S3MetaRequestResponseHandler() {
+            @Override
+            public int onResponseBody(ByteBuffer bodyBytesIn, long objectRangeStart, long objectRangeEnd) {
+                synchronized (received) {
+                    received[0] += bodyBytesIn.remaining();
+                }
+                return 0;
+            }
+
+            @Override
+            public void onFinished(S3FinishedResponseContext context) {
+                if (context.getErrorCode() != 0) {
+                    done.completeExceptionally(new CrtS3RuntimeException(context));
+                } else {
+                    synchronized (received) {
+                        done.complete(received[0]);
+                    }
+                }
+            }
+        };
+
+        return run(new S3MetaRequestOptions()
+            .withMetaRequestType(S3MetaRequestOptions.MetaRequestType.GET_OBJECT)
+            .withHttpRequest(request)
+            .withEndpoint(server.getUri())
+            .withResponseHandler(handler), done);
+    }
+
+    @Benchmark
+    public long putObject() throws Exception {
+        HttpHeader[] headers = {
+            new HttpHeader("Host", server.getHostHeader()),
+            new HttpHeader("Content-Length", Integer.toString(objectSize)),
+        };
+        HttpRequestBodyStream bodyStream = new HttpRequestBodyStream() {
+            private int position = 0;
+
+            @Override
+            public boolean sendRequestBody(ByteBuffer bodyBytesOut) {
+                int length = Math.min(bodyBytesOut.remaining(), body.length - position);
+                bodyBytesOut.put(body, position, length);
+                position += length;
+                return position == body.length;
+            }
+
+            @Override
+            public boolean resetPosition() {
+                position = 0;
+                return true;
+            }
+
+            @Override
+            public long getLength() {
+                return body.length;
+            }
+        };
+        HttpRequest request = new HttpRequest("PUT", "/object", headers, bodyStream);
+
+        CompletableFuture<Long> done = new CompletableFuture<>();
+        S3MetaRequestResponseHandler handler = new S3MetaRequestResponseHandler() {
+            @Override
+            public void onFinished(S3FinishedResponseContext context) {
+                if (context.getErrorCode() != 0) {
+                    done.completeExceptionally(new CrtS3RuntimeException(context));
+                } else {
+                    done.complete((long) objectSize);
+                }
+            }
+        };
+
+        return run(new S3MetaRequestOptions()
+            .withMetaRequestType(S3MetaRequestOptions.MetaRequestType.PUT_OBJECT)
+            .withHttpRequest(request)
+            .withEndpoint(server.getUri())
+            .withResponseHandler(handler), done);
+    }
+
+    private long run(S3MetaRequestOptions options, CompletableFuture<Long> done) throws Exception {
+        try (S3MetaRequest metaRequest = client.makeMetaRequest(options)) {
+            return done.get();
+        }
+    }
+}
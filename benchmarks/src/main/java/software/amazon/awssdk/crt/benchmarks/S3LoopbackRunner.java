@@ -0,0 +1,267 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.benchmarks;
+
+import java.lang.management.ManagementFactory;
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Locale;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.Semaphore;
+
+import software.amazon.awssdk.crt.LatencyHistogram;
+import software.amazon.awssdk.crt.auth.credentials.StaticCredentialsProvider;
+import software.amazon.awssdk.crt.http.HttpHeader;
+import software.amazon.awssdk.crt.http.HttpRequest;
+import software.amazon.awssdk.crt.http.HttpRequestBodyStream;
+import software.amazon.awssdk.crt.io.ClientBootstrap;
+import software.amazon.awssdk.crt.io.EventLoopGroup;
+import software.amazon.awssdk.crt.io.HostResolver;
+import software.amazon.awssdk.crt.s3.CrtS3RuntimeException;
+import software.amazon.awssdk.crt.s3.S3Client;
+import software.amazon.awssdk.crt.s3.S3ClientOptions;
+import software.amazon.awssdk.crt.s3.S3FinishedResponseContext;
+import software.amazon.awssdk.crt.s3.S3LoopbackServerMetrics;
+import software.amazon.awssdk.crt.s3.S3LoopbackServerOptions;
+import software.amazon.awssdk.crt.s3.S3MetaRequest;
+import software.amazon.awssdk.crt.s3.S3MetaRequestOptions;
+import software.amazon.awssdk.crt.s3.S3MetaRequestResponseHandler;
+
+/**
+ * Sustained S3Client throughput against an S3LoopbackServer simulating a given latency and bandwidth per request:
+ * downloads or uploads a number of objects with a fixed number in flight, then reports throughput, part latency
+ * percentiles, as the server saw them, and the CPU time the whole process spent per GB moved.
+ *
+ * Unlike the JMH benchmarks this is one long run, closer to how a transfer manager drives the client. Options are
+ * given as name=value arguments, see {@link #usage()}.
+ */
+@SuppressWarnings("deprecation")
+public final class S3LoopbackRunner {
+
+    private long objectSize = 256L * 1024 * 1024;
+    private int objectCount = 16;
+    private int concurrency = 4;
+    private long partSize = 8L * 1024 * 1024;
+    private int maxConnections = 0;
+    private long latencyMillis = 0;
+    private long bandwidthBytesPerSecond = 0;
+    private boolean upload = false;
+    private int clientThreads = Math.max(1, Runtime.getRuntime().availableProcessors() / 2);
+    private int serverThreads = Math.max(1, Runtime.getRuntime().availableProcessors() / 2);
+    private double targetGbps = 10;
+
+    private byte[] body;
+
+    public static void main(String[] args) throws Exception {
+        S3LoopbackRunner runner = new S3LoopbackRunner();
+        for (String arg : args) {
+            int separator = arg.indexOf('=');
+            if (separator < 0 || !runner.parse(arg.substring(0, separator), arg.substring(separator + 1))) {
+                usage();
+                System.exit(1);
+            }
+        }
+        runner.run();
+    }
+
+    private static void usage() {
+        System.err.println("usage: S3LoopbackRunner [name=value ...]");
+        System.err.println("  objectSize=bytes       size of each object (256 MiB)");
+        System.err.println("  objectCount=n          objects to transfer (16)");
+        System.err.println("  concurrency=n          objects in flight at once (4)");
+        System.err.println("  partSize=bytes         S3Client part size (8 MiB)");
+        System.err.println("  maxConnections=n       S3Client connection limit, 0 for its default (0)");
+        System.err.println("  latencyMs=ms           simulated latency of each request (0)");
+        System.err.println("  bandwidth=bytes/s      simulated bandwidth of each request, 0 for unlimited (0)");
+        System.err.println("  targetGbps=gbps        S3Client throughput target (10)");
+        System.err.println("  op=get|put             download or upload (get)");
+        System.err.println("  clientThreads=n        client event loop threads (half the processors)");
+        System.err.println("  serverThreads=n        server event loop threads (half the processors)");
+    }
+
+    private boolean parse(String name, String value) {
+        switch (name) {
+            case "objectSize": objectSize = Long.parseLong(value); return true;
+            case "objectCount": objectCount = Integer.parseInt(value); return true;
+            case "concurrency": concurrency = Integer.parseInt(value); return true;
+            case "partSize": partSize = Long.parseLong(value); return true;
+            case "maxConnections": maxConnections = Integer.parseInt(value); return true;
+            case "latencyMs": latencyMillis = Long.parseLong(value); return true;
+            case "bandwidth": bandwidthBytesPerSecond = Long.parseLong(value); return true;
+            case "targetGbps": targetGbps = Double.parseDouble(value); return true;
+            case "op": upload = value.equals("put"); return upload || value.equals("get");
+            case "clientThreads": clientThreads = Integer.parseInt(value); return true;
+            case "serverThreads": serverThreads = Integer.parseInt(value); return true;
+            default: return false;
+        }
+    }
+
+    private void run() throws Exception {
+        if (upload) {
+            if (objectSize > Integer.MAX_VALUE) {
+                throw new IllegalArgumentException("objectSize must fit in an int for uploads");
+            }
+            body = new byte[(int) objectSize];
+        }
+
+        S3LoopbackServerOptions serverOptions = new S3LoopbackServerOptions()
+            .withObjectSize(objectSize)
+            .withResponseLatencyMillis(latencyMillis)
+            .withBandwidthBytesPerSecond(bandwidthBytesPerSecond);
+
+        try (LocalObjectServer server = new LocalObjectServer(serverOptions, serverThreads);
+             EventLoopGroup eventLoopGroup = new EventLoopGroup(clientThreads);
+             HostResolver hostResolver = new HostResolver(eventLoopGroup);
+             ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, hostResolver);
+             StaticCredentialsProvider credentialsProvider = newCredentialsProvider()) {
+
+            S3ClientOptions clientOptions = new S3ClientOptions()
+                .withRegion("us-west-2")
+                .withClientBootstrap(bootstrap)
+                .withCredentialsProvider(credentialsProvider)
+                .withPartSize(partSize)
+                .withThroughputTargetGbps(targetGbps);
+            if (maxConnections > 0) {
+                clientOptions.withMaxConnections(maxConnections);
+            }
+
+            S3Client client = new S3Client(clientOptions);
+            try {
+                transfer(client, server);
+            } finally {
+                client.close();
+                client.getShutdownCompleteFuture().get();
+            }
+        }
+    }
+
+    /* the server doesn't check signatures */
+    private static StaticCredentialsProvider newCredentialsProvider() {
+        return new StaticCredentialsProvider.StaticCredentialsProviderBuilder()
+            .withAccessKeyId("benchmark".getBytes(StandardCharsets.UTF_8))
+            .withSecretAccessKey("benchmark".getBytes(StandardCharsets.UTF_8))
+            .build();
+    }
+
+    private void transfer(S3Client client, LocalObjectServer server) throws Exception {
+        com.sun.management.OperatingSystemMXBean os =
+            (com.sun.management.OperatingSystemMXBean) ManagementFactory.getOperatingSystemMXBean();
+
+        Semaphore inFlight = new Semaphore(concurrency);
+        List<CompletableFuture<Void>> transfers = new ArrayList<>();
+
+        S3LoopbackServerMetrics before = server.getMetrics();
+        long startCpuNanos = os.getProcessCpuTime();
+        long startNanos = System.nanoTime();
+
+        for (int i = 0; i < objectCount; i++) {
+            inFlight.acquire();
+            CompletableFuture<Void> done = new CompletableFuture<>();
+            S3MetaRequest metaRequest = client.makeMetaRequest(upload ? putOptions(server, i, done)
+                                                                      : getOptions(server, i, done));
+            transfers.add(done.whenComplete((result, error) -> {
+                metaRequest.close();
+                inFlight.release();
+            }));
+        }
+        CompletableFuture.allOf(transfers.toArray(new CompletableFuture[0])).get();
+
+        long elapsedNanos = System.nanoTime() - startNanos;
+        long cpuNanos = os.getProcessCpuTime() - startCpuNanos;
+        S3LoopbackServerMetrics after = server.getMetrics();
+
+        double bytes = (double) objectSize * objectCount;
+        LatencyHistogram partLatency = after.getRequestLatency();
+        System.out.println(String.format(Locale.ROOT,
+            "%s %d x %d bytes, %d in flight, %d byte parts, %d ms latency, %s bandwidth per request",
+            upload ? "PUT" : "GET", objectCount, objectSize, concurrency, partSize, latencyMillis,
+            bandwidthBytesPerSecond > 0 ? bandwidthBytesPerSecond + " B/s" : "unlimited"));
+        System.out.println(String.format(Locale.ROOT, "throughput:       %.2f Gbps over %.2f s",
+            bytes * 8 / elapsedNanos, elapsedNanos / 1e9));
+        System.out.println(String.format(Locale.ROOT, "requests:         %d (%.0f/s), %d failed",
+            after.getRequests() - before.getRequests(), after.getRequestsPerSecondSince(before),
+            after.getFailedRequests() - before.getFailedRequests()));
+        System.out.println(String.format(Locale.ROOT, "part latency:     p50 %.2f ms, p99 %.2f ms",
+            partLatency.getValueAtPercentileMicros(50) / 1e3, partLatency.getValueAtPercentileMicros(99) / 1e3));
+        System.out.println(String.format(Locale.ROOT, "cpu:              %.2f s, %.2f cpu-s per GB",
+            cpuNanos / 1e9, cpuNanos / 1e9 / (bytes / 1e9)));
+    }
+
+    private S3MetaRequestOptions getOptions(LocalObjectServer server, int index, CompletableFuture<Void> done) {
+        HttpHeader[] headers = { new HttpHeader("Host", server.getHostHeader()) };
+        HttpRequest request = new HttpRequest("GET", "/object-" + index, headers, null);
+
+        S3MetaRequestResponseHandler handler = new S3MetaRequestResponseHandler() {
+            @Override
+            public int onResponseBody(ByteBuffer bodyBytesIn, long objectRangeStart, long objectRangeEnd) {
+                return 0;
+            }
+
+            @Override
+            public void onFinished(S3FinishedResponseContext context) {
+                complete(done, context);
+            }
+        };
+
+        return new S3MetaRequestOptions()
+            .withMetaRequestType(S3MetaRequestOptions.MetaRequestType.GET_OBJECT)
+            .withHttpRequest(request)
+            .withEndpoint(server.getUri())
+            .withResponseHandler(handler);
+    }
+
+    private S3MetaRequestOptions putOptions(LocalObjectServer server, int index, CompletableFuture<Void> done) {
+        HttpHeader[] headers = {
+            new HttpHeader("Host", server.getHostHeader()),
+            new HttpHeader("Content-Length", Long.toString(objectSize)),
+        };
+        HttpRequestBodyStream bodyStream = new HttpRequestBodyStream() {
+            private int position = 0;
+
+            @Override
+            public boolean sendRequestBody(ByteBuffer bodyBytesOut) {
+                int length = Math.min(bodyBytesOut.remaining(), body.length - position);
+                bodyBytesOut.put(body, position, length);
+                position += length;
+                return position == body.length;
+            }
+
+            @Override
+            public boolean resetPosition() {
+                position = 0;
+                return true;
+            }
+
+            @Override
+            public long getLength() {
+                return body.length;
+            }
+        };
+        HttpRequest request = new HttpRequest("PUT", "/object-" + index, headers, bodyStream);
+
+        S3MetaRequestResponseHandler handler = new S3MetaRequestResponseHandler() {
+            @Override
+            public void onFinished(S3FinishedResponseContext context) {
+                complete(done, context);
+            }
+        };
+
+        return new S3MetaRequestOptions()
+            .withMetaRequestType(S3MetaRequestOptions.MetaRequestType.PUT_OBJECT)
+            .withHttpRequest(request)
+            .withEndpoint(server.getUri())
+            .withResponseHandler(handler);
+    }
+
+    private static void complete(CompletableFuture<Void> done, S3FinishedResponseContext context) {
+        if (context.getErrorCode() != 0) {
+            done.completeExceptionally(new CrtS3RuntimeException(context));
+        } else {
+            done.complete(null);
+        }
+    }
+}
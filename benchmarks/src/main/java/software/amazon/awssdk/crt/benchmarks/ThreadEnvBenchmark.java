@@ -0,0 +1,75 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.benchmarks;
+
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.TimeUnit;
+
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+import software.amazon.awssdk.crt.auth.credentials.Credentials;
+import software.amazon.awssdk.crt.auth.credentials.DelegateCredentialsProvider;
+import software.amazon.awssdk.crt.auth.credentials.StaticCredentialsProvider;
+
+/**
+ * The cost of aws_jni_acquire_thread_env() and the upcall it guards. Both providers complete the future from native
+ * code, through one acquire; the delegate provider also calls its Java handler from native code, through a second.
+ * The difference between the two is one acquire, upcall and release on a thread already attached to the JVM, the
+ * path every callback from a CRT thread takes once that thread is attached.
+ */
+@State(Scope.Benchmark)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class ThreadEnvBenchmark {
+
+    private static final byte[] ACCESS_KEY_ID = "benchmark".getBytes(StandardCharsets.UTF_8);
+    private static final byte[] SECRET_ACCESS_KEY = "benchmark".getBytes(StandardCharsets.UTF_8);
+
+    private StaticCredentialsProvider staticProvider;
+    private DelegateCredentialsProvider delegateProvider;
+
+    @Setup(Level.Trial)
+    public void setup() {
+        staticProvider = new StaticCredentialsProvider.StaticCredentialsProviderBuilder()
+            .withAccessKeyId(ACCESS_KEY_ID)
+            .withSecretAccessKey(SECRET_ACCESS_KEY)
+            .build();
+
+        Credentials credentials = new Credentials(ACCESS_KEY_ID, SECRET_ACCESS_KEY, null);
+        delegateProvider = new DelegateCredentialsProvider.DelegateCredentialsProviderBuilder()
+            .withHandler(() -> credentials)
+            .build();
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        staticProvider.close();
+        delegateProvider.close();
+    }
+
+    @Benchmark
+    public Credentials oneUpcall() throws Exception {
+        return staticProvider.getCredentials().get();
+    }
+
+    @Benchmark
+    public Credentials twoUpcalls() throws Exception {
+        return delegateProvider.getCredentials().get();
+    }
+}
@@ -41,9 +41,15 @@ public final class CRT {
             memoryTracingLevel = Integer.parseInt(System.getProperty("aws.crt.memory.tracing"));
         } catch (Exception ex) {
         }
+        boolean memoryAccounting = System.getProperty("aws.crt.memory.accounting") != null;
+        long memorySamplingInterval = 0;
+        try {
+            memorySamplingInterval = Long.parseLong(System.getProperty("aws.crt.memory.sampling"));
+        } catch (Exception ex) {
+        }
         boolean debugWait = System.getProperty("aws.crt.debugwait") != null;
         boolean strictShutdown = System.getProperty("aws.crt.strictshutdown") != null;
-        awsCrtInit(memoryTracingLevel, debugWait, strictShutdown);
+        awsCrtInit(memoryTracingLevel, memoryAccounting, memorySamplingInterval, debugWait, strictShutdown);
 
         Runtime.getRuntime().addShutdownHook(new Thread()
         {
@@ -58,6 +64,9 @@ public final class CRT {
         } catch (IllegalArgumentException e) {
             ;
         }
+
+        // Logging wasn't set up yet while initializing, so report how long it took now
+        logInitTimings();
     }
 
     /**
@@ -312,8 +321,12 @@ public final class CRT {
 
     // Called internally when bootstrapping the CRT, allows native code to do any
     // static initialization it needs
-    private static native void awsCrtInit(int memoryTracingLevel, boolean debugWait, boolean strictShutdown)
-            throws CrtRuntimeException;
+    private static native void awsCrtInit(int memoryTracingLevel, boolean memoryAccounting,
+            long memorySamplingInterval, boolean debugWait, boolean strictShutdown) throws CrtRuntimeException;
+
+    // Logs, at debug level, how long each part of native initialization took. Class ids for
+    // subsystems that haven't been used yet are cached lazily, and logged when that happens.
+    private static native void logInitTimings();
 
     /**
      * Returns the last error on the current thread.
@@ -357,8 +370,78 @@ public final class CRT {
      */
     public static native void dumpNativeMemory();
 
+    /**
+     * Parts of the CRT that native memory usage can be broken down by
+     */
+    public enum NativeMemorySubsystem {
+        General(0),
+        Io(1),
+        Http(2),
+        Auth(3),
+        Mqtt(4),
+        EventStream(5),
+        S3(6);
+
+        private final int value;
+
+        NativeMemorySubsystem(int value) {
+            this.value = value;
+        }
+
+        int getValue() {
+            return value;
+        }
+    }
+
+    /**
+     * Much cheaper than memory tracing, memory accounting can be left on in production. It's enabled by setting the
+     * aws.crt.memory.accounting system property.
+     *
+     * @param subsystem part of the CRT to report on
+     * @return The number of bytes currently allocated in native resources by the subsystem, including native
+     *         libraries working on its behalf. 0 unless memory accounting is enabled.
+     */
+    public static long nativeMemory(NativeMemorySubsystem subsystem) {
+        return awsNativeMemoryForSubsystem(subsystem.getValue());
+    }
+
+    /**
+     * @param subsystem part of the CRT to report on
+     * @return The number of native allocations the subsystem currently holds. 0 unless memory accounting is enabled.
+     * @see #nativeMemory(NativeMemorySubsystem)
+     */
+    public static long nativeAllocations(NativeMemorySubsystem subsystem) {
+        return awsNativeAllocationsForSubsystem(subsystem.getValue());
+    }
+
+    /**
+     * Unlike memory tracing, memory sampling only records about one allocation (with its stack) per interval of bytes
+     * allocated, and so is cheap enough to leave on in production. It's enabled by setting the
+     * aws.crt.memory.sampling system property to the interval, in bytes. 512KB is a reasonable starting point: a
+     * smaller interval is more accurate, and costs more. Enabling sampling also enables memory accounting.
+     *
+     * @return An estimate of the number of bytes currently allocated in native resources, extrapolated from the
+     *         samples. 0 unless memory sampling is enabled.
+     */
+    public static long sampledNativeMemory() {
+        return awsSampledNativeMemory();
+    }
+
+    /**
+     * Log, at Info level, where the sampled native memory that's still allocated was allocated from, grouped by
+     * stack, biggest first. Only logs if memory sampling is enabled.
+     * @see #sampledNativeMemory()
+     */
+    public static native void dumpNativeMemorySamples();
+
     private static native long awsNativeMemory();
 
+    private static native long awsSampledNativeMemory();
+
+    private static native long awsNativeMemoryForSubsystem(int subsystem);
+
+    private static native long awsNativeAllocationsForSubsystem(int subsystem);
+
     static void testJniException(boolean throwException) {
         if (throwException) {
             throw new RuntimeException("Testing");
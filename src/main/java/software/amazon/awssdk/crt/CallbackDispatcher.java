@@ -0,0 +1,148 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt;
+
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+
+/**
+ * Delivers callbacks from native code on a dedicated thread, instead of on the event loop that produced them.
+ * <p>
+ * Normally each event (a message arriving, a stream closing, ...) calls into Java on the native event loop thread,
+ * so a slow handler holds up all the other I/O on that loop, and every event pays for its own JNI transition.
+ * When a dispatcher is attached to a resource that supports it, the event loop instead queues a compact record of
+ * the event in native memory, without touching the JVM, and the dispatcher's thread picks up queued events in
+ * batches, one JNI call per batch, and runs the handlers.
+ * <p>
+ * Events for the same handler are delivered in the order they happened. Handlers all run on one thread, so a slow
+ * handler still delays the others, just not the I/O. Events raised after the dispatcher has been closed are
+ * delivered on the event loop again, as if there were no dispatcher.
+ * <p>
+ * Closing the dispatcher delivers whatever is already queued before returning, unless it's closed from one of its
+ * own handlers.
+ */
+public class CallbackDispatcher extends CrtResource {
+    private static final int INITIAL_BATCH_BUFFER_SIZE = 64 * 1024;
+    private static final int MAX_BATCH_EVENTS = 256;
+    private static final long DRAIN_WAIT_MS = 1000;
+
+    /**
+     * @hidden Receives the events queued for it. Implemented inside the library by whatever binds a resource to a
+     * dispatcher, not meant to be implemented by users.
+     */
+    public interface Target {
+        /**
+         * @param eventType what happened, specific to the target
+         * @param payload the event's data, only valid for the duration of the call
+         */
+        void onDispatchedEvent(int eventType, ByteBuffer payload);
+    }
+
+    private final Thread thread;
+    private volatile boolean closed = false;
+    private volatile boolean closedFromHandler = false;
+
+    /**
+     * Creates a dispatcher and starts its thread
+     */
+    public CallbackDispatcher() {
+        acquireNativeHandle(callbackDispatcherNew());
+        final long nativeHandle = getNativeHandle();
+        thread = new Thread(() -> run(nativeHandle), "AwsCrtCallbackDispatcher");
+        thread.setDaemon(true);
+        thread.start();
+    }
+
+    private void run(long nativeHandle) {
+        ByteBuffer batch = ByteBuffer.allocateDirect(INITIAL_BATCH_BUFFER_SIZE);
+        Object[] targets = new Object[MAX_BATCH_EVENTS];
+
+        while (true) {
+            int count = callbackDispatcherDrain(nativeHandle, batch, targets, DRAIN_WAIT_MS);
+            if (count == -1) {
+                break;
+            }
+            if (count < -1) {
+                /* the next event doesn't fit, grow the buffer and go again */
+                int needed = -count - 1;
+                batch = ByteBuffer.allocateDirect(Math.max(needed, batch.capacity() * 2));
+                continue;
+            }
+
+            batch.clear();
+            for (int i = 0; i < count; ++i) {
+                int eventType = batch.getInt();
+                int length = batch.getInt();
+                ByteBuffer payload = batch.slice();
+                payload.limit(length);
+                batch.position(batch.position() + length);
+                try {
+                    ((Target) targets[i]).onDispatchedEvent(eventType, payload);
+                } catch (Exception ex) {
+                    Log.log(Log.LogLevel.Error, Log.LogSubject.JavaCrtGeneral,
+                            "CallbackDispatcher: exception from event handler: " + ex.toString());
+                }
+            }
+            batch.clear();
+            Arrays.fill(targets, 0, count, null);
+        }
+
+        /* close() can't wait for this thread when it was called from here, so the thread releases instead */
+        if (closedFromHandler) {
+            callbackDispatcherRelease(nativeHandle);
+        }
+    }
+
+    /**
+     * @return true once the dispatcher has been closed
+     */
+    public boolean isClosed() {
+        return closed;
+    }
+
+    @Override
+    protected boolean canReleaseReferencesImmediately() { return true; }
+
+    @Override
+    protected void releaseNativeHandle() {
+        if (isNull()) {
+            return;
+        }
+
+        closed = true;
+        long nativeHandle = getNativeHandle();
+        if (Thread.currentThread() == thread) {
+            closedFromHandler = true;
+            callbackDispatcherShutdown(nativeHandle);
+            return;
+        }
+
+        callbackDispatcherShutdown(nativeHandle);
+        boolean interrupted = false;
+        while (thread.isAlive()) {
+            try {
+                thread.join();
+            } catch (InterruptedException ex) {
+                interrupted = true;
+            }
+        }
+        if (interrupted) {
+            Thread.currentThread().interrupt();
+        }
+        callbackDispatcherRelease(nativeHandle);
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+    private static native long callbackDispatcherNew();
+
+    private static native void callbackDispatcherShutdown(long dispatcher);
+
+    private static native void callbackDispatcherRelease(long dispatcher);
+
+    private static native int callbackDispatcherDrain(long dispatcher, ByteBuffer batch, Object[] targets,
+            long waitMs);
+}
@@ -10,15 +10,11 @@ import software.amazon.awssdk.crt.io.HostResolver;
 
 import java.time.Instant;
 import java.util.ArrayList;
+import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.atomic.AtomicLong;
-import java.util.concurrent.locks.Condition;
-import java.util.concurrent.locks.Lock;
-import java.util.concurrent.locks.ReentrantLock;
-import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.LongAdder;
 import java.util.function.Consumer;
-import java.util.HashMap;
-import java.util.Map;
 
 
 
@@ -29,6 +25,7 @@ import java.util.Map;
 public abstract class CrtResource implements AutoCloseable {
     private static final String NATIVE_DEBUG_PROPERTY_NAME = "aws.crt.debugnative";
     private static final int DEBUG_CLEANUP_WAIT_TIME_IN_SECONDS = 60;
+    private static final long DEBUG_CLEANUP_POLL_INTERVAL_IN_MILLISECONDS = 10;
     private static final long NULL = 0;
 
     private static final Log.LogLevel ResourceLogLevel = Log.LogLevel.Debug;
@@ -80,16 +77,19 @@ public abstract class CrtResource implements AutoCloseable {
         public void setNativeHandle(long handle) { nativeHandle = handle; }
     }
 
-    private static final HashMap<Long, ResourceInstance> CRT_RESOURCES = new HashMap<>();
-
     /*
-     * Primarily intended for testing only.  Tracks the number of non-closed resources and signals
-     * whenever a zero count is reached.
+     * Only populated when debugging native objects.  Concurrent so that tracking resources doesn't serialize every
+     * resource creation and release in the process on a single lock.
      */
+    private static final ConcurrentHashMap<Long, ResourceInstance> CRT_RESOURCES = new ConcurrentHashMap<>();
+
     private static boolean debugNativeObjects = System.getProperty(NATIVE_DEBUG_PROPERTY_NAME) != null;
-    private static int resourceCount = 0;
-    private static final Lock lock = new ReentrantLock();
-    private static final Condition emptyResources  = lock.newCondition();
+
+    /*
+     * Number of resources holding a native handle.  Striped so that threads creating and closing resources on
+     * different cores don't contend on the same counter.
+     */
+    private static final LongAdder nativeResourceCount = new LongAdder();
     private static final AtomicLong nextId = new AtomicLong(0);
 
     private final ArrayList<CrtResource> referencedResources = new ArrayList<>();
@@ -111,9 +111,7 @@ public abstract class CrtResource implements AutoCloseable {
         if (debugNativeObjects) {
             String canonicalName = this.getClass().getCanonicalName();
 
-            synchronized(CrtResource.class) {
-                CRT_RESOURCES.put(id, new ResourceInstance(this, canonicalName));
-            }
+            CRT_RESOURCES.put(id, new ResourceInstance(this, canonicalName));
 
             Log.log(ResourceLogLevel, Log.LogSubject.JavaCrtResource, String.format("CrtResource of class %s(%d) created", this.getClass().getCanonicalName(), id));
         }
@@ -191,11 +189,9 @@ public abstract class CrtResource implements AutoCloseable {
         }
 
         if (debugNativeObjects) {
-            synchronized(CrtResource.class) {
-                ResourceInstance instance = CRT_RESOURCES.get(id);
-                if (instance != null) {
-                    instance.setNativeHandle(handle);
-                }
+            ResourceInstance instance = CRT_RESOURCES.get(id);
+            if (instance != null) {
+                instance.setNativeHandle(handle);
             }
             Log.log(ResourceLogLevel, Log.LogSubject.JavaCrtResource, String.format("acquireNativeHandle - %s(%d) acquired native pointer %d", canonicalName, id, handle));
         }
@@ -211,9 +207,7 @@ public abstract class CrtResource implements AutoCloseable {
         if (debugNativeObjects) {
             Log.log(ResourceLogLevel, Log.LogSubject.JavaCrtResource, String.format("Releasing class %s(%d)", this.getClass().getCanonicalName(), id));
 
-            synchronized(CrtResource.class) {
-                CRT_RESOURCES.remove(id);
-            }
+            CRT_RESOURCES.remove(id);
         }
 
         releaseNativeHandle();
@@ -362,10 +356,8 @@ public abstract class CrtResource implements AutoCloseable {
      * @param fn function to apply to each outstanding Crt resource
      */
     public static void collectNativeResource(Consumer<ResourceInstance> fn) {
-        synchronized(CrtResource.class) {
-            for (Map.Entry<Long, ResourceInstance> entry : CRT_RESOURCES.entrySet()) {
-                fn.accept(entry.getValue());
-            }
+        for (ResourceInstance resource : CRT_RESOURCES.values()) {
+            fn.accept(resource);
         }
     }
 
@@ -380,39 +372,31 @@ public abstract class CrtResource implements AutoCloseable {
     }
 
     /**
-     * Debug method to increment the current native object count.
+     * Gets the number of resources that currently hold a native handle.  Cheap enough to call at any time, but
+     * only a snapshot when resources are being created or closed concurrently.
+     * @return number of outstanding native resources
      */
-    private static void incrementNativeObjectCount() {
-        if (!debugNativeObjects) {
-            return;
-        }
+    public static long getNativeResourceCount() {
+        return nativeResourceCount.sum();
+    }
 
-        lock.lock();
-        try {
-            ++resourceCount;
-            Log.log(ResourceLogLevel, Log.LogSubject.JavaCrtResource, String.format("incrementNativeObjectCount - count = %d", resourceCount));
-        } finally {
-            lock.unlock();
+    /**
+     * Increments the current native object count.
+     */
+    private static void incrementNativeObjectCount() {
+        nativeResourceCount.increment();
+        if (debugNativeObjects) {
+            Log.log(ResourceLogLevel, Log.LogSubject.JavaCrtResource, String.format("incrementNativeObjectCount - count = %d", nativeResourceCount.sum()));
         }
     }
 
     /**
-     * Debug method to decrement the current native object count.
+     * Decrements the current native object count.
      */
     private static void decrementNativeObjectCount() {
-        if (!debugNativeObjects) {
-            return;
-        }
-
-        lock.lock();
-        try {
-            --resourceCount;
-            Log.log(ResourceLogLevel, Log.LogSubject.JavaCrtResource, String.format("decrementNativeObjectCount - count = %d", resourceCount));
-            if (resourceCount == 0) {
-                emptyResources.signal();
-            }
-        } finally {
-            lock.unlock();
+        nativeResourceCount.decrement();
+        if (debugNativeObjects) {
+            Log.log(ResourceLogLevel, Log.LogSubject.JavaCrtResource, String.format("decrementNativeObjectCount - count = %d", nativeResourceCount.sum()));
         }
     }
 
@@ -426,15 +410,17 @@ public abstract class CrtResource implements AutoCloseable {
         HostResolver.closeStaticDefault();
 
         if (debugNativeObjects) {
-            lock.lock();
-
+            /*
+             * Polled rather than signalled, so that releasing a resource never has to take a lock just in case
+             * someone is waiting here.
+             */
             try {
                 long timeout = System.currentTimeMillis() + DEBUG_CLEANUP_WAIT_TIME_IN_SECONDS * 1000;
-                while (resourceCount != 0 && System.currentTimeMillis() < timeout) {
-                    emptyResources.await(1, TimeUnit.SECONDS);
+                while (nativeResourceCount.sum() != 0 && System.currentTimeMillis() < timeout) {
+                    Thread.sleep(DEBUG_CLEANUP_POLL_INTERVAL_IN_MILLISECONDS);
                 }
 
-                if (resourceCount != 0) {
+                if (nativeResourceCount.sum() != 0) {
                     Log.log(Log.LogLevel.Error, Log.LogSubject.JavaCrtResource, "waitForNoResources - timeOut");
                     logNativeResources();
                     throw new InterruptedException();
@@ -442,8 +428,6 @@ public abstract class CrtResource implements AutoCloseable {
             } catch (InterruptedException e) {
                 /* Cause tests to fail without having to go add checked exceptions to every instance */
                 throw new RuntimeException("Timeout waiting for resource count to drop to zero");
-            } finally {
-                lock.unlock();
             }
         }
 
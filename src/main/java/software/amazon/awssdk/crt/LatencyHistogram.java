@@ -0,0 +1,93 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt;
+
+/**
+ * A snapshot of a histogram of latencies recorded natively, in microseconds.
+ *
+ * Buckets are spaced logarithmically, four to each power of two, so a percentile is accurate to within 25%
+ * whatever its magnitude. Must match the bucket layout in latency_histogram.c.
+ */
+public final class LatencyHistogram {
+
+    /**
+     * Number of buckets in every histogram
+     */
+    public static final int BUCKET_COUNT = 168;
+
+    private final long[] buckets;
+    private final long count;
+
+    /**
+     * @hidden Only called with bucket counts copied out of native
+     * @param buckets count of latencies recorded in each bucket
+     */
+    public LatencyHistogram(long[] buckets) {
+        if (buckets.length != BUCKET_COUNT) {
+            throw new IllegalArgumentException("LatencyHistogram: expected " + BUCKET_COUNT + " buckets");
+        }
+        this.buckets = buckets;
+
+        long total = 0;
+        for (long bucket : buckets) {
+            total += bucket;
+        }
+        this.count = total;
+    }
+
+    /**
+     * @return the total number of latencies recorded
+     */
+    public long getCount() {
+        return count;
+    }
+
+    /**
+     * @param index bucket index, from 0 to BUCKET_COUNT - 1
+     * @return the number of latencies recorded in the bucket
+     */
+    public long getBucketCount(int index) {
+        return buckets[index];
+    }
+
+    /**
+     * @param index bucket index, from 0 to BUCKET_COUNT - 1
+     * @return the smallest latency, in microseconds, recorded in the bucket
+     */
+    public static long getBucketLowerBoundMicros(int index) {
+        if (index < 4) {
+            return index;
+        }
+        int exponent = index / 4 + 1;
+        int subBucket = index % 4;
+        return (long) (4 + subBucket) << (exponent - 2);
+    }
+
+    /**
+     * Returns an upper bound for a percentile: at least the given fraction of the recorded latencies were no more
+     * than the returned value.
+     *
+     * @param percentile the percentile, from 0 to 100
+     * @return the latency in microseconds at the percentile, or 0 if nothing was recorded
+     */
+    public long getValueAtPercentileMicros(double percentile) {
+        if (percentile < 0 || percentile > 100) {
+            throw new IllegalArgumentException("LatencyHistogram: percentile must be between 0 and 100");
+        }
+        if (count == 0) {
+            return 0;
+        }
+
+        long target = Math.max(1, (long) Math.ceil(count * percentile / 100.0));
+        long seen = 0;
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            seen += buckets[i];
+            if (seen >= target) {
+                return i + 1 < BUCKET_COUNT ? getBucketLowerBoundMicros(i + 1) - 1 : Long.MAX_VALUE;
+            }
+        }
+        return Long.MAX_VALUE;
+    }
+}
@@ -4,6 +4,14 @@
  */
 package software.amazon.awssdk.crt;
 
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.EnumMap;
+import java.util.List;
+import java.util.Map;
+
 /**
  * Static wrapper around native and crt logging.
  *
@@ -22,6 +30,9 @@ public class Log {
     private static final String LOG_DESTINATION_PROPERTY_NAME = "aws.crt.log.destination";
     private static final String LOG_FILE_NAME_PROPERTY_NAME = "aws.crt.log.filename";
     private static final String LOG_LEVEL_PROPERTY_NAME = "aws.crt.log.level";
+    private static final String LOG_ASYNC_PROPERTY_NAME = "aws.crt.log.async";
+    private static final String LOG_FORMAT_PROPERTY_NAME = "aws.crt.log.format";
+    private static final String LOG_RATE_LIMIT_PROPERTY_NAME = "aws.crt.log.ratelimit";
 
     /**
      * Enum that determines where logging should be routed to.
@@ -30,7 +41,30 @@ public class Log {
         None,
         Stdout,
         Stderr,
-        File
+        File,
+        Sink
+    }
+
+    /**
+     * Enum that controls how asynchronous logging encodes records.
+     */
+    public enum LogFormat {
+        /** One line per record, the same layout as synchronous logging */
+        Text(0),
+        /** One JSON object per line */
+        Json(1),
+        /** Length-prefixed binary records, the same encoding a LogSink receives */
+        Binary(2);
+
+        private int value;
+
+        LogFormat(int value) {
+            this.value = value;
+        }
+
+        public int getValue() {
+            return value;
+        }
     }
 
     /**
@@ -115,6 +149,139 @@ public class Log {
         private int value;
     };
 
+    /**
+     * A log record delivered to a LogSink
+     */
+    public static class LogRecord {
+        private final long timestampNs;
+        private final LogLevel level;
+        private final int subject;
+        private final String thread;
+        private final String message;
+
+        LogRecord(long timestampNs, LogLevel level, int subject, String thread, String message) {
+            this.timestampNs = timestampNs;
+            this.level = level;
+            this.subject = subject;
+            this.thread = thread;
+            this.message = message;
+        }
+
+        /**
+         * @return when the record was logged, in nanoseconds since the Unix epoch
+         */
+        public long getTimestampNs() { return timestampNs; }
+
+        /**
+         * @return the level the record was logged at
+         */
+        public LogLevel getLevel() { return level; }
+
+        /**
+         * @return the native log subject id, see LogSubject for the well-known ones
+         */
+        public int getSubject() { return subject; }
+
+        /**
+         * @return id of the thread that logged the record
+         */
+        public String getThread() { return thread; }
+
+        /**
+         * @return the log message
+         */
+        public String getMessage() { return message; }
+    }
+
+    /**
+     * Receives batches of log records from asynchronous logging
+     */
+    public interface LogSink {
+        /**
+         * Called on the native log writer thread with each batch of records, in the order they were logged
+         * (per thread).  Slow sinks hold up the writer and cause records to be dropped once the queue fills, so
+         * hand records off rather than doing I/O here if logging is heavy.
+         * @param records the batch of records
+         */
+        void onLogRecords(List<LogRecord> records);
+    }
+
+    /**
+     * Tuning for asynchronous logging
+     */
+    public static class AsyncLoggingOptions {
+        private LogFormat format = LogFormat.Text;
+        private int queueCapacity = 0;
+        private int maxRecordsPerSubjectPerSecond = 0;
+        private final Map<LogSubject, LogLevel> subjectLevels = new EnumMap<>(LogSubject.class);
+
+        public AsyncLoggingOptions() {}
+
+        /**
+         * @param format how records are encoded, ignored for sinks. Defaults to Text.
+         * @return this options object
+         */
+        public AsyncLoggingOptions withFormat(LogFormat format) {
+            this.format = format;
+            return this;
+        }
+
+        /**
+         * @return how records are encoded
+         */
+        public LogFormat getFormat() { return format; }
+
+        /**
+         * @param queueCapacity how many records can be waiting for the writer before new records are dropped,
+         *                      rounded up to a power of two.  0 uses the default of 4096.
+         * @return this options object
+         */
+        public AsyncLoggingOptions withQueueCapacity(int queueCapacity) {
+            this.queueCapacity = queueCapacity;
+            return this;
+        }
+
+        /**
+         * @return how many records can be waiting for the writer
+         */
+        public int getQueueCapacity() { return queueCapacity; }
+
+        /**
+         * @param maxRecordsPerSubjectPerSecond records each log subject may log per second before the rest of
+         *                                      that second's records are dropped.  0, the default, is no limit.
+         * @return this options object
+         */
+        public AsyncLoggingOptions withMaxRecordsPerSubjectPerSecond(int maxRecordsPerSubjectPerSecond) {
+            this.maxRecordsPerSubjectPerSecond = maxRecordsPerSubjectPerSecond;
+            return this;
+        }
+
+        /**
+         * @return records each log subject may log per second, 0 for no limit
+         */
+        public int getMaxRecordsPerSubjectPerSecond() { return maxRecordsPerSubjectPerSecond; }
+
+        /**
+         * Filters one subject at its own level instead of the level logging was initialized with, e.g. to trace
+         * a single subsystem without tracing everything.  Only asynchronous logging supports this.
+         * @param subject the subject to filter separately
+         * @param level the filter level to apply to that subject's log calls
+         * @return this options object
+         */
+        public AsyncLoggingOptions withSubjectLevel(LogSubject subject, LogLevel level) {
+            if (subject == null || level == null) {
+                throw new IllegalArgumentException("AsyncLoggingOptions.withSubjectLevel: subject and level must not be null");
+            }
+            subjectLevels.put(subject, level);
+            return this;
+        }
+
+        /**
+         * @return the subjects filtered at their own level, and their levels
+         */
+        public Map<LogSubject, LogLevel> getSubjectLevels() { return Collections.unmodifiableMap(subjectLevels); }
+    }
+
     /**
      * Logs a message at the specified log level.
      * @param level (for filtering purposes) level attached to the log invocation
@@ -150,6 +317,36 @@ public class Log {
             level = LogLevel.valueOf(levelString);
         }
 
+        if (Boolean.parseBoolean(System.getProperty(LOG_ASYNC_PROPERTY_NAME))) {
+            AsyncLoggingOptions options = new AsyncLoggingOptions();
+            String formatString = System.getProperty(LOG_FORMAT_PROPERTY_NAME);
+            if (formatString != null) {
+                options.withFormat(LogFormat.valueOf(formatString));
+            }
+            String rateLimitString = System.getProperty(LOG_RATE_LIMIT_PROPERTY_NAME);
+            if (rateLimitString != null) {
+                options.withMaxRecordsPerSubjectPerSecond(Integer.parseInt(rateLimitString));
+            }
+
+            switch(destination) {
+                case Stdout:
+                case Stderr:
+                    initAsyncLogging(level, destination, null, null, options);
+                    break;
+
+                case File:
+                    if (filenameString == null) {
+                        return;
+                    }
+
+                    initAsyncLogging(level, destination, filenameString, null, options);
+                    break;
+                default:
+                    break;
+            }
+            return;
+        }
+
         switch(destination) {
             case Stdout:
                 initLoggingToStdout(level.getValue());
@@ -167,6 +364,7 @@ public class Log {
                 initLoggingToFile(level.getValue(), filenameString);
                 break;
             case None:
+            case Sink:
                 break;
         }
     }
@@ -196,6 +394,104 @@ public class Log {
         initLoggingToFile(level.getValue(), filename);
     }
 
+    /**
+     * Initializes asynchronous logging to stdout.  Records are formatted and written on a background thread
+     * instead of the thread that logs them.
+     * @param level the filter level to apply to log calls
+     * @param options encoding, queueing and rate limiting options
+     */
+    public static void initAsyncLoggingToStdout(LogLevel level, AsyncLoggingOptions options) {
+        initAsyncLogging(level, LogDestination.Stdout, null, null, options);
+    }
+
+    /**
+     * Initializes asynchronous logging to stderr.  Records are formatted and written on a background thread
+     * instead of the thread that logs them.
+     * @param level the filter level to apply to log calls
+     * @param options encoding, queueing and rate limiting options
+     */
+    public static void initAsyncLoggingToStderr(LogLevel level, AsyncLoggingOptions options) {
+        initAsyncLogging(level, LogDestination.Stderr, null, null, options);
+    }
+
+    /**
+     * Initializes asynchronous logging to a file.  Records are formatted and written on a background thread
+     * instead of the thread that logs them.
+     * @param level the filter level to apply to log calls
+     * @param filename name of the file to direct logging to
+     * @param options encoding, queueing and rate limiting options
+     */
+    public static void initAsyncLoggingToFile(LogLevel level, String filename, AsyncLoggingOptions options) {
+        if (filename == null) {
+            throw new IllegalArgumentException("Log.initAsyncLoggingToFile: filename must not be null");
+        }
+        initAsyncLogging(level, LogDestination.File, filename, null, options);
+    }
+
+    /**
+     * Initializes asynchronous logging to a sink, which receives records in batches on a background thread.  The
+     * options' format is ignored.
+     * @param level the filter level to apply to log calls
+     * @param sink receives the log records
+     * @param options queueing and rate limiting options
+     */
+    public static void initAsyncLoggingToSink(LogLevel level, LogSink sink, AsyncLoggingOptions options) {
+        if (sink == null) {
+            throw new IllegalArgumentException("Log.initAsyncLoggingToSink: sink must not be null");
+        }
+        initAsyncLogging(level, LogDestination.Sink, null, sink, options);
+    }
+
+    private static void initAsyncLogging(LogLevel level, LogDestination destination, String filename, LogSink sink,
+            AsyncLoggingOptions options) {
+        if (options == null) {
+            options = new AsyncLoggingOptions();
+        }
+
+        Map<LogSubject, LogLevel> subjectLevels = options.getSubjectLevels();
+        int[] subjects = new int[subjectLevels.size()];
+        int[] levels = new int[subjectLevels.size()];
+        int i = 0;
+        for (Map.Entry<LogSubject, LogLevel> subjectLevel : subjectLevels.entrySet()) {
+            subjects[i] = subjectLevel.getKey().getValue();
+            levels[i] = subjectLevel.getValue().getValue();
+            ++i;
+        }
+
+        initAsyncLogging(level.getValue(), destination.ordinal(), filename, sink, options.getFormat().getValue(),
+                options.getQueueCapacity(), options.getMaxRecordsPerSubjectPerSecond(), subjects, levels);
+    }
+
+    /**
+     * Stops logging.  Asynchronous logging writes or delivers every record still queued first, and closes its
+     * file.  Like initialization, this is NOT safe while other threads may be logging.
+     */
+    public static void shutdownLogging() {
+        shutdownLoggingNative();
+    }
+
+    /*
+     * Called from the native log writer thread.  Must match the binary encoding in async_logger.c:
+     * [timestamp ns: 8][level: 4][subject: 4][thread length: 4][thread][message length: 4][message]
+     */
+    private static void deliverLogBatch(LogSink sink, ByteBuffer batch, int recordCount) {
+        LogLevel[] levels = LogLevel.values();
+        List<LogRecord> records = new ArrayList<>(recordCount);
+        for (int i = 0; i < recordCount; ++i) {
+            long timestampNs = batch.getLong();
+            int level = batch.getInt();
+            int subject = batch.getInt();
+            byte[] thread = new byte[batch.getInt()];
+            batch.get(thread);
+            byte[] message = new byte[batch.getInt()];
+            batch.get(message);
+            records.add(new LogRecord(timestampNs, level >= 0 && level < levels.length ? levels[level] : LogLevel.None,
+                    subject, new String(thread, StandardCharsets.UTF_8), new String(message, StandardCharsets.UTF_8)));
+        }
+
+        sink.onLogRecords(records);
+    }
+
     /*******************************************************************************
      * native methods
      ******************************************************************************/
@@ -204,4 +500,7 @@ public class Log {
     private static native void initLoggingToStdout(int level);
     private static native void initLoggingToStderr(int level);
     private static native void initLoggingToFile(int level, String filename);
+    private static native void initAsyncLogging(int level, int destination, String filename, LogSink sink, int format,
+            int queueCapacity, int maxRecordsPerSubjectPerSecond, int[] subjects, int[] subjectLevels);
+    private static native void shutdownLoggingNative();
 };
@@ -18,6 +18,7 @@ public class CachedCredentialsProvider extends CredentialsProvider {
     static public class CachedCredentialsProviderBuilder {
 
         private int cachingDurationInSeconds;
+        private int refreshAheadInSeconds;
         private CredentialsProvider cachedProvider;
 
         /**
@@ -39,6 +40,25 @@ public class CachedCredentialsProvider extends CredentialsProvider {
 
         int getCachingDurationInSeconds() { return cachingDurationInSeconds; }
 
+        /**
+         * Sets how long before cached credentials expire to start refreshing them.  A refresh is started in the
+         * background by the first request for credentials inside this window, and requests go on receiving the
+         * cached credentials until it completes, so they never wait on a slow credentials source while anything
+         * usable is cached.  A failed refresh leaves the cached credentials in use until they expire.
+         *
+         * If zero (the default), credentials are only fetched once they have expired, and requests wait for the
+         * fetch.  In both cases, concurrent requests while nothing usable is cached share a single fetch.
+         * @param refreshAheadInSeconds how long before expiration to refresh credentials, in seconds
+         * @return the provider builder
+         */
+        public CachedCredentialsProviderBuilder withRefreshAheadInSeconds(int refreshAheadInSeconds) {
+            this.refreshAheadInSeconds = refreshAheadInSeconds;
+
+            return this;
+        }
+
+        int getRefreshAheadInSeconds() { return refreshAheadInSeconds; }
+
         /**
          * Sets the credentials provider to cache results from
          * @param cachedProvider credentials provider to cache results from
@@ -67,7 +87,7 @@ public class CachedCredentialsProvider extends CredentialsProvider {
         cachedProvider = builder.getCachedProvider();
         addReferenceTo(cachedProvider);
 
-        long nativeHandle = cachedCredentialsProviderNew(this, builder.getCachingDurationInSeconds(), cachedProvider.getNativeHandle());
+        long nativeHandle = cachedCredentialsProviderNew(this, builder.getCachingDurationInSeconds(), builder.getRefreshAheadInSeconds(), cachedProvider.getNativeHandle());
         acquireNativeHandle(nativeHandle);
     }
 
@@ -75,5 +95,5 @@ public class CachedCredentialsProvider extends CredentialsProvider {
      * Native methods
      ******************************************************************************/
 
-    private static native long cachedCredentialsProviderNew(CachedCredentialsProvider thisObj, int cachingDurationInSeconds, long cachedProvider);
+    private static native long cachedCredentialsProviderNew(CachedCredentialsProvider thisObj, int cachingDurationInSeconds, int refreshAheadInSeconds, long cachedProvider);
 }
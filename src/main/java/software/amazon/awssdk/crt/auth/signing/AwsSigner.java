@@ -4,6 +4,8 @@
  */
 package software.amazon.awssdk.crt.auth.signing;
 
+import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.concurrent.CompletableFuture;
 import java.util.List;
 
@@ -38,6 +40,34 @@ public class AwsSigner {
         return future;
     }
 
+    /**
+     * Signs a list of http requests according to the same signing configuration. The configuration is read, and
+     * credentials are sourced, once for the whole list rather than once per request; for SigV4a, the key derived
+     * from the credentials is shared by every request too.
+     * @param requests http requests to sign
+     * @param config signing configuration
+     * @return future which will contain the signed requests, in the same order.  It completes exceptionally if any
+     * of the requests fails to sign.
+     */
+    static public CompletableFuture<List<HttpRequest>> signRequests(List<HttpRequest> requests, AwsSigningConfig config) {
+        CompletableFuture<List<HttpRequest>> future = new CompletableFuture<List<HttpRequest>>();
+
+        CompletableFuture<List<AwsSigningResult>> results = signAll(requests, config);
+        results.whenComplete((res, throwable) -> {
+            if (throwable != null) {
+                future.completeExceptionally(throwable);
+            } else {
+                List<HttpRequest> signedRequests = new ArrayList<HttpRequest>(res.size());
+                for (AwsSigningResult result : res) {
+                    signedRequests.add(result.getSignedRequest());
+                }
+                future.complete(signedRequests);
+            }
+        });
+
+        return future;
+    }
+
     /**
      * Signs a body chunk according to the supplied signing configuration
      * @param chunkBody stream of bytes that make up the chunk
@@ -81,6 +111,42 @@ public class AwsSigner {
         return future;
     }
 
+    /**
+     * Signs a list of http requests according to the same signing configuration, see signRequests()
+     * @param requests http requests to sign
+     * @param config signing configuration
+     * @return future which will contain a signing result for each request, in the same order
+     */
+    static public CompletableFuture<List<AwsSigningResult>> signAll(List<HttpRequest> requests, AwsSigningConfig config) {
+        CompletableFuture<List<AwsSigningResult>> future = new CompletableFuture<List<AwsSigningResult>>();
+        if (requests.isEmpty()) {
+            future.complete(new ArrayList<AwsSigningResult>());
+            return future;
+        }
+
+        CompletableFuture<AwsSigningResult[]> nativeFuture = new CompletableFuture<AwsSigningResult[]>();
+        nativeFuture.whenComplete((res, throwable) -> {
+            if (throwable != null) {
+                future.completeExceptionally(throwable);
+            } else {
+                future.complete(Arrays.asList(res));
+            }
+        });
+
+        try {
+            HttpRequest[] requestArray = requests.toArray(new HttpRequest[0]);
+            byte[][] marshalledRequests = new byte[requestArray.length][];
+            for (int i = 0; i < requestArray.length; ++i) {
+                marshalledRequests[i] = requestArray[i].marshalForJni();
+            }
+            awsSignerSignRequests(requestArray, marshalledRequests, config, nativeFuture);
+        } catch (Exception e) {
+            future.completeExceptionally(e);
+        }
+
+        return future;
+    }
+
     /**
      * Signs a body chunk according to the supplied signing configuration
      * @param chunkBody stream of bytes that make up the chunk
@@ -134,6 +200,12 @@ public class AwsSigner {
         AwsSigningConfig config,
         CompletableFuture<AwsSigningResult> future) throws CrtRuntimeException;
 
+    private static native void awsSignerSignRequests(
+        HttpRequest[] requests,
+        byte[][] marshalledRequests,
+        AwsSigningConfig config,
+        CompletableFuture<AwsSigningResult[]> future) throws CrtRuntimeException;
+
     private static native void awsSignerSignChunk(
         HttpRequestBodyStream chunk,
         byte[] previousSignature,
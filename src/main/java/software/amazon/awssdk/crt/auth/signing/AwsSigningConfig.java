@@ -5,7 +5,9 @@
 package software.amazon.awssdk.crt.auth.signing;
 
 import java.util.function.Predicate;
+import java.util.Arrays;
 import java.util.HashMap;
+import java.util.List;
 import java.util.Map;
 
 import software.amazon.awssdk.crt.auth.credentials.Credentials;
@@ -225,6 +227,8 @@ public class AwsSigningConfig extends CrtResource {
     private String signedBodyValue = null;
     private int signedBodyHeader = AwsSignedBodyHeaderType.NONE.getNativeValue();
     private long expirationInSeconds = 0;
+    private String[] signedHeaderAllowList;
+    private String[] signedHeaderDenyList;
 
     /**
      * Default constructor
@@ -232,7 +236,7 @@ public class AwsSigningConfig extends CrtResource {
     public AwsSigningConfig() {}
 
     /**
-     * Creates a new signing configuration from this one.
+     * Creates a new signing configuration from this one.  The clone is never frozen.
      * @return a clone of this signing configuration
      */
     public AwsSigningConfig clone() {
@@ -252,6 +256,8 @@ public class AwsSigningConfig extends CrtResource {
             clone.setSignedBodyValue(getSignedBodyValue());
             clone.setSignedBodyHeader(getSignedBodyHeader());
             clone.setExpirationInSeconds(getExpirationInSeconds());
+            clone.setSignedHeaderAllowList(getSignedHeaderAllowList());
+            clone.setSignedHeaderDenyList(getSignedHeaderDenyList());
 
             // success, bump up the ref count so we can escape the try-with-resources block
             clone.addRef();
@@ -263,7 +269,11 @@ public class AwsSigningConfig extends CrtResource {
      * Required override method that must begin the release process of the acquired native handle
      */
     @Override
-    protected void releaseNativeHandle() {}
+    protected void releaseNativeHandle() {
+        if (!isNull()) {
+            awsSigningConfigRelease(getNativeHandle());
+        }
+    }
 
     /**
      * Override that determines whether a resource releases its dependencies at the same time the native handle is released or if it waits.
@@ -277,7 +287,7 @@ public class AwsSigningConfig extends CrtResource {
      * Sets what version of the AWS signing process should be used
      * @param algorithm desired version of the AWS signing process
      */
-    public void setAlgorithm(AwsSigningAlgorithm algorithm) { this.algorithm = algorithm.getNativeValue(); }
+    public void setAlgorithm(AwsSigningAlgorithm algorithm) { checkNotFrozen(); this.algorithm = algorithm.getNativeValue(); }
 
     /**
      * Gets what version of the AWS signing procecss will be used
@@ -291,7 +301,7 @@ public class AwsSigningConfig extends CrtResource {
      * Sets what sort of signature should be computed
      * @param signatureType what kind of signature to compute
      */
-    public void setSignatureType(AwsSignatureType signatureType) { this.signatureType = signatureType.getNativeValue(); }
+    public void setSignatureType(AwsSignatureType signatureType) { checkNotFrozen(); this.signatureType = signatureType.getNativeValue(); }
 
     /**
      * Gets what kind of signature will be computed
@@ -306,7 +316,7 @@ public class AwsSigningConfig extends CrtResource {
      * and so no validation is done on this parameter.  In sigv4a, this value is used for the "region-set" concept.
      * @param region region value to use when signing
      */
-    public void setRegion(String region) { this.region = region; }
+    public void setRegion(String region) { checkNotFrozen(); this.region = region; }
 
     /**
      * Gets what will be used for the region or region-set concept during signing.
@@ -318,7 +328,7 @@ public class AwsSigningConfig extends CrtResource {
      * Sets what service signing name to use.
      * @param service signing name of the service that this signing calculation should use
      */
-    public void setService(String service) { this.service = service; }
+    public void setService(String service) { checkNotFrozen(); this.service = service; }
 
     /**
      * Gets what service signing name will be used
@@ -344,6 +354,7 @@ public class AwsSigningConfig extends CrtResource {
      * @param credentialsProvider provider to retrieve credentials from prior to signing
      */
     public void setCredentialsProvider(CredentialsProvider credentialsProvider) {
+        checkNotFrozen();
         swapReferenceTo(this.credentialsProvider, credentialsProvider);
         this.credentialsProvider = credentialsProvider;
     }
@@ -358,7 +369,7 @@ public class AwsSigningConfig extends CrtResource {
      * Sets the credentials to use for signing.  Overrides the provider setting if non-null.
      * @param credentials credentials to use for signing
      */
-    public void setCredentials(Credentials credentials) { this.credentials = credentials; }
+    public void setCredentials(Credentials credentials) { checkNotFrozen(); this.credentials = credentials; }
 
     /**
      * Gets the credentials to use for signing.
@@ -370,7 +381,7 @@ public class AwsSigningConfig extends CrtResource {
      * Sets a header-name signing predicate filter.  Headers that do not pass the filter will not be signed.
      * @param shouldSignHeader header-name signing predicate filter
      */
-    public void setShouldSignHeader(Predicate<String> shouldSignHeader) { this.shouldSignHeader = shouldSignHeader; }
+    public void setShouldSignHeader(Predicate<String> shouldSignHeader) { checkNotFrozen(); this.shouldSignHeader = shouldSignHeader; }
 
     /**
      * Gets the header-name signing predicate filter to use
@@ -385,7 +396,7 @@ public class AwsSigningConfig extends CrtResource {
      * request in order to pass a signature check.
      * @param useDoubleUriEncode should signing uri encode urls in the canonical request
      */
-    public void setUseDoubleUriEncode(boolean useDoubleUriEncode) { this.useDoubleUriEncode = useDoubleUriEncode; }
+    public void setUseDoubleUriEncode(boolean useDoubleUriEncode) { checkNotFrozen(); this.useDoubleUriEncode = useDoubleUriEncode; }
 
     /**
      * Gets whether or not signing will uri encode urls during canonical request construction
@@ -397,7 +408,7 @@ public class AwsSigningConfig extends CrtResource {
      * Sets whether or not the uri path should be normalized during canonical request construction
      * @param shouldNormalizeUriPath whether or not the uri path should be normalized during canonical request construction
      */
-    public void setShouldNormalizeUriPath(boolean shouldNormalizeUriPath) { this.shouldNormalizeUriPath = shouldNormalizeUriPath; }
+    public void setShouldNormalizeUriPath(boolean shouldNormalizeUriPath) { checkNotFrozen(); this.shouldNormalizeUriPath = shouldNormalizeUriPath; }
 
     /**
      * Gets whether or not the uri path should be normalized during canonical request construction
@@ -417,7 +428,7 @@ public class AwsSigningConfig extends CrtResource {
      * @param omitSessionToken whether or not X-Amz-Session-Token should be added to the canonical request when signing with session
      *                         credentials
      */
-    public void setOmitSessionToken(boolean omitSessionToken) { this.omitSessionToken = omitSessionToken; }
+    public void setOmitSessionToken(boolean omitSessionToken) { checkNotFrozen(); this.omitSessionToken = omitSessionToken; }
 
     /**
      * Gets whether or not X-Amz-Session-Token should be added to the canonical request when signing with session
@@ -434,6 +445,7 @@ public class AwsSigningConfig extends CrtResource {
      * @param signedBodyValue payload hash override value to use in canonical request construction
      */
     public void setSignedBodyValue(String signedBodyValue) {
+        checkNotFrozen();
         if (signedBodyValue != null && signedBodyValue.isEmpty()) {
             throw new IllegalArgumentException("Signed Body Value must be null or non-empty string.");
         }
@@ -450,7 +462,7 @@ public class AwsSigningConfig extends CrtResource {
      * Sets what signed body header should hold the payload hash (or override value).
      * @param signedBodyHeader what signed body header should hold the payload hash (or override value)
      */
-    public void setSignedBodyHeader(AwsSignedBodyHeaderType signedBodyHeader) { this.signedBodyHeader = signedBodyHeader.getNativeValue(); }
+    public void setSignedBodyHeader(AwsSignedBodyHeaderType signedBodyHeader) { checkNotFrozen(); this.signedBodyHeader = signedBodyHeader.getNativeValue(); }
 
     /**
      * Gets what signed body header should hold the payload hash (or override value).
@@ -463,13 +475,79 @@ public class AwsSigningConfig extends CrtResource {
      * will be added to the URL when building the canonical and signed requests.
      * @param expirationInSeconds time in seconds that a pre-signed url will be valid for
      */
-    public void setExpirationInSeconds(long expirationInSeconds) { this.expirationInSeconds = expirationInSeconds; }
+    public void setExpirationInSeconds(long expirationInSeconds) { checkNotFrozen(); this.expirationInSeconds = expirationInSeconds; }
 
     /**
      * Gets the expiration time in seconds to use when signing to make a pre-signed url.
      * @return the expiration time in seconds for a pre-signed url
      */
     public long getExpirationInSeconds() { return expirationInSeconds; }
+
+    /**
+     * Sets the only headers that may be signed, matched by name without regard to case.  Unlike a
+     * shouldSignHeader predicate, the list is checked natively, without calling back into Java for every header.
+     * Host, which SigV4 requires to be signed, and the headers the signer adds itself, such as X-Amz-Date, are
+     * signed whether listed or not.
+     * @param headerNames names of the headers that may be signed, or null to allow all headers
+     */
+    public void setSignedHeaderAllowList(List<String> headerNames) {
+        checkNotFrozen();
+        this.signedHeaderAllowList = headerNames != null ? headerNames.toArray(new String[0]) : null;
+    }
+
+    /**
+     * Gets the only headers that may be signed
+     * @return names of the headers that may be signed, or null if all headers may be
+     */
+    public List<String> getSignedHeaderAllowList() {
+        return signedHeaderAllowList != null ? Arrays.asList(signedHeaderAllowList.clone()) : null;
+    }
+
+    /**
+     * Sets headers that must not be signed, matched by name without regard to case.  Like the allow list, the deny
+     * list is checked natively; a shouldSignHeader predicate, if set, is only consulted for headers that pass both.
+     * @param headerNames names of the headers that must not be signed, or null to deny none
+     */
+    public void setSignedHeaderDenyList(List<String> headerNames) {
+        checkNotFrozen();
+        this.signedHeaderDenyList = headerNames != null ? headerNames.toArray(new String[0]) : null;
+    }
+
+    /**
+     * Gets the headers that must not be signed
+     * @return names of the headers that must not be signed, or null if none are denied
+     */
+    public List<String> getSignedHeaderDenyList() {
+        return signedHeaderDenyList != null ? Arrays.asList(signedHeaderDenyList.clone()) : null;
+    }
+
+    /**
+     * Builds the native form of this configuration once, for every later signing call to share, instead of
+     * rebuilding it from this object's fields on each call.  Afterwards only the time can be changed; every other
+     * setter throws IllegalStateException.  Use clone() for a modifiable copy.
+     */
+    public void freeze() {
+        if (isNull()) {
+            acquireNativeHandle(awsSigningConfigNew(this));
+        }
+    }
+
+    /**
+     * @return whether freeze() has been called on this configuration
+     */
+    public boolean isFrozen() { return !isNull(); }
+
+    private void checkNotFrozen() {
+        if (isFrozen()) {
+            throw new IllegalStateException("AwsSigningConfig is frozen; only its time can be changed");
+        }
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+    private static native long awsSigningConfigNew(AwsSigningConfig config);
+    private static native void awsSigningConfigRelease(long signingConfig);
 }
 
 
@@ -0,0 +1,160 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.cal;
+
+import software.amazon.awssdk.crt.CrtResource;
+
+import java.nio.ByteBuffer;
+
+/**
+ * A streaming hash or HMAC computed natively by aws-c-cal, using the platform's accelerated implementation (aws-lc on
+ * Linux).  Feed it data with update(), then call digest() once for the result; a Hash can't be reused after that.
+ *
+ * Not thread safe: a Hash must only be used by one thread at a time.
+ */
+public final class Hash extends CrtResource {
+
+    /* Must match aws_jni_hash_algorithm in hash.c */
+    private static final int SHA256 = 0;
+    private static final int SHA1 = 1;
+    private static final int MD5 = 2;
+    private static final int SHA256_HMAC = 3;
+
+    private static final int READ_ONLY_CHUNK_SIZE = 8192;
+
+    private boolean finished = false;
+
+    private Hash(int algorithm, byte[] secret) {
+        acquireNativeHandle(hashNew(algorithm, secret));
+    }
+
+    /**
+     * @return a new SHA-256 hash
+     */
+    public static Hash createSha256() {
+        return new Hash(SHA256, null);
+    }
+
+    /**
+     * @return a new SHA-1 hash
+     */
+    public static Hash createSha1() {
+        return new Hash(SHA1, null);
+    }
+
+    /**
+     * @return a new MD5 hash
+     */
+    public static Hash createMd5() {
+        return new Hash(MD5, null);
+    }
+
+    /**
+     * @param secret the HMAC key
+     * @return a new HMAC, using SHA-256
+     */
+    public static Hash createSha256Hmac(byte[] secret) {
+        if (secret == null) {
+            throw new NullPointerException("secret");
+        }
+        return new Hash(SHA256_HMAC, secret);
+    }
+
+    /**
+     * Determines whether a resource releases its dependencies at the same time the native handle is released or if it waits.
+     * Resources that wait are responsible for calling releaseReferences() manually.
+     */
+    @Override
+    protected boolean canReleaseReferencesImmediately() { return true; }
+
+    /**
+     * Frees the native hash
+     */
+    @Override
+    protected void releaseNativeHandle() {
+        if (!isNull()) {
+            hashDestroy(getNativeHandle());
+        }
+    }
+
+    /**
+     * Updates the hash with a slice of an array
+     * @param input the array holding the data
+     * @param offset the offset of the data in input
+     * @param length the length of the data
+     */
+    public void update(byte[] input, int offset, int length) {
+        checkUsable();
+        hashUpdate(getNativeHandle(), input, offset, length);
+    }
+
+    /**
+     * Updates the hash with an array
+     * @param input the data
+     */
+    public void update(byte[] input) {
+        update(input, 0, input.length);
+    }
+
+    /**
+     * Updates the hash with the bytes remaining in the buffer, from its position to its limit.  Upon return the
+     * buffer's position will be equal to its limit.
+     * <p>
+     * Direct buffers are hashed in place, without copying them to the Java heap.
+     *
+     * @param buffer the data
+     */
+    public void update(ByteBuffer buffer) {
+        checkUsable();
+        int position = buffer.position();
+        int length = buffer.remaining();
+        if (length == 0) {
+            return;
+        }
+        if (buffer.isDirect()) {
+            hashUpdateDirect(getNativeHandle(), buffer, position, length);
+        } else if (buffer.hasArray()) {
+            hashUpdate(getNativeHandle(), buffer.array(), buffer.arrayOffset() + position, length);
+        } else {
+            /* read-only heap buffer, its backing array is not accessible */
+            byte[] chunk = new byte[Math.min(length, READ_ONLY_CHUNK_SIZE)];
+            ByteBuffer source = buffer.duplicate();
+            while (source.hasRemaining()) {
+                int chunkLength = Math.min(source.remaining(), chunk.length);
+                source.get(chunk, 0, chunkLength);
+                hashUpdate(getNativeHandle(), chunk, 0, chunkLength);
+            }
+        }
+        buffer.position(buffer.limit());
+    }
+
+    /**
+     * Completes the hash.  No further updates may be made.
+     * @return the digest of everything the hash was updated with
+     */
+    public byte[] digest() {
+        checkUsable();
+        finished = true;
+        return hashDigest(getNativeHandle());
+    }
+
+    private void checkUsable() {
+        if (isNull()) {
+            throw new IllegalStateException("close() has already been called on this object.");
+        }
+        if (finished) {
+            throw new IllegalStateException("Hash.digest() has already been called");
+        }
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+    private static native long hashNew(int algorithm, byte[] secret);
+    private static native void hashDestroy(long hash);
+    private static native void hashUpdate(long hash, byte[] input, int offset, int length);
+    private static native void hashUpdateDirect(long hash, ByteBuffer input, int position, int length);
+    private static native byte[] hashDigest(long hash);
+}
@@ -5,6 +5,8 @@
 package software.amazon.awssdk.crt.checksums;
 
 import software.amazon.awssdk.crt.CRT;
+
+import java.nio.ByteBuffer;
 import java.util.zip.Checksum;
 
 /**
@@ -15,6 +17,7 @@ public class CRC32 implements Checksum, Cloneable {
         new CRT();
     };
 
+    private static final int READ_ONLY_CHUNK_SIZE = 8192;
     private int value = 0;
 
     /**
@@ -91,8 +94,61 @@ public class CRC32 implements Checksum, Cloneable {
         this.update(buf);
     }
 
+    /**
+     * Updates the current checksum with the bytes remaining in the buffer, from its position to its limit.
+     * Upon return the buffer's position will be equal to its limit.
+     * <p>
+     * Direct buffers are checksummed in place, without copying them to the Java heap.
+     *
+     * @param buffer the buffer to update the checksum with
+     */
+    public void update(ByteBuffer buffer) {
+        if (buffer == null) {
+            throw new NullPointerException();
+        }
+        int position = buffer.position();
+        int length = buffer.remaining();
+        if (length == 0) {
+            return;
+        }
+        if (buffer.isDirect()) {
+            value = crc32Direct(buffer, value, position, length);
+        } else if (buffer.hasArray()) {
+            value = crc32(buffer.array(), value, buffer.arrayOffset() + position, length);
+        } else {
+            /* read-only heap buffer, its backing array is not accessible */
+            byte[] chunk = new byte[Math.min(length, READ_ONLY_CHUNK_SIZE)];
+            ByteBuffer source = buffer.duplicate();
+            while (source.hasRemaining()) {
+                int chunkLength = Math.min(source.remaining(), chunk.length);
+                source.get(chunk, 0, chunkLength);
+                value = crc32(chunk, value, 0, chunkLength);
+            }
+        }
+        buffer.position(buffer.limit());
+    }
+
+    /**
+     * Combines the checksums of two consecutive blocks of data into the checksum of their concatenation,
+     * without access to the data itself. Lets checksums computed separately, such as per part or on
+     * different threads, be merged into a checksum of the whole.
+     *
+     * @param crcA the checksum of the first block
+     * @param crcB the checksum of the second block
+     * @param lengthB the length of the second block, in bytes
+     * @return the checksum of the first block followed by the second
+     */
+    public static int combine(int crcA, int crcB, long lengthB) {
+        if (lengthB < 0) {
+            throw new IllegalArgumentException("lengthB must not be negative");
+        }
+        return crc32Combine(crcA, crcB, lengthB);
+    }
+
     /*******************************************************************************
      * native methods
      ******************************************************************************/
-    private static native int crc32(byte[] input, int previous, int offset, int length);;
+    private static native int crc32(byte[] input, int previous, int offset, int length);
+    private static native int crc32Direct(ByteBuffer input, int previous, int position, int length);
+    private static native int crc32Combine(int crcA, int crcB, long lengthB);
 }
@@ -0,0 +1,145 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.checksums;
+
+import software.amazon.awssdk.crt.CRT;
+
+import java.nio.ByteBuffer;
+import java.util.zip.Checksum;
+
+/**
+ * CRT implementation of the Java Checksum interface for making CRC64NVME checksum calculations.
+ * <p>
+ * CRC64NVME is the 64 bit crc S3 uses for full object checksums
+ */
+public class CRC64NVME implements Checksum, Cloneable {
+    static {
+        new CRT();
+    };
+    private static final int READ_ONLY_CHUNK_SIZE = 8192;
+    private long value = 0;
+
+    /**
+     * Default constructor
+     */
+    public CRC64NVME() {
+    }
+
+    private CRC64NVME(long value) {
+        this.value = value;
+    }
+
+    @Override
+    public Object clone() {
+        return new CRC64NVME(value);
+    }
+
+    /**
+     * Returns the current checksum value.
+     *
+     * @return the current checksum value.
+     */
+    @Override
+    public long getValue() {
+        return value;
+    }
+
+    /**
+     * Resets the checksum to its initial value.
+     */
+    @Override
+    public void reset() {
+        value = 0;
+    }
+
+    /**
+     * Updates the current checksum with the specified array of bytes.
+     *
+     * @param b the byte array to update the checksum with
+     * @param off the starting offset within b of the data to use
+     * @param len the number of bytes to use in the update
+     */
+    @Override
+    public void update(byte[] b, int off, int len) {
+        if (b == null) {
+            throw new NullPointerException();
+        }
+        if (off < 0 || len < 0 || off > b.length - len) {
+            throw new ArrayIndexOutOfBoundsException();
+        }
+        value = crc64nvme(b, value, off, len);
+    }
+
+    public void update(byte[] b) {
+        value = crc64nvme(b, value, 0, b.length);
+    }
+
+    @Override
+    public void update(int b) {
+        if (b < 0 || b > 0xff) {
+            throw new IllegalArgumentException();
+        }
+        byte[] buf = { (byte) (b & 0x000000ff) };
+        this.update(buf);
+    }
+
+    /**
+     * Updates the current checksum with the bytes remaining in the buffer, from its position to its limit.
+     * Upon return the buffer's position will be equal to its limit.
+     * <p>
+     * Direct buffers are checksummed in place, without copying them to the Java heap.
+     *
+     * @param buffer the buffer to update the checksum with
+     */
+    public void update(ByteBuffer buffer) {
+        if (buffer == null) {
+            throw new NullPointerException();
+        }
+        int position = buffer.position();
+        int length = buffer.remaining();
+        if (length == 0) {
+            return;
+        }
+        if (buffer.isDirect()) {
+            value = crc64nvmeDirect(buffer, value, position, length);
+        } else if (buffer.hasArray()) {
+            value = crc64nvme(buffer.array(), value, buffer.arrayOffset() + position, length);
+        } else {
+            /* read-only heap buffer, its backing array is not accessible */
+            byte[] chunk = new byte[Math.min(length, READ_ONLY_CHUNK_SIZE)];
+            ByteBuffer source = buffer.duplicate();
+            while (source.hasRemaining()) {
+                int chunkLength = Math.min(source.remaining(), chunk.length);
+                source.get(chunk, 0, chunkLength);
+                value = crc64nvme(chunk, value, 0, chunkLength);
+            }
+        }
+        buffer.position(buffer.limit());
+    }
+
+    /**
+     * Combines the checksums of two consecutive blocks of data into the checksum of their concatenation,
+     * without access to the data itself. Lets checksums computed separately, such as per part or on
+     * different threads, be merged into a checksum of the whole.
+     *
+     * @param crcA the checksum of the first block
+     * @param crcB the checksum of the second block
+     * @param lengthB the length of the second block, in bytes
+     * @return the checksum of the first block followed by the second
+     */
+    public static long combine(long crcA, long crcB, long lengthB) {
+        if (lengthB < 0) {
+            throw new IllegalArgumentException("lengthB must not be negative");
+        }
+        return crc64nvmeCombine(crcA, crcB, lengthB);
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+    private static native long crc64nvme(byte[] input, long previous, int offset, int length);
+    private static native long crc64nvmeDirect(ByteBuffer input, long previous, int position, int length);
+    private static native long crc64nvmeCombine(long crcA, long crcB, long lengthB);
+}
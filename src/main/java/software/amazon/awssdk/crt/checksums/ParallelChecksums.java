@@ -0,0 +1,233 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.checksums;
+
+import java.io.IOException;
+import java.io.UncheckedIOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.Executor;
+import java.util.concurrent.ForkJoinPool;
+
+/**
+ * Computes CRC32 and CRC32C checksums of large buffers and files on several threads at once.
+ * <p>
+ * The data is split into contiguous segments, each segment is checksummed on its own thread, and the partial
+ * checksums are merged with {@link CRC32#combine} / {@link CRC32C#combine}. The result is identical to
+ * checksumming the data sequentially.
+ */
+public final class ParallelChecksums {
+
+    /**
+     * Data is never split into segments smaller than this, below which the cost of handing a segment to another
+     * thread outweighs the time spent checksumming it.
+     */
+    public static final int MIN_SEGMENT_SIZE = 1 << 20;
+
+    /* upper bound on the size of a single memory-mapped file segment */
+    private static final long MAX_FILE_SEGMENT_SIZE = 1L << 30;
+
+    private interface Algorithm {
+        int compute(ByteBuffer segment);
+        int combine(int crcA, int crcB, long lengthB);
+    }
+
+    private static final Algorithm CRC32_ALGORITHM = new Algorithm() {
+        @Override
+        public int compute(ByteBuffer segment) {
+            CRC32 crc = new CRC32();
+            crc.update(segment);
+            return (int) crc.getValue();
+        }
+
+        @Override
+        public int combine(int crcA, int crcB, long lengthB) {
+            return CRC32.combine(crcA, crcB, lengthB);
+        }
+    };
+
+    private static final Algorithm CRC32C_ALGORITHM = new Algorithm() {
+        @Override
+        public int compute(ByteBuffer segment) {
+            CRC32C crc = new CRC32C();
+            crc.update(segment);
+            return (int) crc.getValue();
+        }
+
+        @Override
+        public int combine(int crcA, int crcB, long lengthB) {
+            return CRC32C.combine(crcA, crcB, lengthB);
+        }
+    };
+
+    private interface SegmentTask {
+        int compute(long offset, long length) throws IOException;
+    }
+
+    private ParallelChecksums() {
+    }
+
+    /**
+     * Computes the CRC32 of the bytes remaining in the buffer, using the common ForkJoinPool.
+     * Upon return the buffer's position will be equal to its limit.
+     *
+     * @param buffer the data to checksum
+     * @param parallelism maximum number of segments to checksum concurrently
+     * @return the CRC32 of the data
+     */
+    public static int crc32(ByteBuffer buffer, int parallelism) {
+        return crc32(buffer, parallelism, ForkJoinPool.commonPool());
+    }
+
+    /**
+     * Computes the CRC32 of the bytes remaining in the buffer.
+     * Upon return the buffer's position will be equal to its limit.
+     *
+     * @param buffer the data to checksum
+     * @param parallelism maximum number of segments to checksum concurrently
+     * @param executor executor to run segments on, the calling thread also checksums one segment
+     * @return the CRC32 of the data
+     */
+    public static int crc32(ByteBuffer buffer, int parallelism, Executor executor) {
+        return compute(CRC32_ALGORITHM, buffer, parallelism, executor);
+    }
+
+    /**
+     * Computes the CRC32C of the bytes remaining in the buffer, using the common ForkJoinPool.
+     * Upon return the buffer's position will be equal to its limit.
+     *
+     * @param buffer the data to checksum
+     * @param parallelism maximum number of segments to checksum concurrently
+     * @return the CRC32C of the data
+     */
+    public static int crc32c(ByteBuffer buffer, int parallelism) {
+        return crc32c(buffer, parallelism, ForkJoinPool.commonPool());
+    }
+
+    /**
+     * Computes the CRC32C of the bytes remaining in the buffer.
+     * Upon return the buffer's position will be equal to its limit.
+     *
+     * @param buffer the data to checksum
+     * @param parallelism maximum number of segments to checksum concurrently
+     * @param executor executor to run segments on, the calling thread also checksums one segment
+     * @return the CRC32C of the data
+     */
+    public static int crc32c(ByteBuffer buffer, int parallelism, Executor executor) {
+        return compute(CRC32C_ALGORITHM, buffer, parallelism, executor);
+    }
+
+    /**
+     * Computes the CRC32 of a file's contents, using the common ForkJoinPool.
+     * Segments of the file are memory-mapped and checksummed in place.
+     *
+     * @param file the file to checksum
+     * @param parallelism maximum number of segments to checksum concurrently
+     * @return the CRC32 of the file
+     * @throws IOException if the file cannot be read
+     */
+    public static int crc32(Path file, int parallelism) throws IOException {
+        return compute(CRC32_ALGORITHM, file, parallelism, ForkJoinPool.commonPool());
+    }
+
+    /**
+     * Computes the CRC32C of a file's contents, using the common ForkJoinPool.
+     * Segments of the file are memory-mapped and checksummed in place.
+     *
+     * @param file the file to checksum
+     * @param parallelism maximum number of segments to checksum concurrently
+     * @return the CRC32C of the file
+     * @throws IOException if the file cannot be read
+     */
+    public static int crc32c(Path file, int parallelism) throws IOException {
+        return compute(CRC32C_ALGORITHM, file, parallelism, ForkJoinPool.commonPool());
+    }
+
+    private static int compute(Algorithm algorithm, ByteBuffer buffer, int parallelism, Executor executor) {
+        if (buffer == null || executor == null) {
+            throw new NullPointerException();
+        }
+        int start = buffer.position();
+        int length = buffer.remaining();
+        int result;
+        try {
+            int segmentCount = segmentCount(length, parallelism, Integer.MAX_VALUE);
+            result = computeSegments(algorithm, length, segmentCount, executor, (offset, segmentLength) -> {
+                ByteBuffer segment = buffer.duplicate();
+                segment.position(start + (int) offset);
+                segment.limit(start + (int) (offset + segmentLength));
+                return algorithm.compute(segment);
+            });
+        } catch (IOException ex) {
+            /* not reachable, buffer segments don't do I/O */
+            throw new UncheckedIOException(ex);
+        }
+        buffer.position(buffer.limit());
+        return result;
+    }
+
+    private static int compute(Algorithm algorithm, Path file, int parallelism, Executor executor)
+            throws IOException {
+        if (file == null) {
+            throw new NullPointerException();
+        }
+        try (FileChannel channel = FileChannel.open(file, StandardOpenOption.READ)) {
+            long length = channel.size();
+            return computeSegments(algorithm, length, segmentCount(length, parallelism, MAX_FILE_SEGMENT_SIZE),
+                    executor, (offset, segmentLength) -> algorithm.compute(
+                            channel.map(FileChannel.MapMode.READ_ONLY, offset, segmentLength)));
+        }
+    }
+
+    private static int segmentCount(long length, int parallelism, long maxSegmentSize) {
+        if (parallelism < 1) {
+            throw new IllegalArgumentException("parallelism must be at least 1");
+        }
+        long count = Math.min(parallelism, Math.max(1, length / MIN_SEGMENT_SIZE));
+        /* never exceed the maximum segment size, even if that means more segments than requested */
+        count = Math.max(count, (length + maxSegmentSize - 1) / maxSegmentSize);
+        return (int) Math.max(1, count);
+    }
+
+    private static int computeSegments(Algorithm algorithm, long length, int segmentCount, Executor executor,
+            SegmentTask task) throws IOException {
+        long segmentSize = (length + segmentCount - 1) / segmentCount;
+        if (segmentCount == 1) {
+            return task.compute(0, length);
+        }
+
+        @SuppressWarnings("unchecked")
+        CompletableFuture<Integer>[] futures = new CompletableFuture[segmentCount];
+        for (int i = 1; i < segmentCount; ++i) {
+            long offset = Math.min(length, i * segmentSize);
+            long segmentLength = Math.min(segmentSize, length - offset);
+            futures[i] = CompletableFuture.supplyAsync(() -> {
+                try {
+                    return task.compute(offset, segmentLength);
+                } catch (IOException ex) {
+                    throw new UncheckedIOException(ex);
+                }
+            }, executor);
+        }
+
+        int result = task.compute(0, Math.min(segmentSize, length));
+        try {
+            for (int i = 1; i < segmentCount; ++i) {
+                long offset = Math.min(length, i * segmentSize);
+                result = algorithm.combine(result, futures[i].join(), Math.min(segmentSize, length - offset));
+            }
+        } catch (CompletionException ex) {
+            if (ex.getCause() instanceof UncheckedIOException) {
+                throw ((UncheckedIOException) ex.getCause()).getCause();
+            }
+            throw ex;
+        }
+        return result;
+    }
+}
@@ -1,6 +1,7 @@
 package software.amazon.awssdk.crt.eventstream;
 
 import software.amazon.awssdk.crt.CRT;
+import software.amazon.awssdk.crt.CallbackDispatcher;
 import software.amazon.awssdk.crt.CrtResource;
 import software.amazon.awssdk.crt.CrtRuntimeException;
 import software.amazon.awssdk.crt.io.ClientBootstrap;
@@ -106,11 +107,31 @@ public class ClientConnection extends CrtResource {
      * @return The new continuation object.
      */
     public ClientConnectionContinuation newStream(final ClientConnectionContinuationHandler continuationHandler) {
+        return newStream(continuationHandler, null);
+    }
+
+    /**
+     * Create a new stream whose messages and close notification are delivered by a CallbackDispatcher, rather than
+     * on the connection's event loop. Activate() must be called on the stream for it to actually initiate the new
+     * stream.
+     * @param continuationHandler handler to process continuation messages and state changes.
+     * @param dispatcher (optional) dispatcher to deliver the handler's callbacks, null to deliver them on the
+     *                   event loop.
+     * @return The new continuation object.
+     */
+    public ClientConnectionContinuation newStream(final ClientConnectionContinuationHandler continuationHandler,
+                                                  final CallbackDispatcher dispatcher) {
         if (isNull()) {
             throw new IllegalStateException("close() has already been called on this object.");
         }
+        if (dispatcher != null && dispatcher.isNull()) {
+            throw new IllegalStateException("CallbackDispatcher has already been closed.");
+        }
 
-        long continuationHandle = newClientStream(getNativeHandle(), continuationHandler);
+        long continuationHandle = dispatcher == null
+                ? newClientStream(getNativeHandle(), continuationHandler, 0, null)
+                : newClientStream(getNativeHandle(), continuationHandler, dispatcher.getNativeHandle(),
+                        new ClientConnectionContinuationDispatchTarget(continuationHandler));
 
         if (continuationHandle == 0) {
             int lastError = CRT.awsLastError();
@@ -127,7 +148,8 @@ public class ClientConnection extends CrtResource {
      * Initiates a new outgoing event-stream-rpc connection. The future will be completed once the connection either
      * succeeds or fails.
      * @param hostName hostname to connect to, this can be an IPv4 address, IPv6 address, a local socket address, or a
-     *                 dns name.
+     *                 dns name. For same-host IPC, a local socket address with
+     *                 {@link SocketOptions#createForLocalIpc()} avoids the TCP/IP stack.
      * @param port port to connect to hostName with. For local socket address, this value is ignored.
      * @param socketOptions socketOptions to use.
      * @param tlsContext (optional) tls context to use for using SSL/TLS in the connection.
@@ -202,5 +224,5 @@ public class ClientConnection extends CrtResource {
     private static native void acquireClientConnection(long connection);
     private static native void releaseClientConnection(long connection);
     private static native int sendProtocolMessage(long connectionPtr, byte[] serialized_headers, byte[] payload, int message_type, int message_flags, MessageFlushCallback callback);
-    private static native long newClientStream(long connectionPtr, ClientConnectionContinuationHandler continuationHandler);
+    private static native long newClientStream(long connectionPtr, ClientConnectionContinuationHandler continuationHandler, long dispatcher, CallbackDispatcher.Target dispatchTarget);
 }
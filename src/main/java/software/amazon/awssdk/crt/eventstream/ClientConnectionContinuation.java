@@ -136,6 +136,53 @@ public class ClientConnectionContinuation extends CrtResource {
         return messageFlush;
     }
 
+    /**
+     * Sends every message of a batch on the continuation, in order, in a single call.
+     * @param batch messages to send
+     * @param callback completion callback to be invoked once, when every message of the batch has been synced to
+     *                 the underlying transport, with the error of the first message that failed, if any. If a
+     *                 message can't be sent, the ones after it are not sent either.
+     */
+    public void sendMessages(final MessageBatch batch, MessageFlushCallback callback) {
+        if (isNull()) {
+            throw new IllegalStateException("close() has already been called on this object.");
+        }
+
+        if (batch.size() == 0) {
+            if (callback != null) {
+                callback.onCallbackInvoked(0);
+            }
+            return;
+        }
+
+        int result = sendContinuationMessages(getNativeHandle(), batch.getSerializedHeaders(), batch.getPayloads(),
+                batch.getMessageTypes(), batch.getMessageFlags(), callback);
+
+        if (result != 0) {
+            int errorCode = CRT.awsLastError();
+            throw new CrtRuntimeException(errorCode);
+        }
+    }
+
+    /**
+     * Sends every message of a batch on the continuation, in order, in a single call.
+     * @param batch messages to send
+     * @return Future for syncing when every message of the batch is flushed to the transport, or one fails.
+     */
+    public CompletableFuture<Void> sendMessages(final MessageBatch batch) {
+        CompletableFuture<Void> messagesFlush = new CompletableFuture<>();
+
+        sendMessages(batch, errorCode -> {
+            if (errorCode == 0) {
+                messagesFlush.complete(null);
+            } else {
+                messagesFlush.completeExceptionally(new CrtRuntimeException(errorCode));
+            }
+        });
+
+        return messagesFlush;
+    }
+
     @Override
     protected void releaseNativeHandle() {
         if (!isNull()) {
@@ -150,5 +197,6 @@ public class ClientConnectionContinuation extends CrtResource {
 
     private static native int activateContinuation(long continuationPtr, ClientConnectionContinuation continuation, byte[] operationName, byte[] serialized_headers, byte[] payload, int message_type, int message_flags, MessageFlushCallback callback);
     private static native int sendContinuationMessage(long continuationPtr, byte[] serialized_headers, byte[] payload, int message_type, int message_flags, MessageFlushCallback callback);
+    private static native int sendContinuationMessages(long continuationPtr, byte[][] serialized_headers, byte[][] payloads, int[] message_types, int[] message_flags, MessageFlushCallback callback);
     private static native void releaseContinuation(long continuationPtr);
 }
@@ -0,0 +1,41 @@
+package software.amazon.awssdk.crt.eventstream;
+
+import software.amazon.awssdk.crt.CallbackDispatcher;
+
+import java.nio.ByteBuffer;
+
+/**
+ * Unpacks the continuation events queued on a CallbackDispatcher and hands them to the continuation's handler.
+ * Must match the records written in event_stream_rpc_client.c.
+ */
+class ClientConnectionContinuationDispatchTarget implements CallbackDispatcher.Target {
+    private static final int EVENT_MESSAGE = 1;
+    private static final int EVENT_CLOSED = 2;
+
+    private final ClientConnectionContinuationHandler handler;
+
+    ClientConnectionContinuationDispatchTarget(ClientConnectionContinuationHandler handler) {
+        this.handler = handler;
+    }
+
+    @Override
+    public void onDispatchedEvent(int eventType, ByteBuffer payload) {
+        switch (eventType) {
+            case EVENT_MESSAGE:
+                /* [headers length][headers][payload length][payload][message type][message flags] */
+                byte[] headers = new byte[payload.getInt()];
+                payload.get(headers);
+                byte[] messagePayload = new byte[payload.getInt()];
+                payload.get(messagePayload);
+                int messageType = payload.getInt();
+                int messageFlags = payload.getInt();
+                handler.onContinuationMessageShim(headers, messagePayload, messageType, messageFlags);
+                break;
+            case EVENT_CLOSED:
+                handler.onContinuationClosedShim();
+                break;
+            default:
+                break;
+        }
+    }
+}
@@ -28,7 +28,7 @@ public abstract class ClientConnectionContinuationHandler implements AutoCloseab
      * Invoked from JNI. Converts the native data into usable java objects and invokes
      * onContinuationMessage().
      */
-    private void onContinuationMessageShim(final byte[] headersPayload, final byte[] payload,
+    void onContinuationMessageShim(final byte[] headersPayload, final byte[] payload,
                                    int messageType, int messageFlags) {
         List<Header> headers = new ArrayList<>();
 
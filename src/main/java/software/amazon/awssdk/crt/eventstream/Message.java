@@ -16,7 +16,25 @@ public class Message extends CrtResource {
      * @param payload payload body to include in the message's payload block. Can be null.
      */
     public Message(List<Header> headers, byte[] payload) {
-        acquireNativeHandle(messageNew(Header.marshallHeadersForJNI(headers), payload));
+        acquireNativeHandle(messageNew(marshallHeaders(headers), payload));
+    }
+
+    /**
+     * Creates a message using headers and a payload held in a direct ByteBuffer.
+     *
+     * The bytes between the buffer's position and limit are copied once, straight from off-heap memory into the
+     * encoded message, so large payloads don't pass through a heap byte[]. The buffer's position is left unchanged,
+     * and the buffer may be reused as soon as this returns.
+     *
+     * @param headers list of headers to include in the message's header block. Can be null.
+     * @param payload direct ByteBuffer holding the payload body to include in the message's payload block.
+     * @throws IllegalArgumentException if the buffer is not direct
+     */
+    public Message(List<Header> headers, ByteBuffer payload) {
+        if (payload == null || !payload.isDirect()) {
+            throw new IllegalArgumentException("Message: payload must be a direct ByteBuffer");
+        }
+        acquireNativeHandle(messageNewDirect(marshallHeaders(headers), payload, payload.position(), payload.remaining()));
     }
 
     /**
@@ -28,6 +46,10 @@ public class Message extends CrtResource {
         return messageBuffer(getNativeHandle());
     }
 
+    private static byte[] marshallHeaders(List<Header> headers) {
+        return headers != null ? Header.marshallHeadersForJNI(headers) : null;
+    }
+
     @Override
     protected void releaseNativeHandle() {
         if (!isNull()) {
@@ -41,6 +63,7 @@ public class Message extends CrtResource {
     }
 
     private static native long messageNew(byte[] serializedHeaders, byte[] payload);
+    private static native long messageNewDirect(byte[] serializedHeaders, ByteBuffer payload, int position, int length);
     private static native void messageDelete(long messageHandle);
     private static native ByteBuffer messageBuffer(long messageHandle);
 }
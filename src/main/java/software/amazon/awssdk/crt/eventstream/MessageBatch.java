@@ -0,0 +1,71 @@
+package software.amazon.awssdk.crt.eventstream;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * A sequence of messages to send on a continuation in a single call, e.g. frames of a stream of audio or telemetry.
+ * Sending a batch crosses into native code once and invokes one flush callback for all of its messages, instead of
+ * one of each per message. Headers are serialized as messages are added, so a batch can be built on one thread and
+ * sent from another, and sent more than once.
+ */
+public class MessageBatch {
+    private final List<byte[]> headers = new ArrayList<>();
+    private final List<byte[]> payloads = new ArrayList<>();
+    private final List<Integer> messageTypes = new ArrayList<>();
+    private final List<Integer> messageFlags = new ArrayList<>();
+
+    /**
+     * Creates an empty batch.
+     */
+    public MessageBatch() {}
+
+    /**
+     * Adds a message to the end of the batch.
+     * @param headers list of additional event stream headers to include on the message. Can be null.
+     * @param payload payload for the message. Can be null.
+     * @param messageType message type. Must be either ApplicationMessage or ApplicationError
+     * @param messageFlags message flags for the message, use TerminateStream to cause this message
+     *                     to close the continuation after sending.
+     * @return this batch
+     */
+    public MessageBatch addMessage(final List<Header> headers, final byte[] payload,
+                                   final MessageType messageType, int messageFlags) {
+        this.headers.add(headers != null ? Header.marshallHeadersForJNI(headers) : null);
+        this.payloads.add(payload);
+        this.messageTypes.add((int) messageType.getEnumValue());
+        this.messageFlags.add(messageFlags);
+        return this;
+    }
+
+    /**
+     * @return the number of messages in the batch
+     */
+    public int size() {
+        return payloads.size();
+    }
+
+    byte[][] getSerializedHeaders() {
+        return headers.toArray(new byte[0][]);
+    }
+
+    byte[][] getPayloads() {
+        return payloads.toArray(new byte[0][]);
+    }
+
+    int[] getMessageTypes() {
+        return toIntArray(messageTypes);
+    }
+
+    int[] getMessageFlags() {
+        return toIntArray(messageFlags);
+    }
+
+    private static int[] toIntArray(List<Integer> values) {
+        int[] array = new int[values.size()];
+        for (int i = 0; i < array.length; ++i) {
+            array[i] = values.get(i);
+        }
+        return array;
+    }
+}
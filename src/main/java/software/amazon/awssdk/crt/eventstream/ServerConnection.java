@@ -13,14 +13,17 @@ import java.util.concurrent.CompletableFuture;
  */
 public class ServerConnection extends CrtResource {
     CompletableFuture<Integer> closedFuture = new CompletableFuture<>();
+    private long metricsHandle;
 
     /**
      * Invoked from JNI.
      */
-    ServerConnection(long connectionPtr) {
+    ServerConnection(long connectionPtr, long metricsHandle) {
         // tell c-land we're acquiring
         acquire(connectionPtr);
         acquireNativeHandle(connectionPtr);
+        // a reference c-land took for us
+        this.metricsHandle = metricsHandle;
     }
 
     /**
@@ -91,7 +94,7 @@ public class ServerConnection extends CrtResource {
         }
         byte[] headersBuf = headers != null ? Header.marshallHeadersForJNI(headers) : null;
 
-        int result = sendProtocolMessage(getNativeHandle(), headersBuf, payload, messageType.getEnumValue(), messageFlags, callback);
+        int result = sendProtocolMessage(getNativeHandle(), headersBuf, payload, messageType.getEnumValue(), messageFlags, callback, metricsHandle);
 
         if (result != 0) {
             int errorCode = CRT.awsLastError();
@@ -99,6 +102,16 @@ public class ServerConnection extends CrtResource {
         }
     }
 
+    /**
+     * @return a snapshot of the traffic of this connection and its continuations.
+     */
+    public ServerMetrics getMetrics() {
+        if (isNull()) {
+            throw new IllegalStateException("close() has already been called on this object.");
+        }
+        return ServerMetrics.fromNative(metricsHandle);
+    }
+
     /**
      * @return a future which completes upon the connection closing
      */
@@ -111,6 +124,10 @@ public class ServerConnection extends CrtResource {
         if (!isNull()) {
             release(getNativeHandle());
         }
+        if (metricsHandle != 0) {
+            ServerMetrics.metricsRelease(metricsHandle);
+            metricsHandle = 0;
+        }
     }
 
     @Override
@@ -122,5 +139,5 @@ public class ServerConnection extends CrtResource {
     private static native void release(long connectionPtr);
     private static native void closeConnection(long connectionPtr, int shutdownError);
     private static native boolean isOpen(long connectionPtr);
-    private static native int sendProtocolMessage(long connectionPtr, byte[] serialized_headers, byte[] payload, int message_type, int message_flags, MessageFlushCallback callback);
+    private static native int sendProtocolMessage(long connectionPtr, byte[] serialized_headers, byte[] payload, int message_type, int message_flags, MessageFlushCallback callback, long metricsHandle);
 }
@@ -14,13 +14,27 @@ import java.util.concurrent.CompletableFuture;
  */
 public class ServerConnectionContinuation extends CrtResource {
 
+    private long metricsHandle;
+
     /**
      * Invoked from JNI
      */
-    ServerConnectionContinuation(long continuationPtr) {
+    ServerConnectionContinuation(long continuationPtr, long metricsHandle) {
         // tell c land we're acquiring
         acquire(continuationPtr);
         acquireNativeHandle(continuationPtr);
+        // a reference to the connection's metrics c land took for us
+        this.metricsHandle = metricsHandle;
+    }
+
+    /**
+     * @return a snapshot of the traffic of the connection this continuation belongs to, which its metrics are part of.
+     */
+    public ServerMetrics getConnectionMetrics() {
+        if (isNull()) {
+            throw new IllegalStateException("close() has already been called on this object.");
+        }
+        return ServerMetrics.fromNative(metricsHandle);
     }
 
     /**
@@ -68,7 +82,7 @@ public class ServerConnectionContinuation extends CrtResource {
                                     final MessageType messageType, int messageFlags, MessageFlushCallback callback) {
         byte[] headersBuf = headers != null ? Header.marshallHeadersForJNI(headers): null;
 
-        int result = sendContinuationMessage(getNativeHandle(), headersBuf, payload, messageType.getEnumValue(), messageFlags, callback);
+        int result = sendContinuationMessage(getNativeHandle(), headersBuf, payload, messageType.getEnumValue(), messageFlags, callback, metricsHandle);
 
         if (result != 0) {
             int errorCode = CRT.awsLastError();
@@ -76,11 +90,58 @@ public class ServerConnectionContinuation extends CrtResource {
         }
     }
 
+    /**
+     * Sends every message of a batch on the continuation, in order, in a single call.
+     * @param batch messages to send
+     * @param callback completion callback to be invoked once, when every message of the batch has been synced to
+     *                 the underlying transport, with the error of the first message that failed, if any. If a
+     *                 message can't be sent, the ones after it are not sent either.
+     */
+    public void sendMessages(final MessageBatch batch, MessageFlushCallback callback) {
+        if (batch.size() == 0) {
+            if (callback != null) {
+                callback.onCallbackInvoked(0);
+            }
+            return;
+        }
+
+        int result = sendContinuationMessages(getNativeHandle(), batch.getSerializedHeaders(), batch.getPayloads(),
+                batch.getMessageTypes(), batch.getMessageFlags(), callback, metricsHandle);
+
+        if (result != 0) {
+            int errorCode = CRT.awsLastError();
+            throw new CrtRuntimeException(errorCode);
+        }
+    }
+
+    /**
+     * Sends every message of a batch on the continuation, in order, in a single call.
+     * @param batch messages to send
+     * @return Future for syncing when every message of the batch is flushed to the transport, or one fails.
+     */
+    public CompletableFuture<Void> sendMessages(final MessageBatch batch) {
+        CompletableFuture<Void> messagesFlush = new CompletableFuture<>();
+
+        sendMessages(batch, errorCode -> {
+            if (errorCode == 0) {
+                messagesFlush.complete(null);
+            } else {
+                messagesFlush.completeExceptionally(new CrtRuntimeException(errorCode));
+            }
+        });
+
+        return messagesFlush;
+    }
+
     @Override
     protected void releaseNativeHandle() {
         if (!isNull()) {
             release(getNativeHandle());
         }
+        if (metricsHandle != 0) {
+            ServerMetrics.metricsRelease(metricsHandle);
+            metricsHandle = 0;
+        }
     }
 
     @Override
@@ -91,5 +152,6 @@ public class ServerConnectionContinuation extends CrtResource {
     private static native void acquire(long continuationPtr);
     private static native void release(long continuationPtr);
     private static native boolean isClosed(long continuationPtr);
-    private static native int sendContinuationMessage(long continuation, byte[] serialized_headers, byte[] payload, int message_type, int message_flags, MessageFlushCallback callback);
+    private static native int sendContinuationMessage(long continuation, byte[] serialized_headers, byte[] payload, int message_type, int message_flags, MessageFlushCallback callback, long metricsHandle);
+    private static native int sendContinuationMessages(long continuation, byte[][] serialized_headers, byte[][] payloads, int[] message_types, int[] message_flags, MessageFlushCallback callback, long metricsHandle);
 }
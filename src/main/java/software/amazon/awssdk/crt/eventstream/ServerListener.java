@@ -20,12 +20,15 @@ public class ServerListener extends CrtResource {
     private TlsContext tlsContext = null;
     private final ServerBootstrap serverBootstrap;
     private int boundPort = -1;
+    private long metricsHandle = 0;
 
     /**
      * Instantiates a server listener. Once this function completes, the server is configured
      * and listening for new connections.
      * @param hostName name of the host to listen on. Can be a dns name, ip address, or unix
-     *                 domain socket (or named pipe on windows) name.
+     *                 domain socket (or named pipe on windows) name. A unix domain socket file left behind by a
+     *                 listener that is no longer running is removed first, see
+     *                 {@link SocketOptions#createForLocalIpc()}.
      * @param port port to listen on. Ignored for local domain sockets.
      * @param socketOptions socket options to apply to the listening socket.
      * @param tlsContext optional tls context to apply to the connection if you want to use TLS.
@@ -37,9 +40,17 @@ public class ServerListener extends CrtResource {
                           final ServerListenerHandler handler) {
 
         long tlsContextPtr = tlsContext != null ? tlsContext.getNativeHandle(): 0;
-        long serverHandler = serverListenerNew(this, hostName.getBytes(StandardCharsets.UTF_8), port,
-                socketOptions.getNativeHandle(), tlsContextPtr, serverBootstrap.getNativeHandle(),
-                handler);
+        metricsHandle = ServerMetrics.listenerMetricsNew();
+        long serverHandler;
+        try {
+            serverHandler = serverListenerNew(this, hostName.getBytes(StandardCharsets.UTF_8), port,
+                    socketOptions.getNativeHandle(), tlsContextPtr, serverBootstrap.getNativeHandle(),
+                    handler, metricsHandle);
+        } catch (RuntimeException ex) {
+            ServerMetrics.metricsRelease(metricsHandle);
+            metricsHandle = 0;
+            throw ex;
+        }
 
         boundPort = getBoundPort(serverHandler);
 
@@ -58,6 +69,10 @@ public class ServerListener extends CrtResource {
         if (!isNull()) {
             release(getNativeHandle());
         }
+        if (metricsHandle != 0) {
+            ServerMetrics.metricsRelease(metricsHandle);
+            metricsHandle = 0;
+        }
     }
 
     @Override
@@ -72,6 +87,16 @@ public class ServerListener extends CrtResource {
         return boundPort;
     }
 
+    /**
+     * @return a snapshot of the traffic of every connection this listener has accepted, open or closed.
+     */
+    public ServerMetrics getMetrics() {
+        if (isNull()) {
+            throw new IllegalStateException("close() has already been called on this object.");
+        }
+        return ServerMetrics.fromNative(metricsHandle);
+    }
+
     /**
      * Invoked from JNI. Completes the shutdownComplete future.
      */
@@ -89,7 +114,7 @@ public class ServerListener extends CrtResource {
     private static native long serverListenerNew(ServerListener serverListener, byte[] hostName,
                                                  short port, long socketOptionsHandle,
                                                  long tlsContextHandle, long bootstrapHandle,
-                                                 ServerListenerHandler handler);
+                                                 ServerListenerHandler handler, long metricsHandle);
     private static native int getBoundPort(long serverListener);
 
     private static native void release(long serverListenerPtr);
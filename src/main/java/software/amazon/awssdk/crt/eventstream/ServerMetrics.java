@@ -0,0 +1,156 @@
+package software.amazon.awssdk.crt.eventstream;
+
+import software.amazon.awssdk.crt.LatencyHistogram;
+
+import java.util.Arrays;
+
+/**
+ * A snapshot of the traffic of a ServerListener, every connection it has accepted included, or of a single
+ * ServerConnection. All counters are cumulative, so rates come from comparing two snapshots, for example with
+ * <code>getMessagesReceivedPerSecondSince()</code>.
+ *
+ * Byte counts are of message payloads, not of the bytes on the wire.
+ */
+public class ServerMetrics {
+
+    /* Must match event_stream_server_metric in event_stream_server_metrics.c */
+    private static final int TIMESTAMP_NS = 0;
+    private static final int MESSAGES_RECEIVED = 1;
+    private static final int PAYLOAD_BYTES_RECEIVED = 2;
+    private static final int MESSAGES_FLUSHED = 3;
+    private static final int PAYLOAD_BYTES_FLUSHED = 4;
+    private static final int MESSAGES_FAILED = 5;
+    private static final int PENDING_FLUSHES = 6;
+    private static final int ACTIVE_CONTINUATIONS = 7;
+    private static final int CONNECTIONS_ACCEPTED = 8;
+    private static final int ACTIVE_CONNECTIONS = 9;
+    private static final int FLUSH_LATENCY_HISTOGRAM = 10;
+    private static final int VALUE_COUNT = FLUSH_LATENCY_HISTOGRAM + LatencyHistogram.BUCKET_COUNT;
+
+    private final long[] values;
+    private final LatencyHistogram flushLatency;
+
+    private ServerMetrics(long[] values) {
+        if (values.length != VALUE_COUNT) {
+            throw new IllegalArgumentException("ServerMetrics: unexpected number of values");
+        }
+        this.values = values;
+        this.flushLatency = new LatencyHistogram(
+            Arrays.copyOfRange(values, FLUSH_LATENCY_HISTOGRAM, FLUSH_LATENCY_HISTOGRAM + LatencyHistogram.BUCKET_COUNT));
+    }
+
+    /**
+     * Takes a snapshot of the native metrics behind a listener or connection.
+     * @param metricsHandle handle of the native metrics
+     * @return the snapshot
+     */
+    static ServerMetrics fromNative(long metricsHandle) {
+        return new ServerMetrics(metricsSnapshot(metricsHandle));
+    }
+
+    /**
+     * @return when the snapshot was taken, in nanoseconds of a monotonic clock; only meaningful relative to other
+     * snapshots
+     */
+    public long getTimestampNanos() {
+        return values[TIMESTAMP_NS];
+    }
+
+    /**
+     * @return number of messages received, protocol and continuation messages alike
+     */
+    public long getMessagesReceived() {
+        return values[MESSAGES_RECEIVED];
+    }
+
+    /**
+     * @return total payload bytes of the messages received
+     */
+    public long getPayloadBytesReceived() {
+        return values[PAYLOAD_BYTES_RECEIVED];
+    }
+
+    /**
+     * @return number of messages sent and flushed to the transport
+     */
+    public long getMessagesFlushed() {
+        return values[MESSAGES_FLUSHED];
+    }
+
+    /**
+     * @return total payload bytes of the messages flushed to the transport
+     */
+    public long getPayloadBytesFlushed() {
+        return values[PAYLOAD_BYTES_FLUSHED];
+    }
+
+    /**
+     * @return number of messages that could not be sent, or failed to flush
+     */
+    public long getMessagesFailed() {
+        return values[MESSAGES_FAILED];
+    }
+
+    /**
+     * @return number of messages sent and still waiting to flush
+     */
+    public long getPendingFlushes() {
+        return values[PENDING_FLUSHES];
+    }
+
+    /**
+     * @return number of continuations currently open
+     */
+    public long getActiveContinuations() {
+        return values[ACTIVE_CONTINUATIONS];
+    }
+
+    /**
+     * @return number of connections accepted; always 1 for a connection's own metrics
+     */
+    public long getConnectionsAccepted() {
+        return values[CONNECTIONS_ACCEPTED];
+    }
+
+    /**
+     * @return number of connections currently open; 0 or 1 for a connection's own metrics
+     */
+    public long getActiveConnections() {
+        return values[ACTIVE_CONNECTIONS];
+    }
+
+    /**
+     * @return latencies from sending a message until it was flushed to the transport
+     */
+    public LatencyHistogram getFlushLatency() {
+        return flushLatency;
+    }
+
+    /**
+     * @param earlier a snapshot of the same listener or connection taken before this one
+     * @return the rate messages were received at between the two snapshots, or 0 if no time passed
+     */
+    public double getMessagesReceivedPerSecondSince(ServerMetrics earlier) {
+        return perSecondSince(earlier, MESSAGES_RECEIVED);
+    }
+
+    /**
+     * @param earlier a snapshot of the same listener or connection taken before this one
+     * @return the rate messages were flushed at between the two snapshots, or 0 if no time passed
+     */
+    public double getMessagesFlushedPerSecondSince(ServerMetrics earlier) {
+        return perSecondSince(earlier, MESSAGES_FLUSHED);
+    }
+
+    private double perSecondSince(ServerMetrics earlier, int index) {
+        long elapsedNanos = getTimestampNanos() - earlier.getTimestampNanos();
+        if (elapsedNanos <= 0) {
+            return 0;
+        }
+        return (values[index] - earlier.values[index]) * 1e9 / elapsedNanos;
+    }
+
+    static native long listenerMetricsNew();
+    static native void metricsRelease(long metricsHandle);
+    private static native long[] metricsSnapshot(long metricsHandle);
+}
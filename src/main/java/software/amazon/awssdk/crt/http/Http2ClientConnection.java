@@ -189,10 +189,34 @@ public class Http2ClientConnection extends HttpClientConnection {
         }
 
         Http2Stream stream = http2ClientConnectionMakeRequest(getNativeHandle(), request.marshalForJni(),
-                request.getBodyStream(), new HttpStreamResponseHandlerNativeAdapter(streamHandler));
+                request.getHeaderTemplateNativeHandle(), request.getBodyStream(),
+                new HttpStreamResponseHandlerNativeAdapter(streamHandler));
         return stream;
     }
 
+    /**
+     * Schedules a request built natively with an {@link HttpRequestBuilder}, without re-marshalling it.
+     * An HTTP/1.1 request will be transformed to HTTP/2 request under the hood.
+     *
+     * @param request       The Request to make to the Server.
+     * @param streamHandler The Stream Handler to be called from the Native
+     *                      EventLoop
+     * @throws CrtRuntimeException if stream creation fails
+     * @return The Http2Stream that represents this Request/Response Pair. It can be
+     *         closed at any time during the request/response, but must be closed by
+     *         the user thread making this request when it's done.
+     */
+    @Override
+    public Http2Stream makeRequest(HttpRequestBuilder request, HttpStreamBaseResponseHandler streamHandler)
+            throws CrtRuntimeException {
+        if (isNull()) {
+            throw new IllegalStateException("Http2ClientConnection has been closed, can't make requests on it.");
+        }
+
+        return http2ClientConnectionMakeRequestFromBuilder(getNativeHandle(), request.getNativeHandle(),
+                request.getBodyStream(), new HttpStreamResponseHandlerNativeAdapter(streamHandler));
+    }
+
     /**
      * @TODO: bindings for getters of local/remote setting and goaway.
      */
@@ -201,8 +225,12 @@ public class Http2ClientConnection extends HttpClientConnection {
      ******************************************************************************/
 
     private static native Http2Stream http2ClientConnectionMakeRequest(long connectionBinding, byte[] marshalledRequest,
-            HttpRequestBodyStream bodyStream, HttpStreamResponseHandlerNativeAdapter responseHandler)
-            throws CrtRuntimeException;
+            long headerTemplate, HttpRequestBodyStream bodyStream,
+            HttpStreamResponseHandlerNativeAdapter responseHandler) throws CrtRuntimeException;
+
+    private static native Http2Stream http2ClientConnectionMakeRequestFromBuilder(long connectionBinding,
+            long requestBuilder, HttpRequestBodyStream bodyStream,
+            HttpStreamResponseHandlerNativeAdapter responseHandler) throws CrtRuntimeException;
 
     private static native void http2ClientConnectionUpdateSettings(long connectionBinding,
             AsyncCallback completedCallback, long[] marshalledSettings) throws CrtRuntimeException;
@@ -122,7 +122,9 @@ public class Http2StreamManager extends CrtResource {
                 options.hasPriorKnowledge(),
                 options.shouldCloseConnectionOnServerError(),
                 options.getConnectionPingPeriodMs(),
-                options.getConnectionPingTimeoutMs()));
+                options.getConnectionPingTimeoutMs(),
+                options.getConnectionEvictionResponseLatencyMs(),
+                options.getConnectionEvictionErrorRatePercent()));
 
         /*
          * we don't need to add a reference to socketOptions since it's copied during
@@ -168,6 +170,7 @@ public class Http2StreamManager extends CrtResource {
         try {
             http2StreamManagerAcquireStream(this.getNativeHandle(),
                     request.marshalForJni(),
+                    request.getHeaderTemplateNativeHandle(),
                     request.getBodyStream(),
                     new HttpStreamResponseHandlerNativeAdapter(streamHandler),
                     acquireStreamCompleted);
@@ -263,12 +266,15 @@ public class Http2StreamManager extends CrtResource {
             boolean priorKnowledge,
             boolean closeConnectionOnServerError,
             int connectionPingPeriodMs,
-            int connectionPingTimeoutMs) throws CrtRuntimeException;
+            int connectionPingTimeoutMs,
+            int connectionEvictionResponseLatencyMs,
+            int connectionEvictionErrorRatePercent) throws CrtRuntimeException;
 
     private static native void http2StreamManagerRelease(long stream_manager) throws CrtRuntimeException;
 
     private static native void http2StreamManagerAcquireStream(long stream_manager,
             byte[] marshalledRequest,
+            long headerTemplate,
             HttpRequestBodyStream bodyStream,
             HttpStreamResponseHandlerNativeAdapter responseHandler,
             AsyncCallback completedCallback) throws CrtRuntimeException;
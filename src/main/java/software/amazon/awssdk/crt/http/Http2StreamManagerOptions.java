@@ -23,6 +23,8 @@ public class Http2StreamManagerOptions {
     private boolean closeConnectionOnServerError = false;
     private int connectionPingPeriodMs = 0;
     private int connectionPingTimeoutMs = 0;
+    private int connectionEvictionResponseLatencyMs = 0;
+    private int connectionEvictionErrorRatePercent = 0;
 
     private List<Http2ConnectionSetting> initialSettingsList = new ArrayList<Http2ConnectionSetting>();
 
@@ -240,6 +242,42 @@ public class Http2StreamManagerOptions {
         return connectionPingTimeoutMs;
     }
 
+    /**
+     * Settings to stop using connections that have become unhealthy, so a slow or failing connection doesn't drag
+     * down every stream multiplexed onto it.
+     *
+     * Each connection keeps a moving average of how long its streams take to get response headers, and of how
+     * often they fail. Once a connection has completed a handful of streams and either average goes over its
+     * threshold, the connection stops being handed new streams. Streams already on it carry on, and the stream
+     * manager replaces it with a new connection as needed.
+     *
+     * @param responseLatencyMs Average time, in milliseconds, from the stream being acquired to its response
+     *                          headers, above which a connection is evicted. If you specify 0, latency is not
+     *                          checked.
+     * @param errorRatePercent  Percentage of streams failing, above which a connection is evicted. Between 0 and
+     *                          100. If you specify 0, errors are not checked.
+     * @return this
+     */
+    public Http2StreamManagerOptions withConnectionEviction(int responseLatencyMs, int errorRatePercent) {
+        this.connectionEvictionResponseLatencyMs = responseLatencyMs;
+        this.connectionEvictionErrorRatePercent = errorRatePercent;
+        return this;
+    }
+
+    /**
+     * @return Average response latency in milliseconds above which a connection is evicted, 0 if not checked
+     */
+    public int getConnectionEvictionResponseLatencyMs() {
+        return connectionEvictionResponseLatencyMs;
+    }
+
+    /**
+     * @return Percentage of failed streams above which a connection is evicted, 0 if not checked
+     */
+    public int getConnectionEvictionErrorRatePercent() {
+        return connectionEvictionErrorRatePercent;
+    }
+
     /**
      * Validate the stream manager options are valid to use. Throw exceptions if
      * not.
@@ -261,6 +299,12 @@ public class Http2StreamManagerOptions {
         if (maxConcurrentStreamsPerConnection <= 0) {
             throw new IllegalArgumentException("Max Concurrent Streams Per Connection must be greater than zero.");
         }
+        if (connectionEvictionResponseLatencyMs < 0) {
+            throw new IllegalArgumentException("Connection Eviction Response Latency must not be negative.");
+        }
+        if (connectionEvictionErrorRatePercent < 0 || connectionEvictionErrorRatePercent > 100) {
+            throw new IllegalArgumentException("Connection Eviction Error Rate must be between 0 and 100 percent.");
+        }
         if (idealConcurrentStreamsPerConnection <= 0
                 || idealConcurrentStreamsPerConnection > maxConcurrentStreamsPerConnection) {
             throw new IllegalArgumentException(
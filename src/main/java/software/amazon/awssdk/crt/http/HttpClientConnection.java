@@ -26,10 +26,17 @@ import static software.amazon.awssdk.crt.CRT.awsLastError;
  */
 public class HttpClientConnection extends CrtResource {
 
+    private volatile Runnable releaseCallback;
+
     protected HttpClientConnection(long connectionBinding) {
         acquireNativeHandle(connectionBinding);
     }
 
+    /* Run once the connection has been returned to its pool, lets a ShardedHttpClientConnectionManager count leases */
+    void setReleaseCallback(Runnable releaseCallback) {
+        this.releaseCallback = releaseCallback;
+    }
+
     /**
      * Schedules an HttpRequest on the Native EventLoop for this HttpClientConnection specific to HTTP/1.1 connection.
      *
@@ -49,6 +56,7 @@ public class HttpClientConnection extends CrtResource {
         }
         HttpStreamBase stream = httpClientConnectionMakeRequest(getNativeHandle(),
                 request.marshalForJni(),
+                request.getHeaderTemplateNativeHandle(),
                 request.getBodyStream(),
                 new HttpStreamResponseHandlerNativeAdapter(streamHandler));
 
@@ -70,12 +78,35 @@ public class HttpClientConnection extends CrtResource {
         }
         HttpStreamBase stream = httpClientConnectionMakeRequest(getNativeHandle(),
                 request.marshalForJni(),
+                request.getHeaderTemplateNativeHandle(),
                 request.getBodyStream(),
                 new HttpStreamResponseHandlerNativeAdapter(streamHandler));
 
         return stream;
     }
 
+    /**
+     * Schedules a request built natively with an {@link HttpRequestBuilder}, without re-marshalling it.
+     * The builder may be edited or closed once this returns, without affecting the request.
+     *
+     * @param request The Request to make to the Server.
+     * @param streamHandler The Stream Handler to be called from the Native EventLoop
+     * @throws CrtRuntimeException if stream creation fails
+     * @return The HttpStream that represents this Request/Response Pair. It can be closed at any time during the
+     *          request/response, but must be closed by the user thread making this request when it's done.
+     */
+    public HttpStreamBase makeRequest(HttpRequestBuilder request, HttpStreamBaseResponseHandler streamHandler)
+            throws CrtRuntimeException {
+        if (isNull()) {
+            throw new IllegalStateException("HttpClientConnection has been closed, can't make requests on it.");
+        }
+        if (request.getVersion() == HttpVersion.HTTP_2) {
+            throw new IllegalArgumentException("HTTP/2 request made on an HTTP/1 connection.");
+        }
+        return httpClientConnectionMakeRequestFromBuilder(getNativeHandle(), request.getNativeHandle(),
+                request.getBodyStream(), new HttpStreamResponseHandlerNativeAdapter(streamHandler));
+    }
+
     /**
      * Determines whether a resource releases its dependencies at the same time the native handle is released or if it waits.
      * Resources that wait are responsible for calling releaseReferences() manually.
@@ -91,6 +122,11 @@ public class HttpClientConnection extends CrtResource {
         if (!isNull()){
             httpClientConnectionReleaseManaged(getNativeHandle());
         }
+        Runnable callback = releaseCallback;
+        if (callback != null) {
+            releaseCallback = null;
+            callback.run();
+        }
     }
 
     /**
@@ -153,6 +189,12 @@ public class HttpClientConnection extends CrtResource {
      ******************************************************************************/
     private static native HttpStreamBase httpClientConnectionMakeRequest(long connectionBinding,
                                                                      byte[] marshalledRequest,
+                                                                     long headerTemplate,
+                                                                     HttpRequestBodyStream bodyStream,
+                                                                     HttpStreamResponseHandlerNativeAdapter responseHandler) throws CrtRuntimeException;
+
+    private static native HttpStreamBase httpClientConnectionMakeRequestFromBuilder(long connectionBinding,
+                                                                     long requestBuilder,
                                                                      HttpRequestBodyStream bodyStream,
                                                                      HttpStreamResponseHandlerNativeAdapter responseHandler) throws CrtRuntimeException;
 
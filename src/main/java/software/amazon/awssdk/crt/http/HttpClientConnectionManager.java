@@ -121,7 +121,10 @@ public class HttpClientConnectionManager extends CrtResource {
                                             options.getMaxConnectionIdleInMilliseconds(),
                                             monitoringThroughputThresholdInBytesPerSecond,
                                             monitoringFailureIntervalInSeconds,
-                                            expectedHttpVersion.getValue()));
+                                            expectedHttpVersion.getValue(),
+                                            options.getMaxPendingConnectionAcquisitions(),
+                                            options.getConnectionAcquisitionTimeoutInMilliseconds(),
+                                            options.getMinConnections()));
 
         /* we don't need to add a reference to socketOptions since it's copied during connection manager construction */
          addReferenceTo(clientBootstrap);
@@ -137,6 +140,11 @@ public class HttpClientConnectionManager extends CrtResource {
 
     /**
      * Request a HttpClientConnection from the Connection Pool.
+     * <p>
+     * The future fails with an {@link HttpException} if
+     * {@link HttpClientConnectionManagerOptions#withMaxPendingConnectionAcquisitions} acquisitions are already
+     * waiting, or if no connection is acquired within
+     * {@link HttpClientConnectionManagerOptions#withConnectionAcquisitionTimeoutInMilliseconds}.
      * @return A Future for a HttpClientConnection that will be completed when a connection is acquired.
      */
     public CompletableFuture<HttpClientConnection> acquireConnection() {
@@ -149,6 +157,44 @@ public class HttpClientConnectionManager extends CrtResource {
         return returnedFuture;
     }
 
+    /**
+     * Establishes connections ahead of demand, so the first requests don't pay for DNS, TCP and TLS setup.
+     * <p>
+     * New connections are established until {@code connections} are idle in the pool, each one returned to the pool
+     * as soon as it's ready so requests made meanwhile can use it. Connections already idle in the pool count towards
+     * the number, and the pool never grows past its maximum number of connections.
+     *
+     * @param connections number of connections to have ready
+     * @return A Future completed with the number of connections warmed once they've all been established, or
+     *          completed exceptionally if any of them couldn't be established.
+     */
+    public CompletableFuture<Integer> prewarm(int connections) {
+        if (isNull()) {
+            throw new IllegalStateException("HttpClientConnectionManager has been closed, can't prewarm connections");
+        }
+        if (connections < 0) {
+            throw new IllegalArgumentException("Number of connections to prewarm must not be negative");
+        }
+
+        CompletableFuture<Integer> returnedFuture = new CompletableFuture<>();
+        int warmCount = Math.min(connections, maxConnections);
+        if (warmCount == 0) {
+            returnedFuture.complete(0);
+            return returnedFuture;
+        }
+        httpClientConnectionManagerPrewarm(getNativeHandle(), warmCount, returnedFuture);
+        return returnedFuture;
+    }
+
+    /** Called from Native once every connection of a prewarm has been established and returned to the pool */
+    private static void onPrewarmComplete(CompletableFuture<Integer> prewarmFuture, int connections, int errorCode) {
+        if (errorCode != CRT.AWS_CRT_SUCCESS) {
+            prewarmFuture.completeExceptionally(new HttpException(errorCode));
+        } else {
+            prewarmFuture.complete(connections);
+        }
+    }
+
     /**
      * Releases this HttpClientConnection back into the Connection Pool, and allows another Request to acquire this connection.
      * @param conn Connection to release
@@ -249,12 +295,17 @@ public class HttpClientConnectionManager extends CrtResource {
                                                         long maxConnectionIdleInMilliseconds,
                                                         long monitoringThroughputThresholdInBytesPerSecond,
                                                         int monitoringFailureIntervalInSeconds,
-                                                        int expectedProtocol) throws CrtRuntimeException;
+                                                        int expectedProtocol,
+                                                        int maxPendingConnectionAcquisitions,
+                                                        long connectionAcquisitionTimeoutInMilliseconds,
+                                                        int minConnections) throws CrtRuntimeException;
 
     private static native void httpClientConnectionManagerRelease(long conn_manager) throws CrtRuntimeException;
 
     private static native void httpClientConnectionManagerAcquireConnection(long conn_manager, CompletableFuture<HttpClientConnection> acquireFuture) throws CrtRuntimeException;
 
+    private static native void httpClientConnectionManagerPrewarm(long conn_manager, int connections, CompletableFuture<Integer> prewarmFuture) throws CrtRuntimeException;
+
     private static native HttpManagerMetrics httpConnectionManagerFetchMetrics(long conn_manager) throws CrtRuntimeException;
 
 }
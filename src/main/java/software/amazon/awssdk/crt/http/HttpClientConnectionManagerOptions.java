@@ -31,6 +31,9 @@ public class HttpClientConnectionManagerOptions {
     private boolean manualWindowManagement = false;
     private HttpMonitoringOptions monitoringOptions;
     private long maxConnectionIdleInMilliseconds = 0;
+    private int maxPendingConnectionAcquisitions = 0;
+    private long connectionAcquisitionTimeoutInMilliseconds = 0;
+    private int minConnections = 0;
     private HttpVersion expectedHttpVersion = HttpVersion.HTTP_1_1;
 
     private static final String HTTP = "http";
@@ -42,6 +45,27 @@ public class HttpClientConnectionManagerOptions {
     public HttpClientConnectionManagerOptions() {
     }
 
+    /* Copy of other, so it can be tweaked without changing the caller's options */
+    HttpClientConnectionManagerOptions(HttpClientConnectionManagerOptions other) {
+        this.clientBootstrap = other.clientBootstrap;
+        this.socketOptions = other.socketOptions;
+        this.tlsContext = other.tlsContext;
+        this.tlsConnectionOptions = other.tlsConnectionOptions;
+        this.windowSize = other.windowSize;
+        this.bufferSize = other.bufferSize;
+        this.uri = other.uri;
+        this.port = other.port;
+        this.maxConnections = other.maxConnections;
+        this.proxyOptions = other.proxyOptions;
+        this.manualWindowManagement = other.manualWindowManagement;
+        this.monitoringOptions = other.monitoringOptions;
+        this.maxConnectionIdleInMilliseconds = other.maxConnectionIdleInMilliseconds;
+        this.maxPendingConnectionAcquisitions = other.maxPendingConnectionAcquisitions;
+        this.connectionAcquisitionTimeoutInMilliseconds = other.connectionAcquisitionTimeoutInMilliseconds;
+        this.minConnections = other.minConnections;
+        this.expectedHttpVersion = other.expectedHttpVersion;
+    }
+
     /**
      * Sets the client bootstrap instance to use to create the pool's connections
      * @param clientBootstrap ClientBootstrap to use
@@ -262,6 +286,63 @@ public class HttpClientConnectionManagerOptions {
      */
     public long getMaxConnectionIdleInMilliseconds() { return maxConnectionIdleInMilliseconds; }
 
+    /**
+     * Sets the maximum number of connection acquisitions that may wait for a connection at once.
+     * Once that many are waiting, further calls to {@link HttpClientConnectionManager#acquireConnection()}
+     * fail immediately, instead of queueing behind them. An acquisition that timed out keeps counting as waiting
+     * until the pool hands it a connection, which goes straight back to the pool, or fails it, since the pool
+     * can't drop it from its queue any sooner.
+     *
+     * @param maxPendingConnectionAcquisitions maximum number of waiting acquisitions, or 0 for no limit
+     * @return this
+     */
+    public HttpClientConnectionManagerOptions withMaxPendingConnectionAcquisitions(int maxPendingConnectionAcquisitions) {
+        this.maxPendingConnectionAcquisitions = maxPendingConnectionAcquisitions;
+        return this;
+    }
+
+    /**
+     * @return maximum number of waiting connection acquisitions, or 0 for no limit
+     */
+    public int getMaxPendingConnectionAcquisitions() { return maxPendingConnectionAcquisitions; }
+
+    /**
+     * Sets how long a connection acquisition may wait for a connection before it fails.
+     * If a connection turns up after its acquisition timed out, it goes straight back into the pool.
+     *
+     * @param connectionAcquisitionTimeoutInMilliseconds timeout for connection acquisitions, or 0 to wait forever
+     * @return this
+     */
+    public HttpClientConnectionManagerOptions withConnectionAcquisitionTimeoutInMilliseconds(
+            long connectionAcquisitionTimeoutInMilliseconds) {
+        this.connectionAcquisitionTimeoutInMilliseconds = connectionAcquisitionTimeoutInMilliseconds;
+        return this;
+    }
+
+    /**
+     * @return timeout for connection acquisitions, or 0 if they wait forever
+     */
+    public long getConnectionAcquisitionTimeoutInMilliseconds() { return connectionAcquisitionTimeoutInMilliseconds; }
+
+    /**
+     * Sets a floor on the number of connections in the pool, idle and in use together.
+     * Whenever the pool holds fewer, it establishes more in the background, ahead of demand, starting as soon as the
+     * pool is created. Connections culled by {@link #withMaxConnectionIdleInMilliseconds} are re-established this
+     * way, so the pool doesn't collapse to zero between bursts.
+     *
+     * @param minConnections minimum number of connections to keep, at most the maximum number of connections
+     * @return this
+     */
+    public HttpClientConnectionManagerOptions withMinConnections(int minConnections) {
+        this.minConnections = minConnections;
+        return this;
+    }
+
+    /**
+     * @return minimum number of connections the pool keeps
+     */
+    public int getMinConnections() { return minConnections; }
+
     /**
      * Sets the monitoring options for connections in the connection pool
      * @param monitoringOptions Monitoring options for this connection manager, or null to disable monitoring
@@ -301,5 +382,17 @@ public class HttpClientConnectionManagerOptions {
         if (windowSize <= 0) { throw new  IllegalArgumentException("Window Size must be greater than zero."); }
 
         if (maxConnections <= 0) { throw new  IllegalArgumentException("Max Connections must be greater than zero."); }
+
+        if (maxPendingConnectionAcquisitions < 0) {
+            throw new IllegalArgumentException("Max Pending Connection Acquisitions must not be negative.");
+        }
+
+        if (minConnections < 0 || minConnections > maxConnections) {
+            throw new IllegalArgumentException("Min Connections must be between zero and Max Connections.");
+        }
+
+        if (connectionAcquisitionTimeoutInMilliseconds < 0) {
+            throw new IllegalArgumentException("Connection Acquisition Timeout must not be negative.");
+        }
     }
 }
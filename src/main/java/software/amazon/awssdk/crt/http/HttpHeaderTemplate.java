@@ -0,0 +1,65 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.http;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+
+import software.amazon.awssdk.crt.CrtResource;
+
+/**
+ * An immutable set of headers, created once in native memory and shared by any number of requests.
+ * <p>
+ * Headers that are the same on every request (user agent, accept, host, ...) can be put in a template and attached
+ * to each request with {@link HttpRequestBase#setHeaderTemplate}, instead of being marshalled and copied again
+ * for every request. Headers added to the request itself override template headers of the same name.
+ * <p>
+ * The template may be closed while requests made with it are still in flight, they hold their own reference
+ * to the native headers.
+ */
+public final class HttpHeaderTemplate extends CrtResource {
+
+    private final List<HttpHeader> headers;
+
+    /**
+     * @param headers headers shared by every request made with this template
+     */
+    public HttpHeaderTemplate(HttpHeader[] headers) {
+        if (headers == null) {
+            throw new IllegalArgumentException("HttpHeaderTemplate headers can be empty, but can't be null");
+        }
+        this.headers = Collections.unmodifiableList(new ArrayList<HttpHeader>(Arrays.asList(headers)));
+        acquireNativeHandle(httpHeaderTemplateNew(HttpHeader.marshalHeadersForJni(this.headers)));
+    }
+
+    /**
+     * @return the headers of this template, which can't be modified
+     */
+    public List<HttpHeader> getHeaders() {
+        return headers;
+    }
+
+    @Override
+    protected boolean canReleaseReferencesImmediately() {
+        return true;
+    }
+
+    @Override
+    protected void releaseNativeHandle() {
+        if (!isNull()) {
+            httpHeaderTemplateDestroy(getNativeHandle());
+        }
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+    private static native long httpHeaderTemplateNew(byte[] marshalledHeaders);
+
+    private static native void httpHeaderTemplateDestroy(long headerTemplate);
+}
@@ -0,0 +1,187 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.http;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.Charset;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * A read-only view of a block of response headers, decoded lazily from the native representation.
+ * <p>
+ * Nothing is copied or decoded until it is asked for, so looking up the one or two headers you care about
+ * doesn't pay for converting every header into an {@link HttpHeader}.
+ * <p>
+ * The view points at native memory that only lives for the duration of the callback it was passed to.
+ * Do NOT keep a reference to it past that call, use {@link #toArray()} to keep the headers.
+ */
+public final class HttpHeadersView {
+    private final static int BUFFER_INT_SIZE = 4;
+    private final static Charset UTF8 = StandardCharsets.UTF_8;
+
+    private ByteBuffer headersBlob;
+    /* offset of each header's name length within headersBlob, built on first access */
+    private int[] offsets;
+    private int count = -1;
+
+    /**
+     * Each header is marshalled as
+     * [4-bytes BE name length] [variable length name value] [4-bytes BE value length] [variable length value value]
+     *
+     * @param headersBlob Blob of encoded headers
+     */
+    HttpHeadersView(ByteBuffer headersBlob) {
+        this.headersBlob = headersBlob;
+    }
+
+    /* Called once the callback returns, after which the native memory may be reused */
+    void invalidate() {
+        headersBlob = null;
+    }
+
+    private ByteBuffer blob() {
+        if (headersBlob == null) {
+            throw new IllegalStateException("HttpHeadersView used after the callback it was passed to returned");
+        }
+        return headersBlob;
+    }
+
+    private void index() {
+        if (count >= 0) {
+            return;
+        }
+        ByteBuffer blob = blob();
+        int[] found = new int[16];
+        int foundCount = 0;
+        int position = blob.position();
+        int limit = blob.limit();
+        while (position < limit) {
+            int nameLength = blob.getInt(position);
+            int valueLength = blob.getInt(position + BUFFER_INT_SIZE + nameLength);
+            /* skip 0 length header names, same as HttpHeader.loadHeadersListFromMarshalledHeadersBlob */
+            if (nameLength > 0) {
+                if (foundCount == found.length) {
+                    int[] grown = new int[found.length * 2];
+                    System.arraycopy(found, 0, grown, 0, foundCount);
+                    found = grown;
+                }
+                found[foundCount++] = position;
+            }
+            position += BUFFER_INT_SIZE * 2 + nameLength + valueLength;
+        }
+        offsets = found;
+        count = foundCount;
+    }
+
+    private byte[] field(int offset) {
+        ByteBuffer blob = blob().duplicate();
+        byte[] bytes = new byte[blob.getInt(offset)];
+        blob.position(offset + BUFFER_INT_SIZE);
+        blob.get(bytes);
+        return bytes;
+    }
+
+    private int valueOffset(int index) {
+        int offset = offsets[index];
+        return offset + BUFFER_INT_SIZE + blob().getInt(offset);
+    }
+
+    private void checkIndex(int index) {
+        index();
+        if (index < 0 || index >= count) {
+            throw new IndexOutOfBoundsException("header index " + index + " out of range, size " + count);
+        }
+    }
+
+    /**
+     * @return number of headers in the block
+     */
+    public int size() {
+        index();
+        return count;
+    }
+
+    /**
+     * @param index index of the header, in the order it was received
+     * @return the name of the header, in raw bytes
+     */
+    public byte[] getNameBytes(int index) {
+        checkIndex(index);
+        return field(offsets[index]);
+    }
+
+    /**
+     * @param index index of the header, in the order it was received
+     * @return the name of the header, converted to a UTF-8 string
+     */
+    public String getName(int index) {
+        return new String(getNameBytes(index), UTF8);
+    }
+
+    /**
+     * @param index index of the header, in the order it was received
+     * @return the value of the header, in raw bytes
+     */
+    public byte[] getValueBytes(int index) {
+        checkIndex(index);
+        return field(valueOffset(index));
+    }
+
+    /**
+     * @param index index of the header, in the order it was received
+     * @return the value of the header, converted to a UTF-8 string
+     */
+    public String getValue(int index) {
+        return new String(getValueBytes(index), UTF8);
+    }
+
+    /**
+     * Looks up a header by name, without decoding any of the other headers.
+     *
+     * @param name header name, compared case-insensitively
+     * @return the value of the first header with this name, or null if there is none
+     */
+    public String get(String name) {
+        index();
+        ByteBuffer blob = blob();
+        for (int i = 0; i < count; ++i) {
+            int offset = offsets[i];
+            if (nameMatches(blob, offset, name)) {
+                return new String(field(valueOffset(i)), UTF8);
+            }
+        }
+        return null;
+    }
+
+    private static boolean nameMatches(ByteBuffer blob, int offset, String name) {
+        /* header names are ASCII tokens, so a byte per char */
+        int nameLength = blob.getInt(offset);
+        if (nameLength != name.length()) {
+            return false;
+        }
+        int start = offset + BUFFER_INT_SIZE;
+        for (int i = 0; i < nameLength; ++i) {
+            if (Character.toLowerCase((char) (blob.get(start + i) & 0xff)) != Character.toLowerCase(name.charAt(i))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Decodes every header in the block. The result stays valid after the callback returns.
+     *
+     * @return the headers, in the order they were received
+     */
+    public HttpHeader[] toArray() {
+        index();
+        HttpHeader[] headers = new HttpHeader[count];
+        for (int i = 0; i < count; ++i) {
+            headers[i] = new HttpHeader(field(offsets[i]), field(valueOffset(i)));
+        }
+        return headers;
+    }
+}
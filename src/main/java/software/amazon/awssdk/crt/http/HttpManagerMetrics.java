@@ -1,14 +1,41 @@
 package software.amazon.awssdk.crt.http;
 
 public class HttpManagerMetrics {
+    /**
+     * Upper bounds, in milliseconds, of the buckets of {@link #getAcquisitionWaitTimeHistogram()}.
+     * The last bucket has no upper bound.
+     */
+    private static final long[] ACQUISITION_WAIT_TIME_BUCKET_BOUNDS_MS = { 1, 5, 10, 50, 100, 500, 1000, 5000 };
+
     private final long availableConcurrency;
     private final long pendingConcurrencyAcquires;
     private final long leasedConcurrency;
+    private final long acquisitionsSucceeded;
+    private final long acquisitionsFailed;
+    private final long acquisitionsRejected;
+    private final long acquisitionsTimedOut;
+    private final long totalAcquisitionWaitTimeNs;
+    private final long maxAcquisitionWaitTimeNs;
+    private final long[] acquisitionWaitTimeHistogram;
 
     HttpManagerMetrics(long availableConcurrency, long pendingConcurrencyAcquires, long leasedConcurrency) {
+        this(availableConcurrency, pendingConcurrencyAcquires, leasedConcurrency, 0, 0, 0, 0, 0, 0,
+                new long[ACQUISITION_WAIT_TIME_BUCKET_BOUNDS_MS.length + 1]);
+    }
+
+    HttpManagerMetrics(long availableConcurrency, long pendingConcurrencyAcquires, long leasedConcurrency,
+            long acquisitionsSucceeded, long acquisitionsFailed, long acquisitionsRejected, long acquisitionsTimedOut,
+            long totalAcquisitionWaitTimeNs, long maxAcquisitionWaitTimeNs, long[] acquisitionWaitTimeHistogram) {
         this.availableConcurrency = availableConcurrency;
         this.pendingConcurrencyAcquires = pendingConcurrencyAcquires;
         this.leasedConcurrency = leasedConcurrency;
+        this.acquisitionsSucceeded = acquisitionsSucceeded;
+        this.acquisitionsFailed = acquisitionsFailed;
+        this.acquisitionsRejected = acquisitionsRejected;
+        this.acquisitionsTimedOut = acquisitionsTimedOut;
+        this.totalAcquisitionWaitTimeNs = totalAcquisitionWaitTimeNs;
+        this.maxAcquisitionWaitTimeNs = maxAcquisitionWaitTimeNs;
+        this.acquisitionWaitTimeHistogram = acquisitionWaitTimeHistogram;
     }
 
     /**
@@ -37,4 +64,71 @@ public class HttpManagerMetrics {
     public long getLeasedConcurrency() {
         return this.leasedConcurrency;
     }
+
+    /*
+     * The acquisition statistics below are kept by HttpClientConnectionManager since it was created.
+     * They are always 0 for Http2StreamManager.
+     */
+
+    /**
+     * @return number of connection acquisitions that got a connection
+     */
+    public long getAcquisitionsSucceeded() {
+        return acquisitionsSucceeded;
+    }
+
+    /**
+     * @return number of connection acquisitions that failed to get a connection, other than by timing out
+     */
+    public long getAcquisitionsFailed() {
+        return acquisitionsFailed;
+    }
+
+    /**
+     * @return number of connection acquisitions failed immediately because too many were already waiting
+     * @see HttpClientConnectionManagerOptions#withMaxPendingConnectionAcquisitions
+     */
+    public long getAcquisitionsRejected() {
+        return acquisitionsRejected;
+    }
+
+    /**
+     * @return number of connection acquisitions that timed out waiting
+     * @see HttpClientConnectionManagerOptions#withConnectionAcquisitionTimeoutInMilliseconds
+     */
+    public long getAcquisitionsTimedOut() {
+        return acquisitionsTimedOut;
+    }
+
+    /**
+     * @return total time, in nanoseconds, that completed connection acquisitions spent waiting
+     */
+    public long getTotalAcquisitionWaitTimeNs() {
+        return totalAcquisitionWaitTimeNs;
+    }
+
+    /**
+     * @return longest time, in nanoseconds, that a completed connection acquisition spent waiting
+     */
+    public long getMaxAcquisitionWaitTimeNs() {
+        return maxAcquisitionWaitTimeNs;
+    }
+
+    /**
+     * Histogram of how long completed connection acquisitions waited, including those that failed or timed out.
+     * Element i counts the acquisitions which waited less than {@code getAcquisitionWaitTimeBucketBoundsMs()[i]}
+     * milliseconds, and at least the previous bound. The last element counts everything longer.
+     *
+     * @return a copy of the histogram
+     */
+    public long[] getAcquisitionWaitTimeHistogram() {
+        return acquisitionWaitTimeHistogram.clone();
+    }
+
+    /**
+     * @return upper bounds, in milliseconds, of the buckets of {@link #getAcquisitionWaitTimeHistogram()}
+     */
+    public static long[] getAcquisitionWaitTimeBucketBoundsMs() {
+        return ACQUISITION_WAIT_TIME_BUCKET_BOUNDS_MS.clone();
+    }
 }
@@ -17,6 +17,7 @@ public class HttpRequestBase {
     protected HttpVersion version = HttpVersion.HTTP_1_1;
     protected String method;
     protected String encodedPath;
+    protected HttpHeaderTemplate headerTemplate;
 
     /**
      * Only used for create request from native side.
@@ -102,4 +103,38 @@ public class HttpRequestBase {
         Collections.addAll(this.headers, headers);
 
     }
+
+    /**
+     * Attaches headers shared with other requests. They are added natively when the request is made, after the
+     * request's own headers, and aren't marshalled with the request. A header in {@link #getHeaders()} replaces all
+     * template headers of the same name.
+     * <p>
+     * Only used when the request is sent on a connection or stream manager, signing doesn't see template headers.
+     *
+     * @param headerTemplate (optional) template to attach, or null to detach the current one
+     */
+    public void setHeaderTemplate(final HttpHeaderTemplate headerTemplate) {
+        this.headerTemplate = headerTemplate;
+    }
+
+    /**
+     * @return the attached header template, or null
+     */
+    public HttpHeaderTemplate getHeaderTemplate() {
+        return headerTemplate;
+    }
+
+    /**
+     * @hidden
+     * @return native handle of the attached header template, or 0 if there is none
+     */
+    public long getHeaderTemplateNativeHandle() {
+        if (headerTemplate == null) {
+            return 0;
+        }
+        if (headerTemplate.isNull()) {
+            throw new IllegalStateException("HttpHeaderTemplate has been closed, can't make requests with it.");
+        }
+        return headerTemplate.getNativeHandle();
+    }
 }
@@ -0,0 +1,179 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.http;
+
+import software.amazon.awssdk.crt.CrtResource;
+
+/**
+ * An HTTP request that lives in native memory, edited in place.
+ * <p>
+ * Unlike {@link HttpRequest}, which is marshalled into a byte[] and re-parsed natively each time it's sent,
+ * each setter here writes straight into the native request, and sending it costs nothing extra.
+ * <p>
+ * A builder can be sent any number of times. Requests already sent are not affected by later edits: the native
+ * request is shared by the requests made from it until the next edit, which copies it first.
+ * Requests with a body stream get their own copy as they are made, since a body stream is specific to one request.
+ * <p>
+ * Setters throw IllegalStateException once the builder has been closed.
+ * <p>
+ * This class is not thread safe and should not be called from different threads.
+ */
+public class HttpRequestBuilder extends CrtResource {
+
+    private final HttpVersion version;
+    private HttpRequestBodyStream bodyStream;
+
+    /**
+     * Creates an empty HTTP/1.1 request
+     */
+    public HttpRequestBuilder() {
+        this(HttpVersion.HTTP_1_1);
+    }
+
+    /**
+     * @param version protocol version of the connections this request will be sent on
+     */
+    public HttpRequestBuilder(HttpVersion version) {
+        if (version == null) {
+            throw new IllegalArgumentException("HttpRequestBuilder version can't be null");
+        }
+        this.version = version;
+        acquireNativeHandle(httpRequestBuilderNew(version.getValue()));
+    }
+
+    /**
+     * @return protocol version of this request
+     */
+    public HttpVersion getVersion() {
+        return version;
+    }
+
+    /**
+     * @param method http verb to use
+     * @return this
+     */
+    public HttpRequestBuilder setMethod(String method) {
+        checkNotClosed();
+        httpRequestBuilderSetMethod(getNativeHandle(), method);
+        return this;
+    }
+
+    /**
+     * @param encodedPath path of the http request
+     * @return this
+     */
+    public HttpRequestBuilder setEncodedPath(String encodedPath) {
+        checkNotClosed();
+        httpRequestBuilderSetEncodedPath(getNativeHandle(), encodedPath);
+        return this;
+    }
+
+    /**
+     * Adds a header, after any existing headers of the same name.
+     *
+     * @param name header name
+     * @param value header value
+     * @return this
+     */
+    public HttpRequestBuilder addHeader(String name, String value) {
+        checkNotClosed();
+        httpRequestBuilderAddHeader(getNativeHandle(), name, value, false);
+        return this;
+    }
+
+    /**
+     * @param header header to add, after any existing headers of the same name
+     * @return this
+     */
+    public HttpRequestBuilder addHeader(HttpHeader header) {
+        return addHeader(header.getName(), header.getValue());
+    }
+
+    /**
+     * Sets a header, replacing any existing headers of the same name.
+     *
+     * @param name header name
+     * @param value header value
+     * @return this
+     */
+    public HttpRequestBuilder setHeader(String name, String value) {
+        checkNotClosed();
+        httpRequestBuilderAddHeader(getNativeHandle(), name, value, true);
+        return this;
+    }
+
+    /**
+     * @param name name of the headers to remove, compared case-insensitively
+     * @return this
+     */
+    public HttpRequestBuilder removeHeader(String name) {
+        checkNotClosed();
+        httpRequestBuilderRemoveHeader(getNativeHandle(), name);
+        return this;
+    }
+
+    /**
+     * Removes all headers. The method and path are kept.
+     *
+     * @return this
+     */
+    public HttpRequestBuilder clearHeaders() {
+        checkNotClosed();
+        httpRequestBuilderClearHeaders(getNativeHandle());
+        return this;
+    }
+
+    /**
+     * @param bodyStream (optional) interface to an object that will stream out the request body
+     * @return this
+     */
+    public HttpRequestBuilder setBodyStream(HttpRequestBodyStream bodyStream) {
+        this.bodyStream = bodyStream;
+        return this;
+    }
+
+    /**
+     * @return the request body stream, or null
+     */
+    public HttpRequestBodyStream getBodyStream() {
+        return bodyStream;
+    }
+
+    private void checkNotClosed() {
+        if (isNull()) {
+            throw new IllegalStateException("HttpRequestBuilder has been closed");
+        }
+    }
+
+    @Override
+    protected boolean canReleaseReferencesImmediately() {
+        return true;
+    }
+
+    @Override
+    protected void releaseNativeHandle() {
+        if (!isNull()) {
+            httpRequestBuilderDestroy(getNativeHandle());
+        }
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+    private static native long httpRequestBuilderNew(int version);
+
+    private static native void httpRequestBuilderDestroy(long builder);
+
+    private static native void httpRequestBuilderSetMethod(long builder, String method);
+
+    private static native void httpRequestBuilderSetEncodedPath(long builder, String encodedPath);
+
+    private static native void httpRequestBuilderAddHeader(long builder, String name, String value, boolean replace);
+
+    private static native void httpRequestBuilderRemoveHeader(long builder, String name);
+
+    private static native void httpRequestBuilderClearHeaders(long builder);
+}
@@ -24,6 +24,21 @@ public interface HttpStreamResponseHandler {
      */
     void onResponseHeaders(HttpStream stream, int responseStatusCode, int blockType, HttpHeader[] nextHeaders);
 
+    /**
+     * Called from Native when new Http Headers have been received, with a lazily decoded view of them.
+     * Override this instead of the HttpHeader[] variant to avoid decoding headers you don't look at.
+     * By default, decodes every header and calls {@link #onResponseHeaders(HttpStream, int, int, HttpHeader[])}.
+     *
+     * @param stream The HttpStream object
+     * @param responseStatusCode The HTTP Response Status Code
+     * @param blockType The HTTP header block type
+     * @param nextHeaders The headers received in the latest IO event, only valid during this call.
+     */
+    default void onResponseHeaders(HttpStream stream, int responseStatusCode, int blockType,
+            HttpHeadersView nextHeaders) {
+        onResponseHeaders(stream, responseStatusCode, blockType, nextHeaders.toArray());
+    }
+
     /**
      * Called from Native once all HTTP Headers are processed. Will not be called if there are no Http Headers in the
      * response. Guaranteed to be called exactly once if there is at least 1 Header.
@@ -58,6 +73,26 @@ public interface HttpStreamResponseHandler {
         return bodyBytesIn.length;
     }
 
+    /**
+     * Lets the native layer coalesce response body data before delivering it.
+     * <p>
+     * By default, {@code onResponseBody} is called for every chunk the HTTP decoder yields, which is often as small
+     * as a TLS record. If this returns a positive number, body data is accumulated natively until at least that
+     * many bytes are available, and then delivered in a single call. Whatever remains is delivered before trailing
+     * headers and before {@code onResponseComplete}. Chunks that are already large enough are delivered as they are.
+     * <p>
+     * The flow-control window is opened natively for the bytes being accumulated, so with manual window management
+     * up to this many bytes beyond the window may be received. Those bytes count towards the window increment
+     * returned from {@code onResponseBody} once they're delivered.
+     * <p>
+     * Called once, when the request is made.
+     *
+     * @return minimum number of bytes per {@code onResponseBody} call, or 0 to deliver data as it arrives
+     */
+    default int getMinimumResponseBodyChunkSize() {
+        return 0;
+    }
+
     /**
      * Called from Native when the Response has completed.
      * @param stream completed stream
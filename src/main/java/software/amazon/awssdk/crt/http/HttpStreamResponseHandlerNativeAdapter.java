@@ -25,11 +25,15 @@ class HttpStreamResponseHandlerNativeAdapter {
     }
 
     void onResponseHeaders(HttpStreamBase stream, int responseStatusCode, int blockType, ByteBuffer headersBlob) {
-        HttpHeader[] headersArray = HttpHeader.loadHeadersFromMarshalledHeadersBlob(headersBlob);
-        if (this.responseBaseHandler != null) {
-            responseBaseHandler.onResponseHeaders(stream, responseStatusCode, blockType, headersArray);
-        } else {
-            responseHandler.onResponseHeaders((HttpStream) stream, responseStatusCode, blockType, headersArray);
+        HttpHeadersView headers = new HttpHeadersView(headersBlob);
+        try {
+            if (this.responseBaseHandler != null) {
+                responseBaseHandler.onResponseHeaders(stream, responseStatusCode, blockType, headers);
+            } else {
+                responseHandler.onResponseHeaders((HttpStream) stream, responseStatusCode, blockType, headers);
+            }
+        } finally {
+            headers.invalidate();
         }
     }
 
@@ -41,8 +45,10 @@ class HttpStreamResponseHandlerNativeAdapter {
         }
     }
 
-    int onResponseBody(HttpStreamBase stream, ByteBuffer bodyBytesIn) {
-        byte[] body = new byte[bodyBytesIn.limit()];
+    /* bodyBytesIn may be reused from one call to the next, only its first length bytes are the body */
+    int onResponseBody(HttpStreamBase stream, ByteBuffer bodyBytesIn, int length) {
+        byte[] body = new byte[length];
+        bodyBytesIn.clear();
         bodyBytesIn.get(body);
         if (this.responseBaseHandler != null) {
             return responseBaseHandler.onResponseBody(stream, body);
@@ -51,6 +57,14 @@ class HttpStreamResponseHandlerNativeAdapter {
         }
     }
 
+    int getMinimumResponseBodyChunkSize() {
+        if (this.responseBaseHandler != null) {
+            return responseBaseHandler.getMinimumResponseBodyChunkSize();
+        } else {
+            return responseHandler.getMinimumResponseBodyChunkSize();
+        }
+    }
+
     void onResponseComplete(HttpStreamBase stream, int errorCode) {
         if (this.responseBaseHandler != null) {
             responseBaseHandler.onResponseComplete(stream, errorCode);
@@ -0,0 +1,251 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.http;
+
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import software.amazon.awssdk.crt.CrtResource;
+
+/**
+ * A connection pool split into several independent {@link HttpClientConnectionManager} shards.
+ * <p>
+ * A single connection manager serializes every acquisition and release behind one native lock, which becomes a
+ * contention point when many threads share the pool. Here each thread acquires from its own home shard, so threads
+ * mostly contend only with the others that share their shard. When every connection the home shard may have is
+ * already leased or being acquired, another shard with one to spare is used before waiting. Shards are picked from
+ * lease counts kept here, so picking one never has to take a shard's native lock.
+ * <p>
+ * Connections are returned to the shard they came from when closed. Limits in the options (max connections,
+ * min connections, max pending acquisitions) apply to the pool as a whole and are divided between the shards.
+ */
+public class ShardedHttpClientConnectionManager extends CrtResource {
+
+    private final HttpClientConnectionManager[] shards;
+    /* acquisitions made from each shard that haven't failed or been released yet */
+    private final AtomicInteger[] leases;
+    private final int maxConnections;
+    private volatile boolean closed = false;
+
+    /**
+     * Factory function for ShardedHttpClientConnectionManager instances
+     *
+     * @param options configuration options, shared by all the shards
+     * @param shardCount number of shards to split the pool into, typically the number of threads making requests.
+     *                   Capped at the maximum number of connections.
+     * @return a new instance of a ShardedHttpClientConnectionManager
+     */
+    public static ShardedHttpClientConnectionManager create(HttpClientConnectionManagerOptions options,
+            int shardCount) {
+        return new ShardedHttpClientConnectionManager(options, shardCount);
+    }
+
+    private ShardedHttpClientConnectionManager(HttpClientConnectionManagerOptions options, int shardCount) {
+        options.validateOptions();
+        if (shardCount <= 0) {
+            throw new IllegalArgumentException("Shard count must be greater than zero.");
+        }
+
+        this.maxConnections = options.getMaxConnections();
+        int count = Math.min(shardCount, maxConnections);
+        this.shards = new HttpClientConnectionManager[count];
+        this.leases = new AtomicInteger[count];
+
+        try {
+            for (int i = 0; i < count; ++i) {
+                HttpClientConnectionManagerOptions shardOptions = new HttpClientConnectionManagerOptions(options);
+                shardOptions.withMaxConnections(shareOf(options.getMaxConnections(), i, count));
+                shardOptions.withMinConnections(shareOf(options.getMinConnections(), i, count));
+                if (options.getMaxPendingConnectionAcquisitions() > 0) {
+                    /* 0 means unbounded, so every shard keeps at least 1 */
+                    shardOptions.withMaxPendingConnectionAcquisitions(
+                            Math.max(1, shareOf(options.getMaxPendingConnectionAcquisitions(), i, count)));
+                }
+
+                leases[i] = new AtomicInteger();
+                shards[i] = HttpClientConnectionManager.create(shardOptions);
+                addReferenceTo(shards[i]);
+                /* the reference above keeps it alive */
+                shards[i].close();
+            }
+        } catch (RuntimeException ex) {
+            close();
+            throw ex;
+        }
+    }
+
+    /* Shard index's part of total, when total is divided as evenly as possible between count shards */
+    private static int shareOf(int total, int index, int count) {
+        return total / count + (index < total % count ? 1 : 0);
+    }
+
+    private int homeShard() {
+        return (int) (Thread.currentThread().getId() % shards.length);
+    }
+
+    private boolean hasRoom(int shard) {
+        return leases[shard].get() < shards[shard].getMaxConnections();
+    }
+
+    /* Picks the shard to acquire from: the home shard, unless it's full and another isn't */
+    private int pickShard() {
+        int home = homeShard();
+        if (hasRoom(home)) {
+            return home;
+        }
+
+        /* the least loaded of the others, so stolen acquisitions spread out */
+        int picked = home;
+        int pickedSpare = 0;
+        for (int i = 1; i < shards.length; ++i) {
+            int shard = (home + i) % shards.length;
+            int spare = shards[shard].getMaxConnections() - leases[shard].get();
+            if (spare > pickedSpare) {
+                picked = shard;
+                pickedSpare = spare;
+            }
+        }
+
+        return picked;
+    }
+
+    /**
+     * Request a HttpClientConnection from the Connection Pool.
+     * @return A Future for a HttpClientConnection that will be completed when a connection is acquired.
+     */
+    public CompletableFuture<HttpClientConnection> acquireConnection() {
+        if (closed) {
+            throw new IllegalStateException(
+                    "ShardedHttpClientConnectionManager has been closed, can't acquire connections");
+        }
+        int shard = pickShard();
+        AtomicInteger shardLeases = leases[shard];
+        shardLeases.incrementAndGet();
+
+        CompletableFuture<HttpClientConnection> returnedFuture = new CompletableFuture<>();
+        shards[shard].acquireConnection().whenComplete((connection, error) -> {
+            if (error != null) {
+                shardLeases.decrementAndGet();
+                returnedFuture.completeExceptionally(error);
+                return;
+            }
+            connection.setReleaseCallback(shardLeases::decrementAndGet);
+            if (!returnedFuture.complete(connection)) {
+                // future was already completed/cancelled, return it immediately to the pool to not leak it
+                connection.close();
+            }
+        });
+        return returnedFuture;
+    }
+
+    /**
+     * Establishes connections ahead of demand, spread evenly across the shards.
+     *
+     * @param connections number of connections to have ready
+     * @return A Future completed with the number of connections warmed
+     * @see HttpClientConnectionManager#prewarm
+     */
+    public CompletableFuture<Integer> prewarm(int connections) {
+        if (closed) {
+            throw new IllegalStateException(
+                    "ShardedHttpClientConnectionManager has been closed, can't prewarm connections");
+        }
+        if (connections < 0) {
+            throw new IllegalArgumentException("Number of connections to prewarm must not be negative");
+        }
+
+        @SuppressWarnings("unchecked")
+        CompletableFuture<Integer>[] warmups = new CompletableFuture[shards.length];
+        for (int i = 0; i < shards.length; ++i) {
+            warmups[i] = shards[i].prewarm(shareOf(connections, i, shards.length));
+        }
+
+        return CompletableFuture.allOf(warmups).thenApply((ignored) -> {
+            int warmed = 0;
+            for (CompletableFuture<Integer> warmup : warmups) {
+                warmed += warmup.join();
+            }
+            return warmed;
+        });
+    }
+
+    /**
+     * Releases this HttpClientConnection back into the shard it was acquired from.
+     * @param conn Connection to release
+     */
+    public void releaseConnection(HttpClientConnection conn) {
+        conn.close();
+    }
+
+    /**
+     * @return a future that completes once every shard has finished shutting down
+     */
+    public CompletableFuture<Void> getShutdownCompleteFuture() {
+        CompletableFuture<?>[] shutdowns = new CompletableFuture<?>[shards.length];
+        for (int i = 0; i < shards.length; ++i) {
+            shutdowns[i] = shards[i].getShutdownCompleteFuture();
+        }
+        return CompletableFuture.allOf(shutdowns);
+    }
+
+    @Override
+    protected boolean canReleaseReferencesImmediately() { return true; }
+
+    @Override
+    protected void releaseNativeHandle() {
+        /* nothing native of its own, the shards are released with the other references */
+        closed = true;
+    }
+
+    /*******************************************************************************
+     * Getter methods
+     ******************************************************************************/
+
+    /**
+     * @return number of shards the pool is split into
+     */
+    public int getShardCount() {
+        return shards.length;
+    }
+
+    /**
+     * @return maximum number of connections pooled across all the shards
+     */
+    public int getMaxConnections() {
+        return maxConnections;
+    }
+
+    /**
+     * @return metrics of all the shards added together
+     */
+    public HttpManagerMetrics getManagerMetrics() {
+        if (closed) {
+            throw new IllegalStateException("ShardedHttpClientConnectionManager has been closed, can't fetch metrics");
+        }
+
+        long available = 0, pending = 0, leased = 0;
+        long succeeded = 0, failed = 0, rejected = 0, timedOut = 0, totalWaitNs = 0, maxWaitNs = 0;
+        long[] histogram = new long[HttpManagerMetrics.getAcquisitionWaitTimeBucketBoundsMs().length + 1];
+        for (HttpClientConnectionManager shard : shards) {
+            HttpManagerMetrics metrics = shard.getManagerMetrics();
+            available += metrics.getAvailableConcurrency();
+            pending += metrics.getPendingConcurrencyAcquires();
+            leased += metrics.getLeasedConcurrency();
+            succeeded += metrics.getAcquisitionsSucceeded();
+            failed += metrics.getAcquisitionsFailed();
+            rejected += metrics.getAcquisitionsRejected();
+            timedOut += metrics.getAcquisitionsTimedOut();
+            totalWaitNs += metrics.getTotalAcquisitionWaitTimeNs();
+            maxWaitNs = Math.max(maxWaitNs, metrics.getMaxAcquisitionWaitTimeNs());
+            long[] shardHistogram = metrics.getAcquisitionWaitTimeHistogram();
+            for (int i = 0; i < histogram.length && i < shardHistogram.length; ++i) {
+                histogram[i] += shardHistogram[i];
+            }
+        }
+
+        return new HttpManagerMetrics(available, pending, leased, succeeded, failed, rejected, timedOut, totalWaitNs,
+                maxWaitNs, histogram);
+    }
+}
@@ -0,0 +1,108 @@
+package software.amazon.awssdk.crt.io;
+
+/**
+ * A batch of entries found by a parallel DirectoryTraversal. Entries are held in parallel arrays, so each one only
+ * costs its two path strings; entry i of the batch is described by the i-th element of each array.
+ * <p>
+ * Each entry's size and modification time come from the one stat() the traversal made of it, so they don't need to
+ * be read again before an upload.
+ */
+public class DirectoryEntryBatch {
+
+    /* Must match AWS_FILE_TYPE_* in aws/common/file.h */
+    private static final int FILE_TYPE_FILE = 1;
+    private static final int FILE_TYPE_SYM_LINK = 2;
+    private static final int FILE_TYPE_DIRECTORY = 4;
+
+    private final String[] paths;
+    private final String[] relativePaths;
+    private final long[] fileSizes;
+    private final long[] lastModifiedTimesMillis;
+    private final int[] fileTypes;
+
+    DirectoryEntryBatch(String[] paths, String[] relativePaths, long[] fileSizes, long[] lastModifiedTimesMillis,
+                        int[] fileTypes) {
+        this.paths = paths;
+        this.relativePaths = relativePaths;
+        this.fileSizes = fileSizes;
+        this.lastModifiedTimesMillis = lastModifiedTimesMillis;
+        this.fileTypes = fileTypes;
+    }
+
+    /**
+     * @return the number of entries in the batch
+     */
+    public int size() {
+        return paths.length;
+    }
+
+    /**
+     * @param index index of the entry
+     * @return the absolute path of the entry
+     */
+    public String getPath(int index) {
+        return paths[index];
+    }
+
+    /**
+     * @param index index of the entry
+     * @return the path of the entry relative to the directory being traversed
+     */
+    public String getRelativePath(int index) {
+        return relativePaths[index];
+    }
+
+    /**
+     * @param index index of the entry
+     * @return the size of the entry in bytes
+     */
+    public long getFileSize(int index) {
+        return fileSizes[index];
+    }
+
+    /**
+     * @param index index of the entry
+     * @return when the entry was last modified, in milliseconds since the epoch, or -1 if it couldn't be read
+     */
+    public long getLastModifiedTimeMillis(int index) {
+        return lastModifiedTimesMillis[index];
+    }
+
+    /**
+     * @param index index of the entry
+     * @return true if the entry is a file
+     */
+    public boolean isFile(int index) {
+        return (fileTypes[index] & FILE_TYPE_FILE) != 0;
+    }
+
+    /**
+     * @param index index of the entry
+     * @return true if the entry is a directory
+     */
+    public boolean isDirectory(int index) {
+        return (fileTypes[index] & FILE_TYPE_DIRECTORY) != 0;
+    }
+
+    /**
+     * @param index index of the entry
+     * @return true if the entry is a symbolic link
+     */
+    public boolean isSymLink(int index) {
+        return (fileTypes[index] & FILE_TYPE_SYM_LINK) != 0;
+    }
+
+    /**
+     * @param index index of the entry
+     * @return the entry as a DirectoryEntry
+     */
+    public DirectoryEntry getEntry(int index) {
+        return new DirectoryEntry()
+            .withPath(paths[index])
+            .withRelativePath(relativePaths[index])
+            .withFileSize(fileSizes[index])
+            .withIsFile(isFile(index))
+            .withIsDirectory(isDirectory(index))
+            .withIsSymLink(isSymLink(index));
+    }
+}
@@ -0,0 +1,16 @@
+package software.amazon.awssdk.crt.io;
+
+/**
+ * Handler invoked during parallel calls to DirectoryTraversal.traverse() with each batch of entries found.
+ * Always invoked on the thread that called traverse(), one batch at a time.
+ */
+public interface DirectoryEntryBatchHandler {
+
+    /**
+     * Invoked during parallel calls to DirectoryTraversal.traverse() with each batch of entries found.
+     *
+     * @param batch the entries
+     * @return true to continue the traversal, or false to abort it
+     */
+    boolean onDirectoryEntries(final DirectoryEntryBatch batch);
+}
@@ -37,5 +37,46 @@ public final class DirectoryTraversal {
         crtTraverse(path, recursive, handler);
     }
 
+    /**
+     * Traverse a directory starting at the path provided, listing subdirectories in parallel on native threads and
+     * handing the entries found to the handler in batches.
+     *
+     * Each thread takes a whole subdirectory at a time, so there is no ordering between entries, not even the
+     * post-order of the serial traversal. The handler is only ever invoked on the calling thread, one batch at a
+     * time, and the threads pause while it falls behind.
+     *
+     * Cancellation and errors behave as in the serial traversal: returning false from the handler, an exception
+     * thrown from it, or a directory that can't be listed stops the traversal, and traverse throws a
+     * RuntimeException to notify the user about incomplete results.
+     *
+     * @param path directory to traverse.
+     * @param options how to traverse it, and which entries to report
+     * @param handler callback to invoke with each batch of entries
+     */
+    public static void traverse(final String path, final DirectoryTraversalOptions options,
+                                final DirectoryEntryBatchHandler handler) {
+        if (path == null) {
+            throw new IllegalArgumentException("path must not be null");
+        }
+        if (options == null) {
+            throw new IllegalArgumentException("options must not be null");
+        }
+        if (handler == null) {
+            throw new IllegalArgumentException("handler must not be null");
+        }
+        if (options.getBatchSize() <= 0) {
+            throw new IllegalArgumentException("batch size must be positive");
+        }
+
+        crtTraverseParallel(path, options.isRecursive(), options.getThreadCount(), options.getBatchSize(),
+            options.getFileNameGlob(), options.getMinFileSize(), options.getMaxFileSize(),
+            options.getIncludeDirectories(), handler);
+    }
+
     private static native void crtTraverse(final String path, boolean recursive, final DirectoryTraversalHandler handler);
+
+    private static native void crtTraverseParallel(final String path, boolean recursive, int threadCount,
+                                                   int batchSize, final String fileNameGlob, long minFileSize,
+                                                   long maxFileSize, boolean includeDirectories,
+                                                   final DirectoryEntryBatchHandler handler);
 }
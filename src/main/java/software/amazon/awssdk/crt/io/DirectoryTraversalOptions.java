@@ -0,0 +1,144 @@
+package software.amazon.awssdk.crt.io;
+
+/**
+ * Options for a parallel, batched DirectoryTraversal, see
+ * {@link DirectoryTraversal#traverse(String, DirectoryTraversalOptions, DirectoryEntryBatchHandler)}.
+ *
+ * @deprecated It is currently an EXPERIMENTAL feature meant for internal use only. It may be changed incompatibly
+ * or removed in a future version.
+ */
+@Deprecated()
+public class DirectoryTraversalOptions {
+
+    private static final int DEFAULT_BATCH_SIZE = 1024;
+    private static final int MAX_DEFAULT_THREAD_COUNT = 8;
+
+    private boolean recursive = true;
+    private int threadCount = 0;
+    private int batchSize = DEFAULT_BATCH_SIZE;
+    private String fileNameGlob;
+    private long minFileSize = 0;
+    private long maxFileSize = Long.MAX_VALUE;
+    private boolean includeDirectories = false;
+
+    /**
+     * @param recursive true (the default) to traverse every subdirectory, false to only list the directory itself
+     * @return this options object
+     */
+    public DirectoryTraversalOptions withRecursive(boolean recursive) {
+        this.recursive = recursive;
+        return this;
+    }
+
+    /**
+     * @return true if subdirectories are traversed
+     */
+    public boolean isRecursive() {
+        return recursive;
+    }
+
+    /**
+     * @param threadCount number of native threads listing directories in parallel, each taking whole
+     *                    subdirectories; 0 (the default) for one per processor, up to 8
+     * @return this options object
+     */
+    public DirectoryTraversalOptions withThreadCount(int threadCount) {
+        this.threadCount = threadCount;
+        return this;
+    }
+
+    /**
+     * @return the number of threads the traversal uses
+     */
+    public int getThreadCount() {
+        if (threadCount > 0) {
+            return threadCount;
+        }
+        return Math.min(MAX_DEFAULT_THREAD_COUNT, Math.max(1, Runtime.getRuntime().availableProcessors()));
+    }
+
+    /**
+     * @param batchSize maximum number of entries handed to the handler at a time, 1024 by default
+     * @return this options object
+     */
+    public DirectoryTraversalOptions withBatchSize(int batchSize) {
+        this.batchSize = batchSize;
+        return this;
+    }
+
+    /**
+     * @return the maximum number of entries in a batch
+     */
+    public int getBatchSize() {
+        return batchSize;
+    }
+
+    /**
+     * Only reports files whose name matches a glob pattern, where '*' matches any run of characters and '?' any
+     * single character (any single byte of its UTF-8 encoding, outside ASCII). The pattern is matched against the
+     * file name alone, not its directory.
+     *
+     * @param fileNameGlob the pattern, or null (the default) to report every file
+     * @return this options object
+     */
+    public DirectoryTraversalOptions withFileNameGlob(String fileNameGlob) {
+        this.fileNameGlob = fileNameGlob;
+        return this;
+    }
+
+    /**
+     * @return the file name pattern, or null if every file is reported
+     */
+    public String getFileNameGlob() {
+        return fileNameGlob;
+    }
+
+    /**
+     * @param minFileSize smallest size, in bytes, of the files reported
+     * @return this options object
+     */
+    public DirectoryTraversalOptions withMinFileSize(long minFileSize) {
+        this.minFileSize = minFileSize;
+        return this;
+    }
+
+    /**
+     * @return smallest size, in bytes, of the files reported
+     */
+    public long getMinFileSize() {
+        return minFileSize;
+    }
+
+    /**
+     * @param maxFileSize largest size, in bytes, of the files reported
+     * @return this options object
+     */
+    public DirectoryTraversalOptions withMaxFileSize(long maxFileSize) {
+        this.maxFileSize = maxFileSize;
+        return this;
+    }
+
+    /**
+     * @return largest size, in bytes, of the files reported
+     */
+    public long getMaxFileSize() {
+        return maxFileSize;
+    }
+
+    /**
+     * @param includeDirectories true to report directories as well as files; false by default. The filters only
+     *                           apply to files.
+     * @return this options object
+     */
+    public DirectoryTraversalOptions withIncludeDirectories(boolean includeDirectories) {
+        this.includeDirectories = includeDirectories;
+        return this;
+    }
+
+    /**
+     * @return true if directories are reported as well as files
+     */
+    public boolean getIncludeDirectories() {
+        return includeDirectories;
+    }
+}
@@ -17,6 +17,7 @@ import software.amazon.awssdk.crt.Log;
 public final class EventLoopGroup extends CrtResource {
 
     private final CompletableFuture<Void> shutdownComplete = new CompletableFuture<>();
+    private long metricsHandle = 0;
 
     /**
      * Creates a new event loop group for the I/O subsystem to use to run non-blocking I/O requests
@@ -54,6 +55,14 @@ public final class EventLoopGroup extends CrtResource {
         if (!isNull()) {
             eventLoopGroupDestroy(getNativeHandle());
         }
+
+        synchronized (this) {
+            if (metricsHandle != 0) {
+                /* probes still scheduled keep the native metrics alive until they see it's released */
+                EventLoopGroupMetrics.metricsRelease(metricsHandle);
+                metricsHandle = 0;
+            }
+        }
     }
 
     /**
@@ -69,6 +78,22 @@ public final class EventLoopGroup extends CrtResource {
 
     public CompletableFuture<Void> getShutdownCompleteFuture() { return shutdownComplete; }
 
+    /**
+     * Takes a snapshot of the statistics of every event loop in the group.
+     *
+     * Loops are only measured once this has been called: the first call starts a probe task on each loop, which runs
+     * every 100ms for as long as the group is open, and returns statistics that are close to empty.
+     * @return the snapshot
+     */
+    public EventLoopGroupMetrics getMetrics() {
+        synchronized (this) {
+            if (metricsHandle == 0) {
+                metricsHandle = EventLoopGroupMetrics.metricsNew(getNativeHandle());
+            }
+            return EventLoopGroupMetrics.fromNative(metricsHandle);
+        }
+    }
+
 
     /*
      * Static interface for access to a default, lazily-created event loop group for users who don't
@@ -0,0 +1,70 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.io;
+
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+
+/**
+ * A snapshot of the statistics of every event loop in an EventLoopGroup, see {@link EventLoopGroup#getMetrics()}.
+ */
+public class EventLoopGroupMetrics {
+
+    /* Must match event_loop_group_metric in event_loop_metrics.c */
+    private static final int TIMESTAMP_NS = 0;
+    private static final int LOOP_COUNT = 1;
+    private static final int LOOPS = 2;
+
+    private final long timestampNanos;
+    private final List<EventLoopMetrics> loops;
+
+    private EventLoopGroupMetrics(long[] values) {
+        if (values.length < LOOPS) {
+            throw new IllegalArgumentException("EventLoopGroupMetrics: unexpected number of values");
+        }
+        int loopCount = (int) values[LOOP_COUNT];
+        if (values.length != LOOPS + loopCount * EventLoopMetrics.VALUE_COUNT) {
+            throw new IllegalArgumentException("EventLoopGroupMetrics: unexpected number of values");
+        }
+
+        this.timestampNanos = values[TIMESTAMP_NS];
+        List<EventLoopMetrics> loops = new ArrayList<>(loopCount);
+        for (int i = 0; i < loopCount; ++i) {
+            int offset = LOOPS + i * EventLoopMetrics.VALUE_COUNT;
+            loops.add(new EventLoopMetrics(Arrays.copyOfRange(values, offset, offset + EventLoopMetrics.VALUE_COUNT)));
+        }
+        this.loops = Collections.unmodifiableList(loops);
+    }
+
+    /**
+     * Takes a snapshot of the native metrics behind an event loop group.
+     * @param metricsHandle handle of the native metrics
+     * @return the snapshot
+     */
+    static EventLoopGroupMetrics fromNative(long metricsHandle) {
+        return new EventLoopGroupMetrics(metricsSnapshot(metricsHandle));
+    }
+
+    /**
+     * @return when the snapshot was taken, in nanoseconds of a monotonic clock; only meaningful relative to other
+     * snapshots
+     */
+    public long getTimestampNanos() {
+        return timestampNanos;
+    }
+
+    /**
+     * @return the statistics of each loop in the group, in the group's order
+     */
+    public List<EventLoopMetrics> getEventLoops() {
+        return loops;
+    }
+
+    static native long metricsNew(long eventLoopGroup);
+    static native void metricsRelease(long metricsHandle);
+    private static native long[] metricsSnapshot(long metricsHandle);
+}
@@ -0,0 +1,102 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.io;
+
+import software.amazon.awssdk.crt.LatencyHistogram;
+
+import java.util.Arrays;
+
+/**
+ * The statistics of a single event loop, part of an {@link EventLoopGroupMetrics} snapshot. Counters are cumulative
+ * from the first call to {@link EventLoopGroup#getMetrics()}.
+ *
+ * Lateness is measured by a probe task the loop runs every 100ms: a loop kept busy, or blocked by a callback, runs
+ * it late, as it would every other scheduled task. Upcalls are the callbacks from the loop into Java; a slow one
+ * stalls everything else on the loop.
+ */
+public class EventLoopMetrics {
+
+    /* Must match event_loop_metric in event_loop_metrics.c */
+    private static final int BUSY_NS_LAST_SECOND = 0;
+    private static final int PROBES = 1;
+    private static final int MAX_LATENESS_NS = 2;
+    private static final int UPCALLS = 3;
+    private static final int UPCALL_NS = 4;
+    private static final int LATENESS_HISTOGRAM = 5;
+    private static final int UPCALL_DURATION_HISTOGRAM = LATENESS_HISTOGRAM + LatencyHistogram.BUCKET_COUNT;
+    static final int VALUE_COUNT = UPCALL_DURATION_HISTOGRAM + LatencyHistogram.BUCKET_COUNT;
+
+    private final long[] values;
+    private final LatencyHistogram lateness;
+    private final LatencyHistogram upcallDuration;
+
+    EventLoopMetrics(long[] values) {
+        if (values.length != VALUE_COUNT) {
+            throw new IllegalArgumentException("EventLoopMetrics: unexpected number of values");
+        }
+        this.values = values;
+        this.lateness = new LatencyHistogram(
+            Arrays.copyOfRange(values, LATENESS_HISTOGRAM, LATENESS_HISTOGRAM + LatencyHistogram.BUCKET_COUNT));
+        this.upcallDuration = new LatencyHistogram(Arrays.copyOfRange(
+            values, UPCALL_DURATION_HISTOGRAM, UPCALL_DURATION_HISTOGRAM + LatencyHistogram.BUCKET_COUNT));
+    }
+
+    /**
+     * @return nanoseconds the loop spent running tasks and handling I/O, rather than waiting for it, over its last
+     * one second window
+     */
+    public long getBusyNanosLastSecond() {
+        return values[BUSY_NS_LAST_SECOND];
+    }
+
+    /**
+     * @return the fraction of its last one second window the loop was busy, from 0 (idle) to 1 (saturated)
+     */
+    public double getUtilization() {
+        return Math.min(1.0, getBusyNanosLastSecond() / 1e9);
+    }
+
+    /**
+     * @return number of times the lateness probe has run
+     */
+    public long getLatenessProbes() {
+        return values[PROBES];
+    }
+
+    /**
+     * @return the latest the probe has run after it was due, in nanoseconds
+     */
+    public long getMaxTaskLatenessNanos() {
+        return values[MAX_LATENESS_NS];
+    }
+
+    /**
+     * @return how late the probe ran after it was due, each time it ran
+     */
+    public LatencyHistogram getTaskLateness() {
+        return lateness;
+    }
+
+    /**
+     * @return number of upcalls from the loop into Java
+     */
+    public long getUpcalls() {
+        return values[UPCALLS];
+    }
+
+    /**
+     * @return total nanoseconds the loop spent in upcalls into Java
+     */
+    public long getUpcallNanos() {
+        return values[UPCALL_NS];
+    }
+
+    /**
+     * @return the duration of each upcall into Java
+     */
+    public LatencyHistogram getUpcallDuration() {
+        return upcallDuration;
+    }
+}
@@ -7,6 +7,12 @@ package software.amazon.awssdk.crt.io;
 import software.amazon.awssdk.crt.CrtResource;
 import software.amazon.awssdk.crt.CrtRuntimeException;
 
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collection;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+
 /**
  * Java wrapper around the native CRT host resolver, responsible for performing async dns lookups
  */
@@ -27,7 +33,23 @@ public class HostResolver extends CrtResource {
      * @param maxEntries maximum size of the name to address mapping cache
      */
     public HostResolver(EventLoopGroup elg, int maxEntries) throws CrtRuntimeException {
-        acquireNativeHandle(hostResolverNew(elg.getNativeHandle(), maxEntries));
+        this(elg, maxEntries, 0, 0);
+    }
+
+    /**
+     *
+     * @param elg event loop group to pass to the host resolver.  Not currently used but still mandatory.
+     * @param maxEntries maximum size of the name to address mapping cache, and of the failed lookup cache
+     * @param maxTtlInSeconds how long resolved addresses are cached for, for lookups made through this resolver and
+     *                        every ClientBootstrap using it.  0 for the default of 30 seconds.
+     * @param negativeCacheTtlInSeconds how long a failed lookup made with {@link #resolve} is remembered for, so
+     *                                  resolving the same host again fails fast instead of going back to DNS.
+     *                                  0 disables negative caching.
+     */
+    public HostResolver(EventLoopGroup elg, int maxEntries, int maxTtlInSeconds, int negativeCacheTtlInSeconds)
+            throws CrtRuntimeException {
+        acquireNativeHandle(
+            hostResolverNew(elg.getNativeHandle(), maxEntries, maxTtlInSeconds, negativeCacheTtlInSeconds));
         addReferenceTo(elg);
     }
 
@@ -48,6 +70,46 @@ public class HostResolver extends CrtResource {
         }
     }
 
+    /**
+     * Resolves a host name to its addresses.  Addresses already cached are returned without a DNS lookup, and once
+     * resolved a host's addresses are cached and kept fresh in the background, for this resolver and every
+     * ClientBootstrap using it.
+     *
+     * @param hostName the host to resolve
+     * @return a future that completes with the host's addresses, IPv4 and IPv6 alike, or completes exceptionally with
+     * a CrtRuntimeException if the lookup failed
+     */
+    public CompletableFuture<List<String>> resolve(String hostName) {
+        if (hostName == null) {
+            throw new NullPointerException("hostName");
+        }
+        CompletableFuture<String[]> future = new CompletableFuture<>();
+        hostResolverResolve(getNativeHandle(), hostName, future);
+        return future.thenApply(addresses -> Arrays.asList(addresses));
+    }
+
+    /**
+     * Resolves a set of hosts ahead of time, so connections to them don't wait on DNS.  Lookups run concurrently, and
+     * a host that fails to resolve does not fail the others.
+     *
+     * @param hostNames the hosts to resolve
+     * @return a future that completes once every lookup has finished, successfully or not
+     */
+    public CompletableFuture<Void> prefetch(Collection<String> hostNames) {
+        List<CompletableFuture<?>> lookups = new ArrayList<>(hostNames.size());
+        for (String hostName : hostNames) {
+            lookups.add(resolve(hostName).handle((addresses, error) -> null));
+        }
+        return CompletableFuture.allOf(lookups.toArray(new CompletableFuture<?>[0]));
+    }
+
+    /**
+     * @return a snapshot of the lookups made through {@link #resolve} and {@link #prefetch}
+     */
+    public HostResolverStatistics getStatistics() {
+        return new HostResolverStatistics(hostResolverStatistics(getNativeHandle()));
+    }
+
     /*
      * Static interface for access to a default, lazily-created host resolver for users who don't
      * want to deal with the associated resource management.  Client bootstraps will use this host resolver
@@ -110,6 +172,10 @@ public class HostResolver extends CrtResource {
     /*******************************************************************************
      * native methods
      ******************************************************************************/
-    private static native long hostResolverNew(long el_group, int max_entries) throws CrtRuntimeException;
+    private static native long hostResolverNew(long el_group, int max_entries, int max_ttl_seconds,
+                                               int negative_ttl_seconds) throws CrtRuntimeException;
     private static native void hostResolverRelease(long host_resolver);
+    private static native void hostResolverResolve(long host_resolver, String host_name,
+                                                   CompletableFuture<String[]> future);
+    private static native long[] hostResolverStatistics(long host_resolver);
 }
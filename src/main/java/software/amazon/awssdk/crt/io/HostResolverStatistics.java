@@ -0,0 +1,57 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.io;
+
+/**
+ * A snapshot of the lookups made through a HostResolver's resolve() and prefetch().  All counters are cumulative from
+ * when the resolver was created.  Connections made through a ClientBootstrap resolve their hosts directly and are not
+ * counted.
+ */
+public class HostResolverStatistics {
+
+    /* Must match host_resolver_statistic in host_resolver.c */
+    private static final int CACHE_HITS = 0;
+    private static final int CACHE_MISSES = 1;
+    private static final int NEGATIVE_CACHE_HITS = 2;
+    private static final int RESOLVE_FAILURES = 3;
+    private static final int VALUE_COUNT = 4;
+
+    private final long[] values;
+
+    HostResolverStatistics(long[] values) {
+        if (values.length != VALUE_COUNT) {
+            throw new IllegalArgumentException("HostResolverStatistics: unexpected number of values");
+        }
+        this.values = values;
+    }
+
+    /**
+     * @return number of lookups of a host that already had addresses cached
+     */
+    public long getCacheHits() {
+        return values[CACHE_HITS];
+    }
+
+    /**
+     * @return number of lookups that had to wait on DNS
+     */
+    public long getCacheMisses() {
+        return values[CACHE_MISSES];
+    }
+
+    /**
+     * @return number of lookups failed straight away because the host recently failed to resolve
+     */
+    public long getNegativeCacheHits() {
+        return values[NEGATIVE_CACHE_HITS];
+    }
+
+    /**
+     * @return number of lookups that failed in DNS
+     */
+    public long getResolveFailures() {
+        return values[RESOLVE_FAILURES];
+    }
+}
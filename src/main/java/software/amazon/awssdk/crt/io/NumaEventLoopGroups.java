@@ -0,0 +1,97 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.io;
+
+import software.amazon.awssdk.crt.CrtRuntimeException;
+import software.amazon.awssdk.crt.SystemInfo;
+
+/**
+ * One EventLoopGroup per NUMA node (cpu group), each with its threads pinned to that node and a ClientBootstrap of its
+ * own. Connections made through a node's bootstrap only ever run on that node's cores, so clients built on them, like
+ * the shards of a {@link software.amazon.awssdk.crt.s3.ShardedS3Client}, keep their traffic off the socket
+ * interconnect.
+ * <p>
+ * All nodes share one HostResolver. On hosts with a single cpu group this is simply one pinned EventLoopGroup.
+ */
+public final class NumaEventLoopGroups implements AutoCloseable {
+
+    private final EventLoopGroup[] eventLoopGroups;
+    private final ClientBootstrap[] clientBootstraps;
+
+    /**
+     * Creates an EventLoopGroup and ClientBootstrap for every cpu group, sharing the static default HostResolver
+     * @param threadsPerNode number of threads in each node's EventLoopGroup; 0 for one per physical core of the node
+     * @throws CrtRuntimeException If any of the groups or bootstraps can't be created
+     */
+    public NumaEventLoopGroups(int threadsPerNode) throws CrtRuntimeException {
+        this(threadsPerNode, null);
+    }
+
+    /**
+     * Creates an EventLoopGroup and ClientBootstrap for every cpu group
+     * @param threadsPerNode number of threads in each node's EventLoopGroup; 0 for one per physical core of the node
+     * @param hostResolver resolver shared by every node's bootstrap, or null for the static default
+     * @throws CrtRuntimeException If any of the groups or bootstraps can't be created
+     */
+    public NumaEventLoopGroups(int threadsPerNode, HostResolver hostResolver) throws CrtRuntimeException {
+        if (threadsPerNode < 0) {
+            throw new IllegalArgumentException("NumaEventLoopGroups: threadsPerNode must be >= 0");
+        }
+
+        int nodeCount = Math.max(1, SystemInfo.getCpuGroupCount());
+        eventLoopGroups = new EventLoopGroup[nodeCount];
+        clientBootstraps = new ClientBootstrap[nodeCount];
+        try {
+            for (int node = 0; node < nodeCount; ++node) {
+                eventLoopGroups[node] = new EventLoopGroup(node, threadsPerNode);
+                clientBootstraps[node] = new ClientBootstrap(eventLoopGroups[node], hostResolver);
+            }
+        } catch (RuntimeException ex) {
+            close();
+            throw ex;
+        }
+    }
+
+    /**
+     * @return the number of nodes, and of event loop groups
+     */
+    public int getNodeCount() {
+        return eventLoopGroups.length;
+    }
+
+    /**
+     * @param node index of the node, from 0 to getNodeCount() - 1
+     * @return the EventLoopGroup pinned to the node
+     */
+    public EventLoopGroup getEventLoopGroup(int node) {
+        return eventLoopGroups[node];
+    }
+
+    /**
+     * @param node index of the node, from 0 to getNodeCount() - 1
+     * @return the ClientBootstrap running on the node's EventLoopGroup
+     */
+    public ClientBootstrap getClientBootstrap(int node) {
+        return clientBootstraps[node];
+    }
+
+    /**
+     * Releases every node's bootstrap and event loop group.  Clients still using them keep them alive until they
+     * shut down themselves.
+     */
+    @Override
+    public void close() {
+        for (int node = 0; node < eventLoopGroups.length; ++node) {
+            if (clientBootstraps[node] != null) {
+                clientBootstraps[node].close();
+                clientBootstraps[node] = null;
+            }
+            if (eventLoopGroups[node] != null) {
+                eventLoopGroups[node].close();
+                eventLoopGroups[node] = null;
+            }
+        }
+    }
+}
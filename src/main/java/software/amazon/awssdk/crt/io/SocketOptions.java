@@ -95,6 +95,19 @@ public final class SocketOptions extends CrtResource {
 
     }
 
+    /**
+     * Creates socket options for IPC between processes on the same host: UNIX domain sockets, or named pipes on
+     * Windows, which skip the TCP/IP stack entirely. Listeners and connections using them take the socket path (or
+     * pipe name) as their host name and ignore the port. TLS adds nothing on such connections and is best left off.
+     * @return new socket options for local IPC
+     */
+    public static SocketOptions createForLocalIpc() {
+        SocketOptions options = new SocketOptions();
+        options.domain = SocketDomain.LOCAL;
+        options.type = SocketType.STREAM;
+        return options;
+    }
+
     @Override
     public long getNativeHandle() {
         if (super.getNativeHandle() == 0) {
@@ -51,7 +51,18 @@ public class TlsContext extends CrtResource {
         }
     }
 
+    /**
+     * Takes a snapshot of the handshakes made by connections using this context.  Handshakes are counted from the
+     * moment the context was created; connections still handshaking when it is closed are not counted.
+     * @return the snapshot
+     */
+    public TlsHandshakeMetrics getHandshakeMetrics() {
+        return new TlsHandshakeMetrics(tlsContextHandshakeMetrics(getNativeHandle()));
+    }
+
     protected static native long tlsContextNew(long options) throws CrtRuntimeException;
 
     private static native void tlsContextDestroy(long elg);
+
+    private static native long[] tlsContextHandshakeMetrics(long tlsContext);
 };
@@ -0,0 +1,89 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.io;
+
+import software.amazon.awssdk.crt.LatencyHistogram;
+
+import java.util.Arrays;
+
+/**
+ * A snapshot of the TLS handshakes made with a TlsContext, over every connection using it since it was created. All
+ * counters are cumulative, so rates come from comparing two snapshots, for example with
+ * <code>getHandshakesSucceededPerSecondSince()</code>.
+ */
+public class TlsHandshakeMetrics {
+
+    /* Must match tls_handshake_metric in tls_handshake_metrics.c */
+    private static final int TIMESTAMP_NS = 0;
+    private static final int HANDSHAKES_SUCCEEDED = 1;
+    private static final int HANDSHAKES_FAILED = 2;
+    private static final int HANDSHAKE_LATENCY_HISTOGRAM = 3;
+    private static final int VALUE_COUNT = HANDSHAKE_LATENCY_HISTOGRAM + LatencyHistogram.BUCKET_COUNT;
+
+    private final long[] values;
+    private final LatencyHistogram handshakeLatency;
+
+    TlsHandshakeMetrics(long[] values) {
+        if (values.length != VALUE_COUNT) {
+            throw new IllegalArgumentException("TlsHandshakeMetrics: unexpected number of values");
+        }
+        this.values = values;
+        this.handshakeLatency = new LatencyHistogram(Arrays.copyOfRange(
+            values, HANDSHAKE_LATENCY_HISTOGRAM, HANDSHAKE_LATENCY_HISTOGRAM + LatencyHistogram.BUCKET_COUNT));
+    }
+
+    /**
+     * @return when the snapshot was taken, in nanoseconds of a monotonic clock; only meaningful relative to other
+     * snapshots
+     */
+    public long getTimestampNanos() {
+        return values[TIMESTAMP_NS];
+    }
+
+    /**
+     * @return number of handshakes that completed successfully
+     */
+    public long getHandshakesSucceeded() {
+        return values[HANDSHAKES_SUCCEEDED];
+    }
+
+    /**
+     * @return number of handshakes that failed, timeouts and certificate validation failures included
+     */
+    public long getHandshakesFailed() {
+        return values[HANDSHAKES_FAILED];
+    }
+
+    /**
+     * @return latencies from the start of each handshake until it succeeded or failed
+     */
+    public LatencyHistogram getHandshakeLatency() {
+        return handshakeLatency;
+    }
+
+    /**
+     * @param earlier a snapshot of the same context taken before this one
+     * @return the rate handshakes succeeded at between the two snapshots, or 0 if no time passed
+     */
+    public double getHandshakesSucceededPerSecondSince(TlsHandshakeMetrics earlier) {
+        return perSecondSince(earlier, HANDSHAKES_SUCCEEDED);
+    }
+
+    /**
+     * @param earlier a snapshot of the same context taken before this one
+     * @return the rate handshakes failed at between the two snapshots, or 0 if no time passed
+     */
+    public double getHandshakesFailedPerSecondSince(TlsHandshakeMetrics earlier) {
+        return perSecondSince(earlier, HANDSHAKES_FAILED);
+    }
+
+    private double perSecondSince(TlsHandshakeMetrics earlier, int index) {
+        long elapsedNanos = getTimestampNanos() - earlier.getTimestampNanos();
+        if (elapsedNanos <= 0) {
+            return 0;
+        }
+        return (values[index] - earlier.values[index]) * 1e9 / elapsedNanos;
+    }
+}
@@ -15,6 +15,7 @@ import software.amazon.awssdk.crt.io.SocketOptions;
 import software.amazon.awssdk.crt.io.TlsContext;
 import software.amazon.awssdk.crt.mqtt.MqttConnectionConfig;
 
+import java.nio.ByteBuffer;
 import java.util.concurrent.CompletableFuture;
 import java.util.function.Consumer;
 
@@ -38,8 +39,12 @@ public class MqttClientConnection extends CrtResource {
     private class MessageHandler {
         Consumer<MqttMessage> callback;
 
+        /* read by native when the handler is installed, picks deliverDirect() over deliver() */
+        final boolean directPayload;
+
         private MessageHandler(Consumer<MqttMessage> callback) {
             this.callback = callback;
+            this.directPayload = config.getDirectPayloadDelivery();
         }
 
         /* called from native when a message is delivered */
@@ -47,6 +52,17 @@ public class MqttClientConnection extends CrtResource {
             QualityOfService qosEnum = QualityOfService.getEnumValueFromInteger(qos);
             callback.accept(new MqttMessage(topic, payload, qosEnum, retain, dup));
         }
+
+        /* called from native when a message is delivered, the payload is only valid until this returns */
+        void deliverDirect(String topic, ByteBuffer payload, boolean dup, int qos, boolean retain) {
+            QualityOfService qosEnum = QualityOfService.getEnumValueFromInteger(qos);
+            MqttMessage message = new MqttMessage(topic, payload, qosEnum, retain, dup);
+            try {
+                callback.accept(message);
+            } finally {
+                message.releasePayloadBuffer();
+            }
+        }
     }
 
     /**
@@ -33,6 +33,7 @@ public final class MqttConnectionConfig extends CrtResource {
     private long maxReconnectTimeoutSecs = 0L;
     private int protocolOperationTimeoutMs = 0;
     private boolean cleanSession = true;
+    private boolean directPayloadDelivery = false;
 
     /* will */
     private MqttMessage willMessage;
@@ -517,6 +518,29 @@ public final class MqttConnectionConfig extends CrtResource {
         return websocketHandshakeTransform;
     }
 
+    /**
+     * Sets whether received messages are delivered with their payload as a direct ByteBuffer over native memory,
+     * instead of a byte[] copied onto the Java heap for every message.
+     *
+     * With this on, {@link MqttMessage#getPayloadBuffer()} is only valid while the message handler is running, and
+     * {@link MqttMessage#getPayload()} copies the payload into a byte[] the first time it is called, which must also
+     * be while the handler is running.
+     *
+     * @param directPayloadDelivery whether to deliver payloads as direct ByteBuffers. Defaults to false.
+     */
+    public void setDirectPayloadDelivery(boolean directPayloadDelivery) {
+        this.directPayloadDelivery = directPayloadDelivery;
+    }
+
+    /**
+     * Queries whether received messages are delivered with their payload as a direct ByteBuffer
+     *
+     * @return whether payloads are delivered as direct ByteBuffers
+     */
+    public boolean getDirectPayloadDelivery() {
+        return directPayloadDelivery;
+    }
+
     /**
      * Creates a (shallow) clone of this config object
      *
@@ -537,6 +561,7 @@ public final class MqttConnectionConfig extends CrtResource {
             clone.setPingTimeoutMs(getPingTimeoutMs());
             clone.setProtocolOperationTimeoutMs(getProtocolOperationTimeoutMs());
             clone.setCleanSession(getCleanSession());
+            clone.setDirectPayloadDelivery(getDirectPayloadDelivery());
 
             clone.setWillMessage(getWillMessage());
 
@@ -4,12 +4,17 @@
  */
 package software.amazon.awssdk.crt.mqtt;
 
+import java.nio.ByteBuffer;
+
 /**
  * Represents a message to publish, or a message that was received.
  */
 public final class MqttMessage {
     private String topic;
-    private final byte[] payload;
+    private byte[] payload;
+    /* set for messages delivered with direct payload delivery, only valid until the handler returns */
+    private ByteBuffer payloadBuffer;
+    private boolean payloadBufferReleased;
     private QualityOfService qos;
     private boolean retain;
     private boolean dup;
@@ -68,6 +73,15 @@ public final class MqttMessage {
         this(topic, payload, qos, false, false);
     }
 
+    /**
+     * Constructs a received message whose payload is a view of native memory. Only called for connections with
+     * direct payload delivery on.
+     */
+    MqttMessage(String topic, ByteBuffer payloadBuffer, QualityOfService qos, boolean retain, boolean dup) {
+        this(topic, (byte[]) null, qos, retain, dup);
+        this.payloadBuffer = payloadBuffer;
+    }
+
     /**
      * @deprecated Use alternate constructor.
      * @param topic   Message topic.
@@ -91,9 +105,41 @@ public final class MqttMessage {
      * @return Message payload
      */
     public byte[] getPayload() {
+        if (payload == null && payloadBuffer != null) {
+            payload = new byte[payloadBuffer.remaining()];
+            payloadBuffer.duplicate().get(payload);
+        } else if (payload == null && payloadBufferReleased) {
+            throw new IllegalStateException("MqttMessage: payload was not copied before the message handler returned");
+        }
         return payload;
     }
 
+    /**
+     * Gets the message payload as a ByteBuffer. For a message received on a connection with direct payload delivery
+     * on, this is a direct buffer over native memory, valid only until the message handler returns; otherwise it
+     * wraps the byte[] payload.
+     *
+     * @return Message payload
+     * @throws IllegalStateException if the direct payload is used after the message handler returned
+     */
+    public ByteBuffer getPayloadBuffer() {
+        if (payloadBuffer != null) {
+            return payloadBuffer;
+        }
+        if (payloadBufferReleased && payload == null) {
+            throw new IllegalStateException("MqttMessage: payload buffer is only valid inside the message handler");
+        }
+        return payload != null ? ByteBuffer.wrap(payload) : null;
+    }
+
+    /**
+     * Called once the message handler has returned, after which the native memory behind the payload is gone
+     */
+    void releasePayloadBuffer() {
+        payloadBuffer = null;
+        payloadBufferReleased = true;
+    }
+
     /**
      * Gets the {@link QualityOfService}. When sending, the {@link QualityOfService}
      * to use for delivery. When receiving, the {@link QualityOfService} used for
@@ -4,7 +4,12 @@
  */
 package software.amazon.awssdk.crt.mqtt5;
 
+import java.nio.ByteBuffer;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
 import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentHashMap;
 import java.util.function.Consumer;
 
 import software.amazon.awssdk.crt.CrtResource;
@@ -46,6 +51,22 @@ public class Mqtt5Client extends CrtResource {
      */
     private boolean isConnected;
 
+    /**
+     * The publish events to deliver lazily-decoded messages to, null unless lazy publish packets are on
+     */
+    private Mqtt5ClientOptions.PublishEvents lazyPublishEvents;
+
+    /**
+     * Handlers registered with addTopicHandler, by the id the native topic router knows them by
+     */
+    private final ConcurrentHashMap<Long, Mqtt5ClientOptions.PublishEvents> topicHandlers = new ConcurrentHashMap<>();
+
+    /**
+     * The id of the handler registered for each topic filter; guards registration as well
+     */
+    private final Map<String, Long> topicHandlerIds = new HashMap<>();
+    private long nextTopicHandlerId = 1;
+
     /**
      * Creates a Mqtt5Client instance using the provided Mqtt5ClientOptions. Once the Mqtt5Client is created,
      * changing the settings will not cause a change in already created Mqtt5Client's.
@@ -60,6 +81,9 @@ public class Mqtt5Client extends CrtResource {
         HttpProxyOptions proxyOptions = options.getHttpProxyOptions();
         ConnectPacket connectionOptions = options.getConnectOptions();
         this.websocketHandshakeTransform = options.getWebsocketHandshakeTransform();
+        if (options.getLazyPublishPackets()) {
+            this.lazyPublishEvents = options.getPublishEvents();
+        }
 
         if (bootstrap == null) {
             bootstrap = ClientBootstrap.getOrCreateStaticDefault();
@@ -154,6 +178,106 @@ public class Mqtt5Client extends CrtResource {
         return publishFuture;
     }
 
+    /**
+     * Routes incoming messages whose topic matches a topic filter to a handler of their own.
+     *
+     * Filters are matched natively, with the usual MQTT wildcards: '+' matches a single topic level and a
+     * trailing '#' matches any number of levels. A message that matches one or more filters goes to each of their
+     * handlers, and not to the client's PublishEvents; a message that matches none goes to the client's
+     * PublishEvents, or, if the client has none, is dropped without ever crossing into Java.
+     *
+     * This only routes messages; subscribing to the topics is still up to the caller. Registering a filter that
+     * already has a handler replaces it.
+     *
+     * @param topicFilter topic filter to route, possibly with wildcards
+     * @param handler handler to deliver matching messages to
+     * @throws IllegalArgumentException if the topic filter is not valid
+     */
+    public void addTopicHandler(String topicFilter, Mqtt5ClientOptions.PublishEvents handler) {
+        if (handler == null) {
+            throw new IllegalArgumentException("Mqtt5Client.addTopicHandler: handler cannot be null");
+        }
+
+        synchronized (topicHandlerIds) {
+            long handlerId = nextTopicHandlerId++;
+            topicHandlers.put(handlerId, handler);
+            try {
+                mqtt5ClientInternalAddTopicRoute(getNativeHandle(), topicFilter, handlerId);
+            } catch (RuntimeException ex) {
+                topicHandlers.remove(handlerId);
+                throw ex;
+            }
+
+            Long previousId = topicHandlerIds.put(topicFilter, handlerId);
+            if (previousId != null) {
+                topicHandlers.remove(previousId);
+            }
+        }
+    }
+
+    /**
+     * Stops routing messages for a topic filter registered with addTopicHandler.
+     *
+     * @param topicFilter topic filter to stop routing
+     * @return true if the topic filter had a handler
+     */
+    public boolean removeTopicHandler(String topicFilter) {
+        synchronized (topicHandlerIds) {
+            Long handlerId = topicHandlerIds.remove(topicFilter);
+            if (handlerId == null) {
+                return false;
+            }
+
+            mqtt5ClientInternalRemoveTopicRoute(getNativeHandle(), topicFilter);
+            topicHandlers.remove(handlerId);
+            return true;
+        }
+    }
+
+    /**
+     * Tells the Mqtt5Client to attempt to send a batch of PUBLISH packets.
+     *
+     * All of the packets are converted and queued in a single native call, and their outcomes are reported together
+     * through one future, completed once every publish in the batch has completed. A publish that fails, including
+     * one that could not be queued, fails only its own entry in the result; the future itself is only completed
+     * exceptionally if the results cannot be reported at all.
+     *
+     * @param publishPackets PUBLISH packets to send to the server, in order
+     * @return A future that will be resolved with the outcome of each publish, in the same order as the packets
+     */
+    public CompletableFuture<PublishBatchResult> publishBatch(List<PublishPacket> publishPackets) {
+        CompletableFuture<int[]> batchFuture = new CompletableFuture<>();
+        mqtt5ClientInternalPublishBatch(getNativeHandle(), publishPackets.toArray(new PublishPacket[0]), batchFuture);
+        return batchFuture.thenApply(PublishBatchResult::new);
+    }
+
+    /**
+     * Tells the Mqtt5Client to attempt to send a PUBLISH packet, taking the payload from a direct ByteBuffer
+     * instead of the packet.
+     *
+     * The bytes between the buffer's position and limit are read straight from off-heap memory, with no heap byte[]
+     * and no copy through the JVM. The native client has taken its own copy by the time this returns, so the buffer
+     * may be reused or released immediately; its position is left unchanged.
+     *
+     * @param publishPacket PUBLISH packet to send to the server, without a payload of its own
+     * @param payload direct ByteBuffer holding the payload of the publish
+     * @return A future that will be rejected with an error or resolved with a PublishResult response
+     * @throws IllegalArgumentException if the buffer is not direct, or the packet also has a payload
+     */
+    public CompletableFuture<PublishResult> publish(PublishPacket publishPacket, ByteBuffer payload) {
+        if (payload == null || !payload.isDirect()) {
+            throw new IllegalArgumentException("Mqtt5Client.publish: payload must be a direct ByteBuffer");
+        }
+        if (publishPacket != null && publishPacket.getPayload() != null) {
+            throw new IllegalArgumentException("Mqtt5Client.publish: packet cannot have a payload of its own");
+        }
+
+        CompletableFuture<PublishResult> publishFuture = new CompletableFuture<>();
+        mqtt5ClientInternalPublishDirect(getNativeHandle(), publishPacket, payload, payload.position(),
+            payload.remaining(), publishFuture);
+        return publishFuture;
+    }
+
     /**
      * Tells the Mqtt5Client to attempt to subscribe to one or more topic filters.
      *
@@ -186,6 +310,16 @@ public class Mqtt5Client extends CrtResource {
         return mqtt5ClientInternalGetOperationStatistics(getNativeHandle());
     }
 
+    /**
+     * Returns statistics about everything the Mqtt5Client has done since it was created: publish latency
+     * histograms, payload throughput and connection history. The counters are kept natively as the client runs, and
+     * copied out together in a single call.
+     * @return A snapshot of the client's extended statistics.
+     */
+    public Mqtt5ClientExtendedStatistics getExtendedStatistics() {
+        return new Mqtt5ClientExtendedStatistics(mqtt5ClientInternalGetExtendedStatistics(getNativeHandle()));
+    }
+
     /**
      * Returns the connectivity state for the Mqtt5Client.
      * @return True if the client is connected, false otherwise
@@ -228,6 +362,39 @@ public class Mqtt5Client extends CrtResource {
         }
     }
 
+    /**
+     * Called from native code to deliver a message with lazy publish packets on.  The payload points at native
+     * memory that's only valid for the duration of this call.
+     */
+    private void onLazyPublishReceived(long[] handlerIds, String topic, ByteBuffer payload, int qos, boolean retain,
+            byte[] encodedProperties) {
+        if (handlerIds == null && lazyPublishEvents == null) {
+            return;
+        }
+        PublishReturn publishReturn = new PublishReturn(topic, payload, qos, retain, encodedProperties);
+        try {
+            if (handlerIds != null) {
+                onRoutedPublishReceived(handlerIds, publishReturn);
+            } else {
+                lazyPublishEvents.onMessageReceived(this, publishReturn);
+            }
+        } finally {
+            publishReturn.releaseView();
+        }
+    }
+
+    /**
+     * Called from native code to deliver a message to the topic handlers whose filters it matched.
+     */
+    private void onRoutedPublishReceived(long[] handlerIds, PublishReturn publishReturn) {
+        for (long handlerId : handlerIds) {
+            Mqtt5ClientOptions.PublishEvents handler = topicHandlers.get(handlerId);
+            if (handler != null) {
+                handler.onMessageReceived(this, publishReturn);
+            }
+        }
+    }
+
     /*******************************************************************************
      * native methods
      ******************************************************************************/
@@ -241,8 +408,13 @@ public class Mqtt5Client extends CrtResource {
     private static native void mqtt5ClientInternalStart(long client);
     private static native void mqtt5ClientInternalStop(long client, DisconnectPacket disconnect_options);
     private static native void mqtt5ClientInternalPublish(long client, PublishPacket publish_options, CompletableFuture<PublishResult> publish_result);
+    private static native void mqtt5ClientInternalPublishBatch(long client, PublishPacket[] publish_options, CompletableFuture<int[]> batch_results);
+    private static native void mqtt5ClientInternalPublishDirect(long client, PublishPacket publish_options, ByteBuffer payload, int position, int length, CompletableFuture<PublishResult> publish_result);
     private static native void mqtt5ClientInternalSubscribe(long client, SubscribePacket subscribe_options, CompletableFuture<SubAckPacket> subscribe_suback);
     private static native void mqtt5ClientInternalUnsubscribe(long client, UnsubscribePacket unsubscribe_options, CompletableFuture<UnsubAckPacket> unsubscribe_suback);
     private static native void mqtt5ClientInternalWebsocketHandshakeComplete(long connection, byte[] marshalledRequest, Throwable throwable, long nativeUserData) throws CrtRuntimeException;
+    private static native void mqtt5ClientInternalAddTopicRoute(long client, String topicFilter, long handlerId);
+    private static native boolean mqtt5ClientInternalRemoveTopicRoute(long client, String topicFilter);
     private static native Mqtt5ClientOperationStatistics mqtt5ClientInternalGetOperationStatistics(long client);
+    private static native long[] mqtt5ClientInternalGetExtendedStatistics(long client);
 }
@@ -0,0 +1,191 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.mqtt5;
+
+import java.util.Arrays;
+
+import software.amazon.awssdk.crt.LatencyHistogram;
+
+/**
+ * A snapshot of what an Mqtt5Client has done since it was created: publish latencies, throughput and connection
+ * history. All counters are cumulative, so rates come from comparing two snapshots, for example with
+ * <code>getPayloadBytesPublishedPerSecondSince()</code>.
+ *
+ * Byte counts are of message payloads, not of the bytes on the wire.
+ */
+public class Mqtt5ClientExtendedStatistics {
+
+    /* Must match aws_mqtt5_client_java_extended_statistic in mqtt5_client.c */
+    private static final int TIMESTAMP_NS = 0;
+    private static final int PUBLISHES_COMPLETED = 1;
+    private static final int PUBLISHES_FAILED = 2;
+    private static final int PAYLOAD_BYTES_PUBLISHED = 3;
+    private static final int MESSAGES_RECEIVED = 4;
+    private static final int PAYLOAD_BYTES_RECEIVED = 5;
+    private static final int CONNECTION_SUCCESSES = 6;
+    private static final int CONNECTION_FAILURES = 7;
+    private static final int DISCONNECTIONS = 8;
+    private static final int DISCONNECTED_NS = 9;
+    private static final int OFFLINE_QUEUE_MESSAGES = 10;
+    private static final int OFFLINE_QUEUE_BYTES = 11;
+    private static final int OFFLINE_QUEUE_DROPPED = 12;
+    private static final int QOS0_LATENCY_HISTOGRAM = 13;
+    private static final int QOS1_LATENCY_HISTOGRAM = QOS0_LATENCY_HISTOGRAM + LatencyHistogram.BUCKET_COUNT;
+    private static final int VALUE_COUNT = QOS1_LATENCY_HISTOGRAM + LatencyHistogram.BUCKET_COUNT;
+
+    private final long[] values;
+    private final LatencyHistogram qos0PublishLatency;
+    private final LatencyHistogram qos1PublishLatency;
+
+    /**
+     * This is only called from Mqtt5Client, with the values copied out of native in one call.
+     * @param values the statistics, in the layout native writes them
+     */
+    Mqtt5ClientExtendedStatistics(long[] values) {
+        if (values.length != VALUE_COUNT) {
+            throw new IllegalArgumentException("Mqtt5ClientExtendedStatistics: unexpected number of values");
+        }
+        this.values = values;
+        this.qos0PublishLatency = new LatencyHistogram(
+            Arrays.copyOfRange(values, QOS0_LATENCY_HISTOGRAM, QOS0_LATENCY_HISTOGRAM + LatencyHistogram.BUCKET_COUNT));
+        this.qos1PublishLatency = new LatencyHistogram(
+            Arrays.copyOfRange(values, QOS1_LATENCY_HISTOGRAM, QOS1_LATENCY_HISTOGRAM + LatencyHistogram.BUCKET_COUNT));
+    }
+
+    /**
+     * @return when the snapshot was taken, in nanoseconds of a monotonic clock; only meaningful relative to other
+     * snapshots
+     */
+    public long getTimestampNanos() {
+        return values[TIMESTAMP_NS];
+    }
+
+    /**
+     * @return number of publishes that completed successfully
+     */
+    public long getPublishesCompleted() {
+        return values[PUBLISHES_COMPLETED];
+    }
+
+    /**
+     * @return number of publishes that failed, including those that timed out or were dropped from the offline queue
+     */
+    public long getPublishesFailed() {
+        return values[PUBLISHES_FAILED];
+    }
+
+    /**
+     * @return total payload bytes of the publishes that completed successfully
+     */
+    public long getPayloadBytesPublished() {
+        return values[PAYLOAD_BYTES_PUBLISHED];
+    }
+
+    /**
+     * @return number of messages received from the server
+     */
+    public long getMessagesReceived() {
+        return values[MESSAGES_RECEIVED];
+    }
+
+    /**
+     * @return total payload bytes of the messages received from the server
+     */
+    public long getPayloadBytesReceived() {
+        return values[PAYLOAD_BYTES_RECEIVED];
+    }
+
+    /**
+     * @return number of times the client successfully connected
+     */
+    public long getConnectionSuccesses() {
+        return values[CONNECTION_SUCCESSES];
+    }
+
+    /**
+     * @return number of connection attempts that failed
+     */
+    public long getConnectionFailures() {
+        return values[CONNECTION_FAILURES];
+    }
+
+    /**
+     * @return number of times an established connection was lost or closed
+     */
+    public long getDisconnections() {
+        return values[DISCONNECTIONS];
+    }
+
+    /**
+     * Returns the time the client has spent disconnected: from losing a connection, or failing its first attempt,
+     * until it next connected, including the time so far if it is disconnected now.
+     * @return milliseconds spent disconnected
+     */
+    public long getTimeDisconnectedMillis() {
+        return values[DISCONNECTED_NS] / 1_000_000;
+    }
+
+    /**
+     * @return number of publishes waiting in the client's offline queue, or 0 if it has no offline queue limits
+     */
+    public long getOfflineQueueMessages() {
+        return values[OFFLINE_QUEUE_MESSAGES];
+    }
+
+    /**
+     * @return encoded size of the publishes waiting in the client's offline queue, in bytes
+     */
+    public long getOfflineQueueBytes() {
+        return values[OFFLINE_QUEUE_BYTES];
+    }
+
+    /**
+     * @return number of publishes the offline queue's overflow policy has dropped
+     */
+    public long getOfflineQueueDropped() {
+        return values[OFFLINE_QUEUE_DROPPED];
+    }
+
+    /**
+     * Returns the latency of QoS 0 publishes, from the call to publish() until the packet was written to the socket.
+     * This is how long publishes wait in the client's queue.
+     * @return histogram of QoS 0 publish latencies
+     */
+    public LatencyHistogram getQos0PublishLatency() {
+        return qos0PublishLatency;
+    }
+
+    /**
+     * Returns the latency of QoS 1 publishes, from the call to publish() until the PUBACK was received.
+     * @return histogram of QoS 1 publish latencies
+     */
+    public LatencyHistogram getQos1PublishLatency() {
+        return qos1PublishLatency;
+    }
+
+    /**
+     * @param earlier a snapshot from the same client, taken before this one
+     * @return payload bytes published per second between the two snapshots
+     */
+    public double getPayloadBytesPublishedPerSecondSince(Mqtt5ClientExtendedStatistics earlier) {
+        return perSecondSince(earlier, PAYLOAD_BYTES_PUBLISHED);
+    }
+
+    /**
+     * @param earlier a snapshot from the same client, taken before this one
+     * @return payload bytes received per second between the two snapshots
+     */
+    public double getPayloadBytesReceivedPerSecondSince(Mqtt5ClientExtendedStatistics earlier) {
+        return perSecondSince(earlier, PAYLOAD_BYTES_RECEIVED);
+    }
+
+    private double perSecondSince(Mqtt5ClientExtendedStatistics earlier, int index) {
+        long elapsedNanos = getTimestampNanos() - earlier.getTimestampNanos();
+        if (elapsedNanos <= 0) {
+            return 0;
+        }
+        return (values[index] - earlier.values[index]) * 1_000_000_000.0 / elapsedNanos;
+    }
+}
@@ -40,6 +40,10 @@ public class Mqtt5ClientOptions {
     private ClientSessionBehavior sessionBehavior = ClientSessionBehavior.DEFAULT;
     private ExtendedValidationAndFlowControlOptions extendedValidationAndFlowControlOptions = ExtendedValidationAndFlowControlOptions.NONE;
     private ClientOfflineQueueBehavior offlineQueueBehavior = ClientOfflineQueueBehavior.DEFAULT;
+    private Long offlineQueueMaxMessages;
+    private Long offlineQueueMaxBytes;
+    private OfflineQueueOverflowPolicy offlineQueueOverflowPolicy = OfflineQueueOverflowPolicy.DROP_NEWEST;
+    private String offlineQueueSpillPath;
     private JitterMode retryJitterMode = JitterMode.Default;
     private Long minReconnectDelayMs;
     private Long maxReconnectDelayMs;
@@ -50,6 +54,7 @@ public class Mqtt5ClientOptions {
     private LifecycleEvents lifecycleEvents;
     private Consumer<Mqtt5WebsocketHandshakeTransformArgs> websocketHandshakeTransform;
     private PublishEvents publishEvents;
+    private boolean lazyPublishPackets = false;
 
     /**
      * Returns the host name of the MQTT server to connect to.
@@ -156,6 +161,46 @@ public class Mqtt5ClientOptions {
         return this.offlineQueueBehavior;
     }
 
+    /**
+     * Returns the most publishes the client holds while it is disconnected, or null for no limit.
+     *
+     * @return the most publishes the client holds while it is disconnected
+     */
+    public Long getOfflineQueueMaxMessages()
+    {
+        return this.offlineQueueMaxMessages;
+    }
+
+    /**
+     * Returns the most bytes of publishes the client holds while it is disconnected, or null for no limit.
+     *
+     * @return the most bytes of publishes the client holds while it is disconnected
+     */
+    public Long getOfflineQueueMaxBytes()
+    {
+        return this.offlineQueueMaxBytes;
+    }
+
+    /**
+     * Returns which publish the client drops when holding another while disconnected would exceed a limit.
+     *
+     * @return which publish the client drops when its offline queue is full
+     */
+    public OfflineQueueOverflowPolicy getOfflineQueueOverflowPolicy()
+    {
+        return this.offlineQueueOverflowPolicy;
+    }
+
+    /**
+     * Returns the file QoS 1 publishes are kept in while the client is disconnected, or null to keep them in memory.
+     *
+     * @return the file QoS 1 publishes are kept in while the client is disconnected
+     */
+    public String getOfflineQueueSpillPath()
+    {
+        return this.offlineQueueSpillPath;
+    }
+
     /**
      * Returns how the reconnect delay is modified in order to smooth out the distribution of reconnection attempt
      * time points for a large set of reconnecting clients.
@@ -259,6 +304,16 @@ public class Mqtt5ClientOptions {
         return this.publishEvents;
     }
 
+    /**
+     * Returns whether received messages are passed to PublishEvents as a lazily-decoded view instead of a fully
+     * built PublishPacket.
+     *
+     * @return whether received messages are delivered lazily
+     */
+    public boolean getLazyPublishPackets() {
+        return this.lazyPublishPackets;
+    }
+
     /**
      * Creates a Mqtt5ClientOptionsBuilder instance
      * @param builder The builder to get the Mqtt5ClientOptions values from
@@ -274,6 +329,10 @@ public class Mqtt5ClientOptions {
         this.sessionBehavior = builder.sessionBehavior;
         this.extendedValidationAndFlowControlOptions = builder.extendedValidationAndFlowControlOptions;
         this.offlineQueueBehavior = builder.offlineQueueBehavior;
+        this.offlineQueueMaxMessages = builder.offlineQueueMaxMessages;
+        this.offlineQueueMaxBytes = builder.offlineQueueMaxBytes;
+        this.offlineQueueOverflowPolicy = builder.offlineQueueOverflowPolicy;
+        this.offlineQueueSpillPath = builder.offlineQueueSpillPath;
         this.retryJitterMode = builder.retryJitterMode;
         this.minReconnectDelayMs = builder.minReconnectDelayMs;
         this.maxReconnectDelayMs = builder.maxReconnectDelayMs;
@@ -284,6 +343,7 @@ public class Mqtt5ClientOptions {
         this.lifecycleEvents = builder.lifecycleEvents;
         this.websocketHandshakeTransform = builder.websocketHandshakeTransform;
         this.publishEvents = builder.publishEvents;
+        this.lazyPublishPackets = builder.lazyPublishPackets;
     }
 
     /*******************************************************************************
@@ -543,6 +603,64 @@ public class Mqtt5ClientOptions {
         private static Map<Integer, ClientOfflineQueueBehavior> enumMapping = buildEnumMapping();
     }
 
+    /**
+     * Controls which publish is dropped when the client holds another while disconnected, and doing so would exceed
+     * the offline queue's message or byte limit. A dropped publish's future completes exceptionally with
+     * AWS_ERROR_MQTT5_OPERATION_FAILED_DUE_TO_OFFLINE_QUEUE_POLICY.
+     */
+    public enum OfflineQueueOverflowPolicy {
+
+        /**
+         * Drop the new publish, keeping everything already queued.
+         */
+        DROP_NEWEST(0),
+
+        /**
+         * Drop the oldest queued publishes until the new one fits.
+         */
+        DROP_OLDEST(1),
+
+        /**
+         * Drop the oldest queued QoS 0 publishes until the new one fits. Once only QoS 1 publishes are queued, a new
+         * QoS 0 publish is dropped, and a new QoS 1 publish drops the oldest one.
+         */
+        DROP_QOS0_FIRST(2);
+
+        private int type;
+
+        private OfflineQueueOverflowPolicy(int code) {
+            type = code;
+        }
+
+        /**
+         * @return The native enum integer value associated with this Java enum value
+         */
+        public int getValue() {
+            return type;
+        }
+
+        /**
+         * Creates a Java OfflineQueueOverflowPolicy enum value from a native integer value.
+         *
+         * @param value native integer value for the offline queue overflow policy
+         * @return a new OfflineQueueOverflowPolicy value
+         */
+        public static OfflineQueueOverflowPolicy getEnumValueFromInteger(int value) {
+            OfflineQueueOverflowPolicy enumValue = enumMapping.get(value);
+            if (enumValue != null) {
+                return enumValue;
+            }
+            throw new RuntimeException("Illegal OfflineQueueOverflowPolicy");
+        }
+
+        private static Map<Integer, OfflineQueueOverflowPolicy> buildEnumMapping() {
+            return Stream.of(OfflineQueueOverflowPolicy.values())
+                .collect(Collectors.toMap(OfflineQueueOverflowPolicy::getValue, Function.identity()));
+        }
+
+        private static Map<Integer, OfflineQueueOverflowPolicy> enumMapping = buildEnumMapping();
+    }
+
     /**
      * All of the options for a Mqtt5Client. This includes the settings to make a connection, as well as the
      * event callbacks, publish callbacks, and more.
@@ -563,6 +681,10 @@ public class Mqtt5ClientOptions {
         private ClientSessionBehavior sessionBehavior = ClientSessionBehavior.DEFAULT;
         private ExtendedValidationAndFlowControlOptions extendedValidationAndFlowControlOptions = ExtendedValidationAndFlowControlOptions.NONE;
         private ClientOfflineQueueBehavior offlineQueueBehavior = ClientOfflineQueueBehavior.DEFAULT;
+        private Long offlineQueueMaxMessages;
+        private Long offlineQueueMaxBytes;
+        private OfflineQueueOverflowPolicy offlineQueueOverflowPolicy = OfflineQueueOverflowPolicy.DROP_NEWEST;
+        private String offlineQueueSpillPath;
         private JitterMode retryJitterMode = JitterMode.Default;
         private Long minReconnectDelayMs;
         private Long maxReconnectDelayMs;
@@ -573,6 +695,7 @@ public class Mqtt5ClientOptions {
         private LifecycleEvents lifecycleEvents;
         private Consumer<Mqtt5WebsocketHandshakeTransformArgs> websocketHandshakeTransform;
         private PublishEvents publishEvents;
+        private boolean lazyPublishPackets = false;
 
         /**
          * Sets the host name of the MQTT server to connect to.
@@ -700,6 +823,63 @@ public class Mqtt5ClientOptions {
             return this;
         }
 
+        /**
+         * Sets the most publishes the client holds while it is disconnected. Setting any offline queue limit, or a
+         * spill path, gives the client its own bounded queue: publishes made while it is not connected, at any QoS,
+         * wait there, in order, and are handed on once it connects. Publishes already handed on when a connection
+         * drops are still governed by the ClientOfflineQueueBehavior.
+         *
+         * @param offlineQueueMaxMessages the most publishes held while disconnected, or null for no limit
+         * @return The Mqtt5ClientOptionsBuilder after setting the offline queue message limit
+         */
+        public Mqtt5ClientOptionsBuilder withOfflineQueueMaxMessages(Long offlineQueueMaxMessages)
+        {
+            this.offlineQueueMaxMessages = offlineQueueMaxMessages;
+            return this;
+        }
+
+        /**
+         * Sets the most bytes of publishes the client holds while it is disconnected, counting each publish's
+         * topic, payload and properties. A publish bigger than this on its own is always dropped.
+         *
+         * @param offlineQueueMaxBytes the most bytes held while disconnected, or null for no limit
+         * @return The Mqtt5ClientOptionsBuilder after setting the offline queue byte limit
+         */
+        public Mqtt5ClientOptionsBuilder withOfflineQueueMaxBytes(Long offlineQueueMaxBytes)
+        {
+            this.offlineQueueMaxBytes = offlineQueueMaxBytes;
+            return this;
+        }
+
+        /**
+         * Sets which publish the client drops when holding another while disconnected would exceed a limit.
+         *
+         * @param offlineQueueOverflowPolicy which publish is dropped. Defaults to DROP_NEWEST.
+         * @return The Mqtt5ClientOptionsBuilder after setting the offline queue overflow policy
+         */
+        public Mqtt5ClientOptionsBuilder withOfflineQueueOverflowPolicy(OfflineQueueOverflowPolicy offlineQueueOverflowPolicy)
+        {
+            this.offlineQueueOverflowPolicy = offlineQueueOverflowPolicy;
+            return this;
+        }
+
+        /**
+         * Sets a file to keep QoS 1 publishes in while the client is disconnected, instead of in memory, so a long
+         * outage doesn't grow the heap and queued messages outlive the process. A client created on a file that
+         * already holds publishes, left by a client that was closed or crashed before it could reconnect, sends them
+         * when it first connects; they have no futures. The file is emptied each time the queue is handed on.
+         *
+         * Only one client may use a file at a time.
+         *
+         * @param offlineQueueSpillPath path of the spill file, created if it doesn't exist, or null for none
+         * @return The Mqtt5ClientOptionsBuilder after setting the offline queue spill path
+         */
+        public Mqtt5ClientOptionsBuilder withOfflineQueueSpillPath(String offlineQueueSpillPath)
+        {
+            this.offlineQueueSpillPath = offlineQueueSpillPath;
+            return this;
+        }
+
         /**
          * Sets how the reconnect delay is modified in order to smooth out the distribution of reconnection attempt
          * time points for a large set of reconnecting clients.
@@ -829,6 +1009,21 @@ public class Mqtt5ClientOptions {
             return this;
         }
 
+        /**
+         * Sets whether received messages are passed to PublishEvents lazily. When set, only the topic and a
+         * direct buffer over the payload in native memory are passed up for each message, and the PublishPacket
+         * with the rest of the message's properties is only built if PublishReturn.getPublishPacket() is called.
+         * This saves most of the per-message allocation for handlers that only need the topic and payload, but the
+         * PublishReturn and its payload buffer are only valid until onMessageReceived returns.
+         *
+         * @param lazyPublishPackets whether received messages are delivered lazily. Defaults to false.
+         * @return The Mqtt5ClientOptionsBuilder after setting whether messages are delivered lazily
+         */
+        public Mqtt5ClientOptionsBuilder withLazyPublishPackets(boolean lazyPublishPackets) {
+            this.lazyPublishPackets = lazyPublishPackets;
+            return this;
+        }
+
         /**
          * Creates a new Mqtt5ClientOptionsBuilder instance
          *
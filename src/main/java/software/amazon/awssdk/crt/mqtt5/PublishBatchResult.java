@@ -0,0 +1,73 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.mqtt5;
+
+import software.amazon.awssdk.crt.CRT;
+import software.amazon.awssdk.crt.mqtt5.packets.PubAckPacket.PubAckReasonCode;
+
+/**
+ * The outcome of every publish sent by <code>Mqtt5Client.publishBatch()</code>, indexed in the order the packets
+ * were given.
+ *
+ * To keep a batch cheap, only the error code and, for QoS 1, the PUBACK reason code of each publish are kept. The
+ * reason string and user properties of each PUBACK are not; use <code>Mqtt5Client.publish()</code> if those are
+ * needed.
+ */
+public class PublishBatchResult {
+
+    /* [error code, PUBACK reason code] for each publish */
+    private final int[] results;
+
+    /**
+     * This is only called from Mqtt5Client, with the results reported by native.
+     * @param results the error code and PUBACK reason code of each publish, interleaved
+     */
+    PublishBatchResult(int[] results) {
+        this.results = results;
+    }
+
+    /**
+     * @return the number of publishes in the batch
+     */
+    public int size() {
+        return results.length / 2;
+    }
+
+    /**
+     * Returns whether a publish was sent, and for QoS 1 acknowledged, without error. A publish the server
+     * acknowledged with a failing reason code still counts as succeeded here; check its reason code as well.
+     * @param index index of the publish in the batch
+     * @return true if the publish completed without error
+     */
+    public boolean succeeded(int index) {
+        return getErrorCode(index) == 0;
+    }
+
+    /**
+     * @param index index of the publish in the batch
+     * @return the CRT error code the publish failed with, or 0 if it succeeded
+     */
+    public int getErrorCode(int index) {
+        return results[index * 2];
+    }
+
+    /**
+     * @param index index of the publish in the batch
+     * @return the name of the error the publish failed with, or null if it succeeded
+     */
+    public String getErrorName(int index) {
+        return succeeded(index) ? null : CRT.awsErrorName(getErrorCode(index));
+    }
+
+    /**
+     * Returns the reason code the server acknowledged a QoS 1 publish with. QoS 0 publishes, and publishes that
+     * failed, report SUCCESS.
+     * @param index index of the publish in the batch
+     * @return the PUBACK reason code of the publish
+     */
+    public PubAckReasonCode getPubAckReasonCode(int index) {
+        return PubAckReasonCode.getEnumValueFromInteger(results[index * 2 + 1]);
+    }
+}
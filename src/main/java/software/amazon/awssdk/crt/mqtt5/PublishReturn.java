@@ -4,24 +4,78 @@
  */
 package software.amazon.awssdk.crt.mqtt5;
 
+import java.nio.ByteBuffer;
+
 import software.amazon.awssdk.crt.mqtt5.packets.PublishPacket;
 
 /**
  * The data returned when a publish is made to a topic the MQTT5 client is subscribed to.
  * The data contained within can be gotten using the <code>get</code> functions.
  * For example, <code>getPublishPacket</code> will return the PublishPacket received from the server.
+ * <p>
+ * When the client was created with lazy publish packets (see
+ * {@link Mqtt5ClientOptions.Mqtt5ClientOptionsBuilder#withLazyPublishPackets}), only the topic and a view of the
+ * payload are passed up from native code, and the PublishPacket is only built if <code>getPublishPacket</code> is
+ * called. In that mode a PublishReturn, and its payload buffer, are only valid during
+ * {@link Mqtt5ClientOptions.PublishEvents#onMessageReceived}.
  */
 public class PublishReturn {
     private PublishPacket publishPacket;
 
+    /* Lazy mode only */
+    private String topic;
+    private ByteBuffer payloadBuffer;
+    private int qos;
+    private boolean retain;
+    private byte[] encodedProperties;
+    private boolean viewReleased = false;
+
     /**
      * Returns the PublishPacket returned from the server or Null if none was returned.
      * @return The PublishPacket returned from the server.
+     * @throws IllegalStateException if the packet is lazily decoded and is requested after onMessageReceived
+     *     returned
      */
     public PublishPacket getPublishPacket() {
+        if (publishPacket == null && payloadBuffer != null) {
+            if (viewReleased) {
+                throw new IllegalStateException(
+                    "A lazily decoded PublishPacket must be requested during onMessageReceived");
+            }
+            byte[] payload = new byte[payloadBuffer.remaining()];
+            payloadBuffer.duplicate().get(payload);
+            publishPacket = PublishPacket.fromReceived(topic, payload, qos, retain, encodedProperties);
+        }
         return publishPacket;
     }
 
+    /**
+     * Returns the topic the message was published to, without building the PublishPacket when it's lazily decoded.
+     * @return The topic of the message
+     */
+    public String getTopic() {
+        if (payloadBuffer != null) {
+            return topic;
+        }
+        return publishPacket != null ? publishPacket.getTopic() : null;
+    }
+
+    /**
+     * Returns the message payload, without building the PublishPacket when it's lazily decoded. With lazy publish
+     * packets this is a read-only direct buffer over the received bytes in native memory, which must not be used
+     * after onMessageReceived returns: copy anything that needs to be kept.
+     * @return The payload of the message
+     */
+    public ByteBuffer getPayloadBuffer() {
+        if (payloadBuffer != null) {
+            return payloadBuffer;
+        }
+        if (publishPacket == null || publishPacket.getPayload() == null) {
+            return null;
+        }
+        return ByteBuffer.wrap(publishPacket.getPayload()).asReadOnlyBuffer();
+    }
+
     /**
      * This is only called in JNI to make a new PublishReturn with a PUBLISH packet.
      * @param newPublishPacket The PubAckPacket data for QoS 1 packets. Can be null if result is non QoS 1.
@@ -30,4 +84,22 @@ public class PublishReturn {
     private PublishReturn(PublishPacket newPublishPacket) {
         this.publishPacket = newPublishPacket;
     }
+
+    /**
+     * Makes a lazily-decoded PublishReturn over a message delivered by native code.
+     */
+    PublishReturn(String topic, ByteBuffer payload, int qos, boolean retain, byte[] encodedProperties) {
+        this.topic = topic;
+        this.payloadBuffer = payload.asReadOnlyBuffer();
+        this.qos = qos;
+        this.retain = retain;
+        this.encodedProperties = encodedProperties;
+    }
+
+    /**
+     * Called once onMessageReceived returns, after which the native payload memory is gone.
+     */
+    void releaseView() {
+        viewReleased = true;
+    }
 }
@@ -6,6 +6,9 @@ package software.amazon.awssdk.crt.mqtt5.packets;
 
 import software.amazon.awssdk.crt.mqtt5.QOS;
 
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
 import java.util.List;
 import java.util.Map;
 import java.util.function.Function;
@@ -185,6 +188,85 @@ public class PublishPacket {
 
     private PublishPacket() {}
 
+    /* Optional property flags, must match s_encode_lazy_publish_properties() in mqtt5_client.c */
+    private static final int ENCODED_PAYLOAD_FORMAT = 1;
+    private static final int ENCODED_MESSAGE_EXPIRY_INTERVAL = 1 << 1;
+    private static final int ENCODED_RESPONSE_TOPIC = 1 << 2;
+    private static final int ENCODED_CORRELATION_DATA = 1 << 3;
+    private static final int ENCODED_CONTENT_TYPE = 1 << 4;
+
+    /**
+     * @hidden Builds a received PublishPacket from the parts a lazily-decoded PublishReturn holds.  The encoded
+     * properties are laid out as:
+     * [flags: 4][payload format: 4][message expiry: 4][response topic length: 4][response topic]
+     * [correlation data length: 4][correlation data][content type length: 4][content type]
+     * [subscription identifier count: 4][subscription identifier: 4]*
+     * [user property count: 4]([name length: 4][name][value length: 4][value])*
+     * where each optional property is only present if its flag is set.
+     *
+     * @param topic the topic the message was published to
+     * @param payload the message payload
+     * @param qos the QoS the message was delivered with
+     * @param retain whether the message was retained
+     * @param encodedProperties the optional properties, or null if there were none
+     * @return the PublishPacket
+     */
+    public static PublishPacket fromReceived(String topic, byte[] payload, int qos, boolean retain,
+            byte[] encodedProperties) {
+        PublishPacket packet = new PublishPacket();
+        packet.topic = topic;
+        packet.payload = payload;
+        packet.nativeSetQOS(qos);
+        packet.retain = retain;
+        if (encodedProperties == null) {
+            return packet;
+        }
+
+        ByteBuffer properties = ByteBuffer.wrap(encodedProperties);
+        int flags = properties.getInt();
+        if ((flags & ENCODED_PAYLOAD_FORMAT) != 0) {
+            packet.nativeSetPayloadFormatIndicator(properties.getInt());
+        }
+        if ((flags & ENCODED_MESSAGE_EXPIRY_INTERVAL) != 0) {
+            packet.messageExpiryIntervalSeconds = Integer.toUnsignedLong(properties.getInt());
+        }
+        if ((flags & ENCODED_RESPONSE_TOPIC) != 0) {
+            packet.responseTopic = new String(getLengthPrefixed(properties), StandardCharsets.UTF_8);
+        }
+        if ((flags & ENCODED_CORRELATION_DATA) != 0) {
+            packet.correlationData = getLengthPrefixed(properties);
+        }
+        if ((flags & ENCODED_CONTENT_TYPE) != 0) {
+            packet.contentType = new String(getLengthPrefixed(properties), StandardCharsets.UTF_8);
+        }
+
+        int subscriptionIdentifierCount = properties.getInt();
+        if (subscriptionIdentifierCount > 0) {
+            packet.subscriptionIdentifiers = new ArrayList<>(subscriptionIdentifierCount);
+            for (int i = 0; i < subscriptionIdentifierCount; ++i) {
+                packet.subscriptionIdentifiers.add(Integer.toUnsignedLong(properties.getInt()));
+            }
+        }
+
+        int userPropertyCount = properties.getInt();
+        if (userPropertyCount > 0) {
+            packet.userProperties = new ArrayList<>(userPropertyCount);
+            for (int i = 0; i < userPropertyCount; ++i) {
+                String name = new String(getLengthPrefixed(properties), StandardCharsets.UTF_8);
+                String value = new String(getLengthPrefixed(properties), StandardCharsets.UTF_8);
+                packet.userProperties.add(new UserProperty(name, value));
+            }
+        }
+
+        return packet;
+    }
+
+    private static byte[] getLengthPrefixed(ByteBuffer buffer) {
+        byte[] bytes = new byte[buffer.getInt()];
+        buffer.get(bytes);
+        return bytes;
+    }
+
     /**
      * A native, JNI-only helper function for more easily setting the QOS
      * @param QOSValue A int representing the QoS
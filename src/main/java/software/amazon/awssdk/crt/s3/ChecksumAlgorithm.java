@@ -20,7 +20,13 @@ public enum ChecksumAlgorithm {
 
     SHA1(3),
 
-    SHA256(4);
+    SHA256(4),
+
+    /**
+     * Computed by the binding only, see {@link S3MetaRequestOptions#withResponseBodyChecksumAlgorithm}.
+     * Not yet supported by aws-c-s3, so {@link ChecksumConfig} rejects it with an IllegalArgumentException.
+     */
+    CRC64NVME(5);
 
     ChecksumAlgorithm(int nativeValue) {
         this.nativeValue = nativeValue;
@@ -46,6 +52,7 @@ public enum ChecksumAlgorithm {
         enumMapping.put(CRC32.getNativeValue(), CRC32);
         enumMapping.put(SHA1.getNativeValue(), SHA1);
         enumMapping.put(SHA256.getNativeValue(), SHA256);
+        enumMapping.put(CRC64NVME.getNativeValue(), CRC64NVME);
         return enumMapping;
     }
 
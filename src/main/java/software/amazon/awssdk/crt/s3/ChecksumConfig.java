@@ -4,11 +4,16 @@
  */
 package software.amazon.awssdk.crt.s3;
 
+import java.util.ArrayList;
 import java.util.List;
 import java.util.Collections;
 
 public class ChecksumConfig {
 
+    /* the binding computes CRC64NVME itself for downloads, aws-c-s3 has no CRC64NVME for request checksums yet */
+    private static final String CRC64NVME_UNSUPPORTED = "ChecksumConfig: CRC64NVME is not supported by aws-c-s3 for "
+            + "request or response checksums, see S3MetaRequestOptions.withResponseBodyChecksumAlgorithm";
+
     public enum ChecksumLocation {
 
         NONE(0),
@@ -70,8 +75,12 @@ public class ChecksumConfig {
      * @param algorithm The checksum algorithm used to calculate the checksum of
      *                  payload uploaded.
      * @return this
+     * @throws IllegalArgumentException if algorithm is CRC64NVME
      */
     public ChecksumConfig withChecksumAlgorithm(ChecksumAlgorithm algorithm) {
+        if (algorithm == ChecksumAlgorithm.CRC64NVME) {
+            throw new IllegalArgumentException(CRC64NVME_UNSUPPORTED);
+        }
         this.checksumAlgorithm = algorithm;
         return this;
     }
@@ -122,10 +131,15 @@ public class ChecksumConfig {
      * @param validateChecksumAlgorithmList The list of algorithm picked to validate
      *                                      checksum from response.
      * @return this
+     * @throws IllegalArgumentException if the list contains CRC64NVME
      */
     public ChecksumConfig withValidateChecksumAlgorithmList(List<ChecksumAlgorithm> validateChecksumAlgorithmList) {
+        if (validateChecksumAlgorithmList != null && validateChecksumAlgorithmList.contains(ChecksumAlgorithm.CRC64NVME)) {
+            throw new IllegalArgumentException(CRC64NVME_UNSUPPORTED);
+        }
+        /* copied, so the list can't gain CRC64NVME after it was checked */
         this.validateChecksumAlgorithmList = validateChecksumAlgorithmList != null
-                ? Collections.unmodifiableList(validateChecksumAlgorithmList)
+                ? Collections.unmodifiableList(new ArrayList<>(validateChecksumAlgorithmList))
                 : null;
         return this;
     }
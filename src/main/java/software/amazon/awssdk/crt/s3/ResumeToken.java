@@ -4,6 +4,8 @@
  */
 package software.amazon.awssdk.crt.s3;
 
+import java.util.BitSet;
+
 public class ResumeToken {
 
     static public class PutResumeTokenBuilder {
@@ -58,11 +60,90 @@ public class ResumeToken {
         } 
     };
 
+    static public class GetResumeTokenBuilder {
+        private long partSize;
+        private long totalNumParts;
+        private long numPartsCompleted;
+        private long objectSize;
+        private String eTag;
+        private BitSet completedParts = new BitSet();
+
+        /**
+         * Default constructor
+         */
+        public GetResumeTokenBuilder() {}
+
+        /**
+         * @param partSize part size used for operation
+         * @return this resume token object
+         */
+        public GetResumeTokenBuilder withPartSize(long partSize) {
+            this.partSize = partSize;
+            return this;
+        }
+
+        /**
+         * @param totalNumParts total num parts in operation
+         * @return this resume token object
+         */
+        public GetResumeTokenBuilder withTotalNumParts(long totalNumParts) {
+            this.totalNumParts = totalNumParts;
+            return this;
+        }
+
+        /**
+         * @param numPartsCompleted number of parts completed
+         * @return this resume token object
+         */
+        public GetResumeTokenBuilder withNumPartsCompleted(long numPartsCompleted) {
+            this.numPartsCompleted = numPartsCompleted;
+            return this;
+        }
+
+        /**
+         * @param objectSize size of the whole object being downloaded
+         * @return this resume token object
+         */
+        public GetResumeTokenBuilder withObjectSize(long objectSize) {
+            this.objectSize = objectSize;
+            return this;
+        }
+
+        /**
+         * @param eTag ETag of the object being downloaded, used to make sure it did not change between attempts
+         * @return this resume token object
+         */
+        public GetResumeTokenBuilder withETag(String eTag) {
+            this.eTag = eTag;
+            return this;
+        }
+
+        /**
+         * @param completedParts bitmap of parts already written to the response file, bit i is part i + 1
+         * @return this resume token object
+         */
+        public GetResumeTokenBuilder withCompletedParts(BitSet completedParts) {
+            this.completedParts = completedParts;
+            return this;
+        }
+
+        public ResumeToken build() {
+            return new ResumeToken(this);
+        }
+    };
+
     private int nativeType;
     private long partSize;
     private long totalNumParts;
     private long numPartsCompleted;
     private String uploadId;
+    private long objectSize;
+    private String eTag;
+    /* BitSet.toLongArray() layout, so the native side can read it without calling back into Java */
+    private long[] completedParts;
+
+    /* Populated field by field from native code when a meta request is paused */
+    ResumeToken() {}
 
     public ResumeToken(PutResumeTokenBuilder builder) {
         this.nativeType = S3MetaRequestOptions.MetaRequestType.PUT_OBJECT.getNativeValue();
@@ -72,6 +153,16 @@ public class ResumeToken {
         this.uploadId = builder.uploadId;
     }
 
+    public ResumeToken(GetResumeTokenBuilder builder) {
+        this.nativeType = S3MetaRequestOptions.MetaRequestType.GET_OBJECT.getNativeValue();
+        this.partSize = builder.partSize;
+        this.totalNumParts = builder.totalNumParts;
+        this.numPartsCompleted = builder.numPartsCompleted;
+        this.objectSize = builder.objectSize;
+        this.eTag = builder.eTag;
+        this.completedParts = builder.completedParts == null ? new long[0] : builder.completedParts.toLongArray();
+    }
+
     /******
      * Common Fields.
      ******/
@@ -118,4 +209,37 @@ public class ResumeToken {
 
         return uploadId;
     }
+
+    /******
+     * Download Specific fields.
+     ******/
+    /**
+     * @return size of the whole object being downloaded
+     */
+    public long getObjectSize() {
+        checkGetObjectField("object size");
+        return objectSize;
+    }
+
+    /**
+     * @return ETag of the object being downloaded, or null if the response did not have one
+     */
+    public String getETag() {
+        checkGetObjectField("ETag");
+        return eTag;
+    }
+
+    /**
+     * @return bitmap of parts already written to the response file, bit i is part i + 1
+     */
+    public BitSet getCompletedParts() {
+        checkGetObjectField("completed parts");
+        return completedParts == null ? new BitSet() : BitSet.valueOf(completedParts);
+    }
+
+    private void checkGetObjectField(String fieldName) {
+        if (getType() != S3MetaRequestOptions.MetaRequestType.GET_OBJECT) {
+            throw new IllegalArgumentException("ResumeToken - " + fieldName + " is only defined for Get Object Resume tokens");
+        }
+    }
 }
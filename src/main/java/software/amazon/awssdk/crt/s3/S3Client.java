@@ -5,10 +5,19 @@
  */
 package software.amazon.awssdk.crt.s3;
 
+import java.nio.ByteBuffer;
 import java.nio.charset.Charset;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
 import java.util.concurrent.CompletableFuture;
 import software.amazon.awssdk.crt.CrtResource;
 import software.amazon.awssdk.crt.CrtRuntimeException;
+import software.amazon.awssdk.crt.http.HttpHeader;
+import software.amazon.awssdk.crt.http.HttpRequest;
 import software.amazon.awssdk.crt.http.HttpRequestBodyStream;
 import software.amazon.awssdk.crt.io.TlsContext;
 import software.amazon.awssdk.crt.io.StandardRetryOptions;
@@ -20,6 +29,9 @@ public class S3Client extends CrtResource {
     private final static Charset UTF8 = java.nio.charset.StandardCharsets.UTF_8;
     private final CompletableFuture<Void> shutdownComplete = new CompletableFuture<>();
     private final String region;
+    private final long partSize;
+    private long partBufferPool = 0;
+    private long statistics = 0;
 
     public S3Client(S3ClientOptions options) throws CrtRuntimeException {
         TlsContext tlsCtx = options.getTlsContext();
@@ -39,6 +51,13 @@ public class S3Client extends CrtResource {
                 options.getStandardRetryOptions(),
                 options.getComputeContentMd5()));
 
+        this.partSize = options.getPartSize();
+        statistics = s3ClientStatisticsNew();
+        if (options.getMaxPartBuffers() > 0) {
+            partBufferPool = s3PartBufferPoolNew(options.getPartSize(), options.getMaxPartBuffers(),
+                    options.getPartBufferCpuGroup());
+        }
+
         addReferenceTo(options.getClientBootstrap());
         addReferenceTo(options.getCredentialsProvider());
     }
@@ -63,6 +82,34 @@ public class S3Client extends CrtResource {
             return null;
         }
 
+        int bodySourceCount = (options.getHttpRequest().getBodyStream() != null ? 1 : 0)
+                + (options.getRequestFilePath() != null ? 1 : 0)
+                + (options.getRequestPartBufferQueue() != null ? 1 : 0);
+        if (bodySourceCount > 1) {
+            Log.log(Log.LogLevel.Error, Log.LogSubject.S3Client,
+                    "S3Client.makeMetaRequest has invalid options; only one of Http Request body stream, request file path and request part buffer queue can be set.");
+            return null;
+        }
+
+        ChecksumAlgorithm responseBodyChecksumAlgorithm = options.getResponseBodyChecksumAlgorithm() != null
+                ? options.getResponseBodyChecksumAlgorithm() : ChecksumAlgorithm.NONE;
+        if (responseBodyChecksumAlgorithm != ChecksumAlgorithm.NONE
+                && responseBodyChecksumAlgorithm != ChecksumAlgorithm.CRC32
+                && responseBodyChecksumAlgorithm != ChecksumAlgorithm.CRC32C
+                && responseBodyChecksumAlgorithm != ChecksumAlgorithm.CRC64NVME) {
+            Log.log(Log.LogLevel.Error, Log.LogSubject.S3Client,
+                    "S3Client.makeMetaRequest has invalid options; response body checksum must be CRC32, CRC32C or CRC64NVME.");
+            return null;
+        }
+
+        ResumeToken resumeToken = options.getResumeToken();
+        if (resumeToken != null && resumeToken.getType() == S3MetaRequestOptions.MetaRequestType.GET_OBJECT
+                && options.getResponseFilePath() == null) {
+            Log.log(Log.LogLevel.Error, Log.LogSubject.S3Client,
+                    "S3Client.makeMetaRequest has invalid options; GetObject resume token requires a response file path.");
+            return null;
+        }
+
         S3MetaRequest metaRequest = new S3MetaRequest();
         S3MetaRequestResponseHandlerNativeAdapter responseHandlerNativeAdapter = new S3MetaRequestResponseHandlerNativeAdapter(
                 options.getResponseHandler());
@@ -74,16 +121,43 @@ public class S3Client extends CrtResource {
         }
         URI endpoint = options.getEndpoint();
 
+        /* ChecksumConfig rejects CRC64NVME as it's configured */
         ChecksumConfig checksumConfig = options.getChecksumConfig() != null ? options.getChecksumConfig()
                 : new ChecksumConfig();
 
-        long metaRequestNativeHandle = s3ClientMakeMetaRequest(getNativeHandle(), metaRequest, region.getBytes(UTF8),
-                options.getMetaRequestType().getNativeValue(), checksumConfig.getChecksumLocation().getNativeValue(),
-                checksumConfig.getChecksumAlgorithm().getNativeValue(), checksumConfig.getValidateChecksum(),
-                ChecksumAlgorithm.marshallAlgorithmsForJNI(checksumConfig.getValidateChecksumAlgorithmList()),
-                httpRequestBytes, options.getHttpRequest().getBodyStream(), credentialsProviderNativeHandle,
-                responseHandlerNativeAdapter, endpoint == null ? null : endpoint.toString().getBytes(UTF8),
-                options.getResumeToken());
+        MetaRequestNativeOptions nativeOptions = new MetaRequestNativeOptions();
+        nativeOptions.region = region.getBytes(UTF8);
+        nativeOptions.metaRequestType = options.getMetaRequestType().getNativeValue();
+        nativeOptions.checksumLocation = checksumConfig.getChecksumLocation().getNativeValue();
+        nativeOptions.checksumAlgorithm = checksumConfig.getChecksumAlgorithm().getNativeValue();
+        nativeOptions.validateChecksum = checksumConfig.getValidateChecksum();
+        nativeOptions.validateAlgorithms =
+                ChecksumAlgorithm.marshallAlgorithmsForJNI(checksumConfig.getValidateChecksumAlgorithmList());
+        nativeOptions.httpRequestBytes = httpRequestBytes;
+        nativeOptions.httpRequestBodyStream = options.getHttpRequest().getBodyStream();
+        nativeOptions.credentialsProvider = credentialsProviderNativeHandle;
+        nativeOptions.responseHandlerNativeAdapter = responseHandlerNativeAdapter;
+        nativeOptions.endpoint = endpoint == null ? null : endpoint.toString().getBytes(UTF8);
+        nativeOptions.resumeToken = options.getResumeToken();
+        nativeOptions.zeroCopyResponseBody = options.getZeroCopyResponseBody();
+        nativeOptions.responseFilePath =
+                options.getResponseFilePath() == null ? null : options.getResponseFilePath().toString();
+        nativeOptions.requestFilePath =
+                options.getRequestFilePath() == null ? null : options.getRequestFilePath().toString();
+        nativeOptions.requestPartBufferQueue =
+                options.getRequestPartBufferQueue() == null ? 0 : options.getRequestPartBufferQueue().getNativeHandle();
+        nativeOptions.partSize = partSize;
+        nativeOptions.progressIntervalBytes = options.getProgressIntervalBytes();
+        nativeOptions.progressIntervalMillis = options.getProgressIntervalMillis();
+        nativeOptions.reuseProgressObject = options.getReuseProgressObject();
+        nativeOptions.metricsEnabled = options.getMetricsEnabled();
+        nativeOptions.statistics = statistics;
+        nativeOptions.responseBuffers = options.getResponseBuffers();
+        nativeOptions.responseBufferLayout = options.getResponseBufferLayout();
+        nativeOptions.responseRangeStart = options.getResponseRangeStart();
+        nativeOptions.responseBodyChecksumAlgorithm = responseBodyChecksumAlgorithm.getNativeValue();
+
+        long metaRequestNativeHandle = s3ClientMakeMetaRequest(getNativeHandle(), metaRequest, nativeOptions);
 
         metaRequest.setMetaRequestNativeHandle(metaRequestNativeHandle);
         if (credentialsProviderNativeHandle != 0) {
@@ -93,9 +167,174 @@ public class S3Client extends CrtResource {
              */
             metaRequest.addReferenceTo(options.getCredentialsProvider());
         }
+        if (options.getRequestPartBufferQueue() != null) {
+            metaRequest.addReferenceTo(options.getRequestPartBufferQueue());
+        }
+        return metaRequest;
+    }
+
+    /**
+     * Fetches many byte ranges, of one or more objects, straight into caller-provided direct buffers.
+     * <p>
+     * Ranges of the same object that are adjacent, overlapping or within
+     * {@link S3RangedGetBatchOptions#withCoalesceGapBytes} of each other are fetched with a single ranged GET,
+     * whose body is copied natively into each range's destination. No response body data crosses into Java,
+     * and each {@link S3RangedGet#getFuture()} completes as soon as the GET it was part of finishes.
+     * <p>
+     * This is a convenience wrapper over making one GetObject meta request per coalesced range yourself: each GET is
+     * signed on its own and shares the client's connection pool like any other meta request. Coalescing is what
+     * saves requests, so keep related ranges in one batch.
+     *
+     * @param options ranges to fetch and the headers to send with them
+     * @return the batch, which must be closed once it completes
+     */
+    public S3RangedGetBatch makeRangedGetBatch(S3RangedGetBatchOptions options) {
+        if (options.getRangedGets() == null || options.getRangedGets().isEmpty()) {
+            throw new IllegalArgumentException("S3Client.makeRangedGetBatch: ranged gets must not be empty");
+        }
+
+        Map<String, List<S3RangedGet>> rangedGetsByKey = new LinkedHashMap<>();
+        for (S3RangedGet rangedGet : options.getRangedGets()) {
+            /* checked again here, the destination may have been moved or drained since the S3RangedGet was made */
+            if (rangedGet.getLength() <= 0) {
+                throw new IllegalArgumentException(
+                        "S3Client.makeRangedGetBatch: range of " + rangedGet.getKey() + " must not be empty");
+            }
+            rangedGetsByKey.computeIfAbsent(rangedGet.getKey(), key -> new ArrayList<>()).add(rangedGet);
+        }
+
+        List<S3MetaRequest> metaRequests = new ArrayList<>();
+        List<CompletableFuture<Void>> futures = new ArrayList<>();
+        try {
+            for (Map.Entry<String, List<S3RangedGet>> entry : rangedGetsByKey.entrySet()) {
+                List<S3RangedGet> rangedGets = entry.getValue();
+                rangedGets.sort(Comparator.comparingLong(S3RangedGet::getRangeStart));
+
+                List<S3RangedGet> group = new ArrayList<>();
+                long groupStart = 0;
+                long groupEnd = 0;
+                for (S3RangedGet rangedGet : rangedGets) {
+                    long rangeEnd = rangedGet.getRangeStart() + rangedGet.getLength();
+                    if (!group.isEmpty() && rangedGet.getRangeStart() > groupEnd + options.getCoalesceGapBytes()) {
+                        metaRequests.add(makeRangedGet(entry.getKey(), group, groupStart, groupEnd, options));
+                        group = new ArrayList<>();
+                    }
+                    if (group.isEmpty()) {
+                        groupStart = rangedGet.getRangeStart();
+                        groupEnd = rangeEnd;
+                    }
+                    groupEnd = Math.max(groupEnd, rangeEnd);
+                    group.add(rangedGet);
+                    futures.add(rangedGet.getFuture());
+                }
+                metaRequests.add(makeRangedGet(entry.getKey(), group, groupStart, groupEnd, options));
+            }
+        } catch (RuntimeException ex) {
+            for (S3MetaRequest metaRequest : metaRequests) {
+                metaRequest.cancel();
+                metaRequest.close();
+            }
+            throw ex;
+        }
+
+        return new S3RangedGetBatch(metaRequests,
+                CompletableFuture.allOf(futures.toArray(new CompletableFuture<?>[0])));
+    }
+
+    private S3MetaRequest makeRangedGet(String key, List<S3RangedGet> rangedGets, long rangeStart, long rangeEnd,
+            S3RangedGetBatchOptions options) {
+        HttpHeader[] batchHeaders = options.getHeaders() != null ? options.getHeaders() : new HttpHeader[0];
+        HttpHeader[] headers = new HttpHeader[batchHeaders.length + 1];
+        System.arraycopy(batchHeaders, 0, headers, 0, batchHeaders.length);
+        headers[batchHeaders.length] = new HttpHeader("Range", "bytes=" + rangeStart + "-" + (rangeEnd - 1));
+
+        ByteBuffer[] responseBuffers = new ByteBuffer[rangedGets.size()];
+        long[] responseBufferLayout = new long[rangedGets.size() * 3];
+        for (int i = 0; i < rangedGets.size(); ++i) {
+            S3RangedGet rangedGet = rangedGets.get(i);
+            responseBuffers[i] = rangedGet.getDestination();
+            responseBufferLayout[i * 3] = rangedGet.getRangeStart();
+            responseBufferLayout[i * 3 + 1] = rangedGet.getDestination().position();
+            responseBufferLayout[i * 3 + 2] = rangedGet.getLength();
+        }
+
+        S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+            @Override
+            public void onFinished(S3FinishedResponseContext context) {
+                for (S3RangedGet rangedGet : rangedGets) {
+                    if (context.getErrorCode() != 0) {
+                        rangedGet.getFuture().completeExceptionally(new CrtS3RuntimeException(context));
+                    } else {
+                        rangedGet.getFuture().complete(null);
+                    }
+                }
+            }
+        };
+
+        S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                .withMetaRequestType(S3MetaRequestOptions.MetaRequestType.GET_OBJECT)
+                .withHttpRequest(new HttpRequest("GET", encodeObjectKeyPath(key), headers, null))
+                .withResponseHandler(responseHandler)
+                .withCredentialsProvider(options.getCredentialsProvider())
+                .withResponseBuffers(responseBuffers, responseBufferLayout, rangeStart);
+
+        S3MetaRequest metaRequest = makeMetaRequest(metaRequestOptions);
+        if (metaRequest == null) {
+            throw new IllegalArgumentException("S3Client.makeRangedGetBatch: invalid ranged get for " + key);
+        }
         return metaRequest;
     }
 
+    /* "/" followed by the key, percent-encoding everything except unreserved characters and the "/" separators */
+    private static String encodeObjectKeyPath(String key) {
+        StringBuilder path = new StringBuilder("/");
+        for (byte b : key.getBytes(StandardCharsets.UTF_8)) {
+            char c = (char) (b & 0xFF);
+            if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '_'
+                    || c == '.' || c == '~' || c == '/') {
+                path.append(c);
+            } else {
+                path.append(String.format("%%%02X", (int) c));
+            }
+        }
+        return path.toString();
+    }
+
+    /**
+     * Returns a snapshot of the client's current load, cheap enough to poll, e.g. from an autoscaler.
+     * Counters are maintained by the binding as meta requests are made and finish.
+     *
+     * @return the client's current statistics
+     */
+    public S3ClientStatistics getStatistics() {
+        if (statistics == 0) {
+            throw new IllegalStateException("S3Client.getStatistics: client has been closed");
+        }
+        return s3ClientGetStatistics(statistics, partBufferPool);
+    }
+
+    /**
+     * Leases a part-sized buffer from the client's native part buffer pool. Fill it and submit it to an
+     * {@link S3PartBufferQueue} to upload it without copying through the JVM. Buffers are recycled into the
+     * pool once they have been uploaded, or when closed without being submitted.
+     * <p>
+     * The pool must be enabled with {@link S3ClientOptions#withMaxPartBuffers}.
+     *
+     * @return a part buffer, or null if all of the pool's buffers are currently in use
+     */
+    public S3PartBuffer acquirePartBuffer() {
+        if (partBufferPool == 0) {
+            throw new IllegalStateException("S3Client.acquirePartBuffer: part buffer pool is not enabled, see S3ClientOptions.withMaxPartBuffers");
+        }
+
+        long partBuffer = s3PartBufferAcquire(partBufferPool);
+        if (partBuffer == 0) {
+            return null;
+        }
+
+        return new S3PartBuffer(partBuffer);
+    }
+
     /**
      * Determines whether a resource releases its dependencies at the same time the
      * native handle is released or if it waits. Resources that wait are responsible
@@ -115,12 +354,57 @@ public class S3Client extends CrtResource {
         if (!isNull()) {
             s3ClientDestroy(getNativeHandle());
         }
+
+        if (statistics != 0) {
+            /* meta requests that are still shutting down keep the native statistics alive */
+            s3ClientStatisticsRelease(statistics);
+            statistics = 0;
+        }
+
+        if (partBufferPool != 0) {
+            /* outstanding part buffers keep the native pool alive until they are released */
+            s3PartBufferPoolRelease(partBufferPool);
+            partBufferPool = 0;
+        }
     }
 
     public CompletableFuture<Void> getShutdownCompleteFuture() {
         return shutdownComplete;
     }
 
+    /*
+     * Everything s3ClientMakeMetaRequest needs, already converted to what native reads, so the native call takes one
+     * object instead of a parameter per option. Read field by field from native, see java_class_ids.c.
+     */
+    private static class MetaRequestNativeOptions {
+        byte[] region;
+        int metaRequestType;
+        int checksumLocation;
+        int checksumAlgorithm;
+        boolean validateChecksum;
+        int[] validateAlgorithms;
+        byte[] httpRequestBytes;
+        HttpRequestBodyStream httpRequestBodyStream;
+        long credentialsProvider;
+        S3MetaRequestResponseHandlerNativeAdapter responseHandlerNativeAdapter;
+        byte[] endpoint;
+        ResumeToken resumeToken;
+        boolean zeroCopyResponseBody;
+        String responseFilePath;
+        String requestFilePath;
+        long requestPartBufferQueue;
+        long partSize;
+        long progressIntervalBytes;
+        long progressIntervalMillis;
+        boolean reuseProgressObject;
+        boolean metricsEnabled;
+        long statistics;
+        ByteBuffer[] responseBuffers;
+        long[] responseBufferLayout;
+        long responseRangeStart;
+        int responseBodyChecksumAlgorithm;
+    }
+
     /*******************************************************************************
      * native methods
      ******************************************************************************/
@@ -131,10 +415,18 @@ public class S3Client extends CrtResource {
 
     private static native void s3ClientDestroy(long client);
 
-    private static native long s3ClientMakeMetaRequest(long clientId, S3MetaRequest metaRequest, byte[] region,
-            int metaRequestType, int checksumLocation, int checksumAlgorithm, boolean validateChecksum,
-            int[] validateAlgorithms, byte[] httpRequestBytes,
-            HttpRequestBodyStream httpRequestBodyStream,
-            long signingConfig, S3MetaRequestResponseHandlerNativeAdapter responseHandlerNativeAdapter,
-            byte[] endpoint, ResumeToken resumeToken);
+    private static native long s3ClientMakeMetaRequest(long clientId, S3MetaRequest metaRequest,
+            MetaRequestNativeOptions options);
+
+    private static native long s3ClientStatisticsNew();
+
+    private static native void s3ClientStatisticsRelease(long statistics);
+
+    private static native S3ClientStatistics s3ClientGetStatistics(long statistics, long partBufferPool);
+
+    private static native long s3PartBufferPoolNew(long partSize, int maxPartBuffers, int cpuGroup);
+
+    private static native void s3PartBufferPoolRelease(long partBufferPool);
+
+    private static native long s3PartBufferAcquire(long partBufferPool);
 }
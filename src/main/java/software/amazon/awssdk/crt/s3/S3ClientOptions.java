@@ -34,11 +34,33 @@ public class S3ClientOptions {
      */
     private Boolean computeContentMd5;
     private StandardRetryOptions standardRetryOptions;
+    private int maxPartBuffers;
+    private int partBufferCpuGroup = -1;
 
     public S3ClientOptions() {
         this.computeContentMd5 = false;
     }
 
+    /**
+     * Copies every option of another S3ClientOptions
+     */
+    S3ClientOptions(S3ClientOptions other) {
+        this.endpoint = other.endpoint;
+        this.region = other.region;
+        this.clientBootstrap = other.clientBootstrap;
+        this.tlsContext = other.tlsContext;
+        this.credentialsProvider = other.credentialsProvider;
+        this.partSize = other.partSize;
+        this.throughputTargetGbps = other.throughputTargetGbps;
+        this.readBackpressureEnabled = other.readBackpressureEnabled;
+        this.initialReadWindowSize = other.initialReadWindowSize;
+        this.maxConnections = other.maxConnections;
+        this.computeContentMd5 = other.computeContentMd5;
+        this.standardRetryOptions = other.standardRetryOptions;
+        this.maxPartBuffers = other.maxPartBuffers;
+        this.partBufferCpuGroup = other.partBufferCpuGroup;
+    }
+
     public S3ClientOptions withRegion(String region) {
         this.region = region;
         return this;
@@ -176,4 +198,45 @@ public class S3ClientOptions {
     public StandardRetryOptions getStandardRetryOptions() {
         return this.standardRetryOptions;
     }
+
+    /**
+     * Enables the client's pool of native part buffers, see {@link S3Client#acquirePartBuffer()}.
+     * <p>
+     * Each buffer is {@link #withPartSize part size} bytes, and the pool never holds more than
+     * maxPartBuffers of them, which bounds the native memory used for uploads fed from part buffers.
+     * Buffers are allocated on demand and recycled rather than freed.
+     * <p>
+     * Default is 0, which disables the pool.
+     *
+     * @param maxPartBuffers maximum number of part buffers the pool may allocate
+     * @return this
+     */
+    public S3ClientOptions withMaxPartBuffers(int maxPartBuffers) {
+        this.maxPartBuffers = maxPartBuffers;
+        return this;
+    }
+
+    public int getMaxPartBuffers() {
+        return this.maxPartBuffers;
+    }
+
+    /**
+     * Makes the part buffer pool node-local: every buffer is allocated when the client is created, and first written
+     * from a thread pinned to the given cpu group, so on NUMA hosts its memory sits on that group's node. Pair it with
+     * a ClientBootstrap whose EventLoopGroup is pinned to the same group, see {@link ShardedS3Client}.
+     * <p>
+     * Default is -1, which allocates buffers on demand wherever the acquiring thread runs. Has no effect unless the
+     * pool is enabled with {@link #withMaxPartBuffers}.
+     *
+     * @param cpuGroup the cpu group, as counted by {@link software.amazon.awssdk.crt.SystemInfo#getCpuGroupCount()}
+     * @return this
+     */
+    public S3ClientOptions withPartBufferCpuGroup(int cpuGroup) {
+        this.partBufferCpuGroup = cpuGroup;
+        return this;
+    }
+
+    public int getPartBufferCpuGroup() {
+        return this.partBufferCpuGroup;
+    }
 }
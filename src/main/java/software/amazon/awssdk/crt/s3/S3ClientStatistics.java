@@ -0,0 +1,60 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.s3;
+
+/**
+ * A point-in-time snapshot of an {@link S3Client}'s load, see {@link S3Client#getStatistics()}.
+ */
+public class S3ClientStatistics {
+    private final long activeMetaRequests;
+    private final long totalMetaRequests;
+    private final long responseBodyBytesReceived;
+    private final long partBufferBytesAllocated;
+    private final long partBufferBytesInUse;
+
+    S3ClientStatistics(long activeMetaRequests, long totalMetaRequests, long responseBodyBytesReceived,
+            long partBufferBytesAllocated, long partBufferBytesInUse) {
+        this.activeMetaRequests = activeMetaRequests;
+        this.totalMetaRequests = totalMetaRequests;
+        this.responseBodyBytesReceived = responseBodyBytesReceived;
+        this.partBufferBytesAllocated = partBufferBytesAllocated;
+        this.partBufferBytesInUse = partBufferBytesInUse;
+    }
+
+    /**
+     * @return number of meta requests that have been made and have not finished yet
+     */
+    public long getActiveMetaRequests() {
+        return activeMetaRequests;
+    }
+
+    /**
+     * @return number of meta requests made with the client since it was created
+     */
+    public long getTotalMetaRequests() {
+        return totalMetaRequests;
+    }
+
+    /**
+     * @return total number of response body bytes received by all of the client's meta requests
+     */
+    public long getResponseBodyBytesReceived() {
+        return responseBodyBytesReceived;
+    }
+
+    /**
+     * @return native memory allocated by the client's part buffer pool, see {@link S3ClientOptions#withMaxPartBuffers}
+     */
+    public long getPartBufferBytesAllocated() {
+        return partBufferBytesAllocated;
+    }
+
+    /**
+     * @return native memory in part buffers that are currently leased or queued for upload
+     */
+    public long getPartBufferBytesInUse() {
+        return partBufferBytesInUse;
+    }
+}
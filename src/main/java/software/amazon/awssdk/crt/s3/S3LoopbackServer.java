@@ -0,0 +1,138 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.s3;
+
+import software.amazon.awssdk.crt.CrtResource;
+import software.amazon.awssdk.crt.Log;
+import software.amazon.awssdk.crt.io.ServerBootstrap;
+import software.amazon.awssdk.crt.io.SocketOptions;
+
+import java.net.URI;
+import java.util.concurrent.CompletableFuture;
+
+/**
+ * A native HTTP server answering just enough of the S3 API for an S3Client to download and upload objects against
+ * it, for measuring the throughput of the client without S3 or a network in the way. It runs on the event loops of
+ * its ServerBootstrap.
+ *
+ * Every GET, of any key, serves the same synthetic object, whose byte at offset i is (byte) i; ranged GETs are
+ * honoured. PUTs and multipart uploads are acknowledged and their data discarded. Requests are not authenticated, so
+ * any credentials will do.
+ *
+ * Latency and bandwidth are simulated by holding back each response until the request would have completed, so part
+ * latencies are realistic while the data itself moves at loopback speed.
+ *
+ * @deprecated It is currently an EXPERIMENTAL feature meant for internal use only. It may be changed incompatibly
+ * or removed in a future version.
+ */
+@Deprecated()
+public class S3LoopbackServer extends CrtResource {
+
+    private final CompletableFuture<Void> shutdownComplete = new CompletableFuture<>();
+    private final String host;
+    private final int boundPort;
+
+    /**
+     * Creates the server, which is listening once this returns.
+     * @param serverBootstrap bootstrap object for handling connections
+     * @param socketOptions socket options to apply to the listening socket
+     * @param options what to listen on, and the object and network to simulate
+     */
+    public S3LoopbackServer(ServerBootstrap serverBootstrap, SocketOptions socketOptions,
+                            S3LoopbackServerOptions options) {
+        if (serverBootstrap == null || socketOptions == null || options == null) {
+            throw new IllegalArgumentException(
+                "S3LoopbackServer: serverBootstrap, socketOptions and options must not be null");
+        }
+        if (options.getHost() == null) {
+            throw new IllegalArgumentException("S3LoopbackServer: host must not be null");
+        }
+
+        long handle = s3LoopbackServerNew(this, serverBootstrap.getNativeHandle(), socketOptions.getNativeHandle(),
+            options.getHost(), options.getPort(), options.getObjectSize(), options.getResponseLatencyMillis(),
+            options.getBandwidthBytesPerSecond());
+        acquireNativeHandle(handle);
+        addReferenceTo(serverBootstrap);
+
+        this.host = options.getHost();
+        this.boundPort = s3LoopbackServerGetBoundPort(handle);
+    }
+
+    @Override
+    protected void releaseNativeHandle() {
+        if (!isNull()) {
+            s3LoopbackServerRelease(getNativeHandle());
+        }
+    }
+
+    @Override
+    protected boolean canReleaseReferencesImmediately() {
+        return false;
+    }
+
+    /**
+     * @return the port the server is listening on
+     */
+    public int getBoundPort() {
+        return boundPort;
+    }
+
+    /**
+     * @return the endpoint to give an S3Client, see {@link S3ClientOptions#withEndpoint(String)}
+     */
+    public String getEndpoint() {
+        return "http://" + getHostHeader();
+    }
+
+    /**
+     * @return the endpoint as a URI
+     */
+    public URI getUri() {
+        return URI.create(getEndpoint());
+    }
+
+    /**
+     * @return the value for the Host header of requests to this server
+     */
+    public String getHostHeader() {
+        return host + ":" + boundPort;
+    }
+
+    /**
+     * @return a snapshot of the traffic the server has handled so far
+     */
+    public S3LoopbackServerMetrics getMetrics() {
+        if (isNull()) {
+            throw new IllegalStateException("close() has already been called on this object.");
+        }
+        return new S3LoopbackServerMetrics(s3LoopbackServerMetrics(getNativeHandle()));
+    }
+
+    /**
+     * Invoked from JNI once the listener and every connection it accepted are gone.
+     */
+    private void onShutdownComplete() {
+        Log.log(Log.LogLevel.Trace, Log.LogSubject.JavaCrtS3, "S3LoopbackServer.onShutdownComplete");
+        releaseReferences();
+        this.shutdownComplete.complete(null);
+    }
+
+    /**
+     * @return future to synchronize shutdown completion of this object
+     */
+    public CompletableFuture<Void> getShutdownCompleteFuture() {
+        return shutdownComplete;
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+    private static native long s3LoopbackServerNew(S3LoopbackServer server, long serverBootstrap, long socketOptions,
+                                                   String host, int port, long objectSize, long latencyMillis,
+                                                   long bandwidthBytesPerSecond);
+    private static native int s3LoopbackServerGetBoundPort(long server);
+    private static native long[] s3LoopbackServerMetrics(long server);
+    private static native void s3LoopbackServerRelease(long server);
+}
@@ -0,0 +1,137 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.s3;
+
+import software.amazon.awssdk.crt.LatencyHistogram;
+
+import java.util.Arrays;
+
+/**
+ * A snapshot of the traffic of an S3LoopbackServer. All counters are cumulative, so rates come from comparing two
+ * snapshots, for example with <code>getGigabitsSentPerSecondSince()</code>.
+ *
+ * Byte counts are of object bodies, not of the bytes on the wire.
+ *
+ * @deprecated It is currently an EXPERIMENTAL feature meant for internal use only. It may be changed incompatibly
+ * or removed in a future version.
+ */
+@Deprecated()
+public class S3LoopbackServerMetrics {
+
+    /* Must match s3_loopback_server_metric in s3_loopback_server.c */
+    private static final int TIMESTAMP_NS = 0;
+    private static final int REQUESTS = 1;
+    private static final int GET_REQUESTS = 2;
+    private static final int PUT_REQUESTS = 3;
+    private static final int BYTES_SENT = 4;
+    private static final int BYTES_RECEIVED = 5;
+    private static final int FAILED_REQUESTS = 6;
+    private static final int REQUEST_LATENCY_HISTOGRAM = 7;
+    private static final int VALUE_COUNT = REQUEST_LATENCY_HISTOGRAM + LatencyHistogram.BUCKET_COUNT;
+
+    private final long[] values;
+    private final LatencyHistogram requestLatency;
+
+    S3LoopbackServerMetrics(long[] values) {
+        if (values.length != VALUE_COUNT) {
+            throw new IllegalArgumentException("S3LoopbackServerMetrics: unexpected number of values");
+        }
+        this.values = values;
+        this.requestLatency = new LatencyHistogram(Arrays.copyOfRange(values, REQUEST_LATENCY_HISTOGRAM,
+            REQUEST_LATENCY_HISTOGRAM + LatencyHistogram.BUCKET_COUNT));
+    }
+
+    /**
+     * @return when the snapshot was taken, in nanoseconds of a monotonic clock; only meaningful relative to other
+     * snapshots
+     */
+    public long getTimestampNanos() {
+        return values[TIMESTAMP_NS];
+    }
+
+    /**
+     * @return number of requests completed, of every kind
+     */
+    public long getRequests() {
+        return values[REQUESTS];
+    }
+
+    /**
+     * @return number of GET requests received, each one a part of a download
+     */
+    public long getGetRequests() {
+        return values[GET_REQUESTS];
+    }
+
+    /**
+     * @return number of PUT requests received, each one a part of an upload
+     */
+    public long getPutRequests() {
+        return values[PUT_REQUESTS];
+    }
+
+    /**
+     * @return total bytes of the object bodies sent
+     */
+    public long getBytesSent() {
+        return values[BYTES_SENT];
+    }
+
+    /**
+     * @return total bytes of the request bodies received
+     */
+    public long getBytesReceived() {
+        return values[BYTES_RECEIVED];
+    }
+
+    /**
+     * @return number of requests that didn't complete, usually because their connection closed
+     */
+    public long getFailedRequests() {
+        return values[FAILED_REQUESTS];
+    }
+
+    /**
+     * @return latencies from each request arriving until its response was sent, simulated latency and bandwidth
+     * included; for an S3Client, the latency of each part
+     */
+    public LatencyHistogram getRequestLatency() {
+        return requestLatency;
+    }
+
+    /**
+     * @param earlier a snapshot of the same server taken before this one
+     * @return the rate object bytes were sent at between the two snapshots, in gigabits per second, or 0 if no time
+     * passed
+     */
+    public double getGigabitsSentPerSecondSince(S3LoopbackServerMetrics earlier) {
+        return perSecondSince(earlier, BYTES_SENT) * 8 / 1e9;
+    }
+
+    /**
+     * @param earlier a snapshot of the same server taken before this one
+     * @return the rate request bytes were received at between the two snapshots, in gigabits per second, or 0 if no
+     * time passed
+     */
+    public double getGigabitsReceivedPerSecondSince(S3LoopbackServerMetrics earlier) {
+        return perSecondSince(earlier, BYTES_RECEIVED) * 8 / 1e9;
+    }
+
+    /**
+     * @param earlier a snapshot of the same server taken before this one
+     * @return the rate requests completed at between the two snapshots, or 0 if no time passed
+     */
+    public double getRequestsPerSecondSince(S3LoopbackServerMetrics earlier) {
+        return perSecondSince(earlier, REQUESTS);
+    }
+
+    private double perSecondSince(S3LoopbackServerMetrics earlier, int index) {
+        long elapsedNanos = getTimestampNanos() - earlier.getTimestampNanos();
+        if (elapsedNanos <= 0) {
+            return 0;
+        }
+        return (values[index] - earlier.values[index]) * 1e9 / elapsedNanos;
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.s3;
+
+/**
+ * Options for an S3LoopbackServer.
+ *
+ * @deprecated It is currently an EXPERIMENTAL feature meant for internal use only. It may be changed incompatibly
+ * or removed in a future version.
+ */
+@Deprecated()
+public class S3LoopbackServerOptions {
+
+    private static final long DEFAULT_OBJECT_SIZE = 1024L * 1024 * 1024;
+
+    private String host = "127.0.0.1";
+    private int port = 0;
+    private long objectSize = DEFAULT_OBJECT_SIZE;
+    private long responseLatencyMillis = 0;
+    private long bandwidthBytesPerSecond = 0;
+
+    /**
+     * @param host address to listen on, 127.0.0.1 by default
+     * @return this options object
+     */
+    public S3LoopbackServerOptions withHost(String host) {
+        this.host = host;
+        return this;
+    }
+
+    /**
+     * @return the address to listen on
+     */
+    public String getHost() {
+        return host;
+    }
+
+    /**
+     * @param port port to listen on; 0 (the default) for any free port, see
+     *             {@link S3LoopbackServer#getBoundPort()}
+     * @return this options object
+     */
+    public S3LoopbackServerOptions withPort(int port) {
+        this.port = port;
+        return this;
+    }
+
+    /**
+     * @return the port to listen on
+     */
+    public int getPort() {
+        return port;
+    }
+
+    /**
+     * @param objectSize size in bytes of the object every GET serves, 1 GiB by default
+     * @return this options object
+     */
+    public S3LoopbackServerOptions withObjectSize(long objectSize) {
+        this.objectSize = objectSize;
+        return this;
+    }
+
+    /**
+     * @return the size of the object every GET serves
+     */
+    public long getObjectSize() {
+        return objectSize;
+    }
+
+    /**
+     * @param responseLatencyMillis time from a request arriving until the earliest its response is sent, 0 by
+     *                              default
+     * @return this options object
+     */
+    public S3LoopbackServerOptions withResponseLatencyMillis(long responseLatencyMillis) {
+        this.responseLatencyMillis = responseLatencyMillis;
+        return this;
+    }
+
+    /**
+     * @return the simulated latency of every request
+     */
+    public long getResponseLatencyMillis() {
+        return responseLatencyMillis;
+    }
+
+    /**
+     * @param bandwidthBytesPerSecond simulated bandwidth of each request: its response is held back until its body
+     *                                would have been transferred at this rate. 0 (the default) for unlimited
+     * @return this options object
+     */
+    public S3LoopbackServerOptions withBandwidthBytesPerSecond(long bandwidthBytesPerSecond) {
+        this.bandwidthBytesPerSecond = bandwidthBytesPerSecond;
+        return this;
+    }
+
+    /**
+     * @return the simulated bandwidth of each request, 0 for unlimited
+     */
+    public long getBandwidthBytesPerSecond() {
+        return bandwidthBytesPerSecond;
+    }
+}
@@ -10,6 +10,8 @@ import software.amazon.awssdk.crt.CrtResource;
 public class S3MetaRequest extends CrtResource {
 
     private final CompletableFuture<Void> shutdownComplete = new CompletableFuture<>();
+    /* Set from native code for downloads to a response file, which can be paused and resumed */
+    private long downloadResumeState = 0;
 
     public S3MetaRequest() {
 
@@ -56,10 +58,16 @@ public class S3MetaRequest extends CrtResource {
      * Pauses meta request and returns a token that can be used to resume a meta request.
      * For PutObject resume, input stream should always start at the beginning,
      * already uploaded parts will be skipped, but checksums on those will be verified if request specified checksum algo.
+     * <p>
+     * GetObject requests can be paused when they download to a response file
+     * (see {@link S3MetaRequestOptions#withResponseFilePath}). Resume by making a new GetObject request to the same
+     * response file with the token, only the parts missing from the file are downloaded again. If the paused request
+     * had a Range header, give the new request the same one: it is narrowed to the part of the range still missing.
+     * Only a single range can be resumed.
      * @return token to resume request. might be null if request has not started executing yet
      */
     public ResumeToken pause() {
-        return s3MetaRequestPause(getNativeHandle());
+        return s3MetaRequestPause(getNativeHandle(), downloadResumeState);
     }
 
     /**
@@ -96,7 +104,7 @@ public class S3MetaRequest extends CrtResource {
 
     private static native void s3MetaRequestCancel(long s3MetaRequest);
 
-    private static native ResumeToken s3MetaRequestPause(long s3MetaRequest);
+    private static native ResumeToken s3MetaRequestPause(long s3MetaRequest, long downloadResumeState);
 
     private static native void s3MetaRequestIncrementReadWindow(long s3MetaRequest, long bytes);
 }
@@ -0,0 +1,122 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.s3;
+
+/**
+ * Timing information about a meta request, as observed by the native binding.
+ * Delivered once per meta request to {@link S3MetaRequestResponseHandler#onMetrics}, if enabled with
+ * {@link S3MetaRequestOptions#withMetricsEnabled}.
+ * <p>
+ * All times are in nanoseconds, relative to when the meta request was made.
+ * Response body parts are stored packed in a single array, rather than as one object per part,
+ * so recording metrics for large objects stays cheap.
+ */
+public class S3MetaRequestMetrics {
+    /* number of longs per part in the packed parts array: range start, size, arrival time */
+    private static final int PART_FIELD_COUNT = 3;
+
+    private final long timeToResponseHeadersNs;
+    private final long timeToFirstBodyByteNs;
+    private final long durationNs;
+    private final long bytesReceived;
+    private final long[] parts;
+    private final ChecksumAlgorithm responseBodyChecksumAlgorithm;
+    private final long responseBodyChecksum;
+    private final long checksumNs;
+
+    S3MetaRequestMetrics(long timeToResponseHeadersNs, long timeToFirstBodyByteNs, long durationNs,
+            long bytesReceived, long[] parts, ChecksumAlgorithm responseBodyChecksumAlgorithm,
+            long responseBodyChecksum, long checksumNs) {
+        this.timeToResponseHeadersNs = timeToResponseHeadersNs;
+        this.timeToFirstBodyByteNs = timeToFirstBodyByteNs;
+        this.durationNs = durationNs;
+        this.bytesReceived = bytesReceived;
+        this.parts = parts == null ? new long[0] : parts;
+        this.responseBodyChecksumAlgorithm = responseBodyChecksumAlgorithm;
+        this.responseBodyChecksum = responseBodyChecksum;
+        this.checksumNs = checksumNs;
+    }
+
+    /**
+     * @return time until the response headers were received, or -1 if they never were
+     */
+    public long getTimeToResponseHeadersNs() {
+        return timeToResponseHeadersNs;
+    }
+
+    /**
+     * @return time until the first response body part was received, or -1 if none was
+     */
+    public long getTimeToFirstBodyByteNs() {
+        return timeToFirstBodyByteNs;
+    }
+
+    /**
+     * @return time until the meta request finished
+     */
+    public long getDurationNs() {
+        return durationNs;
+    }
+
+    /**
+     * @return total number of response body bytes received
+     */
+    public long getBytesReceived() {
+        return bytesReceived;
+    }
+
+    /**
+     * @return number of response body parts received
+     */
+    public int getPartCount() {
+        return parts.length / PART_FIELD_COUNT;
+    }
+
+    /**
+     * @param partIndex index of the part, in the order parts were received
+     * @return offset within the object of the part's first byte
+     */
+    public long getPartRangeStart(int partIndex) {
+        return parts[partIndex * PART_FIELD_COUNT];
+    }
+
+    /**
+     * @param partIndex index of the part, in the order parts were received
+     * @return size of the part in bytes
+     */
+    public long getPartSize(int partIndex) {
+        return parts[partIndex * PART_FIELD_COUNT + 1];
+    }
+
+    /**
+     * @param partIndex index of the part, in the order parts were received
+     * @return time at which the part was delivered
+     */
+    public long getPartArrivalNs(int partIndex) {
+        return parts[partIndex * PART_FIELD_COUNT + 2];
+    }
+
+    /**
+     * @return algorithm of {@link #getResponseBodyChecksum()}, NONE unless enabled with
+     * {@link S3MetaRequestOptions#withResponseBodyChecksumAlgorithm}
+     */
+    public ChecksumAlgorithm getResponseBodyChecksumAlgorithm() {
+        return responseBodyChecksumAlgorithm;
+    }
+
+    /**
+     * @return checksum of the whole response body, as received, as an unsigned value
+     */
+    public long getResponseBodyChecksum() {
+        return responseBodyChecksum;
+    }
+
+    /**
+     * @return CPU time spent computing the response body checksum
+     */
+    public long getChecksumNs() {
+        return checksumNs;
+    }
+}
@@ -8,6 +8,8 @@ import software.amazon.awssdk.crt.http.HttpRequest;
 import software.amazon.awssdk.crt.auth.credentials.CredentialsProvider;
 
 import java.net.URI;
+import java.nio.ByteBuffer;
+import java.nio.file.Path;
 import java.util.HashMap;
 import java.util.Map;
 
@@ -84,6 +86,18 @@ public class S3MetaRequestOptions {
     private CredentialsProvider credentialsProvider;
     private URI endpoint;
     private ResumeToken resumeToken;
+    private boolean zeroCopyResponseBody = false;
+    private Path responseFilePath;
+    private Path requestFilePath;
+    private S3PartBufferQueue requestPartBufferQueue;
+    private long progressIntervalBytes = 0;
+    private long progressIntervalMillis = 0;
+    private boolean reuseProgressObject = false;
+    private boolean metricsEnabled = false;
+    private ChecksumAlgorithm responseBodyChecksumAlgorithm = ChecksumAlgorithm.NONE;
+    private ByteBuffer[] responseBuffers;
+    private long[] responseBufferLayout;
+    private long responseRangeStart;
 
     public S3MetaRequestOptions withMetaRequestType(MetaRequestType metaRequestType) {
         this.metaRequestType = metaRequestType;
@@ -198,4 +212,212 @@ public class S3MetaRequestOptions {
     public ResumeToken getResumeToken() {
         return resumeToken;
     }
+
+    /**
+     * Deliver response body data to {@link S3MetaRequestResponseHandler#onResponseBody} as a read-only
+     * direct ByteBuffer over the native part buffer, instead of copying every part into a new heap byte[].
+     * <p>
+     * This avoids an allocation and a memcpy per part, but the buffer is only valid for the duration
+     * of the onResponseBody call. The native memory is reused once the callback returns, so the handler
+     * must not keep a reference to the buffer (or any view of it) and must copy out any data it needs later.
+     * <p>
+     * Default is false.
+     *
+     * @param zeroCopyResponseBody whether to deliver response body data without copying
+     * @return this
+     */
+    public S3MetaRequestOptions withZeroCopyResponseBody(boolean zeroCopyResponseBody) {
+        this.zeroCopyResponseBody = zeroCopyResponseBody;
+        return this;
+    }
+
+    public boolean getZeroCopyResponseBody() {
+        return zeroCopyResponseBody;
+    }
+
+    /**
+     * Write the response body directly to a file instead of delivering it to
+     * {@link S3MetaRequestResponseHandler#onResponseBody}.
+     * <p>
+     * The file is created (or truncated) when the meta request is made, and each part is written natively
+     * at its offset within the object, so body data never crosses into the JVM.
+     * {@link S3MetaRequestResponseHandler#onResponseBody} is never invoked in this mode; progress is reported
+     * through {@link S3MetaRequestResponseHandler#onProgress} as parts are written.
+     * The flow-control window is maintained automatically.
+     *
+     * @param responseFilePath path of the file to write the response body to
+     * @return this
+     */
+    public S3MetaRequestOptions withResponseFilePath(Path responseFilePath) {
+        this.responseFilePath = responseFilePath;
+        return this;
+    }
+
+    public Path getResponseFilePath() {
+        return responseFilePath;
+    }
+
+    /**
+     * Read the request body directly from a file instead of from the HttpRequest's
+     * {@link software.amazon.awssdk.crt.http.HttpRequestBodyStream}.
+     * <p>
+     * The file is opened natively and parts are read by the event-loop threads, so body data never
+     * crosses into the JVM. If the HttpRequest has no Content-Length header, it is set from the file size.
+     * The HttpRequest must not also have a body stream.
+     *
+     * @param requestFilePath path of the file to upload
+     * @return this
+     */
+    public S3MetaRequestOptions withRequestFilePath(Path requestFilePath) {
+        this.requestFilePath = requestFilePath;
+        return this;
+    }
+
+    public Path getRequestFilePath() {
+        return requestFilePath;
+    }
+
+    /**
+     * Feed the request body from native part buffers submitted to the given queue, instead of from the
+     * HttpRequest's {@link software.amazon.awssdk.crt.http.HttpRequestBodyStream}.
+     * The HttpRequest must not also have a body stream, and must carry a Content-Length header.
+     * Parts may keep being submitted after the meta request is made, see {@link S3PartBufferQueue}.
+     *
+     * @param requestPartBufferQueue queue the body's part buffers are submitted to
+     * @return this
+     * @see S3Client#acquirePartBuffer()
+     */
+    public S3MetaRequestOptions withRequestPartBufferQueue(S3PartBufferQueue requestPartBufferQueue) {
+        this.requestPartBufferQueue = requestPartBufferQueue;
+        return this;
+    }
+
+    public S3PartBufferQueue getRequestPartBufferQueue() {
+        return requestPartBufferQueue;
+    }
+
+    /**
+     * Coalesce progress updates so {@link S3MetaRequestResponseHandler#onProgress} is invoked at most once per
+     * this many transferred bytes, instead of once per part. Bytes are accumulated natively, so nothing is lost,
+     * and any remainder is reported before {@link S3MetaRequestResponseHandler#onFinished}.
+     * <p>
+     * If both this and {@link #withProgressIntervalMillis} are set, progress is reported when either is reached.
+     * Default is 0, which reports every update.
+     *
+     * @param progressIntervalBytes minimum number of bytes between progress updates
+     * @return this
+     */
+    public S3MetaRequestOptions withProgressIntervalBytes(long progressIntervalBytes) {
+        this.progressIntervalBytes = progressIntervalBytes;
+        return this;
+    }
+
+    public long getProgressIntervalBytes() {
+        return progressIntervalBytes;
+    }
+
+    /**
+     * Coalesce progress updates so {@link S3MetaRequestResponseHandler#onProgress} is invoked at most about once
+     * per this many milliseconds, instead of once per part. Updates are only checked for when data is
+     * transferred, so this is a lower bound on the time between progress updates, not a timer.
+     * <p>
+     * Default is 0, which reports every update.
+     *
+     * @see #withProgressIntervalBytes
+     * @param progressIntervalMillis minimum number of milliseconds between progress updates
+     * @return this
+     */
+    public S3MetaRequestOptions withProgressIntervalMillis(long progressIntervalMillis) {
+        this.progressIntervalMillis = progressIntervalMillis;
+        return this;
+    }
+
+    public long getProgressIntervalMillis() {
+        return progressIntervalMillis;
+    }
+
+    /**
+     * Deliver every progress update for this meta request in the same {@link S3MetaRequestProgress} object,
+     * instead of allocating a new one per update. The object is overwritten by the next update, so the handler
+     * must not keep a reference to it after {@link S3MetaRequestResponseHandler#onProgress} returns.
+     * Progress updates are never delivered concurrently when this is set.
+     * <p>
+     * Default is false.
+     *
+     * @param reuseProgressObject whether to reuse a single progress object
+     * @return this
+     */
+    public S3MetaRequestOptions withReuseProgressObject(boolean reuseProgressObject) {
+        this.reuseProgressObject = reuseProgressObject;
+        return this;
+    }
+
+    public boolean getReuseProgressObject() {
+        return reuseProgressObject;
+    }
+
+    /**
+     * Record timing information for this meta request and deliver it to
+     * {@link S3MetaRequestResponseHandler#onMetrics} when it finishes.
+     * Recording costs a clock read and a few bytes of native memory per response body part.
+     * <p>
+     * Default is false.
+     *
+     * @param metricsEnabled whether to record metrics
+     * @return this
+     */
+    public S3MetaRequestOptions withMetricsEnabled(boolean metricsEnabled) {
+        this.metricsEnabled = metricsEnabled;
+        return this;
+    }
+
+    public boolean getMetricsEnabled() {
+        return metricsEnabled;
+    }
+
+    /**
+     * Have the binding compute a checksum over the whole response body as it is delivered, in the same pass that
+     * copies each part to Java, a response file or a ranged-get destination, while the part is still hot in cache.
+     * The result and the CPU time spent on it are reported in {@link S3MetaRequestMetrics}, so setting this also
+     * enables metrics. This gives a whole-object checksum of a multi-part download without re-reading the data.
+     * <p>
+     * Only {@link ChecksumAlgorithm#CRC32}, {@link ChecksumAlgorithm#CRC32C} and {@link ChecksumAlgorithm#CRC64NVME}
+     * are supported.
+     * Default is {@link ChecksumAlgorithm#NONE}.
+     *
+     * @param responseBodyChecksumAlgorithm algorithm of the whole-body checksum
+     * @return this
+     */
+    public S3MetaRequestOptions withResponseBodyChecksumAlgorithm(ChecksumAlgorithm responseBodyChecksumAlgorithm) {
+        this.responseBodyChecksumAlgorithm = responseBodyChecksumAlgorithm;
+        return this;
+    }
+
+    public ChecksumAlgorithm getResponseBodyChecksumAlgorithm() {
+        return responseBodyChecksumAlgorithm;
+    }
+
+    /*
+     * Used by S3Client.makeRangedGetBatch(): the body of a ranged GET starting at rangeStart is copied natively into
+     * these direct buffers. The layout holds three longs per buffer: object offset, buffer position and length.
+     */
+    S3MetaRequestOptions withResponseBuffers(ByteBuffer[] responseBuffers, long[] responseBufferLayout,
+            long responseRangeStart) {
+        this.responseBuffers = responseBuffers;
+        this.responseBufferLayout = responseBufferLayout;
+        this.responseRangeStart = responseRangeStart;
+        return this;
+    }
+
+    ByteBuffer[] getResponseBuffers() {
+        return responseBuffers;
+    }
+
+    long[] getResponseBufferLayout() {
+        return responseBufferLayout;
+    }
+
+    long getResponseRangeStart() {
+        return responseRangeStart;
+    }
 }
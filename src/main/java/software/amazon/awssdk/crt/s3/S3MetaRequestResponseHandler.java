@@ -34,6 +34,11 @@ public interface S3MetaRequestResponseHandler {
      * <p>
      * If backpressure is disabled, you do not need to maintain the flow-control window,
      * data will arrive as fast as possible.
+     * <p>
+     * If the meta request was made with {@link S3MetaRequestOptions#withZeroCopyResponseBody} set true,
+     * bodyBytesIn is a read-only direct buffer over native memory that is only valid until this method returns.
+     * <p>
+     * This is not invoked if the meta request was made with {@link S3MetaRequestOptions#withResponseFilePath}.
      *
      * @param bodyBytesIn The body data for this chunk of the object
      * @param objectRangeStart The byte index of the object that this refers to. For example, for an HTTP message that
@@ -58,10 +63,21 @@ public interface S3MetaRequestResponseHandler {
 
     /**
      * Invoked to report progress of the meta request execution.
-     * Currently, the progress callback is invoked only for the CopyObject meta request type.
+     * Currently, the progress callback is invoked only for the CopyObject meta request type,
+     * and for meta requests made with {@link S3MetaRequestOptions#withResponseFilePath}.
+     * Updates can be coalesced with {@link S3MetaRequestOptions#withProgressIntervalBytes} and
+     * {@link S3MetaRequestOptions#withProgressIntervalMillis}.
      * TODO: support this callback for all types of meta requests
      * @param progress information about the progress of the meta request execution
      */
     default void onProgress(final S3MetaRequestProgress progress) {
     }
+
+    /**
+     * Invoked once, just before {@link #onFinished}, with timing information about the meta request.
+     * Only invoked if the meta request was made with {@link S3MetaRequestOptions#withMetricsEnabled}.
+     * @param metrics timing information about the meta request and its response body parts
+     */
+    default void onMetrics(final S3MetaRequestMetrics metrics) {
+    }
 }
@@ -19,6 +19,13 @@ class S3MetaRequestResponseHandlerNativeAdapter {
         return this.responseHandler.onResponseBody(ByteBuffer.wrap(bodyBytesIn), objectRangeStart, objectRangeEnd);
     }
 
+    /*
+     * Zero-copy variant, the buffer points at native memory that is only valid until this call returns.
+     */
+    int onResponseBodyDirect(ByteBuffer bodyBytesIn, long objectRangeStart, long objectRangeEnd) {
+        return this.responseHandler.onResponseBody(bodyBytesIn.asReadOnlyBuffer(), objectRangeStart, objectRangeEnd);
+    }
+
     void onFinished(int errorCode, int responseStatus, byte[] errorPayload, int checksumAlgorithm, boolean didValidateChecksum) {
         S3FinishedResponseContext context = new S3FinishedResponseContext(errorCode, responseStatus, errorPayload, ChecksumAlgorithm.getEnumValueFromInteger(checksumAlgorithm), didValidateChecksum);
         this.responseHandler.onFinished(context);
@@ -31,4 +38,11 @@ class S3MetaRequestResponseHandlerNativeAdapter {
     void onProgress(final S3MetaRequestProgress progress) {
         responseHandler.onProgress(progress);
     }
+
+    void onMetrics(long timeToResponseHeadersNs, long timeToFirstBodyByteNs, long durationNs, long bytesReceived,
+            long[] parts, int checksumAlgorithm, long responseBodyChecksum, long checksumNs) {
+        responseHandler.onMetrics(new S3MetaRequestMetrics(timeToResponseHeadersNs, timeToFirstBodyByteNs,
+                durationNs, bytesReceived, parts, ChecksumAlgorithm.getEnumValueFromInteger(checksumAlgorithm),
+                responseBodyChecksum, checksumNs));
+    }
 }
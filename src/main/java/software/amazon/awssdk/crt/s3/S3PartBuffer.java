@@ -0,0 +1,64 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.s3;
+
+import java.nio.ByteBuffer;
+import software.amazon.awssdk.crt.CrtResource;
+
+/**
+ * A part-sized native buffer leased from an {@link S3Client}'s part buffer pool.
+ * <p>
+ * Fill the buffer returned by {@link #getBuffer()} and hand it to
+ * {@link S3PartBufferQueue#submitPart(int, S3PartBuffer)}, after which the native upload owns it and returns it
+ * to the pool once it has been sent. Always close the S3PartBuffer when done with it; closing a buffer that was
+ * never submitted returns it to the pool directly.
+ *
+ * @see S3Client#acquirePartBuffer()
+ */
+public class S3PartBuffer extends CrtResource {
+
+    private final ByteBuffer buffer;
+    private boolean submitted = false;
+
+    S3PartBuffer(long nativeHandle) {
+        acquireNativeHandle(nativeHandle);
+        buffer = s3PartBufferGetByteBuffer(nativeHandle);
+    }
+
+    /**
+     * @return direct ByteBuffer over the native part memory, with a capacity of the client's part size.
+     * Data from index 0 up to the buffer's position is uploaded when the part is submitted.
+     */
+    public ByteBuffer getBuffer() {
+        return buffer;
+    }
+
+    synchronized void markSubmitted() {
+        submitted = true;
+    }
+
+    synchronized boolean isSubmitted() {
+        return submitted;
+    }
+
+    @Override
+    protected boolean canReleaseReferencesImmediately() {
+        return true;
+    }
+
+    @Override
+    protected void releaseNativeHandle() {
+        if (!isNull() && !isSubmitted()) {
+            s3PartBufferRelease(getNativeHandle());
+        }
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+    private static native ByteBuffer s3PartBufferGetByteBuffer(long partBuffer);
+
+    private static native void s3PartBufferRelease(long partBuffer);
+}
@@ -0,0 +1,84 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.s3;
+
+import software.amazon.awssdk.crt.CrtResource;
+
+/**
+ * Request body for an S3 upload that is fed with filled {@link S3PartBuffer}s instead of a
+ * {@link software.amazon.awssdk.crt.http.HttpRequestBodyStream}.
+ * <p>
+ * Parts are consumed natively in part-number order and recycled into the client's pool as soon as they have been
+ * read, so body data is never copied through the JVM. The meta request can be made before any part has been
+ * submitted: the upload waits for each part as it needs it, so a body of any size only ever holds as many buffers
+ * as the client's pool, and Java keeps leasing buffers with {@link S3Client#acquirePartBuffer()} as earlier parts
+ * are sent. Call {@link #complete()} once the last part has been submitted. The HttpRequest must carry a
+ * Content-Length header matching the total number of bytes submitted.
+ * <p>
+ * While the upload waits for a part it holds one of the client's threads, as a blocking
+ * {@link software.amazon.awssdk.crt.http.HttpRequestBodyStream} does, so parts should be submitted promptly.
+ * Closing the queue before completing it fails any upload still reading from it, rather than truncating the body
+ * or leaving it waiting.
+ *
+ * @see S3MetaRequestOptions#withRequestPartBufferQueue(S3PartBufferQueue)
+ */
+public class S3PartBufferQueue extends CrtResource {
+
+    public S3PartBufferQueue() {
+        acquireNativeHandle(s3PartBufferQueueNew());
+    }
+
+    /**
+     * Submits a filled buffer as a part of the body. Ownership of the buffer passes to the queue.
+     *
+     * @param partNumber 1-based position of this buffer in the body. Each number may be submitted only once,
+     *                   and buffers may be submitted out of order.
+     * @param partBuffer buffer holding the part data, from index 0 up to its position
+     * @throws IllegalArgumentException if the part number was already submitted or sent, or if the parts queued
+     *                   ahead of a missing part would leave the pool no buffer for that missing part
+     */
+    public void submitPart(int partNumber, S3PartBuffer partBuffer) {
+        if (partBuffer == null || partBuffer.isNull() || partBuffer.isSubmitted()) {
+            throw new IllegalArgumentException("S3PartBufferQueue.submitPart: part buffer is closed or already submitted");
+        }
+
+        if (s3PartBufferQueueSubmit(getNativeHandle(), partNumber, partBuffer.getNativeHandle(),
+                partBuffer.getBuffer().position())) {
+            partBuffer.markSubmitted();
+        }
+    }
+
+    /**
+     * Signals that all parts have been submitted, so the upload ends once it has read them.
+     *
+     * @throws IllegalArgumentException if a part numbered below the highest one submitted is missing
+     */
+    public void complete() {
+        s3PartBufferQueueComplete(getNativeHandle());
+    }
+
+    @Override
+    protected boolean canReleaseReferencesImmediately() {
+        return true;
+    }
+
+    @Override
+    protected void releaseNativeHandle() {
+        if (!isNull()) {
+            s3PartBufferQueueRelease(getNativeHandle());
+        }
+    }
+
+    /*******************************************************************************
+     * native methods
+     ******************************************************************************/
+    private static native long s3PartBufferQueueNew();
+
+    private static native void s3PartBufferQueueRelease(long queue);
+
+    private static native boolean s3PartBufferQueueSubmit(long queue, int partNumber, long partBuffer, int length);
+
+    private static native void s3PartBufferQueueComplete(long queue);
+}
@@ -0,0 +1,69 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.s3;
+
+import java.nio.ByteBuffer;
+import java.util.concurrent.CompletableFuture;
+
+/**
+ * One byte range of one object to fetch as part of an {@link S3RangedGetBatch}.
+ * <p>
+ * The range is written natively into the caller's direct ByteBuffer, starting at its position and filling at most its
+ * remaining bytes. The buffer's position is advanced past the received bytes before the future completes, and the
+ * buffer must not be touched until then.
+ */
+public class S3RangedGet {
+    private final String key;
+    private final long rangeStart;
+    private final ByteBuffer destination;
+    private final CompletableFuture<Void> future = new CompletableFuture<>();
+
+    /**
+     * @param key key of the object, such as "my-object" or "photos/a b.jpg", URI-encoded into the request path
+     * @param rangeStart offset within the object of the first byte to fetch
+     * @param destination direct buffer to receive destination.remaining() bytes of the object
+     */
+    public S3RangedGet(String key, long rangeStart, ByteBuffer destination) {
+        if (key == null || destination == null) {
+            throw new IllegalArgumentException("S3RangedGet: key and destination must not be null");
+        }
+        if (!destination.isDirect() || destination.isReadOnly()) {
+            throw new IllegalArgumentException("S3RangedGet: destination must be a writable direct ByteBuffer");
+        }
+        if (rangeStart < 0 || destination.remaining() == 0) {
+            throw new IllegalArgumentException("S3RangedGet: range must not be empty or negative");
+        }
+        this.key = key;
+        this.rangeStart = rangeStart;
+        this.destination = destination;
+    }
+
+    public String getKey() {
+        return key;
+    }
+
+    public long getRangeStart() {
+        return rangeStart;
+    }
+
+    /**
+     * @return number of bytes requested, the destination's remaining bytes when this was created
+     */
+    public long getLength() {
+        return destination.limit() - (long)destination.position();
+    }
+
+    public ByteBuffer getDestination() {
+        return destination;
+    }
+
+    /**
+     * @return future that completes once the range has been written to the destination, or completes exceptionally
+     * with a {@link CrtS3RuntimeException} if the GET it was part of failed
+     */
+    public CompletableFuture<Void> getFuture() {
+        return future;
+    }
+}
@@ -0,0 +1,52 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.s3;
+
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+
+/**
+ * A set of ranged GetObject requests made with {@link S3Client#makeRangedGetBatch}.
+ * Close the batch once its future has completed, to release the underlying meta requests.
+ */
+public class S3RangedGetBatch implements AutoCloseable {
+    private final List<S3MetaRequest> metaRequests;
+    private final CompletableFuture<Void> future;
+
+    S3RangedGetBatch(List<S3MetaRequest> metaRequests, CompletableFuture<Void> future) {
+        this.metaRequests = metaRequests;
+        this.future = future;
+    }
+
+    /**
+     * @return future that completes when every range in the batch has completed, exceptionally if any failed
+     */
+    public CompletableFuture<Void> getFuture() {
+        return future;
+    }
+
+    /**
+     * @return number of GET requests the ranges were coalesced into
+     */
+    public int getRequestCount() {
+        return metaRequests.size();
+    }
+
+    /**
+     * Cancels any GETs that are still running.
+     */
+    public void cancel() {
+        for (S3MetaRequest metaRequest : metaRequests) {
+            metaRequest.cancel();
+        }
+    }
+
+    @Override
+    public void close() {
+        for (S3MetaRequest metaRequest : metaRequests) {
+            metaRequest.close();
+        }
+    }
+}
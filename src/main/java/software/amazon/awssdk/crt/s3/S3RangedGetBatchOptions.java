@@ -0,0 +1,74 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.s3;
+
+import java.util.List;
+
+import software.amazon.awssdk.crt.auth.credentials.CredentialsProvider;
+import software.amazon.awssdk.crt.http.HttpHeader;
+
+public class S3RangedGetBatchOptions {
+    private List<S3RangedGet> rangedGets;
+    private HttpHeader[] headers;
+    private long coalesceGapBytes = 0;
+    private CredentialsProvider credentialsProvider;
+
+    /**
+     * @param rangedGets the ranges to fetch, ranges of the same object may be in any order
+     * @return this
+     */
+    public S3RangedGetBatchOptions withRangedGets(List<S3RangedGet> rangedGets) {
+        this.rangedGets = rangedGets;
+        return this;
+    }
+
+    public List<S3RangedGet> getRangedGets() {
+        return rangedGets;
+    }
+
+    /**
+     * @param headers headers sent with every GET in the batch, such as Host. Range is set per GET.
+     * @return this
+     */
+    public S3RangedGetBatchOptions withHeaders(HttpHeader[] headers) {
+        this.headers = headers;
+        return this;
+    }
+
+    public HttpHeader[] getHeaders() {
+        return headers;
+    }
+
+    /**
+     * Ranges of the same object that are at most this many bytes apart are fetched with a single GET,
+     * and the bytes between them are discarded. Adjacent and overlapping ranges are always fetched together.
+     * <p>
+     * Default is 0.
+     *
+     * @param coalesceGapBytes largest gap between two ranges that are still fetched together
+     * @return this
+     */
+    public S3RangedGetBatchOptions withCoalesceGapBytes(long coalesceGapBytes) {
+        this.coalesceGapBytes = coalesceGapBytes;
+        return this;
+    }
+
+    public long getCoalesceGapBytes() {
+        return coalesceGapBytes;
+    }
+
+    /**
+     * @param credentialsProvider provider used to sign every GET in the batch, instead of the client's
+     * @return this
+     */
+    public S3RangedGetBatchOptions withCredentialsProvider(CredentialsProvider credentialsProvider) {
+        this.credentialsProvider = credentialsProvider;
+        return this;
+    }
+
+    public CredentialsProvider getCredentialsProvider() {
+        return credentialsProvider;
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.s3;
+
+import software.amazon.awssdk.crt.CrtRuntimeException;
+import software.amazon.awssdk.crt.io.NumaEventLoopGroups;
+
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.atomic.AtomicInteger;
+
+/**
+ * An S3Client per NUMA node, each running on its own node's EventLoopGroup with its part buffers in node-local memory.
+ * Meta requests made through the sharded client are spread across the shards round-robin, so on multi-socket hosts
+ * the connections and the memory they stream through are split between the sockets instead of all crossing to one.
+ * <p>
+ * The throughput target, connection limit and part buffer limit of the options are divided between the shards.
+ * Part buffers belong to the shard they were acquired from: a request uploading them must be made on that same shard,
+ * through {@link #getShard}.
+ */
+public final class ShardedS3Client implements AutoCloseable {
+
+    private final S3Client[] shards;
+    private final AtomicInteger nextShard = new AtomicInteger();
+
+    /**
+     * @param nodes the per-node event loop groups to run the shards on
+     * @param options options for the shards; its ClientBootstrap is ignored, each shard uses its node's own
+     * @throws CrtRuntimeException If any of the shards can't be created
+     */
+    public ShardedS3Client(NumaEventLoopGroups nodes, S3ClientOptions options) throws CrtRuntimeException {
+        int shardCount = nodes.getNodeCount();
+        shards = new S3Client[shardCount];
+        try {
+            for (int node = 0; node < shardCount; ++node) {
+                S3ClientOptions shardOptions = new S3ClientOptions(options)
+                        .withClientBootstrap(nodes.getClientBootstrap(node))
+                        .withThroughputTargetGbps(options.getThroughputTargetGbps() / shardCount)
+                        .withMaxConnections(divideLimit(options.getMaxConnections(), shardCount))
+                        .withMaxPartBuffers(divideLimit(options.getMaxPartBuffers(), shardCount));
+                if (options.getMaxPartBuffers() > 0) {
+                    shardOptions.withPartBufferCpuGroup(node);
+                }
+                shards[node] = new S3Client(shardOptions);
+            }
+        } catch (RuntimeException ex) {
+            close();
+            throw ex;
+        }
+    }
+
+    /* Splits a limit between the shards, leaving 0 (no limit / disabled) as it is */
+    private static int divideLimit(int limit, int shardCount) {
+        return limit > 0 ? Math.max(1, limit / shardCount) : limit;
+    }
+
+    /**
+     * @return the number of shards, one per node
+     */
+    public int getShardCount() {
+        return shards.length;
+    }
+
+    /**
+     * @param node index of the node, from 0 to getShardCount() - 1
+     * @return the S3Client running on the node
+     */
+    public S3Client getShard(int node) {
+        return shards[node];
+    }
+
+    /**
+     * Makes a meta request on the next shard in turn
+     * @param options options for the meta request
+     * @return the meta request
+     */
+    public S3MetaRequest makeMetaRequest(S3MetaRequestOptions options) {
+        int shard = Math.floorMod(nextShard.getAndIncrement(), shards.length);
+        return shards[shard].makeMetaRequest(options);
+    }
+
+    /**
+     * @return a future that completes once every shard has shut down
+     */
+    public CompletableFuture<Void> getShutdownCompleteFuture() {
+        CompletableFuture<?>[] shutdowns = new CompletableFuture<?>[shards.length];
+        for (int node = 0; node < shards.length; ++node) {
+            shutdowns[node] = shards[node] != null
+                    ? shards[node].getShutdownCompleteFuture() : CompletableFuture.completedFuture(null);
+        }
+        return CompletableFuture.allOf(shutdowns);
+    }
+
+    /**
+     * Closes every shard
+     */
+    @Override
+    public void close() {
+        for (S3Client shard : shards) {
+            if (shard != null) {
+                shard.close();
+            }
+        }
+    }
+}
@@ -1,5 +1,7 @@
 package software.amazon.awssdk.crt.utils;
 
+import java.nio.ByteBuffer;
+
 public class StringUtils {
     /**
      * Returns a new String composed of copies of the CharSequence elements joined together with a copy of the specified delimiter.
@@ -42,6 +44,93 @@ public class StringUtils {
         return stringUtilsBase64Decode(data);
     }
 
+    /**
+     * @param dataLength number of bytes to encode
+     * @return number of bytes the Base64 encoding of that many bytes takes, padding included
+     */
+    public static int base64EncodedLength(int dataLength) {
+        if (dataLength < 0) {
+            throw new IllegalArgumentException("dataLength must not be negative");
+        }
+        long encodedLength = (dataLength + 2L) / 3 * 4;
+        if (encodedLength > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException("Base64 encoding of " + dataLength + " bytes is too large for a buffer");
+        }
+        return (int) encodedLength;
+    }
+
+    /**
+     * @param data Base64 data, from its position to its limit; it's left untouched
+     * @return number of bytes the data decodes to
+     */
+    public static int base64DecodedLength(ByteBuffer data) {
+        int length = data.remaining();
+        if (length % 4 != 0) {
+            throw new IllegalArgumentException("Base64 data length must be a multiple of 4");
+        }
+        if (length == 0) {
+            return 0;
+        }
+        int padding = 0;
+        int last = data.position() + length - 1;
+        if (data.get(last) == '=') {
+            padding = data.get(last - 1) == '=' ? 2 : 1;
+        }
+        return length / 4 * 3 - padding;
+    }
+
+    /**
+     * Encodes the bytes remaining in one direct buffer into another, without allocating. Upon return the position of
+     * data is equal to its limit, and the position of output has advanced past the encoding.
+     *
+     * @param data direct buffer holding the bytes to encode, from its position to its limit
+     * @param output direct buffer to write the encoding at its position; it needs
+     *               <code>base64EncodedLength(data.remaining())</code> bytes remaining
+     * @return number of bytes written to output
+     */
+    public static int base64Encode(ByteBuffer data, ByteBuffer output) {
+        checkDirect(data, output);
+        int written = stringUtilsBase64EncodeDirect(data, data.position(), data.remaining(),
+            output, output.position(), output.remaining());
+        data.position(data.limit());
+        output.position(output.position() + written);
+        return written;
+    }
+
+    /**
+     * Decodes the Base64 bytes remaining in one direct buffer into another, without allocating. Upon return the
+     * position of data is equal to its limit, and the position of output has advanced past the decoded bytes.
+     *
+     * @param data direct buffer holding the Base64 bytes to decode, from its position to its limit
+     * @param output direct buffer to write the decoded bytes at its position; it needs
+     *               <code>base64DecodedLength(data)</code> bytes remaining
+     * @return number of bytes written to output
+     */
+    public static int base64Decode(ByteBuffer data, ByteBuffer output) {
+        checkDirect(data, output);
+        int written = stringUtilsBase64DecodeDirect(data, data.position(), data.remaining(),
+            output, output.position(), output.remaining());
+        data.position(data.limit());
+        output.position(output.position() + written);
+        return written;
+    }
+
+    private static void checkDirect(ByteBuffer data, ByteBuffer output) {
+        if (data == null || output == null) {
+            throw new NullPointerException("data and output must not be null");
+        }
+        if (!data.isDirect() || !output.isDirect()) {
+            throw new IllegalArgumentException("data and output must be direct buffers");
+        }
+        if (output.isReadOnly()) {
+            throw new IllegalArgumentException("output must not be read-only");
+        }
+    }
+
     private static native byte[] stringUtilsBase64Encode(byte[] data_to_encode);
     private static native byte[] stringUtilsBase64Decode(byte[] data_to_decode);
+    private static native int stringUtilsBase64EncodeDirect(ByteBuffer data, int dataPosition, int dataLength,
+                                                            ByteBuffer output, int outputPosition, int outputLength);
+    private static native int stringUtilsBase64DecodeDirect(ByteBuffer data, int dataPosition, int dataLength,
+                                                            ByteBuffer output, int outputPosition, int outputLength);
 }
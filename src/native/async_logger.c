@@ -0,0 +1,596 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "async_logger.h"
+
+#include <aws/common/atomics.h>
+#include <aws/common/byte_buf.h>
+#include <aws/common/clock.h>
+#include <aws/common/date_time.h>
+#include <aws/common/file.h>
+#include <aws/common/thread.h>
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include "crt.h"
+#include "java_class_ids.h"
+
+#define ASYNC_LOG_MAX_MESSAGE_SIZE 1000
+#define ASYNC_LOG_DEFAULT_QUEUE_CAPACITY 4096
+#define ASYNC_LOG_MAX_BATCH_RECORDS 256
+#define ASYNC_LOG_INITIAL_OUTPUT_SIZE (64 * 1024)
+#define ASYNC_LOG_IDLE_SLEEP_NS (10 * 1000 * 1000)
+
+/* rate limits are kept per (package, subject), subjects beyond the table share the last bucket of their package */
+#define ASYNC_LOG_RATE_LIMIT_PACKAGES 32
+#define ASYNC_LOG_RATE_LIMIT_SUBJECTS_PER_PACKAGE 64
+
+struct async_log_slot {
+    /*
+     * Bounded multi-producer queue (Vyukov's): a slot is free for the producer whose position equals its sequence,
+     * and holds a record for the consumer once the sequence is one past that.
+     */
+    struct aws_atomic_var sequence;
+    uint64_t timestamp_ns;
+    aws_thread_id_t thread_id;
+    enum aws_log_level level;
+    aws_log_subject_t subject;
+    size_t message_len;
+    char message[ASYNC_LOG_MAX_MESSAGE_SIZE];
+};
+
+struct async_log_rate_limit {
+    /* the second count is for */
+    struct aws_atomic_var window;
+    struct aws_atomic_var count;
+};
+
+struct async_logger_impl {
+    struct aws_allocator *allocator;
+    struct aws_atomic_var level;
+    /* fixed once the logger is initialized, usually only a handful, so found by scanning */
+    struct aws_jni_log_subject_level *subject_levels;
+    size_t subject_level_count;
+    enum aws_jni_log_format format;
+
+    struct async_log_slot *slots;
+    size_t capacity_mask;
+    struct aws_atomic_var enqueue_position;
+    /* writer thread only */
+    size_t dequeue_position;
+
+    size_t max_records_per_subject_per_second;
+    struct async_log_rate_limit *rate_limits;
+
+    struct aws_atomic_var dropped_queue_full;
+    struct aws_atomic_var dropped_rate_limited;
+    /* writer thread only, totals already reported */
+    size_t reported_queue_full;
+    size_t reported_rate_limited;
+
+    FILE *file;
+    bool close_file;
+    JavaVM *jvm;
+    jobject sink;
+
+    /* writer thread only, the batch being encoded */
+    struct aws_byte_buf output;
+    size_t output_records;
+
+    struct aws_thread writer;
+    struct aws_atomic_var shutting_down;
+};
+
+static size_t s_rate_limit_bucket(aws_log_subject_t subject) {
+    size_t package = (subject >> AWS_LOG_SUBJECT_STRIDE_BITS) % ASYNC_LOG_RATE_LIMIT_PACKAGES;
+    size_t index = subject & (AWS_LOG_SUBJECT_STRIDE - 1);
+    if (index >= ASYNC_LOG_RATE_LIMIT_SUBJECTS_PER_PACKAGE) {
+        index = ASYNC_LOG_RATE_LIMIT_SUBJECTS_PER_PACKAGE - 1;
+    }
+    return package * ASYNC_LOG_RATE_LIMIT_SUBJECTS_PER_PACKAGE + index;
+}
+
+/*
+ * Fixed one second windows. Resetting the count races with threads counting against the new window, so the limit
+ * is approximate, but it never takes a lock.
+ */
+static bool s_rate_limit_allows(struct async_logger_impl *impl, aws_log_subject_t subject, uint64_t now_ns) {
+    if (impl->max_records_per_subject_per_second == 0) {
+        return true;
+    }
+
+    struct async_log_rate_limit *limit = &impl->rate_limits[s_rate_limit_bucket(subject)];
+    size_t second = (size_t)aws_timestamp_convert(now_ns, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_SECS, NULL);
+    size_t window = aws_atomic_load_int(&limit->window);
+    if (window != second && aws_atomic_compare_exchange_int(&limit->window, &window, second)) {
+        aws_atomic_store_int(&limit->count, 0);
+    }
+
+    return aws_atomic_fetch_add(&limit->count, 1) < impl->max_records_per_subject_per_second;
+}
+
+static struct async_log_slot *s_claim_slot(struct async_logger_impl *impl, size_t *out_position) {
+    size_t position = aws_atomic_load_int(&impl->enqueue_position);
+    for (;;) {
+        struct async_log_slot *slot = &impl->slots[position & impl->capacity_mask];
+        size_t sequence = aws_atomic_load_int(&slot->sequence);
+        if (sequence == position) {
+            /* on failure, position is reloaded with the current enqueue position */
+            if (aws_atomic_compare_exchange_int(&impl->enqueue_position, &position, position + 1)) {
+                *out_position = position;
+                return slot;
+            }
+        } else if ((intptr_t)(sequence - position) < 0) {
+            /* the writer hasn't consumed this slot's record from the previous lap yet: full */
+            return NULL;
+        } else {
+            position = aws_atomic_load_int(&impl->enqueue_position);
+        }
+    }
+}
+
+static int s_async_logger_log(
+    struct aws_logger *logger,
+    enum aws_log_level log_level,
+    aws_log_subject_t subject,
+    const char *format,
+    ...) {
+
+    struct async_logger_impl *impl = logger->p_impl;
+
+    uint64_t now = 0;
+    aws_sys_clock_get_ticks(&now);
+
+    if (!s_rate_limit_allows(impl, subject, now)) {
+        aws_atomic_fetch_add(&impl->dropped_rate_limited, 1);
+        return AWS_OP_SUCCESS;
+    }
+
+    size_t position = 0;
+    struct async_log_slot *slot = s_claim_slot(impl, &position);
+    if (slot == NULL) {
+        aws_atomic_fetch_add(&impl->dropped_queue_full, 1);
+        return AWS_OP_SUCCESS;
+    }
+
+    slot->timestamp_ns = now;
+    slot->thread_id = aws_thread_current_thread_id();
+    slot->level = log_level;
+    slot->subject = subject;
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(slot->message, sizeof(slot->message), format, args);
+    va_end(args);
+
+    /* long messages are truncated */
+    slot->message_len = written < 0 ? 0 : AWS_MIN((size_t)written, sizeof(slot->message) - 1);
+
+    aws_atomic_store_int(&slot->sequence, position + 1);
+    return AWS_OP_SUCCESS;
+}
+
+static enum aws_log_level s_async_logger_get_log_level(struct aws_logger *logger, aws_log_subject_t subject) {
+    struct async_logger_impl *impl = logger->p_impl;
+    for (size_t i = 0; i < impl->subject_level_count; ++i) {
+        if (impl->subject_levels[i].subject == subject) {
+            return impl->subject_levels[i].level;
+        }
+    }
+    return (enum aws_log_level)aws_atomic_load_int(&impl->level);
+}
+
+static int s_async_logger_set_log_level(struct aws_logger *logger, enum aws_log_level level) {
+    struct async_logger_impl *impl = logger->p_impl;
+    aws_atomic_store_int(&impl->level, (size_t)level);
+    return AWS_OP_SUCCESS;
+}
+
+/*******************************************************************************
+ * encoding, writer thread only
+ ******************************************************************************/
+struct async_log_record {
+    uint64_t timestamp_ns;
+    aws_thread_id_t thread_id;
+    enum aws_log_level level;
+    aws_log_subject_t subject;
+    struct aws_byte_cursor message;
+};
+
+static struct aws_byte_cursor s_level_name(enum aws_log_level level) {
+    const char *level_name = "UNKNOWN";
+    aws_log_level_to_string(level, &level_name);
+    return aws_byte_cursor_from_c_str(level_name);
+}
+
+static void s_append_timestamp(struct aws_byte_buf *output, uint64_t timestamp_ns) {
+    struct aws_date_time date_time;
+    aws_date_time_init_epoch_millis(
+        &date_time, aws_timestamp_convert(timestamp_ns, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MILLIS, NULL));
+
+    uint8_t storage[AWS_DATE_TIME_STR_MAX_LEN];
+    struct aws_byte_buf date_buf = aws_byte_buf_from_empty_array(storage, sizeof(storage));
+    aws_date_time_to_utc_time_str(&date_time, AWS_DATE_FORMAT_ISO_8601, &date_buf);
+    struct aws_byte_cursor date = aws_byte_cursor_from_buf(&date_buf);
+    aws_byte_buf_append_dynamic(output, &date);
+}
+
+static void s_append_c_str(struct aws_byte_buf *output, const char *str) {
+    struct aws_byte_cursor cursor = aws_byte_cursor_from_c_str(str);
+    aws_byte_buf_append_dynamic(output, &cursor);
+}
+
+static void s_append_json_string(struct aws_byte_buf *output, struct aws_byte_cursor value) {
+    s_append_c_str(output, "\"");
+
+    /* copy runs of characters that don't need escaping in one go */
+    size_t run_start = 0;
+    for (size_t i = 0; i < value.len; ++i) {
+        uint8_t c = value.ptr[i];
+        if (c != '"' && c != '\\' && c >= 0x20) {
+            continue;
+        }
+
+        struct aws_byte_cursor run = {.ptr = value.ptr + run_start, .len = i - run_start};
+        aws_byte_buf_append_dynamic(output, &run);
+        run_start = i + 1;
+
+        char escaped[8];
+        switch (c) {
+            case '"':
+                s_append_c_str(output, "\\\"");
+                break;
+            case '\\':
+                s_append_c_str(output, "\\\\");
+                break;
+            case '\n':
+                s_append_c_str(output, "\\n");
+                break;
+            case '\r':
+                s_append_c_str(output, "\\r");
+                break;
+            case '\t':
+                s_append_c_str(output, "\\t");
+                break;
+            default:
+                snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned int)c);
+                s_append_c_str(output, escaped);
+                break;
+        }
+    }
+
+    struct aws_byte_cursor run = {.ptr = value.ptr + run_start, .len = value.len - run_start};
+    aws_byte_buf_append_dynamic(output, &run);
+
+    s_append_c_str(output, "\"");
+}
+
+/* [LEVEL] [timestamp] [thread] [subject] - message, the same layout as the standard logger */
+static void s_encode_text(struct aws_byte_buf *output, const struct async_log_record *record, const char *thread_id) {
+    struct aws_byte_cursor level_name = s_level_name(record->level);
+
+    s_append_c_str(output, "[");
+    aws_byte_buf_append_dynamic(output, &level_name);
+    s_append_c_str(output, "] [");
+    s_append_timestamp(output, record->timestamp_ns);
+    s_append_c_str(output, "] [");
+    s_append_c_str(output, thread_id);
+    s_append_c_str(output, "] [");
+    s_append_c_str(output, aws_log_subject_name(record->subject));
+    s_append_c_str(output, "] - ");
+    aws_byte_buf_append_dynamic(output, &record->message);
+    s_append_c_str(output, "\n");
+}
+
+/* one object per line */
+static void s_encode_json(struct aws_byte_buf *output, const struct async_log_record *record, const char *thread_id) {
+    char timestamp_ns[32];
+    snprintf(timestamp_ns, sizeof(timestamp_ns), "%" PRIu64, record->timestamp_ns);
+
+    s_append_c_str(output, "{\"timestamp\":\"");
+    s_append_timestamp(output, record->timestamp_ns);
+    s_append_c_str(output, "\",\"timestampNs\":");
+    s_append_c_str(output, timestamp_ns);
+    s_append_c_str(output, ",\"level\":");
+    s_append_json_string(output, s_level_name(record->level));
+    s_append_c_str(output, ",\"thread\":");
+    s_append_json_string(output, aws_byte_cursor_from_c_str(thread_id));
+    s_append_c_str(output, ",\"subject\":");
+    s_append_json_string(output, aws_byte_cursor_from_c_str(aws_log_subject_name(record->subject)));
+    s_append_c_str(output, ",\"message\":");
+    s_append_json_string(output, record->message);
+    s_append_c_str(output, "}\n");
+}
+
+/*
+ * [timestamp ns: 8][level: 4][subject: 4][thread length: 4][thread][message length: 4][message], big endian.
+ * Must match Log.deliverLogBatch().
+ */
+static void s_encode_binary(struct aws_byte_buf *output, const struct async_log_record *record, const char *thread_id) {
+    struct aws_byte_cursor thread = aws_byte_cursor_from_c_str(thread_id);
+    if (aws_byte_buf_reserve_relative(output, 8 + 4 + 4 + 4 + thread.len + 4 + record->message.len)) {
+        return;
+    }
+
+    aws_byte_buf_write_be64(output, record->timestamp_ns);
+    aws_byte_buf_write_be32(output, (uint32_t)record->level);
+    aws_byte_buf_write_be32(output, (uint32_t)record->subject);
+    aws_byte_buf_write_be32(output, (uint32_t)thread.len);
+    aws_byte_buf_write_from_whole_cursor(output, thread);
+    aws_byte_buf_write_be32(output, (uint32_t)record->message.len);
+    aws_byte_buf_write_from_whole_cursor(output, record->message);
+}
+
+static void s_encode_record(struct async_logger_impl *impl, const struct async_log_record *record) {
+    char thread_id[AWS_THREAD_ID_T_REPR_BUFSZ];
+    if (aws_thread_id_t_to_string(record->thread_id, thread_id, sizeof(thread_id))) {
+        thread_id[0] = '\0';
+    }
+
+    switch (impl->sink != NULL ? AWS_JNI_LOG_FORMAT_BINARY : impl->format) {
+        case AWS_JNI_LOG_FORMAT_JSON:
+            s_encode_json(&impl->output, record, thread_id);
+            break;
+        case AWS_JNI_LOG_FORMAT_BINARY:
+            s_encode_binary(&impl->output, record, thread_id);
+            break;
+        default:
+            s_encode_text(&impl->output, record, thread_id);
+            break;
+    }
+    ++impl->output_records;
+}
+
+static void s_encode_dropped_records(struct async_logger_impl *impl) {
+    size_t queue_full = aws_atomic_load_int(&impl->dropped_queue_full);
+    size_t rate_limited = aws_atomic_load_int(&impl->dropped_rate_limited);
+    if (queue_full == impl->reported_queue_full && rate_limited == impl->reported_rate_limited) {
+        return;
+    }
+
+    char message[128];
+    int written = snprintf(
+        message,
+        sizeof(message),
+        "Dropped %zu log records because the queue was full and %zu because of rate limiting",
+        queue_full - impl->reported_queue_full,
+        rate_limited - impl->reported_rate_limited);
+    impl->reported_queue_full = queue_full;
+    impl->reported_rate_limited = rate_limited;
+
+    struct async_log_record record = {
+        .thread_id = aws_thread_current_thread_id(),
+        .level = AWS_LL_WARN,
+        .subject = AWS_LS_JAVA_CRT_GENERAL,
+        .message = {.ptr = (uint8_t *)message, .len = written < 0 ? 0 : AWS_MIN((size_t)written, sizeof(message) - 1)},
+    };
+    aws_sys_clock_get_ticks(&record.timestamp_ns);
+    s_encode_record(impl, &record);
+}
+
+static void s_deliver_to_sink(struct async_logger_impl *impl) {
+    /********** JNI ENV ACQUIRE **********/
+    JNIEnv *env = aws_jni_acquire_thread_env(impl->jvm);
+    if (env == NULL) {
+        /* JVM is no longer available, nowhere to deliver to */
+        return;
+    }
+
+    jobject batch = aws_jni_direct_byte_buffer_from_raw_ptr(env, impl->output.buffer, impl->output.len);
+    if (batch != NULL) {
+        (*env)->CallStaticVoidMethod(
+            env,
+            log_properties.log_class,
+            log_properties.deliver_log_batch_method_id,
+            impl->sink,
+            batch,
+            (jint)impl->output_records);
+        (*env)->DeleteLocalRef(env, batch);
+    }
+    aws_jni_check_and_clear_exception(env);
+
+    aws_jni_release_thread_env(impl->jvm, env);
+    /********** JNI ENV RELEASE **********/
+}
+
+static void s_flush_output(struct async_logger_impl *impl) {
+    if (impl->output_records == 0) {
+        return;
+    }
+
+    if (impl->sink != NULL) {
+        s_deliver_to_sink(impl);
+    } else {
+        fwrite(impl->output.buffer, 1, impl->output.len, impl->file);
+        fflush(impl->file);
+    }
+
+    aws_byte_buf_reset(&impl->output, false);
+    impl->output_records = 0;
+}
+
+/* Consumes up to a batch of records, returns how many */
+static size_t s_drain(struct async_logger_impl *impl) {
+    size_t drained = 0;
+    while (drained < ASYNC_LOG_MAX_BATCH_RECORDS) {
+        size_t position = impl->dequeue_position;
+        struct async_log_slot *slot = &impl->slots[position & impl->capacity_mask];
+        if (aws_atomic_load_int(&slot->sequence) != position + 1) {
+            /* empty, or the producer that claimed it is still writing */
+            break;
+        }
+
+        struct async_log_record record = {
+            .timestamp_ns = slot->timestamp_ns,
+            .thread_id = slot->thread_id,
+            .level = slot->level,
+            .subject = slot->subject,
+            .message = {.ptr = (uint8_t *)slot->message, .len = slot->message_len},
+        };
+        s_encode_record(impl, &record);
+
+        /* hand the slot back to producers for the next lap */
+        aws_atomic_store_int(&slot->sequence, position + impl->capacity_mask + 1);
+        impl->dequeue_position = position + 1;
+        ++drained;
+    }
+
+    s_encode_dropped_records(impl);
+    s_flush_output(impl);
+    return drained;
+}
+
+static void s_writer_thread_fn(void *arg) {
+    struct async_logger_impl *impl = arg;
+
+    for (;;) {
+        /* read before draining, so that everything logged before shutdown started gets written */
+        bool shutting_down = aws_atomic_load_int(&impl->shutting_down) != 0;
+        if (s_drain(impl) > 0) {
+            continue;
+        }
+        if (shutting_down) {
+            break;
+        }
+        aws_thread_current_sleep(ASYNC_LOG_IDLE_SLEEP_NS);
+    }
+}
+
+static void s_async_logger_impl_destroy(struct async_logger_impl *impl) {
+    if (impl->close_file && impl->file != NULL) {
+        fclose(impl->file);
+    }
+
+    if (impl->sink != NULL) {
+        /********** JNI ENV ACQUIRE **********/
+        JNIEnv *env = aws_jni_acquire_thread_env(impl->jvm);
+        if (env != NULL) {
+            (*env)->DeleteGlobalRef(env, impl->sink);
+
+            aws_jni_release_thread_env(impl->jvm, env);
+            /********** JNI ENV RELEASE **********/
+        }
+    }
+
+    aws_byte_buf_clean_up(&impl->output);
+    aws_mem_release(impl->allocator, impl->subject_levels);
+    aws_mem_release(impl->allocator, impl->rate_limits);
+    aws_mem_release(impl->allocator, impl->slots);
+    aws_mem_release(impl->allocator, impl);
+}
+
+static void s_async_logger_clean_up(struct aws_logger *logger) {
+    struct async_logger_impl *impl = logger->p_impl;
+
+    aws_atomic_store_int(&impl->shutting_down, 1);
+    aws_thread_join(&impl->writer);
+    aws_thread_clean_up(&impl->writer);
+
+    s_async_logger_impl_destroy(impl);
+    AWS_ZERO_STRUCT(*logger);
+}
+
+static struct aws_logger_vtable s_async_logger_vtable = {
+    .log = s_async_logger_log,
+    .get_log_level = s_async_logger_get_log_level,
+    .clean_up = s_async_logger_clean_up,
+    .set_log_level = s_async_logger_set_log_level,
+};
+
+static size_t s_round_up_to_power_of_two(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+int aws_jni_async_logger_init(
+    struct aws_logger *logger,
+    JNIEnv *env,
+    struct aws_allocator *allocator,
+    const struct aws_jni_async_logger_options *options) {
+
+    struct async_logger_impl *impl = aws_mem_calloc(allocator, 1, sizeof(struct async_logger_impl));
+    impl->allocator = allocator;
+    aws_atomic_init_int(&impl->level, (size_t)options->level);
+    impl->format = options->format;
+    impl->max_records_per_subject_per_second = options->max_records_per_subject_per_second;
+    aws_atomic_init_int(&impl->enqueue_position, 0);
+    aws_atomic_init_int(&impl->dropped_queue_full, 0);
+    aws_atomic_init_int(&impl->dropped_rate_limited, 0);
+    aws_atomic_init_int(&impl->shutting_down, 0);
+
+    size_t capacity = s_round_up_to_power_of_two(
+        options->queue_capacity > 0 ? options->queue_capacity : ASYNC_LOG_DEFAULT_QUEUE_CAPACITY);
+    impl->slots = aws_mem_calloc(allocator, capacity, sizeof(struct async_log_slot));
+    if (impl->slots == NULL) {
+        goto on_error;
+    }
+    impl->capacity_mask = capacity - 1;
+    for (size_t i = 0; i < capacity; ++i) {
+        aws_atomic_init_int(&impl->slots[i].sequence, i);
+    }
+
+    if (options->subject_level_count > 0) {
+        impl->subject_levels =
+            aws_mem_calloc(allocator, options->subject_level_count, sizeof(struct aws_jni_log_subject_level));
+        if (impl->subject_levels == NULL) {
+            goto on_error;
+        }
+        memcpy(
+            impl->subject_levels,
+            options->subject_levels,
+            options->subject_level_count * sizeof(struct aws_jni_log_subject_level));
+        impl->subject_level_count = options->subject_level_count;
+    }
+
+    if (impl->max_records_per_subject_per_second > 0) {
+        impl->rate_limits = aws_mem_calloc(
+            allocator,
+            ASYNC_LOG_RATE_LIMIT_PACKAGES * ASYNC_LOG_RATE_LIMIT_SUBJECTS_PER_PACKAGE,
+            sizeof(struct async_log_rate_limit));
+        if (impl->rate_limits == NULL) {
+            goto on_error;
+        }
+    }
+
+    if (aws_byte_buf_init(&impl->output, allocator, ASYNC_LOG_INITIAL_OUTPUT_SIZE)) {
+        goto on_error;
+    }
+
+    if (options->sink != NULL) {
+        impl->jvm = options->jvm;
+        impl->sink = (*env)->NewGlobalRef(env, options->sink);
+        if (impl->sink == NULL) {
+            goto on_error;
+        }
+    } else if (options->filename != NULL) {
+        impl->file = aws_fopen(options->filename, "a");
+        if (impl->file == NULL) {
+            goto on_error;
+        }
+        impl->close_file = true;
+    } else {
+        impl->file = options->file;
+    }
+
+    aws_thread_init(&impl->writer, allocator);
+    if (aws_thread_launch(&impl->writer, s_writer_thread_fn, impl, aws_default_thread_options())) {
+        aws_thread_clean_up(&impl->writer);
+        goto on_error;
+    }
+
+    logger->vtable = &s_async_logger_vtable;
+    logger->allocator = allocator;
+    logger->p_impl = impl;
+    return AWS_OP_SUCCESS;
+
+on_error:
+    s_async_logger_impl_destroy(impl);
+    return AWS_OP_ERR;
+}
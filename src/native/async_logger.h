@@ -0,0 +1,71 @@
+#ifndef AWS_JNI_CRT_ASYNC_LOGGER_H
+#define AWS_JNI_CRT_ASYNC_LOGGER_H
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <jni.h>
+
+#include <aws/common/logging.h>
+
+#include <stdio.h>
+
+/*
+ * A logger that keeps formatting and I/O off the threads doing the logging. Logging a record only formats the
+ * message itself into a slot of a fixed-size lock-free queue; a background writer thread adds the timestamp, level,
+ * thread and subject, encodes the record as text, JSON or binary, and writes batches of records to a file or hands
+ * them to Java.
+ *
+ * The logging thread never blocks: when the queue is full, or a subject is over its rate limit, the record is
+ * dropped, and the writer reports how many were dropped.
+ */
+
+/* A level that applies to one subject in place of the logger's level */
+struct aws_jni_log_subject_level {
+    aws_log_subject_t subject;
+    enum aws_log_level level;
+};
+
+/* Must match Log.LogFormat */
+enum aws_jni_log_format {
+    AWS_JNI_LOG_FORMAT_TEXT = 0,
+    AWS_JNI_LOG_FORMAT_JSON = 1,
+    AWS_JNI_LOG_FORMAT_BINARY = 2,
+};
+
+struct aws_jni_async_logger_options {
+    enum aws_log_level level;
+
+    /* levels for particular subjects, copied by the logger; changing the logger's level doesn't affect them */
+    const struct aws_jni_log_subject_level *subject_levels;
+    size_t subject_level_count;
+
+    /* ignored when delivering to a sink, which always gets binary records */
+    enum aws_jni_log_format format;
+
+    /* exactly one of file, filename or sink */
+    FILE *file;
+    const char *filename;
+    /* Log.LogSink, the logger takes its own global reference */
+    jobject sink;
+    JavaVM *jvm;
+
+    /* number of records the queue holds, rounded up to a power of two, 0 for the default */
+    size_t queue_capacity;
+
+    /* records per second allowed for each subject, 0 for no limit */
+    size_t max_records_per_subject_per_second;
+};
+
+/*******************************************************************************
+ * aws_jni_async_logger_init - initializes an asynchronous logger and starts its writer thread
+ ******************************************************************************/
+int aws_jni_async_logger_init(
+    struct aws_logger *logger,
+    JNIEnv *env,
+    struct aws_allocator *allocator,
+    const struct aws_jni_async_logger_options *options);
+
+#endif /* AWS_JNI_CRT_ASYNC_LOGGER_H */
@@ -17,6 +17,9 @@
 #include <aws/auth/signing.h>
 #include <aws/auth/signing_result.h>
 #include <aws/cal/ecc.h>
+#include <aws/common/array_list.h>
+#include <aws/common/atomics.h>
+#include <aws/common/ref_count.h>
 #include <aws/common/string.h>
 #include <aws/http/request_response.h>
 #include <aws/io/stream.h>
@@ -33,24 +36,92 @@
 #    endif
 #endif
 
+/*
+ * The native form of an AwsSigningConfig. It is built from the Java object's fields for each signing call, unless
+ * AwsSigningConfig.freeze() built it once already, in which case every call shares it. Reference counted, so a frozen
+ * configuration can be closed while signings that use it are still in flight.
+ */
+struct aws_jni_signing_config {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+    JavaVM *jvm;
+    struct aws_signing_config_aws config;
+    struct aws_string *region;
+    struct aws_string *service;
+    struct aws_string *signed_body_value;
+    struct aws_credentials *credentials;
+    jobject java_sign_header_predicate;
+    /* struct aws_string *, header names compared without regard to case */
+    struct aws_array_list signed_header_allow_list;
+    struct aws_array_list signed_header_deny_list;
+};
+
 struct s_aws_sign_request_callback_data {
     JavaVM *jvm;
     jobject java_signing_result_future;
     jobject java_original_request;
     jobject java_original_chunk_body;
-    jobject java_sign_header_predicate;
     jbyteArray java_previous_signature;
     struct aws_http_headers *trailing_headers;
     struct aws_input_stream *chunk_body_stream;
     struct aws_http_message *native_request;
     struct aws_signable *original_message_signable;
-    struct aws_string *region;
-    struct aws_string *service;
-    struct aws_string *signed_body_value;
+    struct aws_jni_signing_config *signing_config;
     struct aws_byte_cursor previous_signature;
+    /* Credentials sourced for this signing, beyond those of the signing configuration */
     struct aws_credentials *credentials;
 };
 
+static void s_destroy_header_list(struct aws_array_list *header_list) {
+    if (header_list->alloc == NULL) {
+        /* never initialized */
+        return;
+    }
+
+    for (size_t i = 0; i < aws_array_list_length(header_list); ++i) {
+        struct aws_string *header_name = NULL;
+        aws_array_list_get_at(header_list, &header_name, i);
+        aws_string_destroy(header_name);
+    }
+    aws_array_list_clean_up(header_list);
+}
+
+static void s_aws_jni_signing_config_destroy(void *user_data) {
+    struct aws_jni_signing_config *signing_config = user_data;
+
+    if (signing_config->java_sign_header_predicate != NULL) {
+        /********** JNI ENV ACQUIRE **********/
+        JNIEnv *env = aws_jni_acquire_thread_env(signing_config->jvm);
+        if (env != NULL) {
+            (*env)->DeleteGlobalRef(env, signing_config->java_sign_header_predicate);
+            aws_jni_release_thread_env(signing_config->jvm, env);
+            /********** JNI ENV RELEASE **********/
+        }
+    }
+
+    s_destroy_header_list(&signing_config->signed_header_allow_list);
+    s_destroy_header_list(&signing_config->signed_header_deny_list);
+
+    if (signing_config->config.credentials_provider != NULL) {
+        aws_credentials_provider_release(signing_config->config.credentials_provider);
+    }
+    aws_credentials_release(signing_config->credentials);
+    aws_string_destroy(signing_config->region);
+    aws_string_destroy(signing_config->service);
+    aws_string_destroy(signing_config->signed_body_value);
+
+    aws_mem_release(signing_config->allocator, signing_config);
+}
+
+static struct aws_jni_signing_config *s_aws_jni_signing_config_acquire(struct aws_jni_signing_config *signing_config) {
+    aws_ref_count_acquire(&signing_config->ref_count);
+    return signing_config;
+}
+
+static void s_aws_jni_signing_config_release(struct aws_jni_signing_config *signing_config) {
+    aws_ref_count_release(&signing_config->ref_count);
+}
+
 static void s_cleanup_callback_data(struct s_aws_sign_request_callback_data *callback_data, JNIEnv *env) {
     if (callback_data == NULL || env == NULL) {
         return;
@@ -68,10 +139,6 @@ static void s_cleanup_callback_data(struct s_aws_sign_request_callback_data *cal
         (*env)->DeleteGlobalRef(env, callback_data->java_original_chunk_body);
     }
 
-    if (callback_data->java_sign_header_predicate) {
-        (*env)->DeleteGlobalRef(env, callback_data->java_sign_header_predicate);
-    }
-
     if (callback_data->native_request) {
         aws_http_message_release(callback_data->native_request);
     }
@@ -90,9 +157,9 @@ static void s_cleanup_callback_data(struct s_aws_sign_request_callback_data *cal
     if (callback_data->trailing_headers != NULL) {
         aws_http_headers_release(callback_data->trailing_headers);
     }
-    aws_string_destroy(callback_data->region);
-    aws_string_destroy(callback_data->service);
-    aws_string_destroy(callback_data->signed_body_value);
+    if (callback_data->signing_config != NULL) {
+        s_aws_jni_signing_config_release(callback_data->signing_config);
+    }
 
     if (callback_data->previous_signature.len > 0 && callback_data->java_previous_signature != NULL) {
         aws_jni_byte_cursor_from_jbyteArray_release(
@@ -103,7 +170,7 @@ static void s_cleanup_callback_data(struct s_aws_sign_request_callback_data *cal
         (*env)->DeleteGlobalRef(env, callback_data->java_previous_signature);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), callback_data);
+    aws_mem_release(aws_jni_auth_allocator(), callback_data);
 }
 
 static jobject s_create_signed_java_http_request(
@@ -212,7 +279,7 @@ static void s_aws_request_signing_complete(struct aws_signing_result *result, in
         goto done;
     }
 
-    if (aws_apply_signing_result_to_http_request(callback_data->native_request, aws_jni_get_allocator(), result)) {
+    if (aws_apply_signing_result_to_http_request(callback_data->native_request, aws_jni_auth_allocator(), result)) {
         s_complete_signing_exceptionally(env, callback_data, aws_last_error());
         goto done;
     }
@@ -270,11 +337,45 @@ static void s_aws_trailing_headers_signing_complete(struct aws_signing_result *r
     s_aws_chunk_like_signing_complete(result, error_code, userdata);
 }
 
+static bool s_header_list_contains(const struct aws_array_list *header_list, const struct aws_byte_cursor *name) {
+    for (size_t i = 0; i < aws_array_list_length(header_list); ++i) {
+        struct aws_string *header_name = NULL;
+        aws_array_list_get_at(header_list, &header_name, i);
+        if (aws_string_eq_byte_cursor_ignore_case(header_name, name)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Host, which SigV4 requires to be signed, and the headers the signer adds itself; an allow list never filters these */
+static bool s_is_always_signed_header(const struct aws_byte_cursor *name) {
+    return aws_byte_cursor_eq_c_str_ignore_case(name, "host") ||
+           aws_byte_cursor_eq_c_str_ignore_case(name, "x-amz-date") ||
+           aws_byte_cursor_eq_c_str_ignore_case(name, "x-amz-content-sha256") ||
+           aws_byte_cursor_eq_c_str_ignore_case(name, "x-amz-security-token") ||
+           aws_byte_cursor_eq_c_str_ignore_case(name, "x-amz-region-set");
+}
+
 static bool s_should_sign_header(const struct aws_byte_cursor *name, void *user_data) {
-    struct s_aws_sign_request_callback_data *callback_data = user_data;
+    struct aws_jni_signing_config *signing_config = user_data;
+
+    if (aws_array_list_length(&signing_config->signed_header_allow_list) > 0 &&
+        !s_header_list_contains(&signing_config->signed_header_allow_list, name) && !s_is_always_signed_header(name)) {
+        return false;
+    }
+
+    if (s_header_list_contains(&signing_config->signed_header_deny_list, name)) {
+        return false;
+    }
+
+    if (signing_config->java_sign_header_predicate == NULL) {
+        return true;
+    }
 
     /********** JNI ENV ACQUIRE **********/
-    JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
+    JNIEnv *env = aws_jni_acquire_thread_env(signing_config->jvm);
     if (env == NULL) {
         /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
         return false;
@@ -283,22 +384,59 @@ static bool s_should_sign_header(const struct aws_byte_cursor *name, void *user_
     jstring header_name = aws_jni_string_from_cursor(env, name);
 
     bool result = (*env)->CallBooleanMethod(
-        env, callback_data->java_sign_header_predicate, predicate_properties.test_method_id, (jobject)header_name);
+        env, signing_config->java_sign_header_predicate, predicate_properties.test_method_id, (jobject)header_name);
     AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
 
     (*env)->DeleteLocalRef(env, header_name);
 
-    aws_jni_release_thread_env(callback_data->jvm, env);
+    aws_jni_release_thread_env(signing_config->jvm, env);
     /********** JNI ENV RELEASE **********/
 
     return result;
 }
 
-static int s_build_signing_config(
+static int s_init_header_list(
     JNIEnv *env,
-    struct s_aws_sign_request_callback_data *callback_data,
+    struct aws_allocator *allocator,
     jobject java_config,
-    struct aws_signing_config_aws *config) {
+    jfieldID field_id,
+    struct aws_array_list *header_list) {
+
+    jobjectArray java_header_names = (jobjectArray)(*env)->GetObjectField(env, java_config, field_id);
+    jsize header_count = java_header_names != NULL ? (*env)->GetArrayLength(env, java_header_names) : 0;
+
+    if (aws_array_list_init_dynamic(header_list, allocator, (size_t)header_count, sizeof(struct aws_string *))) {
+        return AWS_OP_ERR;
+    }
+
+    for (jsize i = 0; i < header_count; ++i) {
+        jstring java_header_name = (jstring)(*env)->GetObjectArrayElement(env, java_header_names, i);
+        struct aws_string *header_name = aws_jni_new_string_from_jstring(env, java_header_name);
+        (*env)->DeleteLocalRef(env, java_header_name);
+        if (header_name == NULL) {
+            return AWS_OP_ERR;
+        }
+
+        aws_array_list_push_back(header_list, &header_name);
+    }
+
+    if (java_header_names != NULL) {
+        (*env)->DeleteLocalRef(env, java_header_names);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static struct aws_jni_signing_config *s_aws_jni_signing_config_new(JNIEnv *env, jobject java_config) {
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
+    struct aws_jni_signing_config *signing_config = aws_mem_calloc(allocator, 1, sizeof(struct aws_jni_signing_config));
+    signing_config->allocator = allocator;
+    aws_ref_count_init(&signing_config->ref_count, signing_config, s_aws_jni_signing_config_destroy);
+
+    jint jvmresult = (*env)->GetJavaVM(env, &signing_config->jvm);
+    AWS_FATAL_ASSERT(jvmresult == 0);
+
+    struct aws_signing_config_aws *config = &signing_config->config;
 
     config->config_type = AWS_SIGNING_CONFIG_AWS;
     config->algorithm = (enum aws_signing_algorithm)(*env)->GetIntField(
@@ -307,12 +445,12 @@ static int s_build_signing_config(
         env, java_config, aws_signing_config_properties.signature_type_field_id);
 
     jstring region = (jstring)(*env)->GetObjectField(env, java_config, aws_signing_config_properties.region_field_id);
-    callback_data->region = aws_jni_new_string_from_jstring(env, region);
-    config->region = aws_byte_cursor_from_string(callback_data->region);
+    signing_config->region = aws_jni_new_string_from_jstring(env, region);
+    config->region = aws_byte_cursor_from_string(signing_config->region);
 
     jstring service = (jstring)(*env)->GetObjectField(env, java_config, aws_signing_config_properties.service_field_id);
-    callback_data->service = aws_jni_new_string_from_jstring(env, service);
-    config->service = aws_byte_cursor_from_string(callback_data->service);
+    signing_config->service = aws_jni_new_string_from_jstring(env, service);
+    config->service = aws_byte_cursor_from_string(signing_config->service);
 
     int64_t epoch_time_millis = (*env)->GetLongField(env, java_config, aws_signing_config_properties.time_field_id);
     aws_date_time_init_epoch_millis(&config->date, (uint64_t)epoch_time_millis);
@@ -320,11 +458,31 @@ static int s_build_signing_config(
     jobject sign_header_predicate =
         (*env)->GetObjectField(env, java_config, aws_signing_config_properties.should_sign_header_field_id);
     if (sign_header_predicate != NULL) {
-        callback_data->java_sign_header_predicate = (*env)->NewGlobalRef(env, sign_header_predicate);
-        AWS_FATAL_ASSERT(callback_data->java_sign_header_predicate != NULL);
+        signing_config->java_sign_header_predicate = (*env)->NewGlobalRef(env, sign_header_predicate);
+        AWS_FATAL_ASSERT(signing_config->java_sign_header_predicate != NULL);
+    }
 
+    if (s_init_header_list(
+            env,
+            allocator,
+            java_config,
+            aws_signing_config_properties.signed_header_allow_list_field_id,
+            &signing_config->signed_header_allow_list) ||
+        s_init_header_list(
+            env,
+            allocator,
+            java_config,
+            aws_signing_config_properties.signed_header_deny_list_field_id,
+            &signing_config->signed_header_deny_list)) {
+        goto on_error;
+    }
+
+    /* Headers are filtered natively, only calling into Java per header when there is a Java predicate */
+    if (signing_config->java_sign_header_predicate != NULL ||
+        aws_array_list_length(&signing_config->signed_header_allow_list) > 0 ||
+        aws_array_list_length(&signing_config->signed_header_deny_list) > 0) {
         config->should_sign_header = s_should_sign_header;
-        config->should_sign_header_ud = callback_data;
+        config->should_sign_header_ud = signing_config;
     }
 
     config->flags.use_double_uri_encode =
@@ -339,8 +497,8 @@ static int s_build_signing_config(
     if (signed_body_value == NULL) {
         AWS_ZERO_STRUCT(config->signed_body_value);
     } else {
-        callback_data->signed_body_value = aws_jni_new_string_from_jstring(env, signed_body_value);
-        config->signed_body_value = aws_byte_cursor_from_string(callback_data->signed_body_value);
+        signing_config->signed_body_value = aws_jni_new_string_from_jstring(env, signed_body_value);
+        config->signed_body_value = aws_byte_cursor_from_string(signing_config->signed_body_value);
     }
 
     config->signed_body_header =
@@ -349,27 +507,100 @@ static int s_build_signing_config(
     jobject provider =
         (*env)->GetObjectField(env, java_config, aws_signing_config_properties.credentials_provider_field_id);
     if (provider != NULL) {
-        config->credentials_provider =
+        struct aws_credentials_provider *native_provider =
             (void *)(*env)->CallLongMethod(env, provider, crt_resource_properties.get_native_handle_method_id);
         aws_jni_check_and_clear_exception(env);
+        if (native_provider != NULL) {
+            /* Held so that a frozen configuration, or a signing in flight, keeps its provider alive */
+            config->credentials_provider = aws_credentials_provider_acquire(native_provider);
+        }
     }
 
     jobject credentials = (*env)->GetObjectField(env, java_config, aws_signing_config_properties.credentials_field_id);
     if (credentials != NULL) {
-        callback_data->credentials = aws_credentials_new_from_java_credentials(env, credentials);
-        config->credentials = callback_data->credentials;
+        signing_config->credentials = aws_credentials_new_from_java_credentials(env, credentials);
+        config->credentials = signing_config->credentials;
     }
 
     config->expiration_in_seconds =
         (uint64_t)(*env)->GetLongField(env, java_config, aws_signing_config_properties.expiration_in_seconds_field_id);
 
+    if (aws_jni_check_and_clear_exception(env)) {
+        aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
+        goto on_error;
+    }
+
+    return signing_config;
+
+on_error:
+
+    s_aws_jni_signing_config_release(signing_config);
+    return NULL;
+}
+
+static int s_build_signing_config(
+    JNIEnv *env,
+    struct s_aws_sign_request_callback_data *callback_data,
+    jobject java_config,
+    struct aws_signing_config_aws *config) {
+
+    /* A frozen AwsSigningConfig already holds its native form */
+    jlong native_handle = (*env)->CallLongMethod(env, java_config, crt_resource_properties.get_native_handle_method_id);
     if (aws_jni_check_and_clear_exception(env)) {
         return aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
     }
 
+    if (native_handle != 0) {
+        struct aws_jni_signing_config *frozen_config = (struct aws_jni_signing_config *)native_handle;
+        callback_data->signing_config = s_aws_jni_signing_config_acquire(frozen_config);
+    } else {
+        callback_data->signing_config = s_aws_jni_signing_config_new(env, java_config);
+        if (callback_data->signing_config == NULL) {
+            return AWS_OP_ERR;
+        }
+    }
+
+    *config = callback_data->signing_config->config;
+
+    /* The time remains settable on a frozen configuration, so it is read on every call */
+    int64_t epoch_time_millis = (*env)->GetLongField(env, java_config, aws_signing_config_properties.time_field_id);
+    aws_date_time_init_epoch_millis(&config->date, (uint64_t)epoch_time_millis);
+
     return AWS_OP_SUCCESS;
 }
 
+JNIEXPORT
+jlong JNICALL Java_software_amazon_awssdk_crt_auth_signing_AwsSigningConfig_awsSigningConfigNew(
+    JNIEnv *env,
+    jclass jni_class,
+    jobject java_signing_config) {
+
+    (void)jni_class;
+
+    struct aws_jni_signing_config *signing_config = s_aws_jni_signing_config_new(env, java_signing_config);
+    if (signing_config == NULL) {
+        aws_jni_throw_runtime_exception(env, "Failed to create native signing configuration");
+        return (jlong)NULL;
+    }
+
+    return (jlong)signing_config;
+}
+
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_auth_signing_AwsSigningConfig_awsSigningConfigRelease(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong signing_config_handle) {
+
+    (void)env;
+    (void)jni_class;
+
+    struct aws_jni_signing_config *signing_config = (struct aws_jni_signing_config *)signing_config_handle;
+    if (signing_config != NULL) {
+        s_aws_jni_signing_config_release(signing_config);
+    }
+}
+
 JNIEXPORT
 void JNICALL Java_software_amazon_awssdk_crt_auth_signing_AwsSigner_awsSignerSignRequest(
     JNIEnv *env,
@@ -381,7 +612,7 @@ void JNICALL Java_software_amazon_awssdk_crt_auth_signing_AwsSigner_awsSignerSig
 
     (void)jni_class;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct s_aws_sign_request_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct s_aws_sign_request_callback_data));
     if (callback_data == NULL) {
@@ -441,6 +672,324 @@ on_error:
     s_cleanup_callback_data(callback_data, env);
 }
 
+/*
+ * Batch signing: the signing configuration is read, and credentials are sourced, once for the whole batch. For SigV4a
+ * the ECC key derived from the credentials is shared too; aws-c-auth would otherwise derive it again for every request.
+ * The batch completes a single future, with the results in request order, once every request has been signed.
+ */
+struct s_aws_sign_batch;
+
+struct s_aws_sign_batch_entry {
+    struct s_aws_sign_batch *batch;
+    struct aws_http_message *native_request;
+    struct aws_signable *signable;
+    struct aws_string *signature;
+    int error_code;
+};
+
+struct s_aws_sign_batch {
+    /* Owns the future, the signing configuration and the credentials sourced for the batch */
+    struct s_aws_sign_request_callback_data *shared;
+    jobjectArray java_requests;
+    struct aws_signing_config_aws signing_config;
+    struct s_aws_sign_batch_entry *entries;
+    size_t entry_count;
+    struct aws_atomic_var pending;
+    bool failed;
+    int error_code;
+};
+
+static void s_cleanup_sign_batch(struct s_aws_sign_batch *batch, JNIEnv *env) {
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
+
+    for (size_t i = 0; i < batch->entry_count; ++i) {
+        struct s_aws_sign_batch_entry *entry = &batch->entries[i];
+        if (entry->signable != NULL) {
+            aws_signable_destroy(entry->signable);
+        }
+        aws_http_message_release(entry->native_request);
+        aws_string_destroy(entry->signature);
+    }
+
+    if (batch->java_requests != NULL) {
+        (*env)->DeleteGlobalRef(env, batch->java_requests);
+    }
+
+    s_cleanup_callback_data(batch->shared, env);
+
+    if (batch->entries != NULL) {
+        aws_mem_release(allocator, batch->entries);
+    }
+    aws_mem_release(allocator, batch);
+}
+
+static jobject s_create_batch_signing_result(JNIEnv *env, struct s_aws_sign_batch_entry *entry, jobject java_request) {
+    jobject java_signed_request = s_create_signed_java_http_request(env, entry->native_request, java_request);
+    if (java_signed_request == NULL) {
+        return NULL;
+    }
+
+    jbyteArray java_signature = NULL;
+    if (entry->signature != NULL) {
+        struct aws_byte_cursor signature_cursor = aws_byte_cursor_from_string(entry->signature);
+        java_signature = aws_jni_byte_array_from_cursor(env, &signature_cursor);
+    }
+
+    jobject java_signing_result = (*env)->NewObject(
+        env, aws_signing_result_properties.aws_signing_result_class, aws_signing_result_properties.constructor);
+    if ((*env)->ExceptionCheck(env) || java_signing_result == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        aws_raise_error(AWS_ERROR_UNKNOWN);
+        java_signing_result = NULL;
+    } else {
+        (*env)->SetObjectField(
+            env, java_signing_result, aws_signing_result_properties.signed_request_field_id, java_signed_request);
+        (*env)->SetObjectField(
+            env, java_signing_result, aws_signing_result_properties.signature_field_id, java_signature);
+    }
+
+    if (java_signature != NULL) {
+        (*env)->DeleteLocalRef(env, java_signature);
+    }
+    (*env)->DeleteLocalRef(env, java_signed_request);
+
+    return java_signing_result;
+}
+
+static jobjectArray s_create_batch_signing_results(JNIEnv *env, struct s_aws_sign_batch *batch) {
+    jobjectArray java_results = (*env)->NewObjectArray(
+        env, (jsize)batch->entry_count, aws_signing_result_properties.aws_signing_result_class, NULL);
+    if (java_results == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        aws_raise_error(AWS_ERROR_UNKNOWN);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < batch->entry_count; ++i) {
+        jobject java_request = (*env)->GetObjectArrayElement(env, batch->java_requests, (jsize)i);
+        jobject java_signing_result = s_create_batch_signing_result(env, &batch->entries[i], java_request);
+        (*env)->DeleteLocalRef(env, java_request);
+        if (java_signing_result == NULL) {
+            (*env)->DeleteLocalRef(env, java_results);
+            return NULL;
+        }
+
+        (*env)->SetObjectArrayElement(env, java_results, (jsize)i, java_signing_result);
+        (*env)->DeleteLocalRef(env, java_signing_result);
+    }
+
+    return java_results;
+}
+
+static void s_complete_sign_batch(struct s_aws_sign_batch *batch) {
+    JavaVM *jvm = batch->shared->jvm;
+
+    /********** JNI ENV ACQUIRE **********/
+    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        return;
+    }
+
+    for (size_t i = 0; !batch->failed && i < batch->entry_count; ++i) {
+        if (batch->entries[i].error_code != AWS_ERROR_SUCCESS) {
+            batch->failed = true;
+            batch->error_code = batch->entries[i].error_code;
+        }
+    }
+
+    if (batch->failed) {
+        s_complete_signing_exceptionally(env, batch->shared, batch->error_code);
+        goto done;
+    }
+
+    jobjectArray java_results = s_create_batch_signing_results(env, batch);
+    if (java_results == NULL) {
+        s_complete_signing_exceptionally(env, batch->shared, aws_last_error());
+        goto done;
+    }
+
+    (*env)->CallBooleanMethod(
+        env, batch->shared->java_signing_result_future, completable_future_properties.complete_method_id, java_results);
+    AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
+
+    (*env)->DeleteLocalRef(env, java_results);
+
+done:
+
+    s_cleanup_sign_batch(batch, env);
+
+    aws_jni_release_thread_env(jvm, env);
+    /********** JNI ENV RELEASE **********/
+}
+
+static void s_sign_batch_entry_done(struct s_aws_sign_batch *batch) {
+    if (aws_atomic_fetch_sub(&batch->pending, 1) == 1) {
+        s_complete_sign_batch(batch);
+    }
+}
+
+static void s_aws_batch_request_signing_complete(struct aws_signing_result *result, int error_code, void *userdata) {
+    struct s_aws_sign_batch_entry *entry = userdata;
+
+    if (result == NULL || error_code != AWS_ERROR_SUCCESS) {
+        entry->error_code = error_code != AWS_ERROR_SUCCESS ? error_code : AWS_ERROR_UNKNOWN;
+    } else if (aws_apply_signing_result_to_http_request(entry->native_request, aws_jni_auth_allocator(), result)) {
+        entry->error_code = aws_last_error() != AWS_ERROR_SUCCESS ? aws_last_error() : AWS_ERROR_UNKNOWN;
+    } else {
+        /* Anonymous requests don't have a signature because they are not signed. */
+        struct aws_string *signature = NULL;
+        aws_signing_result_get_property(result, g_aws_signature_property_name, &signature);
+        if (signature != NULL) {
+            entry->signature = aws_string_new_from_string(aws_jni_auth_allocator(), signature);
+        }
+    }
+
+    s_sign_batch_entry_done(entry->batch);
+}
+
+static void s_sign_batch_requests(struct s_aws_sign_batch *batch) {
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
+    struct aws_signing_config_aws *config = &batch->signing_config;
+
+    if (config->algorithm == AWS_SIGNING_ALGORITHM_V4_ASYMMETRIC && config->credentials != NULL &&
+        !aws_credentials_is_anonymous(config->credentials) &&
+        aws_credentials_get_ecc_key_pair(config->credentials) == NULL) {
+
+        struct aws_credentials *ecc_credentials =
+            aws_credentials_new_ecc_from_aws_credentials(allocator, config->credentials);
+        if (ecc_credentials == NULL) {
+            batch->failed = true;
+            batch->error_code = aws_last_error();
+            s_complete_sign_batch(batch);
+            return;
+        }
+
+        aws_credentials_release(batch->shared->credentials);
+        batch->shared->credentials = ecc_credentials;
+        config->credentials = ecc_credentials;
+    }
+
+    /* One count per request, plus one held until every request has been started */
+    aws_atomic_init_int(&batch->pending, batch->entry_count + 1);
+
+    for (size_t i = 0; i < batch->entry_count; ++i) {
+        struct s_aws_sign_batch_entry *entry = &batch->entries[i];
+        if (aws_sign_request_aws(
+                allocator,
+                entry->signable,
+                (struct aws_signing_config_base *)config,
+                s_aws_batch_request_signing_complete,
+                entry)) {
+            entry->error_code = aws_last_error() != AWS_ERROR_SUCCESS ? aws_last_error() : AWS_ERROR_UNKNOWN;
+            s_sign_batch_entry_done(batch);
+        }
+    }
+
+    s_sign_batch_entry_done(batch);
+}
+
+static void s_on_sign_batch_credentials(struct aws_credentials *credentials, int error_code, void *user_data) {
+    struct s_aws_sign_batch *batch = user_data;
+
+    if (credentials == NULL || error_code != AWS_ERROR_SUCCESS) {
+        batch->failed = true;
+        batch->error_code = error_code;
+        s_complete_sign_batch(batch);
+        return;
+    }
+
+    batch->shared->credentials = aws_credentials_acquire(credentials);
+    batch->signing_config.credentials = credentials;
+    batch->signing_config.credentials_provider = NULL;
+
+    s_sign_batch_requests(batch);
+}
+
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_auth_signing_AwsSigner_awsSignerSignRequests(
+    JNIEnv *env,
+    jclass jni_class,
+    jobjectArray java_http_requests,
+    jobjectArray marshalled_requests,
+    jobject java_signing_config,
+    jobject java_signing_results_future) {
+
+    (void)jni_class;
+
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
+    struct s_aws_sign_batch *batch = aws_mem_calloc(allocator, 1, sizeof(struct s_aws_sign_batch));
+    batch->shared = aws_mem_calloc(allocator, 1, sizeof(struct s_aws_sign_request_callback_data));
+
+    jint jvmresult = (*env)->GetJavaVM(env, &batch->shared->jvm);
+    AWS_FATAL_ASSERT(jvmresult == 0);
+
+    batch->shared->java_signing_result_future = (*env)->NewGlobalRef(env, java_signing_results_future);
+    AWS_FATAL_ASSERT(batch->shared->java_signing_result_future != NULL);
+
+    batch->java_requests = (*env)->NewGlobalRef(env, java_http_requests);
+    AWS_FATAL_ASSERT(batch->java_requests != NULL);
+
+    if (s_build_signing_config(env, batch->shared, java_signing_config, &batch->signing_config)) {
+        aws_jni_throw_runtime_exception(env, "Failed to create signing configuration");
+        goto on_error;
+    }
+
+    jsize request_count = (*env)->GetArrayLength(env, java_http_requests);
+    if (request_count == 0 || request_count != (*env)->GetArrayLength(env, marshalled_requests)) {
+        aws_jni_throw_illegal_argument_exception(env, "AwsSigner.signRequests: invalid request batch");
+        goto on_error;
+    }
+
+    batch->entries = aws_mem_calloc(allocator, (size_t)request_count, sizeof(struct s_aws_sign_batch_entry));
+    batch->entry_count = (size_t)request_count;
+
+    for (jsize i = 0; i < request_count; ++i) {
+        struct s_aws_sign_batch_entry *entry = &batch->entries[i];
+        entry->batch = batch;
+
+        jobject java_http_request = (*env)->GetObjectArrayElement(env, java_http_requests, i);
+        jbyteArray marshalled_request = (*env)->GetObjectArrayElement(env, marshalled_requests, i);
+        jobject java_http_request_body_stream =
+            (*env)->GetObjectField(env, java_http_request, http_request_properties.body_stream_field_id);
+
+        entry->native_request =
+            aws_http_request_new_from_java_http_request(env, marshalled_request, java_http_request_body_stream);
+
+        (*env)->DeleteLocalRef(env, java_http_request_body_stream);
+        (*env)->DeleteLocalRef(env, marshalled_request);
+        (*env)->DeleteLocalRef(env, java_http_request);
+
+        if (entry->native_request == NULL) {
+            aws_jni_throw_runtime_exception(env, "Failed to create native http request from Java HttpRequest");
+            goto on_error;
+        }
+
+        entry->signable = aws_signable_new_http_request(allocator, entry->native_request);
+        if (entry->signable == NULL) {
+            aws_jni_throw_runtime_exception(env, "Failed to create signable from http request");
+            goto on_error;
+        }
+    }
+
+    /* Source credentials once here, instead of once per request inside aws_sign_request_aws() */
+    if (batch->signing_config.credentials == NULL && batch->signing_config.credentials_provider != NULL) {
+        if (aws_credentials_provider_get_credentials(
+                batch->signing_config.credentials_provider, s_on_sign_batch_credentials, batch)) {
+            aws_jni_throw_runtime_exception(env, "Failed to source credentials for the request batch");
+            goto on_error;
+        }
+        return;
+    }
+
+    s_sign_batch_requests(batch);
+    return;
+
+on_error:
+
+    s_cleanup_sign_batch(batch, env);
+}
+
 JNIEXPORT
 void JNICALL Java_software_amazon_awssdk_crt_auth_signing_AwsSigner_awsSignerSignChunk(
     JNIEnv *env,
@@ -452,7 +1001,7 @@ void JNICALL Java_software_amazon_awssdk_crt_auth_signing_AwsSigner_awsSignerSig
 
     (void)jni_class;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct s_aws_sign_request_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct s_aws_sign_request_callback_data));
     if (callback_data == NULL) {
@@ -471,7 +1020,7 @@ void JNICALL Java_software_amazon_awssdk_crt_auth_signing_AwsSigner_awsSignerSig
         AWS_FATAL_ASSERT(callback_data->java_original_chunk_body != NULL);
 
         callback_data->chunk_body_stream = aws_input_stream_new_from_java_http_request_body_stream(
-            aws_jni_get_allocator(), env, java_chunk_body_stream);
+            aws_jni_auth_allocator(), env, java_chunk_body_stream);
         if (callback_data->chunk_body_stream == NULL) {
             aws_jni_throw_runtime_exception(env, "Error building chunk body stream");
             goto on_error;
@@ -526,7 +1075,7 @@ void JNICALL Java_software_amazon_awssdk_crt_auth_signing_AwsSigner_awsSignerSig
 
     (void)jni_class;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct s_aws_sign_request_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct s_aws_sign_request_callback_data));
     /* we no longer worry about allocation failures */
@@ -601,7 +1150,7 @@ bool JNICALL Java_software_amazon_awssdk_crt_auth_signing_AwsSigningUtils_awsSig
     struct aws_string *pub_x = NULL;
     struct aws_string *pub_y = NULL;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct s_aws_sign_request_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct s_aws_sign_request_callback_data));
     if (callback_data == NULL) {
@@ -686,7 +1235,7 @@ bool JNICALL Java_software_amazon_awssdk_crt_auth_signing_AwsSigningUtils_awsSig
     (void)jni_class;
 
     bool success = false;
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
 
     struct aws_byte_cursor string_to_sign_cursor;
     AWS_ZERO_STRUCT(string_to_sign_cursor);
@@ -0,0 +1,367 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "callback_dispatcher.h"
+
+#include "crt.h"
+
+#include <aws/common/atomics.h>
+#include <aws/common/clock.h>
+#include <aws/common/condition_variable.h>
+#include <aws/common/mutex.h>
+#include <aws/common/thread.h>
+
+/* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(push)
+#        pragma warning(disable : 4305) /* 'type cast': truncation from 'jlong' to 'jni_tls_ctx_options *' */
+#    else
+#        pragma GCC diagnostic push
+#        pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
+#        pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+#    endif
+#endif
+
+struct aws_jni_dispatch_target {
+    struct aws_atomic_var ref_count;
+    jobject java_target;
+};
+
+struct aws_jni_dispatch_record {
+    /* next record in the queue, written by the producer that queued the next one */
+    struct aws_atomic_var next;
+    struct aws_jni_dispatch_target *target;
+    int32_t event_type;
+    struct aws_byte_buf payload;
+    /* payload bytes follow */
+};
+
+/*
+ * Records are queued on an intrusive multi-producer single-consumer queue (Vyukov's): producers swap themselves in
+ * as the head and then link the previous head to themselves, so submitting never takes a lock. Only the thread
+ * draining the queue touches tail. stub keeps the queue non-empty so there's always a node to link from.
+ *
+ * The consumer only sleeps on the condition variable once the queue is empty, and producers only take the lock to
+ * wake it when it says it's waiting, so under load nobody takes the lock at all.
+ */
+struct aws_jni_callback_dispatcher {
+    struct aws_allocator *allocator;
+    struct aws_atomic_var ref_count;
+
+    struct aws_atomic_var head;
+    struct aws_jni_dispatch_record *tail;
+    struct aws_jni_dispatch_record stub;
+
+    /* records submitted and not yet drained, counted before they're linked in so none are missed at shutdown */
+    struct aws_atomic_var queued_count;
+    struct aws_atomic_var closed;
+
+    struct aws_atomic_var consumer_waiting;
+    struct aws_mutex lock;
+    struct aws_condition_variable signal;
+
+    /* drained, but didn't fit in the last batch */
+    struct aws_jni_dispatch_record *pending;
+};
+
+struct aws_jni_dispatch_target *aws_jni_dispatch_target_new(JNIEnv *env, jobject java_target) {
+    struct aws_jni_dispatch_target *target =
+        aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct aws_jni_dispatch_target));
+    target->java_target = (*env)->NewGlobalRef(env, java_target);
+    if (target->java_target == NULL) {
+        aws_mem_release(aws_jni_get_allocator(), target);
+        aws_jni_throw_runtime_exception(env, "CallbackDispatcher: unable to create reference to dispatch target");
+        return NULL;
+    }
+    aws_atomic_init_int(&target->ref_count, 1);
+    return target;
+}
+
+struct aws_jni_dispatch_target *aws_jni_dispatch_target_acquire(struct aws_jni_dispatch_target *target) {
+    if (target != NULL) {
+        aws_atomic_fetch_add(&target->ref_count, 1);
+    }
+    return target;
+}
+
+void aws_jni_dispatch_target_release(struct aws_jni_dispatch_target *target, JNIEnv *env) {
+    if (target == NULL) {
+        return;
+    }
+    size_t pre_ref = aws_atomic_fetch_sub(&target->ref_count, 1);
+    AWS_ASSERT(pre_ref > 0 && "dispatch target refcount has gone negative");
+    if (pre_ref == 1) {
+        AWS_FATAL_ASSERT(env != NULL && "last reference to a dispatch target released without a JNIEnv");
+        (*env)->DeleteGlobalRef(env, target->java_target);
+        aws_mem_release(aws_jni_get_allocator(), target);
+    }
+}
+
+struct aws_jni_dispatch_record *aws_jni_dispatch_record_new(
+    struct aws_jni_dispatch_target *target,
+    int32_t event_type,
+    size_t payload_size) {
+    struct aws_jni_dispatch_record *record =
+        aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct aws_jni_dispatch_record) + payload_size);
+    aws_atomic_init_ptr(&record->next, NULL);
+    record->target = aws_jni_dispatch_target_acquire(target);
+    record->event_type = event_type;
+    record->payload = aws_byte_buf_from_empty_array((uint8_t *)(record + 1), payload_size);
+    return record;
+}
+
+struct aws_byte_buf *aws_jni_dispatch_record_payload(struct aws_jni_dispatch_record *record) {
+    return &record->payload;
+}
+
+void aws_jni_dispatch_record_destroy(struct aws_jni_dispatch_record *record, JNIEnv *env) {
+    if (record == NULL) {
+        return;
+    }
+    aws_jni_dispatch_target_release(record->target, env);
+    aws_mem_release(aws_jni_get_allocator(), record);
+}
+
+static void s_queue_push(struct aws_jni_callback_dispatcher *dispatcher, struct aws_jni_dispatch_record *record) {
+    aws_atomic_store_ptr(&record->next, NULL);
+    struct aws_jni_dispatch_record *prev = aws_atomic_exchange_ptr(&dispatcher->head, record);
+    aws_atomic_store_ptr(&prev->next, record);
+}
+
+/* Only called from the draining thread. NULL if the queue is empty, or a producer is halfway through linking. */
+static struct aws_jni_dispatch_record *s_queue_pop(struct aws_jni_callback_dispatcher *dispatcher) {
+    struct aws_jni_dispatch_record *tail = dispatcher->tail;
+    struct aws_jni_dispatch_record *next = aws_atomic_load_ptr(&tail->next);
+
+    if (tail == &dispatcher->stub) {
+        if (next == NULL) {
+            return NULL;
+        }
+        dispatcher->tail = next;
+        tail = next;
+        next = aws_atomic_load_ptr(&next->next);
+    }
+
+    if (next != NULL) {
+        dispatcher->tail = next;
+        return tail;
+    }
+
+    if (tail != aws_atomic_load_ptr(&dispatcher->head)) {
+        return NULL;
+    }
+
+    /* tail is the last record, put the stub back behind it so it can be handed out */
+    s_queue_push(dispatcher, &dispatcher->stub);
+    next = aws_atomic_load_ptr(&tail->next);
+    if (next != NULL) {
+        dispatcher->tail = next;
+        return tail;
+    }
+
+    return NULL;
+}
+
+int aws_jni_callback_dispatcher_submit(
+    struct aws_jni_callback_dispatcher *dispatcher,
+    struct aws_jni_dispatch_record *record) {
+
+    aws_atomic_fetch_add(&dispatcher->queued_count, 1);
+    if (aws_atomic_load_int(&dispatcher->closed)) {
+        aws_atomic_fetch_sub(&dispatcher->queued_count, 1);
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+
+    s_queue_push(dispatcher, record);
+
+    if (aws_atomic_load_int(&dispatcher->consumer_waiting)) {
+        aws_mutex_lock(&dispatcher->lock);
+        aws_condition_variable_notify_one(&dispatcher->signal);
+        aws_mutex_unlock(&dispatcher->lock);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+struct aws_jni_callback_dispatcher *aws_jni_callback_dispatcher_acquire(
+    struct aws_jni_callback_dispatcher *dispatcher) {
+    if (dispatcher != NULL) {
+        aws_atomic_fetch_add(&dispatcher->ref_count, 1);
+    }
+    return dispatcher;
+}
+
+void aws_jni_callback_dispatcher_release(struct aws_jni_callback_dispatcher *dispatcher, JNIEnv *env) {
+    if (dispatcher == NULL) {
+        return;
+    }
+    size_t pre_ref = aws_atomic_fetch_sub(&dispatcher->ref_count, 1);
+    AWS_ASSERT(pre_ref > 0 && "callback dispatcher refcount has gone negative");
+    if (pre_ref != 1) {
+        return;
+    }
+
+    /* nothing is draining any more, and nothing can submit */
+    aws_jni_dispatch_record_destroy(dispatcher->pending, env);
+    struct aws_jni_dispatch_record *record = NULL;
+    while ((record = s_queue_pop(dispatcher)) != NULL) {
+        if (record != &dispatcher->stub) {
+            aws_jni_dispatch_record_destroy(record, env);
+        }
+    }
+
+    aws_condition_variable_clean_up(&dispatcher->signal);
+    aws_mutex_clean_up(&dispatcher->lock);
+    aws_mem_release(dispatcher->allocator, dispatcher);
+}
+
+static bool s_has_queued_records(void *user_data) {
+    struct aws_jni_callback_dispatcher *dispatcher = user_data;
+    return aws_atomic_load_int(&dispatcher->queued_count) > 0 || aws_atomic_load_int(&dispatcher->closed);
+}
+
+JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_CallbackDispatcher_callbackDispatcherNew(
+    JNIEnv *env,
+    jclass jni_class) {
+    (void)env;
+    (void)jni_class;
+
+    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_jni_callback_dispatcher *dispatcher =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_jni_callback_dispatcher));
+    dispatcher->allocator = allocator;
+    aws_atomic_init_int(&dispatcher->ref_count, 1);
+    aws_atomic_init_ptr(&dispatcher->stub.next, NULL);
+    aws_atomic_init_ptr(&dispatcher->head, &dispatcher->stub);
+    dispatcher->tail = &dispatcher->stub;
+    aws_atomic_init_int(&dispatcher->queued_count, 0);
+    aws_atomic_init_int(&dispatcher->closed, 0);
+    aws_atomic_init_int(&dispatcher->consumer_waiting, 0);
+    AWS_FATAL_ASSERT(!aws_mutex_init(&dispatcher->lock));
+    AWS_FATAL_ASSERT(!aws_condition_variable_init(&dispatcher->signal));
+
+    return (jlong)dispatcher;
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_CallbackDispatcher_callbackDispatcherShutdown(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_dispatcher) {
+    (void)env;
+    (void)jni_class;
+
+    struct aws_jni_callback_dispatcher *dispatcher = (struct aws_jni_callback_dispatcher *)jni_dispatcher;
+    aws_atomic_store_int(&dispatcher->closed, 1);
+
+    aws_mutex_lock(&dispatcher->lock);
+    aws_condition_variable_notify_all(&dispatcher->signal);
+    aws_mutex_unlock(&dispatcher->lock);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_CallbackDispatcher_callbackDispatcherRelease(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_dispatcher) {
+    (void)jni_class;
+
+    aws_jni_callback_dispatcher_release((struct aws_jni_callback_dispatcher *)jni_dispatcher, env);
+}
+
+/*
+ * Copies queued records into buffer, each as [4-byte BE event type][4-byte BE payload length][payload], and their
+ * targets into targets. Waits up to wait_ms for the first one.
+ *
+ * Returns the number of records copied, 0 if there were none, -1 once the dispatcher is closed and empty, or
+ * -(size + 1) if the next record needs a buffer of at least size bytes.
+ */
+JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_CallbackDispatcher_callbackDispatcherDrain(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_dispatcher,
+    jobject jni_buffer,
+    jobjectArray jni_targets,
+    jlong wait_ms) {
+    (void)jni_class;
+
+    struct aws_jni_callback_dispatcher *dispatcher = (struct aws_jni_callback_dispatcher *)jni_dispatcher;
+
+    uint8_t *buffer_ptr = (*env)->GetDirectBufferAddress(env, jni_buffer);
+    jlong buffer_capacity = (*env)->GetDirectBufferCapacity(env, jni_buffer);
+    if (buffer_ptr == NULL || buffer_capacity < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "CallbackDispatcher: buffer must be a direct ByteBuffer");
+        return 0;
+    }
+    struct aws_byte_buf batch = aws_byte_buf_from_empty_array(buffer_ptr, (size_t)buffer_capacity);
+    size_t max_records = (size_t)(*env)->GetArrayLength(env, jni_targets);
+
+    if (dispatcher->pending == NULL && aws_atomic_load_int(&dispatcher->queued_count) == 0) {
+        if (aws_atomic_load_int(&dispatcher->closed)) {
+            return -1;
+        }
+        if (wait_ms > 0) {
+            aws_mutex_lock(&dispatcher->lock);
+            aws_atomic_store_int(&dispatcher->consumer_waiting, 1);
+            aws_condition_variable_wait_for_pred(
+                &dispatcher->signal,
+                &dispatcher->lock,
+                (int64_t)aws_timestamp_convert((uint64_t)wait_ms, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL),
+                s_has_queued_records,
+                dispatcher);
+            aws_atomic_store_int(&dispatcher->consumer_waiting, 0);
+            aws_mutex_unlock(&dispatcher->lock);
+        }
+    }
+
+    jint count = 0;
+    while ((size_t)count < max_records) {
+        struct aws_jni_dispatch_record *record = dispatcher->pending;
+        dispatcher->pending = NULL;
+        if (record == NULL) {
+            if (aws_atomic_load_int(&dispatcher->queued_count) == 0) {
+                break;
+            }
+            record = s_queue_pop(dispatcher);
+            if (record == NULL) {
+                /* a producer is still linking its record in, hand over what we have or try again */
+                if (count > 0) {
+                    break;
+                }
+                aws_thread_current_yield();
+                continue;
+            }
+            aws_atomic_fetch_sub(&dispatcher->queued_count, 1);
+        }
+
+        size_t record_size = 8 + record->payload.len;
+        if (batch.capacity - batch.len < record_size) {
+            dispatcher->pending = record;
+            if (count == 0) {
+                return -(jint)(record_size + 1);
+            }
+            break;
+        }
+
+        aws_byte_buf_write_be32(&batch, (uint32_t)record->event_type);
+        aws_byte_buf_write_be32(&batch, (uint32_t)record->payload.len);
+        struct aws_byte_cursor payload = aws_byte_cursor_from_buf(&record->payload);
+        aws_byte_buf_write_from_whole_cursor(&batch, payload);
+        (*env)->SetObjectArrayElement(env, jni_targets, count, record->target->java_target);
+        ++count;
+
+        /* the array holds the target now */
+        aws_jni_dispatch_record_destroy(record, env);
+    }
+
+    return count;
+}
+
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(pop)
+#    else
+#        pragma GCC diagnostic pop
+#    endif
+#endif
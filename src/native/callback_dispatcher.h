@@ -0,0 +1,53 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_CALLBACK_DISPATCHER_H
+#define AWS_JNI_CRT_CALLBACK_DISPATCHER_H
+
+#include <aws/common/byte_buf.h>
+
+#include <jni.h>
+
+/*
+ * Native side of CallbackDispatcher. Instead of calling into Java from the event loop, a binding builds a record of
+ * the event and submits it. Records are queued on a lock-free multi-producer queue, and CallbackDispatcher's thread
+ * drains them in batches, one JNI call per batch, so a slow Java handler never holds up the event loop.
+ *
+ * Every record goes to a dispatch target: a Java CallbackDispatcher.Target plus a ref count, so queued records keep
+ * it alive without creating a JNI global ref per event. Records for one target are delivered in submission order.
+ */
+struct aws_jni_callback_dispatcher;
+struct aws_jni_dispatch_target;
+struct aws_jni_dispatch_record;
+
+/* Returns the dispatcher behind a Java CallbackDispatcher's native handle, with a reference for the caller */
+struct aws_jni_callback_dispatcher *aws_jni_callback_dispatcher_acquire(struct aws_jni_callback_dispatcher *dispatcher);
+void aws_jni_callback_dispatcher_release(struct aws_jni_callback_dispatcher *dispatcher, JNIEnv *env);
+
+/* If this fails a java exception has been set */
+struct aws_jni_dispatch_target *aws_jni_dispatch_target_new(JNIEnv *env, jobject java_target);
+struct aws_jni_dispatch_target *aws_jni_dispatch_target_acquire(struct aws_jni_dispatch_target *target);
+void aws_jni_dispatch_target_release(struct aws_jni_dispatch_target *target, JNIEnv *env);
+
+/*
+ * Creates a record of type event_type for the target, with room for payload_size bytes. The caller writes the
+ * payload into the buffer returned by aws_jni_dispatch_record_payload(), then submits the record.
+ */
+struct aws_jni_dispatch_record *aws_jni_dispatch_record_new(
+    struct aws_jni_dispatch_target *target,
+    int32_t event_type,
+    size_t payload_size);
+struct aws_byte_buf *aws_jni_dispatch_record_payload(struct aws_jni_dispatch_record *record);
+void aws_jni_dispatch_record_destroy(struct aws_jni_dispatch_record *record, JNIEnv *env);
+
+/*
+ * Queues the record, taking ownership of it. Fails once the dispatcher has been closed, in which case the record is
+ * still the caller's, and the caller should deliver the event itself.
+ */
+int aws_jni_callback_dispatcher_submit(
+    struct aws_jni_callback_dispatcher *dispatcher,
+    struct aws_jni_dispatch_record *record);
+
+#endif /* AWS_JNI_CRT_CALLBACK_DISPATCHER_H */
@@ -5,28 +5,257 @@
 #include <jni.h>
 
 #include <aws/checksums/crc.h>
+#include <aws/common/thread.h>
 
+#include "checksums.h"
 #include "crt.h"
 
-jint crc_common(
+/* reflected polynomials */
+#define CRC32_POLYNOMIAL 0xEDB88320u
+#define CRC32C_POLYNOMIAL 0x82F63B78u
+#define CRC64NVME_POLYNOMIAL 0x9A6C9329AC4BC9B5ull
+
+/*
+ * Describes a reflected crc of up to 64 bits. Values are carried as uint64_t throughout, 32 bit crcs just leave the
+ * upper half zero.
+ */
+struct crc_algorithm {
+    uint64_t (*compute)(struct aws_byte_cursor data, uint64_t previous);
+    uint64_t polynomial;
+    int width;
+};
+
+static uint64_t s_crc32_compute(struct aws_byte_cursor data, uint64_t previous) {
+    uint32_t res = (uint32_t)previous;
+    while (data.len > INT_MAX) {
+        res = aws_checksums_crc32(data.ptr, INT_MAX, res);
+        aws_byte_cursor_advance(&data, INT_MAX);
+    }
+    return aws_checksums_crc32(data.ptr, (int)data.len, res);
+}
+
+static uint64_t s_crc32c_compute(struct aws_byte_cursor data, uint64_t previous) {
+    uint32_t res = (uint32_t)previous;
+    while (data.len > INT_MAX) {
+        res = aws_checksums_crc32c(data.ptr, INT_MAX, res);
+        aws_byte_cursor_advance(&data, INT_MAX);
+    }
+    return aws_checksums_crc32c(data.ptr, (int)data.len, res);
+}
+
+static uint64_t s_crc64nvme_compute(struct aws_byte_cursor data, uint64_t previous) {
+    return aws_jni_crc64nvme(data.ptr, data.len, previous);
+}
+
+static const struct crc_algorithm s_crc32 = {
+    .compute = s_crc32_compute,
+    .polynomial = CRC32_POLYNOMIAL,
+    .width = 32,
+};
+
+static const struct crc_algorithm s_crc32c = {
+    .compute = s_crc32c_compute,
+    .polynomial = CRC32C_POLYNOMIAL,
+    .width = 32,
+};
+
+static const struct crc_algorithm s_crc64nvme = {
+    .compute = s_crc64nvme_compute,
+    .polynomial = CRC64NVME_POLYNOMIAL,
+    .width = 64,
+};
+
+/*
+ * CRC64NVME, slicing-by-8: eight bytes are folded per step using eight 256-entry tables, table[k] giving the
+ * effect of a byte followed by k zero bytes. Tables are built once, on first use.
+ */
+static uint64_t s_crc64nvme_table[8][256];
+static aws_thread_once s_crc64nvme_table_once = AWS_THREAD_ONCE_STATIC_INIT;
+
+static void s_crc64nvme_init_table(void *user_data) {
+    (void)user_data;
+    for (int i = 0; i < 256; i++) {
+        uint64_t crc = (uint64_t)i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC64NVME_POLYNOMIAL : crc >> 1;
+        }
+        s_crc64nvme_table[0][i] = crc;
+    }
+    for (int i = 0; i < 256; i++) {
+        for (int k = 1; k < 8; k++) {
+            uint64_t prev = s_crc64nvme_table[k - 1][i];
+            s_crc64nvme_table[k][i] = (prev >> 8) ^ s_crc64nvme_table[0][prev & 0xff];
+        }
+    }
+}
+
+uint64_t aws_jni_crc64nvme(const uint8_t *input, size_t length, uint64_t previous) {
+    aws_thread_call_once(&s_crc64nvme_table_once, s_crc64nvme_init_table, NULL);
+
+    uint64_t crc = ~previous;
+    while (length >= 8) {
+        /* assembled byte by byte, as input may be unaligned and the host may be big endian */
+        uint64_t word = (uint64_t)input[0] | ((uint64_t)input[1] << 8) | ((uint64_t)input[2] << 16) |
+                        ((uint64_t)input[3] << 24) | ((uint64_t)input[4] << 32) | ((uint64_t)input[5] << 40) |
+                        ((uint64_t)input[6] << 48) | ((uint64_t)input[7] << 56);
+        crc ^= word;
+        crc = s_crc64nvme_table[7][crc & 0xff] ^ s_crc64nvme_table[6][(crc >> 8) & 0xff] ^
+              s_crc64nvme_table[5][(crc >> 16) & 0xff] ^ s_crc64nvme_table[4][(crc >> 24) & 0xff] ^
+              s_crc64nvme_table[3][(crc >> 32) & 0xff] ^ s_crc64nvme_table[2][(crc >> 40) & 0xff] ^
+              s_crc64nvme_table[1][(crc >> 48) & 0xff] ^ s_crc64nvme_table[0][crc >> 56];
+        input += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        crc = s_crc64nvme_table[0][(crc ^ *input) & 0xff] ^ (crc >> 8);
+        input++;
+        length--;
+    }
+    return ~crc;
+}
+
+/*
+ * Checksums a slice of a heap array. The array is accessed inside a critical region so the JVM hands us its
+ * storage directly rather than copying the whole array, and only the requested slice is read.
+ * Nothing in the critical region may call back into the JVM.
+ */
+static uint64_t s_crc_array(
     JNIEnv *env,
     jbyteArray input,
-    jint previous,
-    const size_t start,
-    size_t length,
-    uint32_t (*checksum_fn)(const uint8_t *, int, uint32_t)) {
-    struct aws_byte_cursor c_byte_array = aws_jni_byte_cursor_from_jbyteArray_acquire(env, input);
-    struct aws_byte_cursor cursor = c_byte_array;
-    aws_byte_cursor_advance(&cursor, start);
-    cursor.len = aws_min_size(length, cursor.len);
-    uint32_t res = (uint32_t)previous;
-    while (cursor.len > INT_MAX) {
-        res = checksum_fn(cursor.ptr, INT_MAX, res);
-        aws_byte_cursor_advance(&cursor, INT_MAX);
+    uint64_t previous,
+    jint offset,
+    jint length,
+    const struct crc_algorithm *algorithm) {
+    if (input == NULL) {
+        aws_jni_throw_null_pointer_exception(env, "byte[] is null");
+        return previous;
+    }
+
+    jsize array_length = (*env)->GetArrayLength(env, input);
+    if (offset < 0 || length < 0 || offset > array_length) {
+        aws_jni_throw_illegal_argument_exception(env, "crc range is out of bounds");
+        return previous;
+    }
+    size_t slice_length = aws_min_size((size_t)length, (size_t)(array_length - offset));
+    if (slice_length == 0) {
+        return previous;
+    }
+
+    uint8_t *bytes = (*env)->GetPrimitiveArrayCritical(env, input, NULL);
+    if (bytes == NULL) {
+        /* GetPrimitiveArrayCritical() has thrown exception */
+        return previous;
+    }
+
+    uint64_t res = algorithm->compute(aws_byte_cursor_from_array(bytes + offset, slice_length), previous);
+    (*env)->ReleasePrimitiveArrayCritical(env, input, bytes, JNI_ABORT);
+    return res;
+}
+
+/* Checksums a slice of a direct ByteBuffer in place, without pinning or copying anything */
+static uint64_t s_crc_direct(
+    JNIEnv *env,
+    jobject input,
+    uint64_t previous,
+    jint position,
+    jint length,
+    const struct crc_algorithm *algorithm) {
+    if (input == NULL) {
+        aws_jni_throw_null_pointer_exception(env, "ByteBuffer is null");
+        return previous;
+    }
+
+    uint8_t *address = (*env)->GetDirectBufferAddress(env, input);
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, input);
+    if (address == NULL || capacity < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "ByteBuffer is not direct");
+        return previous;
+    }
+
+    if (position < 0 || length < 0 || (jlong)position + (jlong)length > capacity) {
+        aws_jni_throw_illegal_argument_exception(env, "crc range is out of bounds");
+        return previous;
+    }
+
+    return algorithm->compute(aws_byte_cursor_from_array(address + position, (size_t)length), previous);
+}
+
+static uint64_t s_gf2_matrix_times(const uint64_t *mat, uint64_t vec) {
+    uint64_t sum = 0;
+    while (vec) {
+        if (vec & 1) {
+            sum ^= *mat;
+        }
+        vec >>= 1;
+        mat++;
+    }
+    return sum;
+}
+
+static void s_gf2_matrix_square(uint64_t *square, const uint64_t *mat, int width) {
+    for (int n = 0; n < width; n++) {
+        square[n] = s_gf2_matrix_times(mat, mat[n]);
+    }
+}
+
+/*
+ * Returns the crc of A followed by B, given only crc(A), crc(B), and the length of B, without touching the data.
+ * Applies len_b zero bytes to crc_a by repeated squaring of the "append one zero bit" operator over GF(2),
+ * so it costs O(log(len_b)) rather than O(len_b).
+ */
+static uint64_t s_crc_combine(uint64_t crc_a, uint64_t crc_b, uint64_t len_b, const struct crc_algorithm *algorithm) {
+    if (len_b == 0) {
+        return crc_a;
+    }
+
+    int width = algorithm->width;
+    uint64_t even[64]; /* even-power-of-two zeros operator */
+    uint64_t odd[64];  /* odd-power-of-two zeros operator */
+
+    /* operator for one zero bit */
+    odd[0] = algorithm->polynomial;
+    uint64_t row = 1;
+    for (int n = 1; n < width; n++) {
+        odd[n] = row;
+        row <<= 1;
+    }
+
+    /* operator for two zero bits, then four */
+    s_gf2_matrix_square(even, odd, width);
+    s_gf2_matrix_square(odd, even, width);
+
+    /* apply len_b zero bytes, the first square below gives the operator for one zero byte */
+    do {
+        s_gf2_matrix_square(even, odd, width);
+        if (len_b & 1) {
+            crc_a = s_gf2_matrix_times(even, crc_a);
+        }
+        len_b >>= 1;
+        if (len_b == 0) {
+            break;
+        }
+
+        s_gf2_matrix_square(odd, even, width);
+        if (len_b & 1) {
+            crc_a = s_gf2_matrix_times(odd, crc_a);
+        }
+        len_b >>= 1;
+    } while (len_b != 0);
+
+    return crc_a ^ crc_b;
+}
+
+static uint64_t s_crc_combine_checked(
+    JNIEnv *env,
+    uint64_t crc_a,
+    uint64_t crc_b,
+    jlong length_b,
+    const struct crc_algorithm *algorithm) {
+    if (length_b < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "crc length must not be negative");
+        return crc_a;
     }
-    jint res_signed = (jint)checksum_fn(cursor.ptr, (int)cursor.len, res);
-    aws_jni_byte_cursor_from_jbyteArray_release(env, input, c_byte_array);
-    return res_signed;
+    return s_crc_combine(crc_a, crc_b, (uint64_t)length_b, algorithm);
 }
 
 JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32_crc32(
@@ -37,7 +266,28 @@ JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32_crc32(
     jint offset,
     jint length) {
     (void)jni_class;
-    return crc_common(env, input, previous, offset, length, aws_checksums_crc32);
+    return (jint)s_crc_array(env, input, (uint32_t)previous, offset, length, &s_crc32);
+}
+
+JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32_crc32Direct(
+    JNIEnv *env,
+    jclass jni_class,
+    jobject input,
+    jint previous,
+    jint position,
+    jint length) {
+    (void)jni_class;
+    return (jint)s_crc_direct(env, input, (uint32_t)previous, position, length, &s_crc32);
+}
+
+JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32_crc32Combine(
+    JNIEnv *env,
+    jclass jni_class,
+    jint crc_a,
+    jint crc_b,
+    jlong length_b) {
+    (void)jni_class;
+    return (jint)s_crc_combine_checked(env, (uint32_t)crc_a, (uint32_t)crc_b, length_b, &s_crc32);
 }
 
 JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32C_crc32c(
@@ -48,5 +298,58 @@ JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32C_crc32c(
     jint offset,
     jint length) {
     (void)jni_class;
-    return crc_common(env, input, previous, offset, length, aws_checksums_crc32c);
+    return (jint)s_crc_array(env, input, (uint32_t)previous, offset, length, &s_crc32c);
+}
+
+JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32C_crc32cDirect(
+    JNIEnv *env,
+    jclass jni_class,
+    jobject input,
+    jint previous,
+    jint position,
+    jint length) {
+    (void)jni_class;
+    return (jint)s_crc_direct(env, input, (uint32_t)previous, position, length, &s_crc32c);
+}
+
+JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_checksums_CRC32C_crc32cCombine(
+    JNIEnv *env,
+    jclass jni_class,
+    jint crc_a,
+    jint crc_b,
+    jlong length_b) {
+    (void)jni_class;
+    return (jint)s_crc_combine_checked(env, (uint32_t)crc_a, (uint32_t)crc_b, length_b, &s_crc32c);
+}
+
+JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_checksums_CRC64NVME_crc64nvme(
+    JNIEnv *env,
+    jclass jni_class,
+    jbyteArray input,
+    jlong previous,
+    jint offset,
+    jint length) {
+    (void)jni_class;
+    return (jlong)s_crc_array(env, input, (uint64_t)previous, offset, length, &s_crc64nvme);
+}
+
+JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_checksums_CRC64NVME_crc64nvmeDirect(
+    JNIEnv *env,
+    jclass jni_class,
+    jobject input,
+    jlong previous,
+    jint position,
+    jint length) {
+    (void)jni_class;
+    return (jlong)s_crc_direct(env, input, (uint64_t)previous, position, length, &s_crc64nvme);
+}
+
+JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_checksums_CRC64NVME_crc64nvmeCombine(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong crc_a,
+    jlong crc_b,
+    jlong length_b) {
+    (void)jni_class;
+    return (jlong)s_crc_combine_checked(env, (uint64_t)crc_a, (uint64_t)crc_b, length_b, &s_crc64nvme);
 }
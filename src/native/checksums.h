@@ -0,0 +1,18 @@
+#ifndef AWS_JNI_CRT_CHECKSUMS_H
+#define AWS_JNI_CRT_CHECKSUMS_H
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/common/common.h>
+
+/**
+ * Computes the CRC64NVME of input, continuing from previous (0 for a new checksum).
+ * Same conventions as aws_checksums_crc32(), which the aws-checksums version we build against lacks a
+ * CRC64 counterpart for.
+ */
+uint64_t aws_jni_crc64nvme(const uint8_t *input, size_t length, uint64_t previous);
+
+#endif /* AWS_JNI_CRT_CHECKSUMS_H */
@@ -8,6 +8,7 @@
 #include <aws/io/channel_bootstrap.h>
 
 #include "crt.h"
+#include "host_resolver.h"
 #include "java_class_ids.h"
 
 #if _MSC_VER
@@ -40,7 +41,7 @@ static void s_shutdown_callback_data_destroy(JNIEnv *env, struct shutdown_callba
         (*env)->DeleteWeakGlobalRef(env, callback_data->java_client_bootstrap);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), callback_data);
+    aws_mem_release(aws_jni_io_allocator(), callback_data);
 }
 
 static void s_client_bootstrap_shutdown_complete(void *user_data) {
@@ -76,7 +77,7 @@ jlong JNICALL Java_software_amazon_awssdk_crt_io_ClientBootstrap_clientBootstrap
     jlong jni_hr) {
     (void)jni_class;
     struct aws_event_loop_group *elg = (struct aws_event_loop_group *)jni_elg;
-    struct aws_host_resolver *resolver = (struct aws_host_resolver *)jni_hr;
+    struct aws_jni_host_resolver *resolver = (struct aws_jni_host_resolver *)jni_hr;
 
     if (!elg) {
         aws_jni_throw_runtime_exception(env, "ClientBootstrap.client_bootstrap_new: Invalid EventLoopGroup");
@@ -88,7 +89,7 @@ jlong JNICALL Java_software_amazon_awssdk_crt_io_ClientBootstrap_clientBootstrap
         return (jlong)NULL;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
 
     struct shutdown_callback_data *callback_data = aws_mem_calloc(allocator, 1, sizeof(struct shutdown_callback_data));
     if (!callback_data) {
@@ -110,7 +111,8 @@ jlong JNICALL Java_software_amazon_awssdk_crt_io_ClientBootstrap_clientBootstrap
 
     struct aws_client_bootstrap_options bootstrap_options = {
         .event_loop_group = elg,
-        .host_resolver = resolver,
+        .host_resolver = resolver->resolver,
+        .host_resolution_config = &resolver->resolution_config,
         .on_shutdown_complete = s_client_bootstrap_shutdown_complete,
         .user_data = callback_data,
     };
@@ -33,7 +33,7 @@ struct aws_credentials *aws_credentials_new_from_java_credentials(JNIEnv *env, j
         (*env)->GetObjectField(env, java_credentials, credentials_properties.session_token_field_id);
 
     if (access_key_id == NULL && secret_access_key == NULL) {
-        return aws_credentials_new_anonymous(aws_jni_get_allocator());
+        return aws_credentials_new_anonymous(aws_jni_auth_allocator());
     }
 
     if (access_key_id == NULL || secret_access_key == NULL) {
@@ -58,7 +58,7 @@ struct aws_credentials *aws_credentials_new_from_java_credentials(JNIEnv *env, j
     }
 
     credentials = aws_credentials_new(
-        aws_jni_get_allocator(), access_key_id_cursor, secret_access_key_cursor, session_token_cursor, UINT64_MAX);
+        aws_jni_auth_allocator(), access_key_id_cursor, secret_access_key_cursor, session_token_cursor, UINT64_MAX);
 
     aws_jni_byte_cursor_from_jbyteArray_release(env, access_key_id, access_key_id_cursor);
     aws_jni_byte_cursor_from_jbyteArray_release(env, secret_access_key, secret_access_key_cursor);
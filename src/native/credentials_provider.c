@@ -4,8 +4,10 @@
  */
 
 #include "crt.h"
+#include "credentials_refresh_ahead.h"
 #include "http_connection_manager.h"
 #include "java_class_ids.h"
+#include "tls_handshake_metrics.h"
 
 #include <jni.h>
 #include <string.h>
@@ -72,7 +74,7 @@ static void s_on_shutdown_complete(void *user_data) {
         AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     // We're done with this callback data, clean it up.
 
     JavaVM *jvm = callback_data->jvm;
@@ -93,7 +95,7 @@ JNIEXPORT jlong JNICALL
 
     (void)jni_class;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
 
     struct aws_credentials_provider_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_credentials_provider_callback_data));
@@ -140,7 +142,7 @@ JNIEXPORT jlong JNICALL
     (void)jni_class;
     (void)env;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct aws_credentials_provider_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_credentials_provider_callback_data));
     callback_data->java_crt_credentials_provider = (*env)->NewWeakGlobalRef(env, java_crt_credentials_provider);
@@ -179,7 +181,7 @@ JNIEXPORT jlong JNICALL
     (void)jni_class;
     (void)env;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct aws_credentials_provider_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_credentials_provider_callback_data));
     callback_data->java_crt_credentials_provider = (*env)->NewWeakGlobalRef(env, java_crt_credentials_provider);
@@ -245,7 +247,7 @@ JNIEXPORT jlong JNICALL
     (void)jni_class;
     (void)env;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct aws_credentials_provider_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_credentials_provider_callback_data));
     callback_data->java_crt_credentials_provider = (*env)->NewWeakGlobalRef(env, java_crt_credentials_provider);
@@ -310,7 +312,7 @@ JNIEXPORT jlong JNICALL
     (void)jni_class;
     (void)env;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct aws_credentials_provider_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_credentials_provider_callback_data));
     callback_data->java_crt_credentials_provider = (*env)->NewWeakGlobalRef(env, java_crt_credentials_provider);
@@ -368,7 +370,7 @@ JNIEXPORT jlong JNICALL
     (void)jni_class;
     (void)env;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct aws_credentials_provider_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_credentials_provider_callback_data));
     callback_data->java_crt_credentials_provider = (*env)->NewWeakGlobalRef(env, java_crt_credentials_provider);
@@ -415,7 +417,7 @@ JNIEXPORT jlong JNICALL
     (void)jni_class;
     (void)env;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct aws_credentials_provider_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_credentials_provider_callback_data));
     callback_data->java_crt_credentials_provider = (*env)->NewWeakGlobalRef(env, java_crt_credentials_provider);
@@ -425,7 +427,7 @@ JNIEXPORT jlong JNICALL
 
     struct aws_tls_connection_options tls_connection_options;
     AWS_ZERO_STRUCT(tls_connection_options);
-    aws_tls_connection_options_init_from_ctx(&tls_connection_options, (struct aws_tls_ctx *)tls_context_handle);
+    aws_jni_tls_connection_options_init_from_ctx(&tls_connection_options, (struct aws_tls_ctx *)tls_context_handle);
 
     struct aws_credentials_provider_x509_options options;
     AWS_ZERO_STRUCT(options);
@@ -484,6 +486,7 @@ JNIEXPORT jlong JNICALL
         jclass jni_class,
         jobject java_crt_credentials_provider,
         jint cached_duration_in_seconds,
+        jint refresh_ahead_in_seconds,
         jlong native_cached_provider) {
 
     (void)jni_class;
@@ -494,7 +497,7 @@ JNIEXPORT jlong JNICALL
         return 0;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
 
     struct aws_credentials_provider_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_credentials_provider_callback_data));
@@ -503,16 +506,33 @@ JNIEXPORT jlong JNICALL
     jint jvmresult = (*env)->GetJavaVM(env, &callback_data->jvm);
     AWS_FATAL_ASSERT(jvmresult == 0);
 
-    struct aws_credentials_provider_cached_options options;
-    AWS_ZERO_STRUCT(options);
-    options.refresh_time_in_milliseconds =
-        aws_timestamp_convert(cached_duration_in_seconds, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_MILLIS, NULL);
-    options.source = (struct aws_credentials_provider *)native_cached_provider;
+    struct aws_credentials_provider *provider = NULL;
+    if (refresh_ahead_in_seconds > 0) {
+        struct aws_jni_credentials_refresh_ahead_options options;
+        AWS_ZERO_STRUCT(options);
+        options.source = (struct aws_credentials_provider *)native_cached_provider;
+        options.caching_duration_ms =
+            aws_timestamp_convert(cached_duration_in_seconds, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_MILLIS, NULL);
+        options.refresh_ahead_ms =
+            aws_timestamp_convert(refresh_ahead_in_seconds, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_MILLIS, NULL);
+
+        options.shutdown_options.shutdown_callback = s_on_shutdown_complete;
+        options.shutdown_options.shutdown_user_data = callback_data;
+
+        provider = aws_jni_credentials_provider_new_refresh_ahead(allocator, &options);
+    } else {
+        struct aws_credentials_provider_cached_options options;
+        AWS_ZERO_STRUCT(options);
+        options.refresh_time_in_milliseconds =
+            aws_timestamp_convert(cached_duration_in_seconds, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_MILLIS, NULL);
+        options.source = (struct aws_credentials_provider *)native_cached_provider;
 
-    options.shutdown_options.shutdown_callback = s_on_shutdown_complete;
-    options.shutdown_options.shutdown_user_data = callback_data;
+        options.shutdown_options.shutdown_callback = s_on_shutdown_complete;
+        options.shutdown_options.shutdown_user_data = callback_data;
+
+        provider = aws_credentials_provider_new_cached(allocator, &options);
+    }
 
-    struct aws_credentials_provider *provider = aws_credentials_provider_new_cached(allocator, &options);
     if (provider == NULL) {
         s_callback_data_clean_up(env, allocator, callback_data);
         aws_jni_throw_runtime_exception(env, "Failed to create cached credentials provider");
@@ -529,7 +549,7 @@ static int s_credentials_provider_delegate_get_credentials(
     void *callback_user_data) {
 
     struct aws_credentials_provider_callback_data *callback_data = delegate_user_data;
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
 
     int return_value = AWS_OP_ERR;
 
@@ -629,7 +649,7 @@ JNIEXPORT jlong JNICALL
     (void)jni_class;
     (void)env;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct aws_credentials_provider_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_credentials_provider_callback_data));
     callback_data->java_crt_credentials_provider = (*env)->NewWeakGlobalRef(env, java_crt_credentials_provider);
@@ -709,7 +729,7 @@ jlong JNICALL Java_software_amazon_awssdk_crt_auth_credentials_CognitoCredential
     (void)jni_class;
     (void)env;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct aws_credentials_provider *provider = NULL;
     struct aws_credentials_provider_callback_data *callback_data = NULL;
 
@@ -849,7 +869,7 @@ static void s_cp_callback_data_clean_up(
     aws_credentials_provider_release(callback_data->provider);
 
     // We're done with this callback data, free it.
-    aws_mem_release(aws_jni_get_allocator(), callback_data);
+    aws_mem_release(aws_jni_auth_allocator(), callback_data);
 }
 
 static void s_on_get_credentials_callback(struct aws_credentials *credentials, int error_code, void *user_data) {
@@ -949,7 +969,7 @@ void JNICALL Java_software_amazon_awssdk_crt_auth_credentials_CredentialsProvide
         return;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_auth_allocator();
     struct aws_credentials_provider_get_credentials_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_credentials_provider_get_credentials_callback_data));
     callback_data->java_crt_credentials_provider = (*env)->NewGlobalRef(env, java_crt_credentials_provider);
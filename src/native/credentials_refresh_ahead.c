@@ -0,0 +1,279 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "credentials_refresh_ahead.h"
+
+#include <aws/auth/auth.h>
+#include <aws/common/clock.h>
+#include <aws/common/linked_list.h>
+#include <aws/common/logging.h>
+#include <aws/common/math.h>
+#include <aws/common/mutex.h>
+#include <aws/common/ref_count.h>
+#include <aws/common/thread.h>
+
+/* A failed background refresh is retried after this, doubling with each failure in a row up to the max */
+#define REFRESH_AHEAD_RETRY_BASE_SECS 1
+#define REFRESH_AHEAD_RETRY_MAX_SECS 60
+
+struct refresh_ahead_waiter {
+    struct aws_linked_list_node node;
+    aws_on_get_credentials_callback_fn *callback;
+    void *user_data;
+};
+
+struct refresh_ahead_impl {
+    struct aws_allocator *allocator;
+    /* held by the provider, and by each fetch in flight */
+    struct aws_ref_count ref_count;
+    struct aws_credentials_provider *source;
+    uint64_t caching_duration_ns;
+    uint64_t refresh_ahead_ns;
+    struct aws_credentials_provider_shutdown_options shutdown_options;
+
+    struct aws_mutex lock;
+    /* the fields below are guarded by lock */
+    struct aws_credentials *credentials;
+    /* high res clock */
+    uint64_t expires_at_ns;
+    bool fetch_in_flight;
+    /* no background refresh starts before this, after a failed fetch */
+    uint64_t next_refresh_at_ns;
+    uint32_t consecutive_failures;
+    /* struct refresh_ahead_waiter, waiting on the fetch in flight */
+    struct aws_linked_list waiters;
+};
+
+static void s_refresh_ahead_impl_destroy(void *user_data) {
+    struct refresh_ahead_impl *impl = user_data;
+
+    AWS_FATAL_ASSERT(aws_linked_list_empty(&impl->waiters));
+
+    aws_credentials_release(impl->credentials);
+    aws_credentials_provider_release(impl->source);
+    aws_mutex_clean_up(&impl->lock);
+
+    struct aws_credentials_provider_shutdown_options shutdown_options = impl->shutdown_options;
+    aws_mem_release(impl->allocator, impl);
+
+    if (shutdown_options.shutdown_callback != NULL) {
+        shutdown_options.shutdown_callback(shutdown_options.shutdown_user_data);
+    }
+}
+
+static uint64_t s_compute_expires_at(
+    const struct refresh_ahead_impl *impl,
+    const struct aws_credentials *credentials,
+    uint64_t now_ns) {
+
+    uint64_t expires_at_ns = UINT64_MAX;
+    if (impl->caching_duration_ns > 0) {
+        expires_at_ns = aws_add_u64_saturating(now_ns, impl->caching_duration_ns);
+    }
+
+    uint64_t expiration_seconds = aws_credentials_get_expiration_timepoint_seconds(credentials);
+    if (expiration_seconds != UINT64_MAX) {
+        /* The expiration is wall clock time; the cache runs on the monotonic clock */
+        uint64_t wall_now_ns = 0;
+        aws_sys_clock_get_ticks(&wall_now_ns);
+        uint64_t expiration_ns =
+            aws_timestamp_convert(expiration_seconds, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL);
+        uint64_t remaining_ns = expiration_ns > wall_now_ns ? expiration_ns - wall_now_ns : 0;
+        uint64_t credentials_expire_at_ns = aws_add_u64_saturating(now_ns, remaining_ns);
+        if (credentials_expire_at_ns < expires_at_ns) {
+            expires_at_ns = credentials_expire_at_ns;
+        }
+    }
+
+    return expires_at_ns;
+}
+
+static void s_on_source_credentials(struct aws_credentials *credentials, int error_code, void *user_data) {
+    struct refresh_ahead_impl *impl = user_data;
+
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+
+    struct aws_linked_list waiters;
+    aws_linked_list_init(&waiters);
+    struct aws_credentials *usable_credentials = NULL;
+
+    aws_mutex_lock(&impl->lock);
+    if (credentials != NULL && error_code == AWS_ERROR_SUCCESS) {
+        aws_credentials_release(impl->credentials);
+        impl->credentials = aws_credentials_acquire(credentials);
+        impl->expires_at_ns = s_compute_expires_at(impl, credentials, now_ns);
+        impl->next_refresh_at_ns = 0;
+        impl->consecutive_failures = 0;
+    } else {
+        uint64_t retry_secs = REFRESH_AHEAD_RETRY_BASE_SECS;
+        for (uint32_t i = 0; i < impl->consecutive_failures && retry_secs < REFRESH_AHEAD_RETRY_MAX_SECS; ++i) {
+            retry_secs *= 2;
+        }
+        retry_secs = aws_min_u64(retry_secs, REFRESH_AHEAD_RETRY_MAX_SECS);
+        impl->consecutive_failures++;
+        impl->next_refresh_at_ns = aws_add_u64_saturating(
+            now_ns, aws_timestamp_convert(retry_secs, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL));
+        AWS_LOGF_WARN(
+            AWS_LS_AUTH_CREDENTIALS_PROVIDER,
+            "id=%p: refresh-ahead credentials fetch failed with error %d (%s), next refresh in %llu seconds",
+            (void *)impl,
+            error_code,
+            aws_error_str(error_code),
+            (unsigned long long)retry_secs);
+    }
+
+    /* If the fetch failed, whatever is still cached and unexpired serves the waiters */
+    if (impl->credentials != NULL && now_ns < impl->expires_at_ns) {
+        usable_credentials = aws_credentials_acquire(impl->credentials);
+    }
+    impl->fetch_in_flight = false;
+    aws_linked_list_swap_contents(&waiters, &impl->waiters);
+    aws_mutex_unlock(&impl->lock);
+
+    if (usable_credentials == NULL && error_code == AWS_ERROR_SUCCESS) {
+        error_code = AWS_ERROR_UNKNOWN;
+    }
+
+    while (!aws_linked_list_empty(&waiters)) {
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(&waiters);
+        struct refresh_ahead_waiter *waiter = AWS_CONTAINER_OF(node, struct refresh_ahead_waiter, node);
+        waiter->callback(
+            usable_credentials, usable_credentials != NULL ? AWS_ERROR_SUCCESS : error_code, waiter->user_data);
+        aws_mem_release(impl->allocator, waiter);
+    }
+
+    aws_credentials_release(usable_credentials);
+    aws_ref_count_release(&impl->ref_count);
+}
+
+static void s_fetch(struct refresh_ahead_impl *impl) {
+    aws_ref_count_acquire(&impl->ref_count);
+    if (aws_credentials_provider_get_credentials(impl->source, s_on_source_credentials, impl)) {
+        s_on_source_credentials(NULL, aws_last_error(), impl);
+    }
+}
+
+static void s_refresh_thread_fn(void *arg) {
+    struct refresh_ahead_impl *impl = arg;
+
+    s_fetch(impl);
+    aws_ref_count_release(&impl->ref_count);
+}
+
+static void s_start_background_refresh(struct refresh_ahead_impl *impl) {
+    aws_ref_count_acquire(&impl->ref_count);
+
+    struct aws_thread refresh_thread;
+    aws_thread_init(&refresh_thread, impl->allocator);
+
+    struct aws_thread_options thread_options = *aws_default_thread_options();
+    thread_options.join_strategy = AWS_TJS_MANAGED;
+    thread_options.name = aws_byte_cursor_from_c_str("AwsCredsRefresh");
+
+    if (aws_thread_launch(&refresh_thread, s_refresh_thread_fn, impl, &thread_options)) {
+        /* Refreshing on this thread beats not refreshing at all */
+        aws_thread_clean_up(&refresh_thread);
+        s_refresh_thread_fn(impl);
+    }
+}
+
+static int s_refresh_ahead_get_credentials(
+    void *delegate_user_data,
+    aws_on_get_credentials_callback_fn callback,
+    void *callback_user_data) {
+
+    struct refresh_ahead_impl *impl = delegate_user_data;
+
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+
+    aws_mutex_lock(&impl->lock);
+    if (impl->credentials != NULL && now_ns < impl->expires_at_ns) {
+        struct aws_credentials *credentials = aws_credentials_acquire(impl->credentials);
+        bool start_refresh = !impl->fetch_in_flight && now_ns >= impl->next_refresh_at_ns &&
+                             aws_add_u64_saturating(now_ns, impl->refresh_ahead_ns) >= impl->expires_at_ns;
+        if (start_refresh) {
+            impl->fetch_in_flight = true;
+        }
+        aws_mutex_unlock(&impl->lock);
+
+        callback(credentials, AWS_ERROR_SUCCESS, callback_user_data);
+        aws_credentials_release(credentials);
+
+        if (start_refresh) {
+            s_start_background_refresh(impl);
+        }
+        return AWS_OP_SUCCESS;
+    }
+
+    struct refresh_ahead_waiter *waiter = aws_mem_calloc(impl->allocator, 1, sizeof(struct refresh_ahead_waiter));
+    waiter->callback = callback;
+    waiter->user_data = callback_user_data;
+    aws_linked_list_push_back(&impl->waiters, &waiter->node);
+
+    bool start_fetch = !impl->fetch_in_flight;
+    impl->fetch_in_flight = true;
+    aws_mutex_unlock(&impl->lock);
+
+    /* Nothing usable is cached, so this caller has to wait anyway; fetch on its thread */
+    if (start_fetch) {
+        s_fetch(impl);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_on_delegate_shutdown(void *user_data) {
+    struct refresh_ahead_impl *impl = user_data;
+    aws_ref_count_release(&impl->ref_count);
+}
+
+struct aws_credentials_provider *aws_jni_credentials_provider_new_refresh_ahead(
+    struct aws_allocator *allocator,
+    const struct aws_jni_credentials_refresh_ahead_options *options) {
+
+    if (options->source == NULL) {
+        aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    struct refresh_ahead_impl *impl = aws_mem_calloc(allocator, 1, sizeof(struct refresh_ahead_impl));
+    impl->allocator = allocator;
+    impl->caching_duration_ns =
+        aws_timestamp_convert(options->caching_duration_ms, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+    impl->refresh_ahead_ns =
+        aws_timestamp_convert(options->refresh_ahead_ms, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+    aws_linked_list_init(&impl->waiters);
+
+    if (aws_mutex_init(&impl->lock)) {
+        aws_mem_release(allocator, impl);
+        return NULL;
+    }
+
+    struct aws_credentials_provider_delegate_options delegate_options = {
+        .get_credentials = s_refresh_ahead_get_credentials,
+        .delegate_user_data = impl,
+        .shutdown_options =
+            {
+                .shutdown_callback = s_on_delegate_shutdown,
+                .shutdown_user_data = impl,
+            },
+    };
+
+    struct aws_credentials_provider *provider = aws_credentials_provider_new_delegate(allocator, &delegate_options);
+    if (provider == NULL) {
+        aws_mutex_clean_up(&impl->lock);
+        aws_mem_release(allocator, impl);
+        return NULL;
+    }
+
+    /* Only set once the provider exists, so a failure above doesn't invoke the caller's shutdown callback */
+    impl->source = aws_credentials_provider_acquire(options->source);
+    impl->shutdown_options = options->shutdown_options;
+    aws_ref_count_init(&impl->ref_count, impl, s_refresh_ahead_impl_destroy);
+
+    return provider;
+}
@@ -0,0 +1,38 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_CREDENTIALS_REFRESH_AHEAD_H
+#define AWS_JNI_CRT_CREDENTIALS_REFRESH_AHEAD_H
+
+#include <aws/auth/credentials.h>
+
+/*
+ * A caching credentials provider that refreshes ahead of expiry: once cached credentials are within refresh_ahead_ms
+ * of expiring, the next request for them starts a refresh on a background thread, and it and every request until the
+ * refresh completes still get the cached credentials. Callers are only made to wait when nothing usable is cached,
+ * and then all of them wait on the same fetch. A failed refresh leaves the cached credentials in use until they
+ * expire, and the next background refresh waits out a backoff that doubles with each failure in a row, from 1 up to
+ * 60 seconds.
+ *
+ * Credentials expire at the earlier of their own expiration and caching_duration_ms after they were fetched.
+ *
+ * The background thread matters for sources that do their work in get_credentials itself, like the delegate
+ * provider calling into Java, which would otherwise block the signing thread that asked.
+ */
+struct aws_jni_credentials_refresh_ahead_options {
+    /* Acquired by the new provider */
+    struct aws_credentials_provider *source;
+    /* 0 to cache credentials until their own expiration */
+    uint64_t caching_duration_ms;
+    uint64_t refresh_ahead_ms;
+    /* Invoked once the provider and any refresh still in flight are done */
+    struct aws_credentials_provider_shutdown_options shutdown_options;
+};
+
+struct aws_credentials_provider *aws_jni_credentials_provider_new_refresh_ahead(
+    struct aws_allocator *allocator,
+    const struct aws_jni_credentials_refresh_ahead_options *options);
+
+#endif /* AWS_JNI_CRT_CREDENTIALS_REFRESH_AHEAD_H */
@@ -24,21 +24,108 @@
 #include <aws/mqtt/mqtt.h>
 #include <aws/s3/s3.h>
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "crt.h"
+#include "event_loop_metrics.h"
+#include "http_request_response.h"
 #include "java_class_ids.h"
 #include "logging.h"
+#include "memory_sampler.h"
+#include "tracing.h"
 
 /* 0 = off, 1 = bytes, 2 = stack traces, see aws_mem_trace_level */
 int g_memory_tracing = 0;
+
+/* per-subsystem memory accounting, see aws_jni_get_subsystem_allocator() */
+static bool s_memory_accounting = false;
+
+/*
+ * Each accounting allocator prefixes its allocations with this header, so that a block released through another
+ * subsystem's allocator is still counted against the subsystem that allocated it. 16 bytes keeps the alignment of
+ * the underlying allocator.
+ */
+struct jni_accounting_header {
+    uint64_t size;
+    uint64_t subsystem;
+};
+
+/* set in jni_accounting_header.subsystem for blocks recorded by the memory sampler */
+#define JNI_ACCOUNTING_SAMPLED_FLAG ((uint64_t)1 << 63)
+
+struct jni_subsystem_memory_usage {
+    struct aws_atomic_var bytes;
+    struct aws_atomic_var allocations;
+};
+
+static struct jni_subsystem_memory_usage s_subsystem_memory_usage[AWS_JNI_SUBSYSTEM_COUNT];
+
+/* default allocator or tracer, the accounting allocators allocate from it */
+static struct aws_allocator *s_base_allocator = NULL;
+
+static void *s_accounting_mem_acquire(struct aws_allocator *allocator, size_t size) {
+    struct jni_accounting_header *header = aws_mem_acquire(s_base_allocator, sizeof(*header) + size);
+    if (header == NULL) {
+        return NULL;
+    }
+
+    size_t subsystem = (size_t)allocator->impl;
+    header->size = size;
+    header->subsystem = subsystem;
+    aws_atomic_fetch_add(&s_subsystem_memory_usage[subsystem].bytes, size);
+    aws_atomic_fetch_add(&s_subsystem_memory_usage[subsystem].allocations, 1);
+
+    if (aws_jni_memory_sampler_is_enabled() && aws_jni_memory_sampler_should_sample(size)) {
+        header->subsystem |= JNI_ACCOUNTING_SAMPLED_FLAG;
+        aws_jni_memory_sampler_record(header + 1, size, (int)subsystem);
+    }
+    return header + 1;
+}
+
+static void s_accounting_mem_release(struct aws_allocator *allocator, void *ptr) {
+    (void)allocator;
+
+    struct jni_accounting_header *header = (struct jni_accounting_header *)ptr - 1;
+    if (header->subsystem & JNI_ACCOUNTING_SAMPLED_FLAG) {
+        aws_jni_memory_sampler_forget(ptr);
+    }
+
+    size_t subsystem = (size_t)(header->subsystem & ~JNI_ACCOUNTING_SAMPLED_FLAG);
+    aws_atomic_fetch_sub(&s_subsystem_memory_usage[subsystem].bytes, (size_t)header->size);
+    aws_atomic_fetch_sub(&s_subsystem_memory_usage[subsystem].allocations, 1);
+    aws_mem_release(s_base_allocator, header);
+}
+
+#define JNI_ACCOUNTING_ALLOCATOR(SUBSYSTEM)                                                                            \
+    [SUBSYSTEM] = {                                                                                                    \
+        .mem_acquire = s_accounting_mem_acquire,                                                                       \
+        .mem_release = s_accounting_mem_release,                                                                       \
+        .impl = (void *)(size_t)(SUBSYSTEM),                                                                           \
+    }
+
+/* no realloc or calloc, aws_mem_realloc() and aws_mem_calloc() fall back to acquire and release */
+static struct aws_allocator s_accounting_allocators[AWS_JNI_SUBSYSTEM_COUNT] = {
+    JNI_ACCOUNTING_ALLOCATOR(AWS_JNI_SUBSYSTEM_GENERAL),
+    JNI_ACCOUNTING_ALLOCATOR(AWS_JNI_SUBSYSTEM_IO),
+    JNI_ACCOUNTING_ALLOCATOR(AWS_JNI_SUBSYSTEM_HTTP),
+    JNI_ACCOUNTING_ALLOCATOR(AWS_JNI_SUBSYSTEM_AUTH),
+    JNI_ACCOUNTING_ALLOCATOR(AWS_JNI_SUBSYSTEM_MQTT),
+    JNI_ACCOUNTING_ALLOCATOR(AWS_JNI_SUBSYSTEM_EVENT_STREAM),
+    JNI_ACCOUNTING_ALLOCATOR(AWS_JNI_SUBSYSTEM_S3),
+};
+
 static struct aws_allocator *s_init_allocator(void) {
+    struct aws_allocator *allocator = aws_default_allocator();
     if (g_memory_tracing) {
-        struct aws_allocator *allocator = aws_default_allocator();
         allocator = aws_mem_tracer_new(allocator, NULL, (enum aws_mem_trace_level)g_memory_tracing, 8);
-        return allocator;
     }
-    return aws_default_allocator();
+    s_base_allocator = allocator;
+
+    if (s_memory_accounting) {
+        return &s_accounting_allocators[AWS_JNI_SUBSYSTEM_GENERAL];
+    }
+    return allocator;
 }
 
 static struct aws_allocator *s_allocator = NULL;
@@ -49,6 +136,22 @@ struct aws_allocator *aws_jni_get_allocator() {
     return s_allocator;
 }
 
+struct aws_allocator *aws_jni_get_subsystem_allocator(enum aws_jni_subsystem subsystem) {
+    struct aws_allocator *allocator = aws_jni_get_allocator();
+    if (s_memory_accounting) {
+        return &s_accounting_allocators[subsystem];
+    }
+    return allocator;
+}
+
+/* The tracer, when memory tracing is on */
+static struct aws_allocator *s_get_tracer_allocator(void) {
+    aws_jni_get_allocator();
+    return s_base_allocator;
+}
+
+static void s_thread_env_slot_release(void);
+
 static void s_detach_jvm_from_thread(void *user_data) {
     AWS_LOGF_DEBUG(AWS_LS_COMMON_GENERAL, "s_detach_jvm_from_thread invoked");
     JavaVM *jvm = user_data;
@@ -62,6 +165,9 @@ static void s_detach_jvm_from_thread(void *user_data) {
         aws_jni_release_thread_env(jvm, env);
         /********** JNI ENV RELEASE **********/
     }
+
+    /* the cached JNIEnv went with the attachment */
+    s_thread_env_slot_release();
 }
 
 static JNIEnv *s_aws_jni_get_thread_env(JavaVM *jvm) {
@@ -117,10 +223,120 @@ instead, we just have to be careful with acquire/release.
 
 In this way, the vast majority of usage is relatively contentionless; it's just a bunch of native threads taking
 read locks on a shared rw lock.  Only when the JVM shutdown hook calls into native is there read-write contention.
+
+Taking even an uncontended read lock still writes the lock's shared reader count though, and with every body chunk and
+MQTT message calling back into Java from every event loop thread, that cache line bounces between cores.  So threads
+created by aws-c-common (event loop threads, in practice all of the callback traffic) take a fast path instead:
+
+Each such thread claims a slot, which caches its JNIEnv and counts how deep it is in acquires.  Acquiring bumps the
+slot's depth, then checks the JVM is still the active one in s_active_jvm; releasing drops the depth.  Only the owning
+thread ever writes its slot, so nothing is shared between threads.  Removing the JVM clears s_active_jvm and then
+waits for every slot's depth to reach zero, which is the same guarantee the write lock gives for the read lock: once
+removal returns, no thread is using a JNIEnv and none will get a new one.  Those two steps are sequentially
+consistent atomics on both sides, so either the acquiring thread sees the JVM is gone, or removal sees its depth.
+
+Slots are returned when their thread exits and reused by later threads; they are never freed.  Other threads (JVM
+threads calling into native, mostly), nested JVMs and threads on their way out keep using the rw lock.
  */
 static struct aws_rw_lock s_jvm_table_lock = AWS_RW_LOCK_INIT;
 static struct aws_hash_table *s_jvms = NULL;
 
+struct jni_thread_env_slot {
+    /* non-zero while a live thread owns this slot */
+    struct aws_atomic_var claimed;
+    /* number of JNIEnvs the owning thread has acquired through the slot and not yet released */
+    struct aws_atomic_var depth;
+    /* only touched by the owning thread */
+    JavaVM *jvm;
+    JNIEnv *env;
+    /* set once, before the slot is published */
+    struct jni_thread_env_slot *next;
+};
+
+/* the JavaVM acquires can take the fast path for, NULL while there's none or it's shutting down */
+static struct aws_atomic_var s_active_jvm = AWS_ATOMIC_INIT_PTR(NULL);
+/* list of every slot ever created, most recent first */
+static struct aws_atomic_var s_thread_env_slots = AWS_ATOMIC_INIT_PTR(NULL);
+
+enum jni_thread_env_mode {
+    AWS_JNI_THREAD_ENV_UNKNOWN = 0,
+    AWS_JNI_THREAD_ENV_FAST,
+    AWS_JNI_THREAD_ENV_LOCKED,
+};
+
+static AWS_THREAD_LOCAL enum jni_thread_env_mode tl_thread_env_mode = AWS_JNI_THREAD_ENV_UNKNOWN;
+static AWS_THREAD_LOCAL struct jni_thread_env_slot *tl_thread_env_slot = NULL;
+
+static void s_thread_env_slot_release(void) {
+    struct jni_thread_env_slot *slot = tl_thread_env_slot;
+    /* from here on this thread uses the rw lock */
+    tl_thread_env_mode = AWS_JNI_THREAD_ENV_LOCKED;
+    tl_thread_env_slot = NULL;
+    if (slot != NULL) {
+        AWS_FATAL_ASSERT(aws_atomic_load_int(&slot->depth) == 0);
+        slot->jvm = NULL;
+        slot->env = NULL;
+        aws_atomic_store_int(&slot->claimed, 0);
+    }
+}
+
+static void s_on_thread_exit_release_env_slot(void *user_data) {
+    (void)user_data;
+    s_thread_env_slot_release();
+}
+
+static struct jni_thread_env_slot *s_thread_env_slot_claim(void) {
+    struct jni_thread_env_slot *head = aws_atomic_load_ptr(&s_thread_env_slots);
+    for (struct jni_thread_env_slot *slot = head; slot != NULL; slot = slot->next) {
+        size_t unclaimed = 0;
+        if (aws_atomic_compare_exchange_int(&slot->claimed, &unclaimed, 1)) {
+            return slot;
+        }
+    }
+
+    /* use default allocator so that tracing allocator doesn't flag this as a leak during tests */
+    struct jni_thread_env_slot *slot = aws_mem_calloc(aws_default_allocator(), 1, sizeof(struct jni_thread_env_slot));
+    aws_atomic_init_int(&slot->claimed, 1);
+    aws_atomic_init_int(&slot->depth, 0);
+    do {
+        slot->next = head;
+    } while (!aws_atomic_compare_exchange_ptr(&s_thread_env_slots, (void **)&head, slot));
+
+    return slot;
+}
+
+/* Decides, once per thread, whether it takes the fast path. Only threads that can tell us when they exit do. */
+static struct jni_thread_env_slot *s_get_thread_env_slot(void) {
+    if (AWS_LIKELY(tl_thread_env_mode == AWS_JNI_THREAD_ENV_FAST)) {
+        return tl_thread_env_slot;
+    }
+    if (tl_thread_env_mode == AWS_JNI_THREAD_ENV_LOCKED) {
+        return NULL;
+    }
+
+    int last_error = aws_last_error();
+    if (aws_thread_current_at_exit(s_on_thread_exit_release_env_slot, NULL)) {
+        /* not a thread aws-c-common started, and callers may still care about the error they had */
+        aws_raise_error(last_error);
+        tl_thread_env_mode = AWS_JNI_THREAD_ENV_LOCKED;
+        return NULL;
+    }
+
+    tl_thread_env_slot = s_thread_env_slot_claim();
+    tl_thread_env_mode = AWS_JNI_THREAD_ENV_FAST;
+    return tl_thread_env_slot;
+}
+
+/* Waits until no thread is using a JNIEnv it got from the fast path */
+static void s_wait_for_thread_env_slots(void) {
+    for (struct jni_thread_env_slot *slot = aws_atomic_load_ptr(&s_thread_env_slots); slot != NULL;
+         slot = slot->next) {
+        while (aws_atomic_load_int(&slot->depth) != 0) {
+            aws_thread_current_sleep(aws_timestamp_convert(1, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL));
+        }
+    }
+}
+
 static void s_jvm_table_add_jvm_for_env(JNIEnv *env) {
     aws_rw_lock_wlock(&s_jvm_table_lock);
 
@@ -140,6 +356,10 @@ static void s_jvm_table_add_jvm_for_env(JNIEnv *env) {
     AWS_FATAL_ASSERT(AWS_OP_SUCCESS == aws_hash_table_put(s_jvms, jvm, NULL, &was_created));
     AWS_FATAL_ASSERT(was_created == 1);
 
+    /* only the first JVM gets the fast path, we don't correctly support multiple JVMs anyway */
+    void *no_jvm = NULL;
+    aws_atomic_compare_exchange_ptr(&s_active_jvm, &no_jvm, jvm);
+
     aws_rw_lock_wunlock(&s_jvm_table_lock);
 }
 
@@ -156,6 +376,11 @@ static void s_jvm_table_remove_jvm_for_env(JNIEnv *env) {
 
     AWS_FATAL_ASSERT(AWS_OP_SUCCESS == aws_hash_table_remove(s_jvms, jvm, NULL, NULL));
 
+    void *active_jvm = jvm;
+    if (aws_atomic_compare_exchange_ptr(&s_active_jvm, &active_jvm, NULL)) {
+        s_wait_for_thread_env_slots();
+    }
+
     if (aws_hash_table_get_entry_count(s_jvms) == 0) {
         aws_hash_table_clean_up(s_jvms);
         aws_mem_release(aws_default_allocator(), s_jvms);
@@ -168,6 +393,26 @@ done:
 }
 
 JNIEnv *aws_jni_acquire_thread_env(JavaVM *jvm) {
+    AWS_JNI_TRACE_SPAN("jni.acquire_thread_env", jvm);
+    struct jni_thread_env_slot *slot = s_get_thread_env_slot();
+    if (slot != NULL) {
+        size_t depth = aws_atomic_load_int(&slot->depth);
+        aws_atomic_store_int(&slot->depth, depth + 1);
+        if (AWS_LIKELY(aws_atomic_load_ptr(&s_active_jvm) == jvm)) {
+            if (slot->env == NULL || slot->jvm != jvm) {
+                AWS_FATAL_ASSERT(depth == 0);
+                slot->env = s_aws_jni_get_thread_env(jvm);
+                slot->jvm = slot->env != NULL ? jvm : NULL;
+            }
+            if (slot->env != NULL) {
+                aws_jni_event_loop_metrics_upcall_begin();
+                return slot->env;
+            }
+        }
+        /* the JVM is going away, or it isn't the one the fast path is for: let the rw lock sort it out */
+        aws_atomic_store_int(&slot->depth, depth);
+    }
+
     /*
      * We use try-lock here in order to avoid the re-entrant deadlock case that could happen if we have a read
      * lock already, the JVM shutdown hooks causes another thread to block on taking the write lock, and then
@@ -199,6 +444,7 @@ JNIEnv *aws_jni_acquire_thread_env(JavaVM *jvm) {
         goto error;
     }
 
+    aws_jni_event_loop_metrics_upcall_begin();
     return env;
 
 error:
@@ -209,28 +455,47 @@ error:
 }
 
 void aws_jni_release_thread_env(JavaVM *jvm, JNIEnv *env) {
-    (void)jvm;
-    (void)env;
+    if (env == NULL) {
+        return;
+    }
 
-    if (env != NULL) {
-        aws_rw_lock_runlock(&s_jvm_table_lock);
+    aws_jni_event_loop_metrics_upcall_end();
+
+    struct jni_thread_env_slot *slot = tl_thread_env_slot;
+    if (slot != NULL && slot->jvm == jvm && slot->env == env) {
+        size_t depth = aws_atomic_load_int(&slot->depth);
+        if (depth > 0) {
+            aws_atomic_store_int(&slot->depth, depth - 1);
+            return;
+        }
     }
+
+    aws_rw_lock_runlock(&s_jvm_table_lock);
 }
 
 void aws_jni_throw_runtime_exception(JNIEnv *env, const char *msg, ...) {
+    int error = aws_last_error();
+
+    /*
+     * Format the message and the error suffix into the same buffer, rather than formatting twice. The message gets
+     * at most MAX_MSG_LEN of it so the suffix, which CrtRuntimeException parses the error code from, always fits.
+     */
+    enum { MAX_MSG_LEN = 1024 };
+    char exception[MAX_MSG_LEN + 256];
     va_list args;
     va_start(args, msg);
-    char buf[1024];
-    vsnprintf(buf, sizeof(buf), msg, args);
+    int msg_len = vsnprintf(exception, MAX_MSG_LEN, msg, args);
     va_end(args);
+    if (msg_len < 0) {
+        msg_len = 0;
+        exception[0] = '\0';
+    }
 
-    int error = aws_last_error();
-    char exception[1280];
+    size_t offset = AWS_MIN((size_t)msg_len, MAX_MSG_LEN - 1);
     snprintf(
-        exception,
-        sizeof(exception),
-        "%s (aws_last_error: %s(%d), %s)",
-        buf,
+        exception + offset,
+        sizeof(exception) - offset,
+        " (aws_last_error: %s(%d), %s)",
         aws_error_name(error),
         error,
         aws_error_str(error));
@@ -238,13 +503,28 @@ void aws_jni_throw_runtime_exception(JNIEnv *env, const char *msg, ...) {
     (*env)->ThrowNew(env, runtime_exception, exception);
 }
 
+void aws_jni_throw_crt_error(JNIEnv *env, int error_code) {
+    jobject crt_exception = (*env)->NewObject(
+        env,
+        crt_runtime_exception_properties.crt_runtime_exception_class,
+        crt_runtime_exception_properties.constructor_method_id,
+        (jint)error_code);
+    if (crt_exception == NULL) {
+        /* NewObject() has thrown (most likely OutOfMemoryError), which is as good as it gets */
+        return;
+    }
+
+    (*env)->Throw(env, (jthrowable)crt_exception);
+    (*env)->DeleteLocalRef(env, crt_exception);
+}
+
 void aws_jni_throw_null_pointer_exception(JNIEnv *env, const char *msg, ...) {
     va_list args;
     va_start(args, msg);
     char buf[1024];
     vsnprintf(buf, sizeof(buf), msg, args);
     va_end(args);
-    (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/NullPointerException"), buf);
+    (*env)->ThrowNew(env, exception_properties.null_pointer_exception_class, buf);
 }
 
 void aws_jni_throw_illegal_argument_exception(JNIEnv *env, const char *msg, ...) {
@@ -253,7 +533,7 @@ void aws_jni_throw_illegal_argument_exception(JNIEnv *env, const char *msg, ...)
     char buf[1024];
     vsnprintf(buf, sizeof(buf), msg, args);
     va_end(args);
-    (*env)->ThrowNew(env, (*env)->FindClass(env, "java/lang/IllegalArgumentException"), buf);
+    (*env)->ThrowNew(env, exception_properties.illegal_argument_exception_class, buf);
 }
 
 bool aws_jni_check_and_clear_exception(JNIEnv *env) {
@@ -434,6 +714,12 @@ static struct aws_error_info s_crt_errors[] = {
     AWS_DEFINE_ERROR_INFO_CRT(
         AWS_ERROR_JAVA_CRT_JVM_DESTROYED,
         "Attempt to use a JVM that has already been destroyed"),
+    AWS_DEFINE_ERROR_INFO_CRT(
+        AWS_ERROR_JAVA_CRT_CONNECTION_ACQUISITION_TIMEOUT,
+        "Timed out waiting for a connection from the connection manager"),
+    AWS_DEFINE_ERROR_INFO_CRT(
+        AWS_ERROR_JAVA_CRT_MAX_PENDING_CONNECTION_ACQUISITIONS_EXCEEDED,
+        "Too many connection acquisitions are already waiting on the connection manager"),
 };
 /* clang-format on */
 
@@ -463,6 +749,8 @@ static void s_jni_atexit_strict(void) {
     aws_unregister_log_subject_info_list(&s_crt_log_subject_list);
     aws_unregister_error_info(&s_crt_error_list);
 
+    aws_http_stream_binding_pool_clear();
+
     aws_s3_library_clean_up();
     aws_event_stream_library_clean_up();
     aws_auth_library_clean_up();
@@ -470,18 +758,21 @@ static void s_jni_atexit_strict(void) {
     aws_mqtt_library_clean_up();
 
     if (g_memory_tracing) {
-        struct aws_allocator *tracer_allocator = aws_jni_get_allocator();
+        struct aws_allocator *tracer_allocator = s_get_tracer_allocator();
         aws_mem_tracer_dump(tracer_allocator);
     }
 
     aws_jni_cleanup_logging();
 
     if (g_memory_tracing) {
-        struct aws_allocator *tracer_allocator = aws_jni_get_allocator();
+        struct aws_allocator *tracer_allocator = s_get_tracer_allocator();
         aws_mem_tracer_destroy(tracer_allocator);
     }
 
+    aws_jni_memory_sampler_clean_up();
+
     s_allocator = NULL;
+    s_base_allocator = NULL;
 }
 
 #define DEFAULT_MANAGED_SHUTDOWN_WAIT_IN_SECONDS 1
@@ -508,9 +799,9 @@ static void s_jni_atexit_gentle(void) {
             AWS_LOGF_DEBUG(
                 AWS_LS_JAVA_CRT_GENERAL,
                 "At shutdown, %u bytes remaining",
-                (uint32_t)aws_mem_tracer_bytes(aws_jni_get_allocator()));
+                (uint32_t)aws_mem_tracer_bytes(s_get_tracer_allocator()));
             if (g_memory_tracing > 1) {
-                aws_mem_tracer_dump(aws_jni_get_allocator());
+                aws_mem_tracer_dump(s_get_tracer_allocator());
             }
         }
     }
@@ -518,12 +809,17 @@ static void s_jni_atexit_gentle(void) {
 
 #define KB_256 (256 * 1024)
 
+/* How long awsCrtInit spent initializing the native libraries, reported by CRT.logInitTimings() */
+static uint64_t s_library_init_time_ns = 0;
+
 /* Called as the entry point, immediately after the shared lib is loaded the first time by JNI */
 JNIEXPORT
 void JNICALL Java_software_amazon_awssdk_crt_CRT_awsCrtInit(
     JNIEnv *env,
     jclass jni_crt_class,
     jint jni_memtrace,
+    jboolean jni_memory_accounting,
+    jlong jni_memory_sampling_interval,
     jboolean jni_debug_wait,
     jboolean jni_strict_shutdown) {
     (void)jni_crt_class;
@@ -536,6 +832,12 @@ void JNICALL Java_software_amazon_awssdk_crt_CRT_awsCrtInit(
     }
 
     g_memory_tracing = jni_memtrace;
+    s_memory_accounting = jni_memory_accounting;
+    if (jni_memory_sampling_interval > 0) {
+        /* the sampler hooks into the accounting allocators */
+        aws_jni_memory_sampler_init((size_t)jni_memory_sampling_interval);
+        s_memory_accounting = true;
+    }
 
     /*
      * Increase the maximum channel message size in order to improve throughput on large payloads.
@@ -549,6 +851,9 @@ void JNICALL Java_software_amazon_awssdk_crt_CRT_awsCrtInit(
         g_memory_tracing = 1;
     }
 
+    uint64_t library_init_start_ns = 0;
+    aws_high_res_clock_get_ticks(&library_init_start_ns);
+
     /* NOT using aws_jni_get_allocator to avoid trace leak outside the test */
     struct aws_allocator *allocator = aws_default_allocator();
     aws_mqtt_library_init(allocator);
@@ -560,6 +865,10 @@ void JNICALL Java_software_amazon_awssdk_crt_CRT_awsCrtInit(
     aws_register_error_info(&s_crt_error_list);
     aws_register_log_subject_info_list(&s_crt_log_subject_list);
 
+    uint64_t library_init_end_ns = 0;
+    aws_high_res_clock_get_ticks(&library_init_end_ns);
+    s_library_init_time_ns = library_init_end_ns - library_init_start_ns;
+
     s_jvm_table_add_jvm_for_env(env);
     cache_java_class_ids(env);
 
@@ -570,6 +879,18 @@ void JNICALL Java_software_amazon_awssdk_crt_CRT_awsCrtInit(
     }
 }
 
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_CRT_logInitTimings(JNIEnv *env, jclass jni_crt_class) {
+    (void)env;
+    (void)jni_crt_class;
+
+    AWS_LOGF_DEBUG(
+        AWS_LS_JAVA_CRT_GENERAL,
+        "Initialized native libraries in %" PRIu64 " us",
+        aws_timestamp_convert(s_library_init_time_ns, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MICROS, NULL));
+    log_java_class_ids_cache_times();
+}
+
 JNIEXPORT
 void JNICALL Java_software_amazon_awssdk_crt_CRT_onJvmShutdown(JNIEnv *env, jclass jni_crt_class) {
 
@@ -605,7 +926,7 @@ jlong JNICALL Java_software_amazon_awssdk_crt_CRT_awsNativeMemory(JNIEnv *env, j
     (void)jni_crt_class;
     jlong allocated = 0;
     if (g_memory_tracing) {
-        allocated = (jlong)aws_mem_tracer_bytes(aws_jni_get_allocator());
+        allocated = (jlong)aws_mem_tracer_bytes(s_get_tracer_allocator());
     }
     return allocated;
 }
@@ -615,10 +936,50 @@ void JNICALL Java_software_amazon_awssdk_crt_CRT_dumpNativeMemory(JNIEnv *env, j
     (void)env;
     (void)jni_crt_class;
     if (g_memory_tracing > 1) {
-        aws_mem_tracer_dump(aws_jni_get_allocator());
+        aws_mem_tracer_dump(s_get_tracer_allocator());
     }
 }
 
+JNIEXPORT
+jlong JNICALL Java_software_amazon_awssdk_crt_CRT_awsSampledNativeMemory(JNIEnv *env, jclass jni_crt_class) {
+    (void)env;
+    (void)jni_crt_class;
+    return (jlong)aws_jni_memory_sampler_estimated_bytes();
+}
+
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_CRT_dumpNativeMemorySamples(JNIEnv *env, jclass jni_crt_class) {
+    (void)env;
+    (void)jni_crt_class;
+    aws_jni_memory_sampler_dump();
+}
+
+JNIEXPORT
+jlong JNICALL Java_software_amazon_awssdk_crt_CRT_awsNativeMemoryForSubsystem(
+    JNIEnv *env,
+    jclass jni_crt_class,
+    jint jni_subsystem) {
+    (void)env;
+    (void)jni_crt_class;
+    if (jni_subsystem < 0 || jni_subsystem >= AWS_JNI_SUBSYSTEM_COUNT) {
+        return 0;
+    }
+    return (jlong)aws_atomic_load_int(&s_subsystem_memory_usage[jni_subsystem].bytes);
+}
+
+JNIEXPORT
+jlong JNICALL Java_software_amazon_awssdk_crt_CRT_awsNativeAllocationsForSubsystem(
+    JNIEnv *env,
+    jclass jni_crt_class,
+    jint jni_subsystem) {
+    (void)env;
+    (void)jni_crt_class;
+    if (jni_subsystem < 0 || jni_subsystem >= AWS_JNI_SUBSYSTEM_COUNT) {
+        return 0;
+    }
+    return (jlong)aws_atomic_load_int(&s_subsystem_memory_usage[jni_subsystem].allocations);
+}
+
 jstring aws_jni_string_from_cursor(JNIEnv *env, const struct aws_byte_cursor *native_data) {
     struct aws_string *string = aws_string_new_from_array(aws_jni_get_allocator(), native_data->ptr, native_data->len);
     AWS_FATAL_ASSERT(string != NULL);
@@ -649,13 +1010,16 @@ void JNICALL Java_software_amazon_awssdk_crt_CrtResource_waitForGlobalResourceDe
         aws_timestamp_convert(timeout_in_seconds, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL));
     aws_thread_join_all_managed();
 
+    /* pooled bindings aren't leaks, free them so the memory check below (and the tests') doesn't count them */
+    aws_http_stream_binding_pool_clear();
+
     if (g_memory_tracing) {
         AWS_LOGF_DEBUG(
             AWS_LS_COMMON_GENERAL,
             "At shutdown, %u bytes remaining",
-            (uint32_t)aws_mem_tracer_bytes(aws_jni_get_allocator()));
+            (uint32_t)aws_mem_tracer_bytes(s_get_tracer_allocator()));
         if (g_memory_tracing > 1) {
-            aws_mem_tracer_dump(aws_jni_get_allocator());
+            aws_mem_tracer_dump(s_get_tracer_allocator());
         }
     }
 }
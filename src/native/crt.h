@@ -25,12 +25,60 @@ enum aws_java_crt_log_subject {
 
 enum aws_java_crt_error {
     AWS_ERROR_JAVA_CRT_JVM_DESTROYED = AWS_ERROR_ENUM_BEGIN_RANGE(AWS_CRT_JAVA_PACKAGE_ID),
+    AWS_ERROR_JAVA_CRT_CONNECTION_ACQUISITION_TIMEOUT,
+    AWS_ERROR_JAVA_CRT_MAX_PENDING_CONNECTION_ACQUISITIONS_EXCEEDED,
 
     AWS_ERROR_JAVA_CRT_END_RANGE = AWS_ERROR_ENUM_END_RANGE(AWS_CRT_JAVA_PACKAGE_ID),
 };
 
 struct aws_allocator *aws_jni_get_allocator(void);
 
+/* Parts of the library that native memory usage is reported for, must match CRT.NativeMemorySubsystem */
+enum aws_jni_subsystem {
+    AWS_JNI_SUBSYSTEM_GENERAL,
+    AWS_JNI_SUBSYSTEM_IO,
+    AWS_JNI_SUBSYSTEM_HTTP,
+    AWS_JNI_SUBSYSTEM_AUTH,
+    AWS_JNI_SUBSYSTEM_MQTT,
+    AWS_JNI_SUBSYSTEM_EVENT_STREAM,
+    AWS_JNI_SUBSYSTEM_S3,
+
+    AWS_JNI_SUBSYSTEM_COUNT,
+};
+
+/*******************************************************************************
+ * aws_jni_get_subsystem_allocator - returns the allocator for a subsystem's
+ * native memory. With memory accounting on (aws.crt.memory.accounting), each
+ * subsystem's allocations are counted separately. Otherwise this is the same
+ * as aws_jni_get_allocator(). Memory can be released through any subsystem's
+ * allocator, or aws_jni_get_allocator(), and is still counted correctly.
+ ******************************************************************************/
+struct aws_allocator *aws_jni_get_subsystem_allocator(enum aws_jni_subsystem subsystem);
+
+AWS_STATIC_IMPL struct aws_allocator *aws_jni_io_allocator(void) {
+    return aws_jni_get_subsystem_allocator(AWS_JNI_SUBSYSTEM_IO);
+}
+
+AWS_STATIC_IMPL struct aws_allocator *aws_jni_http_allocator(void) {
+    return aws_jni_get_subsystem_allocator(AWS_JNI_SUBSYSTEM_HTTP);
+}
+
+AWS_STATIC_IMPL struct aws_allocator *aws_jni_auth_allocator(void) {
+    return aws_jni_get_subsystem_allocator(AWS_JNI_SUBSYSTEM_AUTH);
+}
+
+AWS_STATIC_IMPL struct aws_allocator *aws_jni_mqtt_allocator(void) {
+    return aws_jni_get_subsystem_allocator(AWS_JNI_SUBSYSTEM_MQTT);
+}
+
+AWS_STATIC_IMPL struct aws_allocator *aws_jni_event_stream_allocator(void) {
+    return aws_jni_get_subsystem_allocator(AWS_JNI_SUBSYSTEM_EVENT_STREAM);
+}
+
+AWS_STATIC_IMPL struct aws_allocator *aws_jni_s3_allocator(void) {
+    return aws_jni_get_subsystem_allocator(AWS_JNI_SUBSYSTEM_S3);
+}
+
 /*******************************************************************************
  * aws_jni_throw_runtime_exception - throws a crt.CrtRuntimeException with the
  * supplied message, sprintf formatted. Control WILL return from this function,
@@ -39,6 +87,15 @@ struct aws_allocator *aws_jni_get_allocator(void);
  ******************************************************************************/
 void aws_jni_throw_runtime_exception(JNIEnv *env, const char *msg, ...);
 
+/*******************************************************************************
+ * aws_jni_throw_crt_error - throws a crt.CrtRuntimeException for error_code,
+ * without building a native message. The exception's message comes from the
+ * error code. Meant for the failure paths of high-rate entry points (making a
+ * request, publishing, ...), where formatting a message on every failure adds
+ * up under overload. Control WILL return from this function.
+ ******************************************************************************/
+void aws_jni_throw_crt_error(JNIEnv *env, int error_code);
+
 /*******************************************************************************
  * Throws java NullPointerException
  ******************************************************************************/
@@ -139,7 +139,7 @@ static struct aws_custom_key_op_handler_vtable s_aws_custom_key_op_handler_vtabl
 
 struct aws_custom_key_op_handler *aws_custom_key_op_handler_java_new(JNIEnv *env, jobject jni_custom_key_op) {
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
 
     struct aws_jni_custom_key_op_handler *java_custom_key_op_handler =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_jni_custom_key_op_handler));
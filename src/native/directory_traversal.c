@@ -4,8 +4,16 @@
  */
 #include "crt.h"
 #include "java_class_ids.h"
+#include <aws/common/array_list.h>
+#include <aws/common/condition_variable.h>
 #include <aws/common/file.h>
+#include <aws/common/linked_list.h>
+#include <aws/common/mutex.h>
 #include <aws/common/string.h>
+#include <aws/common/thread.h>
+
+#include <sys/stat.h>
+#include <sys/types.h>
 
 struct directory_traversal_callback_ctx {
     JNIEnv *env;
@@ -105,3 +113,558 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_io_DirectoryTraversal_crt
 
     aws_string_destroy(path_str);
 }
+
+/*
+ * Parallel traversal: worker threads each take a whole directory off a shared queue, list it, queue the
+ * subdirectories they find for any worker to take, and collect the entries that pass the filters into batches. The
+ * thread that called traverse() hands the batches to Java one at a time. Workers wait while max_ready_batches are
+ * waiting for it, so a slow handler holds back the traversal rather than letting it buffer the whole tree.
+ */
+struct parallel_traversal_entry {
+    struct aws_string *path;
+    struct aws_string *relative_path;
+    int64_t file_size;
+    int64_t last_modified_ms;
+    int32_t file_type;
+};
+
+struct parallel_traversal_batch {
+    struct aws_linked_list_node node;
+    /* struct parallel_traversal_entry */
+    struct aws_array_list entries;
+};
+
+struct parallel_traversal_directory {
+    struct aws_linked_list_node node;
+    struct aws_string *path;
+    /* relative to the directory being traversed, NULL for that directory itself */
+    struct aws_string *relative_path;
+};
+
+struct parallel_traversal {
+    struct aws_allocator *allocator;
+    bool recursive;
+    bool include_directories;
+    /* NULL to report every file */
+    struct aws_string *file_name_glob;
+    int64_t min_file_size;
+    int64_t max_file_size;
+    size_t batch_size;
+    size_t max_ready_batches;
+
+    struct aws_mutex lock;
+    struct aws_condition_variable signal;
+    /* the fields below are guarded by lock */
+    /* struct parallel_traversal_directory, waiting to be listed */
+    struct aws_linked_list pending_directories;
+    /* workers listing a directory, which may queue more */
+    size_t busy_workers;
+    size_t running_workers;
+    /* struct parallel_traversal_batch, waiting to be handed to Java */
+    struct aws_linked_list ready_batches;
+    size_t ready_batch_count;
+    /* set on cancellation or error */
+    bool stopped;
+    int error_code;
+};
+
+/* Matches '*' and '?' against a file name. '?' matches a single byte, so a character outside ASCII takes several. */
+static bool s_glob_matches(struct aws_byte_cursor pattern, struct aws_byte_cursor name) {
+    size_t pattern_index = 0;
+    size_t name_index = 0;
+    size_t star_pattern_index = SIZE_MAX;
+    size_t star_name_index = 0;
+
+    while (name_index < name.len) {
+        if (pattern_index < pattern.len &&
+            (pattern.ptr[pattern_index] == '?' || pattern.ptr[pattern_index] == name.ptr[name_index])) {
+            ++pattern_index;
+            ++name_index;
+        } else if (pattern_index < pattern.len && pattern.ptr[pattern_index] == '*') {
+            star_pattern_index = pattern_index++;
+            star_name_index = name_index;
+        } else if (star_pattern_index != SIZE_MAX) {
+            /* let the last '*' swallow one more byte and try again */
+            pattern_index = star_pattern_index + 1;
+            name_index = ++star_name_index;
+        } else {
+            return false;
+        }
+    }
+
+    while (pattern_index < pattern.len && pattern.ptr[pattern_index] == '*') {
+        ++pattern_index;
+    }
+
+    return pattern_index == pattern.len;
+}
+
+static struct aws_byte_cursor s_file_name(struct aws_byte_cursor relative_path) {
+    const char separator = aws_get_platform_directory_separator();
+    for (size_t i = relative_path.len; i > 0; --i) {
+        if (relative_path.ptr[i - 1] == separator || relative_path.ptr[i - 1] == '/') {
+            aws_byte_cursor_advance(&relative_path, i);
+            break;
+        }
+    }
+    return relative_path;
+}
+
+static bool s_entry_passes_filters(
+    const struct parallel_traversal *traversal,
+    const struct aws_directory_entry *entry) {
+    if ((entry->file_type & AWS_FILE_TYPE_DIRECTORY) != 0) {
+        return traversal->include_directories;
+    }
+
+    if (entry->file_size < traversal->min_file_size || entry->file_size > traversal->max_file_size) {
+        return false;
+    }
+
+    return traversal->file_name_glob == NULL ||
+           s_glob_matches(aws_byte_cursor_from_string(traversal->file_name_glob), s_file_name(entry->relative_path));
+}
+
+static int64_t s_last_modified_ms(const struct aws_string *path) {
+#ifdef _WIN32
+    struct __stat64 file_stat;
+    if (_stat64(aws_string_c_str(path), &file_stat) != 0) {
+        return -1;
+    }
+#else
+    struct stat file_stat;
+    if (stat(aws_string_c_str(path), &file_stat) != 0) {
+        return -1;
+    }
+#endif
+    return (int64_t)file_stat.st_mtime * 1000;
+}
+
+static struct aws_string *s_join_relative_path(
+    struct aws_allocator *allocator,
+    const struct aws_string *parent,
+    struct aws_byte_cursor name) {
+
+    if (parent == NULL) {
+        return aws_string_new_from_cursor(allocator, &name);
+    }
+
+    struct aws_byte_buf joined;
+    aws_byte_buf_init(&joined, allocator, parent->len + 1 + name.len);
+    struct aws_byte_cursor parent_cursor = aws_byte_cursor_from_string(parent);
+    aws_byte_buf_append(&joined, &parent_cursor);
+    aws_byte_buf_append_byte_dynamic(&joined, (uint8_t)aws_get_platform_directory_separator());
+    aws_byte_buf_append(&joined, &name);
+
+    struct aws_byte_cursor joined_cursor = aws_byte_cursor_from_buf(&joined);
+    struct aws_string *relative_path = aws_string_new_from_cursor(allocator, &joined_cursor);
+    aws_byte_buf_clean_up(&joined);
+    return relative_path;
+}
+
+static void s_directory_destroy(struct aws_allocator *allocator, struct parallel_traversal_directory *directory) {
+    aws_string_destroy(directory->path);
+    aws_string_destroy(directory->relative_path);
+    aws_mem_release(allocator, directory);
+}
+
+static struct parallel_traversal_batch *s_batch_new(struct parallel_traversal *traversal) {
+    struct parallel_traversal_batch *batch =
+        aws_mem_calloc(traversal->allocator, 1, sizeof(struct parallel_traversal_batch));
+    aws_array_list_init_dynamic(
+        &batch->entries, traversal->allocator, traversal->batch_size, sizeof(struct parallel_traversal_entry));
+    return batch;
+}
+
+static void s_batch_destroy(struct aws_allocator *allocator, struct parallel_traversal_batch *batch) {
+    size_t entry_count = aws_array_list_length(&batch->entries);
+    for (size_t i = 0; i < entry_count; ++i) {
+        struct parallel_traversal_entry *entry = NULL;
+        aws_array_list_get_at_ptr(&batch->entries, (void **)&entry, i);
+        aws_string_destroy(entry->path);
+        aws_string_destroy(entry->relative_path);
+    }
+    aws_array_list_clean_up(&batch->entries);
+    aws_mem_release(allocator, batch);
+}
+
+/* Waits for room among the ready batches; gives up the batch if the traversal stopped meanwhile */
+static void s_submit_batch_locked(struct parallel_traversal *traversal, struct parallel_traversal_batch *batch) {
+    while (!traversal->stopped && traversal->ready_batch_count >= traversal->max_ready_batches) {
+        aws_condition_variable_wait(&traversal->signal, &traversal->lock);
+    }
+
+    if (traversal->stopped) {
+        s_batch_destroy(traversal->allocator, batch);
+        return;
+    }
+
+    aws_linked_list_push_back(&traversal->ready_batches, &batch->node);
+    ++traversal->ready_batch_count;
+    aws_condition_variable_notify_all(&traversal->signal);
+}
+
+static void s_stop_locked(struct parallel_traversal *traversal, int error_code) {
+    if (!traversal->stopped) {
+        traversal->stopped = true;
+        traversal->error_code = error_code;
+    }
+    aws_condition_variable_notify_all(&traversal->signal);
+}
+
+/* Lists one directory, queueing its subdirectories and adding the entries that pass the filters to *batch */
+static int s_list_directory(
+    struct parallel_traversal *traversal,
+    const struct parallel_traversal_directory *directory,
+    struct parallel_traversal_batch **batch) {
+
+    struct aws_allocator *allocator = traversal->allocator;
+    struct aws_directory_iterator *iterator = aws_directory_entry_iterator_for_path(allocator, directory->path);
+    if (iterator == NULL) {
+        return aws_last_error();
+    }
+
+    for (const struct aws_directory_entry *entry = aws_directory_entry_iterator_get_value(iterator); entry != NULL;
+         entry = aws_directory_entry_iterator_next(iterator) == AWS_OP_SUCCESS
+                     ? aws_directory_entry_iterator_get_value(iterator)
+                     : NULL) {
+
+        struct aws_string *relative_path =
+            s_join_relative_path(allocator, directory->relative_path, s_file_name(entry->relative_path));
+
+        /* symlinks are reported, but not followed, as in aws_directory_traverse() */
+        if (traversal->recursive && (entry->file_type & AWS_FILE_TYPE_DIRECTORY) != 0 &&
+            (entry->file_type & AWS_FILE_TYPE_SYM_LINK) == 0) {
+            struct parallel_traversal_directory *subdirectory =
+                aws_mem_calloc(allocator, 1, sizeof(struct parallel_traversal_directory));
+            subdirectory->path = aws_string_new_from_cursor(allocator, &entry->path);
+            subdirectory->relative_path = aws_string_new_from_string(allocator, relative_path);
+
+            aws_mutex_lock(&traversal->lock);
+            aws_linked_list_push_back(&traversal->pending_directories, &subdirectory->node);
+            aws_condition_variable_notify_one(&traversal->signal);
+            aws_mutex_unlock(&traversal->lock);
+        }
+
+        if (!s_entry_passes_filters(traversal, entry)) {
+            aws_string_destroy(relative_path);
+            continue;
+        }
+
+        struct parallel_traversal_entry batch_entry = {
+            .path = aws_string_new_from_cursor(allocator, &entry->path),
+            .relative_path = relative_path,
+            .file_size = entry->file_size,
+            .file_type = entry->file_type,
+        };
+        /* the one stat() the entry gets beyond the iterator's, so callers don't need to make their own */
+        batch_entry.last_modified_ms = s_last_modified_ms(batch_entry.path);
+
+        if (*batch == NULL) {
+            *batch = s_batch_new(traversal);
+        }
+        aws_array_list_push_back(&(*batch)->entries, &batch_entry);
+
+        if (aws_array_list_length(&(*batch)->entries) >= traversal->batch_size) {
+            aws_mutex_lock(&traversal->lock);
+            s_submit_batch_locked(traversal, *batch);
+            bool stopped = traversal->stopped;
+            aws_mutex_unlock(&traversal->lock);
+
+            *batch = NULL;
+            if (stopped) {
+                break;
+            }
+        }
+    }
+
+    aws_directory_entry_iterator_destroy(iterator);
+    return AWS_ERROR_SUCCESS;
+}
+
+static void s_traversal_worker(void *arg) {
+    struct parallel_traversal *traversal = arg;
+    struct parallel_traversal_batch *batch = NULL;
+
+    aws_mutex_lock(&traversal->lock);
+    while (true) {
+        /* an empty queue only means the traversal is done once no busy worker can add to it */
+        while (!traversal->stopped && aws_linked_list_empty(&traversal->pending_directories) &&
+               traversal->busy_workers > 0) {
+            aws_condition_variable_wait(&traversal->signal, &traversal->lock);
+        }
+
+        if (traversal->stopped || aws_linked_list_empty(&traversal->pending_directories)) {
+            break;
+        }
+
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(&traversal->pending_directories);
+        struct parallel_traversal_directory *directory =
+            AWS_CONTAINER_OF(node, struct parallel_traversal_directory, node);
+        ++traversal->busy_workers;
+        aws_mutex_unlock(&traversal->lock);
+
+        int error_code = s_list_directory(traversal, directory, &batch);
+        s_directory_destroy(traversal->allocator, directory);
+
+        aws_mutex_lock(&traversal->lock);
+        --traversal->busy_workers;
+        if (error_code != AWS_ERROR_SUCCESS) {
+            s_stop_locked(traversal, error_code);
+        } else if (batch != NULL && aws_linked_list_empty(&traversal->pending_directories)) {
+            /* nothing left to fill it from right away, so don't hold back what this worker found */
+            s_submit_batch_locked(traversal, batch);
+            batch = NULL;
+        }
+        aws_condition_variable_notify_all(&traversal->signal);
+    }
+
+    if (batch != NULL) {
+        if (traversal->stopped) {
+            s_batch_destroy(traversal->allocator, batch);
+        } else {
+            s_submit_batch_locked(traversal, batch);
+        }
+    }
+    --traversal->running_workers;
+    aws_condition_variable_notify_all(&traversal->signal);
+    aws_mutex_unlock(&traversal->lock);
+}
+
+/* Returns false if the traversal should stop, leaving any exception the handler threw pending */
+static bool s_deliver_batch(JNIEnv *env, jobject handler, const struct parallel_traversal_batch *batch) {
+    struct aws_allocator *allocator = aws_jni_get_allocator();
+    size_t entry_count = aws_array_list_length(&batch->entries);
+    bool result = false;
+
+    jobjectArray paths = (*env)->NewObjectArray(env, (jsize)entry_count, string_properties.string_class, NULL);
+    jobjectArray relative_paths =
+        (*env)->NewObjectArray(env, (jsize)entry_count, string_properties.string_class, NULL);
+    jlongArray file_sizes = (*env)->NewLongArray(env, (jsize)entry_count);
+    jlongArray last_modified_times = (*env)->NewLongArray(env, (jsize)entry_count);
+    jintArray file_types = (*env)->NewIntArray(env, (jsize)entry_count);
+    jobject batch_object = NULL;
+
+    jlong *long_values = aws_mem_calloc(allocator, entry_count * 2, sizeof(jlong));
+    jint *int_values = aws_mem_calloc(allocator, entry_count, sizeof(jint));
+
+    if (paths == NULL || relative_paths == NULL || file_sizes == NULL || last_modified_times == NULL ||
+        file_types == NULL) {
+        /* an OutOfMemoryError is pending */
+        goto done;
+    }
+
+    for (size_t i = 0; i < entry_count; ++i) {
+        struct parallel_traversal_entry *entry = NULL;
+        aws_array_list_get_at_ptr(&batch->entries, (void **)&entry, i);
+
+        jstring path = aws_jni_string_from_string(env, entry->path);
+        (*env)->SetObjectArrayElement(env, paths, (jsize)i, path);
+        (*env)->DeleteLocalRef(env, path);
+
+        jstring relative_path = aws_jni_string_from_string(env, entry->relative_path);
+        (*env)->SetObjectArrayElement(env, relative_paths, (jsize)i, relative_path);
+        (*env)->DeleteLocalRef(env, relative_path);
+
+        if ((*env)->ExceptionCheck(env)) {
+            goto done;
+        }
+
+        long_values[i] = (jlong)entry->file_size;
+        long_values[entry_count + i] = (jlong)entry->last_modified_ms;
+        int_values[i] = (jint)entry->file_type;
+    }
+
+    (*env)->SetLongArrayRegion(env, file_sizes, 0, (jsize)entry_count, long_values);
+    (*env)->SetLongArrayRegion(env, last_modified_times, 0, (jsize)entry_count, long_values + entry_count);
+    (*env)->SetIntArrayRegion(env, file_types, 0, (jsize)entry_count, int_values);
+
+    batch_object = (*env)->NewObject(
+        env,
+        directory_entry_batch_properties.directory_entry_batch_class,
+        directory_entry_batch_properties.directory_entry_batch_constructor_method_id,
+        paths,
+        relative_paths,
+        file_sizes,
+        last_modified_times,
+        file_types);
+    if ((*env)->ExceptionCheck(env) || batch_object == NULL) {
+        goto done;
+    }
+
+    jboolean callback_result = (*env)->CallBooleanMethod(
+        env, handler, directory_entry_batch_handler_properties.on_directory_entries_method_id, batch_object);
+
+    /* as in the serial traversal, an exception thrown by the handler cancels the traversal */
+    result = !(*env)->ExceptionCheck(env) && callback_result;
+
+done:
+
+    aws_mem_release(allocator, long_values);
+    aws_mem_release(allocator, int_values);
+
+    if (batch_object != NULL) {
+        (*env)->DeleteLocalRef(env, batch_object);
+    }
+    if (paths != NULL) {
+        (*env)->DeleteLocalRef(env, paths);
+    }
+    if (relative_paths != NULL) {
+        (*env)->DeleteLocalRef(env, relative_paths);
+    }
+    if (file_sizes != NULL) {
+        (*env)->DeleteLocalRef(env, file_sizes);
+    }
+    if (last_modified_times != NULL) {
+        (*env)->DeleteLocalRef(env, last_modified_times);
+    }
+    if (file_types != NULL) {
+        (*env)->DeleteLocalRef(env, file_types);
+    }
+
+    return result;
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_io_DirectoryTraversal_crtTraverseParallel(
+    JNIEnv *env,
+    jclass jni_class,
+    jstring path,
+    jboolean recursive,
+    jint thread_count,
+    jint batch_size,
+    jstring file_name_glob,
+    jlong min_file_size,
+    jlong max_file_size,
+    jboolean include_directories,
+    jobject handler) {
+    (void)jni_class;
+
+    struct aws_allocator *allocator = aws_jni_get_allocator();
+
+    if (batch_size <= 0) {
+        aws_jni_throw_illegal_argument_exception(env, "DirectoryTraversal: batch size must be positive");
+        return;
+    }
+    if (thread_count <= 0) {
+        thread_count = 1;
+    }
+
+    struct aws_string *path_str = aws_jni_new_string_from_jstring(env, path);
+    if (path_str == NULL) {
+        aws_jni_throw_runtime_exception(env, "failed to get path string");
+        return;
+    }
+
+    struct parallel_traversal traversal = {
+        .allocator = allocator,
+        .recursive = recursive,
+        .include_directories = include_directories,
+        .min_file_size = min_file_size,
+        .max_file_size = max_file_size,
+        .batch_size = (size_t)batch_size,
+        .max_ready_batches = (size_t)thread_count * 2,
+        .lock = AWS_MUTEX_INIT,
+        .signal = AWS_CONDITION_VARIABLE_INIT,
+    };
+    aws_linked_list_init(&traversal.pending_directories);
+    aws_linked_list_init(&traversal.ready_batches);
+
+    if (file_name_glob != NULL) {
+        traversal.file_name_glob = aws_jni_new_string_from_jstring(env, file_name_glob);
+        if (traversal.file_name_glob == NULL) {
+            aws_jni_throw_runtime_exception(env, "failed to get file name glob string");
+            aws_string_destroy(path_str);
+            return;
+        }
+    }
+
+    struct parallel_traversal_directory *root =
+        aws_mem_calloc(allocator, 1, sizeof(struct parallel_traversal_directory));
+    root->path = path_str;
+    aws_linked_list_push_back(&traversal.pending_directories, &root->node);
+
+    struct aws_thread_options thread_options = *aws_default_thread_options();
+    thread_options.name = aws_byte_cursor_from_c_str("AwsDirTraverse");
+
+    struct aws_thread *threads = aws_mem_calloc(allocator, (size_t)thread_count, sizeof(struct aws_thread));
+    size_t launched_count = 0;
+    for (jint i = 0; i < thread_count; ++i) {
+        struct aws_thread *thread = &threads[launched_count];
+        aws_thread_init(thread, allocator);
+
+        aws_mutex_lock(&traversal.lock);
+        ++traversal.running_workers;
+        aws_mutex_unlock(&traversal.lock);
+
+        if (aws_thread_launch(thread, s_traversal_worker, &traversal, &thread_options)) {
+            aws_mutex_lock(&traversal.lock);
+            --traversal.running_workers;
+            aws_mutex_unlock(&traversal.lock);
+            aws_thread_clean_up(thread);
+            continue;
+        }
+        ++launched_count;
+    }
+
+    if (launched_count == 0) {
+        /* no threads to be had, traverse on this one, with nobody to take batches until it's done */
+        traversal.running_workers = 1;
+        traversal.max_ready_batches = SIZE_MAX;
+        s_traversal_worker(&traversal);
+    }
+
+    /* hand each batch to Java as it's ready, until the workers are done and every batch is handed over */
+    aws_mutex_lock(&traversal.lock);
+    while (true) {
+        while (aws_linked_list_empty(&traversal.ready_batches) && traversal.running_workers > 0) {
+            aws_condition_variable_wait(&traversal.signal, &traversal.lock);
+        }
+
+        if (traversal.stopped || aws_linked_list_empty(&traversal.ready_batches)) {
+            break;
+        }
+
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(&traversal.ready_batches);
+        struct parallel_traversal_batch *batch = AWS_CONTAINER_OF(node, struct parallel_traversal_batch, node);
+        --traversal.ready_batch_count;
+        aws_condition_variable_notify_all(&traversal.signal);
+        aws_mutex_unlock(&traversal.lock);
+
+        bool keep_going = s_deliver_batch(env, handler, batch);
+        s_batch_destroy(allocator, batch);
+
+        aws_mutex_lock(&traversal.lock);
+        if (!keep_going) {
+            s_stop_locked(&traversal, AWS_ERROR_SUCCESS);
+            break;
+        }
+    }
+    aws_mutex_unlock(&traversal.lock);
+
+    for (size_t i = 0; i < launched_count; ++i) {
+        aws_thread_join(&threads[i]);
+        aws_thread_clean_up(&threads[i]);
+    }
+    aws_mem_release(allocator, threads);
+
+    /* whatever a stopped traversal left behind */
+    while (!aws_linked_list_empty(&traversal.ready_batches)) {
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(&traversal.ready_batches);
+        s_batch_destroy(allocator, AWS_CONTAINER_OF(node, struct parallel_traversal_batch, node));
+    }
+    while (!aws_linked_list_empty(&traversal.pending_directories)) {
+        struct aws_linked_list_node *node = aws_linked_list_pop_front(&traversal.pending_directories);
+        s_directory_destroy(allocator, AWS_CONTAINER_OF(node, struct parallel_traversal_directory, node));
+    }
+
+    if (traversal.stopped) {
+        /* If there's already a Java exception being thrown from the handler, then we don't need to throw another */
+        if (!(*env)->ExceptionCheck(env)) {
+            aws_jni_throw_runtime_exception(env, "Directory traversal failed");
+        }
+    }
+
+    aws_string_destroy(traversal.file_name_glob);
+    aws_mutex_clean_up(&traversal.lock);
+    aws_condition_variable_clean_up(&traversal.signal);
+}
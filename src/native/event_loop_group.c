@@ -64,7 +64,7 @@ static void s_event_loop_group_cleanup_completion_callback(void *user_data) {
         (*env)->DeleteGlobalRef(env, callback_data->java_event_loop_group);
 
         // We're done with this callback data, free it.
-        struct aws_allocator *allocator = aws_jni_get_allocator();
+        struct aws_allocator *allocator = aws_jni_io_allocator();
         aws_mem_release(allocator, callback_data);
 
         (*jvm)->DetachCurrentThread(jvm);
@@ -78,7 +78,7 @@ jlong JNICALL Java_software_amazon_awssdk_crt_io_EventLoopGroup_eventLoopGroupNe
     jobject elg_jobject,
     jint num_threads) {
     (void)jni_elg;
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
 
     struct event_loop_group_cleanup_callback_data *callback_data =
         aws_mem_acquire(allocator, sizeof(struct event_loop_group_cleanup_callback_data));
@@ -123,7 +123,7 @@ jlong JNICALL Java_software_amazon_awssdk_crt_io_EventLoopGroup_eventLoopGroupNe
     jint cpu_group,
     jint num_threads) {
     (void)jni_elg;
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
 
     struct event_loop_group_cleanup_callback_data *callback_data =
         aws_mem_acquire(allocator, sizeof(struct event_loop_group_cleanup_callback_data));
@@ -0,0 +1,270 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "event_loop_metrics.h"
+
+#include <jni.h>
+
+#include <aws/common/atomics.h>
+#include <aws/common/clock.h>
+#include <aws/common/ref_count.h>
+#include <aws/common/thread.h>
+#include <aws/io/event_loop.h>
+
+#include "crt.h"
+#include "latency_histogram.h"
+
+/* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(push)
+#        pragma warning(disable : 4305) /* 'type cast': truncation from 'jlong' to 'jni_tls_ctx_options *' */
+#    else
+#        pragma GCC diagnostic push
+#        pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
+#        pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+#    endif
+#endif
+
+struct event_loop_group_metrics;
+
+struct event_loop_metrics {
+    struct event_loop_group_metrics *group;
+    struct aws_event_loop *loop;
+    struct aws_task probe_task;
+    /* only touched by the probe, on the loop's thread */
+    uint64_t probe_run_at_ns;
+
+    struct aws_atomic_var busy_ns_last_second;
+    struct aws_atomic_var probes;
+    struct aws_atomic_var max_lateness_ns;
+    struct aws_jni_latency_histogram lateness;
+
+    struct aws_atomic_var upcalls;
+    struct aws_atomic_var upcall_ns;
+    struct aws_jni_latency_histogram upcall_duration;
+};
+
+struct event_loop_group_metrics {
+    struct aws_allocator *allocator;
+    /* held by the Java EventLoopGroup, and by each loop's probe while it's scheduled */
+    struct aws_ref_count ref_count;
+    /* set once the Java EventLoopGroup lets go, probes stop when they see it */
+    struct aws_atomic_var released;
+    size_t loop_count;
+    struct event_loop_metrics loops[];
+};
+
+/* Must match EventLoopGroupMetrics.java */
+enum event_loop_group_metric {
+    EVENT_LOOP_GROUP_METRIC_TIMESTAMP_NS,
+    EVENT_LOOP_GROUP_METRIC_LOOP_COUNT,
+    EVENT_LOOP_GROUP_METRIC_LOOPS,
+};
+
+/* Must match EventLoopMetrics.java; each loop's values follow the previous loop's */
+enum event_loop_metric {
+    EVENT_LOOP_METRIC_BUSY_NS_LAST_SECOND,
+    EVENT_LOOP_METRIC_PROBES,
+    EVENT_LOOP_METRIC_MAX_LATENESS_NS,
+    EVENT_LOOP_METRIC_UPCALLS,
+    EVENT_LOOP_METRIC_UPCALL_NS,
+    EVENT_LOOP_METRIC_LATENESS_HISTOGRAM,
+    EVENT_LOOP_METRIC_UPCALL_DURATION_HISTOGRAM =
+        EVENT_LOOP_METRIC_LATENESS_HISTOGRAM + AWS_JNI_LATENCY_HISTOGRAM_BUCKETS,
+    EVENT_LOOP_METRIC_COUNT = EVENT_LOOP_METRIC_UPCALL_DURATION_HISTOGRAM + AWS_JNI_LATENCY_HISTOGRAM_BUCKETS,
+};
+
+/* The loop whose thread this is, set by its probe; never set on any other thread */
+static AWS_THREAD_LOCAL struct event_loop_metrics *tl_loop_metrics = NULL;
+static AWS_THREAD_LOCAL size_t tl_upcall_depth = 0;
+static AWS_THREAD_LOCAL uint64_t tl_upcall_start_ns = 0;
+
+void aws_jni_event_loop_metrics_upcall_begin(void) {
+    if (AWS_LIKELY(tl_loop_metrics == NULL)) {
+        return;
+    }
+    if (tl_upcall_depth++ == 0) {
+        aws_high_res_clock_get_ticks(&tl_upcall_start_ns);
+    }
+}
+
+void aws_jni_event_loop_metrics_upcall_end(void) {
+    struct event_loop_metrics *loop_metrics = tl_loop_metrics;
+    if (AWS_LIKELY(loop_metrics == NULL) || tl_upcall_depth == 0) {
+        return;
+    }
+    if (--tl_upcall_depth > 0) {
+        return;
+    }
+
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+    uint64_t duration_ns = now_ns > tl_upcall_start_ns ? now_ns - tl_upcall_start_ns : 0;
+
+    aws_atomic_fetch_add(&loop_metrics->upcalls, 1);
+    aws_atomic_fetch_add(&loop_metrics->upcall_ns, (size_t)duration_ns);
+    aws_jni_latency_histogram_record_ns(&loop_metrics->upcall_duration, duration_ns);
+}
+
+static void s_event_loop_group_metrics_destroy(void *user_data) {
+    struct event_loop_group_metrics *metrics = user_data;
+    aws_mem_release(metrics->allocator, metrics);
+}
+
+static void s_probe_task(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+    struct event_loop_metrics *loop_metrics = arg;
+    struct event_loop_group_metrics *metrics = loop_metrics->group;
+
+    if (status != AWS_TASK_STATUS_RUN_READY) {
+        /* The loop is being destroyed, its thread has already stopped */
+        aws_ref_count_release(&metrics->ref_count);
+        return;
+    }
+
+    if (aws_atomic_load_int(&metrics->released)) {
+        if (tl_loop_metrics == loop_metrics) {
+            tl_loop_metrics = NULL;
+            tl_upcall_depth = 0;
+        }
+        aws_ref_count_release(&metrics->ref_count);
+        return;
+    }
+
+    tl_loop_metrics = loop_metrics;
+
+    uint64_t now_ns = 0;
+    aws_event_loop_current_clock_time(loop_metrics->loop, &now_ns);
+    uint64_t lateness_ns = now_ns > loop_metrics->probe_run_at_ns ? now_ns - loop_metrics->probe_run_at_ns : 0;
+
+    aws_jni_latency_histogram_record_ns(&loop_metrics->lateness, lateness_ns);
+    /* only this thread writes it */
+    if (lateness_ns > aws_atomic_load_int(&loop_metrics->max_lateness_ns)) {
+        aws_atomic_store_int(&loop_metrics->max_lateness_ns, (size_t)lateness_ns);
+    }
+    aws_atomic_store_int(&loop_metrics->busy_ns_last_second, aws_event_loop_get_load_factor(loop_metrics->loop));
+    aws_atomic_fetch_add(&loop_metrics->probes, 1);
+
+    uint64_t interval_ns = aws_timestamp_convert(
+        AWS_JNI_EVENT_LOOP_PROBE_INTERVAL_MS, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+    loop_metrics->probe_run_at_ns = now_ns + interval_ns;
+    aws_event_loop_schedule_task_future(loop_metrics->loop, &loop_metrics->probe_task, loop_metrics->probe_run_at_ns);
+}
+
+JNIEXPORT
+jlong JNICALL Java_software_amazon_awssdk_crt_io_EventLoopGroupMetrics_metricsNew(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_elg) {
+    (void)jni_class;
+
+    struct aws_event_loop_group *elg = (struct aws_event_loop_group *)jni_elg;
+    if (elg == NULL) {
+        aws_jni_throw_runtime_exception(env, "EventLoopGroupMetrics.metricsNew: Invalid EventLoopGroup");
+        return (jlong)NULL;
+    }
+
+    struct aws_allocator *allocator = aws_jni_io_allocator();
+    size_t loop_count = aws_event_loop_group_get_loop_count(elg);
+    struct event_loop_group_metrics *metrics = aws_mem_calloc(
+        allocator, 1, sizeof(struct event_loop_group_metrics) + loop_count * sizeof(struct event_loop_metrics));
+    metrics->allocator = allocator;
+    metrics->loop_count = loop_count;
+    aws_atomic_init_int(&metrics->released, 0);
+    aws_ref_count_init(&metrics->ref_count, metrics, s_event_loop_group_metrics_destroy);
+
+    for (size_t i = 0; i < loop_count; ++i) {
+        struct event_loop_metrics *loop_metrics = &metrics->loops[i];
+        loop_metrics->group = metrics;
+        loop_metrics->loop = aws_event_loop_group_get_loop_at(elg, i);
+        aws_atomic_init_int(&loop_metrics->busy_ns_last_second, 0);
+        aws_atomic_init_int(&loop_metrics->probes, 0);
+        aws_atomic_init_int(&loop_metrics->max_lateness_ns, 0);
+        aws_atomic_init_int(&loop_metrics->upcalls, 0);
+        aws_atomic_init_int(&loop_metrics->upcall_ns, 0);
+        aws_jni_latency_histogram_init(&loop_metrics->lateness);
+        aws_jni_latency_histogram_init(&loop_metrics->upcall_duration);
+        aws_task_init(&loop_metrics->probe_task, s_probe_task, loop_metrics, "EventLoopMetricsProbe");
+
+        aws_ref_count_acquire(&metrics->ref_count);
+        aws_event_loop_current_clock_time(loop_metrics->loop, &loop_metrics->probe_run_at_ns);
+        aws_event_loop_schedule_task_future(
+            loop_metrics->loop, &loop_metrics->probe_task, loop_metrics->probe_run_at_ns);
+    }
+
+    return (jlong)metrics;
+}
+
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_io_EventLoopGroupMetrics_metricsRelease(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_metrics) {
+    (void)env;
+    (void)jni_class;
+
+    struct event_loop_group_metrics *metrics = (struct event_loop_group_metrics *)jni_metrics;
+    if (metrics == NULL) {
+        return;
+    }
+
+    aws_atomic_store_int(&metrics->released, 1);
+    aws_ref_count_release(&metrics->ref_count);
+}
+
+JNIEXPORT
+jlongArray JNICALL Java_software_amazon_awssdk_crt_io_EventLoopGroupMetrics_metricsSnapshot(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_metrics) {
+    (void)jni_class;
+
+    struct event_loop_group_metrics *metrics = (struct event_loop_group_metrics *)jni_metrics;
+    if (metrics == NULL) {
+        aws_jni_throw_runtime_exception(env, "EventLoopGroupMetrics.snapshot: Invalid metrics");
+        return NULL;
+    }
+
+    size_t value_count = EVENT_LOOP_GROUP_METRIC_LOOPS + metrics->loop_count * EVENT_LOOP_METRIC_COUNT;
+    int64_t *values = aws_mem_calloc(metrics->allocator, value_count, sizeof(int64_t));
+
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+    values[EVENT_LOOP_GROUP_METRIC_TIMESTAMP_NS] = (int64_t)now_ns;
+    values[EVENT_LOOP_GROUP_METRIC_LOOP_COUNT] = (int64_t)metrics->loop_count;
+
+    for (size_t i = 0; i < metrics->loop_count; ++i) {
+        struct event_loop_metrics *loop_metrics = &metrics->loops[i];
+        int64_t *loop_values = values + EVENT_LOOP_GROUP_METRIC_LOOPS + i * EVENT_LOOP_METRIC_COUNT;
+
+        loop_values[EVENT_LOOP_METRIC_BUSY_NS_LAST_SECOND] =
+            (int64_t)aws_atomic_load_int(&loop_metrics->busy_ns_last_second);
+        loop_values[EVENT_LOOP_METRIC_PROBES] = (int64_t)aws_atomic_load_int(&loop_metrics->probes);
+        loop_values[EVENT_LOOP_METRIC_MAX_LATENESS_NS] = (int64_t)aws_atomic_load_int(&loop_metrics->max_lateness_ns);
+        loop_values[EVENT_LOOP_METRIC_UPCALLS] = (int64_t)aws_atomic_load_int(&loop_metrics->upcalls);
+        loop_values[EVENT_LOOP_METRIC_UPCALL_NS] = (int64_t)aws_atomic_load_int(&loop_metrics->upcall_ns);
+        aws_jni_latency_histogram_snapshot(&loop_metrics->lateness, &loop_values[EVENT_LOOP_METRIC_LATENESS_HISTOGRAM]);
+        aws_jni_latency_histogram_snapshot(
+            &loop_metrics->upcall_duration, &loop_values[EVENT_LOOP_METRIC_UPCALL_DURATION_HISTOGRAM]);
+    }
+
+    jlongArray jni_values = (*env)->NewLongArray(env, (jsize)value_count);
+    if (jni_values != NULL) {
+        (*env)->SetLongArrayRegion(env, jni_values, 0, (jsize)value_count, (const jlong *)values);
+    }
+    /* else OutOfMemoryError is pending */
+
+    aws_mem_release(metrics->allocator, values);
+    return jni_values;
+}
+
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(pop)
+#    else
+#        pragma GCC diagnostic pop
+#    endif
+#endif
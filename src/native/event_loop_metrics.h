@@ -0,0 +1,26 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_EVENT_LOOP_METRICS_H
+#define AWS_JNI_CRT_EVENT_LOOP_METRICS_H
+
+/*
+ * Per-loop statistics behind EventLoopGroup.getMetrics().
+ *
+ * aws-c-io keeps no task statistics a binding can read, so each loop runs a probe task: rescheduled every
+ * AWS_JNI_EVENT_LOOP_PROBE_INTERVAL_MS, it records how late it ran (the lateness any scheduled task would see) and the
+ * loop's load factor, the time it spent busy over the last second. The probe also marks its thread as that loop's, so
+ * the upcall hooks below can time the JNI upcalls made from it.
+ */
+#define AWS_JNI_EVENT_LOOP_PROBE_INTERVAL_MS 100
+
+/*
+ * Time the upcall between a successful aws_jni_acquire_thread_env() and its aws_jni_release_thread_env(); only the
+ * outermost pair counts. They do nothing except on event loop threads of a group with metrics.
+ */
+void aws_jni_event_loop_metrics_upcall_begin(void);
+void aws_jni_event_loop_metrics_upcall_end(void);
+
+#endif /* AWS_JNI_CRT_EVENT_LOOP_METRICS_H */
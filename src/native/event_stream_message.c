@@ -5,6 +5,8 @@
 
 #include <jni.h>
 
+#include <aws/checksums/crc.h>
+#include <aws/common/atomics.h>
 #include <aws/event-stream/event_stream.h>
 
 #include "crt.h"
@@ -23,6 +25,87 @@
 #    endif
 #endif
 
+/*
+ * A message whose wire encoding was written once, straight from the Java headers and payload, into storage the
+ * message wraps instead of copying.
+ */
+struct aws_jni_event_stream_message {
+    /* must be first, the handle Java holds points at it */
+    struct aws_event_stream_message message;
+    struct aws_byte_buf encoded;
+};
+
+static void s_event_stream_message_destroy(struct aws_jni_event_stream_message *jni_message) {
+    aws_event_stream_message_clean_up(&jni_message->message);
+    aws_byte_buf_clean_up(&jni_message->encoded);
+    aws_mem_release(aws_jni_event_stream_allocator(), jni_message);
+}
+
+/*
+ * Allocates the message's storage and writes its prelude; the caller writes exactly headers_length bytes of headers
+ * (already in wire format) then payload_length bytes of payload, and calls s_event_stream_message_finish().
+ */
+static struct aws_jni_event_stream_message *s_event_stream_message_begin(
+    JNIEnv *env,
+    size_t headers_length,
+    size_t payload_length) {
+
+    uint64_t total_length = (uint64_t)AWS_EVENT_STREAM_PRELUDE_LENGTH + headers_length + payload_length +
+                            (uint64_t)AWS_EVENT_STREAM_TRAILER_LENGTH;
+    if (headers_length > AWS_EVENT_STREAM_MAX_HEADERS_SIZE || total_length > AWS_EVENT_STREAM_MAX_MESSAGE_SIZE) {
+        aws_jni_throw_illegal_argument_exception(env, "Message.MessageNew: message exceeds the maximum size");
+        return NULL;
+    }
+
+    struct aws_allocator *allocator = aws_jni_event_stream_allocator();
+    struct aws_jni_event_stream_message *jni_message =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_jni_event_stream_message));
+    aws_byte_buf_init(&jni_message->encoded, allocator, (size_t)total_length);
+
+    struct aws_byte_buf *encoded = &jni_message->encoded;
+    aws_byte_buf_write_be32(encoded, (uint32_t)total_length);
+    aws_byte_buf_write_be32(encoded, (uint32_t)headers_length);
+    aws_byte_buf_write_be32(encoded, aws_checksums_crc32(encoded->buffer, (int)encoded->len, 0));
+
+    return jni_message;
+}
+
+/* Copies a Java array straight into the message, without pinning or copying it through the JVM first */
+static int s_event_stream_message_write_array(
+    JNIEnv *env,
+    struct aws_jni_event_stream_message *jni_message,
+    jbyteArray array) {
+
+    struct aws_byte_buf *encoded = &jni_message->encoded;
+    jsize length = (*env)->GetArrayLength(env, array);
+    if ((size_t)length > encoded->capacity - encoded->len) {
+        aws_jni_throw_illegal_argument_exception(env, "Message.MessageNew: array changed size");
+        return AWS_OP_ERR;
+    }
+
+    (*env)->GetByteArrayRegion(env, array, 0, length, (jbyte *)(encoded->buffer + encoded->len));
+    if ((*env)->ExceptionCheck(env)) {
+        return AWS_OP_ERR;
+    }
+    encoded->len += (size_t)length;
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Writes the trailer and hands the encoded bytes to the message, which wraps them instead of copying */
+static jlong s_event_stream_message_finish(JNIEnv *env, struct aws_jni_event_stream_message *jni_message) {
+    struct aws_byte_buf *encoded = &jni_message->encoded;
+    aws_byte_buf_write_be32(encoded, aws_checksums_crc32(encoded->buffer, (int)encoded->len, 0));
+
+    if (aws_event_stream_message_from_buffer(&jni_message->message, aws_jni_event_stream_allocator(), encoded)) {
+        aws_jni_throw_runtime_exception(env, "Message.MessageNew: encoding failed!");
+        s_event_stream_message_destroy(jni_message);
+        return (jlong)NULL;
+    }
+
+    return (jlong)&jni_message->message;
+}
+
 JNIEXPORT
 jlong JNICALL Java_software_amazon_awssdk_crt_eventstream_Message_messageNew(
     JNIEnv *env,
@@ -31,37 +114,64 @@ jlong JNICALL Java_software_amazon_awssdk_crt_eventstream_Message_messageNew(
     jbyteArray payload) {
     (void)jni_class;
 
-    struct aws_event_stream_message *message =
-        aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct aws_event_stream_message));
+    size_t headers_length = headers ? (size_t)(*env)->GetArrayLength(env, headers) : 0;
+    size_t payload_length = payload ? (size_t)(*env)->GetArrayLength(env, payload) : 0;
 
-    if (!message) {
-        aws_jni_throw_runtime_exception(env, "Message.MessageNew: Allocation failed!");
+    struct aws_jni_event_stream_message *jni_message =
+        s_event_stream_message_begin(env, headers_length, payload_length);
+    if (jni_message == NULL) {
         return (jlong)NULL;
     }
 
-    struct aws_event_stream_message *return_message = NULL;
-
-    struct aws_event_stream_rpc_marshalled_message marshalled_message;
-    if (aws_event_stream_rpc_marshall_message_args_init(
-            &marshalled_message, aws_jni_get_allocator(), env, headers, payload, NULL, 0, 0)) {
-        goto clean_up;
+    if ((headers && s_event_stream_message_write_array(env, jni_message, headers)) ||
+        (payload && s_event_stream_message_write_array(env, jni_message, payload))) {
+        s_event_stream_message_destroy(jni_message);
+        return (jlong)NULL;
     }
 
-    if (aws_event_stream_message_init(
-            message, aws_jni_get_allocator(), &marshalled_message.headers_list, &marshalled_message.payload_buf)) {
-        goto clean_up;
+    return s_event_stream_message_finish(env, jni_message);
+}
+
+JNIEXPORT
+jlong JNICALL Java_software_amazon_awssdk_crt_eventstream_Message_messageNewDirect(
+    JNIEnv *env,
+    jclass jni_class,
+    jbyteArray headers,
+    jobject payload,
+    jint position,
+    jint length) {
+    (void)jni_class;
+
+    if (payload == NULL) {
+        aws_jni_throw_null_pointer_exception(env, "Message.MessageNew: payload buffer is null");
+        return (jlong)NULL;
     }
 
-    return_message = message;
+    uint8_t *address = (*env)->GetDirectBufferAddress(env, payload);
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, payload);
+    if (address == NULL || capacity < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "Message.MessageNew: payload buffer is not direct");
+        return (jlong)NULL;
+    }
+    if (position < 0 || length < 0 || (jlong)position + (jlong)length > capacity) {
+        aws_jni_throw_illegal_argument_exception(env, "Message.MessageNew: payload range is out of bounds");
+        return (jlong)NULL;
+    }
 
-clean_up:
-    aws_event_stream_rpc_marshall_message_args_clean_up(&marshalled_message);
+    size_t headers_length = headers ? (size_t)(*env)->GetArrayLength(env, headers) : 0;
+    struct aws_jni_event_stream_message *jni_message =
+        s_event_stream_message_begin(env, headers_length, (size_t)length);
+    if (jni_message == NULL) {
+        return (jlong)NULL;
+    }
 
-    if (!return_message) {
-        aws_mem_release(aws_jni_get_allocator(), message);
+    if (headers && s_event_stream_message_write_array(env, jni_message, headers)) {
+        s_event_stream_message_destroy(jni_message);
+        return (jlong)NULL;
     }
+    aws_byte_buf_write(&jni_message->encoded, address + position, (size_t)length);
 
-    return (jlong)return_message;
+    return s_event_stream_message_finish(env, jni_message);
 }
 
 JNIEXPORT
@@ -71,9 +181,8 @@ void JNICALL Java_software_amazon_awssdk_crt_eventstream_Message_messageDelete(
     jlong message_ptr) {
     (void)env;
     (void)jni_class;
-    struct aws_event_stream_message *message = (struct aws_event_stream_message *)message_ptr;
-    aws_event_stream_message_clean_up(message);
-    aws_mem_release(aws_jni_get_allocator(), message);
+    struct aws_jni_event_stream_message *jni_message = (struct aws_jni_event_stream_message *)message_ptr;
+    s_event_stream_message_destroy(jni_message);
 }
 
 JNIEXPORT
@@ -177,6 +286,175 @@ void aws_event_stream_rpc_marshall_message_args_clean_up(struct aws_event_stream
     }
 }
 
+/* Shared by every message of a batch, so the batch costs one allocation and one global reference */
+struct message_batch_flush_args {
+    JavaVM *jvm;
+    jobject callback;
+    /* messages sent and not yet flushed, plus one held by the sending thread until it has sent them all */
+    struct aws_atomic_var pending;
+    struct aws_atomic_var error_code;
+};
+
+static void s_message_batch_flush_args_release(struct message_batch_flush_args *batch_args, int error_code) {
+    if (error_code != AWS_ERROR_SUCCESS) {
+        size_t expected = AWS_ERROR_SUCCESS;
+        aws_atomic_compare_exchange_int(&batch_args->error_code, &expected, (size_t)error_code);
+    }
+
+    if (aws_atomic_fetch_sub(&batch_args->pending, 1) != 1) {
+        return;
+    }
+
+    /********** JNI ENV ACQUIRE **********/
+    JNIEnv *env = aws_jni_acquire_thread_env(batch_args->jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        return;
+    }
+
+    (*env)->CallVoidMethod(
+        env,
+        batch_args->callback,
+        event_stream_server_message_flush_properties.callback,
+        (jint)aws_atomic_load_int(&batch_args->error_code));
+    aws_jni_check_and_clear_exception(env);
+
+    JavaVM *jvm = batch_args->jvm;
+    (*env)->DeleteGlobalRef(env, batch_args->callback);
+    aws_mem_release(aws_jni_event_stream_allocator(), batch_args);
+
+    aws_jni_release_thread_env(jvm, env);
+    /********** JNI ENV RELEASE **********/
+}
+
+static void s_message_batch_flush_fn(int error_code, void *user_data) {
+    s_message_batch_flush_args_release(user_data, error_code);
+}
+
+/* Marshals and sends message i of the batch, returning AWS_OP_ERR with an exception pending if it fails */
+static int s_send_batched_message(
+    JNIEnv *env,
+    void *continuation,
+    aws_jni_event_stream_send_message_fn *send_fn,
+    jbyteArray headers,
+    jbyteArray payload,
+    jint message_type,
+    jint message_flags,
+    struct message_batch_flush_args *batch_args) {
+
+    struct aws_event_stream_rpc_marshalled_message marshalled_message;
+    if (aws_event_stream_rpc_marshall_message_args_init(
+            &marshalled_message,
+            aws_jni_event_stream_allocator(),
+            env,
+            headers,
+            payload,
+            NULL,
+            message_flags,
+            message_type)) {
+        return AWS_OP_ERR;
+    }
+
+    aws_atomic_fetch_add(&batch_args->pending, 1);
+    int result = send_fn(continuation, &marshalled_message.message_args, s_message_batch_flush_fn, batch_args);
+    if (result) {
+        aws_atomic_fetch_sub(&batch_args->pending, 1);
+        aws_jni_throw_crt_error(env, aws_last_error());
+    }
+
+    aws_event_stream_rpc_marshall_message_args_clean_up(&marshalled_message);
+    return result;
+}
+
+int aws_jni_event_stream_send_message_batch(
+    JNIEnv *env,
+    void *continuation,
+    aws_jni_event_stream_send_message_fn *send_fn,
+    jobjectArray headers,
+    jobjectArray payloads,
+    jintArray message_types,
+    jintArray message_flags,
+    jobject callback) {
+
+    if (continuation == NULL) {
+        aws_jni_throw_runtime_exception(env, "sendMessages: native continuation is NULL.");
+        return AWS_OP_ERR;
+    }
+
+    jsize count = (*env)->GetArrayLength(env, payloads);
+    if (count == 0 || (*env)->GetArrayLength(env, headers) != count ||
+        (*env)->GetArrayLength(env, message_types) != count || (*env)->GetArrayLength(env, message_flags) != count) {
+        aws_jni_throw_illegal_argument_exception(env, "sendMessages: malformed message batch");
+        return AWS_OP_ERR;
+    }
+
+    struct message_batch_flush_args *batch_args =
+        aws_mem_calloc(aws_jni_event_stream_allocator(), 1, sizeof(struct message_batch_flush_args));
+    aws_atomic_init_int(&batch_args->pending, 1);
+    aws_atomic_init_int(&batch_args->error_code, AWS_ERROR_SUCCESS);
+
+    if ((*env)->GetJavaVM(env, &batch_args->jvm) != 0) {
+        aws_jni_throw_runtime_exception(env, "sendMessages: Unable to get JVM");
+        goto error;
+    }
+
+    batch_args->callback = (*env)->NewGlobalRef(env, callback);
+    if (batch_args->callback == NULL) {
+        aws_jni_throw_runtime_exception(env, "sendMessages: Unable to create global ref to callback");
+        goto error;
+    }
+
+    jint *types = (*env)->GetIntArrayElements(env, message_types, NULL);
+    jint *flags = (*env)->GetIntArrayElements(env, message_flags, NULL);
+
+    jsize sent = 0;
+    int error_code = AWS_ERROR_SUCCESS;
+    for (; types != NULL && flags != NULL && sent < count; ++sent) {
+        jbyteArray message_headers = (*env)->GetObjectArrayElement(env, headers, sent);
+        jbyteArray message_payload = (*env)->GetObjectArrayElement(env, payloads, sent);
+
+        int result = s_send_batched_message(
+            env, continuation, send_fn, message_headers, message_payload, types[sent], flags[sent], batch_args);
+
+        if (message_payload != NULL) {
+            (*env)->DeleteLocalRef(env, message_payload);
+        }
+        if (message_headers != NULL) {
+            (*env)->DeleteLocalRef(env, message_headers);
+        }
+
+        if (result) {
+            error_code = aws_last_error() != AWS_ERROR_SUCCESS ? aws_last_error() : AWS_ERROR_UNKNOWN;
+            break;
+        }
+    }
+
+    if (flags != NULL) {
+        (*env)->ReleaseIntArrayElements(env, message_flags, flags, JNI_ABORT);
+    }
+    if (types != NULL) {
+        (*env)->ReleaseIntArrayElements(env, message_types, types, JNI_ABORT);
+    }
+
+    if (sent == 0) {
+        goto error;
+    }
+
+    /* some messages are on their way, so the failure is reported through the callback along with theirs */
+    if (sent < count) {
+        aws_jni_check_and_clear_exception(env);
+    }
+    s_message_batch_flush_args_release(batch_args, error_code);
+    return AWS_OP_SUCCESS;
+
+error:
+    if (batch_args->callback != NULL) {
+        (*env)->DeleteGlobalRef(env, batch_args->callback);
+    }
+    aws_mem_release(aws_jni_event_stream_allocator(), batch_args);
+    return AWS_OP_ERR;
+}
+
 jbyteArray aws_event_stream_rpc_marshall_headers_to_byteArray(
     struct aws_allocator *allocator,
     JNIEnv *env,
@@ -31,6 +31,32 @@ int aws_event_stream_rpc_marshall_message_args_init(
 
 void aws_event_stream_rpc_marshall_message_args_clean_up(struct aws_event_stream_rpc_marshalled_message *message_args);
 
+/* Matches the flush callbacks of both client and server continuations */
+typedef void(aws_jni_event_stream_message_flush_fn)(int error_code, void *user_data);
+
+/* Sends one message through a client or server continuation */
+typedef int(aws_jni_event_stream_send_message_fn)(
+    void *continuation,
+    const struct aws_event_stream_rpc_message_args *message_args,
+    aws_jni_event_stream_message_flush_fn *flush_fn,
+    void *user_data);
+
+/*
+ * Marshals and sends each message of a MessageBatch (parallel arrays of serialized headers, payloads, types and flags)
+ * through send_fn, then calls the Java MessageFlushCallback once, with the first error, when every message sent has
+ * flushed. Returns AWS_OP_ERR with an exception pending, and without calling the callback, if no message could be
+ * sent; if a later message can't be sent, the messages after it are dropped and the callback reports the error.
+ */
+int aws_jni_event_stream_send_message_batch(
+    JNIEnv *env,
+    void *continuation,
+    aws_jni_event_stream_send_message_fn *send_fn,
+    jobjectArray headers,
+    jobjectArray payloads,
+    jintArray message_types,
+    jintArray message_flags,
+    jobject callback);
+
 jbyteArray aws_event_stream_rpc_marshall_headers_to_byteArray(
     struct aws_allocator *allocator,
     JNIEnv *env,
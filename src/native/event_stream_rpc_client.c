@@ -10,9 +10,11 @@
 #include <aws/common/string.h>
 #include <aws/io/tls_channel_handler.h>
 
+#include "callback_dispatcher.h"
 #include "crt.h"
 #include "event_stream_message.h"
 #include "java_class_ids.h"
+#include "tls_handshake_metrics.h"
 
 #if defined(_MSC_VER)
 #    pragma warning(disable : 4204) /* non-constant aggregate initializer */
@@ -44,7 +46,7 @@ static void s_destroy_connection_callback_data(struct connection_callback_data *
         (*env)->DeleteGlobalRef(env, callback_data->java_connection_handler);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), callback_data);
+    aws_mem_release(aws_jni_event_stream_allocator(), callback_data);
 }
 
 static void s_on_connection_setup(
@@ -126,7 +128,7 @@ static void s_connection_protocol_message(
     }
 
     jbyteArray headers_array = aws_event_stream_rpc_marshall_headers_to_byteArray(
-        aws_jni_get_allocator(), env, message_args->headers, message_args->headers_count);
+        aws_jni_event_stream_allocator(), env, message_args->headers, message_args->headers_count);
 
     struct aws_byte_cursor payload_cur = aws_byte_cursor_from_buf(message_args->payload);
     jbyteArray payload_byte_array = aws_jni_byte_array_from_cursor(env, &payload_cur);
@@ -159,6 +161,7 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnection_client
     jlong jni_client_bootstrap,
     jobject jni_client_connection_handler) {
     (void)jni_class;
+    cache_java_class_ids_for_event_stream(env);
     struct aws_client_bootstrap *client_bootstrap = (struct aws_client_bootstrap *)jni_client_bootstrap;
     struct aws_socket_options *socket_options = (struct aws_socket_options *)jni_socket_options;
     struct aws_tls_ctx *tls_context = (struct aws_tls_ctx *)jni_tls_ctx;
@@ -179,11 +182,11 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnection_client
     struct aws_string *host_name_str = NULL;
 
     if (tls_context) {
-        aws_tls_connection_options_init_from_ctx(&connection_options, tls_context);
+        aws_jni_tls_connection_options_init_from_ctx(&connection_options, tls_context);
         conn_options_ptr = &connection_options;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_event_stream_allocator();
     struct connection_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct connection_callback_data));
 
@@ -332,7 +335,7 @@ static void s_destroy_message_flush_callback_args(JNIEnv *env, struct message_fl
         (*env)->DeleteGlobalRef(env, callback_args->callback);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), callback_args);
+    aws_mem_release(aws_jni_event_stream_allocator(), callback_args);
 }
 
 static void s_message_flush_fn(int error_code, void *user_data) {
@@ -376,7 +379,14 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnection_sendPr
 
     struct aws_event_stream_rpc_marshalled_message marshalled_message;
     if (aws_event_stream_rpc_marshall_message_args_init(
-            &marshalled_message, aws_jni_get_allocator(), env, headers, payload, NULL, message_flags, message_type)) {
+            &marshalled_message,
+            aws_jni_event_stream_allocator(),
+            env,
+            headers,
+            payload,
+            NULL,
+            message_flags,
+            message_type)) {
         goto clean_up;
     }
 
@@ -384,7 +394,7 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnection_sendPr
         goto clean_up;
     }
 
-    callback_data = aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct message_flush_callback_args));
+    callback_data = aws_mem_calloc(aws_jni_event_stream_allocator(), 1, sizeof(struct message_flush_callback_args));
 
     if (!callback_data) {
         aws_jni_throw_runtime_exception(env, "ClientConnection.sendProtocolMessage: allocation failed.");
@@ -421,8 +431,66 @@ struct continuation_callback_data {
     JavaVM *jvm;
     jobject java_continuation;
     jobject java_continuation_handler;
+
+    /* set if events go through a CallbackDispatcher, see ClientConnectionContinuationDispatchTarget */
+    struct aws_jni_callback_dispatcher *dispatcher;
+    struct aws_jni_dispatch_target *dispatch_target;
 };
 
+/* event types of ClientConnectionContinuationDispatchTarget */
+enum continuation_dispatch_event {
+    CONTINUATION_DISPATCH_EVENT_MESSAGE = 1,
+    CONTINUATION_DISPATCH_EVENT_CLOSED = 2,
+};
+
+/*
+ * Queues a continuation message on the dispatcher, laid out as
+ * [4-byte BE headers length][headers][4-byte BE payload length][payload][4-byte BE message type][4-byte BE flags].
+ * Returns AWS_OP_ERR if it wasn't queued and should be delivered directly.
+ */
+static int s_dispatch_continuation_message(
+    struct continuation_callback_data *callback_data,
+    const struct aws_event_stream_rpc_message_args *message_args) {
+
+    struct aws_array_list headers_list;
+    aws_array_list_init_static(
+        &headers_list,
+        message_args->headers,
+        message_args->headers_count,
+        sizeof(struct aws_event_stream_header_value_pair));
+    headers_list.length = message_args->headers_count;
+    size_t headers_len = aws_event_stream_compute_headers_required_buffer_len(&headers_list);
+    size_t payload_len = message_args->payload ? message_args->payload->len : 0;
+
+    struct aws_jni_dispatch_record *record = aws_jni_dispatch_record_new(
+        callback_data->dispatch_target, CONTINUATION_DISPATCH_EVENT_MESSAGE, 16 + headers_len + payload_len);
+    struct aws_byte_buf *record_payload = aws_jni_dispatch_record_payload(record);
+
+    aws_byte_buf_write_be32(record_payload, (uint32_t)headers_len);
+    struct aws_byte_buf headers_buf = aws_byte_buf_from_empty_array(record_payload->buffer + 4, headers_len);
+    if (aws_event_stream_write_headers_to_buffer_safe(&headers_list, &headers_buf)) {
+        goto error;
+    }
+    record_payload->len += headers_len;
+
+    aws_byte_buf_write_be32(record_payload, (uint32_t)payload_len);
+    if (payload_len > 0) {
+        aws_byte_buf_write_from_whole_buffer(record_payload, *message_args->payload);
+    }
+    aws_byte_buf_write_be32(record_payload, (uint32_t)message_args->message_type);
+    aws_byte_buf_write_be32(record_payload, (uint32_t)message_args->message_flags);
+
+    if (aws_jni_callback_dispatcher_submit(callback_data->dispatcher, record)) {
+        goto error;
+    }
+    return AWS_OP_SUCCESS;
+
+error:
+    /* the continuation still holds the target, so this doesn't need a JNIEnv */
+    aws_jni_dispatch_record_destroy(record, NULL);
+    return AWS_OP_ERR;
+}
+
 static void s_client_continuation_data_destroy(JNIEnv *env, struct continuation_callback_data *callback_data) {
     if (!callback_data) {
         return;
@@ -436,7 +504,10 @@ static void s_client_continuation_data_destroy(JNIEnv *env, struct continuation_
         (*env)->DeleteGlobalRef(env, callback_data->java_continuation);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), callback_data);
+    aws_jni_dispatch_target_release(callback_data->dispatch_target, env);
+    aws_jni_callback_dispatcher_release(callback_data->dispatcher, env);
+
+    aws_mem_release(aws_jni_event_stream_allocator(), callback_data);
 }
 
 static void s_stream_continuation(
@@ -447,6 +518,10 @@ static void s_stream_continuation(
 
     struct continuation_callback_data *callback_data = user_data;
 
+    if (callback_data->dispatcher != NULL && s_dispatch_continuation_message(callback_data, message_args) == 0) {
+        return;
+    }
+
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
     if (env == NULL) {
@@ -455,7 +530,7 @@ static void s_stream_continuation(
     }
 
     jbyteArray headers_array = aws_event_stream_rpc_marshall_headers_to_byteArray(
-        aws_jni_get_allocator(), env, message_args->headers, message_args->headers_count);
+        aws_jni_event_stream_allocator(), env, message_args->headers, message_args->headers_count);
 
     struct aws_byte_cursor payload_cur = aws_byte_cursor_from_buf(message_args->payload);
     jbyteArray payload_byte_array = aws_jni_byte_array_from_cursor(env, &payload_cur);
@@ -491,12 +566,24 @@ static void s_stream_continuation_closed(
         return;
     }
 
-    (*env)->CallVoidMethod(
-        env,
-        continuation_callback_data->java_continuation_handler,
-        event_stream_client_continuation_handler_properties.onContinuationClosed);
-    /* don't really care if they threw here, but we want to make the jvm happy that we checked */
-    aws_jni_check_and_clear_exception(env);
+    bool dispatched = false;
+    if (continuation_callback_data->dispatcher != NULL) {
+        struct aws_jni_dispatch_record *record = aws_jni_dispatch_record_new(
+            continuation_callback_data->dispatch_target, CONTINUATION_DISPATCH_EVENT_CLOSED, 0);
+        dispatched = aws_jni_callback_dispatcher_submit(continuation_callback_data->dispatcher, record) == 0;
+        if (!dispatched) {
+            aws_jni_dispatch_record_destroy(record, env);
+        }
+    }
+
+    if (!dispatched) {
+        (*env)->CallVoidMethod(
+            env,
+            continuation_callback_data->java_continuation_handler,
+            event_stream_client_continuation_handler_properties.onContinuationClosed);
+        /* don't really care if they threw here, but we want to make the jvm happy that we checked */
+        aws_jni_check_and_clear_exception(env);
+    }
 
     JavaVM *jvm = continuation_callback_data->jvm;
     s_client_continuation_data_destroy(env, continuation_callback_data);
@@ -509,14 +596,16 @@ jlong JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnection_newCl
     JNIEnv *env,
     jclass jni_class,
     jlong jni_connection,
-    jobject continuation_handler) {
+    jobject continuation_handler,
+    jlong jni_dispatcher,
+    jobject dispatch_target) {
     (void)jni_class;
 
     struct aws_event_stream_rpc_client_connection *connection =
         (struct aws_event_stream_rpc_client_connection *)jni_connection;
 
     struct continuation_callback_data *continuation_callback_data =
-        aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct continuation_callback_data));
+        aws_mem_calloc(aws_jni_event_stream_allocator(), 1, sizeof(struct continuation_callback_data));
 
     if (!continuation_callback_data || !connection) {
         aws_event_stream_rpc_client_connection_close(connection, aws_last_error());
@@ -535,6 +624,16 @@ jlong JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnection_newCl
         goto error;
     }
 
+    if (jni_dispatcher != 0) {
+        continuation_callback_data->dispatch_target = aws_jni_dispatch_target_new(env, dispatch_target);
+        if (!continuation_callback_data->dispatch_target) {
+            /* exception already thrown */
+            goto error;
+        }
+        continuation_callback_data->dispatcher =
+            aws_jni_callback_dispatcher_acquire((struct aws_jni_callback_dispatcher *)jni_dispatcher);
+    }
+
     struct aws_event_stream_rpc_client_stream_continuation_options continuation_options = {
         .on_continuation_closed = s_stream_continuation_closed,
         .on_continuation = s_stream_continuation,
@@ -591,7 +690,7 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnectionContinu
     struct aws_event_stream_rpc_marshalled_message marshalled_message;
     if (aws_event_stream_rpc_marshall_message_args_init(
             &marshalled_message,
-            aws_jni_get_allocator(),
+            aws_jni_event_stream_allocator(),
             env,
             headers,
             payload,
@@ -601,7 +700,7 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnectionContinu
         goto clean_up;
     }
 
-    callback_data = aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct message_flush_callback_args));
+    callback_data = aws_mem_calloc(aws_jni_event_stream_allocator(), 1, sizeof(struct message_flush_callback_args));
 
     if (!callback_data) {
         aws_jni_throw_runtime_exception(env, "ClientConnectionContinuation.activateContinuation: allocation failed.");
@@ -667,7 +766,14 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnectionContinu
 
     struct aws_event_stream_rpc_marshalled_message marshalled_message;
     if (aws_event_stream_rpc_marshall_message_args_init(
-            &marshalled_message, aws_jni_get_allocator(), env, headers, payload, NULL, message_flags, message_type)) {
+            &marshalled_message,
+            aws_jni_event_stream_allocator(),
+            env,
+            headers,
+            payload,
+            NULL,
+            message_flags,
+            message_type)) {
         goto clean_up;
     }
 
@@ -675,7 +781,7 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnectionContinu
         goto clean_up;
     }
 
-    callback_data = aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct message_flush_callback_args));
+    callback_data = aws_mem_calloc(aws_jni_event_stream_allocator(), 1, sizeof(struct message_flush_callback_args));
 
     if (!callback_data) {
         aws_jni_throw_runtime_exception(
@@ -698,8 +804,7 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnectionContinu
 
     if (aws_event_stream_rpc_client_continuation_send_message(
             continuation_token, &marshalled_message.message_args, s_message_flush_fn, callback_data)) {
-        aws_jni_throw_runtime_exception(
-            env, "ClientConnectionContinuation.sendContinuationMessage: send message failed");
+        aws_jni_throw_crt_error(env, aws_last_error());
         goto clean_up;
     }
 
@@ -715,6 +820,37 @@ clean_up:
     return ret_val;
 }
 
+static int s_client_continuation_send_message(
+    void *continuation,
+    const struct aws_event_stream_rpc_message_args *message_args,
+    aws_jni_event_stream_message_flush_fn *flush_fn,
+    void *user_data) {
+    return aws_event_stream_rpc_client_continuation_send_message(continuation, message_args, flush_fn, user_data);
+}
+
+JNIEXPORT
+jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnectionContinuation_sendContinuationMessages(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_continuation_ptr,
+    jobjectArray headers,
+    jobjectArray payloads,
+    jintArray message_types,
+    jintArray message_flags,
+    jobject callback) {
+    (void)jni_class;
+
+    return aws_jni_event_stream_send_message_batch(
+        env,
+        (struct aws_event_stream_rpc_client_continuation_token *)jni_continuation_ptr,
+        s_client_continuation_send_message,
+        headers,
+        payloads,
+        message_types,
+        message_flags,
+        callback);
+}
+
 JNIEXPORT
 void JNICALL Java_software_amazon_awssdk_crt_eventstream_ClientConnectionContinuation_releaseContinuation(
     JNIEnv *env,
@@ -12,7 +12,19 @@
 
 #include "crt.h"
 #include "event_stream_message.h"
+#include "event_stream_server_metrics.h"
 #include "java_class_ids.h"
+#include "tls_handshake_metrics.h"
+
+#ifndef _WIN32
+#    include <errno.h>
+#    include <fcntl.h>
+#    include <string.h>
+#    include <sys/socket.h>
+#    include <sys/stat.h>
+#    include <sys/un.h>
+#    include <unistd.h>
+#endif
 
 #if defined(_MSC_VER)
 #    pragma warning(disable : 4204) /* non-constant aggregate initializer */
@@ -34,6 +46,7 @@ struct shutdown_callback_data {
     JavaVM *jvm;
     jweak java_server_listener;
     jobject java_listener_handler;
+    struct aws_jni_event_stream_server_metrics *metrics;
 };
 
 static void s_shutdown_callback_data_destroy(JNIEnv *env, struct shutdown_callback_data *callback_data) {
@@ -50,7 +63,8 @@ static void s_shutdown_callback_data_destroy(JNIEnv *env, struct shutdown_callba
         (*env)->DeleteGlobalRef(env, callback_data->java_listener_handler);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), callback_data);
+    aws_jni_event_stream_server_metrics_release(callback_data->metrics);
+    aws_mem_release(aws_jni_event_stream_allocator(), callback_data);
 }
 
 struct connection_callback_data {
@@ -58,6 +72,7 @@ struct connection_callback_data {
     jobject java_server_connection;
     jweak java_listener_handler;
     jobject java_connection_handler;
+    struct aws_jni_event_stream_server_metrics *metrics;
 };
 
 static void s_server_connection_data_destroy(JNIEnv *env, struct connection_callback_data *callback_data) {
@@ -77,7 +92,9 @@ static void s_server_connection_data_destroy(JNIEnv *env, struct connection_call
         (*env)->DeleteGlobalRef(env, callback_data->java_connection_handler);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), callback_data);
+    aws_jni_event_stream_server_metrics_connection_closed(callback_data->metrics);
+    aws_jni_event_stream_server_metrics_release(callback_data->metrics);
+    aws_mem_release(aws_jni_event_stream_allocator(), callback_data);
 }
 
 static void s_server_listener_shutdown_complete(
@@ -111,6 +128,8 @@ struct continuation_callback_data {
     JavaVM *jvm;
     jobject java_continuation;
     jobject java_continuation_handler;
+    /* the connection's */
+    struct aws_jni_event_stream_server_metrics *metrics;
 };
 
 static void s_server_continuation_data_destroy(JNIEnv *env, struct continuation_callback_data *callback_data) {
@@ -126,7 +145,8 @@ static void s_server_continuation_data_destroy(JNIEnv *env, struct continuation_
         (*env)->DeleteGlobalRef(env, callback_data->java_continuation);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), callback_data);
+    aws_jni_event_stream_server_metrics_release(callback_data->metrics);
+    aws_mem_release(aws_jni_event_stream_allocator(), callback_data);
 }
 
 static void s_stream_continuation_fn(
@@ -136,6 +156,7 @@ static void s_stream_continuation_fn(
     (void)token;
 
     struct continuation_callback_data *callback_data = user_data;
+    aws_jni_event_stream_server_metrics_record_received(callback_data->metrics, message_args->payload->len);
 
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
@@ -145,7 +166,7 @@ static void s_stream_continuation_fn(
     }
 
     jbyteArray headers_array = aws_event_stream_rpc_marshall_headers_to_byteArray(
-        aws_jni_get_allocator(), env, message_args->headers, message_args->headers_count);
+        aws_jni_event_stream_allocator(), env, message_args->headers, message_args->headers_count);
 
     struct aws_byte_cursor payload_cur = aws_byte_cursor_from_buf(message_args->payload);
     jbyteArray payload_byte_array = aws_jni_byte_array_from_cursor(env, &payload_cur);
@@ -171,6 +192,7 @@ static void s_stream_continuation_closed_fn(
     void *user_data) {
     (void)token;
     struct continuation_callback_data *continuation_callback_data = user_data;
+    aws_jni_event_stream_server_metrics_record_continuation_closed(continuation_callback_data->metrics);
 
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(continuation_callback_data->jvm);
@@ -213,23 +235,29 @@ static int s_on_incoming_stream_fn(
     }
 
     struct continuation_callback_data *continuation_callback_data =
-        aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct continuation_callback_data));
+        aws_mem_calloc(aws_jni_event_stream_allocator(), 1, sizeof(struct continuation_callback_data));
 
     if (!continuation_callback_data) {
         goto on_error;
     }
 
     continuation_callback_data->jvm = callback_data->jvm;
+    continuation_callback_data->metrics = aws_jni_event_stream_server_metrics_acquire(callback_data->metrics);
 
+    /* the Java continuation holds a reference of its own, released when it's closed */
+    struct aws_jni_event_stream_server_metrics *java_metrics =
+        aws_jni_event_stream_server_metrics_acquire(callback_data->metrics);
     java_continuation = (*env)->NewObject(
         env,
         event_stream_server_connection_handler_properties.continuationCls,
         event_stream_server_connection_handler_properties.newContinuationConstructor,
-        (jlong)token);
+        (jlong)token,
+        (jlong)java_metrics);
 
     aws_jni_check_and_clear_exception(env);
 
     if (!java_continuation) {
+        aws_jni_event_stream_server_metrics_release(java_metrics);
         aws_raise_error(AWS_ERROR_INVALID_STATE);
         goto on_error;
     }
@@ -267,6 +295,7 @@ static int s_on_incoming_stream_fn(
     continuation_options->user_data = continuation_callback_data;
     continuation_options->on_continuation = s_stream_continuation_fn;
     continuation_options->on_continuation_closed = s_stream_continuation_closed_fn;
+    aws_jni_event_stream_server_metrics_record_continuation_opened(continuation_callback_data->metrics);
 
     (*env)->DeleteLocalRef(env, java_continuation_handler);
     (*env)->DeleteLocalRef(env, java_continuation);
@@ -302,6 +331,7 @@ static void s_connection_protocol_message_fn(
     (void)connection;
 
     struct connection_callback_data *callback_data = user_data;
+    aws_jni_event_stream_server_metrics_record_received(callback_data->metrics, message_args->payload->len);
 
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
@@ -311,7 +341,7 @@ static void s_connection_protocol_message_fn(
     }
 
     jbyteArray headers_array = aws_event_stream_rpc_marshall_headers_to_byteArray(
-        aws_jni_get_allocator(), env, message_args->headers, message_args->headers_count);
+        aws_jni_event_stream_allocator(), env, message_args->headers, message_args->headers_count);
 
     struct aws_byte_cursor payload_cur = aws_byte_cursor_from_buf(message_args->payload);
     jbyteArray payload_byte_array = aws_jni_byte_array_from_cursor(env, &payload_cur);
@@ -352,7 +382,7 @@ static int s_on_new_connection_fn(
     jobject java_connection_handler = NULL;
 
     struct connection_callback_data *connection_callback_data =
-        aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct connection_callback_data));
+        aws_mem_calloc(aws_jni_event_stream_allocator(), 1, sizeof(struct connection_callback_data));
 
     if (!connection_callback_data) {
         goto error;
@@ -362,12 +392,19 @@ static int s_on_new_connection_fn(
     connection_callback_data->java_listener_handler = (*env)->NewGlobalRef(env, callback_data->java_listener_handler);
 
     if (!error_code) {
+        connection_callback_data->metrics = aws_jni_event_stream_server_metrics_new_connection(callback_data->metrics);
+
+        /* the Java connection holds a reference of its own, released when it's closed */
+        struct aws_jni_event_stream_server_metrics *java_metrics =
+            aws_jni_event_stream_server_metrics_acquire(connection_callback_data->metrics);
         java_server_connection = (*env)->NewObject(
             env,
             event_stream_server_listener_handler_properties.connCls,
             event_stream_server_listener_handler_properties.newConnConstructor,
-            (jlong)connection);
+            (jlong)connection,
+            (jlong)java_metrics);
         if (aws_jni_check_and_clear_exception(env) || java_server_connection == NULL) {
+            aws_jni_event_stream_server_metrics_release(java_metrics);
             aws_raise_error(AWS_ERROR_INVALID_STATE);
             goto error;
         }
@@ -471,6 +508,49 @@ static void s_on_connection_shutdown_fn(
     /********** JNI ENV RELEASE **********/
 }
 
+/*
+ * A process that exits without closing its listener leaves its UNIX domain socket file behind, and listening on the
+ * same path then fails with EADDRINUSE until something deletes it, which is the usual trouble with same-host IPC
+ * servers that restart. Before listening on a LOCAL socket, remove the file if it is a socket nobody is listening on.
+ * The probe is non-blocking, so a live listener with a full backlog is left alone rather than waited on.
+ */
+static void s_remove_stale_local_socket(const char *path) {
+#ifndef _WIN32
+    struct stat path_stat;
+    if (lstat(path, &path_stat) != 0 || !S_ISSOCK(path_stat.st_mode)) {
+        return;
+    }
+
+    struct sockaddr_un address;
+    AWS_ZERO_STRUCT(address);
+    address.sun_family = AF_UNIX;
+    size_t path_len = strlen(path);
+    if (path_len >= sizeof(address.sun_path)) {
+        return;
+    }
+    memcpy(address.sun_path, path, path_len);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return;
+    }
+
+    int connect_errno = 0;
+    if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) == 0 &&
+        connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0) {
+        connect_errno = errno;
+    }
+    close(fd);
+
+    if (connect_errno == ECONNREFUSED) {
+        unlink(path);
+    }
+#else
+    /* named pipes go away with the last handle to them */
+    (void)path;
+#endif
+}
+
 JNIEXPORT
 jlong JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerListener_serverListenerNew(
     JNIEnv *env,
@@ -481,8 +561,10 @@ jlong JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerListener_serverL
     jlong jni_socket_options,
     jlong jni_tls_ctx,
     jlong jni_server_bootstrap,
-    jobject jni_server_listener_handler) {
+    jobject jni_server_listener_handler,
+    jlong jni_metrics) {
     (void)jni_class;
+    cache_java_class_ids_for_event_stream(env);
     struct aws_server_bootstrap *server_bootstrap = (struct aws_server_bootstrap *)jni_server_bootstrap;
     struct aws_socket_options *socket_options = (struct aws_socket_options *)jni_socket_options;
     struct aws_tls_ctx *tls_context = (struct aws_tls_ctx *)jni_tls_ctx;
@@ -503,11 +585,11 @@ jlong JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerListener_serverL
     struct aws_string *host_name_str = NULL;
 
     if (tls_context) {
-        aws_tls_connection_options_init_from_ctx(&connection_options, tls_context);
+        aws_jni_tls_connection_options_init_from_ctx(&connection_options, tls_context);
         conn_options_ptr = &connection_options;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_event_stream_allocator();
 
     struct shutdown_callback_data *callback_data = aws_mem_calloc(allocator, 1, sizeof(struct shutdown_callback_data));
     if (!callback_data) {
@@ -533,6 +615,9 @@ jlong JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerListener_serverL
         goto error;
     }
 
+    callback_data->metrics =
+        aws_jni_event_stream_server_metrics_acquire((struct aws_jni_event_stream_server_metrics *)jni_metrics);
+
     const size_t host_name_len = (*env)->GetArrayLength(env, jni_host_name);
     jbyte *host_name = (*env)->GetPrimitiveArrayCritical(env, jni_host_name, NULL);
     host_name_str = aws_string_new_from_array(allocator, (uint8_t *)host_name, host_name_len);
@@ -544,6 +629,9 @@ jlong JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerListener_serverL
     }
 
     const char *c_str_host_name = aws_string_c_str(host_name_str);
+    if (socket_options->domain == AWS_SOCKET_LOCAL) {
+        s_remove_stale_local_socket(c_str_host_name);
+    }
 
     struct aws_event_stream_rpc_server_listener_options listener_options = {
         .socket_options = socket_options,
@@ -685,6 +773,9 @@ jboolean JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerConnection_is
 struct message_flush_callback_args {
     JavaVM *jvm;
     jobject callback;
+    struct aws_jni_event_stream_server_metrics *metrics;
+    size_t payload_length;
+    uint64_t sent_ns;
 };
 
 static void s_destroy_message_flush_callback_args(JNIEnv *env, struct message_flush_callback_args *callback_args) {
@@ -696,11 +787,26 @@ static void s_destroy_message_flush_callback_args(JNIEnv *env, struct message_fl
         (*env)->DeleteGlobalRef(env, callback_args->callback);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), callback_args);
+    aws_jni_event_stream_server_metrics_release(callback_args->metrics);
+    aws_mem_release(aws_jni_event_stream_allocator(), callback_args);
+}
+
+/* Counts a message about to be sent, so its flush can be timed; the message's metrics are its connection's */
+static void s_message_flush_callback_args_record_sent(
+    struct message_flush_callback_args *callback_args,
+    jlong jni_metrics,
+    const struct aws_event_stream_rpc_marshalled_message *marshalled_message) {
+
+    callback_args->metrics =
+        aws_jni_event_stream_server_metrics_acquire((struct aws_jni_event_stream_server_metrics *)jni_metrics);
+    callback_args->payload_length = marshalled_message->payload_buf.len;
+    callback_args->sent_ns = aws_jni_event_stream_server_metrics_record_sent(callback_args->metrics);
 }
 
 static void s_message_flush_fn(int error_code, void *user_data) {
     struct message_flush_callback_args *callback_data = user_data;
+    aws_jni_event_stream_server_metrics_record_flushed(
+        callback_data->metrics, callback_data->payload_length, callback_data->sent_ns, error_code);
 
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
@@ -728,7 +834,8 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerConnection_sendPr
     jbyteArray payload,
     jint message_type,
     jint message_flags,
-    jobject callback) {
+    jobject callback,
+    jlong jni_metrics) {
     (void)jni_class;
     struct aws_event_stream_rpc_server_connection *connection =
         (struct aws_event_stream_rpc_server_connection *)jni_server_connection;
@@ -738,7 +845,14 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerConnection_sendPr
 
     struct aws_event_stream_rpc_marshalled_message marshalled_message;
     if (aws_event_stream_rpc_marshall_message_args_init(
-            &marshalled_message, aws_jni_get_allocator(), env, headers, payload, NULL, message_flags, message_type)) {
+            &marshalled_message,
+            aws_jni_event_stream_allocator(),
+            env,
+            headers,
+            payload,
+            NULL,
+            message_flags,
+            message_type)) {
         goto clean_up;
     }
 
@@ -747,7 +861,7 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerConnection_sendPr
         goto clean_up;
     }
 
-    callback_data = aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct message_flush_callback_args));
+    callback_data = aws_mem_calloc(aws_jni_event_stream_allocator(), 1, sizeof(struct message_flush_callback_args));
 
     if (!callback_data) {
         aws_jni_throw_runtime_exception(env, "ServerConnection.sendProtocolMessage: allocation failed.");
@@ -767,8 +881,11 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerConnection_sendPr
         goto clean_up;
     }
 
+    s_message_flush_callback_args_record_sent(callback_data, jni_metrics, &marshalled_message);
     if (aws_event_stream_rpc_server_connection_send_protocol_message(
             connection, &marshalled_message.message_args, s_message_flush_fn, callback_data)) {
+        aws_jni_event_stream_server_metrics_record_flushed(
+            callback_data->metrics, callback_data->payload_length, callback_data->sent_ns, aws_last_error());
         aws_jni_throw_runtime_exception(env, "ServerConnection.sendProtocolMessage: send message failed");
         goto clean_up;
     }
@@ -835,7 +952,8 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerConnectionContinu
     jbyteArray payload,
     jint message_type,
     jint message_flags,
-    jobject callback) {
+    jobject callback,
+    jlong jni_metrics) {
     (void)jni_class;
     struct aws_event_stream_rpc_server_continuation_token *continuation =
         (struct aws_event_stream_rpc_server_continuation_token *)jni_server_continuation;
@@ -846,7 +964,14 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerConnectionContinu
 
     struct aws_event_stream_rpc_marshalled_message marshalled_message;
     if (aws_event_stream_rpc_marshall_message_args_init(
-            &marshalled_message, aws_jni_get_allocator(), env, headers, payload, NULL, message_flags, message_type)) {
+            &marshalled_message,
+            aws_jni_event_stream_allocator(),
+            env,
+            headers,
+            payload,
+            NULL,
+            message_flags,
+            message_type)) {
         goto clean_up;
     }
 
@@ -855,7 +980,7 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerConnectionContinu
         goto clean_up;
     }
 
-    callback_data = aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct message_flush_callback_args));
+    callback_data = aws_mem_calloc(aws_jni_event_stream_allocator(), 1, sizeof(struct message_flush_callback_args));
     if (!callback_data) {
         aws_jni_throw_runtime_exception(
             env, "ServerConnectionContinuation.sendContinuationMessage: allocation failed.");
@@ -875,8 +1000,11 @@ jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerConnectionContinu
         goto clean_up;
     }
 
+    s_message_flush_callback_args_record_sent(callback_data, jni_metrics, &marshalled_message);
     if (aws_event_stream_rpc_server_continuation_send_message(
             continuation, &marshalled_message.message_args, s_message_flush_fn, callback_data)) {
+        aws_jni_event_stream_server_metrics_record_flushed(
+            callback_data->metrics, callback_data->payload_length, callback_data->sent_ns, aws_last_error());
         aws_jni_throw_runtime_exception(
             env, "ServerConnectionContinuation.sendContinuationMessage: send message failed");
         goto clean_up;
@@ -893,6 +1021,89 @@ clean_up:
     return ret_val;
 }
 
+/* What a batch sends through: the continuation, and the metrics of its connection */
+struct server_continuation_sender {
+    struct aws_event_stream_rpc_server_continuation_token *continuation;
+    struct aws_jni_event_stream_server_metrics *metrics;
+};
+
+/* Times the flush of one batched message before passing it on to the batch */
+struct server_batched_message_flush_args {
+    struct aws_jni_event_stream_server_metrics *metrics;
+    size_t payload_length;
+    uint64_t sent_ns;
+    aws_jni_event_stream_message_flush_fn *flush_fn;
+    void *user_data;
+};
+
+static void s_server_batched_message_flush_fn(int error_code, void *user_data) {
+    struct server_batched_message_flush_args *flush_args = user_data;
+    aws_jni_event_stream_server_metrics_record_flushed(
+        flush_args->metrics, flush_args->payload_length, flush_args->sent_ns, error_code);
+
+    aws_jni_event_stream_message_flush_fn *flush_fn = flush_args->flush_fn;
+    void *batch_user_data = flush_args->user_data;
+    aws_jni_event_stream_server_metrics_release(flush_args->metrics);
+    aws_mem_release(aws_jni_event_stream_allocator(), flush_args);
+
+    flush_fn(error_code, batch_user_data);
+}
+
+static int s_server_continuation_send_message(
+    void *continuation,
+    const struct aws_event_stream_rpc_message_args *message_args,
+    aws_jni_event_stream_message_flush_fn *flush_fn,
+    void *user_data) {
+    struct server_continuation_sender *sender = continuation;
+
+    struct server_batched_message_flush_args *flush_args =
+        aws_mem_calloc(aws_jni_event_stream_allocator(), 1, sizeof(struct server_batched_message_flush_args));
+    flush_args->metrics = aws_jni_event_stream_server_metrics_acquire(sender->metrics);
+    flush_args->payload_length = message_args->payload != NULL ? message_args->payload->len : 0;
+    flush_args->sent_ns = aws_jni_event_stream_server_metrics_record_sent(flush_args->metrics);
+    flush_args->flush_fn = flush_fn;
+    flush_args->user_data = user_data;
+
+    if (aws_event_stream_rpc_server_continuation_send_message(
+            sender->continuation, message_args, s_server_batched_message_flush_fn, flush_args)) {
+        aws_jni_event_stream_server_metrics_record_flushed(
+            flush_args->metrics, flush_args->payload_length, flush_args->sent_ns, aws_last_error());
+        aws_jni_event_stream_server_metrics_release(flush_args->metrics);
+        aws_mem_release(aws_jni_event_stream_allocator(), flush_args);
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+JNIEXPORT
+jint JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerConnectionContinuation_sendContinuationMessages(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_server_continuation,
+    jobjectArray headers,
+    jobjectArray payloads,
+    jintArray message_types,
+    jintArray message_flags,
+    jobject callback,
+    jlong jni_metrics) {
+    (void)jni_class;
+
+    if (jni_server_continuation == 0) {
+        aws_jni_throw_runtime_exception(
+            env, "ServerConnectionContinuation.sendContinuationMessages: native continuation is NULL.");
+        return AWS_OP_ERR;
+    }
+
+    struct server_continuation_sender sender = {
+        .continuation = (struct aws_event_stream_rpc_server_continuation_token *)jni_server_continuation,
+        .metrics = (struct aws_jni_event_stream_server_metrics *)jni_metrics,
+    };
+
+    return aws_jni_event_stream_send_message_batch(
+        env, &sender, s_server_continuation_send_message, headers, payloads, message_types, message_flags, callback);
+}
+
 #if UINTPTR_MAX == 0xffffffff
 #    if defined(_MSC_VER)
 #        pragma warning(pop)
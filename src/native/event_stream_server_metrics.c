@@ -0,0 +1,346 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "event_stream_server_metrics.h"
+
+#include <aws/common/clock.h>
+#include <aws/common/linked_list.h>
+#include <aws/common/mutex.h>
+#include <aws/common/ref_count.h>
+
+#include "crt.h"
+#include "latency_histogram.h"
+
+/* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(push)
+#        pragma warning(disable : 4305) /* 'type cast': truncation from 'jlong' to 'jni_tls_ctx_options *' */
+#    else
+#        pragma GCC diagnostic push
+#        pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
+#        pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+#    endif
+#endif
+
+/* Everything but the connection counts; gauges are kept as running sums of +1 and -1, which wrap back correctly */
+struct event_stream_server_counters {
+    uint64_t messages_received;
+    uint64_t payload_bytes_received;
+    uint64_t messages_flushed;
+    uint64_t payload_bytes_flushed;
+    uint64_t messages_failed;
+    uint64_t pending_flushes;
+    uint64_t active_continuations;
+};
+
+struct aws_jni_event_stream_server_metrics {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+
+    /* NULL for a listener; a connection holds a reference to its listener */
+    struct aws_jni_event_stream_server_metrics *listener;
+    /* a connection's place in its listener's live_connections */
+    struct aws_linked_list_node node;
+
+    struct aws_jni_latency_histogram flush_latency;
+
+    struct aws_mutex lock;
+    /* for a connection, its own; for a listener, the totals of every connection that has closed */
+    struct event_stream_server_counters counters;
+    /* connections only: once set, updates go to the listener's totals as well */
+    bool closed;
+    /* listeners only */
+    uint64_t connections_accepted;
+    uint64_t active_connections;
+    struct aws_linked_list live_connections;
+};
+
+/* Must match ServerMetrics.java */
+enum event_stream_server_metric {
+    EVENT_STREAM_SERVER_METRIC_TIMESTAMP_NS,
+    EVENT_STREAM_SERVER_METRIC_MESSAGES_RECEIVED,
+    EVENT_STREAM_SERVER_METRIC_PAYLOAD_BYTES_RECEIVED,
+    EVENT_STREAM_SERVER_METRIC_MESSAGES_FLUSHED,
+    EVENT_STREAM_SERVER_METRIC_PAYLOAD_BYTES_FLUSHED,
+    EVENT_STREAM_SERVER_METRIC_MESSAGES_FAILED,
+    EVENT_STREAM_SERVER_METRIC_PENDING_FLUSHES,
+    EVENT_STREAM_SERVER_METRIC_ACTIVE_CONTINUATIONS,
+    EVENT_STREAM_SERVER_METRIC_CONNECTIONS_ACCEPTED,
+    EVENT_STREAM_SERVER_METRIC_ACTIVE_CONNECTIONS,
+    EVENT_STREAM_SERVER_METRIC_FLUSH_LATENCY_HISTOGRAM,
+    EVENT_STREAM_SERVER_METRIC_COUNT =
+        EVENT_STREAM_SERVER_METRIC_FLUSH_LATENCY_HISTOGRAM + AWS_JNI_LATENCY_HISTOGRAM_BUCKETS,
+};
+
+static uint64_t s_now_ns(void) {
+    uint64_t now = 0;
+    aws_high_res_clock_get_ticks(&now);
+    return now;
+}
+
+static void s_add_counters(struct event_stream_server_counters *to, const struct event_stream_server_counters *delta) {
+    to->messages_received += delta->messages_received;
+    to->payload_bytes_received += delta->payload_bytes_received;
+    to->messages_flushed += delta->messages_flushed;
+    to->payload_bytes_flushed += delta->payload_bytes_flushed;
+    to->messages_failed += delta->messages_failed;
+    to->pending_flushes += delta->pending_flushes;
+    to->active_continuations += delta->active_continuations;
+}
+
+static void s_record(
+    struct aws_jni_event_stream_server_metrics *metrics,
+    const struct event_stream_server_counters *delta) {
+    if (metrics == NULL) {
+        return;
+    }
+
+    aws_mutex_lock(&metrics->lock);
+    s_add_counters(&metrics->counters, delta);
+    bool closed = metrics->closed;
+    aws_mutex_unlock(&metrics->lock);
+
+    /* a closed connection's totals already went to the listener, so anything after that has to follow them */
+    if (closed && metrics->listener != NULL) {
+        aws_mutex_lock(&metrics->listener->lock);
+        s_add_counters(&metrics->listener->counters, delta);
+        aws_mutex_unlock(&metrics->listener->lock);
+    }
+}
+
+static void s_metrics_destroy(void *user_data) {
+    struct aws_jni_event_stream_server_metrics *metrics = user_data;
+
+    if (metrics->listener != NULL) {
+        aws_jni_event_stream_server_metrics_connection_closed(metrics);
+        aws_jni_event_stream_server_metrics_release(metrics->listener);
+    }
+
+    aws_mutex_clean_up(&metrics->lock);
+    aws_mem_release(metrics->allocator, metrics);
+}
+
+static struct aws_jni_event_stream_server_metrics *s_metrics_new(struct aws_allocator *allocator) {
+    struct aws_jni_event_stream_server_metrics *metrics =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_jni_event_stream_server_metrics));
+    metrics->allocator = allocator;
+    aws_ref_count_init(&metrics->ref_count, metrics, s_metrics_destroy);
+    aws_jni_latency_histogram_init(&metrics->flush_latency);
+    aws_mutex_init(&metrics->lock);
+    aws_linked_list_init(&metrics->live_connections);
+    return metrics;
+}
+
+struct aws_jni_event_stream_server_metrics *aws_jni_event_stream_server_metrics_new_listener(
+    struct aws_allocator *allocator) {
+    return s_metrics_new(allocator);
+}
+
+struct aws_jni_event_stream_server_metrics *aws_jni_event_stream_server_metrics_new_connection(
+    struct aws_jni_event_stream_server_metrics *listener) {
+
+    struct aws_jni_event_stream_server_metrics *metrics = s_metrics_new(listener->allocator);
+    metrics->listener = aws_jni_event_stream_server_metrics_acquire(listener);
+
+    aws_mutex_lock(&listener->lock);
+    ++listener->connections_accepted;
+    ++listener->active_connections;
+    aws_linked_list_push_back(&listener->live_connections, &metrics->node);
+    aws_mutex_unlock(&listener->lock);
+
+    return metrics;
+}
+
+struct aws_jni_event_stream_server_metrics *aws_jni_event_stream_server_metrics_acquire(
+    struct aws_jni_event_stream_server_metrics *metrics) {
+    if (metrics != NULL) {
+        aws_ref_count_acquire(&metrics->ref_count);
+    }
+    return metrics;
+}
+
+void aws_jni_event_stream_server_metrics_release(struct aws_jni_event_stream_server_metrics *metrics) {
+    if (metrics != NULL) {
+        aws_ref_count_release(&metrics->ref_count);
+    }
+}
+
+void aws_jni_event_stream_server_metrics_connection_closed(struct aws_jni_event_stream_server_metrics *metrics) {
+    struct aws_jni_event_stream_server_metrics *listener = metrics != NULL ? metrics->listener : NULL;
+    if (listener == NULL) {
+        return;
+    }
+
+    /* listener before connection, the same order a snapshot takes them in */
+    aws_mutex_lock(&listener->lock);
+    aws_mutex_lock(&metrics->lock);
+    if (!metrics->closed) {
+        metrics->closed = true;
+        s_add_counters(&listener->counters, &metrics->counters);
+        aws_linked_list_remove(&metrics->node);
+        --listener->active_connections;
+    }
+    aws_mutex_unlock(&metrics->lock);
+    aws_mutex_unlock(&listener->lock);
+}
+
+void aws_jni_event_stream_server_metrics_record_received(
+    struct aws_jni_event_stream_server_metrics *metrics,
+    size_t payload_length) {
+    struct event_stream_server_counters delta = {
+        .messages_received = 1,
+        .payload_bytes_received = payload_length,
+    };
+    s_record(metrics, &delta);
+}
+
+uint64_t aws_jni_event_stream_server_metrics_record_sent(struct aws_jni_event_stream_server_metrics *metrics) {
+    struct event_stream_server_counters delta = {
+        .pending_flushes = 1,
+    };
+    s_record(metrics, &delta);
+    return s_now_ns();
+}
+
+void aws_jni_event_stream_server_metrics_record_flushed(
+    struct aws_jni_event_stream_server_metrics *metrics,
+    size_t payload_length,
+    uint64_t sent_ns,
+    int error_code) {
+    if (metrics == NULL) {
+        return;
+    }
+
+    struct event_stream_server_counters delta = {
+        .pending_flushes = (uint64_t)-1,
+    };
+    if (error_code == AWS_ERROR_SUCCESS) {
+        delta.messages_flushed = 1;
+        delta.payload_bytes_flushed = payload_length;
+
+        uint64_t now = s_now_ns();
+        uint64_t latency_ns = now > sent_ns ? now - sent_ns : 0;
+        aws_jni_latency_histogram_record_ns(&metrics->flush_latency, latency_ns);
+        if (metrics->listener != NULL) {
+            aws_jni_latency_histogram_record_ns(&metrics->listener->flush_latency, latency_ns);
+        }
+    } else {
+        delta.messages_failed = 1;
+    }
+    s_record(metrics, &delta);
+}
+
+void aws_jni_event_stream_server_metrics_record_continuation_opened(
+    struct aws_jni_event_stream_server_metrics *metrics) {
+    struct event_stream_server_counters delta = {
+        .active_continuations = 1,
+    };
+    s_record(metrics, &delta);
+}
+
+void aws_jni_event_stream_server_metrics_record_continuation_closed(
+    struct aws_jni_event_stream_server_metrics *metrics) {
+    struct event_stream_server_counters delta = {
+        .active_continuations = (uint64_t)-1,
+    };
+    s_record(metrics, &delta);
+}
+
+jlongArray aws_jni_event_stream_server_metrics_snapshot(
+    JNIEnv *env,
+    struct aws_jni_event_stream_server_metrics *metrics) {
+
+    int64_t values[EVENT_STREAM_SERVER_METRIC_COUNT];
+    struct event_stream_server_counters counters;
+    uint64_t connections_accepted = 0;
+    uint64_t active_connections = 0;
+
+    aws_mutex_lock(&metrics->lock);
+    counters = metrics->counters;
+    if (metrics->listener == NULL) {
+        connections_accepted = metrics->connections_accepted;
+        active_connections = metrics->active_connections;
+        for (struct aws_linked_list_node *node = aws_linked_list_begin(&metrics->live_connections);
+             node != aws_linked_list_end(&metrics->live_connections);
+             node = aws_linked_list_next(node)) {
+            struct aws_jni_event_stream_server_metrics *connection =
+                AWS_CONTAINER_OF(node, struct aws_jni_event_stream_server_metrics, node);
+            aws_mutex_lock(&connection->lock);
+            s_add_counters(&counters, &connection->counters);
+            aws_mutex_unlock(&connection->lock);
+        }
+    } else {
+        connections_accepted = 1;
+        active_connections = metrics->closed ? 0 : 1;
+    }
+    aws_mutex_unlock(&metrics->lock);
+
+    values[EVENT_STREAM_SERVER_METRIC_TIMESTAMP_NS] = (int64_t)s_now_ns();
+    values[EVENT_STREAM_SERVER_METRIC_MESSAGES_RECEIVED] = (int64_t)counters.messages_received;
+    values[EVENT_STREAM_SERVER_METRIC_PAYLOAD_BYTES_RECEIVED] = (int64_t)counters.payload_bytes_received;
+    values[EVENT_STREAM_SERVER_METRIC_MESSAGES_FLUSHED] = (int64_t)counters.messages_flushed;
+    values[EVENT_STREAM_SERVER_METRIC_PAYLOAD_BYTES_FLUSHED] = (int64_t)counters.payload_bytes_flushed;
+    values[EVENT_STREAM_SERVER_METRIC_MESSAGES_FAILED] = (int64_t)counters.messages_failed;
+    values[EVENT_STREAM_SERVER_METRIC_PENDING_FLUSHES] = (int64_t)counters.pending_flushes;
+    values[EVENT_STREAM_SERVER_METRIC_ACTIVE_CONTINUATIONS] = (int64_t)counters.active_continuations;
+    values[EVENT_STREAM_SERVER_METRIC_CONNECTIONS_ACCEPTED] = (int64_t)connections_accepted;
+    values[EVENT_STREAM_SERVER_METRIC_ACTIVE_CONNECTIONS] = (int64_t)active_connections;
+    aws_jni_latency_histogram_snapshot(
+        &metrics->flush_latency, &values[EVENT_STREAM_SERVER_METRIC_FLUSH_LATENCY_HISTOGRAM]);
+
+    jlongArray jni_values = (*env)->NewLongArray(env, EVENT_STREAM_SERVER_METRIC_COUNT);
+    if (jni_values == NULL) {
+        /* OutOfMemoryError is pending */
+        return NULL;
+    }
+    (*env)->SetLongArrayRegion(env, jni_values, 0, EVENT_STREAM_SERVER_METRIC_COUNT, (const jlong *)values);
+    return jni_values;
+}
+
+JNIEXPORT
+jlong JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerMetrics_listenerMetricsNew(
+    JNIEnv *env,
+    jclass jni_class) {
+    (void)env;
+    (void)jni_class;
+
+    return (jlong)aws_jni_event_stream_server_metrics_new_listener(aws_jni_event_stream_allocator());
+}
+
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerMetrics_metricsRelease(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_metrics) {
+    (void)env;
+    (void)jni_class;
+
+    aws_jni_event_stream_server_metrics_release((struct aws_jni_event_stream_server_metrics *)jni_metrics);
+}
+
+JNIEXPORT
+jlongArray JNICALL Java_software_amazon_awssdk_crt_eventstream_ServerMetrics_metricsSnapshot(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_metrics) {
+    (void)jni_class;
+
+    struct aws_jni_event_stream_server_metrics *metrics = (struct aws_jni_event_stream_server_metrics *)jni_metrics;
+    if (metrics == NULL) {
+        aws_jni_throw_runtime_exception(env, "ServerMetrics.snapshot: Invalid metrics");
+        return NULL;
+    }
+
+    return aws_jni_event_stream_server_metrics_snapshot(env, metrics);
+}
+
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(pop)
+#    else
+#        pragma GCC diagnostic pop
+#    endif
+#endif
@@ -0,0 +1,65 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_EVENT_STREAM_SERVER_METRICS_H
+#define AWS_JNI_CRT_EVENT_STREAM_SERVER_METRICS_H
+
+#include <jni.h>
+
+#include <aws/common/common.h>
+
+/*
+ * Counters behind ServerListener.getMetrics(), ServerConnection.getMetrics() and
+ * ServerConnectionContinuation.getMetrics(). A listener's metrics cover every connection it has accepted; each
+ * connection's cover that connection alone, and are shared by its continuations.
+ *
+ * Each connection counts into its own set, under its own lock, so connections on different event loops never
+ * contend; the listener adds up its live connections when a snapshot is taken, and folds in a connection's totals
+ * when it closes. Flush latencies go straight into both histograms, which are atomic.
+ *
+ * Reference counted: the native callback data and the Java object of each listener, connection and continuation,
+ * and every message waiting to flush, hold a reference. The record functions do nothing when given NULL.
+ */
+struct aws_jni_event_stream_server_metrics;
+
+struct aws_jni_event_stream_server_metrics *aws_jni_event_stream_server_metrics_new_listener(
+    struct aws_allocator *allocator);
+
+/* Counts a new connection accepted by listener, and returns the connection's own metrics */
+struct aws_jni_event_stream_server_metrics *aws_jni_event_stream_server_metrics_new_connection(
+    struct aws_jni_event_stream_server_metrics *listener);
+
+struct aws_jni_event_stream_server_metrics *aws_jni_event_stream_server_metrics_acquire(
+    struct aws_jni_event_stream_server_metrics *metrics);
+void aws_jni_event_stream_server_metrics_release(struct aws_jni_event_stream_server_metrics *metrics);
+
+/* Marks a connection closed, handing its totals to its listener. Safe to call more than once */
+void aws_jni_event_stream_server_metrics_connection_closed(struct aws_jni_event_stream_server_metrics *metrics);
+
+void aws_jni_event_stream_server_metrics_record_received(
+    struct aws_jni_event_stream_server_metrics *metrics,
+    size_t payload_length);
+
+/* Counts a message handed to the connection; returns its timestamp, for record_flushed() */
+uint64_t aws_jni_event_stream_server_metrics_record_sent(struct aws_jni_event_stream_server_metrics *metrics);
+
+/* Counts a message sent with record_sent() as flushed, or as failed if error_code is set */
+void aws_jni_event_stream_server_metrics_record_flushed(
+    struct aws_jni_event_stream_server_metrics *metrics,
+    size_t payload_length,
+    uint64_t sent_ns,
+    int error_code);
+
+void aws_jni_event_stream_server_metrics_record_continuation_opened(
+    struct aws_jni_event_stream_server_metrics *metrics);
+void aws_jni_event_stream_server_metrics_record_continuation_closed(
+    struct aws_jni_event_stream_server_metrics *metrics);
+
+/* Copies the metrics out in the layout ServerMetrics reads, or returns NULL with an exception pending */
+jlongArray aws_jni_event_stream_server_metrics_snapshot(
+    JNIEnv *env,
+    struct aws_jni_event_stream_server_metrics *metrics);
+
+#endif /* AWS_JNI_CRT_EVENT_STREAM_SERVER_METRICS_H */
@@ -0,0 +1,238 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <jni.h>
+
+#include <aws/cal/hash.h>
+#include <aws/cal/hmac.h>
+
+#include "crt.h"
+
+/* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(push)
+#        pragma warning(disable : 4305) /* 'type cast': truncation from 'jlong' to 'jni_tls_ctx_options *' */
+#    else
+#        pragma GCC diagnostic push
+#        pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
+#        pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+#    endif
+#endif
+
+/* Must match Hash.Algorithm */
+enum aws_jni_hash_algorithm {
+    AWS_JNI_HASH_SHA256 = 0,
+    AWS_JNI_HASH_SHA1 = 1,
+    AWS_JNI_HASH_MD5 = 2,
+    AWS_JNI_HASH_SHA256_HMAC = 3,
+};
+
+/* Backs a Java Hash: exactly one of hash and hmac is set */
+struct aws_jni_hash {
+    struct aws_hash *hash;
+    struct aws_hmac *hmac;
+};
+
+static size_t s_digest_size(const struct aws_jni_hash *jni_hash) {
+    return jni_hash->hash != NULL ? jni_hash->hash->digest_size : jni_hash->hmac->digest_size;
+}
+
+static int s_hash_update(struct aws_jni_hash *jni_hash, struct aws_byte_cursor data) {
+    return jni_hash->hash != NULL ? aws_hash_update(jni_hash->hash, &data) : aws_hmac_update(jni_hash->hmac, &data);
+}
+
+static void s_hash_destroy(struct aws_jni_hash *jni_hash) {
+    if (jni_hash->hash != NULL) {
+        aws_hash_destroy(jni_hash->hash);
+    }
+    if (jni_hash->hmac != NULL) {
+        aws_hmac_destroy(jni_hash->hmac);
+    }
+    aws_mem_release(aws_jni_get_allocator(), jni_hash);
+}
+
+JNIEXPORT
+jlong JNICALL Java_software_amazon_awssdk_crt_cal_Hash_hashNew(
+    JNIEnv *env,
+    jclass jni_class,
+    jint algorithm,
+    jbyteArray secret) {
+
+    (void)jni_class;
+
+    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_jni_hash *jni_hash = aws_mem_calloc(allocator, 1, sizeof(struct aws_jni_hash));
+
+    switch ((enum aws_jni_hash_algorithm)algorithm) {
+        case AWS_JNI_HASH_SHA256:
+            jni_hash->hash = aws_sha256_new(allocator);
+            break;
+        case AWS_JNI_HASH_SHA1:
+            jni_hash->hash = aws_sha1_new(allocator);
+            break;
+        case AWS_JNI_HASH_MD5:
+            jni_hash->hash = aws_md5_new(allocator);
+            break;
+        case AWS_JNI_HASH_SHA256_HMAC: {
+            if (secret == NULL) {
+                aws_jni_throw_null_pointer_exception(env, "Hash.hashNew: HMAC secret is null");
+                goto on_error;
+            }
+            struct aws_byte_cursor secret_cursor = aws_jni_byte_cursor_from_jbyteArray_acquire(env, secret);
+            jni_hash->hmac = aws_sha256_hmac_new(allocator, &secret_cursor);
+            aws_jni_byte_cursor_from_jbyteArray_release(env, secret, secret_cursor);
+            break;
+        }
+        default:
+            aws_jni_throw_illegal_argument_exception(env, "Hash.hashNew: unknown algorithm");
+            goto on_error;
+    }
+
+    if (jni_hash->hash == NULL && jni_hash->hmac == NULL) {
+        aws_jni_throw_runtime_exception(env, "Hash.hashNew: failed to create native hash");
+        goto on_error;
+    }
+
+    return (jlong)jni_hash;
+
+on_error:
+
+    s_hash_destroy(jni_hash);
+    return (jlong)0;
+}
+
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_cal_Hash_hashDestroy(JNIEnv *env, jclass jni_class, jlong hash_handle) {
+    (void)env;
+    (void)jni_class;
+
+    struct aws_jni_hash *jni_hash = (struct aws_jni_hash *)hash_handle;
+    if (jni_hash != NULL) {
+        s_hash_destroy(jni_hash);
+    }
+}
+
+/*
+ * Hashes a slice of a heap array. As with checksums, the array is accessed inside a critical region so the JVM hands
+ * us its storage rather than a copy; nothing in the region may call back into the JVM.
+ */
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_cal_Hash_hashUpdate(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong hash_handle,
+    jbyteArray input,
+    jint offset,
+    jint length) {
+
+    (void)jni_class;
+
+    struct aws_jni_hash *jni_hash = (struct aws_jni_hash *)hash_handle;
+    if (jni_hash == NULL) {
+        aws_jni_throw_runtime_exception(env, "Hash.hashUpdate: hash is null");
+        return;
+    }
+    if (input == NULL) {
+        aws_jni_throw_null_pointer_exception(env, "byte[] is null");
+        return;
+    }
+
+    jsize array_length = (*env)->GetArrayLength(env, input);
+    if (offset < 0 || length < 0 || offset > array_length - length) {
+        aws_jni_throw_illegal_argument_exception(env, "hash range is out of bounds");
+        return;
+    }
+    if (length == 0) {
+        return;
+    }
+
+    uint8_t *bytes = (*env)->GetPrimitiveArrayCritical(env, input, NULL);
+    if (bytes == NULL) {
+        /* GetPrimitiveArrayCritical() has thrown exception */
+        return;
+    }
+
+    int result = s_hash_update(jni_hash, aws_byte_cursor_from_array(bytes + offset, (size_t)length));
+    (*env)->ReleasePrimitiveArrayCritical(env, input, bytes, JNI_ABORT);
+
+    if (result) {
+        aws_jni_throw_crt_error(env, aws_last_error());
+    }
+}
+
+/* Hashes a slice of a direct ByteBuffer in place */
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_cal_Hash_hashUpdateDirect(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong hash_handle,
+    jobject input,
+    jint position,
+    jint length) {
+
+    (void)jni_class;
+
+    struct aws_jni_hash *jni_hash = (struct aws_jni_hash *)hash_handle;
+    if (jni_hash == NULL) {
+        aws_jni_throw_runtime_exception(env, "Hash.hashUpdateDirect: hash is null");
+        return;
+    }
+    if (input == NULL) {
+        aws_jni_throw_null_pointer_exception(env, "ByteBuffer is null");
+        return;
+    }
+
+    uint8_t *address = (*env)->GetDirectBufferAddress(env, input);
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, input);
+    if (address == NULL || capacity < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "ByteBuffer is not direct");
+        return;
+    }
+
+    if (position < 0 || length < 0 || (jlong)position + (jlong)length > capacity) {
+        aws_jni_throw_illegal_argument_exception(env, "hash range is out of bounds");
+        return;
+    }
+
+    if (s_hash_update(jni_hash, aws_byte_cursor_from_array(address + position, (size_t)length))) {
+        aws_jni_throw_crt_error(env, aws_last_error());
+    }
+}
+
+JNIEXPORT
+jbyteArray JNICALL
+    Java_software_amazon_awssdk_crt_cal_Hash_hashDigest(JNIEnv *env, jclass jni_class, jlong hash_handle) {
+    (void)jni_class;
+
+    struct aws_jni_hash *jni_hash = (struct aws_jni_hash *)hash_handle;
+    if (jni_hash == NULL) {
+        aws_jni_throw_runtime_exception(env, "Hash.hashDigest: hash is null");
+        return NULL;
+    }
+
+    uint8_t digest[AWS_SHA256_LEN];
+    size_t digest_size = s_digest_size(jni_hash);
+    AWS_FATAL_ASSERT(digest_size <= sizeof(digest));
+
+    struct aws_byte_buf digest_buf = aws_byte_buf_from_empty_array(digest, digest_size);
+    int result = jni_hash->hash != NULL ? aws_hash_finalize(jni_hash->hash, &digest_buf, 0)
+                                        : aws_hmac_finalize(jni_hash->hmac, &digest_buf, 0);
+    if (result) {
+        aws_jni_throw_crt_error(env, aws_last_error());
+        return NULL;
+    }
+
+    struct aws_byte_cursor digest_cursor = aws_byte_cursor_from_buf(&digest_buf);
+    return aws_jni_byte_array_from_cursor(env, &digest_cursor);
+}
+
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(pop)
+#    else
+#        pragma GCC diagnostic pop
+#    endif
+#endif
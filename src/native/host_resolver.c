@@ -4,9 +4,13 @@
  */
 #include <jni.h>
 
+#include <aws/common/clock.h>
+#include <aws/common/string.h>
 #include <aws/io/host_resolver.h>
 
 #include "crt.h"
+#include "host_resolver.h"
+#include "java_class_ids.h"
 
 /* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
 #if UINTPTR_MAX == 0xffffffff
@@ -20,15 +24,51 @@
 #    endif
 #endif
 
+/* Must match HostResolverStatistics.java */
+enum host_resolver_statistic {
+    HOST_RESOLVER_STATISTIC_CACHE_HITS,
+    HOST_RESOLVER_STATISTIC_CACHE_MISSES,
+    HOST_RESOLVER_STATISTIC_NEGATIVE_CACHE_HITS,
+    HOST_RESOLVER_STATISTIC_RESOLVE_FAILURES,
+    HOST_RESOLVER_STATISTIC_COUNT,
+};
+
+struct negative_cache_entry {
+    /* high res clock */
+    uint64_t expires_at_ns;
+    int error_code;
+};
+
+struct resolve_callback_data {
+    JavaVM *jvm;
+    struct aws_jni_host_resolver *jni_resolver;
+    jobject java_future;
+};
+
+static void s_negative_cache_entry_destroy(void *value) {
+    aws_mem_release(aws_jni_io_allocator(), value);
+}
+
+static void s_jni_host_resolver_destroy(void *user_data) {
+    struct aws_jni_host_resolver *jni_resolver = user_data;
+
+    aws_host_resolver_release(jni_resolver->resolver);
+    aws_hash_table_clean_up(&jni_resolver->negative_cache);
+    aws_mutex_clean_up(&jni_resolver->lock);
+    aws_mem_release(jni_resolver->allocator, jni_resolver);
+}
+
 JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_io_HostResolver_hostResolverNew(
     JNIEnv *env,
     jclass jni_class,
     jlong jni_elg,
-    jint max_entries) {
+    jint max_entries,
+    jint max_ttl_seconds,
+    jint negative_ttl_seconds) {
 
     (void)jni_class;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
     struct aws_event_loop_group *el_group = (struct aws_event_loop_group *)jni_elg;
 
     if (!el_group) {
@@ -41,18 +81,62 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_io_HostResolver_hostReso
         return (jlong)NULL;
     }
 
+    if (max_ttl_seconds < 0 || negative_ttl_seconds < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "HostResolver.hostResolverNew: TTLs must be >= 0");
+        return (jlong)NULL;
+    }
+
+    struct aws_jni_host_resolver *jni_resolver = aws_mem_calloc(allocator, 1, sizeof(struct aws_jni_host_resolver));
+    jni_resolver->allocator = allocator;
+    jni_resolver->max_entries = (size_t)max_entries;
+    jni_resolver->resolution_config = aws_host_resolver_init_default_resolution_config();
+    if (max_ttl_seconds > 0) {
+        jni_resolver->resolution_config.max_ttl = (size_t)max_ttl_seconds;
+    }
+    jni_resolver->negative_ttl_ns =
+        aws_timestamp_convert((uint64_t)negative_ttl_seconds, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL);
+    aws_atomic_init_int(&jni_resolver->cache_hits, 0);
+    aws_atomic_init_int(&jni_resolver->cache_misses, 0);
+    aws_atomic_init_int(&jni_resolver->negative_cache_hits, 0);
+    aws_atomic_init_int(&jni_resolver->resolve_failures, 0);
+
+    if (aws_mutex_init(&jni_resolver->lock)) {
+        aws_mem_release(allocator, jni_resolver);
+        aws_jni_throw_runtime_exception(env, "HostResolver.hostResolverNew: aws_mutex_init failed");
+        return (jlong)NULL;
+    }
+
+    if (aws_hash_table_init(
+            &jni_resolver->negative_cache,
+            allocator,
+            (size_t)max_entries,
+            aws_hash_string,
+            aws_hash_callback_string_eq,
+            aws_hash_callback_string_destroy,
+            s_negative_cache_entry_destroy)) {
+        aws_mutex_clean_up(&jni_resolver->lock);
+        aws_mem_release(allocator, jni_resolver);
+        aws_jni_throw_runtime_exception(env, "HostResolver.hostResolverNew: aws_hash_table_init failed");
+        return (jlong)NULL;
+    }
+
     struct aws_host_resolver_default_options resolver_options = {
         .max_entries = max_entries,
         .el_group = el_group,
     };
 
-    struct aws_host_resolver *resolver = aws_host_resolver_new_default(allocator, &resolver_options);
-    if (resolver == NULL) {
+    jni_resolver->resolver = aws_host_resolver_new_default(allocator, &resolver_options);
+    if (jni_resolver->resolver == NULL) {
+        aws_hash_table_clean_up(&jni_resolver->negative_cache);
+        aws_mutex_clean_up(&jni_resolver->lock);
+        aws_mem_release(allocator, jni_resolver);
         aws_jni_throw_runtime_exception(env, "aws_host_resolver_new_default failed");
         return (jlong)NULL;
     }
 
-    return (jlong)resolver;
+    aws_ref_count_init(&jni_resolver->ref_count, jni_resolver, s_jni_host_resolver_destroy);
+
+    return (jlong)jni_resolver;
 }
 
 JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_io_HostResolver_hostResolverRelease(
@@ -62,17 +146,262 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_io_HostResolver_hostResol
 
     (void)jni_class;
 
-    struct aws_host_resolver *resolver = (struct aws_host_resolver *)jni_host_resolver;
-    if (!resolver) {
+    struct aws_jni_host_resolver *jni_resolver = (struct aws_jni_host_resolver *)jni_host_resolver;
+    if (!jni_resolver) {
         aws_jni_throw_runtime_exception(env, "HostResolver.hostResolverRelease: Invalid aws_host_resolver");
         return;
     }
 
-    aws_host_resolver_release(resolver);
+    aws_ref_count_release(&jni_resolver->ref_count);
 
     return;
 }
 
+/*
+ * Returns the error a cached failure of host_name should fail with, or AWS_ERROR_SUCCESS if none is cached. Expired
+ * entries are dropped as they are found.
+ */
+static int s_negative_cache_lookup(struct aws_jni_host_resolver *jni_resolver, const struct aws_string *host_name) {
+    if (jni_resolver->negative_ttl_ns == 0) {
+        return AWS_ERROR_SUCCESS;
+    }
+
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+
+    int error_code = AWS_ERROR_SUCCESS;
+    aws_mutex_lock(&jni_resolver->lock);
+    struct aws_hash_element *element = NULL;
+    aws_hash_table_find(&jni_resolver->negative_cache, host_name, &element);
+    if (element != NULL) {
+        struct negative_cache_entry *entry = element->value;
+        if (now_ns < entry->expires_at_ns) {
+            error_code = entry->error_code;
+        } else {
+            aws_hash_table_remove_element(&jni_resolver->negative_cache, element);
+        }
+    }
+    aws_mutex_unlock(&jni_resolver->lock);
+
+    return error_code;
+}
+
+static void s_negative_cache_put(
+    struct aws_jni_host_resolver *jni_resolver,
+    const struct aws_string *host_name,
+    int error_code) {
+
+    if (jni_resolver->negative_ttl_ns == 0) {
+        return;
+    }
+
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+
+    aws_mutex_lock(&jni_resolver->lock);
+    if (aws_hash_table_get_entry_count(&jni_resolver->negative_cache) >= jni_resolver->max_entries) {
+        /* Make room by dropping whatever has expired; if nothing has, this failure just isn't cached */
+        for (struct aws_hash_iter iter = aws_hash_iter_begin(&jni_resolver->negative_cache); !aws_hash_iter_done(&iter);
+             aws_hash_iter_next(&iter)) {
+            const struct negative_cache_entry *entry = iter.element.value;
+            if (entry->expires_at_ns <= now_ns) {
+                aws_hash_iter_delete(&iter, true);
+            }
+        }
+    }
+
+    if (aws_hash_table_get_entry_count(&jni_resolver->negative_cache) < jni_resolver->max_entries) {
+        struct negative_cache_entry *entry =
+            aws_mem_calloc(jni_resolver->allocator, 1, sizeof(struct negative_cache_entry));
+        entry->expires_at_ns = aws_add_u64_saturating(now_ns, jni_resolver->negative_ttl_ns);
+        entry->error_code = error_code;
+
+        struct aws_string *key = aws_string_new_from_string(jni_resolver->allocator, host_name);
+        /* replaces, and destroys, any entry for the same host */
+        if (key == NULL || aws_hash_table_put(&jni_resolver->negative_cache, key, entry, NULL)) {
+            aws_string_destroy(key);
+            aws_mem_release(jni_resolver->allocator, entry);
+        }
+    }
+    aws_mutex_unlock(&jni_resolver->lock);
+}
+
+static void s_complete_resolve_exceptionally(JNIEnv *env, jobject java_future, int error_code) {
+    if (error_code == AWS_ERROR_SUCCESS) {
+        error_code = AWS_ERROR_UNKNOWN;
+    }
+
+    jobject crt_exception = aws_jni_new_crt_exception_from_error_code(env, error_code);
+
+    (*env)->CallBooleanMethod(
+        env, java_future, completable_future_properties.complete_exceptionally_method_id, crt_exception);
+
+    aws_jni_check_and_clear_exception(env);
+    (*env)->DeleteLocalRef(env, crt_exception);
+}
+
+static jobjectArray s_create_address_array(JNIEnv *env, const struct aws_array_list *host_addresses) {
+    size_t address_count = aws_array_list_length(host_addresses);
+    jobjectArray java_addresses =
+        (*env)->NewObjectArray(env, (jsize)address_count, string_properties.string_class, NULL);
+    if (java_addresses == NULL) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < address_count; ++i) {
+        struct aws_host_address *address = NULL;
+        aws_array_list_get_at_ptr(host_addresses, (void **)&address, i);
+
+        jstring java_address = aws_jni_string_from_string(env, address->address);
+        if (java_address == NULL) {
+            (*env)->DeleteLocalRef(env, java_addresses);
+            return NULL;
+        }
+        (*env)->SetObjectArrayElement(env, java_addresses, (jsize)i, java_address);
+        (*env)->DeleteLocalRef(env, java_address);
+    }
+
+    return java_addresses;
+}
+
+static void s_on_host_resolved(
+    struct aws_host_resolver *resolver,
+    const struct aws_string *host_name,
+    int err_code,
+    const struct aws_array_list *host_addresses,
+    void *user_data) {
+
+    (void)resolver;
+    struct resolve_callback_data *callback_data = user_data;
+    struct aws_jni_host_resolver *jni_resolver = callback_data->jni_resolver;
+
+    if (err_code != AWS_ERROR_SUCCESS) {
+        aws_atomic_fetch_add(&jni_resolver->resolve_failures, 1);
+        s_negative_cache_put(jni_resolver, host_name, err_code);
+    }
+
+    JavaVM *jvm = callback_data->jvm;
+    /********** JNI ENV ACQUIRE **********/
+    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        goto done;
+    }
+
+    if (err_code != AWS_ERROR_SUCCESS) {
+        s_complete_resolve_exceptionally(env, callback_data->java_future, err_code);
+    } else {
+        jobjectArray java_addresses = s_create_address_array(env, host_addresses);
+        if (java_addresses == NULL) {
+            aws_jni_check_and_clear_exception(env);
+            s_complete_resolve_exceptionally(env, callback_data->java_future, AWS_ERROR_UNKNOWN);
+        } else {
+            (*env)->CallBooleanMethod(
+                env, callback_data->java_future, completable_future_properties.complete_method_id, java_addresses);
+            AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
+            (*env)->DeleteLocalRef(env, java_addresses);
+        }
+    }
+
+    (*env)->DeleteGlobalRef(env, callback_data->java_future);
+
+    aws_jni_release_thread_env(jvm, env);
+    /********** JNI ENV RELEASE **********/
+
+done:
+
+    aws_ref_count_release(&jni_resolver->ref_count);
+    aws_mem_release(aws_jni_io_allocator(), callback_data);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_io_HostResolver_hostResolverResolve(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_host_resolver,
+    jstring java_host_name,
+    jobject java_future) {
+
+    (void)jni_class;
+
+    struct aws_jni_host_resolver *jni_resolver = (struct aws_jni_host_resolver *)jni_host_resolver;
+    if (!jni_resolver) {
+        aws_jni_throw_runtime_exception(env, "HostResolver.resolve: Invalid aws_host_resolver");
+        return;
+    }
+
+    struct aws_string *host_name = aws_jni_new_string_from_jstring(env, java_host_name);
+    if (host_name == NULL) {
+        /* exception already pending */
+        return;
+    }
+
+    int cached_error_code = s_negative_cache_lookup(jni_resolver, host_name);
+    if (cached_error_code != AWS_ERROR_SUCCESS) {
+        aws_atomic_fetch_add(&jni_resolver->negative_cache_hits, 1);
+        s_complete_resolve_exceptionally(env, java_future, cached_error_code);
+        goto done;
+    }
+
+    size_t cached_address_count = aws_host_resolver_get_host_address_count(
+        jni_resolver->resolver,
+        host_name,
+        AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_A | AWS_GET_HOST_ADDRESS_COUNT_RECORD_TYPE_AAAA);
+    aws_atomic_fetch_add(cached_address_count > 0 ? &jni_resolver->cache_hits : &jni_resolver->cache_misses, 1);
+
+    struct resolve_callback_data *callback_data =
+        aws_mem_calloc(aws_jni_io_allocator(), 1, sizeof(struct resolve_callback_data));
+    jint jvmresult = (*env)->GetJavaVM(env, &callback_data->jvm);
+    AWS_FATAL_ASSERT(jvmresult == 0);
+    callback_data->java_future = (*env)->NewGlobalRef(env, java_future);
+    AWS_FATAL_ASSERT(callback_data->java_future != NULL);
+    callback_data->jni_resolver = jni_resolver;
+    aws_ref_count_acquire(&jni_resolver->ref_count);
+
+    if (aws_host_resolver_resolve_host(
+            jni_resolver->resolver, host_name, s_on_host_resolved, &jni_resolver->resolution_config, callback_data)) {
+        int error_code = aws_last_error();
+        aws_atomic_fetch_add(&jni_resolver->resolve_failures, 1);
+        s_complete_resolve_exceptionally(env, java_future, error_code);
+
+        (*env)->DeleteGlobalRef(env, callback_data->java_future);
+        aws_mem_release(aws_jni_io_allocator(), callback_data);
+        aws_ref_count_release(&jni_resolver->ref_count);
+    }
+
+done:
+
+    aws_string_destroy(host_name);
+}
+
+JNIEXPORT jlongArray JNICALL Java_software_amazon_awssdk_crt_io_HostResolver_hostResolverStatistics(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_host_resolver) {
+
+    (void)jni_class;
+
+    struct aws_jni_host_resolver *jni_resolver = (struct aws_jni_host_resolver *)jni_host_resolver;
+    if (!jni_resolver) {
+        aws_jni_throw_runtime_exception(env, "HostResolver.getStatistics: Invalid aws_host_resolver");
+        return NULL;
+    }
+
+    jlong values[HOST_RESOLVER_STATISTIC_COUNT];
+    values[HOST_RESOLVER_STATISTIC_CACHE_HITS] = (jlong)aws_atomic_load_int(&jni_resolver->cache_hits);
+    values[HOST_RESOLVER_STATISTIC_CACHE_MISSES] = (jlong)aws_atomic_load_int(&jni_resolver->cache_misses);
+    values[HOST_RESOLVER_STATISTIC_NEGATIVE_CACHE_HITS] =
+        (jlong)aws_atomic_load_int(&jni_resolver->negative_cache_hits);
+    values[HOST_RESOLVER_STATISTIC_RESOLVE_FAILURES] = (jlong)aws_atomic_load_int(&jni_resolver->resolve_failures);
+
+    jlongArray java_values = (*env)->NewLongArray(env, HOST_RESOLVER_STATISTIC_COUNT);
+    if (java_values == NULL) {
+        /* OutOfMemoryError is pending */
+        return NULL;
+    }
+    (*env)->SetLongArrayRegion(env, java_values, 0, HOST_RESOLVER_STATISTIC_COUNT, values);
+    return java_values;
+}
+
 #if UINTPTR_MAX == 0xffffffff
 #    if defined(_MSC_VER)
 #        pragma warning(pop)
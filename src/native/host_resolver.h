@@ -0,0 +1,42 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_HOST_RESOLVER_H
+#define AWS_JNI_CRT_HOST_RESOLVER_H
+
+#include <aws/common/atomics.h>
+#include <aws/common/hash_table.h>
+#include <aws/common/mutex.h>
+#include <aws/common/ref_count.h>
+#include <aws/io/host_resolver.h>
+
+/*
+ * The native half of a Java HostResolver, and what its native handle points to. Besides the resolver, it carries the
+ * resolution config every bootstrap built on it resolves with, so a TTL override applies to all their connections.
+ *
+ * Negative caching and the statistics only cover lookups made through HostResolver.resolve() and prefetch();
+ * connections resolve through the default resolver directly and don't see them.
+ */
+struct aws_jni_host_resolver {
+    struct aws_allocator *allocator;
+    /* held by the Java HostResolver, and by each lookup in flight */
+    struct aws_ref_count ref_count;
+    struct aws_host_resolver *resolver;
+    struct aws_host_resolution_config resolution_config;
+    size_t max_entries;
+    /* 0 when negative caching is off */
+    uint64_t negative_ttl_ns;
+
+    struct aws_mutex lock;
+    /* aws_string host name -> struct negative_cache_entry, guarded by lock */
+    struct aws_hash_table negative_cache;
+
+    struct aws_atomic_var cache_hits;
+    struct aws_atomic_var cache_misses;
+    struct aws_atomic_var negative_cache_hits;
+    struct aws_atomic_var resolve_failures;
+};
+
+#endif /* AWS_JNI_CRT_HOST_RESOLVER_H */
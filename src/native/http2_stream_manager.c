@@ -8,11 +8,16 @@
 #include "http_request_response.h"
 #include "http_request_utils.h"
 #include "java_class_ids.h"
+#include "tls_handshake_metrics.h"
 
+#include <inttypes.h>
 #include <jni.h>
 #include <string.h>
 
+#include <aws/common/clock.h>
 #include <aws/common/condition_variable.h>
+#include <aws/common/hash_table.h>
+#include <aws/common/mutex.h>
 #include <aws/common/string.h>
 
 #include <aws/io/channel_bootstrap.h>
@@ -46,17 +51,196 @@ struct aws_http2_stream_manager_binding {
     JavaVM *jvm;
     jweak java_http2_stream_manager;
     struct aws_http2_stream_manager *stream_manager;
+
+    /*
+     * Connection health, only tracked when eviction is enabled. Maps each aws_http_connection to its
+     * http2_connection_health, connections that get too slow or fail too many streams stop taking new streams.
+     */
+    bool evict_unhealthy_connections;
+    uint64_t eviction_response_latency_ns;
+    uint32_t eviction_error_rate_permille;
+    size_t max_connections;
+    struct aws_mutex health_lock;
+    struct aws_hash_table connection_health;
+};
+
+/* Streams a connection must have completed before it can be judged */
+#define CONNECTION_HEALTH_MIN_STREAMS 8
+/* Weight of the most recent stream in the moving averages, as a right shift: 1/8 */
+#define CONNECTION_HEALTH_EWMA_SHIFT 3
+
+struct http2_connection_health {
+    uint64_t last_used_ns;
+    size_t completed_streams;
+    /* exponentially weighted moving averages over the connection's completed streams */
+    uint64_t response_latency_ewma_ns;
+    uint32_t error_rate_ewma_permille;
 };
 
+static void s_destroy_connection_health(void *value) {
+    aws_mem_release(aws_jni_http_allocator(), value);
+}
+
+static uint64_t s_update_ewma(uint64_t average, uint64_t sample) {
+    return average - (average >> CONNECTION_HEALTH_EWMA_SHIFT) + (sample >> CONNECTION_HEALTH_EWMA_SHIFT);
+}
+
+struct least_recently_used {
+    const void *connection;
+    uint64_t last_used_ns;
+};
+
+static int s_find_least_recently_used(void *context, struct aws_hash_element *element) {
+    struct least_recently_used *lru = context;
+    const struct http2_connection_health *health = element->value;
+    if (lru->connection == NULL || health->last_used_ns < lru->last_used_ns) {
+        lru->connection = element->key;
+        lru->last_used_ns = health->last_used_ns;
+    }
+    return AWS_COMMON_HASH_TABLE_ITER_CONTINUE;
+}
+
+/* Finds or adds the connection's entry, health_lock must be held. Returns NULL if it can't be added. */
+static struct http2_connection_health *s_connection_health_acquire(
+    struct aws_http2_stream_manager_binding *binding,
+    struct aws_http_connection *connection) {
+
+    struct aws_hash_element *element = NULL;
+    aws_hash_table_find(&binding->connection_health, connection, &element);
+    if (element != NULL) {
+        return element->value;
+    }
+
+    if (aws_hash_table_get_entry_count(&binding->connection_health) >= binding->max_connections * 2) {
+        struct least_recently_used lru;
+        AWS_ZERO_STRUCT(lru);
+        aws_hash_table_foreach(&binding->connection_health, s_find_least_recently_used, &lru);
+        aws_hash_table_remove(&binding->connection_health, lru.connection, NULL, NULL);
+    }
+
+    struct http2_connection_health *health =
+        aws_mem_calloc(aws_jni_http_allocator(), 1, sizeof(struct http2_connection_health));
+    if (aws_hash_table_put(&binding->connection_health, connection, health, NULL)) {
+        aws_mem_release(aws_jni_http_allocator(), health);
+        return NULL;
+    }
+    return health;
+}
+
+/*
+ * Records a completed stream against its connection, and stops the connection taking new streams if it's unhealthy.
+ * The stream manager drops connections that stop taking streams once their last stream completes.
+ *
+ * There's no notification when one of the manager's connections goes away. Entries of connections that closed while
+ * in use are dropped here, the others are dropped least recently used first once there are more entries than
+ * connections could be open. A new connection allocated where an old one was may inherit its stats until then.
+ */
+static void s_record_stream_health(
+    struct aws_http2_stream_manager_binding *binding,
+    struct aws_http_stream *stream,
+    int error_code,
+    uint64_t latency_ns) {
+
+    struct aws_http_connection *connection = aws_http_stream_get_connection(stream);
+    if (!aws_http_connection_new_requests_allowed(connection)) {
+        aws_mutex_lock(&binding->health_lock);
+        aws_hash_table_remove(&binding->connection_health, connection, NULL, NULL);
+        aws_mutex_unlock(&binding->health_lock);
+        return;
+    }
+
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+
+    aws_mutex_lock(&binding->health_lock);
+    struct http2_connection_health *health = s_connection_health_acquire(binding, connection);
+    bool evict = false;
+    if (health != NULL) {
+        health->last_used_ns = now_ns;
+        if (health->completed_streams++ == 0) {
+            /* start the averages at the first sample, rather than decaying up from 0 */
+            health->response_latency_ewma_ns = latency_ns;
+            health->error_rate_ewma_permille = error_code ? 1000 : 0;
+        } else {
+            health->response_latency_ewma_ns = s_update_ewma(health->response_latency_ewma_ns, latency_ns);
+            health->error_rate_ewma_permille =
+                (uint32_t)s_update_ewma(health->error_rate_ewma_permille, error_code ? 1000 : 0);
+        }
+
+        if (health->completed_streams >= CONNECTION_HEALTH_MIN_STREAMS) {
+            evict = (binding->eviction_response_latency_ns > 0 &&
+                     health->response_latency_ewma_ns > binding->eviction_response_latency_ns) ||
+                    (binding->eviction_error_rate_permille > 0 &&
+                     health->error_rate_ewma_permille > binding->eviction_error_rate_permille);
+        }
+
+        if (evict) {
+            AWS_LOGF_INFO(
+                AWS_LS_HTTP_STREAM_MANAGER,
+                "id=%p: Evicting unhealthy connection %p, average response latency %" PRIu64
+                "ns, error rate %" PRIu32 " per thousand streams",
+                (void *)binding->stream_manager,
+                (void *)connection,
+                health->response_latency_ewma_ns,
+                health->error_rate_ewma_permille);
+            aws_hash_table_remove(&binding->connection_health, connection, NULL, NULL);
+        }
+    }
+    aws_mutex_unlock(&binding->health_lock);
+
+    if (evict) {
+        /* streams already on the connection carry on, it just isn't handed new ones */
+        aws_http_connection_stop_new_requests(connection);
+    }
+}
+
+static uint64_t s_stream_elapsed_ns(const struct http_stream_binding *stream_binding) {
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+    return now_ns > stream_binding->request_start_ns ? now_ns - stream_binding->request_start_ns : 0;
+}
+
+static int s_on_sm_stream_header_block_done(
+    struct aws_http_stream *stream,
+    enum aws_http_header_block block_type,
+    void *user_data) {
+    struct http_stream_binding *stream_binding = user_data;
+
+    if (block_type == AWS_HTTP_HEADER_BLOCK_MAIN && stream_binding->request_start_ns != 0 &&
+        stream_binding->response_latency_ns == 0) {
+        stream_binding->response_latency_ns = s_stream_elapsed_ns(stream_binding);
+    }
+
+    return aws_java_http_stream_on_incoming_header_block_done_fn(stream, block_type, user_data);
+}
+
+static void s_on_sm_stream_complete(struct aws_http_stream *stream, int error_code, void *user_data) {
+    struct http_stream_binding *stream_binding = user_data;
+
+    if (stream_binding->request_start_ns != 0) {
+        uint64_t latency_ns = stream_binding->response_latency_ns;
+        if (latency_ns == 0) {
+            latency_ns = s_stream_elapsed_ns(stream_binding);
+        }
+        s_record_stream_health(stream_binding->stream_manager_binding, stream, error_code, latency_ns);
+    }
+
+    aws_java_http_stream_on_stream_complete_fn(stream, error_code, user_data);
+}
+
 static void s_destroy_manager_binding(struct aws_http2_stream_manager_binding *binding, JNIEnv *env) {
     if (binding == NULL) {
         return;
     }
+    if (binding->evict_unhealthy_connections) {
+        aws_hash_table_clean_up(&binding->connection_health);
+        aws_mutex_clean_up(&binding->health_lock);
+    }
     if (binding->java_http2_stream_manager != NULL) {
         (*env)->DeleteWeakGlobalRef(env, binding->java_http2_stream_manager);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), binding);
+    aws_mem_release(aws_jni_http_allocator(), binding);
 }
 
 static void s_on_stream_manager_shutdown_complete_callback(void *user_data) {
@@ -113,7 +297,9 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_
     jboolean jni_prior_knowledge,
     jboolean jni_close_connection_on_server_error,
     jint jni_connection_ping_period_ms,
-    jint jni_connection_ping_timeout_ms) {
+    jint jni_connection_ping_timeout_ms,
+    jint jni_connection_eviction_response_latency_ms,
+    jint jni_connection_eviction_error_rate_percent) {
 
     (void)jni_class;
 
@@ -123,7 +309,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_
     struct aws_tls_connection_options *tls_connection_options =
         (struct aws_tls_connection_options *)jni_tls_connection_options;
     struct aws_http2_stream_manager_binding *binding = NULL;
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_http_allocator();
 
     if (!client_bootstrap) {
         aws_jni_throw_illegal_argument_exception(env, "ClientBootstrap can't be null");
@@ -163,6 +349,12 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_
         goto cleanup;
     }
 
+    if (jni_connection_eviction_response_latency_ms < 0 || jni_connection_eviction_error_rate_percent < 0 ||
+        jni_connection_eviction_error_rate_percent > 100) {
+        aws_jni_throw_illegal_argument_exception(env, "Connection eviction thresholds are out of range");
+        goto cleanup;
+    }
+
     uint16_t port = (uint16_t)jni_port;
 
     bool new_tls_conn_opts = (jni_tls_ctx != 0 && !tls_connection_options);
@@ -170,7 +362,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_
     struct aws_tls_connection_options tls_conn_options;
     AWS_ZERO_STRUCT(tls_conn_options);
     if (new_tls_conn_opts) {
-        aws_tls_connection_options_init_from_ctx(&tls_conn_options, tls_ctx);
+        aws_jni_tls_connection_options_init_from_ctx(&tls_conn_options, tls_ctx);
         aws_tls_connection_options_set_server_name(&tls_conn_options, allocator, &endpoint);
         tls_connection_options = &tls_conn_options;
     }
@@ -183,6 +375,23 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_
     (void)jvmresult;
     AWS_FATAL_ASSERT(jvmresult == 0);
 
+    if (jni_connection_eviction_response_latency_ms > 0 || jni_connection_eviction_error_rate_percent > 0) {
+        binding->evict_unhealthy_connections = true;
+        binding->eviction_response_latency_ns = aws_timestamp_convert(
+            (uint64_t)jni_connection_eviction_response_latency_ms, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+        binding->eviction_error_rate_permille = (uint32_t)jni_connection_eviction_error_rate_percent * 10;
+        binding->max_connections = (size_t)jni_max_conns;
+        AWS_FATAL_ASSERT(!aws_mutex_init(&binding->health_lock));
+        AWS_FATAL_ASSERT(!aws_hash_table_init(
+            &binding->connection_health,
+            allocator,
+            (size_t)jni_max_conns,
+            aws_hash_ptr,
+            aws_ptr_eq,
+            NULL,
+            s_destroy_connection_health));
+    }
+
     struct aws_http2_stream_manager_options manager_options = {
         .bootstrap = client_bootstrap,
         .initial_settings_array = initial_settings,
@@ -276,7 +485,7 @@ static void s_cleanup_sm_acquire_stream_callback_data(
     if (callback_data->java_async_callback) {
         (*env)->DeleteGlobalRef(env, callback_data->java_async_callback);
     }
-    aws_mem_release(aws_jni_get_allocator(), callback_data);
+    aws_mem_release(aws_jni_http_allocator(), callback_data);
 }
 
 static struct aws_sm_acquire_stream_callback_data *s_new_sm_acquire_stream_callback_data(
@@ -316,6 +525,9 @@ static void s_on_stream_acquired(struct aws_http_stream *stream, int error_code,
         aws_http_stream_binding_acquire(callback_data->stream_binding);
 
         callback_data->stream_binding->native_stream = stream;
+        if (callback_data->stream_binding->stream_manager_binding != NULL) {
+            aws_high_res_clock_get_ticks(&callback_data->stream_binding->request_start_ns);
+        }
         jobject j_http_stream =
             aws_java_http_stream_from_native_new(env, callback_data->stream_binding, AWS_HTTP_VERSION_2);
         if (!j_http_stream) {
@@ -348,6 +560,7 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_h
     jclass jni_class,
     jlong jni_stream_manager,
     jbyteArray marshalled_request,
+    jlong jni_header_template,
     jobject jni_http_request_body_stream,
     jobject jni_http_response_callback_handler,
     jobject java_async_callback) {
@@ -376,8 +589,8 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_h
         return;
     }
 
-    stream_binding->native_request =
-        aws_http_request_new_from_java_http_request(env, marshalled_request, jni_http_request_body_stream);
+    stream_binding->native_request = aws_http_request_new_from_java_http_request_with_template(
+        env, marshalled_request, jni_http_request_body_stream, (struct aws_http_headers *)jni_header_template);
     if (stream_binding->native_request == NULL) {
         /* Exception already thrown */
         aws_http_stream_binding_release(env, stream_binding);
@@ -396,7 +609,13 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2StreamManager_h
         .user_data = stream_binding,
     };
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    if (sm_binding->evict_unhealthy_connections) {
+        stream_binding->stream_manager_binding = sm_binding;
+        request_options.on_response_header_block_done = s_on_sm_stream_header_block_done;
+        request_options.on_complete = s_on_sm_stream_complete;
+    }
+
+    struct aws_allocator *allocator = aws_jni_http_allocator();
     struct aws_sm_acquire_stream_callback_data *callback_data =
         s_new_sm_acquire_stream_callback_data(env, allocator, stream_binding, java_async_callback);
 
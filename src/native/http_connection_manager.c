@@ -5,11 +5,16 @@
 
 #include "crt.h"
 #include "java_class_ids.h"
+#include "tls_handshake_metrics.h"
 
 #include <jni.h>
 #include <string.h>
 
+#include <aws/common/atomics.h>
+#include <aws/common/clock.h>
 #include <aws/common/condition_variable.h>
+#include <aws/common/math.h>
+#include <aws/common/mutex.h>
 #include <aws/common/string.h>
 
 #include <aws/io/channel_bootstrap.h>
@@ -37,6 +42,21 @@
 #    endif
 #endif
 
+/* Buckets of the acquisition wait time histogram, matches HttpManagerMetrics */
+#define ACQUISITION_WAIT_TIME_BUCKET_COUNT 9
+static const uint64_t s_acquisition_wait_time_bucket_bounds_ms[ACQUISITION_WAIT_TIME_BUCKET_COUNT - 1] =
+    {1, 5, 10, 50, 100, 500, 1000, 5000};
+
+struct connection_acquisition_stats {
+    uint64_t succeeded;
+    uint64_t failed;
+    uint64_t rejected;
+    uint64_t timed_out;
+    uint64_t total_wait_ns;
+    uint64_t max_wait_ns;
+    uint64_t wait_time_histogram[ACQUISITION_WAIT_TIME_BUCKET_COUNT];
+};
+
 /*
  * Connection manager binding, persists across the lifetime of the native object.
  */
@@ -44,6 +64,34 @@ struct http_connection_manager_binding {
     JavaVM *jvm;
     jweak java_http_conn_manager;
     struct aws_http_connection_manager *manager;
+
+    size_t max_connections;
+
+    /* Acquisition limits, enforced on this side of the native manager. 0 means no limit. */
+    size_t max_pending_acquisitions;
+    uint64_t acquisition_timeout_ns;
+    /* acquisition timeouts are scheduled on its event loops */
+    struct aws_event_loop_group *event_loop_group;
+    struct aws_atomic_var pending_acquisitions;
+
+    struct aws_mutex stats_lock;
+    struct connection_acquisition_stats stats;
+
+    /*
+     * The pool is topped up to min_connections by min_connections_task, which runs periodically on
+     * min_connections_loop. The manager is then released from that loop too, so the task never acquires
+     * from a released manager. min_connections_task_scheduled is only touched from there.
+     */
+    size_t min_connections;
+    uint64_t min_connections_check_interval_ns;
+    struct aws_event_loop *min_connections_loop;
+    struct aws_task min_connections_task;
+    struct aws_task release_task;
+    bool min_connections_task_scheduled;
+    struct aws_atomic_var min_connections_warmup_in_flight;
+
+    /* One for the native manager until its shutdown completes, plus one per acquisition in flight */
+    struct aws_atomic_var ref_count;
 };
 
 static void s_destroy_manager_binding(struct http_connection_manager_binding *binding, JNIEnv *env) {
@@ -55,7 +103,21 @@ static void s_destroy_manager_binding(struct http_connection_manager_binding *bi
         (*env)->DeleteWeakGlobalRef(env, binding->java_http_conn_manager);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), binding);
+    aws_event_loop_group_release(binding->event_loop_group);
+    aws_mutex_clean_up(&binding->stats_lock);
+    aws_mem_release(aws_jni_http_allocator(), binding);
+}
+
+static void s_acquire_manager_binding(struct http_connection_manager_binding *binding) {
+    aws_atomic_fetch_add(&binding->ref_count, 1);
+}
+
+static void s_release_manager_binding(struct http_connection_manager_binding *binding, JNIEnv *env) {
+    size_t pre_ref = aws_atomic_fetch_sub(&binding->ref_count, 1);
+    AWS_ASSERT(pre_ref > 0 && "connection manager binding refcount has gone negative");
+    if (pre_ref == 1) {
+        s_destroy_manager_binding(binding, env);
+    }
 }
 
 static void s_on_http_conn_manager_shutdown_complete_callback(void *user_data) {
@@ -79,14 +141,220 @@ static void s_on_http_conn_manager_shutdown_complete_callback(void *user_data) {
         (*env)->DeleteLocalRef(env, java_http_conn_manager);
     }
 
-    // We're done with this wrapper, free it.
+    // We're done with this wrapper, free it once the last acquisition timeout is done with it too.
     JavaVM *jvm = binding->jvm;
-    s_destroy_manager_binding(binding, env);
+    s_release_manager_binding(binding, env);
+
+    aws_jni_release_thread_env(jvm, env);
+    /********** JNI ENV RELEASE **********/
+}
+
+/*
+ * Warms up connections by acquiring them from the pool, which establishes new ones once the idle ones run out.
+ * Idle connections handed out while the acquisitions are still being issued are held until the last one is issued,
+ * so they can't be handed straight back to the next acquisition instead of a new connection being made. Every other
+ * connection goes back to the pool as soon as it arrives, so requests made meanwhile aren't kept waiting on it.
+ */
+struct http_connection_warmup {
+    struct http_connection_manager_binding *manager_binding;
+    /* NULL when topping the pool up to min_connections */
+    jobject java_prewarm_future;
+
+    struct aws_mutex lock;
+    struct aws_array_list held_connections;
+    bool issuing;
+    /* acquisitions yet to call back, plus one until they've all been issued */
+    size_t remaining;
+    size_t warmed;
+    int error_code;
+};
+
+static void s_complete_warmup(struct http_connection_warmup *warmup) {
+    struct http_connection_manager_binding *manager_binding = warmup->manager_binding;
+
+    /********** JNI ENV ACQUIRE **********/
+    JavaVM *jvm = manager_binding->jvm;
+    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        return;
+    }
+
+    AWS_LOGF_DEBUG(
+        AWS_LS_HTTP_CONNECTION_MANAGER,
+        "ConnManager warmed %zu connections: manager: %p, err_code: %d",
+        warmup->warmed,
+        (void *)manager_binding->manager,
+        warmup->error_code);
+
+    if (warmup->java_prewarm_future != NULL) {
+        (*env)->CallStaticVoidMethod(
+            env,
+            http_client_connection_manager_properties.http_client_connection_manager_class,
+            http_client_connection_manager_properties.onPrewarmComplete,
+            warmup->java_prewarm_future,
+            (jint)warmup->warmed,
+            (jint)warmup->error_code);
+        AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
+        (*env)->DeleteGlobalRef(env, warmup->java_prewarm_future);
+    } else {
+        aws_atomic_store_int(&manager_binding->min_connections_warmup_in_flight, 0);
+    }
+
+    aws_array_list_clean_up(&warmup->held_connections);
+    aws_mutex_clean_up(&warmup->lock);
+    aws_mem_release(aws_jni_http_allocator(), warmup);
+    s_release_manager_binding(manager_binding, env);
 
     aws_jni_release_thread_env(jvm, env);
     /********** JNI ENV RELEASE **********/
 }
 
+static void s_on_warmup_connection_acquired(struct aws_http_connection *connection, int error_code, void *user_data) {
+    struct http_connection_warmup *warmup = user_data;
+    struct http_connection_manager_binding *manager_binding = warmup->manager_binding;
+
+    aws_mutex_lock(&warmup->lock);
+    if (connection != NULL) {
+        ++warmup->warmed;
+        if (warmup->issuing) {
+            aws_array_list_push_back(&warmup->held_connections, &connection);
+            connection = NULL;
+        }
+    } else if (warmup->error_code == AWS_ERROR_SUCCESS) {
+        warmup->error_code = error_code ? error_code : AWS_ERROR_UNKNOWN;
+    }
+    bool done = --warmup->remaining == 0;
+    aws_mutex_unlock(&warmup->lock);
+
+    if (connection != NULL) {
+        aws_http_connection_manager_release_connection(manager_binding->manager, connection);
+    }
+
+    if (done) {
+        s_complete_warmup(warmup);
+    }
+}
+
+/*
+ * Establishes up to new_connections connections on top of those already in the pool, never going past the maximum.
+ * Takes ownership of java_prewarm_future, which may be NULL.
+ */
+static void s_warmup_connections(
+    struct http_connection_manager_binding *manager_binding,
+    size_t new_connections,
+    jobject java_prewarm_future) {
+
+    struct aws_http_manager_metrics metrics;
+    aws_http_connection_manager_fetch_metrics(manager_binding->manager, &metrics);
+    /* acquisitions already waiting may have connections of their own on the way */
+    size_t connections =
+        metrics.available_concurrency + metrics.leased_concurrency + metrics.pending_concurrency_acquires;
+    size_t headroom =
+        manager_binding->max_connections > connections ? manager_binding->max_connections - connections : 0;
+    new_connections = aws_min_size(new_connections, headroom);
+
+    struct aws_allocator *allocator = aws_jni_http_allocator();
+    struct http_connection_warmup *warmup = aws_mem_calloc(allocator, 1, sizeof(struct http_connection_warmup));
+    warmup->manager_binding = manager_binding;
+    warmup->java_prewarm_future = java_prewarm_future;
+    AWS_FATAL_ASSERT(!aws_mutex_init(&warmup->lock));
+    AWS_FATAL_ASSERT(!aws_array_list_init_dynamic(
+        &warmup->held_connections, allocator, metrics.available_concurrency + 1, sizeof(struct aws_http_connection *)));
+    s_acquire_manager_binding(manager_binding);
+
+    /* the idle connections are served first, everything past them is a new connection */
+    size_t count = new_connections > 0 ? metrics.available_concurrency + new_connections : 0;
+    if (count == 0) {
+        /* nothing to establish, the idle connections are already warm */
+        warmup->warmed = metrics.available_concurrency;
+    }
+
+    /* set before the first acquisition, which may complete right away */
+    warmup->issuing = true;
+    warmup->remaining = count + 1;
+
+    for (size_t i = 0; i < count; ++i) {
+        aws_http_connection_manager_acquire_connection(
+            manager_binding->manager, s_on_warmup_connection_acquired, warmup);
+    }
+
+    aws_mutex_lock(&warmup->lock);
+    warmup->issuing = false;
+    bool done = --warmup->remaining == 0;
+    aws_mutex_unlock(&warmup->lock);
+
+    /* safe without the lock, nothing is added once issuing is over */
+    size_t held_count = aws_array_list_length(&warmup->held_connections);
+    for (size_t i = 0; i < held_count; ++i) {
+        struct aws_http_connection *held_connection = NULL;
+        aws_array_list_get_at(&warmup->held_connections, &held_connection, i);
+        aws_http_connection_manager_release_connection(manager_binding->manager, held_connection);
+    }
+
+    if (done) {
+        s_complete_warmup(warmup);
+    }
+}
+
+static void s_schedule_min_connections_check(struct http_connection_manager_binding *binding, uint64_t delay_ns) {
+    uint64_t now_ns = 0;
+    aws_event_loop_current_clock_time(binding->min_connections_loop, &now_ns);
+    binding->min_connections_task_scheduled = true;
+    aws_event_loop_schedule_task_future(
+        binding->min_connections_loop, &binding->min_connections_task, now_ns + delay_ns);
+}
+
+static void s_on_min_connections_check(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+
+    struct http_connection_manager_binding *binding = arg;
+    binding->min_connections_task_scheduled = false;
+
+    if (status != AWS_TASK_STATUS_RUN_READY) {
+        /* the manager is being released, let go of the reference the task held */
+        /********** JNI ENV ACQUIRE **********/
+        JavaVM *jvm = binding->jvm;
+        JNIEnv *env = aws_jni_acquire_thread_env(jvm);
+        if (env == NULL) {
+            /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+            return;
+        }
+        s_release_manager_binding(binding, env);
+        aws_jni_release_thread_env(jvm, env);
+        /********** JNI ENV RELEASE **********/
+        return;
+    }
+
+    /* one top-up at a time, the connections it's still establishing don't show up in the metrics yet */
+    if (aws_atomic_load_int(&binding->min_connections_warmup_in_flight) == 0) {
+        struct aws_http_manager_metrics metrics;
+        aws_http_connection_manager_fetch_metrics(binding->manager, &metrics);
+        size_t connections = metrics.available_concurrency + metrics.leased_concurrency;
+        if (connections < binding->min_connections) {
+            /* only what's missing is established, the idle and leased connections already count */
+            aws_atomic_store_int(&binding->min_connections_warmup_in_flight, 1);
+            s_warmup_connections(binding, binding->min_connections - connections, NULL);
+        }
+    }
+
+    s_schedule_min_connections_check(binding, binding->min_connections_check_interval_ns);
+}
+
+static void s_on_release_manager_task(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+
+    struct http_connection_manager_binding *binding = arg;
+
+    /* cancelling runs the check right away, with a cancelled status. A loop shutting down cancels it anyway */
+    if (status == AWS_TASK_STATUS_RUN_READY && binding->min_connections_task_scheduled) {
+        aws_event_loop_cancel_task(binding->min_connections_loop, &binding->min_connections_task);
+    }
+
+    AWS_LOGF_DEBUG(AWS_LS_HTTP_CONNECTION, "Releasing ConnManager: id: %p", (void *)binding->manager);
+    aws_http_connection_manager_release(binding->manager);
+}
+
 void aws_http_proxy_options_jni_init(
     JNIEnv *env,
     struct aws_http_proxy_options *options,
@@ -99,7 +367,7 @@ void aws_http_proxy_options_jni_init(
     int proxy_authorization_type,
     struct aws_tls_ctx *proxy_tls_ctx) {
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_http_allocator();
 
     options->connection_type = proxy_connection_type;
     options->port = proxy_port;
@@ -118,7 +386,7 @@ void aws_http_proxy_options_jni_init(
     }
 
     if (proxy_tls_ctx != NULL) {
-        aws_tls_connection_options_init_from_ctx(tls_options, proxy_tls_ctx);
+        aws_jni_tls_connection_options_init_from_ctx(tls_options, proxy_tls_ctx);
         aws_tls_connection_options_set_server_name(tls_options, allocator, &options->host);
         options->tls_options = tls_options;
     }
@@ -171,7 +439,10 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnectio
     jlong jni_max_connection_idle_in_milliseconds,
     jlong jni_monitoring_throughput_threshold_in_bytes_per_second,
     jint jni_monitoring_failure_interval_in_seconds,
-    jint jni_expected_protocol_version) {
+    jint jni_expected_protocol_version,
+    jint jni_max_pending_connection_acquisitions,
+    jlong jni_connection_acquisition_timeout_in_milliseconds,
+    jint jni_min_connections) {
 
     (void)jni_class;
     (void)jni_expected_protocol_version;
@@ -193,7 +464,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnectio
         return (jlong)NULL;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_http_allocator();
     struct aws_byte_cursor endpoint = aws_jni_byte_cursor_from_jbyteArray_acquire(env, jni_endpoint);
 
     if (jni_port <= 0 || 65535 < jni_port) {
@@ -211,6 +482,16 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnectio
         goto cleanup;
     }
 
+    if (jni_max_pending_connection_acquisitions < 0 || jni_connection_acquisition_timeout_in_milliseconds < 0) {
+        aws_jni_throw_runtime_exception(env, "Connection acquisition limits must be >= 0");
+        goto cleanup;
+    }
+
+    if (jni_min_connections < 0 || jni_min_connections > jni_max_conns) {
+        aws_jni_throw_runtime_exception(env, "Min Connections must be between 0 and Max Connections");
+        goto cleanup;
+    }
+
     uint16_t port = (uint16_t)jni_port;
 
     bool new_tls_conn_opts = (jni_tls_ctx != 0 && !tls_connection_options);
@@ -218,7 +499,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnectio
     struct aws_tls_connection_options tls_conn_options;
     AWS_ZERO_STRUCT(tls_conn_options);
     if (new_tls_conn_opts) {
-        aws_tls_connection_options_init_from_ctx(&tls_conn_options, tls_ctx);
+        aws_jni_tls_connection_options_init_from_ctx(&tls_conn_options, tls_ctx);
         aws_tls_connection_options_set_server_name(&tls_conn_options, allocator, &endpoint);
         tls_connection_options = &tls_conn_options;
     }
@@ -231,6 +512,27 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnectio
     (void)jvmresult;
     AWS_FATAL_ASSERT(jvmresult == 0);
 
+    binding->max_connections = (size_t)jni_max_conns;
+    binding->max_pending_acquisitions = (size_t)jni_max_pending_connection_acquisitions;
+    binding->acquisition_timeout_ns = aws_timestamp_convert(
+        (uint64_t)jni_connection_acquisition_timeout_in_milliseconds, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+    binding->event_loop_group = aws_event_loop_group_acquire(client_bootstrap->event_loop_group);
+    aws_atomic_init_int(&binding->pending_acquisitions, 0);
+    AWS_FATAL_ASSERT(!aws_mutex_init(&binding->stats_lock));
+    aws_atomic_init_int(&binding->ref_count, 1);
+
+    binding->min_connections = (size_t)jni_min_connections;
+    /* check often enough to refill connections soon after idle ones are culled */
+    binding->min_connections_check_interval_ns =
+        jni_max_connection_idle_in_milliseconds > 0
+            ? aws_timestamp_convert(
+                  aws_max_u64((uint64_t)jni_max_connection_idle_in_milliseconds / 2, 100),
+                  AWS_TIMESTAMP_MILLIS,
+                  AWS_TIMESTAMP_NANOS,
+                  NULL)
+            : aws_timestamp_convert(5, AWS_TIMESTAMP_SECS, AWS_TIMESTAMP_NANOS, NULL);
+    aws_atomic_init_int(&binding->min_connections_warmup_in_flight, 0);
+
     struct aws_http_connection_manager_options manager_options;
     AWS_ZERO_STRUCT(manager_options);
 
@@ -285,6 +587,14 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnectio
     if (binding->manager == NULL) {
         aws_jni_throw_runtime_exception(
             env, "Failed to create connection manager: %s", aws_error_str(aws_last_error()));
+    } else if (binding->min_connections > 0) {
+        /* the first check runs right away, so the pool starts warming as soon as it exists */
+        binding->min_connections_loop = aws_event_loop_group_get_next_loop(binding->event_loop_group);
+        aws_task_init(
+            &binding->min_connections_task, s_on_min_connections_check, binding, "http_connection_manager_min_conns");
+        aws_task_init(&binding->release_task, s_on_release_manager_task, binding, "http_connection_manager_release");
+        s_acquire_manager_binding(binding);
+        s_schedule_min_connections_check(binding, 0);
     }
 
     aws_http_proxy_options_jni_clean_up(
@@ -322,6 +632,12 @@ JNIEXPORT void JNICALL
         return;
     }
 
+    if (binding->min_connections_loop != NULL) {
+        /* released from the loop that tops the pool up, so that never acquires from a released manager */
+        aws_event_loop_schedule_task_now(binding->min_connections_loop, &binding->release_task);
+        return;
+    }
+
     AWS_LOGF_DEBUG(AWS_LS_HTTP_CONNECTION, "Releasing ConnManager: id: %p", (void *)conn_manager);
     aws_http_connection_manager_release(conn_manager);
 }
@@ -341,7 +657,185 @@ static void s_destroy_connection_binding(struct aws_http_connection_binding *bin
         aws_http_connection_manager_release_connection(binding->manager, binding->connection);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), binding);
+    aws_mem_release(aws_jni_http_allocator(), binding);
+}
+
+/*
+ * An acquisition in flight. It ends either when the native manager calls back, or when its timeout fires first,
+ * whichever wins the state change away from pending. A connection delivered after the timeout won goes straight
+ * back into the pool. A timed out acquisition still counts against max_pending_acquisitions until then, since the
+ * native manager has no way to take it back out of its queue.
+ */
+enum connection_acquisition_state {
+    CONNECTION_ACQUISITION_PENDING,
+    CONNECTION_ACQUISITION_COMPLETED,
+    CONNECTION_ACQUISITION_TIMED_OUT,
+};
+
+struct http_connection_acquisition {
+    struct http_connection_manager_binding *manager_binding;
+    jobject java_acquire_connection_future;
+    uint64_t start_ns;
+    struct aws_atomic_var state;
+
+    /* One for the acquisition callback, plus one for each of the tasks below while it's scheduled */
+    struct aws_atomic_var ref_count;
+
+    /* Both tasks run on timeout_loop. timeout_task_done is only touched from there. */
+    struct aws_event_loop *timeout_loop;
+    struct aws_task timeout_task;
+    struct aws_task cancel_timeout_task;
+    bool timeout_task_done;
+};
+
+static void s_release_connection_acquisition(struct http_connection_acquisition *acquisition, JNIEnv *env) {
+    size_t pre_ref = aws_atomic_fetch_sub(&acquisition->ref_count, 1);
+    AWS_ASSERT(pre_ref > 0 && "connection acquisition refcount has gone negative");
+    if (pre_ref != 1) {
+        return;
+    }
+
+    if (acquisition->java_acquire_connection_future != NULL) {
+        (*env)->DeleteGlobalRef(env, acquisition->java_acquire_connection_future);
+    }
+    s_release_manager_binding(acquisition->manager_binding, env);
+    aws_mem_release(aws_jni_http_allocator(), acquisition);
+}
+
+enum connection_acquisition_outcome {
+    CONNECTION_ACQUISITION_OUTCOME_SUCCEEDED,
+    CONNECTION_ACQUISITION_OUTCOME_FAILED,
+    CONNECTION_ACQUISITION_OUTCOME_TIMED_OUT,
+};
+
+static void s_record_connection_acquisition(
+    struct http_connection_manager_binding *manager_binding,
+    uint64_t start_ns,
+    enum connection_acquisition_outcome outcome) {
+
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+    uint64_t wait_ns = now_ns > start_ns ? now_ns - start_ns : 0;
+    uint64_t wait_ms = aws_timestamp_convert(wait_ns, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MILLIS, NULL);
+
+    size_t bucket = 0;
+    while (bucket < ACQUISITION_WAIT_TIME_BUCKET_COUNT - 1 &&
+           wait_ms >= s_acquisition_wait_time_bucket_bounds_ms[bucket]) {
+        ++bucket;
+    }
+
+    aws_mutex_lock(&manager_binding->stats_lock);
+    struct connection_acquisition_stats *stats = &manager_binding->stats;
+    switch (outcome) {
+        case CONNECTION_ACQUISITION_OUTCOME_SUCCEEDED:
+            ++stats->succeeded;
+            break;
+        case CONNECTION_ACQUISITION_OUTCOME_FAILED:
+            ++stats->failed;
+            break;
+        case CONNECTION_ACQUISITION_OUTCOME_TIMED_OUT:
+            ++stats->timed_out;
+            break;
+    }
+    stats->total_wait_ns += wait_ns;
+    stats->max_wait_ns = aws_max_u64(stats->max_wait_ns, wait_ns);
+    ++stats->wait_time_histogram[bucket];
+    aws_mutex_unlock(&manager_binding->stats_lock);
+}
+
+static void s_complete_java_connection_acquisition(
+    JNIEnv *env,
+    jobject java_acquire_connection_future,
+    struct aws_http_connection_binding *connection_binding,
+    int error_code) {
+
+    (*env)->CallStaticVoidMethod(
+        env,
+        http_client_connection_properties.http_client_connection_class,
+        http_client_connection_properties.on_connection_acquired_method_id,
+        java_acquire_connection_future,
+        (jlong)connection_binding,
+        (jint)error_code);
+
+    AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
+}
+
+static void s_on_connection_acquisition_timeout(struct aws_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+
+    struct http_connection_acquisition *acquisition = arg;
+    struct http_connection_manager_binding *manager_binding = acquisition->manager_binding;
+    acquisition->timeout_task_done = true;
+
+    /********** JNI ENV ACQUIRE **********/
+    JavaVM *jvm = manager_binding->jvm;
+    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        return;
+    }
+
+    size_t expected_state = CONNECTION_ACQUISITION_PENDING;
+    if (status == AWS_TASK_STATUS_RUN_READY &&
+        aws_atomic_compare_exchange_int(&acquisition->state, &expected_state, CONNECTION_ACQUISITION_TIMED_OUT)) {
+        /* still queued in the native manager, so it stays pending until the manager calls back */
+        s_record_connection_acquisition(
+            manager_binding, acquisition->start_ns, CONNECTION_ACQUISITION_OUTCOME_TIMED_OUT);
+
+        AWS_LOGF_DEBUG(
+            AWS_LS_HTTP_CONNECTION,
+            "ConnManager acquisition timed out: manager: %p",
+            (void *)manager_binding->manager);
+        s_complete_java_connection_acquisition(
+            env, acquisition->java_acquire_connection_future, NULL, AWS_ERROR_JAVA_CRT_CONNECTION_ACQUISITION_TIMEOUT);
+    }
+
+    s_release_connection_acquisition(acquisition, env);
+
+    aws_jni_release_thread_env(jvm, env);
+    /********** JNI ENV RELEASE **********/
+}
+
+static void s_on_cancel_connection_acquisition_timeout(
+    struct aws_task *task,
+    void *arg,
+    enum aws_task_status status) {
+    (void)task;
+
+    struct http_connection_acquisition *acquisition = arg;
+
+    /* cancelling runs the timeout task right away, with a cancelled status */
+    if (status == AWS_TASK_STATUS_RUN_READY && !acquisition->timeout_task_done) {
+        aws_event_loop_cancel_task(acquisition->timeout_loop, &acquisition->timeout_task);
+    }
+
+    /********** JNI ENV ACQUIRE **********/
+    JavaVM *jvm = acquisition->manager_binding->jvm;
+    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        return;
+    }
+
+    s_release_connection_acquisition(acquisition, env);
+
+    aws_jni_release_thread_env(jvm, env);
+    /********** JNI ENV RELEASE **********/
+}
+
+/* The timeout task may only be cancelled from its own event loop, so cancelling is a task too */
+static void s_cancel_connection_acquisition_timeout(struct http_connection_acquisition *acquisition) {
+    if (acquisition->timeout_loop == NULL) {
+        return;
+    }
+
+    aws_atomic_fetch_add(&acquisition->ref_count, 1);
+    aws_task_init(
+        &acquisition->cancel_timeout_task,
+        s_on_cancel_connection_acquisition_timeout,
+        acquisition,
+        "http_connection_acquisition_cancel_timeout");
+    aws_event_loop_schedule_task_now(acquisition->timeout_loop, &acquisition->cancel_timeout_task);
 }
 
 static void s_on_http_conn_acquisition_callback(
@@ -349,41 +843,57 @@ static void s_on_http_conn_acquisition_callback(
     int error_code,
     void *user_data) {
 
-    struct aws_http_connection_binding *binding = (struct aws_http_connection_binding *)user_data;
-    binding->connection = connection;
+    struct http_connection_acquisition *acquisition = (struct http_connection_acquisition *)user_data;
+    struct http_connection_manager_binding *manager_binding = acquisition->manager_binding;
 
     /********** JNI ENV ACQUIRE **********/
-    JNIEnv *env = aws_jni_acquire_thread_env(binding->jvm);
+    JavaVM *jvm = manager_binding->jvm;
+    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
     if (env == NULL) {
         /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
         return;
     }
 
-    jint jni_error_code = (jint)error_code;
-
     AWS_LOGF_DEBUG(
         AWS_LS_HTTP_CONNECTION,
         "ConnManager Acquired Conn: conn: %p, manager: %p, err_code: %d,  err_str: %s",
         (void *)connection,
-        (void *)binding->manager,
+        (void *)manager_binding->manager,
         error_code,
         aws_error_str(error_code));
 
-    (*env)->CallStaticVoidMethod(
-        env,
-        http_client_connection_properties.http_client_connection_class,
-        http_client_connection_properties.on_connection_acquired_method_id,
-        binding->java_acquire_connection_future,
-        (jlong)binding,
-        jni_error_code);
-
-    AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
-
-    JavaVM *jvm = binding->jvm;
-    if (error_code) {
-        s_destroy_connection_binding(binding, env);
+    /* counted as pending until now even if it timed out, the native manager was still holding on to it */
+    aws_atomic_fetch_sub(&manager_binding->pending_acquisitions, 1);
+
+    size_t expected_state = CONNECTION_ACQUISITION_PENDING;
+    if (aws_atomic_compare_exchange_int(&acquisition->state, &expected_state, CONNECTION_ACQUISITION_COMPLETED)) {
+        s_record_connection_acquisition(
+            manager_binding,
+            acquisition->start_ns,
+            error_code ? CONNECTION_ACQUISITION_OUTCOME_FAILED : CONNECTION_ACQUISITION_OUTCOME_SUCCEEDED);
+        s_cancel_connection_acquisition_timeout(acquisition);
+
+        struct aws_http_connection_binding *binding =
+            aws_mem_calloc(aws_jni_http_allocator(), 1, sizeof(struct aws_http_connection_binding));
+        binding->jvm = jvm;
+        binding->manager = manager_binding->manager;
+        binding->connection = connection;
+        /* the connection binding owns the future from here on */
+        binding->java_acquire_connection_future = acquisition->java_acquire_connection_future;
+        acquisition->java_acquire_connection_future = NULL;
+
+        s_complete_java_connection_acquisition(env, binding->java_acquire_connection_future, binding, error_code);
+
+        if (error_code) {
+            s_destroy_connection_binding(binding, env);
+        }
+    } else if (connection != NULL) {
+        /* Java was already told this acquisition timed out, nobody is waiting for this connection */
+        aws_http_connection_manager_release_connection(manager_binding->manager, connection);
     }
 
+    s_release_connection_acquisition(acquisition, env);
+
     aws_jni_release_thread_env(jvm, env);
     /********** JNI ENV RELEASE **********/
 }
@@ -406,8 +916,22 @@ JNIEXPORT void JNICALL
         return;
     }
 
+    size_t pending = aws_atomic_fetch_add(&manager_binding->pending_acquisitions, 1);
+    if (manager_binding->max_pending_acquisitions > 0 && pending >= manager_binding->max_pending_acquisitions) {
+        /* shed load immediately rather than queueing behind everyone else */
+        aws_atomic_fetch_sub(&manager_binding->pending_acquisitions, 1);
+        aws_mutex_lock(&manager_binding->stats_lock);
+        ++manager_binding->stats.rejected;
+        aws_mutex_unlock(&manager_binding->stats_lock);
+
+        s_complete_java_connection_acquisition(
+            env, acquire_future, NULL, AWS_ERROR_JAVA_CRT_MAX_PENDING_CONNECTION_ACQUISITIONS_EXCEEDED);
+        return;
+    }
+
     jobject future_ref = (*env)->NewGlobalRef(env, acquire_future);
     if (future_ref == NULL) {
+        aws_atomic_fetch_sub(&manager_binding->pending_acquisitions, 1);
         aws_jni_throw_runtime_exception(
             env, "httpClientConnectionManagerAcquireConnection: failed to obtain ref to future");
         return;
@@ -415,18 +939,34 @@ JNIEXPORT void JNICALL
 
     AWS_LOGF_DEBUG(AWS_LS_HTTP_CONNECTION, "Requesting a new connection from conn_manager: %p", (void *)conn_manager);
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
-    struct aws_http_connection_binding *connection_binding =
-        aws_mem_calloc(allocator, 1, sizeof(struct aws_http_connection_binding));
-    connection_binding->java_acquire_connection_future = future_ref;
-    connection_binding->manager = conn_manager;
-
-    jint jvmresult = (*env)->GetJavaVM(env, &connection_binding->jvm);
-    (void)jvmresult;
-    AWS_FATAL_ASSERT(jvmresult == 0);
+    struct aws_allocator *allocator = aws_jni_http_allocator();
+    struct http_connection_acquisition *acquisition =
+        aws_mem_calloc(allocator, 1, sizeof(struct http_connection_acquisition));
+    acquisition->manager_binding = manager_binding;
+    acquisition->java_acquire_connection_future = future_ref;
+    aws_high_res_clock_get_ticks(&acquisition->start_ns);
+    aws_atomic_init_int(&acquisition->state, CONNECTION_ACQUISITION_PENDING);
+    aws_atomic_init_int(&acquisition->ref_count, 1);
+    s_acquire_manager_binding(manager_binding);
+
+    /* scheduled first, the acquisition may complete before aws_http_connection_manager_acquire_connection returns */
+    if (manager_binding->acquisition_timeout_ns > 0) {
+        acquisition->timeout_loop = aws_event_loop_group_get_next_loop(manager_binding->event_loop_group);
+        uint64_t now_ns = 0;
+        aws_event_loop_current_clock_time(acquisition->timeout_loop, &now_ns);
+
+        aws_atomic_fetch_add(&acquisition->ref_count, 1);
+        aws_task_init(
+            &acquisition->timeout_task,
+            s_on_connection_acquisition_timeout,
+            acquisition,
+            "http_connection_acquisition_timeout");
+        aws_event_loop_schedule_task_future(
+            acquisition->timeout_loop, &acquisition->timeout_task, now_ns + manager_binding->acquisition_timeout_ns);
+    }
 
     aws_http_connection_manager_acquire_connection(
-        conn_manager, &s_on_http_conn_acquisition_callback, (void *)connection_binding);
+        conn_manager, &s_on_http_conn_acquisition_callback, (void *)acquisition);
 }
 
 JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnection_httpClientConnectionReleaseManaged(
@@ -460,6 +1000,44 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnection
     s_destroy_connection_binding(binding, env);
 }
 
+JNIEXPORT void JNICALL
+    Java_software_amazon_awssdk_crt_http_HttpClientConnectionManager_httpClientConnectionManagerPrewarm(
+        JNIEnv *env,
+        jclass jni_class,
+        jlong jni_conn_manager_binding,
+        jint jni_connections,
+        jobject prewarm_future) {
+    (void)jni_class;
+
+    struct http_connection_manager_binding *manager_binding =
+        (struct http_connection_manager_binding *)jni_conn_manager_binding;
+
+    if (!manager_binding->manager) {
+        aws_jni_throw_runtime_exception(env, "Connection Manager can't be null");
+        return;
+    }
+
+    if (jni_connections <= 0) {
+        aws_jni_throw_illegal_argument_exception(env, "Number of connections to prewarm must be > 0");
+        return;
+    }
+
+    jobject future_ref = (*env)->NewGlobalRef(env, prewarm_future);
+    if (future_ref == NULL) {
+        aws_jni_throw_runtime_exception(env, "httpClientConnectionManagerPrewarm: failed to obtain ref to future");
+        return;
+    }
+
+    /* connections already idle in the pool count towards the number */
+    struct aws_http_manager_metrics metrics;
+    aws_http_connection_manager_fetch_metrics(manager_binding->manager, &metrics);
+    size_t connections = (size_t)jni_connections;
+    size_t new_connections =
+        connections > metrics.available_concurrency ? connections - metrics.available_concurrency : 0;
+
+    s_warmup_connections(manager_binding, new_connections, future_ref);
+}
+
 JNIEXPORT jobject JNICALL
     Java_software_amazon_awssdk_crt_http_HttpClientConnectionManager_httpConnectionManagerFetchMetrics(
         JNIEnv *env,
@@ -479,13 +1057,38 @@ JNIEXPORT jobject JNICALL
     struct aws_http_manager_metrics metrics;
     aws_http_connection_manager_fetch_metrics(conn_manager, &metrics);
 
-    return (*env)->NewObject(
+    struct connection_acquisition_stats stats;
+    aws_mutex_lock(&manager_binding->stats_lock);
+    stats = manager_binding->stats;
+    aws_mutex_unlock(&manager_binding->stats_lock);
+
+    jlongArray jni_histogram = (*env)->NewLongArray(env, ACQUISITION_WAIT_TIME_BUCKET_COUNT);
+    if (jni_histogram == NULL) {
+        /* exception already thrown */
+        return NULL;
+    }
+    jlong histogram[ACQUISITION_WAIT_TIME_BUCKET_COUNT];
+    for (size_t i = 0; i < ACQUISITION_WAIT_TIME_BUCKET_COUNT; ++i) {
+        histogram[i] = (jlong)stats.wait_time_histogram[i];
+    }
+    (*env)->SetLongArrayRegion(env, jni_histogram, 0, ACQUISITION_WAIT_TIME_BUCKET_COUNT, histogram);
+
+    jobject jni_metrics = (*env)->NewObject(
         env,
         http_manager_metrics_properties.http_manager_metrics_class,
-        http_manager_metrics_properties.constructor_method_id,
+        http_manager_metrics_properties.acquisition_stats_constructor_method_id,
         (jlong)metrics.available_concurrency,
         (jlong)metrics.pending_concurrency_acquires,
-        (jlong)metrics.leased_concurrency);
+        (jlong)metrics.leased_concurrency,
+        (jlong)stats.succeeded,
+        (jlong)stats.failed,
+        (jlong)stats.rejected,
+        (jlong)stats.timed_out,
+        (jlong)stats.total_wait_ns,
+        (jlong)stats.max_wait_ns,
+        jni_histogram);
+    (*env)->DeleteLocalRef(env, jni_histogram);
+    return jni_metrics;
 }
 
 #if UINTPTR_MAX == 0xffffffff
@@ -0,0 +1,320 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <jni.h>
+
+#include "crt.h"
+#include "http_request_utils.h"
+
+#include <aws/http/request_response.h>
+#include <aws/io/stream.h>
+
+/* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(push)
+#        pragma warning(disable : 4305) /* 'type cast': truncation from 'jlong' to 'jni_tls_ctx_options *' */
+#    else
+#        pragma GCC diagnostic push
+#        pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
+#        pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+#    endif
+#endif
+
+/*
+ * Native side of HttpRequestBuilder. Java edits the aws_http_message directly, so making a request needs no
+ * marshalling. Once the message has been handed to a stream it's shared, and it is copied before the next edit,
+ * so a builder can be reused for many requests without changing ones already in flight.
+ */
+struct http_request_builder {
+    struct aws_allocator *allocator;
+    struct aws_http_message *message;
+    bool shared;
+};
+
+static struct aws_http_message *s_http_request_new(struct aws_allocator *allocator, enum aws_http_version version) {
+    return version == AWS_HTTP_VERSION_2 ? aws_http2_message_new_request(allocator)
+                                         : aws_http_message_new_request(allocator);
+}
+
+static struct aws_http_message *s_http_request_copy(
+    struct aws_allocator *allocator,
+    const struct aws_http_message *source) {
+    enum aws_http_version version = aws_http_message_get_protocol_version(source);
+    struct aws_http_message *copy = s_http_request_new(allocator, version);
+    if (copy == NULL) {
+        return NULL;
+    }
+
+    /* HTTP/2 keeps method and path in pseudo-headers, which are copied with the other headers */
+    if (version != AWS_HTTP_VERSION_2) {
+        struct aws_byte_cursor method;
+        if (aws_http_message_get_request_method(source, &method) == AWS_OP_SUCCESS &&
+            aws_http_message_set_request_method(copy, method)) {
+            goto on_error;
+        }
+
+        struct aws_byte_cursor path;
+        if (aws_http_message_get_request_path(source, &path) == AWS_OP_SUCCESS &&
+            aws_http_message_set_request_path(copy, path)) {
+            goto on_error;
+        }
+    }
+
+    const struct aws_http_headers *headers = aws_http_message_get_const_headers(source);
+    size_t header_count = aws_http_headers_count(headers);
+    for (size_t i = 0; i < header_count; ++i) {
+        struct aws_http_header header;
+        AWS_ZERO_STRUCT(header);
+        if (aws_http_headers_get_index(headers, i, &header) || aws_http_message_add_header(copy, header)) {
+            goto on_error;
+        }
+    }
+
+    return copy;
+
+on_error:
+    aws_http_message_release(copy);
+    return NULL;
+}
+
+/* Makes the builder's message safe to edit. If this fails a java exception has been set. */
+static struct aws_http_message *s_builder_message_for_write(JNIEnv *env, struct http_request_builder *builder) {
+    if (builder == NULL) {
+        aws_jni_throw_null_pointer_exception(env, "HttpRequestBuilder: invalid builder");
+        return NULL;
+    }
+
+    if (builder->shared) {
+        struct aws_http_message *copy = s_http_request_copy(builder->allocator, builder->message);
+        if (copy == NULL) {
+            aws_jni_throw_runtime_exception(
+                env, "HttpRequestBuilder: failed to copy request, %s", aws_error_debug_str(aws_last_error()));
+            return NULL;
+        }
+        aws_http_message_release(builder->message);
+        builder->message = copy;
+        builder->shared = false;
+    }
+    return builder->message;
+}
+
+struct aws_http_message *aws_http_request_builder_acquire_request(
+    JNIEnv *env,
+    jlong jni_builder,
+    jobject jni_body_stream) {
+    struct http_request_builder *builder = (struct http_request_builder *)jni_builder;
+    if (builder == NULL) {
+        aws_jni_throw_null_pointer_exception(env, "HttpRequestBuilder: invalid builder");
+        return NULL;
+    }
+
+    if (jni_body_stream == NULL) {
+        /* body-less requests are read-only once sent, so every request can share one message until it's edited */
+        builder->shared = true;
+        return aws_http_message_acquire(builder->message);
+    }
+
+    /* a body stream is specific to one request, so it gets its own message */
+    struct aws_http_message *request = s_http_request_copy(builder->allocator, builder->message);
+    if (request == NULL) {
+        aws_jni_throw_runtime_exception(
+            env, "HttpRequestBuilder: failed to copy request, %s", aws_error_debug_str(aws_last_error()));
+        return NULL;
+    }
+
+    struct aws_input_stream *body_stream =
+        aws_input_stream_new_from_java_http_request_body_stream(builder->allocator, env, jni_body_stream);
+    if (body_stream == NULL) {
+        aws_jni_throw_runtime_exception(env, "HttpRequestBuilder: Error building body stream");
+        aws_http_message_release(request);
+        return NULL;
+    }
+
+    aws_http_message_set_body_stream(request, body_stream);
+    /* request controls the lifetime of body stream fully */
+    aws_input_stream_release(body_stream);
+
+    return request;
+}
+
+JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpRequestBuilder_httpRequestBuilderNew(
+    JNIEnv *env,
+    jclass jni_class,
+    jint version) {
+    (void)jni_class;
+
+    struct aws_allocator *allocator = aws_jni_http_allocator();
+    struct http_request_builder *builder = aws_mem_calloc(allocator, 1, sizeof(struct http_request_builder));
+    builder->allocator = allocator;
+    builder->message = s_http_request_new(allocator, (enum aws_http_version)version);
+    if (builder->message == NULL) {
+        aws_mem_release(allocator, builder);
+        aws_jni_throw_runtime_exception(
+            env, "HttpRequestBuilder: failed to create request, %s", aws_error_debug_str(aws_last_error()));
+        return (jlong)NULL;
+    }
+
+    return (jlong)builder;
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpRequestBuilder_httpRequestBuilderDestroy(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_builder) {
+    (void)env;
+    (void)jni_class;
+
+    struct http_request_builder *builder = (struct http_request_builder *)jni_builder;
+    if (builder == NULL) {
+        return;
+    }
+
+    /* requests still in flight hold their own references */
+    aws_http_message_release(builder->message);
+    aws_mem_release(builder->allocator, builder);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpRequestBuilder_httpRequestBuilderSetMethod(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_builder,
+    jstring jni_method) {
+    (void)jni_class;
+
+    struct aws_http_message *message = s_builder_message_for_write(env, (struct http_request_builder *)jni_builder);
+    if (message == NULL) {
+        return;
+    }
+
+    struct aws_byte_cursor method = aws_jni_byte_cursor_from_jstring_acquire(env, jni_method);
+    if (method.ptr == NULL) {
+        /* exception already thrown */
+        return;
+    }
+
+    if (aws_http_message_set_request_method(message, method)) {
+        aws_jni_throw_runtime_exception(
+            env, "HttpRequestBuilder.setMethod: %s", aws_error_debug_str(aws_last_error()));
+    }
+    aws_jni_byte_cursor_from_jstring_release(env, jni_method, method);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpRequestBuilder_httpRequestBuilderSetEncodedPath(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_builder,
+    jstring jni_path) {
+    (void)jni_class;
+
+    struct aws_http_message *message = s_builder_message_for_write(env, (struct http_request_builder *)jni_builder);
+    if (message == NULL) {
+        return;
+    }
+
+    struct aws_byte_cursor path = aws_jni_byte_cursor_from_jstring_acquire(env, jni_path);
+    if (path.ptr == NULL) {
+        /* exception already thrown */
+        return;
+    }
+
+    if (aws_http_message_set_request_path(message, path)) {
+        aws_jni_throw_runtime_exception(
+            env, "HttpRequestBuilder.setEncodedPath: %s", aws_error_debug_str(aws_last_error()));
+    }
+    aws_jni_byte_cursor_from_jstring_release(env, jni_path, path);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpRequestBuilder_httpRequestBuilderAddHeader(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_builder,
+    jstring jni_name,
+    jstring jni_value,
+    jboolean replace) {
+    (void)jni_class;
+
+    struct aws_http_message *message = s_builder_message_for_write(env, (struct http_request_builder *)jni_builder);
+    if (message == NULL) {
+        return;
+    }
+
+    struct aws_byte_cursor name = aws_jni_byte_cursor_from_jstring_acquire(env, jni_name);
+    if (name.ptr == NULL) {
+        /* exception already thrown */
+        return;
+    }
+
+    struct aws_byte_cursor value = aws_jni_byte_cursor_from_jstring_acquire(env, jni_value);
+    if (value.ptr == NULL) {
+        /* exception already thrown */
+        aws_jni_byte_cursor_from_jstring_release(env, jni_name, name);
+        return;
+    }
+
+    struct aws_http_headers *headers = aws_http_message_get_headers(message);
+    int result = replace ? aws_http_headers_set(headers, name, value) : aws_http_headers_add(headers, name, value);
+    if (result) {
+        aws_jni_throw_runtime_exception(
+            env, "HttpRequestBuilder.addHeader: %s", aws_error_debug_str(aws_last_error()));
+    }
+
+    aws_jni_byte_cursor_from_jstring_release(env, jni_value, value);
+    aws_jni_byte_cursor_from_jstring_release(env, jni_name, name);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpRequestBuilder_httpRequestBuilderRemoveHeader(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_builder,
+    jstring jni_name) {
+    (void)jni_class;
+
+    struct aws_http_message *message = s_builder_message_for_write(env, (struct http_request_builder *)jni_builder);
+    if (message == NULL) {
+        return;
+    }
+
+    struct aws_byte_cursor name = aws_jni_byte_cursor_from_jstring_acquire(env, jni_name);
+    if (name.ptr == NULL) {
+        /* exception already thrown */
+        return;
+    }
+
+    /* fails with AWS_ERROR_HTTP_HEADER_NOT_FOUND if there was nothing to remove, which is fine */
+    aws_http_headers_erase(aws_http_message_get_headers(message), name);
+    aws_jni_byte_cursor_from_jstring_release(env, jni_name, name);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpRequestBuilder_httpRequestBuilderClearHeaders(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_builder) {
+    (void)jni_class;
+
+    struct aws_http_message *message = s_builder_message_for_write(env, (struct http_request_builder *)jni_builder);
+    if (message == NULL) {
+        return;
+    }
+
+    /* keep HTTP/2 pseudo-headers, they hold the method and path */
+    struct aws_http_headers *headers = aws_http_message_get_headers(message);
+    for (size_t i = aws_http_headers_count(headers); i > 0; --i) {
+        struct aws_http_header header;
+        AWS_ZERO_STRUCT(header);
+        aws_http_headers_get_index(headers, i - 1, &header);
+        if (header.name.len == 0 || header.name.ptr[0] != ':') {
+            aws_http_headers_erase_index(headers, i - 1);
+        }
+    }
+}
+
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(pop)
+#    else
+#        pragma GCC diagnostic pop
+#    endif
+#endif
@@ -10,8 +10,10 @@
 #include "http_request_response.h"
 #include "http_request_utils.h"
 #include "java_class_ids.h"
+#include "tracing.h"
 
 #include <aws/common/atomics.h>
+#include <aws/common/math.h>
 #include <aws/common/mutex.h>
 #include <aws/http/connection.h>
 #include <aws/http/http.h>
@@ -65,6 +67,80 @@ void aws_java_http_stream_from_native_delete(JNIEnv *env, jobject jHttpStream) {
  * http_stream_binding - Jni native represent of the Java HTTP stream object
  ******************************************************************************/
 
+/*
+ * Destroyed bindings go on a bounded free list instead of being freed, keeping their headers buffer, so making a
+ * request doesn't allocate a binding in steady state. Bindings are created on the thread making the request and
+ * destroyed on whichever thread drops the last reference (usually the connection's event loop), so one list is
+ * shared by all threads. It's only held to push or pop a pointer.
+ */
+#define HTTP_STREAM_BINDING_POOL_MAX_SIZE 512
+#define HTTP_STREAM_BINDING_HEADERS_BUF_SIZE 1024
+/* a binding whose headers buffer grew past this is freed rather than kept, so outliers don't pin memory */
+#define HTTP_STREAM_BINDING_POOL_MAX_HEADERS_BUF_SIZE (16 * 1024)
+
+static struct aws_mutex s_binding_pool_lock = AWS_MUTEX_INIT;
+static struct http_stream_binding *s_binding_pool = NULL;
+static size_t s_binding_pool_size = 0;
+
+static void s_http_stream_binding_free(struct http_stream_binding *binding) {
+    aws_byte_buf_clean_up(&binding->headers_buf);
+    aws_mem_release(aws_jni_http_allocator(), binding);
+}
+
+/* Returns false if the pool is full, and the binding should be freed instead */
+static bool s_http_stream_binding_pool_put(struct http_stream_binding *binding) {
+    if (binding->headers_buf.capacity > HTTP_STREAM_BINDING_POOL_MAX_HEADERS_BUF_SIZE) {
+        return false;
+    }
+
+    struct aws_byte_buf headers_buf = binding->headers_buf;
+    headers_buf.len = 0;
+    AWS_ZERO_STRUCT(*binding);
+    binding->headers_buf = headers_buf;
+
+    bool pooled = false;
+    aws_mutex_lock(&s_binding_pool_lock);
+    if (s_binding_pool_size < HTTP_STREAM_BINDING_POOL_MAX_SIZE) {
+        binding->next_free = s_binding_pool;
+        s_binding_pool = binding;
+        ++s_binding_pool_size;
+        pooled = true;
+    }
+    aws_mutex_unlock(&s_binding_pool_lock);
+
+    return pooled;
+}
+
+/* Returns a zeroed binding with an empty headers buffer, or NULL if the pool is empty */
+static struct http_stream_binding *s_http_stream_binding_pool_get(void) {
+    aws_mutex_lock(&s_binding_pool_lock);
+    struct http_stream_binding *binding = s_binding_pool;
+    if (binding != NULL) {
+        s_binding_pool = binding->next_free;
+        --s_binding_pool_size;
+    }
+    aws_mutex_unlock(&s_binding_pool_lock);
+
+    if (binding != NULL) {
+        binding->next_free = NULL;
+    }
+    return binding;
+}
+
+void aws_http_stream_binding_pool_clear(void) {
+    aws_mutex_lock(&s_binding_pool_lock);
+    struct http_stream_binding *binding = s_binding_pool;
+    s_binding_pool = NULL;
+    s_binding_pool_size = 0;
+    aws_mutex_unlock(&s_binding_pool_lock);
+
+    while (binding != NULL) {
+        struct http_stream_binding *next = binding->next_free;
+        s_http_stream_binding_free(binding);
+        binding = next;
+    }
+}
+
 static void s_http_stream_binding_destroy(JNIEnv *env, struct http_stream_binding *binding) {
 
     if (binding->java_http_stream_base) {
@@ -78,8 +154,14 @@ static void s_http_stream_binding_destroy(JNIEnv *env, struct http_stream_bindin
     if (binding->native_request) {
         aws_http_message_release(binding->native_request);
     }
-    aws_byte_buf_clean_up(&binding->headers_buf);
-    aws_mem_release(aws_jni_get_allocator(), binding);
+    if (binding->body_buffer != NULL) {
+        (*env)->DeleteGlobalRef(env, binding->body_buffer);
+    }
+    aws_byte_buf_clean_up(&binding->body_buf);
+
+    if (!s_http_stream_binding_pool_put(binding)) {
+        s_http_stream_binding_free(binding);
+    }
 }
 
 void *aws_http_stream_binding_acquire(struct http_stream_binding *binding) {
@@ -105,9 +187,13 @@ void *aws_http_stream_binding_release(JNIEnv *env, struct http_stream_binding *b
 // If error occurs, A Java exception is thrown and NULL is returned.
 struct http_stream_binding *aws_http_stream_binding_new(JNIEnv *env, jobject java_callback_handler) {
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
-    struct http_stream_binding *binding = aws_mem_calloc(allocator, 1, sizeof(struct http_stream_binding));
-    AWS_FATAL_ASSERT(binding);
+    struct aws_allocator *allocator = aws_jni_http_allocator();
+    struct http_stream_binding *binding = s_http_stream_binding_pool_get();
+    if (binding == NULL) {
+        binding = aws_mem_calloc(allocator, 1, sizeof(struct http_stream_binding));
+        AWS_FATAL_ASSERT(binding);
+        AWS_FATAL_ASSERT(!aws_byte_buf_init(&binding->headers_buf, allocator, HTTP_STREAM_BINDING_HEADERS_BUF_SIZE));
+    }
 
     // GetJavaVM() reference doesn't need a NewGlobalRef() call since it's global by default
     jint jvmresult = (*env)->GetJavaVM(env, &binding->jvm);
@@ -116,7 +202,16 @@ struct http_stream_binding *aws_http_stream_binding_new(JNIEnv *env, jobject jav
 
     binding->java_http_response_stream_handler = (*env)->NewGlobalRef(env, java_callback_handler);
     AWS_FATAL_ASSERT(binding->java_http_response_stream_handler);
-    AWS_FATAL_ASSERT(!aws_byte_buf_init(&binding->headers_buf, allocator, 1024));
+
+    jint min_body_chunk_size = (*env)->CallIntMethod(
+        env, java_callback_handler, http_stream_response_handler_properties.getMinimumResponseBodyChunkSize);
+    if (aws_jni_check_and_clear_exception(env) || min_body_chunk_size < 0) {
+        min_body_chunk_size = 0;
+    }
+    binding->min_body_chunk_size = (size_t)min_body_chunk_size;
+    if (binding->min_body_chunk_size > 0) {
+        AWS_FATAL_ASSERT(!aws_byte_buf_init(&binding->body_buf, allocator, binding->min_body_chunk_size));
+    }
 
     aws_atomic_init_int(&binding->ref, 1);
 
@@ -129,6 +224,7 @@ int aws_java_http_stream_on_incoming_headers_fn(
     const struct aws_http_header *header_array,
     size_t num_headers,
     void *user_data) {
+    AWS_JNI_TRACE_SPAN("http.incoming_headers", stream);
     (void)block_type;
 
     struct http_stream_binding *binding = (struct http_stream_binding *)user_data;
@@ -154,7 +250,7 @@ int aws_java_http_stream_on_incoming_header_block_done_fn(
     struct aws_http_stream *stream,
     enum aws_http_header_block block_type,
     void *user_data) {
-    (void)stream;
+    AWS_JNI_TRACE_SPAN("http.incoming_header_block_done", stream);
 
     struct http_stream_binding *binding = (struct http_stream_binding *)user_data;
 
@@ -168,6 +264,11 @@ int aws_java_http_stream_on_incoming_header_block_done_fn(
     int result = AWS_OP_ERR;
     jint jni_block_type = block_type;
 
+    /* trailing headers come after the body, so any body held back goes first */
+    if (s_http_stream_flush_body(env, binding, stream)) {
+        goto done;
+    }
+
     jobject jni_headers_buf =
         aws_jni_direct_byte_buffer_from_raw_ptr(env, binding->headers_buf.buffer, binding->headers_buf.len);
 
@@ -212,55 +313,132 @@ done:
     return result;
 }
 
-int aws_java_http_stream_on_incoming_body_fn(
+/* Calls onResponseBody, returning the window increment Java asked for */
+static int s_java_http_stream_deliver_body(
+    JNIEnv *env,
+    struct http_stream_binding *binding,
     struct aws_http_stream *stream,
-    const struct aws_byte_cursor *data,
-    void *user_data) {
-    struct http_stream_binding *binding = (struct http_stream_binding *)user_data;
-
-    size_t total_window_increment = 0;
-
-    /********** JNI ENV ACQUIRE **********/
-    JNIEnv *env = aws_jni_acquire_thread_env(binding->jvm);
-    if (env == NULL) {
-        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
-        return AWS_OP_ERR;
-    }
-
-    int result = AWS_OP_ERR;
-
-    jobject jni_payload = aws_jni_direct_byte_buffer_from_raw_ptr(env, data->ptr, data->len);
+    jobject jni_payload,
+    size_t length,
+    size_t *out_window_increment) {
 
     jint window_increment = (*env)->CallIntMethod(
         env,
         binding->java_http_response_stream_handler,
         http_stream_response_handler_properties.onResponseBody,
         binding->java_http_stream_base,
-        jni_payload);
-
-    (*env)->DeleteLocalRef(env, jni_payload);
+        jni_payload,
+        (jint)length);
 
     if (aws_jni_check_and_clear_exception(env)) {
         AWS_LOGF_ERROR(AWS_LS_HTTP_STREAM, "id=%p: Received Exception from onResponseBody", (void *)stream);
-        aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
-        goto done;
+        return aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
     }
 
     if (window_increment < 0) {
         AWS_LOGF_ERROR(AWS_LS_HTTP_STREAM, "id=%p: Window Increment from onResponseBody < 0", (void *)stream);
-        aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
-        goto done;
+        return aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
     }
 
-    total_window_increment += window_increment;
+    *out_window_increment = (size_t)window_increment;
+    return AWS_OP_SUCCESS;
+}
 
-    if (total_window_increment > 0) {
-        aws_http_stream_update_window(stream, total_window_increment);
+static void s_http_stream_update_body_window(
+    struct http_stream_binding *binding,
+    struct aws_http_stream *stream,
+    size_t window_increment) {
+
+    /* the window was already opened for bytes that were held back, that counts towards what Java asks for */
+    size_t credit = aws_min_size(window_increment, binding->body_window_credit);
+    binding->body_window_credit -= credit;
+    window_increment -= credit;
+
+    if (window_increment > 0) {
+        aws_http_stream_update_window(stream, window_increment);
     }
+}
 
-    result = AWS_OP_SUCCESS;
+/* Hands the bytes held back to Java, through the stream's reusable DirectByteBuffer */
+static int s_http_stream_flush_body(JNIEnv *env, struct http_stream_binding *binding, struct aws_http_stream *stream) {
+    if (binding->body_buf.len == 0) {
+        return AWS_OP_SUCCESS;
+    }
 
-done:
+    if (binding->body_buffer == NULL || binding->body_buffer_ptr != binding->body_buf.buffer ||
+        binding->body_buffer_capacity != binding->body_buf.capacity) {
+        /* body_buf has moved since the last time, or this is the first time */
+        if (binding->body_buffer != NULL) {
+            (*env)->DeleteGlobalRef(env, binding->body_buffer);
+            binding->body_buffer = NULL;
+        }
+
+        jobject jni_body_buffer =
+            aws_jni_direct_byte_buffer_from_raw_ptr(env, binding->body_buf.buffer, binding->body_buf.capacity);
+        if (jni_body_buffer == NULL) {
+            aws_jni_check_and_clear_exception(env);
+            return aws_raise_error(AWS_ERROR_HTTP_CALLBACK_FAILURE);
+        }
+        binding->body_buffer = (*env)->NewGlobalRef(env, jni_body_buffer);
+        (*env)->DeleteLocalRef(env, jni_body_buffer);
+        binding->body_buffer_ptr = binding->body_buf.buffer;
+        binding->body_buffer_capacity = binding->body_buf.capacity;
+    }
+
+    size_t window_increment = 0;
+    int result = s_java_http_stream_deliver_body(
+        env, binding, stream, binding->body_buffer, binding->body_buf.len, &window_increment);
+    aws_byte_buf_reset(&binding->body_buf, false);
+    if (result == AWS_OP_SUCCESS) {
+        s_http_stream_update_body_window(binding, stream, window_increment);
+    }
+    return result;
+}
+
+int aws_java_http_stream_on_incoming_body_fn(
+    struct aws_http_stream *stream,
+    const struct aws_byte_cursor *data,
+    void *user_data) {
+    AWS_JNI_TRACE_SPAN("http.incoming_body", stream);
+    struct http_stream_binding *binding = (struct http_stream_binding *)user_data;
+
+    bool coalescing = binding->min_body_chunk_size > 0;
+    if (coalescing && binding->body_buf.len + data->len < binding->min_body_chunk_size) {
+        /* hold it back without calling into Java, opening the window so data keeps flowing meanwhile */
+        if (aws_byte_buf_append_dynamic(&binding->body_buf, data)) {
+            return AWS_OP_ERR;
+        }
+        binding->body_window_credit += data->len;
+        aws_http_stream_update_window(stream, data->len);
+        return AWS_OP_SUCCESS;
+    }
+
+    /********** JNI ENV ACQUIRE **********/
+    JNIEnv *env = aws_jni_acquire_thread_env(binding->jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        return AWS_OP_ERR;
+    }
+
+    int result = AWS_OP_ERR;
+
+    if (coalescing && binding->body_buf.len > 0) {
+        if (aws_byte_buf_append_dynamic(&binding->body_buf, data) == AWS_OP_SUCCESS) {
+            result = s_http_stream_flush_body(env, binding, stream);
+        }
+    } else {
+        /* nothing held back, and this is big enough (or coalescing is off), so deliver it in place */
+        jobject jni_payload = aws_jni_direct_byte_buffer_from_raw_ptr(env, data->ptr, data->len);
+
+        size_t window_increment = 0;
+        result = s_java_http_stream_deliver_body(env, binding, stream, jni_payload, data->len, &window_increment);
+
+        (*env)->DeleteLocalRef(env, jni_payload);
+
+        if (result == AWS_OP_SUCCESS) {
+            s_http_stream_update_body_window(binding, stream, window_increment);
+        }
+    }
 
     aws_jni_release_thread_env(binding->jvm, env);
     /********** JNI ENV RELEASE **********/
@@ -269,6 +447,7 @@ done:
 }
 
 void aws_java_http_stream_on_stream_complete_fn(struct aws_http_stream *stream, int error_code, void *user_data) {
+    AWS_JNI_TRACE_SPAN("http.stream_complete", stream);
     struct http_stream_binding *binding = (struct http_stream_binding *)user_data;
 
     /********** JNI ENV ACQUIRE **********/
@@ -278,6 +457,11 @@ void aws_java_http_stream_on_stream_complete_fn(struct aws_http_stream *stream,
         return;
     }
 
+    /* the rest of the body that was held back goes out before completion */
+    if (error_code == AWS_ERROR_SUCCESS && s_http_stream_flush_body(env, binding, stream)) {
+        error_code = aws_last_error();
+    }
+
     /* Don't invoke Java callbacks if Java HttpStream failed to completely setup */
     jint jErrorCode = error_code;
     (*env)->CallVoidMethod(
@@ -338,10 +522,37 @@ jobjectArray aws_java_http_headers_from_native(JNIEnv *env, struct aws_http_head
     return (ret);
 }
 
+JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_http_HttpHeaderTemplate_httpHeaderTemplateNew(
+    JNIEnv *env,
+    jclass jni_class,
+    jbyteArray marshalled_headers) {
+    (void)jni_class;
+
+    /* the template is never edited after this, requests share it by reference */
+    return (jlong)aws_http_headers_new_from_java_http_headers(env, marshalled_headers);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_HttpHeaderTemplate_httpHeaderTemplateDestroy(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_header_template) {
+    (void)env;
+    (void)jni_class;
+
+    /* requests still in flight that share the template's headers hold their own references */
+    aws_http_headers_release((struct aws_http_headers *)jni_header_template);
+}
+
+/*
+ * The request comes either marshalled, from an HttpRequestBase with an optional HttpHeaderTemplate,
+ * or from an HttpRequestBuilder
+ */
 static jobject s_make_request_general(
     JNIEnv *env,
     jlong jni_connection,
     jbyteArray marshalled_request,
+    jlong jni_header_template,
+    jlong jni_request_builder,
     jobject jni_http_request_body_stream,
     jobject jni_http_response_callback_handler,
     enum aws_http_version version) {
@@ -368,7 +579,13 @@ static jobject s_make_request_general(
     }
 
     stream_binding->native_request =
-        aws_http_request_new_from_java_http_request(env, marshalled_request, jni_http_request_body_stream);
+        marshalled_request != NULL
+            ? aws_http_request_new_from_java_http_request_with_template(
+                  env,
+                  marshalled_request,
+                  jni_http_request_body_stream,
+                  (struct aws_http_headers *)jni_header_template)
+            : aws_http_request_builder_acquire_request(env, jni_request_builder, jni_http_request_body_stream);
     if (stream_binding->native_request == NULL) {
         /* Exception already thrown */
         goto error;
@@ -388,8 +605,9 @@ static jobject s_make_request_general(
 
     stream_binding->native_stream = aws_http_connection_make_request(native_conn, &request_options);
     if (stream_binding->native_stream == NULL) {
+        int error_code = aws_last_error();
         AWS_LOGF_ERROR(AWS_LS_HTTP_CONNECTION, "Stream Request Failed. conn: %p", (void *)native_conn);
-        aws_jni_throw_runtime_exception(env, "HttpClientConnection.MakeRequest: Unable to Execute Request");
+        aws_jni_throw_crt_error(env, error_code);
         goto error;
     }
 
@@ -420,6 +638,7 @@ JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnect
     jclass jni_class,
     jlong jni_connection,
     jbyteArray marshalled_request,
+    jlong jni_header_template,
     jobject jni_http_request_body_stream,
     jobject jni_http_response_callback_handler) {
     (void)jni_class;
@@ -427,6 +646,28 @@ JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_http_HttpClientConnect
         env,
         jni_connection,
         marshalled_request,
+        jni_header_template,
+        0,
+        jni_http_request_body_stream,
+        jni_http_response_callback_handler,
+        AWS_HTTP_VERSION_1_1);
+}
+
+JNIEXPORT jobject JNICALL
+    Java_software_amazon_awssdk_crt_http_HttpClientConnection_httpClientConnectionMakeRequestFromBuilder(
+        JNIEnv *env,
+        jclass jni_class,
+        jlong jni_connection,
+        jlong jni_request_builder,
+        jobject jni_http_request_body_stream,
+        jobject jni_http_response_callback_handler) {
+    (void)jni_class;
+    return s_make_request_general(
+        env,
+        jni_connection,
+        NULL,
+        0,
+        jni_request_builder,
         jni_http_request_body_stream,
         jni_http_response_callback_handler,
         AWS_HTTP_VERSION_1_1);
@@ -437,6 +678,7 @@ JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_http_Http2ClientConnec
     jclass jni_class,
     jlong jni_connection,
     jbyteArray marshalled_request,
+    jlong jni_header_template,
     jobject jni_http_request_body_stream,
     jobject jni_http_response_callback_handler) {
     (void)jni_class;
@@ -444,6 +686,28 @@ JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_http_Http2ClientConnec
         env,
         jni_connection,
         marshalled_request,
+        jni_header_template,
+        0,
+        jni_http_request_body_stream,
+        jni_http_response_callback_handler,
+        AWS_HTTP_VERSION_2);
+}
+
+JNIEXPORT jobject JNICALL
+    Java_software_amazon_awssdk_crt_http_Http2ClientConnection_http2ClientConnectionMakeRequestFromBuilder(
+        JNIEnv *env,
+        jclass jni_class,
+        jlong jni_connection,
+        jlong jni_request_builder,
+        jobject jni_http_request_body_stream,
+        jobject jni_http_response_callback_handler) {
+    (void)jni_class;
+    return s_make_request_general(
+        env,
+        jni_connection,
+        NULL,
+        0,
+        jni_request_builder,
         jni_http_request_body_stream,
         jni_http_response_callback_handler,
         AWS_HTTP_VERSION_2);
@@ -462,7 +726,7 @@ static void s_cleanup_chunked_callback_data(
     aws_input_stream_destroy(chunked_callback_data->chunk_stream);
     aws_byte_buf_clean_up(&chunked_callback_data->chunk_data);
     (*env)->DeleteGlobalRef(env, chunked_callback_data->completion_callback);
-    aws_mem_release(aws_jni_get_allocator(), chunked_callback_data);
+    aws_mem_release(aws_jni_http_allocator(), chunked_callback_data);
 }
 
 static void s_write_chunk_complete(struct aws_http_stream *stream, int error_code, void *user_data) {
@@ -503,13 +767,13 @@ JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_http_HttpStream_httpStrea
     struct aws_http_stream *stream = cb_data->native_stream;
 
     struct http_stream_chunked_callback_data *chunked_callback_data =
-        aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct http_stream_chunked_callback_data));
+        aws_mem_calloc(aws_jni_http_allocator(), 1, sizeof(struct http_stream_chunked_callback_data));
 
     chunked_callback_data->stream_cb_data = cb_data;
     chunked_callback_data->completion_callback = (*env)->NewGlobalRef(env, completion_callback);
 
     struct aws_byte_cursor chunk_cur = aws_jni_byte_cursor_from_jbyteArray_acquire(env, chunk_data);
-    aws_byte_buf_init_copy_from_cursor(&chunked_callback_data->chunk_data, aws_jni_get_allocator(), chunk_cur);
+    aws_byte_buf_init_copy_from_cursor(&chunked_callback_data->chunk_data, aws_jni_http_allocator(), chunk_cur);
     aws_jni_byte_cursor_from_jbyteArray_release(env, chunk_data, chunk_cur);
 
     struct aws_http1_chunk_options chunk_options = {
@@ -519,7 +783,7 @@ JNIEXPORT jint JNICALL Java_software_amazon_awssdk_crt_http_HttpStream_httpStrea
     };
 
     chunk_cur = aws_byte_cursor_from_buf(&chunked_callback_data->chunk_data);
-    chunked_callback_data->chunk_stream = aws_input_stream_new_from_cursor(aws_jni_get_allocator(), &chunk_cur);
+    chunked_callback_data->chunk_stream = aws_input_stream_new_from_cursor(aws_jni_http_allocator(), &chunk_cur);
     chunk_options.chunk_data = chunked_callback_data->chunk_stream;
 
     if (aws_http1_stream_write_chunk(stream, &chunk_options)) {
@@ -738,7 +1002,7 @@ static void s_cleanup_http2_callback_data(struct aws_http2_callback_data *callba
         (*env)->DeleteGlobalRef(env, callback_data->async_callback);
     }
 
-    aws_mem_release(aws_jni_get_allocator(), callback_data);
+    aws_mem_release(aws_jni_http_allocator(), callback_data);
 }
 
 static struct aws_http2_callback_data *s_new_http2_callback_data(
@@ -804,7 +1068,7 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2ClientConnectio
             env, "Http2ClientConnection.http2ClientConnectionUpdateSettings: Invalid async callback");
         return;
     }
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_http_allocator();
     struct aws_http2_callback_data *callback_data = s_new_http2_callback_data(env, allocator, java_async_callback);
 
     /* We marshalled each setting to two long integers, the long list will be number of settings times two */
@@ -897,7 +1161,7 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_http_Http2ClientConnectio
         return;
     }
     bool success = false;
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_http_allocator();
     struct aws_byte_cursor *ping_cur_pointer = NULL;
     struct aws_byte_cursor ping_cur;
     AWS_ZERO_STRUCT(ping_cur);
@@ -13,6 +13,7 @@ struct aws_http_message;
 struct aws_http_stream;
 struct aws_byte_buf;
 struct aws_atomic_var;
+struct aws_http2_stream_manager_binding;
 
 struct http_stream_binding {
     JavaVM *jvm;
@@ -26,8 +27,33 @@ struct http_stream_binding {
     struct aws_http_stream *native_stream;
     struct aws_byte_buf headers_buf;
     int response_status;
+
+    /*
+     * Response body coalescing, see HttpStreamBaseResponseHandler.getMinimumResponseBodyChunkSize().
+     * Body bytes are held in body_buf until there are at least min_body_chunk_size of them, and handed to Java
+     * through body_buffer, a DirectByteBuffer over body_buf that's only recreated if body_buf moves.
+     * The window is opened natively for bytes held back, body_window_credit counts them so Java doesn't open it twice.
+     */
+    size_t min_body_chunk_size;
+    struct aws_byte_buf body_buf;
+    jobject body_buffer;
+    const uint8_t *body_buffer_ptr;
+    size_t body_buffer_capacity;
+    size_t body_window_credit;
+
+    /*
+     * Set for streams from an Http2StreamManager that evicts unhealthy connections. The time is measured from
+     * when the stream was handed out to its first response headers, or its completion if it had none.
+     */
+    struct aws_http2_stream_manager_binding *stream_manager_binding;
+    uint64_t request_start_ns;
+    uint64_t response_latency_ns;
+
     /* For the native http stream and the Java stream object */
     struct aws_atomic_var ref;
+
+    /* Next binding in the free list, while this one is in it */
+    struct http_stream_binding *next_free;
 };
 
 jobject aws_java_http_stream_from_native_new(JNIEnv *env, void *opaque, int version);
@@ -39,6 +65,9 @@ void *aws_http_stream_binding_acquire(struct http_stream_binding *binding);
 // If error occurs, A Java exception is thrown and NULL is returned.
 struct http_stream_binding *aws_http_stream_binding_new(JNIEnv *env, jobject java_callback_handler);
 
+/* Frees the bindings kept for reuse, so everything is released before checking for leaks or shutting down */
+void aws_http_stream_binding_pool_clear(void);
+
 /* Default callbacks using binding */
 int aws_java_http_stream_on_incoming_headers_fn(
     struct aws_http_stream *stream,
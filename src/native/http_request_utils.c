@@ -383,7 +383,7 @@ int aws_apply_java_http_request_changes_to_native_request(
 
     if (jni_body_stream) {
         struct aws_input_stream *body_stream =
-            aws_input_stream_new_from_java_http_request_body_stream(aws_jni_get_allocator(), env, jni_body_stream);
+            aws_input_stream_new_from_java_http_request_body_stream(aws_jni_http_allocator(), env, jni_body_stream);
 
         aws_http_message_set_body_stream(message, body_stream);
         /* request controls the lifetime of body stream fully */
@@ -393,10 +393,58 @@ int aws_apply_java_http_request_changes_to_native_request(
     return result;
 }
 
+/* Peeks past method and path, without consuming the blob. Malformed blobs are reported as having headers. */
+static bool s_marshalled_request_has_headers(struct aws_byte_cursor request_blob) {
+    uint32_t field_len = 0;
+    for (int field = 0; field < 2; ++field) {
+        if (!aws_byte_cursor_read_be32(&request_blob, &field_len) || field_len > request_blob.len) {
+            return true;
+        }
+        aws_byte_cursor_advance(&request_blob, field_len);
+    }
+    return request_blob.len > 0;
+}
+
+/* Adds every template header whose name the request doesn't already set */
+static int s_apply_http_header_template(
+    struct aws_http_message *request,
+    const struct aws_http_headers *header_template) {
+    struct aws_http_headers *headers = aws_http_message_get_headers(request);
+    size_t request_header_count = aws_http_headers_count(headers);
+    size_t template_count = aws_http_headers_count(header_template);
+    for (size_t i = 0; i < template_count; ++i) {
+        struct aws_http_header header;
+        AWS_ZERO_STRUCT(header);
+        aws_http_headers_get_index(header_template, i, &header);
+
+        /* only the request's own headers override, so repeated template headers are all kept */
+        bool overridden = false;
+        for (size_t j = 0; j < request_header_count && !overridden; ++j) {
+            struct aws_http_header request_header;
+            AWS_ZERO_STRUCT(request_header);
+            aws_http_headers_get_index(headers, j, &request_header);
+            overridden = aws_byte_cursor_eq_ignore_case(&header.name, &request_header.name);
+        }
+
+        if (!overridden && aws_http_headers_add_header(headers, &header)) {
+            return AWS_OP_ERR;
+        }
+    }
+    return AWS_OP_SUCCESS;
+}
+
 struct aws_http_message *aws_http_request_new_from_java_http_request(
     JNIEnv *env,
     jbyteArray marshalled_request,
     jobject jni_body_stream) {
+    return aws_http_request_new_from_java_http_request_with_template(env, marshalled_request, jni_body_stream, NULL);
+}
+
+struct aws_http_message *aws_http_request_new_from_java_http_request_with_template(
+    JNIEnv *env,
+    jbyteArray marshalled_request,
+    jobject jni_body_stream,
+    struct aws_http_headers *header_template) {
     const char *exception_message = NULL;
     const size_t marshalled_request_length = (*env)->GetArrayLength(env, marshalled_request);
 
@@ -404,9 +452,22 @@ struct aws_http_message *aws_http_request_new_from_java_http_request(
     struct aws_byte_cursor marshalled_cur =
         aws_byte_cursor_from_array((uint8_t *)marshalled_request_data, marshalled_request_length);
     enum aws_http_version version = s_unmarshal_http_request_to_get_version(&marshalled_cur);
-    struct aws_http_message *request = version == AWS_HTTP_VERSION_2
-                                           ? aws_http2_message_new_request(aws_jni_get_allocator())
-                                           : aws_http_message_new_request(aws_jni_get_allocator());
+
+    /*
+     * An HTTP/1 request with no headers of its own can point at the template's headers instead of copying them.
+     * Nothing edits a request's headers once it's been made, so sharing them is safe.
+     * HTTP/2 requests keep method and path in their headers, so they always get their own.
+     */
+    bool shares_template = header_template != NULL && version != AWS_HTTP_VERSION_2 &&
+                           !s_marshalled_request_has_headers(marshalled_cur);
+    struct aws_http_message *request = NULL;
+    if (shares_template) {
+        request = aws_http_message_new_request_with_headers(aws_jni_http_allocator(), header_template);
+    } else if (version == AWS_HTTP_VERSION_2) {
+        request = aws_http2_message_new_request(aws_jni_http_allocator());
+    } else {
+        request = aws_http_message_new_request(aws_jni_http_allocator());
+    }
 
     int result = AWS_OP_SUCCESS;
     if (version != aws_http_message_get_protocol_version(request)) {
@@ -416,6 +477,10 @@ struct aws_http_message *aws_http_request_new_from_java_http_request(
     }
     (*env)->ReleasePrimitiveArrayCritical(env, marshalled_request, marshalled_request_data, 0);
 
+    if (result == AWS_OP_SUCCESS && header_template != NULL && !shares_template) {
+        result = s_apply_http_header_template(request, header_template);
+    }
+
     if (result) {
         exception_message = "aws_http_request_new_from_java_http_request: Invalid marshalled request data.";
         goto on_error;
@@ -423,7 +488,7 @@ struct aws_http_message *aws_http_request_new_from_java_http_request(
 
     if (jni_body_stream != NULL) {
         struct aws_input_stream *body_stream =
-            aws_input_stream_new_from_java_http_request_body_stream(aws_jni_get_allocator(), env, jni_body_stream);
+            aws_input_stream_new_from_java_http_request_body_stream(aws_jni_http_allocator(), env, jni_body_stream);
         if (body_stream == NULL) {
             exception_message = "aws_fill_out_request: Error building body stream";
             goto on_error;
@@ -448,7 +513,7 @@ on_error:
 }
 
 struct aws_http_headers *aws_http_headers_new_from_java_http_headers(JNIEnv *env, jbyteArray marshalled_headers) {
-    struct aws_http_headers *headers = aws_http_headers_new(aws_jni_get_allocator());
+    struct aws_http_headers *headers = aws_http_headers_new(aws_jni_http_allocator());
     if (headers == NULL) {
         aws_jni_throw_runtime_exception(env, "aws_http_headers_new_from_java_http_headers: Unable to allocate headers");
         return NULL;
@@ -516,7 +581,7 @@ jobject aws_java_http_request_from_native(JNIEnv *env, struct aws_http_message *
     jobject j_request = NULL;
     struct aws_byte_buf marshaling_buf;
 
-    if (aws_byte_buf_init(&marshaling_buf, aws_jni_get_allocator(), 1024)) {
+    if (aws_byte_buf_init(&marshaling_buf, aws_jni_http_allocator(), 1024)) {
         aws_jni_throw_runtime_exception(env, "aws_java_http_request_from_native: allocation failed");
         return NULL;
     }
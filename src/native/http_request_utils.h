@@ -26,6 +26,16 @@ struct aws_http_message *aws_http_request_new_from_java_http_request(
     jbyteArray marshalled_request,
     jobject jni_body_stream);
 
+/*
+ * Same as aws_http_request_new_from_java_http_request, with the headers of an HttpHeaderTemplate added to the
+ * request's own. A request header replaces all template headers of the same name. header_template may be NULL.
+ */
+struct aws_http_message *aws_http_request_new_from_java_http_request_with_template(
+    JNIEnv *env,
+    jbyteArray marshalled_request,
+    jobject jni_body_stream,
+    struct aws_http_headers *header_template);
+
 struct aws_http_headers *aws_http_headers_new_from_java_http_headers(JNIEnv *env, jbyteArray marshalled_headers);
 
 int aws_marshal_http_headers_to_dynamic_buffer(
@@ -40,6 +50,15 @@ int aws_apply_java_http_request_changes_to_native_request(
     jobject jni_body_stream,
     struct aws_http_message *message);
 
+/*
+ * Returns a new reference to the request an HttpRequestBuilder has built, with the Java body stream attached if
+ * there is one. If this fails a java exception has been set.
+ */
+struct aws_http_message *aws_http_request_builder_acquire_request(
+    JNIEnv *env,
+    jlong jni_builder,
+    jobject jni_body_stream);
+
 /* if this fails a java exception has been set. */
 jobject aws_java_http_request_from_native(JNIEnv *env, struct aws_http_message *message, jobject request_body_stream);
 
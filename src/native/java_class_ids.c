@@ -6,6 +6,13 @@
 #include "java_class_ids.h"
 
 #include <aws/common/assert.h>
+#include <aws/common/clock.h>
+#include <aws/common/logging.h>
+#include <aws/common/thread.h>
+
+#include <inttypes.h>
+
+#include "crt.h"
 
 struct java_http_request_body_stream_properties http_request_body_stream_properties;
 
@@ -89,6 +96,14 @@ static void s_cache_aws_signing_config(JNIEnv *env) {
     aws_signing_config_properties.expiration_in_seconds_field_id =
         (*env)->GetFieldID(env, aws_signing_config_class, "expirationInSeconds", "J");
     AWS_FATAL_ASSERT(aws_signing_config_properties.expiration_in_seconds_field_id);
+
+    aws_signing_config_properties.signed_header_allow_list_field_id =
+        (*env)->GetFieldID(env, aws_signing_config_class, "signedHeaderAllowList", "[Ljava/lang/String;");
+    AWS_FATAL_ASSERT(aws_signing_config_properties.signed_header_allow_list_field_id);
+
+    aws_signing_config_properties.signed_header_deny_list_field_id =
+        (*env)->GetFieldID(env, aws_signing_config_class, "signedHeaderDenyList", "[Ljava/lang/String;");
+    AWS_FATAL_ASSERT(aws_signing_config_properties.signed_header_deny_list_field_id);
 }
 
 struct java_predicate_properties predicate_properties;
@@ -185,6 +200,13 @@ static void s_cache_message_handler(JNIEnv *env) {
 
     message_handler_properties.deliver = (*env)->GetMethodID(env, cls, "deliver", "(Ljava/lang/String;[BZIZ)V");
     AWS_FATAL_ASSERT(message_handler_properties.deliver);
+
+    message_handler_properties.deliver_direct =
+        (*env)->GetMethodID(env, cls, "deliverDirect", "(Ljava/lang/String;Ljava/nio/ByteBuffer;ZIZ)V");
+    AWS_FATAL_ASSERT(message_handler_properties.deliver_direct);
+
+    message_handler_properties.direct_payload_field_id = (*env)->GetFieldID(env, cls, "directPayload", "Z");
+    AWS_FATAL_ASSERT(message_handler_properties.direct_payload_field_id);
 }
 
 struct java_mqtt_exception_properties mqtt_exception_properties;
@@ -409,9 +431,15 @@ static void s_cache_http_client_connection_manager(JNIEnv *env) {
     jclass cls = (*env)->FindClass(env, "software/amazon/awssdk/crt/http/HttpClientConnectionManager");
     AWS_FATAL_ASSERT(cls);
 
+    http_client_connection_manager_properties.http_client_connection_manager_class = (*env)->NewGlobalRef(env, cls);
+
     http_client_connection_manager_properties.onShutdownComplete =
         (*env)->GetMethodID(env, cls, "onShutdownComplete", "()V");
     AWS_FATAL_ASSERT(http_client_connection_manager_properties.onShutdownComplete);
+
+    http_client_connection_manager_properties.onPrewarmComplete = (*env)->GetStaticMethodID(
+        env, cls, "onPrewarmComplete", "(Ljava/util/concurrent/CompletableFuture;II)V");
+    AWS_FATAL_ASSERT(http_client_connection_manager_properties.onPrewarmComplete);
 }
 
 struct java_http2_stream_manager_properties http2_stream_manager_properties;
@@ -476,12 +504,16 @@ static void s_cache_http_stream_response_handler_native_adapter(JNIEnv *env) {
     AWS_FATAL_ASSERT(http_stream_response_handler_properties.onResponseHeadersDone);
 
     http_stream_response_handler_properties.onResponseBody = (*env)->GetMethodID(
-        env, cls, "onResponseBody", "(Lsoftware/amazon/awssdk/crt/http/HttpStreamBase;Ljava/nio/ByteBuffer;)I");
+        env, cls, "onResponseBody", "(Lsoftware/amazon/awssdk/crt/http/HttpStreamBase;Ljava/nio/ByteBuffer;I)I");
     AWS_FATAL_ASSERT(http_stream_response_handler_properties.onResponseBody);
 
     http_stream_response_handler_properties.onResponseComplete =
         (*env)->GetMethodID(env, cls, "onResponseComplete", "(Lsoftware/amazon/awssdk/crt/http/HttpStreamBase;I)V");
     AWS_FATAL_ASSERT(http_stream_response_handler_properties.onResponseComplete);
+
+    http_stream_response_handler_properties.getMinimumResponseBodyChunkSize =
+        (*env)->GetMethodID(env, cls, "getMinimumResponseBodyChunkSize", "()I");
+    AWS_FATAL_ASSERT(http_stream_response_handler_properties.getMinimumResponseBodyChunkSize);
 }
 
 struct java_http_stream_write_chunk_completion_properties http_stream_write_chunk_completion_properties;
@@ -517,7 +549,7 @@ static void s_cache_event_stream_server_listener_handler_properties(JNIEnv *env)
     AWS_FATAL_ASSERT(event_stream_server_listener_handler_properties.connCls);
 
     event_stream_server_listener_handler_properties.newConnConstructor =
-        (*env)->GetMethodID(env, event_stream_server_listener_handler_properties.connCls, "<init>", "(J)V");
+        (*env)->GetMethodID(env, event_stream_server_listener_handler_properties.connCls, "<init>", "(JJ)V");
     AWS_FATAL_ASSERT(event_stream_server_listener_handler_properties.newConnConstructor);
 
     event_stream_server_listener_handler_properties.onNewConnection = (*env)->GetMethodID(
@@ -543,7 +575,7 @@ static void s_cache_event_stream_server_connection_handler_properties(JNIEnv *en
     AWS_FATAL_ASSERT(event_stream_server_connection_handler_properties.continuationCls);
 
     event_stream_server_connection_handler_properties.newContinuationConstructor =
-        (*env)->GetMethodID(env, event_stream_server_connection_handler_properties.continuationCls, "<init>", "(J)V");
+        (*env)->GetMethodID(env, event_stream_server_connection_handler_properties.continuationCls, "<init>", "(JJ)V");
     AWS_FATAL_ASSERT(event_stream_server_connection_handler_properties.newContinuationConstructor);
 
     event_stream_server_connection_handler_properties.onProtocolMessage =
@@ -635,6 +667,16 @@ static void s_cache_s3_client_properties(JNIEnv *env) {
     AWS_FATAL_ASSERT(s3_client_properties.onShutdownComplete);
 }
 
+struct java_s3_loopback_server_properties s3_loopback_server_properties;
+
+static void s_cache_s3_loopback_server_properties(JNIEnv *env) {
+    jclass cls = (*env)->FindClass(env, "software/amazon/awssdk/crt/s3/S3LoopbackServer");
+    AWS_FATAL_ASSERT(cls);
+
+    s3_loopback_server_properties.onShutdownComplete = (*env)->GetMethodID(env, cls, "onShutdownComplete", "()V");
+    AWS_FATAL_ASSERT(s3_loopback_server_properties.onShutdownComplete);
+}
+
 struct java_s3_meta_request_properties s3_meta_request_properties;
 
 static void s_cache_s3_meta_request_properties(JNIEnv *env) {
@@ -643,6 +685,10 @@ static void s_cache_s3_meta_request_properties(JNIEnv *env) {
 
     s3_meta_request_properties.onShutdownComplete = (*env)->GetMethodID(env, cls, "onShutdownComplete", "()V");
     AWS_FATAL_ASSERT(s3_meta_request_properties.onShutdownComplete);
+
+    s3_meta_request_properties.download_resume_state_field_id =
+        (*env)->GetFieldID(env, cls, "downloadResumeState", "J");
+    AWS_FATAL_ASSERT(s3_meta_request_properties.download_resume_state_field_id);
 }
 
 struct java_s3_meta_request_response_handler_native_adapter_properties
@@ -656,6 +702,10 @@ static void s_cache_s3_meta_request_response_handler_native_adapter_properties(J
         (*env)->GetMethodID(env, cls, "onResponseBody", "([BJJ)I");
     AWS_FATAL_ASSERT(s3_meta_request_response_handler_native_adapter_properties.onResponseBody);
 
+    s3_meta_request_response_handler_native_adapter_properties.onResponseBodyDirect =
+        (*env)->GetMethodID(env, cls, "onResponseBodyDirect", "(Ljava/nio/ByteBuffer;JJ)I");
+    AWS_FATAL_ASSERT(s3_meta_request_response_handler_native_adapter_properties.onResponseBodyDirect);
+
     s3_meta_request_response_handler_native_adapter_properties.onFinished =
         (*env)->GetMethodID(env, cls, "onFinished", "(II[BIZ)V");
     AWS_FATAL_ASSERT(s3_meta_request_response_handler_native_adapter_properties.onFinished);
@@ -666,7 +716,11 @@ static void s_cache_s3_meta_request_response_handler_native_adapter_properties(J
 
     s3_meta_request_response_handler_native_adapter_properties.onProgress =
         (*env)->GetMethodID(env, cls, "onProgress", "(Lsoftware/amazon/awssdk/crt/s3/S3MetaRequestProgress;)V");
-    AWS_FATAL_ASSERT(s3_meta_request_response_handler_native_adapter_properties.onResponseHeaders);
+    AWS_FATAL_ASSERT(s3_meta_request_response_handler_native_adapter_properties.onProgress);
+
+    s3_meta_request_response_handler_native_adapter_properties.onMetrics =
+        (*env)->GetMethodID(env, cls, "onMetrics", "(JJJJ[JIJJ)V");
+    AWS_FATAL_ASSERT(s3_meta_request_response_handler_native_adapter_properties.onMetrics);
 }
 
 struct java_completable_future_properties completable_future_properties;
@@ -684,6 +738,15 @@ static void s_cache_completable_future(JNIEnv *env) {
     AWS_FATAL_ASSERT(completable_future_properties.complete_exceptionally_method_id != NULL);
 }
 
+struct java_string_properties string_properties;
+
+static void s_cache_string(JNIEnv *env) {
+    jclass cls = (*env)->FindClass(env, "java/lang/String");
+    AWS_FATAL_ASSERT(cls);
+    string_properties.string_class = (*env)->NewGlobalRef(env, cls);
+    AWS_FATAL_ASSERT(string_properties.string_class);
+}
+
 struct java_crt_runtime_exception_properties crt_runtime_exception_properties;
 
 static void s_cache_crt_runtime_exception(JNIEnv *env) {
@@ -698,6 +761,18 @@ static void s_cache_crt_runtime_exception(JNIEnv *env) {
     AWS_FATAL_ASSERT(crt_runtime_exception_properties.error_code_field_id);
 }
 
+struct java_exception_properties exception_properties;
+
+static void s_cache_exceptions(JNIEnv *env) {
+    jclass cls = (*env)->FindClass(env, "java/lang/NullPointerException");
+    AWS_FATAL_ASSERT(cls);
+    exception_properties.null_pointer_exception_class = (*env)->NewGlobalRef(env, cls);
+
+    cls = (*env)->FindClass(env, "java/lang/IllegalArgumentException");
+    AWS_FATAL_ASSERT(cls);
+    exception_properties.illegal_argument_exception_class = (*env)->NewGlobalRef(env, cls);
+}
+
 struct java_ecc_key_pair_properties ecc_key_pair_properties;
 
 static void s_cache_ecc_key_pair(JNIEnv *env) {
@@ -720,6 +795,18 @@ static void s_cache_crt(JNIEnv *env) {
     AWS_FATAL_ASSERT(crt_properties.test_jni_exception_method_id);
 }
 
+struct java_log_properties log_properties;
+
+static void s_cache_log(JNIEnv *env) {
+    jclass cls = (*env)->FindClass(env, "software/amazon/awssdk/crt/Log");
+    AWS_FATAL_ASSERT(cls);
+    log_properties.log_class = (*env)->NewGlobalRef(env, cls);
+
+    log_properties.deliver_log_batch_method_id = (*env)->GetStaticMethodID(
+        env, cls, "deliverLogBatch", "(Lsoftware/amazon/awssdk/crt/Log$LogSink;Ljava/nio/ByteBuffer;I)V");
+    AWS_FATAL_ASSERT(log_properties.deliver_log_batch_method_id);
+}
+
 struct java_aws_signing_result_properties aws_signing_result_properties;
 
 static void s_cache_aws_signing_result(JNIEnv *env) {
@@ -757,6 +844,20 @@ static void s_cache_http_manager_metrics(JNIEnv *env) {
 
     http_manager_metrics_properties.constructor_method_id = (*env)->GetMethodID(env, cls, "<init>", "(JJJ)V");
     AWS_FATAL_ASSERT(http_manager_metrics_properties.constructor_method_id);
+
+    http_manager_metrics_properties.acquisition_stats_constructor_method_id =
+        (*env)->GetMethodID(env, cls, "<init>", "(JJJJJJJJJ[J)V");
+    AWS_FATAL_ASSERT(http_manager_metrics_properties.acquisition_stats_constructor_method_id);
+}
+
+struct java_s3_client_statistics_properties s3_client_statistics_properties;
+static void s_cache_s3_client_statistics(JNIEnv *env) {
+    jclass cls = (*env)->FindClass(env, "software/amazon/awssdk/crt/s3/S3ClientStatistics");
+    AWS_FATAL_ASSERT(cls);
+    s3_client_statistics_properties.s3_client_statistics_class = (*env)->NewGlobalRef(env, cls);
+
+    s3_client_statistics_properties.constructor_method_id = (*env)->GetMethodID(env, cls, "<init>", "(JJJJJ)V");
+    AWS_FATAL_ASSERT(s3_client_statistics_properties.constructor_method_id);
 }
 
 struct java_aws_exponential_backoff_retry_options_properties exponential_backoff_retry_options_properties;
@@ -864,6 +965,32 @@ static void s_cache_directory_entry(JNIEnv *env) {
     directory_entry_properties.file_size_field_id = (*env)->GetFieldID(env, cls, "fileSize", "J");
 }
 
+struct java_aws_directory_entry_batch_handler_properties directory_entry_batch_handler_properties;
+
+static void s_cache_directory_entry_batch_handler(JNIEnv *env) {
+    jclass cls = (*env)->FindClass(env, "software/amazon/awssdk/crt/io/DirectoryEntryBatchHandler");
+    AWS_FATAL_ASSERT(cls);
+    directory_entry_batch_handler_properties.directory_entry_batch_handler_class = (*env)->NewGlobalRef(env, cls);
+    AWS_FATAL_ASSERT(directory_entry_batch_handler_properties.directory_entry_batch_handler_class);
+
+    directory_entry_batch_handler_properties.on_directory_entries_method_id = (*env)->GetMethodID(
+        env, cls, "onDirectoryEntries", "(Lsoftware/amazon/awssdk/crt/io/DirectoryEntryBatch;)Z");
+    AWS_FATAL_ASSERT(directory_entry_batch_handler_properties.on_directory_entries_method_id);
+}
+
+struct java_aws_directory_entry_batch_properties directory_entry_batch_properties;
+
+static void s_cache_directory_entry_batch(JNIEnv *env) {
+    jclass cls = (*env)->FindClass(env, "software/amazon/awssdk/crt/io/DirectoryEntryBatch");
+    AWS_FATAL_ASSERT(cls);
+    directory_entry_batch_properties.directory_entry_batch_class = (*env)->NewGlobalRef(env, cls);
+    AWS_FATAL_ASSERT(directory_entry_batch_properties.directory_entry_batch_class);
+
+    directory_entry_batch_properties.directory_entry_batch_constructor_method_id = (*env)->GetMethodID(
+        env, cls, "<init>", "([Ljava/lang/String;[Ljava/lang/String;[J[J[I)V");
+    AWS_FATAL_ASSERT(directory_entry_batch_properties.directory_entry_batch_constructor_method_id);
+}
+
 struct java_aws_s3_meta_request_progress s3_meta_request_progress_properties;
 
 static void s_cache_s3_meta_request_progress(JNIEnv *env) {
@@ -889,7 +1016,8 @@ static void s_cache_s3_meta_request_resume_token(JNIEnv *env) {
     s3_meta_request_resume_token_properties.s3_meta_request_resume_token_class = (*env)->NewGlobalRef(env, cls);
 
     s3_meta_request_resume_token_properties.s3_meta_request_resume_token_constructor_method_id =
-        (*env)->GetMethodID(env, s3_meta_request_progress_properties.s3_meta_request_progress_class, "<init>", "()V");
+        (*env)->GetMethodID(env, cls, "<init>", "()V");
+    AWS_FATAL_ASSERT(s3_meta_request_resume_token_properties.s3_meta_request_resume_token_constructor_method_id);
 
     s3_meta_request_resume_token_properties.native_type_field_id = (*env)->GetFieldID(env, cls, "nativeType", "I");
     AWS_FATAL_ASSERT(s3_meta_request_resume_token_properties.native_type_field_id);
@@ -900,6 +1028,96 @@ static void s_cache_s3_meta_request_resume_token(JNIEnv *env) {
         (*env)->GetFieldID(env, cls, "numPartsCompleted", "J");
     s3_meta_request_resume_token_properties.upload_id_field_id =
         (*env)->GetFieldID(env, cls, "uploadId", "Ljava/lang/String;");
+    s3_meta_request_resume_token_properties.object_size_field_id = (*env)->GetFieldID(env, cls, "objectSize", "J");
+    AWS_FATAL_ASSERT(s3_meta_request_resume_token_properties.object_size_field_id);
+    s3_meta_request_resume_token_properties.etag_field_id =
+        (*env)->GetFieldID(env, cls, "eTag", "Ljava/lang/String;");
+    AWS_FATAL_ASSERT(s3_meta_request_resume_token_properties.etag_field_id);
+    s3_meta_request_resume_token_properties.completed_parts_field_id =
+        (*env)->GetFieldID(env, cls, "completedParts", "[J");
+    AWS_FATAL_ASSERT(s3_meta_request_resume_token_properties.completed_parts_field_id);
+}
+
+struct java_s3_meta_request_native_options_properties s3_meta_request_native_options_properties;
+
+static void s_cache_s3_meta_request_native_options(JNIEnv *env) {
+    jclass cls = (*env)->FindClass(env, "software/amazon/awssdk/crt/s3/S3Client$MetaRequestNativeOptions");
+    AWS_FATAL_ASSERT(cls);
+
+    s3_meta_request_native_options_properties.region_field_id = (*env)->GetFieldID(env, cls, "region", "[B");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.region_field_id);
+    s3_meta_request_native_options_properties.meta_request_type_field_id =
+        (*env)->GetFieldID(env, cls, "metaRequestType", "I");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.meta_request_type_field_id);
+    s3_meta_request_native_options_properties.checksum_location_field_id =
+        (*env)->GetFieldID(env, cls, "checksumLocation", "I");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.checksum_location_field_id);
+    s3_meta_request_native_options_properties.checksum_algorithm_field_id =
+        (*env)->GetFieldID(env, cls, "checksumAlgorithm", "I");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.checksum_algorithm_field_id);
+    s3_meta_request_native_options_properties.validate_checksum_field_id =
+        (*env)->GetFieldID(env, cls, "validateChecksum", "Z");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.validate_checksum_field_id);
+    s3_meta_request_native_options_properties.validate_algorithms_field_id =
+        (*env)->GetFieldID(env, cls, "validateAlgorithms", "[I");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.validate_algorithms_field_id);
+    s3_meta_request_native_options_properties.http_request_bytes_field_id =
+        (*env)->GetFieldID(env, cls, "httpRequestBytes", "[B");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.http_request_bytes_field_id);
+    s3_meta_request_native_options_properties.http_request_body_stream_field_id = (*env)->GetFieldID(
+        env, cls, "httpRequestBodyStream", "Lsoftware/amazon/awssdk/crt/http/HttpRequestBodyStream;");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.http_request_body_stream_field_id);
+    s3_meta_request_native_options_properties.credentials_provider_field_id =
+        (*env)->GetFieldID(env, cls, "credentialsProvider", "J");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.credentials_provider_field_id);
+    s3_meta_request_native_options_properties.response_handler_native_adapter_field_id = (*env)->GetFieldID(
+        env, cls, "responseHandlerNativeAdapter", "Lsoftware/amazon/awssdk/crt/s3/S3MetaRequestResponseHandlerNativeAdapter;");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.response_handler_native_adapter_field_id);
+    s3_meta_request_native_options_properties.endpoint_field_id = (*env)->GetFieldID(env, cls, "endpoint", "[B");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.endpoint_field_id);
+    s3_meta_request_native_options_properties.resume_token_field_id =
+        (*env)->GetFieldID(env, cls, "resumeToken", "Lsoftware/amazon/awssdk/crt/s3/ResumeToken;");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.resume_token_field_id);
+    s3_meta_request_native_options_properties.zero_copy_response_body_field_id =
+        (*env)->GetFieldID(env, cls, "zeroCopyResponseBody", "Z");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.zero_copy_response_body_field_id);
+    s3_meta_request_native_options_properties.response_file_path_field_id =
+        (*env)->GetFieldID(env, cls, "responseFilePath", "Ljava/lang/String;");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.response_file_path_field_id);
+    s3_meta_request_native_options_properties.request_file_path_field_id =
+        (*env)->GetFieldID(env, cls, "requestFilePath", "Ljava/lang/String;");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.request_file_path_field_id);
+    s3_meta_request_native_options_properties.request_part_buffer_queue_field_id =
+        (*env)->GetFieldID(env, cls, "requestPartBufferQueue", "J");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.request_part_buffer_queue_field_id);
+    s3_meta_request_native_options_properties.part_size_field_id = (*env)->GetFieldID(env, cls, "partSize", "J");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.part_size_field_id);
+    s3_meta_request_native_options_properties.progress_interval_bytes_field_id =
+        (*env)->GetFieldID(env, cls, "progressIntervalBytes", "J");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.progress_interval_bytes_field_id);
+    s3_meta_request_native_options_properties.progress_interval_millis_field_id =
+        (*env)->GetFieldID(env, cls, "progressIntervalMillis", "J");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.progress_interval_millis_field_id);
+    s3_meta_request_native_options_properties.reuse_progress_object_field_id =
+        (*env)->GetFieldID(env, cls, "reuseProgressObject", "Z");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.reuse_progress_object_field_id);
+    s3_meta_request_native_options_properties.metrics_enabled_field_id =
+        (*env)->GetFieldID(env, cls, "metricsEnabled", "Z");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.metrics_enabled_field_id);
+    s3_meta_request_native_options_properties.statistics_field_id = (*env)->GetFieldID(env, cls, "statistics", "J");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.statistics_field_id);
+    s3_meta_request_native_options_properties.response_buffers_field_id =
+        (*env)->GetFieldID(env, cls, "responseBuffers", "[Ljava/nio/ByteBuffer;");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.response_buffers_field_id);
+    s3_meta_request_native_options_properties.response_buffer_layout_field_id =
+        (*env)->GetFieldID(env, cls, "responseBufferLayout", "[J");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.response_buffer_layout_field_id);
+    s3_meta_request_native_options_properties.response_range_start_field_id =
+        (*env)->GetFieldID(env, cls, "responseRangeStart", "J");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.response_range_start_field_id);
+    s3_meta_request_native_options_properties.response_body_checksum_algorithm_field_id =
+        (*env)->GetFieldID(env, cls, "responseBodyChecksumAlgorithm", "I");
+    AWS_FATAL_ASSERT(s3_meta_request_native_options_properties.response_body_checksum_algorithm_field_id);
 }
 
 struct java_aws_mqtt5_connack_packet_properties mqtt5_connack_packet_properties;
@@ -1437,6 +1655,12 @@ static void s_cache_mqtt5_client_options(JNIEnv *env) {
         "getRetryJitterMode",
         "()Lsoftware/amazon/awssdk/crt/io/ExponentialBackoffRetryOptions$JitterMode;");
     AWS_FATAL_ASSERT(mqtt5_client_options_properties.options_get_retry_jitter_mode_id);
+    mqtt5_client_options_properties.options_get_offline_queue_overflow_policy_id = (*env)->GetMethodID(
+        env,
+        mqtt5_client_options_properties.client_options_class,
+        "getOfflineQueueOverflowPolicy",
+        "()Lsoftware/amazon/awssdk/crt/mqtt5/Mqtt5ClientOptions$OfflineQueueOverflowPolicy;");
+    AWS_FATAL_ASSERT(mqtt5_client_options_properties.options_get_offline_queue_overflow_policy_id);
     // Field IDs
     mqtt5_client_options_properties.options_host_name_field_id =
         (*env)->GetFieldID(env, mqtt5_client_options_properties.client_options_class, "hostName", "Ljava/lang/String;");
@@ -1507,6 +1731,18 @@ static void s_cache_mqtt5_client_options(JNIEnv *env) {
         "lifecycleEvents",
         "Lsoftware/amazon/awssdk/crt/mqtt5/Mqtt5ClientOptions$LifecycleEvents;");
     AWS_FATAL_ASSERT(mqtt5_client_options_properties.lifecycle_events_field_id);
+    mqtt5_client_options_properties.lazy_publish_packets_field_id = (*env)->GetFieldID(
+        env, mqtt5_client_options_properties.client_options_class, "lazyPublishPackets", "Z");
+    AWS_FATAL_ASSERT(mqtt5_client_options_properties.lazy_publish_packets_field_id);
+    mqtt5_client_options_properties.offline_queue_max_messages_field_id = (*env)->GetFieldID(
+        env, mqtt5_client_options_properties.client_options_class, "offlineQueueMaxMessages", "Ljava/lang/Long;");
+    AWS_FATAL_ASSERT(mqtt5_client_options_properties.offline_queue_max_messages_field_id);
+    mqtt5_client_options_properties.offline_queue_max_bytes_field_id = (*env)->GetFieldID(
+        env, mqtt5_client_options_properties.client_options_class, "offlineQueueMaxBytes", "Ljava/lang/Long;");
+    AWS_FATAL_ASSERT(mqtt5_client_options_properties.offline_queue_max_bytes_field_id);
+    mqtt5_client_options_properties.offline_queue_spill_path_field_id = (*env)->GetFieldID(
+        env, mqtt5_client_options_properties.client_options_class, "offlineQueueSpillPath", "Ljava/lang/String;");
+    AWS_FATAL_ASSERT(mqtt5_client_options_properties.offline_queue_spill_path_field_id);
 }
 
 struct java_aws_mqtt5_client_properties mqtt5_client_properties;
@@ -1527,6 +1763,20 @@ static void s_cache_mqtt5_client_properties(JNIEnv *env) {
     mqtt5_client_properties.client_set_is_connected =
         (*env)->GetMethodID(env, mqtt5_client_properties.client_class, "setIsConnected", "(Z)V");
     AWS_FATAL_ASSERT(mqtt5_client_properties.client_set_is_connected);
+
+    mqtt5_client_properties.client_on_lazy_publish_received_id = (*env)->GetMethodID(
+        env,
+        mqtt5_client_properties.client_class,
+        "onLazyPublishReceived",
+        "([JLjava/lang/String;Ljava/nio/ByteBuffer;IZ[B)V");
+    AWS_FATAL_ASSERT(mqtt5_client_properties.client_on_lazy_publish_received_id);
+
+    mqtt5_client_properties.client_on_routed_publish_received_id = (*env)->GetMethodID(
+        env,
+        mqtt5_client_properties.client_class,
+        "onRoutedPublishReceived",
+        "([JLsoftware/amazon/awssdk/crt/mqtt5/PublishReturn;)V");
+    AWS_FATAL_ASSERT(mqtt5_client_properties.client_on_routed_publish_received_id);
     // Field IDs
     mqtt5_client_properties.websocket_handshake_field_id = (*env)->GetFieldID(
         env, mqtt5_client_properties.client_class, "websocketHandshakeTransform", "Ljava/util/function/Consumer;");
@@ -1612,6 +1862,26 @@ static void s_cache_mqtt5_client_offline_queue_behavior_type(JNIEnv *env) {
     AWS_FATAL_ASSERT(mqtt5_client_offline_queue_behavior_type_properties.client_get_value_id);
 }
 
+struct java_aws_mqtt5_client_offline_queue_overflow_policy_properties
+    mqtt5_client_offline_queue_overflow_policy_properties;
+
+static void s_cache_mqtt5_client_offline_queue_overflow_policy(JNIEnv *env) {
+    jclass cls =
+        (*env)->FindClass(env, "software/amazon/awssdk/crt/mqtt5/Mqtt5ClientOptions$OfflineQueueOverflowPolicy");
+    AWS_FATAL_ASSERT(cls);
+    mqtt5_client_offline_queue_overflow_policy_properties.mqtt5_client_offline_queue_overflow_policy_class =
+        (*env)->NewGlobalRef(env, cls);
+    AWS_FATAL_ASSERT(
+        mqtt5_client_offline_queue_overflow_policy_properties.mqtt5_client_offline_queue_overflow_policy_class);
+    // Functions
+    mqtt5_client_offline_queue_overflow_policy_properties.client_get_value_id = (*env)->GetMethodID(
+        env,
+        mqtt5_client_offline_queue_overflow_policy_properties.mqtt5_client_offline_queue_overflow_policy_class,
+        "getValue",
+        "()I");
+    AWS_FATAL_ASSERT(mqtt5_client_offline_queue_overflow_policy_properties.client_get_value_id);
+}
+
 struct java_aws_mqtt5_client_jitter_mode_properties mqtt5_client_jitter_mode_properties;
 
 static void s_cache_mqtt5_client_jitter_mode(JNIEnv *env) {
@@ -2081,16 +2351,13 @@ static void s_cache_boxed_array_list(JNIEnv *env) {
     AWS_FATAL_ASSERT(boxed_array_list_properties.list_constructor_id);
 }
 
-void cache_java_class_ids(JNIEnv *env) {
+static void s_cache_core_class_ids(JNIEnv *env) {
     s_cache_http_request_body_stream(env);
     s_cache_aws_signing_config(env);
     s_cache_predicate(env);
     s_cache_boxed_long(env);
     s_cache_http_request(env);
     s_cache_crt_resource(env);
-    s_cache_mqtt_connection(env);
-    s_cache_message_handler(env);
-    s_cache_mqtt_exception(env);
     s_cache_byte_buffer(env);
     s_cache_credentials_provider(env);
     s_cache_credentials(env);
@@ -2109,21 +2376,14 @@ void cache_java_class_ids(JNIEnv *env) {
     s_cache_http2_stream(env);
     s_cache_http_stream_response_handler_native_adapter(env);
     s_cache_http_stream_write_chunk_completion_properties(env);
-    s_cache_event_stream_server_listener_properties(env);
-    s_cache_event_stream_server_listener_handler_properties(env);
-    s_cache_event_stream_server_connection_handler_properties(env);
-    s_cache_event_stream_server_continuation_handler_properties(env);
-    s_cache_event_stream_client_connection_handler_properties(env);
-    s_cache_event_stream_client_continuation_handler_properties(env);
-    s_cache_event_stream_message_flush_properties(env);
     s_cache_cpu_info_properties(env);
-    s_cache_s3_client_properties(env);
-    s_cache_s3_meta_request_properties(env);
-    s_cache_s3_meta_request_response_handler_native_adapter_properties(env);
     s_cache_completable_future(env);
+    s_cache_string(env);
     s_cache_crt_runtime_exception(env);
+    s_cache_exceptions(env);
     s_cache_ecc_key_pair(env);
     s_cache_crt(env);
+    s_cache_log(env);
     s_cache_aws_signing_result(env);
     s_cache_http_header(env);
     s_cache_http_manager_metrics(env);
@@ -2131,8 +2391,14 @@ void cache_java_class_ids(JNIEnv *env) {
     s_cache_standard_retry_options(env);
     s_cache_directory_traversal_handler(env);
     s_cache_directory_entry(env);
-    s_cache_s3_meta_request_progress(env);
-    s_cache_s3_meta_request_resume_token(env);
+    s_cache_directory_entry_batch_handler(env);
+    s_cache_directory_entry_batch(env);
+}
+
+static void s_cache_mqtt_class_ids(JNIEnv *env) {
+    s_cache_mqtt_connection(env);
+    s_cache_message_handler(env);
+    s_cache_mqtt_exception(env);
     s_cache_mqtt5_connack_packet(env);
     s_cache_mqtt5_connect_packet(env);
     s_cache_mqtt5_connect_reason_code(env);
@@ -2151,6 +2417,7 @@ void cache_java_class_ids(JNIEnv *env) {
     s_cache_mqtt5_client_session_behavior(env);
     s_cache_mqtt5_client_extended_validation_and_flow_control_options(env);
     s_cache_mqtt5_client_offline_queue_behavior_type(env);
+    s_cache_mqtt5_client_offline_queue_overflow_policy(env);
     s_cache_mqtt5_client_jitter_mode(env);
     s_cache_mqtt5_subscribe_packet(env);
     s_cache_mqtt5_subscribe_subscription(env);
@@ -2176,3 +2443,117 @@ void cache_java_class_ids(JNIEnv *env) {
     s_cache_boxed_list(env);
     s_cache_boxed_array_list(env);
 }
+
+static void s_cache_event_stream_class_ids(JNIEnv *env) {
+    s_cache_event_stream_server_listener_properties(env);
+    s_cache_event_stream_server_listener_handler_properties(env);
+    s_cache_event_stream_server_connection_handler_properties(env);
+    s_cache_event_stream_server_continuation_handler_properties(env);
+    s_cache_event_stream_client_connection_handler_properties(env);
+    s_cache_event_stream_client_continuation_handler_properties(env);
+    s_cache_event_stream_message_flush_properties(env);
+}
+
+static void s_cache_s3_class_ids(JNIEnv *env) {
+    s_cache_s3_client_properties(env);
+    s_cache_s3_meta_request_properties(env);
+    s_cache_s3_meta_request_response_handler_native_adapter_properties(env);
+    s_cache_s3_client_statistics(env);
+    s_cache_s3_meta_request_progress(env);
+    s_cache_s3_meta_request_resume_token(env);
+    s_cache_s3_meta_request_native_options(env);
+    s_cache_s3_loopback_server_properties(env);
+}
+
+/*
+ * Only the core class ids (io, http, auth, ...) are cached when the library is loaded. Each of the other groups is
+ * only used by one subsystem, and is cached the first time that subsystem creates something, so an app pays only for
+ * what it uses at startup.
+ */
+enum class_id_group_index {
+    CLASS_ID_GROUP_CORE,
+    CLASS_ID_GROUP_MQTT,
+    CLASS_ID_GROUP_EVENT_STREAM,
+    CLASS_ID_GROUP_S3,
+};
+
+struct class_id_group {
+    const char *name;
+    void (*cache_fn)(JNIEnv *env);
+    aws_thread_once once;
+    uint64_t cache_time_ns;
+};
+
+static struct class_id_group s_class_id_groups[] = {
+    [CLASS_ID_GROUP_CORE] = {.name = "core", .cache_fn = s_cache_core_class_ids, .once = AWS_THREAD_ONCE_STATIC_INIT},
+    [CLASS_ID_GROUP_MQTT] = {.name = "mqtt", .cache_fn = s_cache_mqtt_class_ids, .once = AWS_THREAD_ONCE_STATIC_INIT},
+    [CLASS_ID_GROUP_EVENT_STREAM] =
+        {.name = "event-stream", .cache_fn = s_cache_event_stream_class_ids, .once = AWS_THREAD_ONCE_STATIC_INIT},
+    [CLASS_ID_GROUP_S3] = {.name = "s3", .cache_fn = s_cache_s3_class_ids, .once = AWS_THREAD_ONCE_STATIC_INIT},
+};
+
+struct class_id_group_cache_args {
+    struct class_id_group *group;
+    JNIEnv *env;
+};
+
+static void s_cache_class_id_group_once(void *user_data) {
+    struct class_id_group_cache_args *args = user_data;
+
+    uint64_t start_ns = 0;
+    aws_high_res_clock_get_ticks(&start_ns);
+    args->group->cache_fn(args->env);
+    uint64_t end_ns = 0;
+    aws_high_res_clock_get_ticks(&end_ns);
+    args->group->cache_time_ns = end_ns - start_ns;
+
+    /* the core group is cached before logging is set up, log_java_class_ids_cache_times() reports it instead */
+    if (args->group != &s_class_id_groups[CLASS_ID_GROUP_CORE]) {
+        AWS_LOGF_DEBUG(
+            AWS_LS_JAVA_CRT_GENERAL,
+            "Cached %s java class ids in %" PRIu64 " us",
+            args->group->name,
+            aws_timestamp_convert(args->group->cache_time_ns, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MICROS, NULL));
+    }
+}
+
+static void s_cache_class_id_group(JNIEnv *env, enum class_id_group_index index) {
+    struct class_id_group_cache_args args = {
+        .group = &s_class_id_groups[index],
+        .env = env,
+    };
+    aws_thread_call_once(&s_class_id_groups[index].once, s_cache_class_id_group_once, &args);
+}
+
+void cache_java_class_ids(JNIEnv *env) {
+    s_cache_class_id_group(env, CLASS_ID_GROUP_CORE);
+}
+
+void cache_java_class_ids_for_mqtt(JNIEnv *env) {
+    s_cache_class_id_group(env, CLASS_ID_GROUP_MQTT);
+}
+
+void cache_java_class_ids_for_event_stream(JNIEnv *env) {
+    s_cache_class_id_group(env, CLASS_ID_GROUP_EVENT_STREAM);
+}
+
+void cache_java_class_ids_for_s3(JNIEnv *env) {
+    s_cache_class_id_group(env, CLASS_ID_GROUP_S3);
+}
+
+void log_java_class_ids_cache_times(void) {
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(s_class_id_groups); ++i) {
+        /* only ever written once, before the group's once flag is set */
+        uint64_t cache_time_ns = s_class_id_groups[i].cache_time_ns;
+        if (cache_time_ns == 0) {
+            AWS_LOGF_DEBUG(AWS_LS_JAVA_CRT_GENERAL, "%s java class ids not cached yet", s_class_id_groups[i].name);
+            continue;
+        }
+
+        AWS_LOGF_DEBUG(
+            AWS_LS_JAVA_CRT_GENERAL,
+            "Cached %s java class ids in %" PRIu64 " us",
+            s_class_id_groups[i].name,
+            aws_timestamp_convert(cache_time_ns, AWS_TIMESTAMP_NANOS, AWS_TIMESTAMP_MICROS, NULL));
+    }
+}
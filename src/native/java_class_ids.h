@@ -33,6 +33,8 @@ struct java_aws_signing_config_properties {
     jfieldID signed_body_value_field_id;
     jfieldID signed_body_header_field_id;
     jfieldID expiration_in_seconds_field_id;
+    jfieldID signed_header_allow_list_field_id;
+    jfieldID signed_header_deny_list_field_id;
 };
 extern struct java_aws_signing_config_properties aws_signing_config_properties;
 
@@ -80,6 +82,8 @@ extern struct java_mqtt_connection_properties mqtt_connection_properties;
 /* MqttClientConnection.MessageHandler */
 struct java_message_handler_properties {
     jmethodID deliver;
+    jmethodID deliver_direct;
+    jfieldID direct_payload_field_id;
 };
 extern struct java_message_handler_properties message_handler_properties;
 
@@ -183,7 +187,9 @@ extern struct java_tls_key_operation_properties tls_key_operation_properties;
 
 /* HttpClientConnectionManager */
 struct java_http_client_connection_manager_properties {
+    jclass http_client_connection_manager_class;
     jmethodID onShutdownComplete;
+    jmethodID onPrewarmComplete;
 };
 extern struct java_http_client_connection_manager_properties http_client_connection_manager_properties;
 
@@ -221,6 +227,7 @@ struct java_http_stream_response_handler_native_adapter_properties {
     jmethodID onResponseHeadersDone;
     jmethodID onResponseBody;
     jmethodID onResponseComplete;
+    jmethodID getMinimumResponseBodyChunkSize;
 };
 extern struct java_http_stream_response_handler_native_adapter_properties http_stream_response_handler_properties;
 
@@ -290,18 +297,27 @@ struct java_s3_client_properties {
 };
 extern struct java_s3_client_properties s3_client_properties;
 
+/* S3LoopbackServer */
+struct java_s3_loopback_server_properties {
+    jmethodID onShutdownComplete;
+};
+extern struct java_s3_loopback_server_properties s3_loopback_server_properties;
+
 /* S3Client */
 struct java_s3_meta_request_properties {
     jmethodID onShutdownComplete;
+    jfieldID download_resume_state_field_id;
 };
 extern struct java_s3_meta_request_properties s3_meta_request_properties;
 
 /* S3MetaRequestResponseHandlerNativeAdapter */
 struct java_s3_meta_request_response_handler_native_adapter_properties {
     jmethodID onResponseBody;
+    jmethodID onResponseBodyDirect;
     jmethodID onFinished;
     jmethodID onResponseHeaders;
     jmethodID onProgress;
+    jmethodID onMetrics;
 };
 extern struct java_s3_meta_request_response_handler_native_adapter_properties
     s3_meta_request_response_handler_native_adapter_properties;
@@ -314,6 +330,12 @@ struct java_completable_future_properties {
 
 extern struct java_completable_future_properties completable_future_properties;
 
+/* java/lang/String */
+struct java_string_properties {
+    jclass string_class;
+};
+extern struct java_string_properties string_properties;
+
 /* CrtRuntimeException */
 struct java_crt_runtime_exception_properties {
     jclass crt_runtime_exception_class;
@@ -322,6 +344,13 @@ struct java_crt_runtime_exception_properties {
 };
 extern struct java_crt_runtime_exception_properties crt_runtime_exception_properties;
 
+/* java.lang exceptions thrown from native code */
+struct java_exception_properties {
+    jclass null_pointer_exception_class;
+    jclass illegal_argument_exception_class;
+};
+extern struct java_exception_properties exception_properties;
+
 /* EccKeyPair */
 struct java_ecc_key_pair_properties {
     jclass ecc_key_pair_class;
@@ -336,6 +365,13 @@ struct java_crt_properties {
 };
 extern struct java_crt_properties crt_properties;
 
+/* Log */
+struct java_log_properties {
+    jclass log_class;
+    jmethodID deliver_log_batch_method_id;
+};
+extern struct java_log_properties log_properties;
+
 /* AwsSigningResult */
 struct java_aws_signing_result_properties {
     jclass aws_signing_result_class;
@@ -356,9 +392,17 @@ extern struct java_http_header_properties http_header_properties;
 struct java_http_manager_metrics_properties {
     jclass http_manager_metrics_class;
     jmethodID constructor_method_id;
+    jmethodID acquisition_stats_constructor_method_id;
 };
 extern struct java_http_manager_metrics_properties http_manager_metrics_properties;
 
+/* S3ClientStatistics */
+struct java_s3_client_statistics_properties {
+    jclass s3_client_statistics_class;
+    jmethodID constructor_method_id;
+};
+extern struct java_s3_client_statistics_properties s3_client_statistics_properties;
+
 /* ExponentialBackoffRetryOptions */
 struct java_aws_exponential_backoff_retry_options_properties {
     jclass exponential_backoff_retry_options_class;
@@ -402,6 +446,20 @@ struct java_aws_directory_entry_properties {
 };
 extern struct java_aws_directory_entry_properties directory_entry_properties;
 
+/* DirectoryEntryBatchHandler */
+struct java_aws_directory_entry_batch_handler_properties {
+    jclass directory_entry_batch_handler_class;
+    jmethodID on_directory_entries_method_id;
+};
+extern struct java_aws_directory_entry_batch_handler_properties directory_entry_batch_handler_properties;
+
+/* DirectoryEntryBatch */
+struct java_aws_directory_entry_batch_properties {
+    jclass directory_entry_batch_class;
+    jmethodID directory_entry_batch_constructor_method_id;
+};
+extern struct java_aws_directory_entry_batch_properties directory_entry_batch_properties;
+
 /* S3MetaRequestProgress */
 struct java_aws_s3_meta_request_progress {
     jclass s3_meta_request_progress_class;
@@ -420,9 +478,43 @@ struct java_aws_s3_meta_request_resume_token {
     jfieldID total_num_parts_field_id;
     jfieldID num_parts_completed_field_id;
     jfieldID upload_id_field_id;
+    jfieldID object_size_field_id;
+    jfieldID etag_field_id;
+    jfieldID completed_parts_field_id;
 };
 extern struct java_aws_s3_meta_request_resume_token s3_meta_request_resume_token_properties;
 
+/* S3Client.MetaRequestNativeOptions */
+struct java_s3_meta_request_native_options_properties {
+    jfieldID region_field_id;
+    jfieldID meta_request_type_field_id;
+    jfieldID checksum_location_field_id;
+    jfieldID checksum_algorithm_field_id;
+    jfieldID validate_checksum_field_id;
+    jfieldID validate_algorithms_field_id;
+    jfieldID http_request_bytes_field_id;
+    jfieldID http_request_body_stream_field_id;
+    jfieldID credentials_provider_field_id;
+    jfieldID response_handler_native_adapter_field_id;
+    jfieldID endpoint_field_id;
+    jfieldID resume_token_field_id;
+    jfieldID zero_copy_response_body_field_id;
+    jfieldID response_file_path_field_id;
+    jfieldID request_file_path_field_id;
+    jfieldID request_part_buffer_queue_field_id;
+    jfieldID part_size_field_id;
+    jfieldID progress_interval_bytes_field_id;
+    jfieldID progress_interval_millis_field_id;
+    jfieldID reuse_progress_object_field_id;
+    jfieldID metrics_enabled_field_id;
+    jfieldID statistics_field_id;
+    jfieldID response_buffers_field_id;
+    jfieldID response_buffer_layout_field_id;
+    jfieldID response_range_start_field_id;
+    jfieldID response_body_checksum_algorithm_field_id;
+};
+extern struct java_s3_meta_request_native_options_properties s3_meta_request_native_options_properties;
+
 /* mqtt5.packets.ConnAckPacket */
 struct java_aws_mqtt5_connack_packet_properties {
     jclass connack_packet_class;
@@ -608,6 +700,7 @@ struct java_aws_mqtt5_client_options_properties {
     jmethodID options_get_extended_validation_and_flow_control_options_id;
     jmethodID options_get_offline_queue_behavior_id;
     jmethodID options_get_retry_jitter_mode_id;
+    jmethodID options_get_offline_queue_overflow_policy_id;
 
     jfieldID options_host_name_field_id;
     jfieldID options_port_field_id;
@@ -626,6 +719,10 @@ struct java_aws_mqtt5_client_options_properties {
     jfieldID ack_timeout_seconds_field_id;
     jfieldID publish_events_field_id;
     jfieldID lifecycle_events_field_id;
+    jfieldID lazy_publish_packets_field_id;
+    jfieldID offline_queue_max_messages_field_id;
+    jfieldID offline_queue_max_bytes_field_id;
+    jfieldID offline_queue_spill_path_field_id;
 };
 extern struct java_aws_mqtt5_client_options_properties mqtt5_client_options_properties;
 
@@ -634,6 +731,8 @@ struct java_aws_mqtt5_client_properties {
     jclass client_class;
     jmethodID client_on_websocket_handshake_id;
     jmethodID client_set_is_connected;
+    jmethodID client_on_lazy_publish_received_id;
+    jmethodID client_on_routed_publish_received_id;
     jfieldID websocket_handshake_field_id;
 };
 extern struct java_aws_mqtt5_client_properties mqtt5_client_properties;
@@ -672,6 +771,14 @@ struct java_aws_mqtt5_client_offline_queue_behavior_type_properties {
 extern struct java_aws_mqtt5_client_offline_queue_behavior_type_properties
     mqtt5_client_offline_queue_behavior_type_properties;
 
+/* mqtt5.ClientOptions.OfflineQueueOverflowPolicy */
+struct java_aws_mqtt5_client_offline_queue_overflow_policy_properties {
+    jclass mqtt5_client_offline_queue_overflow_policy_class;
+    jmethodID client_get_value_id;
+};
+extern struct java_aws_mqtt5_client_offline_queue_overflow_policy_properties
+    mqtt5_client_offline_queue_overflow_policy_properties;
+
 /* mqtt5.ClientOptions.JitterMode */
 struct java_aws_mqtt5_client_jitter_mode_properties {
     jclass mqtt5_client_jitter_mode_class;
@@ -874,6 +981,18 @@ struct java_boxed_array_list_properties {
 };
 extern struct java_boxed_array_list_properties boxed_array_list_properties;
 
+/* Caches the class ids used throughout the library, called once when the library is loaded */
 void cache_java_class_ids(JNIEnv *env);
 
+/*
+ * Each caches the class ids only used by one subsystem, the first time it's called. Called when the subsystem creates
+ * an object, before anything that uses those ids can run. Safe to call from any thread, any number of times.
+ */
+void cache_java_class_ids_for_mqtt(JNIEnv *env);
+void cache_java_class_ids_for_event_stream(JNIEnv *env);
+void cache_java_class_ids_for_s3(JNIEnv *env);
+
+/* Logs how long each group of class ids took to cache, at debug level */
+void log_java_class_ids_cache_times(void);
+
 #endif /* AWS_JNI_CRT_JAVA_CLASS_IDS_H */
@@ -0,0 +1,40 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "latency_histogram.h"
+
+#include <aws/common/math.h>
+
+void aws_jni_latency_histogram_init(struct aws_jni_latency_histogram *histogram) {
+    for (size_t i = 0; i < AWS_JNI_LATENCY_HISTOGRAM_BUCKETS; ++i) {
+        aws_atomic_init_int(&histogram->buckets[i], 0);
+    }
+}
+
+/*
+ * Below 4us every microsecond has its own bucket. Above that, a value whose highest set bit is bit e lands in one of
+ * four buckets for [2^e, 2^(e+1)), picked by the next two bits down.
+ */
+static size_t s_bucket_index(uint64_t latency_us) {
+    if (latency_us < 4) {
+        return (size_t)latency_us;
+    }
+
+    size_t exponent = 63 - aws_clz_u64(latency_us);
+    size_t sub_bucket = (size_t)(latency_us >> (exponent - 2)) & 3;
+    size_t index = 4 * (exponent - 1) + sub_bucket;
+    return AWS_MIN(index, AWS_JNI_LATENCY_HISTOGRAM_BUCKETS - 1);
+}
+
+void aws_jni_latency_histogram_record_ns(struct aws_jni_latency_histogram *histogram, uint64_t latency_ns) {
+    aws_atomic_fetch_add_explicit(&histogram->buckets[s_bucket_index(latency_ns / 1000)], 1, aws_memory_order_relaxed);
+}
+
+void aws_jni_latency_histogram_snapshot(const struct aws_jni_latency_histogram *histogram, int64_t *out) {
+    for (size_t i = 0; i < AWS_JNI_LATENCY_HISTOGRAM_BUCKETS; ++i) {
+        out[i] = (int64_t)aws_atomic_load_int_explicit(
+            (struct aws_atomic_var *)&histogram->buckets[i], aws_memory_order_relaxed);
+    }
+}
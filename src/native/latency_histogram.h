@@ -0,0 +1,31 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_LATENCY_HISTOGRAM_H
+#define AWS_JNI_CRT_LATENCY_HISTOGRAM_H
+
+#include <aws/common/atomics.h>
+
+/*
+ * A fixed-size, lock-free histogram of latencies in microseconds. Buckets are spaced logarithmically, four to each
+ * power of two, so any latency from a microsecond to days is recorded with at most 25% error in a couple of hundred
+ * counters, and recording one is a shift and an atomic increment (cheap enough for every event on an event loop).
+ *
+ * Must match the bucket layout in LatencyHistogram.java.
+ */
+#define AWS_JNI_LATENCY_HISTOGRAM_BUCKETS 168
+
+struct aws_jni_latency_histogram {
+    struct aws_atomic_var buckets[AWS_JNI_LATENCY_HISTOGRAM_BUCKETS];
+};
+
+void aws_jni_latency_histogram_init(struct aws_jni_latency_histogram *histogram);
+
+void aws_jni_latency_histogram_record_ns(struct aws_jni_latency_histogram *histogram, uint64_t latency_ns);
+
+/* Copies out the count of every bucket, out must hold AWS_JNI_LATENCY_HISTOGRAM_BUCKETS values */
+void aws_jni_latency_histogram_snapshot(const struct aws_jni_latency_histogram *histogram, int64_t *out);
+
+#endif /* AWS_JNI_CRT_LATENCY_HISTOGRAM_H */
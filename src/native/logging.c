@@ -6,6 +6,7 @@
 
 #include <aws/common/logging.h>
 
+#include "async_logger.h"
 #include "crt.h"
 
 /* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
@@ -95,6 +96,104 @@ void JNICALL Java_software_amazon_awssdk_crt_Log_initLoggingToFile(
     (*env)->ReleaseStringUTFChars(env, jni_filename, filename);
 }
 
+/* Log.LogSubject has fewer values than this */
+#define AWS_JNI_MAX_SUBJECT_LEVELS 64
+
+/* Must match Log.LogDestination */
+enum aws_jni_log_destination {
+    AWS_JNI_LOG_DESTINATION_STDOUT = 1,
+    AWS_JNI_LOG_DESTINATION_STDERR = 2,
+    AWS_JNI_LOG_DESTINATION_FILE = 3,
+    AWS_JNI_LOG_DESTINATION_SINK = 4,
+};
+
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_Log_initAsyncLogging(
+    JNIEnv *env,
+    jclass jni_crt_class,
+    jint level,
+    jint destination,
+    jstring jni_filename,
+    jobject jni_sink,
+    jint format,
+    jint queue_capacity,
+    jint max_records_per_subject_per_second,
+    jintArray jni_subjects,
+    jintArray jni_subject_levels) {
+    (void)jni_crt_class;
+
+    if (queue_capacity < 0 || max_records_per_subject_per_second < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "Log.initAsyncLogging: limits must not be negative");
+        return;
+    }
+
+    jsize subject_level_count = (*env)->GetArrayLength(env, jni_subjects);
+    if ((*env)->GetArrayLength(env, jni_subject_levels) != subject_level_count) {
+        aws_jni_throw_illegal_argument_exception(env, "Log.initAsyncLogging: mismatched subject levels");
+        return;
+    }
+
+    /* the logger copies these */
+    struct aws_jni_log_subject_level subject_levels[AWS_JNI_MAX_SUBJECT_LEVELS];
+    if (subject_level_count > AWS_JNI_MAX_SUBJECT_LEVELS) {
+        aws_jni_throw_illegal_argument_exception(env, "Log.initAsyncLogging: too many subject levels");
+        return;
+    }
+    for (jsize i = 0; i < subject_level_count; ++i) {
+        jint subject = 0;
+        jint subject_level = 0;
+        (*env)->GetIntArrayRegion(env, jni_subjects, i, 1, &subject);
+        (*env)->GetIntArrayRegion(env, jni_subject_levels, i, 1, &subject_level);
+        subject_levels[i].subject = (aws_log_subject_t)subject;
+        subject_levels[i].level = (enum aws_log_level)subject_level;
+    }
+
+    struct aws_jni_async_logger_options log_options = {
+        .level = level,
+        .subject_levels = subject_levels,
+        .subject_level_count = (size_t)subject_level_count,
+        .format = format,
+        .queue_capacity = (size_t)queue_capacity,
+        .max_records_per_subject_per_second = (size_t)max_records_per_subject_per_second,
+    };
+
+    const char *filename = NULL;
+    switch (destination) {
+        case AWS_JNI_LOG_DESTINATION_STDOUT:
+            log_options.file = stdout;
+            break;
+        case AWS_JNI_LOG_DESTINATION_STDERR:
+            log_options.file = stderr;
+            break;
+        case AWS_JNI_LOG_DESTINATION_FILE:
+            filename = (*env)->GetStringUTFChars(env, jni_filename, NULL);
+            log_options.filename = filename;
+            break;
+        case AWS_JNI_LOG_DESTINATION_SINK:
+            log_options.sink = jni_sink;
+            if ((*env)->GetJavaVM(env, &log_options.jvm) != 0) {
+                aws_jni_throw_runtime_exception(env, "Log.initAsyncLogging: Unable to get JVM");
+                return;
+            }
+            break;
+        default:
+            aws_jni_throw_illegal_argument_exception(env, "Log.initAsyncLogging: unknown destination");
+            return;
+    }
+
+    /* NOT using aws_jni_get_allocator to avoid trace leak outside the test */
+    if (aws_jni_async_logger_init(&s_logger, env, aws_default_allocator(), &log_options)) {
+        aws_jni_throw_runtime_exception(env, "Failed to initialize asynchronous logger");
+    } else {
+        aws_logger_set(&s_logger);
+        s_initialized_logger = true;
+    }
+
+    if (filename != NULL) {
+        (*env)->ReleaseStringUTFChars(env, jni_filename, filename);
+    }
+}
+
 void aws_jni_cleanup_logging(void) {
     if (aws_logger_get() == &s_logger) {
         aws_logger_set(NULL);
@@ -102,9 +201,18 @@ void aws_jni_cleanup_logging(void) {
 
     if (s_initialized_logger) {
         aws_logger_clean_up(&s_logger);
+        s_initialized_logger = false;
     }
 }
 
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_Log_shutdownLoggingNative(JNIEnv *env, jclass jni_crt_class) {
+    (void)env;
+    (void)jni_crt_class;
+
+    aws_jni_cleanup_logging();
+}
+
 #if UINTPTR_MAX == 0xffffffff
 #    if defined(_MSC_VER)
 #        pragma warning(pop)
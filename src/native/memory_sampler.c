@@ -0,0 +1,282 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "memory_sampler.h"
+
+#include <aws/common/clock.h>
+#include <aws/common/hash_table.h>
+#include <aws/common/logging.h>
+#include <aws/common/mutex.h>
+#include <aws/common/system_info.h>
+#include <aws/common/thread.h>
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "crt.h"
+
+#define SAMPLE_MAX_FRAMES 16
+/* aws_backtrace(), the sampler and the accounting allocator */
+#define SAMPLE_SKIPPED_FRAMES 3
+#define DUMP_MAX_STACKS 20
+
+struct memory_sample {
+    size_t size;
+    int subsystem;
+    size_t frame_count;
+    void *frames[SAMPLE_MAX_FRAMES];
+};
+
+static const char *s_subsystem_names[AWS_JNI_SUBSYSTEM_COUNT] = {
+    [AWS_JNI_SUBSYSTEM_GENERAL] = "general",
+    [AWS_JNI_SUBSYSTEM_IO] = "io",
+    [AWS_JNI_SUBSYSTEM_HTTP] = "http",
+    [AWS_JNI_SUBSYSTEM_AUTH] = "auth",
+    [AWS_JNI_SUBSYSTEM_MQTT] = "mqtt",
+    [AWS_JNI_SUBSYSTEM_EVENT_STREAM] = "event-stream",
+    [AWS_JNI_SUBSYSTEM_S3] = "s3",
+};
+
+static size_t s_sample_interval = 0;
+
+/* All sampler memory comes from the default allocator, so the sampler never samples or accounts for itself */
+static struct aws_mutex s_samples_lock = AWS_MUTEX_INIT;
+static struct aws_hash_table s_samples; /* block -> struct memory_sample */
+static uint64_t s_estimated_bytes = 0;
+
+static AWS_THREAD_LOCAL int64_t tl_bytes_until_sample = 0;
+static AWS_THREAD_LOCAL uint64_t tl_random_state = 0;
+
+static void s_destroy_sample(void *value) {
+    aws_mem_release(aws_default_allocator(), value);
+}
+
+void aws_jni_memory_sampler_init(size_t sample_interval) {
+    if (sample_interval == 0) {
+        return;
+    }
+
+    AWS_FATAL_ASSERT(
+        aws_hash_table_init(
+            &s_samples, aws_default_allocator(), 1024, aws_hash_ptr, aws_ptr_eq, NULL, s_destroy_sample) ==
+        AWS_OP_SUCCESS);
+    s_sample_interval = sample_interval;
+}
+
+void aws_jni_memory_sampler_clean_up(void) {
+    if (s_sample_interval == 0) {
+        return;
+    }
+
+    /* blocks released after this (or concurrently, during shutdown) find the sampler off and skip it */
+    aws_mutex_lock(&s_samples_lock);
+    s_sample_interval = 0;
+    aws_hash_table_clean_up(&s_samples);
+    s_estimated_bytes = 0;
+    aws_mutex_unlock(&s_samples_lock);
+}
+
+bool aws_jni_memory_sampler_is_enabled(void) {
+    return s_sample_interval > 0;
+}
+
+/*
+ * Distance to the next sample, uniform over [interval / 2, interval * 3 / 2) so that the mean is the interval, and
+ * allocation patterns that repeat with the same period as the interval aren't always sampled the same way.
+ */
+static int64_t s_next_sample_distance(void) {
+    /* xorshift64, seeded per thread */
+    uint64_t x = tl_random_state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    tl_random_state = x;
+
+    return (int64_t)(s_sample_interval / 2 + x % s_sample_interval);
+}
+
+bool aws_jni_memory_sampler_should_sample(size_t size) {
+    if (AWS_UNLIKELY(tl_random_state == 0)) {
+        uint64_t now = 0;
+        aws_high_res_clock_get_ticks(&now);
+        tl_random_state = (now ^ (uint64_t)(uintptr_t)&tl_random_state) | 1;
+        tl_bytes_until_sample = s_next_sample_distance();
+    }
+
+    tl_bytes_until_sample -= (int64_t)size;
+    if (AWS_LIKELY(tl_bytes_until_sample > 0)) {
+        return false;
+    }
+
+    tl_bytes_until_sample = s_next_sample_distance();
+    return true;
+}
+
+/*
+ * Bytes of live memory a sample stands for: its size over the chance that a block that size is sampled at all.
+ * A block is sampled when it's at least the bytes left until the next sample, which are spread uniformly over
+ * [0, interval / 2) half of the time and then thin out linearly up to interval * 3 / 2. So with t = size / interval,
+ * a block is sampled with probability t below an interval / 2, (12t - 4t^2 - 1) / 8 up to interval * 3 / 2, and
+ * always beyond that.
+ */
+static uint64_t s_sample_weight(size_t size) {
+    double interval = (double)s_sample_interval;
+    double block_size = (double)size;
+    if (block_size * 2 <= interval) {
+        return (uint64_t)s_sample_interval;
+    }
+    if (block_size * 2 >= interval * 3) {
+        return (uint64_t)size;
+    }
+
+    double t = block_size / interval;
+    double probability = (12 * t - 4 * t * t - 1) / 8;
+    return (uint64_t)(block_size / probability);
+}
+
+void aws_jni_memory_sampler_record(void *ptr, size_t size, int subsystem) {
+    struct memory_sample *sample = aws_mem_calloc(aws_default_allocator(), 1, sizeof(struct memory_sample));
+    sample->size = size;
+    sample->subsystem = subsystem;
+    sample->frame_count = aws_backtrace(sample->frames, SAMPLE_MAX_FRAMES);
+
+    aws_mutex_lock(&s_samples_lock);
+    int was_created = 0;
+    if (s_sample_interval == 0 || aws_hash_table_put(&s_samples, ptr, sample, &was_created)) {
+        aws_mutex_unlock(&s_samples_lock);
+        s_destroy_sample(sample);
+        return;
+    }
+    s_estimated_bytes += s_sample_weight(size);
+    aws_mutex_unlock(&s_samples_lock);
+}
+
+void aws_jni_memory_sampler_forget(void *ptr) {
+    struct aws_hash_element removed;
+    AWS_ZERO_STRUCT(removed);
+    int was_present = 0;
+
+    aws_mutex_lock(&s_samples_lock);
+    if (s_sample_interval != 0) {
+        aws_hash_table_remove(&s_samples, ptr, &removed, &was_present);
+    }
+    if (was_present) {
+        struct memory_sample *sample = removed.value;
+        s_estimated_bytes -= s_sample_weight(sample->size);
+    }
+    aws_mutex_unlock(&s_samples_lock);
+
+    if (was_present) {
+        s_destroy_sample(removed.value);
+    }
+}
+
+uint64_t aws_jni_memory_sampler_estimated_bytes(void) {
+    aws_mutex_lock(&s_samples_lock);
+    uint64_t estimated_bytes = s_estimated_bytes;
+    aws_mutex_unlock(&s_samples_lock);
+    return estimated_bytes;
+}
+
+static int s_compare_sample_stacks(const void *a, const void *b) {
+    const struct memory_sample *lhs = a;
+    const struct memory_sample *rhs = b;
+    if (lhs->frame_count != rhs->frame_count) {
+        return lhs->frame_count < rhs->frame_count ? -1 : 1;
+    }
+    if (lhs->subsystem != rhs->subsystem) {
+        return lhs->subsystem < rhs->subsystem ? -1 : 1;
+    }
+    return memcmp(lhs->frames, rhs->frames, lhs->frame_count * sizeof(void *));
+}
+
+struct sampled_stack {
+    const struct memory_sample *first;
+    size_t samples;
+    uint64_t estimated_bytes;
+};
+
+static int s_compare_stacks_by_bytes(const void *a, const void *b) {
+    const struct sampled_stack *lhs = a;
+    const struct sampled_stack *rhs = b;
+    if (lhs->estimated_bytes == rhs->estimated_bytes) {
+        return 0;
+    }
+    return lhs->estimated_bytes > rhs->estimated_bytes ? -1 : 1;
+}
+
+void aws_jni_memory_sampler_dump(void) {
+    if (s_sample_interval == 0) {
+        return;
+    }
+
+    struct aws_allocator *allocator = aws_default_allocator();
+
+    /* copy the samples out, so the lock isn't held while symbolizing and logging */
+    aws_mutex_lock(&s_samples_lock);
+    size_t sample_count = aws_hash_table_get_entry_count(&s_samples);
+    uint64_t estimated_bytes = s_estimated_bytes;
+    struct memory_sample *samples =
+        sample_count > 0 ? aws_mem_calloc(allocator, sample_count, sizeof(struct memory_sample)) : NULL;
+    size_t copied = 0;
+    for (struct aws_hash_iter iter = aws_hash_iter_begin(&s_samples); !aws_hash_iter_done(&iter);
+         aws_hash_iter_next(&iter)) {
+        samples[copied++] = *(struct memory_sample *)iter.element.value;
+    }
+    aws_mutex_unlock(&s_samples_lock);
+
+    AWS_LOGF_INFO(
+        AWS_LS_JAVA_CRT_GENERAL,
+        "Sampled native memory: %zu live samples, about %" PRIu64 " bytes live, sampling every %zu bytes",
+        sample_count,
+        estimated_bytes,
+        s_sample_interval);
+    if (sample_count == 0) {
+        return;
+    }
+
+    qsort(samples, sample_count, sizeof(struct memory_sample), s_compare_sample_stacks);
+
+    struct sampled_stack *stacks = aws_mem_calloc(allocator, sample_count, sizeof(struct sampled_stack));
+    size_t stack_count = 0;
+    for (size_t i = 0; i < sample_count; ++i) {
+        if (stack_count == 0 || s_compare_sample_stacks(stacks[stack_count - 1].first, &samples[i]) != 0) {
+            stacks[stack_count++].first = &samples[i];
+        }
+        stacks[stack_count - 1].samples++;
+        stacks[stack_count - 1].estimated_bytes += s_sample_weight(samples[i].size);
+    }
+
+    qsort(stacks, stack_count, sizeof(struct sampled_stack), s_compare_stacks_by_bytes);
+
+    for (size_t i = 0; i < stack_count && i < DUMP_MAX_STACKS; ++i) {
+        const struct memory_sample *sample = stacks[i].first;
+        AWS_LOGF_INFO(
+            AWS_LS_JAVA_CRT_GENERAL,
+            "About %" PRIu64 " bytes (%zu samples) allocated by %s from:",
+            stacks[i].estimated_bytes,
+            stacks[i].samples,
+            s_subsystem_names[sample->subsystem]);
+
+        if (sample->frame_count <= SAMPLE_SKIPPED_FRAMES) {
+            continue;
+        }
+        size_t frame_count = sample->frame_count - SAMPLE_SKIPPED_FRAMES;
+        char **symbols = aws_backtrace_symbols(&sample->frames[SAMPLE_SKIPPED_FRAMES], frame_count);
+        for (size_t frame = 0; frame < frame_count; ++frame) {
+            if (symbols != NULL) {
+                AWS_LOGF_INFO(AWS_LS_JAVA_CRT_GENERAL, "    %s", symbols[frame]);
+            } else {
+                AWS_LOGF_INFO(AWS_LS_JAVA_CRT_GENERAL, "    %p", sample->frames[SAMPLE_SKIPPED_FRAMES + frame]);
+            }
+        }
+        /* aws_backtrace_symbols() mallocs the whole array in one block */
+        free(symbols);
+    }
+
+    aws_mem_release(allocator, stacks);
+    aws_mem_release(allocator, samples);
+}
@@ -0,0 +1,39 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_MEMORY_SAMPLER_H
+#define AWS_JNI_CRT_MEMORY_SAMPLER_H
+
+#include <aws/common/common.h>
+
+/*
+ * Sampling profiler for native memory, cheap enough to leave running in production. Instead of recording every
+ * allocation like the memory tracer, it records about one allocation, with its stack, for each sample interval's
+ * worth of bytes allocated on a thread. Each live sample stands for roughly an interval's worth of live memory, so
+ * a dump estimates which code paths are holding native memory without tracking every block.
+ *
+ * Driven by the accounting allocators in crt.c, which flag sampled blocks in their header so only sampled blocks
+ * pay for a lookup when released.
+ */
+
+/* sample_interval is the mean number of bytes allocated between samples, 0 leaves sampling off */
+void aws_jni_memory_sampler_init(size_t sample_interval);
+void aws_jni_memory_sampler_clean_up(void);
+bool aws_jni_memory_sampler_is_enabled(void);
+
+/* Called for every allocation on the calling thread, returns true if this one should be sampled */
+bool aws_jni_memory_sampler_should_sample(size_t size);
+
+/* Records a sampled allocation, and forgets it again once released */
+void aws_jni_memory_sampler_record(void *ptr, size_t size, int subsystem);
+void aws_jni_memory_sampler_forget(void *ptr);
+
+/* Estimated bytes of live native memory, extrapolated from the live samples */
+uint64_t aws_jni_memory_sampler_estimated_bytes(void);
+
+/* Logs the live samples grouped by allocation stack, biggest estimated owners first */
+void aws_jni_memory_sampler_dump(void);
+
+#endif /* AWS_JNI_CRT_MEMORY_SAMPLER_H */
@@ -2,6 +2,9 @@
  * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
  * SPDX-License-Identifier: Apache-2.0.
  */
+#include <aws/common/atomics.h>
+#include <aws/common/clock.h>
+#include <aws/common/mutex.h>
 #include <aws/mqtt/v5/mqtt5_client.h>
 
 #include <aws/http/proxy.h>
@@ -13,7 +16,12 @@
 #include <http_request_utils.h>
 #include <java_class_ids.h>
 #include <jni.h>
+#include <latency_histogram.h>
+#include <mqtt5_offline_queue.h>
 #include <mqtt5_packets.h>
+#include <mqtt5_topic_router.h>
+#include <tls_handshake_metrics.h>
+#include <tracing.h>
 
 /* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
 #if UINTPTR_MAX == 0xffffffff
@@ -31,6 +39,40 @@
  * CLIENT ONLY STRUCTS
  ******************************************************************************/
 
+/*
+ * Counters behind Mqtt5Client.getExtendedStatistics(). Updated from the client's callbacks, which all run on its
+ * event loop, and read from any thread. The histograms are atomic; the counters are 64-bit on every platform, so
+ * they sit behind a lock, which is never contended except while a snapshot is being taken.
+ */
+struct aws_mqtt5_client_java_statistics {
+    /* submit until written to the socket, which for QoS 0 is all the time spent queued */
+    struct aws_jni_latency_histogram qos0_publish_latency;
+    /* submit until PUBACK */
+    struct aws_jni_latency_histogram qos1_publish_latency;
+
+    struct aws_mutex lock;
+    uint64_t publishes_completed;
+    uint64_t publishes_failed;
+    uint64_t payload_bytes_published;
+    uint64_t messages_received;
+    uint64_t payload_bytes_received;
+
+    uint64_t connection_successes;
+    uint64_t connection_failures;
+    uint64_t disconnections;
+    /* 0 while connected (or before the first attempt), otherwise when the client last lost or failed to connect */
+    uint64_t disconnected_since_ns;
+    /* completed stretches of being disconnected */
+    uint64_t disconnected_total_ns;
+};
+
+/* Enough about a publish to record it in the statistics when it completes */
+struct aws_mqtt5_client_java_publish_timing {
+    uint64_t submit_ns;
+    uint64_t payload_size;
+    enum aws_mqtt5_qos qos;
+};
+
 struct aws_mqtt5_client_java_jni {
     struct aws_mqtt5_client *client;
     jobject jni_client;
@@ -41,11 +83,50 @@ struct aws_mqtt5_client_java_jni {
 
     jobject jni_publish_events;
     jobject jni_lifecycle_events;
+
+    /* Deliver received messages through Mqtt5Client.onLazyPublishReceived instead of building a PublishPacket */
+    bool lazy_publish_packets;
+    /* Reused to encode each message's optional properties, only touched from the client's event loop */
+    struct aws_byte_buf lazy_publish_properties;
+
+    /* Topic filters routed to Java handlers by Mqtt5Client.addTopicHandler() */
+    struct aws_jni_topic_router *topic_router;
+    /* Reused to collect the handlers (int64_t) each message matches, only touched from the client's event loop */
+    struct aws_array_list routed_handler_ids;
+
+    /* Holds publishes made while disconnected when offline queue limits are set, NULL otherwise */
+    struct aws_jni_offline_queue *offline_queue;
+
+    struct aws_mqtt5_client_java_statistics statistics;
 };
 
 struct aws_mqtt5_client_publish_return_data {
     struct aws_mqtt5_client_java_jni *java_client;
     jobject jni_publish_future;
+    struct aws_mqtt5_client_java_publish_timing timing;
+};
+
+/*
+ * One per publishBatch() call. The publishes complete independently, each writing its own slot of results, and
+ * whichever finishes last completes the single Java future for the whole batch.
+ */
+struct aws_mqtt5_client_publish_batch_data {
+    struct aws_mqtt5_client_java_jni *java_client;
+    jobject jni_batch_future;
+
+    /* publishes still in flight, plus one held by the submitting call until every publish has been handed off */
+    struct aws_atomic_var pending;
+    size_t count;
+
+    /* [error code, PUBACK reason code] for each publish, in submission order */
+    int32_t *results;
+    struct aws_mqtt5_client_publish_batch_entry *entries;
+};
+
+struct aws_mqtt5_client_publish_batch_entry {
+    struct aws_mqtt5_client_publish_batch_data *batch;
+    size_t index;
+    struct aws_mqtt5_client_java_publish_timing timing;
 };
 
 struct aws_mqtt5_client_subscribe_return_data {
@@ -191,7 +272,7 @@ static struct aws_http_proxy_options_java_jni *s_aws_mqtt5_http_proxy_options_cr
 
         struct aws_tls_ctx *tls_ctx = (struct aws_tls_ctx *)jni_proxy_tls_context_long;
         if (tls_ctx) {
-            aws_tls_connection_options_init_from_ctx(&java_client->http_proxy_tls_options, tls_ctx);
+            aws_jni_tls_connection_options_init_from_ctx(&java_client->http_proxy_tls_options, tls_ctx);
             aws_tls_connection_options_set_server_name(
                 &java_client->http_proxy_tls_options, allocator, &http_options->options.host);
             http_options->options.tls_options = &java_client->http_proxy_tls_options;
@@ -270,6 +351,11 @@ static void aws_mqtt5_client_java_destroy(
 
     aws_tls_connection_options_clean_up(&java_client->tls_options);
     aws_tls_connection_options_clean_up(&java_client->http_proxy_tls_options);
+    aws_byte_buf_clean_up(&java_client->lazy_publish_properties);
+    aws_jni_topic_router_destroy(java_client->topic_router);
+    aws_array_list_clean_up(&java_client->routed_handler_ids);
+    aws_jni_offline_queue_destroy(java_client->offline_queue);
+    aws_mutex_clean_up(&java_client->statistics.lock);
 
     /* Frees allocated memory */
     aws_mem_release(allocator, java_client);
@@ -1061,6 +1147,231 @@ static void s_aws_count_allocation(const void *pointer, size_t *counter) {
 
 static char s_client_string[] = "MQTT5 Client";
 
+/*******************************************************************************
+ * STATISTICS FUNCTIONS
+ ******************************************************************************/
+
+static uint64_t s_now_ns(void) {
+    uint64_t now = 0;
+    aws_high_res_clock_get_ticks(&now);
+    return now;
+}
+
+static void s_aws_mqtt5_client_java_statistics_init(struct aws_mqtt5_client_java_statistics *statistics) {
+    aws_jni_latency_histogram_init(&statistics->qos0_publish_latency);
+    aws_jni_latency_histogram_init(&statistics->qos1_publish_latency);
+    aws_mutex_init(&statistics->lock);
+}
+
+static void s_aws_mqtt5_client_java_publish_timing_init(
+    struct aws_mqtt5_client_java_publish_timing *timing,
+    const struct aws_mqtt5_packet_publish_view *publish) {
+    timing->submit_ns = s_now_ns();
+    timing->payload_size = publish->payload.len;
+    timing->qos = publish->qos;
+}
+
+static void s_aws_mqtt5_client_java_record_publish_completion(
+    struct aws_mqtt5_client_java_jni *java_client,
+    const struct aws_mqtt5_client_java_publish_timing *timing,
+    int error_code) {
+
+    struct aws_mqtt5_client_java_statistics *statistics = &java_client->statistics;
+    if (error_code == AWS_ERROR_SUCCESS) {
+        uint64_t now = s_now_ns();
+        uint64_t latency_ns = now > timing->submit_ns ? now - timing->submit_ns : 0;
+        aws_jni_latency_histogram_record_ns(
+            timing->qos == AWS_MQTT5_QOS_AT_MOST_ONCE ? &statistics->qos0_publish_latency
+                                                      : &statistics->qos1_publish_latency,
+            latency_ns);
+    }
+
+    aws_mutex_lock(&statistics->lock);
+    if (error_code == AWS_ERROR_SUCCESS) {
+        statistics->publishes_completed++;
+        statistics->payload_bytes_published += timing->payload_size;
+    } else {
+        statistics->publishes_failed++;
+    }
+    aws_mutex_unlock(&statistics->lock);
+}
+
+static void s_aws_mqtt5_client_java_record_publish_received(
+    struct aws_mqtt5_client_java_jni *java_client,
+    const struct aws_mqtt5_packet_publish_view *publish) {
+
+    struct aws_mqtt5_client_java_statistics *statistics = &java_client->statistics;
+    aws_mutex_lock(&statistics->lock);
+    statistics->messages_received++;
+    statistics->payload_bytes_received += publish->payload.len;
+    aws_mutex_unlock(&statistics->lock);
+}
+
+static void s_aws_mqtt5_client_java_record_lifecycle_event(
+    struct aws_mqtt5_client_java_jni *java_client,
+    enum aws_mqtt5_client_lifecycle_event_type event_type) {
+
+    struct aws_mqtt5_client_java_statistics *statistics = &java_client->statistics;
+    uint64_t now = s_now_ns();
+
+    aws_mutex_lock(&statistics->lock);
+    switch (event_type) {
+        case AWS_MQTT5_CLET_CONNECTION_SUCCESS:
+            statistics->connection_successes++;
+            if (statistics->disconnected_since_ns != 0) {
+                statistics->disconnected_total_ns += now - statistics->disconnected_since_ns;
+                statistics->disconnected_since_ns = 0;
+            }
+            break;
+        case AWS_MQTT5_CLET_CONNECTION_FAILURE:
+            statistics->connection_failures++;
+            /* only the first failure in a row starts the clock */
+            if (statistics->disconnected_since_ns == 0) {
+                statistics->disconnected_since_ns = now;
+            }
+            break;
+        case AWS_MQTT5_CLET_DISCONNECTION:
+            statistics->disconnections++;
+            statistics->disconnected_since_ns = now;
+            break;
+        default:
+            break;
+    }
+    aws_mutex_unlock(&statistics->lock);
+}
+
+/*******************************************************************************
+ * OFFLINE QUEUE FUNCTIONS
+ ******************************************************************************/
+
+/* Creates the client's offline queue if the options set any of its limits or a spill file, throwing on failure */
+static int s_aws_mqtt5_client_java_init_offline_queue(
+    JNIEnv *env,
+    struct aws_allocator *allocator,
+    struct aws_mqtt5_client_java_jni *java_client,
+    jobject jni_options) {
+
+    struct aws_jni_offline_queue_options queue_options;
+    AWS_ZERO_STRUCT(queue_options);
+
+    uint64_t max_messages = 0;
+    uint64_t *pointer_max_messages = NULL;
+    if (aws_get_uint64_from_jobject(
+            env,
+            jni_options,
+            mqtt5_client_options_properties.offline_queue_max_messages_field_id,
+            s_client_string,
+            "offline queue maximum messages",
+            &max_messages,
+            &pointer_max_messages,
+            true) != AWS_OP_SUCCESS) {
+        return AWS_OP_ERR;
+    }
+
+    uint64_t max_bytes = 0;
+    uint64_t *pointer_max_bytes = NULL;
+    if (aws_get_uint64_from_jobject(
+            env,
+            jni_options,
+            mqtt5_client_options_properties.offline_queue_max_bytes_field_id,
+            s_client_string,
+            "offline queue maximum bytes",
+            &max_bytes,
+            &pointer_max_bytes,
+            true) != AWS_OP_SUCCESS) {
+        return AWS_OP_ERR;
+    }
+
+    uint32_t overflow_policy = UINT32_MAX;
+    if (aws_get_enum_from_jobject(
+            env,
+            jni_options,
+            mqtt5_client_options_properties.options_get_offline_queue_overflow_policy_id,
+            s_client_string,
+            "offline queue overflow policy",
+            mqtt5_client_offline_queue_overflow_policy_properties.client_get_value_id,
+            &overflow_policy,
+            true) == AWS_OP_ERR) {
+        return AWS_OP_ERR;
+    }
+
+    jstring jni_spill_path = (jstring)(*env)->GetObjectField(
+        env, jni_options, mqtt5_client_options_properties.offline_queue_spill_path_field_id);
+    if (aws_jni_check_and_clear_exception(env)) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "MQTT5 client new: error getting offline queue spill path", AWS_ERROR_INVALID_STATE);
+        return AWS_OP_ERR;
+    }
+
+    if (pointer_max_messages == NULL && pointer_max_bytes == NULL && jni_spill_path == NULL) {
+        return AWS_OP_SUCCESS;
+    }
+
+    queue_options.max_messages = (size_t)AWS_MIN(max_messages, SIZE_MAX);
+    queue_options.max_bytes = max_bytes;
+    if (overflow_policy != UINT32_MAX) {
+        queue_options.overflow_policy = (enum aws_jni_offline_queue_overflow_policy)overflow_policy;
+    }
+    struct aws_string *spill_path = NULL;
+    if (jni_spill_path != NULL) {
+        spill_path = aws_jni_new_string_from_jstring(env, jni_spill_path);
+        if (spill_path == NULL) {
+            s_aws_mqtt5_client_log_and_throw_exception(
+                env, "MQTT5 client new: invalid offline queue spill path", AWS_ERROR_INVALID_ARGUMENT);
+            return AWS_OP_ERR;
+        }
+        queue_options.spill_path = spill_path;
+    }
+
+    java_client->offline_queue = aws_jni_offline_queue_new(allocator, &queue_options);
+    aws_string_destroy(spill_path);
+    if (java_client->offline_queue == NULL) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "MQTT5 client new: could not open the offline queue spill file", aws_last_error());
+        return AWS_OP_ERR;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Hands a publish to the native client, or to the offline queue while the client is disconnected. The queue's
+ * overflow policy may drop messages, this one included, whose completions are appended to failures for the caller
+ * to call once it's done with the publish.
+ */
+static int s_aws_mqtt5_client_java_submit_publish(
+    struct aws_mqtt5_client_java_jni *java_client,
+    const struct aws_mqtt5_packet_publish_view *publish,
+    const struct aws_mqtt5_publish_completion_options *completion_options,
+    struct aws_array_list *failures) {
+
+    if (java_client->offline_queue != NULL &&
+        aws_jni_offline_queue_push(java_client->offline_queue, publish, completion_options, failures)) {
+        return AWS_OP_SUCCESS;
+    }
+    return aws_mqtt5_client_publish(java_client->client, publish, completion_options);
+}
+
+static void s_aws_mqtt5_client_java_update_offline_queue(
+    struct aws_mqtt5_client_java_jni *java_client,
+    enum aws_mqtt5_client_lifecycle_event_type event_type) {
+
+    if (java_client->offline_queue == NULL) {
+        return;
+    }
+
+    if (event_type == AWS_MQTT5_CLET_CONNECTION_SUCCESS) {
+        struct aws_array_list failures;
+        aws_array_list_init_dynamic(
+            &failures, aws_jni_mqtt_allocator(), 0, sizeof(struct aws_jni_offline_queue_failure));
+        aws_jni_offline_queue_set_online(java_client->offline_queue, java_client->client, &failures);
+        aws_jni_offline_queue_complete_failures(&failures);
+        aws_array_list_clean_up(&failures);
+    } else if (event_type == AWS_MQTT5_CLET_DISCONNECTION) {
+        aws_jni_offline_queue_set_offline(java_client->offline_queue);
+    }
+}
+
 /*******************************************************************************
  * MQTT5 CALLBACK FUNCTIONS
  ******************************************************************************/
@@ -1073,6 +1384,9 @@ static void s_aws_mqtt5_client_java_lifecycle_event(const struct aws_mqtt5_clien
         return;
     }
 
+    s_aws_mqtt5_client_java_record_lifecycle_event(java_client, event->event_type);
+    s_aws_mqtt5_client_java_update_offline_queue(java_client, event->event_type);
+
     /********** JNI ENV ACQUIRE **********/
     JavaVM *jvm = java_client->jvm;
     JNIEnv *env = aws_jni_acquire_thread_env(jvm);
@@ -1281,9 +1595,165 @@ clean_up:
     aws_jni_release_thread_env(jvm, env);
 }
 
+/* Optional property flags, must match PublishPacket.fromReceived() */
+#define LAZY_PUBLISH_PAYLOAD_FORMAT 1
+#define LAZY_PUBLISH_MESSAGE_EXPIRY_INTERVAL (1 << 1)
+#define LAZY_PUBLISH_RESPONSE_TOPIC (1 << 2)
+#define LAZY_PUBLISH_CORRELATION_DATA (1 << 3)
+#define LAZY_PUBLISH_CONTENT_TYPE (1 << 4)
+
+static bool s_lazy_publish_has_properties(const struct aws_mqtt5_packet_publish_view *publish) {
+    return publish->payload_format != NULL || publish->message_expiry_interval_seconds != NULL ||
+           publish->response_topic != NULL || publish->correlation_data != NULL || publish->content_type != NULL ||
+           publish->subscription_identifier_count > 0 || publish->user_property_count > 0;
+}
+
+static void s_write_length_prefixed(struct aws_byte_buf *buf, struct aws_byte_cursor cursor) {
+    aws_byte_buf_write_be32(buf, (uint32_t)cursor.len);
+    aws_byte_buf_write_from_whole_cursor(buf, cursor);
+}
+
+/* Encodes the optional properties in the layout documented on PublishPacket.fromReceived() */
+static int s_encode_lazy_publish_properties(
+    struct aws_byte_buf *buf,
+    const struct aws_mqtt5_packet_publish_view *publish) {
+
+    size_t needed = 4 + 4 + 4 + 4 + 4 * publish->subscription_identifier_count + 4;
+    uint32_t flags = 0;
+    if (publish->payload_format != NULL) {
+        flags |= LAZY_PUBLISH_PAYLOAD_FORMAT;
+        needed += 4;
+    }
+    if (publish->message_expiry_interval_seconds != NULL) {
+        flags |= LAZY_PUBLISH_MESSAGE_EXPIRY_INTERVAL;
+        needed += 4;
+    }
+    if (publish->response_topic != NULL) {
+        flags |= LAZY_PUBLISH_RESPONSE_TOPIC;
+        needed += 4 + publish->response_topic->len;
+    }
+    if (publish->correlation_data != NULL) {
+        flags |= LAZY_PUBLISH_CORRELATION_DATA;
+        needed += 4 + publish->correlation_data->len;
+    }
+    if (publish->content_type != NULL) {
+        flags |= LAZY_PUBLISH_CONTENT_TYPE;
+        needed += 4 + publish->content_type->len;
+    }
+    for (size_t i = 0; i < publish->user_property_count; ++i) {
+        needed += 4 + publish->user_properties[i].name.len + 4 + publish->user_properties[i].value.len;
+    }
+
+    aws_byte_buf_reset(buf, false);
+    if (aws_byte_buf_reserve(buf, needed)) {
+        return AWS_OP_ERR;
+    }
+
+    aws_byte_buf_write_be32(buf, flags);
+    if (publish->payload_format != NULL) {
+        aws_byte_buf_write_be32(buf, (uint32_t)*publish->payload_format);
+    }
+    if (publish->message_expiry_interval_seconds != NULL) {
+        aws_byte_buf_write_be32(buf, *publish->message_expiry_interval_seconds);
+    }
+    if (publish->response_topic != NULL) {
+        s_write_length_prefixed(buf, *publish->response_topic);
+    }
+    if (publish->correlation_data != NULL) {
+        s_write_length_prefixed(buf, *publish->correlation_data);
+    }
+    if (publish->content_type != NULL) {
+        s_write_length_prefixed(buf, *publish->content_type);
+    }
+
+    aws_byte_buf_write_be32(buf, (uint32_t)publish->subscription_identifier_count);
+    for (size_t i = 0; i < publish->subscription_identifier_count; ++i) {
+        aws_byte_buf_write_be32(buf, publish->subscription_identifiers[i]);
+    }
+
+    aws_byte_buf_write_be32(buf, (uint32_t)publish->user_property_count);
+    for (size_t i = 0; i < publish->user_property_count; ++i) {
+        s_write_length_prefixed(buf, publish->user_properties[i].name);
+        s_write_length_prefixed(buf, publish->user_properties[i].value);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Lazy delivery: only the topic, a direct buffer over the payload and, if there are any, the encoded optional
+ * properties go up to Java, which builds the PublishPacket from them only if it's asked for.
+ */
+/* The handlers a routed message matched, as a long[] for Mqtt5Client to look up */
+static jlongArray s_aws_mqtt5_client_routed_handler_ids_to_jni(
+    JNIEnv *env,
+    const struct aws_array_list *handler_ids) {
+
+    jsize count = (jsize)aws_array_list_length(handler_ids);
+    jlongArray jni_handler_ids = (*env)->NewLongArray(env, count);
+    if (jni_handler_ids == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "publishReceived function: could not create routed handler ids");
+        return NULL;
+    }
+    (*env)->SetLongArrayRegion(env, jni_handler_ids, 0, count, (const jlong *)handler_ids->data);
+    return jni_handler_ids;
+}
+
+static void s_aws_mqtt5_client_java_lazy_publish_received(
+    JNIEnv *env,
+    struct aws_mqtt5_client_java_jni *java_client,
+    const struct aws_mqtt5_packet_publish_view *publish,
+    const struct aws_array_list *handler_ids) {
+
+    /* handler ids, topic, payload and properties */
+    if ((*env)->PushLocalFrame(env, 4) != 0) {
+        aws_jni_check_and_clear_exception(env);
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "publishReceived function: could not push local JNI frame");
+        return;
+    }
+
+    jstring jni_topic = aws_jni_string_from_cursor(env, &publish->topic);
+
+    /* NewDirectByteBuffer needs an address even when there's nothing there */
+    static uint8_t s_empty_payload = 0;
+    void *payload_ptr = publish->payload.len > 0 ? publish->payload.ptr : &s_empty_payload;
+    jobject jni_payload = aws_jni_direct_byte_buffer_from_raw_ptr(env, payload_ptr, publish->payload.len);
+
+    jbyteArray jni_properties = NULL;
+    if (s_lazy_publish_has_properties(publish)) {
+        if (s_encode_lazy_publish_properties(&java_client->lazy_publish_properties, publish) == AWS_OP_SUCCESS) {
+            struct aws_byte_cursor properties = aws_byte_cursor_from_buf(&java_client->lazy_publish_properties);
+            jni_properties = aws_jni_byte_array_from_cursor(env, &properties);
+        }
+    }
+
+    jlongArray jni_handler_ids = NULL;
+    if (handler_ids != NULL) {
+        jni_handler_ids = s_aws_mqtt5_client_routed_handler_ids_to_jni(env, handler_ids);
+    }
+
+    if (jni_topic != NULL && jni_payload != NULL && (handler_ids == NULL || jni_handler_ids != NULL)) {
+        (*env)->CallVoidMethod(
+            env,
+            java_client->jni_client,
+            mqtt5_client_properties.client_on_lazy_publish_received_id,
+            jni_handler_ids,
+            jni_topic,
+            jni_payload,
+            (jint)publish->qos,
+            (jboolean)publish->retain,
+            jni_properties);
+    }
+    aws_jni_check_and_clear_exception(env); // To hide JNI warning
+
+    (*env)->PopLocalFrame(env, NULL);
+}
+
 static void s_aws_mqtt5_client_java_publish_received(
     const struct aws_mqtt5_packet_publish_view *publish,
     void *user_data) {
+    AWS_JNI_TRACE_SPAN("mqtt5.publish_received", user_data);
 
     struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)user_data;
     if (!java_client) {
@@ -1296,6 +1766,23 @@ static void s_aws_mqtt5_client_java_publish_received(
         return;
     }
 
+    s_aws_mqtt5_client_java_record_publish_received(java_client, publish);
+
+    /* Once topic handlers are registered, a message goes only to the handlers whose filters it matches */
+    const struct aws_array_list *handler_ids = NULL;
+    if (!aws_jni_topic_router_is_empty(java_client->topic_router)) {
+        aws_array_list_clear(&java_client->routed_handler_ids);
+        aws_jni_topic_router_match(java_client->topic_router, publish->topic, &java_client->routed_handler_ids);
+        if (aws_array_list_length(&java_client->routed_handler_ids) > 0) {
+            handler_ids = &java_client->routed_handler_ids;
+        }
+    }
+
+    /* Nothing wants this message, so don't cross JNI for it at all */
+    if (handler_ids == NULL && java_client->jni_publish_events == NULL) {
+        return;
+    }
+
     /********** JNI ENV ACQUIRE **********/
     JavaVM *jvm = java_client->jvm;
     JNIEnv *env = aws_jni_acquire_thread_env(jvm);
@@ -1305,11 +1792,18 @@ static void s_aws_mqtt5_client_java_publish_received(
         return;
     }
 
+    if (java_client->lazy_publish_packets) {
+        s_aws_mqtt5_client_java_lazy_publish_received(env, java_client, publish, handler_ids);
+        /********** JNI ENV RELEASE **********/
+        aws_jni_release_thread_env(jvm, env);
+        return;
+    }
+
     /* Calculate the number of references needed */
     size_t references_needed = 0;
     {
-        /* One reference is needed for the PublishReturn */
-        references_needed += 1;
+        /* One reference is needed for the PublishReturn, and one for the routed handler ids */
+        references_needed += 2;
 
         /* A Publish packet will need 5 references at minimum */
         references_needed += 5;
@@ -1358,7 +1852,18 @@ static void s_aws_mqtt5_client_java_publish_received(
         publish_packet_data);
     aws_jni_check_and_clear_exception(env); // To hide JNI warning
 
-    if (java_client->jni_publish_events) {
+    if (handler_ids != NULL) {
+        jlongArray jni_handler_ids = s_aws_mqtt5_client_routed_handler_ids_to_jni(env, handler_ids);
+        if (jni_handler_ids != NULL) {
+            (*env)->CallVoidMethod(
+                env,
+                java_client->jni_client,
+                mqtt5_client_properties.client_on_routed_publish_received_id,
+                jni_handler_ids,
+                publish_packet_return_data);
+            aws_jni_check_and_clear_exception(env); // To hide JNI warning
+        }
+    } else if (java_client->jni_publish_events) {
         (*env)->CallObjectMethod(
             env,
             java_client->jni_publish_events,
@@ -1379,7 +1884,7 @@ clean_up:
 static void s_aws_mqtt5_client_java_publish_callback_destructor(
     JNIEnv *env,
     struct aws_mqtt5_client_publish_return_data *callback_return_data) {
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
 
     if (env != NULL) {
         (*env)->PopLocalFrame(env, NULL);
@@ -1414,6 +1919,8 @@ static void s_aws_mqtt5_client_java_publish_completion(
         goto clean_up;
     }
 
+    s_aws_mqtt5_client_java_record_publish_completion(java_client, &return_data->timing, error_code);
+
     /********** JNI ENV ACQUIRE **********/
     jvm = java_client->jvm;
     env = aws_jni_acquire_thread_env(jvm);
@@ -1518,10 +2025,77 @@ clean_up:
     return;
 }
 
+static void s_aws_mqtt5_client_java_publish_batch_destroy(struct aws_mqtt5_client_publish_batch_data *batch) {
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
+    aws_mem_release(allocator, batch->results);
+    aws_mem_release(allocator, batch->entries);
+    aws_mem_release(allocator, batch);
+}
+
+/* Hands the results of every publish in the batch to Java in one int[], and frees the batch */
+static void s_aws_mqtt5_client_java_publish_batch_complete(
+    JNIEnv *env,
+    struct aws_mqtt5_client_publish_batch_data *batch) {
+
+    jintArray jni_results = (*env)->NewIntArray(env, (jsize)(batch->count * 2));
+    if (jni_results == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        s_complete_future_with_exception(env, batch->jni_batch_future, AWS_ERROR_OOM);
+    } else {
+        (*env)->SetIntArrayRegion(env, jni_results, 0, (jsize)(batch->count * 2), (const jint *)batch->results);
+        (*env)->CallBooleanMethod(
+            env, batch->jni_batch_future, completable_future_properties.complete_method_id, jni_results);
+        if (aws_jni_check_and_clear_exception(env)) {
+            AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "PublishBatchCompletion function: exception when completing future");
+        }
+        (*env)->DeleteLocalRef(env, jni_results);
+    }
+
+    (*env)->DeleteGlobalRef(env, batch->jni_batch_future);
+    s_aws_mqtt5_client_java_publish_batch_destroy(batch);
+}
+
+static void s_aws_mqtt5_client_java_publish_batch_completion(
+    enum aws_mqtt5_packet_type packet_type,
+    const void *packet,
+    int error_code,
+    void *user_data) {
+
+    struct aws_mqtt5_client_publish_batch_entry *entry = user_data;
+    struct aws_mqtt5_client_publish_batch_data *batch = entry->batch;
+    s_aws_mqtt5_client_java_record_publish_completion(batch->java_client, &entry->timing, error_code);
+
+    int32_t reason_code = 0;
+    if (error_code == AWS_ERROR_SUCCESS && packet_type == AWS_MQTT5_PT_PUBACK && packet != NULL) {
+        reason_code = (int32_t)((const struct aws_mqtt5_packet_puback_view *)packet)->reason_code;
+    }
+    batch->results[entry->index * 2] = error_code;
+    batch->results[entry->index * 2 + 1] = reason_code;
+
+    if (aws_atomic_fetch_sub(&batch->pending, 1) != 1) {
+        return;
+    }
+
+    /********** JNI ENV ACQUIRE **********/
+    JavaVM *jvm = batch->java_client->jvm;
+    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        AWS_LOGF_ERROR(AWS_LS_MQTT_CLIENT, "PublishBatchCompletion function: could not get env");
+        s_aws_mqtt5_client_java_publish_batch_destroy(batch);
+        return;
+    }
+
+    s_aws_mqtt5_client_java_publish_batch_complete(env, batch);
+
+    /********** JNI ENV RELEASE **********/
+    aws_jni_release_thread_env(jvm, env);
+}
+
 static void s_aws_mqtt5_client_java_subscribe_callback_destructor(
     JNIEnv *env,
     struct aws_mqtt5_client_subscribe_return_data *callback_return_data) {
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
 
     if (env != NULL) {
         if (callback_return_data->jni_subscribe_future) {
@@ -1673,7 +2247,7 @@ clean_up:
 static void s_aws_mqtt5_client_java_unsubscribe_callback_destructor(
     JNIEnv *env,
     struct aws_mqtt5_client_unsubscribe_return_data *callback_return_data) {
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
 
     if (env != NULL) {
         if (callback_return_data->jni_unsubscribe_future) {
@@ -1835,9 +2409,18 @@ static void s_aws_mqtt5_client_java_termination(void *complete_ctx) {
         return;
     }
 
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
+    if (java_client->offline_queue != NULL) {
+        /* anything spilled stays in the spill file for the next client to publish */
+        struct aws_array_list failures;
+        aws_array_list_init_dynamic(&failures, allocator, 0, sizeof(struct aws_jni_offline_queue_failure));
+        aws_jni_offline_queue_clear(java_client->offline_queue, AWS_ERROR_MQTT5_CLIENT_TERMINATED, &failures);
+        aws_jni_offline_queue_complete_failures(&failures);
+        aws_array_list_clean_up(&failures);
+    }
+
     (*env)->CallVoidMethod(env, java_client->jni_client, crt_resource_properties.release_references);
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
     aws_mqtt5_client_java_destroy(env, allocator, java_client);
 
     /********** JNI ENV RELEASE **********/
@@ -1880,7 +2463,7 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5Cl
     jobject jni_disconnect_packet) {
     (void)jni_class;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
     struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)jni_client;
     if (!java_client) {
         s_aws_mqtt5_client_log_and_throw_exception(
@@ -1919,13 +2502,17 @@ clean_up:
     return;
 }
 
-JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalPublish(
+/*
+ * Shared by both publish entry points. When direct_payload is set it is published in place of the packet's
+ * payload: aws_mqtt5_client_publish() copies it into the operation's own storage before returning, so it only has
+ * to stay valid for the duration of this call.
+ */
+static void s_aws_mqtt5_client_java_publish(
     JNIEnv *env,
-    jclass jni_class,
     jlong jni_client,
     jobject jni_publish_packet,
+    const struct aws_byte_cursor *direct_payload,
     jobject jni_publish_future) {
-    (void)jni_class;
 
     struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)jni_client;
     if (!java_client) {
@@ -1949,7 +2536,8 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5Cl
         return;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
+    int future_error_code = AWS_ERROR_MQTT5_OPERATION_PROCESSING_FAILURE;
 
     /* Cannot fail */
     struct aws_mqtt5_client_publish_return_data *return_data =
@@ -1960,6 +2548,10 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5Cl
     completion_options.completion_callback = &s_aws_mqtt5_client_java_publish_completion;
     completion_options.completion_user_data = (void *)return_data;
 
+    /* publishes the offline queue drops to make room for this one, or this one itself */
+    struct aws_array_list failures;
+    aws_array_list_init_dynamic(&failures, allocator, 0, sizeof(struct aws_jni_offline_queue_failure));
+
     struct aws_mqtt5_packet_publish_view_java_jni *java_publish_packet =
         aws_mqtt5_packet_publish_view_create_from_java(env, allocator, jni_publish_packet);
     if (!java_publish_packet) {
@@ -1967,24 +2559,166 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5Cl
             env, "Mqtt5Client.publish: Could not create publish packet", AWS_ERROR_INVALID_STATE);
         goto exception;
     }
+    if (direct_payload != NULL) {
+        aws_mqtt5_packet_publish_view_get_packet(java_publish_packet)->payload = *direct_payload;
+    }
+    s_aws_mqtt5_client_java_publish_timing_init(
+        &return_data->timing, aws_mqtt5_packet_publish_view_get_packet(java_publish_packet));
 
     return_data->jni_publish_future = (*env)->NewGlobalRef(env, jni_publish_future);
-    int return_result = aws_mqtt5_client_publish(
-        java_client->client, aws_mqtt5_packet_publish_view_get_packet(java_publish_packet), &completion_options);
+    int return_result = s_aws_mqtt5_client_java_submit_publish(
+        java_client, aws_mqtt5_packet_publish_view_get_packet(java_publish_packet), &completion_options, &failures);
     if (return_result != AWS_OP_SUCCESS) {
-        s_aws_mqtt5_client_log_and_throw_exception(env, "Mqtt5Client.publish: Unsuccessful publish", return_result);
+        /*
+         * Publish is a high-rate call, so this failure is reported through the future alone, with the real error
+         * code, rather than by also throwing.
+         */
+        future_error_code = aws_last_error();
+        AWS_LOGF_ERROR(
+            AWS_LS_MQTT_CLIENT, "Mqtt5Client.publish: Unsuccessful publish - error code: %i", future_error_code);
         goto exception;
     }
     goto clean_up;
 
 exception:
-    s_complete_future_with_exception(env, jni_publish_future, AWS_ERROR_MQTT5_OPERATION_PROCESSING_FAILURE);
+    s_complete_future_with_exception(env, jni_publish_future, future_error_code);
     aws_mqtt5_packet_publish_view_java_destroy(env, allocator, java_publish_packet);
     s_aws_mqtt5_client_java_publish_callback_destructor(env, return_data);
+    aws_array_list_clean_up(&failures);
     return;
 
 clean_up:
     aws_mqtt5_packet_publish_view_java_destroy(env, allocator, java_publish_packet);
+    /* this publish may be among them, so its return data can't be touched after this */
+    aws_jni_offline_queue_complete_failures(&failures);
+    aws_array_list_clean_up(&failures);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalPublish(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_client,
+    jobject jni_publish_packet,
+    jobject jni_publish_future) {
+    (void)jni_class;
+
+    s_aws_mqtt5_client_java_publish(env, jni_client, jni_publish_packet, NULL, jni_publish_future);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalPublishDirect(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_client,
+    jobject jni_publish_packet,
+    jobject jni_payload,
+    jint position,
+    jint length,
+    jobject jni_publish_future) {
+    (void)jni_class;
+
+    if (jni_payload == NULL) {
+        aws_jni_throw_null_pointer_exception(env, "Mqtt5Client.publish: payload buffer is null");
+        return;
+    }
+
+    uint8_t *address = (*env)->GetDirectBufferAddress(env, jni_payload);
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, jni_payload);
+    if (address == NULL || capacity < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "Mqtt5Client.publish: payload buffer is not direct");
+        return;
+    }
+    if (position < 0 || length < 0 || (jlong)position + (jlong)length > capacity) {
+        aws_jni_throw_illegal_argument_exception(env, "Mqtt5Client.publish: payload range is out of bounds");
+        return;
+    }
+
+    struct aws_byte_cursor payload = aws_byte_cursor_from_array(address + position, (size_t)length);
+    s_aws_mqtt5_client_java_publish(env, jni_client, jni_publish_packet, &payload, jni_publish_future);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalPublishBatch(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_client,
+    jobjectArray jni_publish_packets,
+    jobject jni_batch_future) {
+    (void)jni_class;
+
+    struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)jni_client;
+    if (!java_client || !java_client->client) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishBatch: Invalid/null client", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+    if (!jni_publish_packets || !jni_batch_future) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.publishBatch: Invalid/null publish packets or future", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
+    size_t count = (size_t)(*env)->GetArrayLength(env, jni_publish_packets);
+
+    /* Cannot fail */
+    struct aws_mqtt5_client_publish_batch_data *batch =
+        aws_mem_calloc(allocator, 1, sizeof(struct aws_mqtt5_client_publish_batch_data));
+    batch->java_client = java_client;
+    batch->jni_batch_future = (*env)->NewGlobalRef(env, jni_batch_future);
+    batch->count = count;
+    batch->results = aws_mem_calloc(allocator, AWS_MAX(count, 1) * 2, sizeof(int32_t));
+    batch->entries = aws_mem_calloc(allocator, AWS_MAX(count, 1), sizeof(struct aws_mqtt5_client_publish_batch_entry));
+    aws_atomic_init_int(&batch->pending, count + 1);
+
+    /* publishes the offline queue drops, completed once every publish has been handed off */
+    struct aws_array_list failures;
+    aws_array_list_init_dynamic(&failures, allocator, 0, sizeof(struct aws_jni_offline_queue_failure));
+
+    for (size_t i = 0; i < count; ++i) {
+        struct aws_mqtt5_client_publish_batch_entry *entry = &batch->entries[i];
+        entry->batch = batch;
+        entry->index = i;
+
+        int error_code = AWS_ERROR_SUCCESS;
+        jobject jni_publish_packet = (*env)->GetObjectArrayElement(env, jni_publish_packets, (jsize)i);
+        struct aws_mqtt5_packet_publish_view_java_jni *java_publish_packet =
+            jni_publish_packet != NULL
+                ? aws_mqtt5_packet_publish_view_create_from_java(env, allocator, jni_publish_packet)
+                : NULL;
+        if (java_publish_packet == NULL) {
+            /* A bad packet fails its own slot rather than the whole batch */
+            aws_jni_check_and_clear_exception(env);
+            error_code = AWS_ERROR_INVALID_ARGUMENT;
+        } else {
+            s_aws_mqtt5_client_java_publish_timing_init(
+                &entry->timing, aws_mqtt5_packet_publish_view_get_packet(java_publish_packet));
+            struct aws_mqtt5_publish_completion_options completion_options = {
+                .completion_callback = &s_aws_mqtt5_client_java_publish_batch_completion,
+                .completion_user_data = entry,
+            };
+            if (s_aws_mqtt5_client_java_submit_publish(
+                    java_client,
+                    aws_mqtt5_packet_publish_view_get_packet(java_publish_packet),
+                    &completion_options,
+                    &failures) != AWS_OP_SUCCESS) {
+                error_code = aws_last_error();
+            }
+            aws_mqtt5_packet_publish_view_java_destroy(env, allocator, java_publish_packet);
+        }
+        (*env)->DeleteLocalRef(env, jni_publish_packet);
+
+        if (error_code != AWS_ERROR_SUCCESS) {
+            /* never handed to the client, so it won't complete on its own */
+            batch->results[i * 2] = error_code;
+            aws_atomic_fetch_sub(&batch->pending, 1);
+        }
+    }
+
+    aws_jni_offline_queue_complete_failures(&failures);
+    aws_array_list_clean_up(&failures);
+
+    if (aws_atomic_fetch_sub(&batch->pending, 1) == 1) {
+        s_aws_mqtt5_client_java_publish_batch_complete(env, batch);
+    }
 }
 
 JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalSubscribe(
@@ -2017,7 +2751,7 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5Cl
         return;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
     /* Cannot fail */
     struct aws_mqtt5_client_subscribe_return_data *return_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_mqtt5_client_subscribe_return_data));
@@ -2084,7 +2818,7 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5Cl
         return;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
     /* Cannot fail */
     struct aws_mqtt5_client_unsubscribe_return_data *return_data =
         aws_mem_calloc(allocator, 1, sizeof(struct aws_mqtt5_client_unsubscribe_return_data));
@@ -2124,6 +2858,139 @@ clean_up:
     aws_mqtt5_packet_unsubscribe_view_java_destroy(env, allocator, java_unsubscribe_packet);
 }
 
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalAddTopicRoute(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_client,
+    jstring jni_topic_filter,
+    jlong handler_id) {
+    (void)jni_class;
+
+    struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)jni_client;
+    if (!java_client || !java_client->topic_router) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.addTopicHandler: Invalid/null client", AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+
+    struct aws_byte_cursor topic_filter = aws_jni_byte_cursor_from_jstring_acquire(env, jni_topic_filter);
+    if (topic_filter.ptr == NULL) {
+        /* exception already pending */
+        return;
+    }
+
+    if (aws_jni_topic_router_insert(java_client->topic_router, topic_filter, (int64_t)handler_id)) {
+        aws_jni_throw_illegal_argument_exception(env, "Mqtt5Client.addTopicHandler: invalid topic filter");
+    }
+
+    aws_jni_byte_cursor_from_jstring_release(env, jni_topic_filter, topic_filter);
+}
+
+JNIEXPORT jboolean JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalRemoveTopicRoute(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_client,
+    jstring jni_topic_filter) {
+    (void)jni_class;
+
+    struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)jni_client;
+    if (!java_client || !java_client->topic_router) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.removeTopicHandler: Invalid/null client", AWS_ERROR_INVALID_ARGUMENT);
+        return false;
+    }
+
+    struct aws_byte_cursor topic_filter = aws_jni_byte_cursor_from_jstring_acquire(env, jni_topic_filter);
+    if (topic_filter.ptr == NULL) {
+        /* exception already pending */
+        return false;
+    }
+
+    bool removed = aws_jni_topic_router_remove(java_client->topic_router, topic_filter);
+
+    aws_jni_byte_cursor_from_jstring_release(env, jni_topic_filter, topic_filter);
+    return removed;
+}
+
+/* Layout of the long[] from mqtt5ClientInternalGetExtendedStatistics, must match Mqtt5ClientExtendedStatistics */
+enum aws_mqtt5_client_java_extended_statistic {
+    AWS_MQTT5_JAVA_STAT_TIMESTAMP_NS,
+    AWS_MQTT5_JAVA_STAT_PUBLISHES_COMPLETED,
+    AWS_MQTT5_JAVA_STAT_PUBLISHES_FAILED,
+    AWS_MQTT5_JAVA_STAT_PAYLOAD_BYTES_PUBLISHED,
+    AWS_MQTT5_JAVA_STAT_MESSAGES_RECEIVED,
+    AWS_MQTT5_JAVA_STAT_PAYLOAD_BYTES_RECEIVED,
+    AWS_MQTT5_JAVA_STAT_CONNECTION_SUCCESSES,
+    AWS_MQTT5_JAVA_STAT_CONNECTION_FAILURES,
+    AWS_MQTT5_JAVA_STAT_DISCONNECTIONS,
+    AWS_MQTT5_JAVA_STAT_DISCONNECTED_NS,
+    AWS_MQTT5_JAVA_STAT_OFFLINE_QUEUE_MESSAGES,
+    AWS_MQTT5_JAVA_STAT_OFFLINE_QUEUE_BYTES,
+    AWS_MQTT5_JAVA_STAT_OFFLINE_QUEUE_DROPPED,
+    AWS_MQTT5_JAVA_STAT_QOS0_LATENCY_HISTOGRAM,
+    AWS_MQTT5_JAVA_STAT_QOS1_LATENCY_HISTOGRAM =
+        AWS_MQTT5_JAVA_STAT_QOS0_LATENCY_HISTOGRAM + AWS_JNI_LATENCY_HISTOGRAM_BUCKETS,
+    AWS_MQTT5_JAVA_STAT_COUNT = AWS_MQTT5_JAVA_STAT_QOS1_LATENCY_HISTOGRAM + AWS_JNI_LATENCY_HISTOGRAM_BUCKETS,
+};
+
+JNIEXPORT jlongArray JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalGetExtendedStatistics(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_client) {
+    (void)jni_class;
+
+    struct aws_mqtt5_client_java_jni *java_client = (struct aws_mqtt5_client_java_jni *)jni_client;
+    if (!java_client) {
+        s_aws_mqtt5_client_log_and_throw_exception(
+            env, "Mqtt5Client.getExtendedStatistics: Invalid/null client", AWS_ERROR_INVALID_ARGUMENT);
+        return NULL;
+    }
+
+    int64_t values[AWS_MQTT5_JAVA_STAT_COUNT];
+    uint64_t now = s_now_ns();
+    struct aws_mqtt5_client_java_statistics *statistics = &java_client->statistics;
+
+    aws_mutex_lock(&statistics->lock);
+    values[AWS_MQTT5_JAVA_STAT_TIMESTAMP_NS] = (int64_t)now;
+    values[AWS_MQTT5_JAVA_STAT_PUBLISHES_COMPLETED] = (int64_t)statistics->publishes_completed;
+    values[AWS_MQTT5_JAVA_STAT_PUBLISHES_FAILED] = (int64_t)statistics->publishes_failed;
+    values[AWS_MQTT5_JAVA_STAT_PAYLOAD_BYTES_PUBLISHED] = (int64_t)statistics->payload_bytes_published;
+    values[AWS_MQTT5_JAVA_STAT_MESSAGES_RECEIVED] = (int64_t)statistics->messages_received;
+    values[AWS_MQTT5_JAVA_STAT_PAYLOAD_BYTES_RECEIVED] = (int64_t)statistics->payload_bytes_received;
+    values[AWS_MQTT5_JAVA_STAT_CONNECTION_SUCCESSES] = (int64_t)statistics->connection_successes;
+    values[AWS_MQTT5_JAVA_STAT_CONNECTION_FAILURES] = (int64_t)statistics->connection_failures;
+    values[AWS_MQTT5_JAVA_STAT_DISCONNECTIONS] = (int64_t)statistics->disconnections;
+    uint64_t disconnected_ns = statistics->disconnected_total_ns;
+    if (statistics->disconnected_since_ns != 0 && now > statistics->disconnected_since_ns) {
+        /* include the stretch the client is in the middle of */
+        disconnected_ns += now - statistics->disconnected_since_ns;
+    }
+    values[AWS_MQTT5_JAVA_STAT_DISCONNECTED_NS] = (int64_t)disconnected_ns;
+    aws_mutex_unlock(&statistics->lock);
+
+    struct aws_jni_offline_queue_statistics queue_statistics;
+    AWS_ZERO_STRUCT(queue_statistics);
+    if (java_client->offline_queue != NULL) {
+        aws_jni_offline_queue_get_statistics(java_client->offline_queue, &queue_statistics);
+    }
+    values[AWS_MQTT5_JAVA_STAT_OFFLINE_QUEUE_MESSAGES] = (int64_t)queue_statistics.queued_messages;
+    values[AWS_MQTT5_JAVA_STAT_OFFLINE_QUEUE_BYTES] = (int64_t)queue_statistics.queued_bytes;
+    values[AWS_MQTT5_JAVA_STAT_OFFLINE_QUEUE_DROPPED] = (int64_t)queue_statistics.dropped_messages;
+
+    aws_jni_latency_histogram_snapshot(
+        &statistics->qos0_publish_latency, &values[AWS_MQTT5_JAVA_STAT_QOS0_LATENCY_HISTOGRAM]);
+    aws_jni_latency_histogram_snapshot(
+        &statistics->qos1_publish_latency, &values[AWS_MQTT5_JAVA_STAT_QOS1_LATENCY_HISTOGRAM]);
+
+    jlongArray jni_values = (*env)->NewLongArray(env, AWS_MQTT5_JAVA_STAT_COUNT);
+    if (jni_values == NULL) {
+        /* OutOfMemoryError is pending */
+        return NULL;
+    }
+    (*env)->SetLongArrayRegion(env, jni_values, 0, AWS_MQTT5_JAVA_STAT_COUNT, (const jlong *)values);
+    return jni_values;
+}
+
 JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5ClientInternalGetOperationStatistics(
     JNIEnv *env,
     jclass jni_class,
@@ -2235,7 +3102,7 @@ static void s_aws_mqtt5_client_java_websocket_handshake_transform(
         return;
     }
 
-    struct aws_allocator *alloc = aws_jni_get_allocator();
+    struct aws_allocator *alloc = aws_jni_mqtt_allocator();
 
     /* Cannot fail */
     struct mqtt5_jni_ws_handshake *ws_handshake = aws_mem_calloc(alloc, 1, sizeof(struct mqtt5_jni_ws_handshake));
@@ -2323,8 +3190,9 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5C
     jobject jni_bootstrap,
     jobject jni_client) {
     (void)jni_class;
+    cache_java_class_ids_for_mqtt(env);
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
     struct aws_mqtt5_packet_connect_view_java_jni *connect_options = NULL;
     struct aws_mqtt5_client_options client_options;
     AWS_ZERO_STRUCT(client_options);
@@ -2355,6 +3223,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5C
             env, "MQTT5 client new: could not initialize new client", AWS_ERROR_INVALID_STATE);
         return (jlong)NULL;
     }
+    s_aws_mqtt5_client_java_statistics_init(&java_client->statistics);
 
     jstring jni_host_name = NULL;
     struct aws_byte_cursor *pointer_host_name = &client_options.host_name;
@@ -2447,7 +3316,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5C
         }
         struct aws_tls_ctx *tls_ctx = (struct aws_tls_ctx *)jni_tls_pointer;
         if (tls_ctx) {
-            aws_tls_connection_options_init_from_ctx(&java_client->tls_options, tls_ctx);
+            aws_jni_tls_connection_options_init_from_ctx(&java_client->tls_options, tls_ctx);
             aws_tls_connection_options_set_server_name(&java_client->tls_options, allocator, &client_options.host_name);
             client_options.tls_options = &java_client->tls_options;
         }
@@ -2676,6 +3545,16 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_mqtt5_Mqtt5Client_mqtt5C
     if (jni_publish_events != NULL) {
         java_client->jni_publish_events = (*env)->NewGlobalRef(env, jni_publish_events);
     }
+    /* routed messages are delivered lazily too, so this applies even without publish events */
+    java_client->lazy_publish_packets =
+        (*env)->GetBooleanField(env, jni_options, mqtt5_client_options_properties.lazy_publish_packets_field_id);
+    aws_byte_buf_init(&java_client->lazy_publish_properties, allocator, 0);
+    java_client->topic_router = aws_jni_topic_router_new(allocator);
+    aws_array_list_init_dynamic(&java_client->routed_handler_ids, allocator, 4, sizeof(int64_t));
+
+    if (s_aws_mqtt5_client_java_init_offline_queue(env, allocator, java_client, jni_options)) {
+        goto clean_up;
+    }
 
     jobject jni_lifecycle_events =
         (*env)->GetObjectField(env, jni_options, mqtt5_client_options_properties.lifecycle_events_field_id);
@@ -0,0 +1,1200 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "mqtt5_offline_queue.h"
+
+#include <aws/checksums/crc.h>
+#include <aws/common/condition_variable.h>
+#include <aws/common/file.h>
+#include <aws/common/linked_list.h>
+#include <aws/common/logging.h>
+#include <aws/common/mutex.h>
+#include <aws/common/thread.h>
+#include <aws/mqtt/mqtt.h>
+
+#include <errno.h>
+#include <stdio.h>
+
+/* "MQOQ" starts every queued record; a dropped record in the spill file has it overwritten with "MQOD" */
+#define OFFLINE_QUEUE_RECORD_MAGIC 0x4d514f51u
+#define OFFLINE_QUEUE_DROPPED_RECORD_MAGIC 0x4d514f44u
+/* magic, body length, crc32 of the body */
+#define OFFLINE_QUEUE_RECORD_HEADER_SIZE 12
+/* Records with more user properties than this are decoded into a heap array instead of one on the stack */
+#define OFFLINE_QUEUE_STACK_USER_PROPERTIES 16
+/* The spill file is compacted once dropped records make up over half of it, and it's at least this big */
+#define OFFLINE_QUEUE_COMPACT_MIN_BYTES (1024 * 1024)
+
+#define OFFLINE_QUEUE_PAYLOAD_FORMAT 0x01
+#define OFFLINE_QUEUE_MESSAGE_EXPIRY_INTERVAL 0x02
+#define OFFLINE_QUEUE_RESPONSE_TOPIC 0x04
+#define OFFLINE_QUEUE_CORRELATION_DATA 0x08
+#define OFFLINE_QUEUE_CONTENT_TYPE 0x10
+
+struct offline_queue_entry {
+    struct aws_linked_list_node node;
+    /* in the queue's spill_pending list while spill_pending is set */
+    struct aws_linked_list_node spill_node;
+    struct aws_mqtt5_publish_completion_options completion_options;
+    enum aws_mqtt5_qos qos;
+    /* encoded size, header included */
+    size_t size;
+    /* the record itself, unless it was spilled */
+    struct aws_byte_buf record;
+    bool spill_pending;
+    bool spilled;
+    int64_t file_offset;
+    /* where a compaction in progress is moving the record to, -1 otherwise */
+    int64_t compact_offset;
+    /* set once a spilled record has been published, its completion needs to find the queue */
+    struct aws_jni_offline_queue *queue;
+};
+
+/* A record in the spill file still to be marked dropped */
+struct offline_queue_drop {
+    int64_t file_offset;
+    /* where the record ends up if the compaction in progress succeeds, -1 if it isn't part of one */
+    int64_t compact_offset;
+};
+
+/* A record a compaction copies to the new spill file */
+struct offline_queue_compact_record {
+    int64_t file_offset;
+    size_t size;
+};
+
+/*
+ * With a spill file, every read and write of it happens on the queue's io thread with the lock released, so neither
+ * an event loop nor anyone waiting on the lock waits for the disk. The io thread appends QoS 1 records shortly after
+ * they're pushed, marks records dropped, compacts the file, and publishes the queued messages once the client
+ * connects, since publishing a spilled record means reading it back first.
+ */
+struct aws_jni_offline_queue {
+    struct aws_allocator *allocator;
+    struct aws_mutex lock;
+    /* wakes the io thread, and anyone waiting for it to finish with a record */
+    struct aws_condition_variable signal;
+
+    size_t max_messages;
+    uint64_t max_bytes;
+    enum aws_jni_offline_queue_overflow_policy overflow_policy;
+
+    bool online;
+    /* set from connecting until everything queued has been published and the queue goes online */
+    bool draining;
+    /* set while a message taken off the queue is being handed to the client */
+    bool publishing;
+    struct aws_mqtt5_client *client;
+    /* struct offline_queue_entry, oldest first */
+    struct aws_linked_list entries;
+    /* Spilled records already handed to the client, which stay in the spill file until their publish completes */
+    struct aws_linked_list unacked_entries;
+    size_t message_count;
+    uint64_t byte_count;
+    uint64_t dropped_count;
+
+    struct aws_string *spill_path;
+    /* only used by the io thread once it's running */
+    FILE *spill_file;
+    struct aws_thread io_thread;
+    bool io_thread_launched;
+    bool shutting_down;
+    /* struct offline_queue_entry by spill_node, QoS 1 records waiting to be appended, oldest first */
+    struct aws_linked_list spill_pending;
+    /* the entry whose record is being appended, cleared if the entry is removed meanwhile */
+    struct offline_queue_entry *spilling_entry;
+    /* struct offline_queue_drop */
+    struct aws_array_list pending_drops;
+    bool compacting;
+    /* set after a failed compaction, so it isn't retried until another record is appended */
+    bool compaction_suspended;
+    /* where the next record is appended, and how much of the file is records still queued or unacknowledged */
+    int64_t spill_file_length;
+    int64_t spill_live_length;
+    /* spilled records are read back into this, and records to spill copied into it, by the io thread */
+    struct aws_byte_buf spill_buffer;
+};
+
+/* A record decoded in place: the view's cursors point into the record */
+struct offline_queue_decoded_publish {
+    struct aws_mqtt5_packet_publish_view view;
+    enum aws_mqtt5_payload_format_indicator payload_format;
+    uint32_t message_expiry_interval_seconds;
+    struct aws_byte_cursor response_topic;
+    struct aws_byte_cursor correlation_data;
+    struct aws_byte_cursor content_type;
+    struct aws_mqtt5_user_property stack_user_properties[OFFLINE_QUEUE_STACK_USER_PROPERTIES];
+    struct aws_mqtt5_user_property *user_properties;
+};
+
+/*******************************************************************************
+ * RECORD ENCODING
+ ******************************************************************************/
+
+static void s_write_length_prefixed(struct aws_byte_buf *buf, struct aws_byte_cursor cursor) {
+    aws_byte_buf_write_be32(buf, (uint32_t)cursor.len);
+    aws_byte_buf_write_from_whole_cursor(buf, cursor);
+}
+
+static bool s_read_length_prefixed(struct aws_byte_cursor *cursor, struct aws_byte_cursor *out) {
+    uint32_t length = 0;
+    if (!aws_byte_cursor_read_be32(cursor, &length) || length > cursor->len) {
+        return false;
+    }
+    *out = aws_byte_cursor_advance(cursor, length);
+    return true;
+}
+
+/*
+ * Body: qos, retain and flags bytes, then the payload format and message expiry interval if flagged, the topic and
+ * payload, the response topic, correlation data and content type if flagged, and the user properties. Lengths and
+ * counts are 32-bit big-endian. Topic aliases aren't kept, since they don't survive a reconnect.
+ */
+static int s_encode_record(
+    struct aws_allocator *allocator,
+    const struct aws_mqtt5_packet_publish_view *publish,
+    struct aws_byte_buf *record) {
+
+    size_t body_size = 3 + 4 + publish->topic.len + 4 + publish->payload.len + 4;
+    uint8_t flags = 0;
+    if (publish->payload_format != NULL) {
+        flags |= OFFLINE_QUEUE_PAYLOAD_FORMAT;
+        body_size += 1;
+    }
+    if (publish->message_expiry_interval_seconds != NULL) {
+        flags |= OFFLINE_QUEUE_MESSAGE_EXPIRY_INTERVAL;
+        body_size += 4;
+    }
+    if (publish->response_topic != NULL) {
+        flags |= OFFLINE_QUEUE_RESPONSE_TOPIC;
+        body_size += 4 + publish->response_topic->len;
+    }
+    if (publish->correlation_data != NULL) {
+        flags |= OFFLINE_QUEUE_CORRELATION_DATA;
+        body_size += 4 + publish->correlation_data->len;
+    }
+    if (publish->content_type != NULL) {
+        flags |= OFFLINE_QUEUE_CONTENT_TYPE;
+        body_size += 4 + publish->content_type->len;
+    }
+    for (size_t i = 0; i < publish->user_property_count; ++i) {
+        body_size += 4 + publish->user_properties[i].name.len + 4 + publish->user_properties[i].value.len;
+    }
+
+    /* far beyond the MQTT packet size limit, and what the crc takes in one call */
+    if (body_size > INT32_MAX) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+    if (aws_byte_buf_init(record, allocator, OFFLINE_QUEUE_RECORD_HEADER_SIZE + body_size)) {
+        return AWS_OP_ERR;
+    }
+
+    aws_byte_buf_write_be32(record, OFFLINE_QUEUE_RECORD_MAGIC);
+    aws_byte_buf_write_be32(record, (uint32_t)body_size);
+    aws_byte_buf_write_be32(record, 0); /* crc, filled in once the body is written */
+
+    aws_byte_buf_write_u8(record, (uint8_t)publish->qos);
+    aws_byte_buf_write_u8(record, publish->retain ? 1 : 0);
+    aws_byte_buf_write_u8(record, flags);
+    if (publish->payload_format != NULL) {
+        aws_byte_buf_write_u8(record, (uint8_t)*publish->payload_format);
+    }
+    if (publish->message_expiry_interval_seconds != NULL) {
+        aws_byte_buf_write_be32(record, *publish->message_expiry_interval_seconds);
+    }
+    s_write_length_prefixed(record, publish->topic);
+    s_write_length_prefixed(record, publish->payload);
+    if (publish->response_topic != NULL) {
+        s_write_length_prefixed(record, *publish->response_topic);
+    }
+    if (publish->correlation_data != NULL) {
+        s_write_length_prefixed(record, *publish->correlation_data);
+    }
+    if (publish->content_type != NULL) {
+        s_write_length_prefixed(record, *publish->content_type);
+    }
+    aws_byte_buf_write_be32(record, (uint32_t)publish->user_property_count);
+    for (size_t i = 0; i < publish->user_property_count; ++i) {
+        s_write_length_prefixed(record, publish->user_properties[i].name);
+        s_write_length_prefixed(record, publish->user_properties[i].value);
+    }
+
+    uint32_t crc = aws_checksums_crc32(record->buffer + OFFLINE_QUEUE_RECORD_HEADER_SIZE, (int)body_size, 0);
+    struct aws_byte_buf crc_buf = aws_byte_buf_from_empty_array(record->buffer + 8, 4);
+    aws_byte_buf_write_be32(&crc_buf, crc);
+
+    return AWS_OP_SUCCESS;
+}
+
+/* Checks a record's header and crc, and returns its body */
+static int s_record_body(struct aws_byte_cursor record, struct aws_byte_cursor *body) {
+    uint32_t magic = 0;
+    uint32_t body_size = 0;
+    uint32_t crc = 0;
+    if (!aws_byte_cursor_read_be32(&record, &magic) || !aws_byte_cursor_read_be32(&record, &body_size) ||
+        !aws_byte_cursor_read_be32(&record, &crc) || magic != OFFLINE_QUEUE_RECORD_MAGIC || body_size != record.len ||
+        body_size > INT32_MAX || aws_checksums_crc32(record.ptr, (int)body_size, 0) != crc) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+    *body = record;
+    return AWS_OP_SUCCESS;
+}
+
+static void s_decoded_publish_clean_up(
+    struct aws_allocator *allocator,
+    struct offline_queue_decoded_publish *decoded) {
+    if (decoded->user_properties != NULL && decoded->user_properties != decoded->stack_user_properties) {
+        aws_mem_release(allocator, decoded->user_properties);
+    }
+    decoded->user_properties = NULL;
+}
+
+static int s_decode_record(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor record,
+    struct offline_queue_decoded_publish *decoded) {
+
+    AWS_ZERO_STRUCT(*decoded);
+    struct aws_mqtt5_packet_publish_view *view = &decoded->view;
+
+    struct aws_byte_cursor body;
+    if (s_record_body(record, &body)) {
+        return AWS_OP_ERR;
+    }
+
+    uint8_t qos = 0;
+    uint8_t retain = 0;
+    uint8_t flags = 0;
+    if (!aws_byte_cursor_read_u8(&body, &qos) || !aws_byte_cursor_read_u8(&body, &retain) ||
+        !aws_byte_cursor_read_u8(&body, &flags)) {
+        goto malformed;
+    }
+    view->qos = (enum aws_mqtt5_qos)qos;
+    view->retain = retain != 0;
+
+    if (flags & OFFLINE_QUEUE_PAYLOAD_FORMAT) {
+        uint8_t payload_format = 0;
+        if (!aws_byte_cursor_read_u8(&body, &payload_format)) {
+            goto malformed;
+        }
+        decoded->payload_format = (enum aws_mqtt5_payload_format_indicator)payload_format;
+        view->payload_format = &decoded->payload_format;
+    }
+    if (flags & OFFLINE_QUEUE_MESSAGE_EXPIRY_INTERVAL) {
+        if (!aws_byte_cursor_read_be32(&body, &decoded->message_expiry_interval_seconds)) {
+            goto malformed;
+        }
+        view->message_expiry_interval_seconds = &decoded->message_expiry_interval_seconds;
+    }
+    if (!s_read_length_prefixed(&body, &view->topic) || !s_read_length_prefixed(&body, &view->payload)) {
+        goto malformed;
+    }
+    if (flags & OFFLINE_QUEUE_RESPONSE_TOPIC) {
+        if (!s_read_length_prefixed(&body, &decoded->response_topic)) {
+            goto malformed;
+        }
+        view->response_topic = &decoded->response_topic;
+    }
+    if (flags & OFFLINE_QUEUE_CORRELATION_DATA) {
+        if (!s_read_length_prefixed(&body, &decoded->correlation_data)) {
+            goto malformed;
+        }
+        view->correlation_data = &decoded->correlation_data;
+    }
+    if (flags & OFFLINE_QUEUE_CONTENT_TYPE) {
+        if (!s_read_length_prefixed(&body, &decoded->content_type)) {
+            goto malformed;
+        }
+        view->content_type = &decoded->content_type;
+    }
+
+    uint32_t user_property_count = 0;
+    /* every property takes at least its two lengths */
+    if (!aws_byte_cursor_read_be32(&body, &user_property_count) || user_property_count > body.len / 8) {
+        goto malformed;
+    }
+    if (user_property_count > 0) {
+        decoded->user_properties =
+            user_property_count <= OFFLINE_QUEUE_STACK_USER_PROPERTIES
+                ? decoded->stack_user_properties
+                : aws_mem_calloc(allocator, user_property_count, sizeof(struct aws_mqtt5_user_property));
+        for (uint32_t i = 0; i < user_property_count; ++i) {
+            if (!s_read_length_prefixed(&body, &decoded->user_properties[i].name) ||
+                !s_read_length_prefixed(&body, &decoded->user_properties[i].value)) {
+                goto malformed;
+            }
+        }
+        view->user_property_count = user_property_count;
+        view->user_properties = decoded->user_properties;
+    }
+
+    return AWS_OP_SUCCESS;
+
+malformed:
+    s_decoded_publish_clean_up(allocator, decoded);
+    return aws_raise_error(AWS_ERROR_INVALID_STATE);
+}
+
+/*******************************************************************************
+ * SPILL FILE
+ ******************************************************************************/
+
+static int s_spill_file_write_at(FILE *file, int64_t offset, struct aws_byte_cursor data) {
+    if (aws_fseek(file, offset, SEEK_SET)) {
+        return AWS_OP_ERR;
+    }
+    if (fwrite(data.ptr, 1, data.len, file) != data.len || fflush(file) != 0) {
+        return aws_translate_and_raise_io_error(errno);
+    }
+    return AWS_OP_SUCCESS;
+}
+
+static int s_spill_file_read_at(FILE *file, int64_t offset, size_t length, struct aws_byte_buf *dest) {
+    aws_byte_buf_reset(dest, false);
+    if (aws_byte_buf_reserve(dest, length) || aws_fseek(file, offset, SEEK_SET)) {
+        return AWS_OP_ERR;
+    }
+    if (fread(dest->buffer, 1, length, file) != length) {
+        /* a short read without an error means the file was cut short under us */
+        return ferror(file) ? aws_translate_and_raise_io_error(errno) : aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+    dest->len = length;
+    return AWS_OP_SUCCESS;
+}
+
+/* Returns the entry's record, reading it back if it was spilled; only valid until the next read */
+static int s_entry_record(
+    struct aws_jni_offline_queue *queue,
+    struct offline_queue_entry *entry,
+    struct aws_byte_cursor *record) {
+
+    if (!entry->spilled) {
+        *record = aws_byte_cursor_from_buf(&entry->record);
+        return AWS_OP_SUCCESS;
+    }
+    if (queue->spill_file == NULL) {
+        return aws_raise_error(AWS_ERROR_INVALID_STATE);
+    }
+    if (s_spill_file_read_at(queue->spill_file, entry->file_offset, entry->size, &queue->spill_buffer)) {
+        return AWS_OP_ERR;
+    }
+    *record = aws_byte_cursor_from_buf(&queue->spill_buffer);
+    return AWS_OP_SUCCESS;
+}
+
+/* Queues an entry's record in the spill file to be marked dropped, so it isn't recovered. Called with the lock held */
+static void s_mark_record_dropped(struct aws_jni_offline_queue *queue, struct offline_queue_entry *entry) {
+    if (!entry->spilled) {
+        return;
+    }
+    struct offline_queue_drop drop = {
+        .file_offset = entry->file_offset,
+        .compact_offset = entry->compact_offset,
+    };
+    aws_array_list_push_back(&queue->pending_drops, &drop);
+    aws_condition_variable_notify_all(&queue->signal);
+}
+
+/*
+ * The functions below run on the io thread. Each is called with the lock held and returns with it held, but
+ * releases it around any file access.
+ */
+
+static void s_write_pending_drops(struct aws_jni_offline_queue *queue) {
+    struct aws_array_list drops;
+    aws_array_list_init_dynamic(&drops, queue->allocator, 0, sizeof(struct offline_queue_drop));
+    aws_array_list_swap_contents(&drops, &queue->pending_drops);
+    aws_mutex_unlock(&queue->lock);
+
+    uint8_t dropped_magic[4];
+    struct aws_byte_buf magic_buf = aws_byte_buf_from_empty_array(dropped_magic, sizeof(dropped_magic));
+    aws_byte_buf_write_be32(&magic_buf, OFFLINE_QUEUE_DROPPED_RECORD_MAGIC);
+    size_t drop_count = aws_array_list_length(&drops);
+    for (size_t i = 0; i < drop_count && queue->spill_file != NULL; ++i) {
+        struct offline_queue_drop drop;
+        aws_array_list_get_at(&drops, &drop, i);
+        s_spill_file_write_at(queue->spill_file, drop.file_offset, aws_byte_cursor_from_buf(&magic_buf));
+    }
+
+    aws_mutex_lock(&queue->lock);
+    aws_array_list_clean_up(&drops);
+}
+
+/* Appends the oldest record waiting to be spilled, and marks it dropped right away if it left the queue meanwhile */
+static void s_spill_next_entry(struct aws_jni_offline_queue *queue) {
+    struct offline_queue_entry *entry =
+        AWS_CONTAINER_OF(aws_linked_list_pop_front(&queue->spill_pending), struct offline_queue_entry, spill_node);
+    entry->spill_pending = false;
+    if (queue->spill_file == NULL) {
+        return;
+    }
+
+    struct aws_byte_cursor record = aws_byte_cursor_from_buf(&entry->record);
+    aws_byte_buf_reset(&queue->spill_buffer, false);
+    aws_byte_buf_append_dynamic(&queue->spill_buffer, &record);
+    int64_t offset = queue->spill_file_length;
+    queue->spilling_entry = entry;
+    aws_mutex_unlock(&queue->lock);
+
+    int result = s_spill_file_write_at(queue->spill_file, offset, aws_byte_cursor_from_buf(&queue->spill_buffer));
+    int error_code = result == AWS_OP_SUCCESS ? AWS_ERROR_SUCCESS : aws_last_error();
+
+    aws_mutex_lock(&queue->lock);
+    entry = queue->spilling_entry;
+    queue->spilling_entry = NULL;
+    aws_condition_variable_notify_all(&queue->signal);
+
+    if (result != AWS_OP_SUCCESS) {
+        AWS_LOGF_WARN(
+            AWS_LS_MQTT_CLIENT,
+            "id=%p: offline queue could not spill a publish, keeping it in memory - error code %d",
+            (void *)queue,
+            error_code);
+        return;
+    }
+
+    queue->spill_file_length = offset + (int64_t)queue->spill_buffer.len;
+    queue->compaction_suspended = false;
+    if (entry == NULL) {
+        struct offline_queue_drop drop = {.file_offset = offset, .compact_offset = -1};
+        aws_array_list_push_back(&queue->pending_drops, &drop);
+        return;
+    }
+
+    entry->spilled = true;
+    entry->file_offset = offset;
+    queue->spill_live_length += (int64_t)entry->size;
+    aws_byte_buf_clean_up(&entry->record);
+}
+
+static bool s_compaction_due(const struct aws_jni_offline_queue *queue) {
+    if (queue->spill_file == NULL || queue->compaction_suspended || queue->spill_file_length == 0) {
+        return false;
+    }
+    return queue->spill_live_length == 0 || (queue->spill_file_length >= OFFLINE_QUEUE_COMPACT_MIN_BYTES &&
+                                             queue->spill_live_length * 2 < queue->spill_file_length);
+}
+
+/* Empties the spill file; nothing queued or unacknowledged is left in it, so nothing can be spilled meanwhile */
+static void s_reset_spill_file(struct aws_jni_offline_queue *queue) {
+    /* every record in the file is about to be gone */
+    aws_array_list_clear(&queue->pending_drops);
+    queue->spill_file_length = 0;
+    aws_mutex_unlock(&queue->lock);
+
+    fclose(queue->spill_file);
+    queue->spill_file = aws_fopen(aws_string_c_str(queue->spill_path), "w+b");
+    if (queue->spill_file == NULL) {
+        AWS_LOGF_ERROR(
+            AWS_LS_MQTT_CLIENT,
+            "id=%p: offline queue could not reopen its spill file, keeping records in memory - error code %d",
+            (void *)queue,
+            aws_last_error());
+    }
+
+    aws_mutex_lock(&queue->lock);
+}
+
+/* Copies the given records to a new file and swaps it in for the old one, returning whether it was swapped in */
+static bool s_write_compacted_spill_file(struct aws_jni_offline_queue *queue, const struct aws_array_list *records) {
+    struct aws_allocator *allocator = queue->allocator;
+    bool replaced = false;
+
+    struct aws_byte_buf tmp_path_buf;
+    aws_byte_buf_init_copy_from_cursor(&tmp_path_buf, allocator, aws_byte_cursor_from_string(queue->spill_path));
+    struct aws_byte_cursor tmp_suffix = aws_byte_cursor_from_c_str(".tmp");
+    aws_byte_buf_append_dynamic(&tmp_path_buf, &tmp_suffix);
+    struct aws_string *tmp_path = aws_string_new_from_buf(allocator, &tmp_path_buf);
+    aws_byte_buf_clean_up(&tmp_path_buf);
+
+    FILE *tmp_file = aws_fopen(aws_string_c_str(tmp_path), "w+b");
+    if (tmp_file == NULL) {
+        goto error;
+    }
+
+    int64_t offset = 0;
+    size_t record_count = aws_array_list_length(records);
+    for (size_t i = 0; i < record_count; ++i) {
+        struct offline_queue_compact_record record;
+        aws_array_list_get_at(records, &record, i);
+        if (s_spill_file_read_at(queue->spill_file, record.file_offset, record.size, &queue->spill_buffer) ||
+            s_spill_file_write_at(tmp_file, offset, aws_byte_cursor_from_buf(&queue->spill_buffer))) {
+            goto error;
+        }
+        offset += (int64_t)record.size;
+    }
+    fclose(tmp_file);
+    tmp_file = NULL;
+
+    fclose(queue->spill_file);
+    queue->spill_file = NULL;
+#if defined(_WIN32)
+    /* renaming doesn't replace an existing file on Windows */
+    aws_file_delete(queue->spill_path);
+#endif
+    if (aws_directory_or_file_move(tmp_path, queue->spill_path)) {
+        AWS_LOGF_WARN(
+            AWS_LS_MQTT_CLIENT,
+            "id=%p: offline queue could not replace its spill file with the compacted one - error code %d",
+            (void *)queue,
+            aws_last_error());
+        aws_file_delete(tmp_path);
+    } else {
+        replaced = true;
+    }
+
+    queue->spill_file = aws_fopen(aws_string_c_str(queue->spill_path), "r+b");
+    if (queue->spill_file == NULL) {
+        AWS_LOGF_ERROR(
+            AWS_LS_MQTT_CLIENT,
+            "id=%p: offline queue could not reopen its spill file - error code %d",
+            (void *)queue,
+            aws_last_error());
+    }
+    aws_string_destroy(tmp_path);
+    return replaced;
+
+error:
+    AWS_LOGF_WARN(
+        AWS_LS_MQTT_CLIENT,
+        "id=%p: offline queue could not compact its spill file - error code %d",
+        (void *)queue,
+        aws_last_error());
+    if (tmp_file != NULL) {
+        fclose(tmp_file);
+        aws_file_delete(tmp_path);
+    }
+    aws_string_destroy(tmp_path);
+    return false;
+}
+
+/*
+ * Rewrites the spill file with only the records still queued or unacknowledged. Records can leave the queue while
+ * they're being copied; the drops queued for them carry their offsets in both files, and whichever file ends up in
+ * place gets them.
+ */
+static void s_compact_spill_file(struct aws_jni_offline_queue *queue) {
+    if (queue->spill_live_length == 0) {
+        s_reset_spill_file(queue);
+        return;
+    }
+
+    struct aws_array_list records;
+    aws_array_list_init_dynamic(&records, queue->allocator, 16, sizeof(struct offline_queue_compact_record));
+
+    /* the unacknowledged records are older than anything still queued, and go first */
+    struct aws_linked_list *lists[] = {&queue->unacked_entries, &queue->entries};
+    int64_t compacted_length = 0;
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(lists); ++i) {
+        for (struct aws_linked_list_node *node = aws_linked_list_begin(lists[i]); node != aws_linked_list_end(lists[i]);
+             node = aws_linked_list_next(node)) {
+            struct offline_queue_entry *entry = AWS_CONTAINER_OF(node, struct offline_queue_entry, node);
+            if (entry->spilled) {
+                struct offline_queue_compact_record record = {.file_offset = entry->file_offset, .size = entry->size};
+                aws_array_list_push_back(&records, &record);
+                entry->compact_offset = compacted_length;
+                compacted_length += (int64_t)entry->size;
+            }
+        }
+    }
+    queue->compacting = true;
+    aws_mutex_unlock(&queue->lock);
+
+    bool replaced = s_write_compacted_spill_file(queue, &records);
+
+    aws_mutex_lock(&queue->lock);
+    queue->compacting = false;
+    aws_array_list_clean_up(&records);
+
+    size_t drop_count = aws_array_list_length(&queue->pending_drops);
+    size_t kept_count = 0;
+    for (size_t i = 0; i < drop_count; ++i) {
+        struct offline_queue_drop drop;
+        aws_array_list_get_at(&queue->pending_drops, &drop, i);
+        if (replaced) {
+            /* a record dropped before the copy started isn't in the new file */
+            if (drop.compact_offset < 0) {
+                continue;
+            }
+            drop.file_offset = drop.compact_offset;
+        }
+        drop.compact_offset = -1;
+        aws_array_list_set_at(&queue->pending_drops, &drop, kept_count++);
+    }
+    while (aws_array_list_length(&queue->pending_drops) > kept_count) {
+        aws_array_list_pop_back(&queue->pending_drops);
+    }
+
+    for (size_t i = 0; i < AWS_ARRAY_SIZE(lists); ++i) {
+        for (struct aws_linked_list_node *node = aws_linked_list_begin(lists[i]); node != aws_linked_list_end(lists[i]);
+             node = aws_linked_list_next(node)) {
+            struct offline_queue_entry *entry = AWS_CONTAINER_OF(node, struct offline_queue_entry, node);
+            if (entry->spilled && replaced) {
+                entry->file_offset = entry->compact_offset;
+            }
+            entry->compact_offset = -1;
+        }
+    }
+
+    if (replaced) {
+        queue->spill_file_length = compacted_length;
+    } else {
+        queue->compaction_suspended = true;
+    }
+}
+
+/*******************************************************************************
+ * QUEUE
+ ******************************************************************************/
+
+static void s_push_failure(
+    struct aws_array_list *failures,
+    const struct aws_mqtt5_publish_completion_options *completion_options,
+    int error_code) {
+    struct aws_jni_offline_queue_failure failure = {
+        .completion_options = *completion_options,
+        .error_code = error_code,
+    };
+    aws_array_list_push_back(failures, &failure);
+}
+
+static void s_remove_entry(struct aws_jni_offline_queue *queue, struct offline_queue_entry *entry) {
+    aws_linked_list_remove(&entry->node);
+    queue->message_count--;
+    queue->byte_count -= entry->size;
+    if (entry->spilled) {
+        queue->spill_live_length -= (int64_t)entry->size;
+    }
+    if (entry->spill_pending) {
+        aws_linked_list_remove(&entry->spill_node);
+    }
+    if (queue->spilling_entry == entry) {
+        queue->spilling_entry = NULL;
+    }
+    aws_byte_buf_clean_up(&entry->record);
+    aws_mem_release(queue->allocator, entry);
+}
+
+static void s_fail_entry(
+    struct aws_jni_offline_queue *queue,
+    struct offline_queue_entry *entry,
+    int error_code,
+    struct aws_array_list *failures) {
+    s_push_failure(failures, &entry->completion_options, error_code);
+    s_remove_entry(queue, entry);
+}
+
+/* Drops a queued message for the overflow policy */
+static void s_drop_entry(
+    struct aws_jni_offline_queue *queue,
+    struct offline_queue_entry *entry,
+    struct aws_array_list *failures) {
+
+    s_mark_record_dropped(queue, entry);
+    queue->dropped_count++;
+    s_fail_entry(queue, entry, AWS_ERROR_MQTT5_OPERATION_FAILED_DUE_TO_OFFLINE_QUEUE_POLICY, failures);
+}
+
+/* Picks the queued message the overflow policy drops to make room for one of the given qos, or NULL for that one */
+static struct offline_queue_entry *s_choose_entry_to_drop(struct aws_jni_offline_queue *queue, enum aws_mqtt5_qos qos) {
+    if (aws_linked_list_empty(&queue->entries)) {
+        return NULL;
+    }
+    struct offline_queue_entry *oldest =
+        AWS_CONTAINER_OF(aws_linked_list_front(&queue->entries), struct offline_queue_entry, node);
+
+    switch (queue->overflow_policy) {
+        case AWS_JNI_OQOP_DROP_OLDEST:
+            return oldest;
+
+        case AWS_JNI_OQOP_DROP_QOS0_FIRST:
+            for (struct aws_linked_list_node *node = aws_linked_list_begin(&queue->entries);
+                 node != aws_linked_list_end(&queue->entries);
+                 node = aws_linked_list_next(node)) {
+                struct offline_queue_entry *entry = AWS_CONTAINER_OF(node, struct offline_queue_entry, node);
+                if (entry->qos == AWS_MQTT5_QOS_AT_MOST_ONCE) {
+                    return entry;
+                }
+            }
+            /* only QoS 1 is queued, so a QoS 0 message is the one to go */
+            return qos == AWS_MQTT5_QOS_AT_MOST_ONCE ? NULL : oldest;
+
+        case AWS_JNI_OQOP_DROP_NEWEST:
+        default:
+            return NULL;
+    }
+}
+
+static bool s_is_full(const struct aws_jni_offline_queue *queue, size_t size) {
+    return (queue->max_messages != 0 && queue->message_count + 1 > queue->max_messages) ||
+           (queue->max_bytes != 0 && queue->byte_count + size > queue->max_bytes);
+}
+
+/* Drops what the overflow policy says until a message of the given qos and size fits, or returns false if it won't */
+static bool s_make_room(
+    struct aws_jni_offline_queue *queue,
+    enum aws_mqtt5_qos qos,
+    size_t size,
+    struct aws_array_list *failures) {
+
+    if (queue->max_bytes != 0 && size > queue->max_bytes) {
+        return false;
+    }
+    while (s_is_full(queue, size)) {
+        struct offline_queue_entry *to_drop = s_choose_entry_to_drop(queue, qos);
+        if (to_drop == NULL) {
+            return false;
+        }
+        s_drop_entry(queue, to_drop, failures);
+    }
+    return true;
+}
+
+/*
+ * Queues the records a previous client left in the spill file, within the queue's limits the same as pushed ones.
+ * Scanning stops at the first record that doesn't check out, which can only be one torn by a crash mid-append, and
+ * the next append overwrites it. Runs before the io thread starts.
+ */
+static void s_recover_spill_file(struct aws_jni_offline_queue *queue) {
+    int64_t length = 0;
+    if (aws_file_get_length(queue->spill_file, &length)) {
+        return;
+    }
+
+    /* recovered records have no completions to call */
+    struct aws_array_list failures;
+    aws_array_list_init_dynamic(&failures, queue->allocator, 0, sizeof(struct aws_jni_offline_queue_failure));
+
+    int64_t offset = 0;
+    while (offset + OFFLINE_QUEUE_RECORD_HEADER_SIZE <= length) {
+        if (s_spill_file_read_at(queue->spill_file, offset, OFFLINE_QUEUE_RECORD_HEADER_SIZE, &queue->spill_buffer)) {
+            break;
+        }
+        struct aws_byte_cursor header = aws_byte_cursor_from_buf(&queue->spill_buffer);
+        uint32_t magic = 0;
+        uint32_t body_size = 0;
+        aws_byte_cursor_read_be32(&header, &magic);
+        aws_byte_cursor_read_be32(&header, &body_size);
+        if ((magic != OFFLINE_QUEUE_RECORD_MAGIC && magic != OFFLINE_QUEUE_DROPPED_RECORD_MAGIC) ||
+            (int64_t)body_size > length - offset - OFFLINE_QUEUE_RECORD_HEADER_SIZE) {
+            break;
+        }
+        size_t size = OFFLINE_QUEUE_RECORD_HEADER_SIZE + (size_t)body_size;
+
+        if (magic == OFFLINE_QUEUE_RECORD_MAGIC) {
+            struct aws_byte_cursor body;
+            if (s_spill_file_read_at(queue->spill_file, offset, size, &queue->spill_buffer) ||
+                s_record_body(aws_byte_cursor_from_buf(&queue->spill_buffer), &body)) {
+                break;
+            }
+
+            enum aws_mqtt5_qos qos = (enum aws_mqtt5_qos)body.ptr[0];
+            if (s_make_room(queue, qos, size, &failures)) {
+                struct offline_queue_entry *entry =
+                    aws_mem_calloc(queue->allocator, 1, sizeof(struct offline_queue_entry));
+                entry->qos = qos;
+                entry->size = size;
+                entry->spilled = true;
+                entry->file_offset = offset;
+                entry->compact_offset = -1;
+                aws_linked_list_push_back(&queue->entries, &entry->node);
+                queue->message_count++;
+                queue->byte_count += size;
+                queue->spill_live_length += (int64_t)size;
+            } else {
+                struct offline_queue_drop drop = {.file_offset = offset, .compact_offset = -1};
+                aws_array_list_push_back(&queue->pending_drops, &drop);
+                queue->dropped_count++;
+            }
+        }
+        offset += (int64_t)size;
+    }
+    aws_array_list_clean_up(&failures);
+
+    queue->spill_file_length = offset;
+    if (offset < length) {
+        AWS_LOGF_WARN(
+            AWS_LS_MQTT_CLIENT,
+            "id=%p: offline queue ignoring %lld bytes it could not read at the end of its spill file",
+            (void *)queue,
+            (long long)(length - offset));
+    }
+    AWS_LOGF_INFO(
+        AWS_LS_MQTT_CLIENT,
+        "id=%p: offline queue recovered %zu messages from its spill file, and dropped %llu over its limits",
+        (void *)queue,
+        queue->message_count,
+        (unsigned long long)queue->dropped_count);
+}
+
+static void s_on_spilled_publish_complete(
+    enum aws_mqtt5_packet_type packet_type,
+    const void *packet,
+    int error_code,
+    void *complete_ctx);
+
+/*
+ * Hands the oldest queued message to the client, with the lock released while it's read back and published.
+ * Returns false once there's nothing left to publish, after putting the queue online if it was being drained.
+ */
+static bool s_publish_next_entry(struct aws_jni_offline_queue *queue, struct aws_array_list *failures) {
+    if (!queue->draining) {
+        return false;
+    }
+    if (aws_linked_list_empty(&queue->entries)) {
+        queue->draining = false;
+        queue->online = true;
+        AWS_LOGF_DEBUG(AWS_LS_MQTT_CLIENT, "id=%p: offline queue published its queued messages", (void *)queue);
+        return false;
+    }
+
+    struct offline_queue_entry *entry =
+        AWS_CONTAINER_OF(aws_linked_list_pop_front(&queue->entries), struct offline_queue_entry, node);
+    queue->message_count--;
+    queue->byte_count -= entry->size;
+    if (entry->spill_pending) {
+        aws_linked_list_remove(&entry->spill_node);
+        entry->spill_pending = false;
+    }
+
+    /*
+     * The client copies the publish before returning, so an in-memory record can go right away. A spilled one stays
+     * in the file until the publish completes, which can happen as soon as the client has it, so it's tracked first.
+     */
+    const bool spilled = entry->spilled;
+    if (spilled) {
+        entry->queue = queue;
+        aws_linked_list_push_back(&queue->unacked_entries, &entry->node);
+    }
+    struct aws_mqtt5_client *client = queue->client;
+    queue->publishing = true;
+    aws_mutex_unlock(&queue->lock);
+
+    int error_code = AWS_ERROR_SUCCESS;
+    struct aws_byte_cursor record;
+    struct offline_queue_decoded_publish decoded;
+    if (s_entry_record(queue, entry, &record) || s_decode_record(queue->allocator, record, &decoded)) {
+        error_code = aws_last_error();
+        AWS_LOGF_ERROR(
+            AWS_LS_MQTT_CLIENT,
+            "id=%p: offline queue could not read back a queued publish - error code %d",
+            (void *)queue,
+            error_code);
+    } else {
+        const struct aws_mqtt5_publish_completion_options *completion_options =
+            entry->completion_options.completion_callback != NULL ? &entry->completion_options : NULL;
+        struct aws_mqtt5_publish_completion_options spilled_completion_options = {
+            .completion_callback = s_on_spilled_publish_complete,
+            .completion_user_data = entry,
+        };
+        if (spilled) {
+            completion_options = &spilled_completion_options;
+        }
+        if (aws_mqtt5_client_publish(client, &decoded.view, completion_options)) {
+            error_code = aws_last_error();
+        }
+        s_decoded_publish_clean_up(queue->allocator, &decoded);
+    }
+
+    aws_mutex_lock(&queue->lock);
+    queue->publishing = false;
+    aws_condition_variable_notify_all(&queue->signal);
+
+    if (error_code == AWS_ERROR_SUCCESS) {
+        if (!spilled) {
+            aws_byte_buf_clean_up(&entry->record);
+            aws_mem_release(queue->allocator, entry);
+        }
+        return true;
+    }
+
+    /* the completion is failed here, so a later client mustn't publish the record again */
+    s_push_failure(failures, &entry->completion_options, error_code);
+    if (spilled) {
+        aws_linked_list_remove(&entry->node);
+        s_mark_record_dropped(queue, entry);
+        queue->spill_live_length -= (int64_t)entry->size;
+    }
+    aws_byte_buf_clean_up(&entry->record);
+    aws_mem_release(queue->allocator, entry);
+    return true;
+}
+
+static bool s_io_thread_has_work(void *user_data) {
+    struct aws_jni_offline_queue *queue = user_data;
+    return queue->shutting_down || queue->draining || aws_array_list_length(&queue->pending_drops) > 0 ||
+           !aws_linked_list_empty(&queue->spill_pending) || s_compaction_due(queue);
+}
+
+static void s_io_thread_fn(void *arg) {
+    struct aws_jni_offline_queue *queue = arg;
+
+    struct aws_array_list failures;
+    aws_array_list_init_dynamic(&failures, queue->allocator, 0, sizeof(struct aws_jni_offline_queue_failure));
+
+    aws_mutex_lock(&queue->lock);
+    for (;;) {
+        aws_condition_variable_wait_pred(&queue->signal, &queue->lock, s_io_thread_has_work, queue);
+
+        /* drops and appends are finished even when shutting down, so the file agrees with what was queued */
+        if (aws_array_list_length(&queue->pending_drops) > 0) {
+            s_write_pending_drops(queue);
+        } else if (!aws_linked_list_empty(&queue->spill_pending)) {
+            s_spill_next_entry(queue);
+        } else if (s_publish_next_entry(queue, &failures)) {
+            aws_mutex_unlock(&queue->lock);
+            aws_jni_offline_queue_complete_failures(&failures);
+            aws_mutex_lock(&queue->lock);
+        } else if (queue->shutting_down) {
+            break;
+        } else if (s_compaction_due(queue)) {
+            s_compact_spill_file(queue);
+        }
+    }
+    aws_mutex_unlock(&queue->lock);
+
+    aws_array_list_clean_up(&failures);
+}
+
+struct aws_jni_offline_queue *aws_jni_offline_queue_new(
+    struct aws_allocator *allocator,
+    const struct aws_jni_offline_queue_options *options) {
+
+    struct aws_jni_offline_queue *queue = aws_mem_calloc(allocator, 1, sizeof(struct aws_jni_offline_queue));
+    queue->allocator = allocator;
+    aws_mutex_init(&queue->lock);
+    aws_condition_variable_init(&queue->signal);
+    queue->max_messages = options->max_messages;
+    queue->max_bytes = options->max_bytes;
+    queue->overflow_policy = options->overflow_policy;
+    aws_linked_list_init(&queue->entries);
+    aws_linked_list_init(&queue->unacked_entries);
+    aws_linked_list_init(&queue->spill_pending);
+    aws_array_list_init_dynamic(&queue->pending_drops, allocator, 0, sizeof(struct offline_queue_drop));
+    aws_byte_buf_init(&queue->spill_buffer, allocator, 0);
+
+    if (options->spill_path != NULL) {
+        queue->spill_path = aws_string_new_from_string(allocator, options->spill_path);
+        /* "r+b" keeps the records a previous client left, but requires the file to exist */
+        queue->spill_file = aws_fopen(aws_string_c_str(queue->spill_path), "r+b");
+        if (queue->spill_file == NULL) {
+            queue->spill_file = aws_fopen(aws_string_c_str(queue->spill_path), "w+b");
+        }
+        if (queue->spill_file == NULL) {
+            AWS_LOGF_ERROR(
+                AWS_LS_MQTT_CLIENT,
+                "offline queue could not open spill file %s - error code %d",
+                aws_string_c_str(queue->spill_path),
+                aws_last_error());
+            aws_jni_offline_queue_destroy(queue);
+            return NULL;
+        }
+        s_recover_spill_file(queue);
+
+        aws_thread_init(&queue->io_thread, allocator);
+        if (aws_thread_launch(&queue->io_thread, s_io_thread_fn, queue, aws_default_thread_options())) {
+            AWS_LOGF_ERROR(
+                AWS_LS_MQTT_CLIENT,
+                "offline queue could not start the thread for spill file %s - error code %d",
+                aws_string_c_str(queue->spill_path),
+                aws_last_error());
+            aws_thread_clean_up(&queue->io_thread);
+            aws_jni_offline_queue_destroy(queue);
+            return NULL;
+        }
+        queue->io_thread_launched = true;
+    }
+
+    return queue;
+}
+
+void aws_jni_offline_queue_destroy(struct aws_jni_offline_queue *queue) {
+    if (queue == NULL) {
+        return;
+    }
+
+    if (queue->io_thread_launched) {
+        aws_mutex_lock(&queue->lock);
+        queue->shutting_down = true;
+        queue->draining = false;
+        aws_condition_variable_notify_all(&queue->signal);
+        aws_mutex_unlock(&queue->lock);
+
+        aws_thread_join(&queue->io_thread);
+        aws_thread_clean_up(&queue->io_thread);
+    }
+
+    while (!aws_linked_list_empty(&queue->entries)) {
+        s_remove_entry(
+            queue, AWS_CONTAINER_OF(aws_linked_list_front(&queue->entries), struct offline_queue_entry, node));
+    }
+    /* the client has terminated, so every publish completion has already been called */
+    while (!aws_linked_list_empty(&queue->unacked_entries)) {
+        struct offline_queue_entry *entry =
+            AWS_CONTAINER_OF(aws_linked_list_pop_front(&queue->unacked_entries), struct offline_queue_entry, node);
+        aws_mem_release(queue->allocator, entry);
+    }
+    if (queue->spill_file != NULL) {
+        fclose(queue->spill_file);
+    }
+    aws_string_destroy(queue->spill_path);
+    aws_array_list_clean_up(&queue->pending_drops);
+    aws_byte_buf_clean_up(&queue->spill_buffer);
+    aws_condition_variable_clean_up(&queue->signal);
+    aws_mutex_clean_up(&queue->lock);
+    aws_mem_release(queue->allocator, queue);
+}
+
+bool aws_jni_offline_queue_push(
+    struct aws_jni_offline_queue *queue,
+    const struct aws_mqtt5_packet_publish_view *publish,
+    const struct aws_mqtt5_publish_completion_options *completion_options,
+    struct aws_array_list *failures) {
+
+    struct aws_mqtt5_publish_completion_options completion;
+    AWS_ZERO_STRUCT(completion);
+    if (completion_options != NULL) {
+        completion = *completion_options;
+    }
+
+    aws_mutex_lock(&queue->lock);
+    if (queue->online) {
+        aws_mutex_unlock(&queue->lock);
+        return false;
+    }
+
+    struct aws_byte_buf record;
+    if (s_encode_record(queue->allocator, publish, &record)) {
+        s_push_failure(failures, &completion, aws_last_error());
+        goto done;
+    }
+
+    size_t size = record.len;
+    if (!s_make_room(queue, publish->qos, size, failures)) {
+        aws_byte_buf_clean_up(&record);
+        queue->dropped_count++;
+        s_push_failure(failures, &completion, AWS_ERROR_MQTT5_OPERATION_FAILED_DUE_TO_OFFLINE_QUEUE_POLICY);
+        goto done;
+    }
+
+    struct offline_queue_entry *entry = aws_mem_calloc(queue->allocator, 1, sizeof(struct offline_queue_entry));
+    entry->completion_options = completion;
+    entry->qos = publish->qos;
+    entry->size = size;
+    entry->record = record;
+    entry->compact_offset = -1;
+
+    aws_linked_list_push_back(&queue->entries, &entry->node);
+    queue->message_count++;
+    queue->byte_count += size;
+
+    /* the io thread appends it to the spill file and frees the in-memory copy */
+    if (queue->io_thread_launched && publish->qos == AWS_MQTT5_QOS_AT_LEAST_ONCE) {
+        entry->spill_pending = true;
+        aws_linked_list_push_back(&queue->spill_pending, &entry->spill_node);
+        aws_condition_variable_notify_all(&queue->signal);
+    }
+
+done:
+    aws_mutex_unlock(&queue->lock);
+    return true;
+}
+
+/*
+ * Completion of a publish made from a spilled record. Whether it was acknowledged or failed, the Java future is done
+ * with, so the record is marked dropped: a later client publishing it again would only send a duplicate.
+ */
+static void s_on_spilled_publish_complete(
+    enum aws_mqtt5_packet_type packet_type,
+    const void *packet,
+    int error_code,
+    void *complete_ctx) {
+
+    struct offline_queue_entry *entry = complete_ctx;
+    struct aws_jni_offline_queue *queue = entry->queue;
+    struct aws_mqtt5_publish_completion_options completion_options = entry->completion_options;
+
+    aws_mutex_lock(&queue->lock);
+    aws_linked_list_remove(&entry->node);
+    s_mark_record_dropped(queue, entry);
+    queue->spill_live_length -= (int64_t)entry->size;
+    aws_mem_release(queue->allocator, entry);
+    aws_mutex_unlock(&queue->lock);
+
+    if (completion_options.completion_callback != NULL) {
+        completion_options.completion_callback(
+            packet_type, packet, error_code, completion_options.completion_user_data);
+    }
+}
+
+void aws_jni_offline_queue_set_online(
+    struct aws_jni_offline_queue *queue,
+    struct aws_mqtt5_client *client,
+    struct aws_array_list *failures) {
+
+    /* the queue only goes online once it's empty, so nothing pushed meanwhile overtakes the queued messages */
+    aws_mutex_lock(&queue->lock);
+    queue->client = client;
+    queue->draining = true;
+    if (queue->io_thread_launched) {
+        /* spilled records are read back on the io thread rather than the event loop */
+        aws_condition_variable_notify_all(&queue->signal);
+    } else {
+        while (s_publish_next_entry(queue, failures)) {
+            /* until the queue is online */
+        }
+    }
+    aws_mutex_unlock(&queue->lock);
+}
+
+void aws_jni_offline_queue_set_offline(struct aws_jni_offline_queue *queue) {
+    aws_mutex_lock(&queue->lock);
+    queue->online = false;
+    queue->draining = false;
+    aws_mutex_unlock(&queue->lock);
+}
+
+static bool s_io_is_idle(void *user_data) {
+    struct aws_jni_offline_queue *queue = user_data;
+    return !queue->publishing && queue->spilling_entry == NULL && aws_linked_list_empty(&queue->spill_pending);
+}
+
+void aws_jni_offline_queue_clear(struct aws_jni_offline_queue *queue, int error_code, struct aws_array_list *failures) {
+    aws_mutex_lock(&queue->lock);
+    /* let a publish in progress finish, and every queued QoS 1 record reach the spill file for the next client */
+    queue->draining = false;
+    aws_condition_variable_wait_pred(&queue->signal, &queue->lock, s_io_is_idle, queue);
+    while (!aws_linked_list_empty(&queue->entries)) {
+        s_fail_entry(
+            queue,
+            AWS_CONTAINER_OF(aws_linked_list_front(&queue->entries), struct offline_queue_entry, node),
+            error_code,
+            failures);
+    }
+    aws_mutex_unlock(&queue->lock);
+}
+
+void aws_jni_offline_queue_get_statistics(
+    struct aws_jni_offline_queue *queue,
+    struct aws_jni_offline_queue_statistics *statistics) {
+    aws_mutex_lock(&queue->lock);
+    statistics->queued_messages = queue->message_count;
+    statistics->queued_bytes = queue->byte_count;
+    statistics->dropped_messages = queue->dropped_count;
+    aws_mutex_unlock(&queue->lock);
+}
+
+void aws_jni_offline_queue_complete_failures(struct aws_array_list *failures) {
+    size_t count = aws_array_list_length(failures);
+    for (size_t i = 0; i < count; ++i) {
+        struct aws_jni_offline_queue_failure *failure = NULL;
+        aws_array_list_get_at_ptr(failures, (void **)&failure, i);
+        if (failure->completion_options.completion_callback != NULL) {
+            failure->completion_options.completion_callback(
+                AWS_MQTT5_PT_NONE, NULL, failure->error_code, failure->completion_options.completion_user_data);
+        }
+    }
+    aws_array_list_clear(failures);
+}
@@ -0,0 +1,102 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_MQTT5_OFFLINE_QUEUE_H
+#define AWS_JNI_CRT_MQTT5_OFFLINE_QUEUE_H
+
+#include <aws/common/array_list.h>
+#include <aws/common/string.h>
+#include <aws/mqtt/v5/mqtt5_client.h>
+
+/*
+ * A bounded queue for the publishes an Mqtt5Client is asked to make while it is disconnected. Each publish is copied
+ * into a single encoded record, held in memory or, for QoS 1 when a spill file is configured, appended to the file,
+ * and the records are handed to the native client in order once it connects. When a limit would be exceeded, the
+ * overflow policy picks which message to drop, and the dropped message's completion is called with
+ * AWS_ERROR_MQTT5_OPERATION_FAILED_DUE_TO_OFFLINE_QUEUE_POLICY.
+ *
+ * Records in the spill file outlive the client: a queue opened on an existing file starts with the records it holds,
+ * which are published, without completions, when the new client first connects, and which count towards the limits
+ * like any other. A spilled record is marked dropped once its publish completes, acknowledged or failed, so only a
+ * publish cut short by a crash is made again from the file.
+ *
+ * The spill file is only ever read and written by a thread of the queue's own, never while holding the queue's lock,
+ * so a QoS 1 record reaches the file shortly after it's queued rather than before push returns.
+ *
+ * Safe to use from any thread.
+ */
+struct aws_jni_offline_queue;
+
+/* Must match Mqtt5ClientOptions.OfflineQueueOverflowPolicy */
+enum aws_jni_offline_queue_overflow_policy {
+    AWS_JNI_OQOP_DROP_NEWEST = 0,
+    AWS_JNI_OQOP_DROP_OLDEST = 1,
+    AWS_JNI_OQOP_DROP_QOS0_FIRST = 2,
+};
+
+struct aws_jni_offline_queue_options {
+    /* 0 for no limit */
+    size_t max_messages;
+    /* bytes of encoded records, 0 for no limit */
+    uint64_t max_bytes;
+    enum aws_jni_offline_queue_overflow_policy overflow_policy;
+    /* NULL to keep every record in memory */
+    const struct aws_string *spill_path;
+};
+
+struct aws_jni_offline_queue_statistics {
+    uint64_t queued_messages;
+    uint64_t queued_bytes;
+    uint64_t dropped_messages;
+};
+
+/* A message that left the queue without reaching the client, whose completion is still to be called */
+struct aws_jni_offline_queue_failure {
+    struct aws_mqtt5_publish_completion_options completion_options;
+    int error_code;
+};
+
+struct aws_jni_offline_queue *aws_jni_offline_queue_new(
+    struct aws_allocator *allocator,
+    const struct aws_jni_offline_queue_options *options);
+void aws_jni_offline_queue_destroy(struct aws_jni_offline_queue *queue);
+
+/*
+ * Queues publish and returns true while the client is offline; returns false while it is online, and the caller
+ * publishes it directly. Messages the overflow policy drops, which may include this one, are appended to failures
+ * (struct aws_jni_offline_queue_failure).
+ */
+bool aws_jni_offline_queue_push(
+    struct aws_jni_offline_queue *queue,
+    const struct aws_mqtt5_packet_publish_view *publish,
+    const struct aws_mqtt5_publish_completion_options *completion_options,
+    struct aws_array_list *failures);
+
+/*
+ * Publishes every queued message through the client, then marks it connected. With a spill file this happens on the
+ * queue's thread, which completes any message the client rejects itself; otherwise it happens before returning and
+ * those are appended to failures.
+ */
+void aws_jni_offline_queue_set_online(
+    struct aws_jni_offline_queue *queue,
+    struct aws_mqtt5_client *client,
+    struct aws_array_list *failures);
+
+void aws_jni_offline_queue_set_offline(struct aws_jni_offline_queue *queue);
+
+/*
+ * Takes every message out of the queue and appends it to failures; spilled records stay in the spill file. Waits for
+ * the queue's thread to finish spilling what was queued.
+ */
+void aws_jni_offline_queue_clear(struct aws_jni_offline_queue *queue, int error_code, struct aws_array_list *failures);
+
+void aws_jni_offline_queue_get_statistics(
+    struct aws_jni_offline_queue *queue,
+    struct aws_jni_offline_queue_statistics *statistics);
+
+/* Calls the completion of each failure with its error code, outside of any queue lock, and empties the list */
+void aws_jni_offline_queue_complete_failures(struct aws_array_list *failures);
+
+#endif /* AWS_JNI_CRT_MQTT5_OFFLINE_QUEUE_H */
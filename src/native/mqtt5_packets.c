@@ -562,7 +562,7 @@ static int s_get_user_properties_from_packet_optional(
     struct aws_array_list *jni_user_properties_struct_holder,
     const struct aws_mqtt5_user_property **packet_properties) {
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
 
     jobject jni_list = (*env)->GetObjectField(env, packet, packet_field);
     if (aws_jni_check_and_clear_exception(env)) {
@@ -0,0 +1,345 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "mqtt5_topic_router.h"
+
+#include <aws/common/atomics.h>
+#include <aws/common/error.h>
+#include <aws/common/hash_table.h>
+#include <aws/common/rw_lock.h>
+
+/* Topics deeper than this are split into a heap array instead of one on the stack */
+#define TOPIC_ROUTER_STACK_LEVELS 32
+
+static const struct aws_byte_cursor s_single_level_wildcard = {.ptr = (uint8_t *)"+", .len = 1};
+static const struct aws_byte_cursor s_multi_level_wildcard = {.ptr = (uint8_t *)"#", .len = 1};
+
+struct topic_router_node {
+    /* this node's level of the filter; the node owns the bytes, and the cursor is its key in the parent */
+    struct aws_byte_buf segment;
+    struct aws_byte_cursor segment_cursor;
+
+    /* struct aws_byte_cursor * -> struct topic_router_node *, only initialized once the node has children */
+    struct aws_hash_table children;
+
+    bool has_handler;
+    int64_t handler_id;
+};
+
+struct aws_jni_topic_router {
+    struct aws_allocator *allocator;
+    struct aws_rw_lock lock;
+    struct topic_router_node root;
+    struct aws_atomic_var handler_count;
+};
+
+static bool s_node_has_children(const struct topic_router_node *node) {
+    return node->children.p_impl != NULL && aws_hash_table_get_entry_count(&node->children) > 0;
+}
+
+static void s_node_clean_up(struct aws_allocator *allocator, struct topic_router_node *node);
+
+static void s_node_destroy(struct aws_allocator *allocator, struct topic_router_node *node) {
+    s_node_clean_up(allocator, node);
+    aws_mem_release(allocator, node);
+}
+
+static void s_node_clean_up(struct aws_allocator *allocator, struct topic_router_node *node) {
+    if (node->children.p_impl != NULL) {
+        for (struct aws_hash_iter iter = aws_hash_iter_begin(&node->children); !aws_hash_iter_done(&iter);
+             aws_hash_iter_next(&iter)) {
+            s_node_destroy(allocator, iter.element.value);
+        }
+        aws_hash_table_clean_up(&node->children);
+    }
+    aws_byte_buf_clean_up(&node->segment);
+}
+
+static struct topic_router_node *s_node_find_child(
+    const struct topic_router_node *node,
+    const struct aws_byte_cursor *segment) {
+    if (node->children.p_impl == NULL) {
+        return NULL;
+    }
+
+    struct aws_hash_element *element = NULL;
+    aws_hash_table_find(&node->children, segment, &element);
+    return element != NULL ? element->value : NULL;
+}
+
+static struct topic_router_node *s_node_find_or_add_child(
+    struct aws_allocator *allocator,
+    struct topic_router_node *node,
+    struct aws_byte_cursor segment) {
+
+    struct topic_router_node *child = s_node_find_child(node, &segment);
+    if (child != NULL) {
+        return child;
+    }
+
+    if (node->children.p_impl == NULL &&
+        aws_hash_table_init(&node->children, allocator, 4, aws_hash_byte_cursor_ptr, aws_byte_cursor_eq, NULL, NULL)) {
+        return NULL;
+    }
+
+    child = aws_mem_calloc(allocator, 1, sizeof(struct topic_router_node));
+    aws_byte_buf_init_copy_from_cursor(&child->segment, allocator, segment);
+    child->segment_cursor = aws_byte_cursor_from_buf(&child->segment);
+    if (aws_hash_table_put(&node->children, &child->segment_cursor, child, NULL)) {
+        s_node_destroy(allocator, child);
+        return NULL;
+    }
+    return child;
+}
+
+/*
+ * Splits a topic or filter into its levels. Returns the number of levels, which may be more than capacity, in which
+ * case only the first capacity levels were stored.
+ */
+static size_t s_split_levels(struct aws_byte_cursor topic, struct aws_byte_cursor *levels, size_t capacity) {
+    size_t count = 0;
+    const uint8_t *start = topic.ptr;
+    const uint8_t *end = topic.ptr + topic.len;
+    for (const uint8_t *current = start;; ++current) {
+        if (current == end || *current == '/') {
+            if (count < capacity) {
+                levels[count] = aws_byte_cursor_from_array(start, (size_t)(current - start));
+            }
+            ++count;
+            if (current == end) {
+                break;
+            }
+            start = current + 1;
+        }
+    }
+    return count;
+}
+
+/*
+ * Calls fn with the levels of topic, split into a stack array when there are few enough of them, so matching an
+ * ordinary topic doesn't allocate.
+ */
+typedef void(with_levels_fn)(const struct aws_byte_cursor *levels, size_t count, void *user_data);
+
+static void s_with_levels(
+    struct aws_allocator *allocator,
+    struct aws_byte_cursor topic,
+    with_levels_fn *fn,
+    void *user_data) {
+
+    struct aws_byte_cursor stack_levels[TOPIC_ROUTER_STACK_LEVELS];
+    size_t count = s_split_levels(topic, stack_levels, TOPIC_ROUTER_STACK_LEVELS);
+    if (count <= TOPIC_ROUTER_STACK_LEVELS) {
+        fn(stack_levels, count, user_data);
+        return;
+    }
+
+    struct aws_byte_cursor *heap_levels = aws_mem_calloc(allocator, count, sizeof(struct aws_byte_cursor));
+    s_split_levels(topic, heap_levels, count);
+    fn(heap_levels, count, user_data);
+    aws_mem_release(allocator, heap_levels);
+}
+
+static bool s_is_valid_filter(const struct aws_byte_cursor *levels, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const struct aws_byte_cursor *level = &levels[i];
+        for (size_t j = 0; j < level->len; ++j) {
+            if (level->ptr[j] != '+' && level->ptr[j] != '#') {
+                continue;
+            }
+            /* wildcards must be a whole level, and '#' can only be the last one */
+            if (level->len != 1 || (level->ptr[j] == '#' && i + 1 != count)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+struct topic_router_insert_args {
+    struct aws_jni_topic_router *router;
+    int64_t handler_id;
+    int result;
+};
+
+static void s_insert_levels(const struct aws_byte_cursor *levels, size_t count, void *user_data) {
+    struct topic_router_insert_args *args = user_data;
+    struct aws_jni_topic_router *router = args->router;
+
+    if (!s_is_valid_filter(levels, count)) {
+        args->result = aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+        return;
+    }
+
+    aws_rw_lock_wlock(&router->lock);
+    struct topic_router_node *node = &router->root;
+    for (size_t i = 0; i < count && node != NULL; ++i) {
+        node = s_node_find_or_add_child(router->allocator, node, levels[i]);
+    }
+    if (node == NULL) {
+        args->result = AWS_OP_ERR;
+    } else {
+        if (!node->has_handler) {
+            aws_atomic_fetch_add(&router->handler_count, 1);
+        }
+        node->has_handler = true;
+        node->handler_id = args->handler_id;
+    }
+    aws_rw_lock_wunlock(&router->lock);
+}
+
+struct topic_router_remove_args {
+    struct aws_jni_topic_router *router;
+    bool removed;
+};
+
+/* Removes the handler at the end of levels, and prunes each node the removal leaves empty on the way back up */
+static bool s_remove_from_node(
+    struct aws_allocator *allocator,
+    struct topic_router_node *node,
+    const struct aws_byte_cursor *levels,
+    size_t count,
+    bool *removed) {
+
+    if (count == 0) {
+        *removed = node->has_handler;
+        node->has_handler = false;
+    } else {
+        struct topic_router_node *child = s_node_find_child(node, &levels[0]);
+        if (child != NULL && s_remove_from_node(allocator, child, levels + 1, count - 1, removed)) {
+            aws_hash_table_remove(&node->children, &child->segment_cursor, NULL, NULL);
+            s_node_destroy(allocator, child);
+        }
+    }
+
+    return !node->has_handler && !s_node_has_children(node);
+}
+
+static void s_remove_levels(const struct aws_byte_cursor *levels, size_t count, void *user_data) {
+    struct topic_router_remove_args *args = user_data;
+    struct aws_jni_topic_router *router = args->router;
+
+    aws_rw_lock_wlock(&router->lock);
+    s_remove_from_node(router->allocator, &router->root, levels, count, &args->removed);
+    if (args->removed) {
+        aws_atomic_fetch_sub(&router->handler_count, 1);
+    }
+    aws_rw_lock_wunlock(&router->lock);
+}
+
+static void s_match_node(
+    const struct topic_router_node *node,
+    const struct aws_byte_cursor *levels,
+    size_t count,
+    size_t index,
+    struct aws_array_list *handler_ids) {
+
+    /* wildcards in the first level don't match topics like $SYS/... */
+    bool wildcards_match = index > 0 || levels[0].len == 0 || levels[0].ptr[0] != '$';
+
+    if (wildcards_match) {
+        const struct topic_router_node *any_levels = s_node_find_child(node, &s_multi_level_wildcard);
+        if (any_levels != NULL && any_levels->has_handler) {
+            aws_array_list_push_back(handler_ids, &any_levels->handler_id);
+        }
+    }
+
+    if (index == count) {
+        if (node->has_handler) {
+            aws_array_list_push_back(handler_ids, &node->handler_id);
+        }
+        return;
+    }
+
+    const struct topic_router_node *exact = s_node_find_child(node, &levels[index]);
+    if (exact != NULL) {
+        s_match_node(exact, levels, count, index + 1, handler_ids);
+    }
+
+    if (wildcards_match) {
+        const struct topic_router_node *one_level = s_node_find_child(node, &s_single_level_wildcard);
+        if (one_level != NULL) {
+            s_match_node(one_level, levels, count, index + 1, handler_ids);
+        }
+    }
+}
+
+struct topic_router_match_args {
+    struct aws_jni_topic_router *router;
+    struct aws_array_list *handler_ids;
+};
+
+static void s_match_levels(const struct aws_byte_cursor *levels, size_t count, void *user_data) {
+    struct topic_router_match_args *args = user_data;
+
+    aws_rw_lock_rlock(&args->router->lock);
+    s_match_node(&args->router->root, levels, count, 0, args->handler_ids);
+    aws_rw_lock_runlock(&args->router->lock);
+}
+
+struct aws_jni_topic_router *aws_jni_topic_router_new(struct aws_allocator *allocator) {
+    struct aws_jni_topic_router *router = aws_mem_calloc(allocator, 1, sizeof(struct aws_jni_topic_router));
+    router->allocator = allocator;
+    aws_rw_lock_init(&router->lock);
+    aws_atomic_init_int(&router->handler_count, 0);
+    return router;
+}
+
+void aws_jni_topic_router_destroy(struct aws_jni_topic_router *router) {
+    if (router == NULL) {
+        return;
+    }
+
+    s_node_clean_up(router->allocator, &router->root);
+    aws_rw_lock_clean_up(&router->lock);
+    aws_mem_release(router->allocator, router);
+}
+
+int aws_jni_topic_router_insert(
+    struct aws_jni_topic_router *router,
+    struct aws_byte_cursor topic_filter,
+    int64_t handler_id) {
+
+    if (topic_filter.len == 0) {
+        return aws_raise_error(AWS_ERROR_INVALID_ARGUMENT);
+    }
+
+    struct topic_router_insert_args args = {
+        .router = router,
+        .handler_id = handler_id,
+        .result = AWS_OP_SUCCESS,
+    };
+    s_with_levels(router->allocator, topic_filter, s_insert_levels, &args);
+    return args.result;
+}
+
+bool aws_jni_topic_router_remove(struct aws_jni_topic_router *router, struct aws_byte_cursor topic_filter) {
+    if (topic_filter.len == 0) {
+        return false;
+    }
+
+    struct topic_router_remove_args args = {
+        .router = router,
+        .removed = false,
+    };
+    s_with_levels(router->allocator, topic_filter, s_remove_levels, &args);
+    return args.removed;
+}
+
+bool aws_jni_topic_router_is_empty(struct aws_jni_topic_router *router) {
+    return aws_atomic_load_int(&router->handler_count) == 0;
+}
+
+void aws_jni_topic_router_match(
+    struct aws_jni_topic_router *router,
+    struct aws_byte_cursor topic,
+    struct aws_array_list *handler_ids) {
+
+    struct topic_router_match_args args = {
+        .router = router,
+        .handler_ids = handler_ids,
+    };
+    s_with_levels(router->allocator, topic, s_match_levels, &args);
+}
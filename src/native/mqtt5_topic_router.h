@@ -0,0 +1,43 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_MQTT5_TOPIC_ROUTER_H
+#define AWS_JNI_CRT_MQTT5_TOPIC_ROUTER_H
+
+#include <aws/common/array_list.h>
+#include <aws/common/byte_buf.h>
+
+/*
+ * A tree of MQTT topic filters, each mapped to the id of a Java handler, so incoming publishes can be matched
+ * against thousands of filters natively and only cross JNI when some handler wants them. Filters follow MQTT
+ * wildcard rules: '+' matches one level, a trailing '#' matches any number of levels (including none), and neither
+ * matches a first level starting with '$'.
+ *
+ * Safe to modify from any thread while publishes are being matched.
+ */
+struct aws_jni_topic_router;
+
+struct aws_jni_topic_router *aws_jni_topic_router_new(struct aws_allocator *allocator);
+void aws_jni_topic_router_destroy(struct aws_jni_topic_router *router);
+
+/* Routes topic_filter to handler_id, replacing any handler already routed from the same filter */
+int aws_jni_topic_router_insert(
+    struct aws_jni_topic_router *router,
+    struct aws_byte_cursor topic_filter,
+    int64_t handler_id);
+
+/* Returns true if topic_filter had a handler */
+bool aws_jni_topic_router_remove(struct aws_jni_topic_router *router, struct aws_byte_cursor topic_filter);
+
+/* Cheap check, so clients that don't route don't pay for matching */
+bool aws_jni_topic_router_is_empty(struct aws_jni_topic_router *router);
+
+/* Appends the id (int64_t) of every handler whose filter matches topic to handler_ids */
+void aws_jni_topic_router_match(
+    struct aws_jni_topic_router *router,
+    struct aws_byte_cursor topic,
+    struct aws_array_list *handler_ids);
+
+#endif /* AWS_JNI_CRT_MQTT5_TOPIC_ROUTER_H */
@@ -29,7 +29,7 @@ JNIEXPORT jlong JNICALL
         return (jlong)NULL;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
     struct aws_mqtt_client *client = aws_mqtt_client_new(allocator, bootstrap);
     if (client == NULL) {
         aws_jni_throw_runtime_exception(env, "MqttClient.mqtt_client_init: aws_mqtt_client_new failed");
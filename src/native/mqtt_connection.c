@@ -29,6 +29,7 @@
 
 #include "http_request_utils.h"
 #include "java_class_ids.h"
+#include "tls_handshake_metrics.h"
 
 /*******************************************************************************
  * mqtt_jni_async_callback - carries an AsyncCallback around as user data to mqtt
@@ -39,6 +40,36 @@ struct mqtt_jni_async_callback {
     struct mqtt_jni_connection *connection;
     jobject async_callback;
     struct aws_byte_buf buffer; /* payloads or other pinned resources go in here, freed when callback is delivered */
+
+    /* message handlers only: deliver payloads as direct ByteBuffers, and reuse the Strings of recent topics */
+    bool direct_payload;
+    struct mqtt_jni_topic_cache *topic_cache; /* created on the first delivery */
+    bool topic_cache_disabled;                /* set once the cache stopped paying for itself */
+};
+
+/*
+ * Recently delivered topics and their Java Strings, so a subscription that keeps receiving the same few topics
+ * doesn't create a new String for every message. Only touched from the connection's event loop.
+ */
+#define MQTT_JNI_TOPIC_CACHE_SIZE 8
+
+/*
+ * A wildcard subscription spread over many topics would miss on nearly every message and churn global refs, so the
+ * hit rate is checked every SAMPLE lookups and the cache is given up if fewer than 1 in MIN_HIT_RATIO hit.
+ */
+#define MQTT_JNI_TOPIC_CACHE_SAMPLE 64
+#define MQTT_JNI_TOPIC_CACHE_MIN_HIT_RATIO 4
+
+struct mqtt_jni_topic_cache_entry {
+    struct aws_byte_buf topic;
+    jstring jni_topic; /* global ref */
+};
+
+struct mqtt_jni_topic_cache {
+    struct mqtt_jni_topic_cache_entry entries[MQTT_JNI_TOPIC_CACHE_SIZE];
+    size_t next_eviction;
+    size_t lookups; /* in the current sample */
+    size_t hits;
 };
 
 /*******************************************************************************
@@ -106,16 +137,33 @@ static struct mqtt_jni_async_callback *s_mqtt_jni_async_callback_new(
         return NULL;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
     /* allocate cannot fail */
     struct mqtt_jni_async_callback *callback = aws_mem_calloc(allocator, 1, sizeof(struct mqtt_jni_async_callback));
     callback->connection = connection;
     callback->async_callback = async_callback ? (*env)->NewGlobalRef(env, async_callback) : NULL;
-    aws_byte_buf_init(&callback->buffer, aws_jni_get_allocator(), 0);
+    aws_byte_buf_init(&callback->buffer, aws_jni_mqtt_allocator(), 0);
 
     return callback;
 }
 
+static void s_mqtt_jni_topic_cache_destroy(struct mqtt_jni_async_callback *callback, JNIEnv *env) {
+    struct mqtt_jni_topic_cache *cache = callback->topic_cache;
+    if (cache == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < MQTT_JNI_TOPIC_CACHE_SIZE; ++i) {
+        struct mqtt_jni_topic_cache_entry *entry = &cache->entries[i];
+        if (entry->jni_topic) {
+            (*env)->DeleteGlobalRef(env, entry->jni_topic);
+        }
+        aws_byte_buf_clean_up(&entry->topic);
+    }
+    aws_mem_release(aws_jni_mqtt_allocator(), cache);
+    callback->topic_cache = NULL;
+}
+
 static void s_mqtt_jni_async_callback_destroy(struct mqtt_jni_async_callback *callback, JNIEnv *env) {
     AWS_FATAL_ASSERT(callback && callback->connection);
 
@@ -129,8 +177,93 @@ static void s_mqtt_jni_async_callback_destroy(struct mqtt_jni_async_callback *ca
 
     aws_byte_buf_clean_up(&callback->buffer);
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
-    aws_mem_release(allocator, callback);
+    s_mqtt_jni_topic_cache_destroy(callback, env);
+
+    aws_mem_release(aws_jni_mqtt_allocator(), callback);
+}
+
+/* A callback for a Java MessageHandler, which also says how it wants its payloads delivered */
+static struct mqtt_jni_async_callback *s_mqtt_jni_message_handler_new(
+    struct mqtt_jni_connection *connection,
+    jobject jni_handler,
+    JNIEnv *env) {
+
+    struct mqtt_jni_async_callback *handler = s_mqtt_jni_async_callback_new(connection, jni_handler, env);
+    if (handler != NULL && jni_handler != NULL) {
+        handler->direct_payload =
+            (*env)->GetBooleanField(env, jni_handler, message_handler_properties.direct_payload_field_id);
+    }
+    return handler;
+}
+
+/*
+ * Returns the String for topic, or NULL if one couldn't be made. It's a global ref owned by the cache, unless
+ * *out_is_local is set, in which case the caller must delete it.
+ */
+static jstring s_mqtt_jni_topic_cache_get(
+    struct mqtt_jni_async_callback *callback,
+    JNIEnv *env,
+    const struct aws_byte_cursor *topic,
+    bool *out_is_local) {
+
+    *out_is_local = false;
+    if (callback->topic_cache_disabled) {
+        *out_is_local = true;
+        return aws_jni_string_from_cursor(env, topic);
+    }
+
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
+    if (callback->topic_cache == NULL) {
+        callback->topic_cache = aws_mem_calloc(allocator, 1, sizeof(struct mqtt_jni_topic_cache));
+    }
+
+    struct mqtt_jni_topic_cache *cache = callback->topic_cache;
+    if (++cache->lookups > MQTT_JNI_TOPIC_CACHE_SAMPLE) {
+        if (cache->hits * MQTT_JNI_TOPIC_CACHE_MIN_HIT_RATIO < MQTT_JNI_TOPIC_CACHE_SAMPLE) {
+            AWS_LOGF_DEBUG(
+                AWS_LS_MQTT_CLIENT,
+                "id=%p: Only %zu of the last %d topics were cached, no longer caching topics for this handler",
+                (void *)callback->connection->client_connection,
+                cache->hits,
+                MQTT_JNI_TOPIC_CACHE_SAMPLE);
+            s_mqtt_jni_topic_cache_destroy(callback, env);
+            callback->topic_cache_disabled = true;
+            *out_is_local = true;
+            return aws_jni_string_from_cursor(env, topic);
+        }
+        cache->lookups = 1;
+        cache->hits = 0;
+    }
+
+    for (size_t i = 0; i < MQTT_JNI_TOPIC_CACHE_SIZE; ++i) {
+        struct mqtt_jni_topic_cache_entry *entry = &cache->entries[i];
+        if (entry->jni_topic != NULL && aws_byte_cursor_eq_byte_buf(topic, &entry->topic)) {
+            ++cache->hits;
+            return entry->jni_topic;
+        }
+    }
+
+    jstring jni_topic = aws_jni_string_from_cursor(env, topic);
+    if (jni_topic == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        return NULL;
+    }
+
+    struct mqtt_jni_topic_cache_entry *entry = &cache->entries[cache->next_eviction];
+    cache->next_eviction = (cache->next_eviction + 1) % MQTT_JNI_TOPIC_CACHE_SIZE;
+    if (entry->jni_topic != NULL) {
+        (*env)->DeleteGlobalRef(env, entry->jni_topic);
+    }
+    entry->jni_topic = (*env)->NewGlobalRef(env, jni_topic);
+    (*env)->DeleteLocalRef(env, jni_topic);
+
+    if (entry->topic.allocator == NULL) {
+        aws_byte_buf_init(&entry->topic, allocator, topic->len);
+    }
+    entry->topic.len = 0;
+    aws_byte_buf_append_dynamic(&entry->topic, topic);
+
+    return entry->jni_topic;
 }
 
 static jobject s_new_mqtt_exception(JNIEnv *env, int error_code) {
@@ -298,7 +431,7 @@ static struct mqtt_jni_connection *s_mqtt_connection_new(
     JNIEnv *env,
     struct aws_mqtt_client *client,
     jobject java_mqtt_connection) {
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
 
     struct mqtt_jni_connection *connection = aws_mem_calloc(allocator, 1, sizeof(struct mqtt_jni_connection));
     if (!connection) {
@@ -348,7 +481,7 @@ static void s_mqtt_connection_destroy(JNIEnv *env, struct mqtt_jni_connection *c
 
     aws_tls_connection_options_clean_up(&connection->tls_options);
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_mqtt_allocator();
     aws_mem_release(allocator, connection);
 }
 
@@ -358,6 +491,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_mqtt_MqttClientConnectio
     jlong jni_client,
     jobject jni_mqtt_connection) {
     (void)jni_class;
+    cache_java_class_ids_for_mqtt(env);
 
     struct aws_mqtt_client *client = (struct aws_mqtt_client *)jni_client;
     if (!client) {
@@ -479,8 +613,8 @@ void JNICALL Java_software_amazon_awssdk_crt_mqtt_MqttClientConnection_mqttClien
     struct aws_tls_connection_options *tls_options = NULL;
     if (tls_ctx) {
         tls_options = &connection->tls_options;
-        aws_tls_connection_options_init_from_ctx(tls_options, tls_ctx);
-        aws_tls_connection_options_set_server_name(tls_options, aws_jni_get_allocator(), &endpoint);
+        aws_jni_tls_connection_options_init_from_ctx(tls_options, tls_ctx);
+        aws_tls_connection_options_set_server_name(tls_options, aws_jni_mqtt_allocator(), &endpoint);
     }
 
     client_id = aws_jni_byte_cursor_from_jstring_acquire(env, jni_client_id);
@@ -666,18 +800,50 @@ static void s_on_subscription_delivered(
         return;
     }
 
-    jbyteArray jni_payload = (*env)->NewByteArray(env, (jsize)payload->len);
-    (*env)->SetByteArrayRegion(env, jni_payload, 0, (jsize)payload->len, (const signed char *)payload->ptr);
-
-    jstring jni_topic = aws_jni_string_from_cursor(env, topic);
-
-    (*env)->CallVoidMethod(
-        env, callback->async_callback, message_handler_properties.deliver, jni_topic, jni_payload, dup, qos, retain);
+    bool topic_is_local = false;
+    jstring jni_topic = s_mqtt_jni_topic_cache_get(callback, env, topic, &topic_is_local);
+    jobject jni_payload = NULL;
+    if (callback->direct_payload) {
+        /* NewDirectByteBuffer needs an address even when there's nothing there */
+        static uint8_t s_empty_payload = 0;
+        void *payload_ptr = payload->len > 0 ? payload->ptr : &s_empty_payload;
+        jni_payload = aws_jni_direct_byte_buffer_from_raw_ptr(env, payload_ptr, payload->len);
+    } else {
+        jni_payload = aws_jni_byte_array_from_cursor(env, payload);
+    }
 
-    (*env)->DeleteLocalRef(env, jni_payload);
-    (*env)->DeleteLocalRef(env, jni_topic);
+    if (jni_topic == NULL || jni_payload == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        AWS_LOGF_ERROR(
+            AWS_LS_MQTT_CLIENT,
+            "id=%p: Dropping message, could not create its topic or payload",
+            (void *)callback->connection->client_connection);
+    } else {
+        (*env)->CallVoidMethod(
+            env,
+            callback->async_callback,
+            callback->direct_payload ? message_handler_properties.deliver_direct : message_handler_properties.deliver,
+            jni_topic,
+            jni_payload,
+            dup,
+            qos,
+            retain);
+
+        /* A throwing handler loses only its own message, it mustn't take the process down with it */
+        if (aws_jni_check_and_clear_exception(env)) {
+            AWS_LOGF_ERROR(
+                AWS_LS_MQTT_CLIENT,
+                "id=%p: Message handler threw an exception",
+                (void *)callback->connection->client_connection);
+        }
+    }
 
-    AWS_FATAL_ASSERT(!aws_jni_check_and_clear_exception(env));
+    if (jni_payload != NULL) {
+        (*env)->DeleteLocalRef(env, jni_payload);
+    }
+    if (topic_is_local && jni_topic != NULL) {
+        (*env)->DeleteLocalRef(env, jni_topic);
+    }
 
     aws_jni_release_thread_env(callback->connection->jvm, env);
     /********** JNI ENV RELEASE **********/
@@ -699,7 +865,7 @@ jshort JNICALL Java_software_amazon_awssdk_crt_mqtt_MqttClientConnection_mqttCli
         return 0;
     }
 
-    struct mqtt_jni_async_callback *handler = s_mqtt_jni_async_callback_new(connection, jni_handler, env);
+    struct mqtt_jni_async_callback *handler = s_mqtt_jni_message_handler_new(connection, jni_handler, env);
     if (!handler) {
         aws_jni_throw_runtime_exception(env, "MqttClientConnection.mqtt_subscribe: Unable to allocate handler");
         return 0;
@@ -766,7 +932,7 @@ void JNICALL Java_software_amazon_awssdk_crt_mqtt_MqttClientConnection_mqttClien
         return;
     }
 
-    struct mqtt_jni_async_callback *handler = s_mqtt_jni_async_callback_new(connection, jni_handler, env);
+    struct mqtt_jni_async_callback *handler = s_mqtt_jni_message_handler_new(connection, jni_handler, env);
     if (!handler) {
         aws_jni_throw_runtime_exception(
             env, "MqttClientConnection.mqttClientConnectionOnMessage: Unable to allocate handler");
@@ -887,8 +1053,7 @@ jshort JNICALL Java_software_amazon_awssdk_crt_mqtt_MqttClientConnection_mqttCli
     }
 
     if (msg_id == 0) {
-        aws_jni_throw_runtime_exception(
-            env, "MqttClientConnection.mqtt_publish: aws_mqtt_client_connection_publish failed");
+        aws_jni_throw_crt_error(env, aws_last_error());
         goto error_cleanup;
     }
 
@@ -1003,7 +1168,7 @@ static void s_ws_handshake_destroy(struct mqtt_jni_ws_handshake *ws_handshake) {
     }
 
     s_mqtt_jni_connection_release(ws_handshake->connection);
-    aws_mem_release(aws_jni_get_allocator(), ws_handshake);
+    aws_mem_release(aws_jni_mqtt_allocator(), ws_handshake);
 }
 
 static void s_ws_handshake_transform(
@@ -1022,7 +1187,7 @@ static void s_ws_handshake_transform(
         return;
     }
 
-    struct aws_allocator *alloc = aws_jni_get_allocator();
+    struct aws_allocator *alloc = aws_jni_mqtt_allocator();
 
     struct mqtt_jni_ws_handshake *ws_handshake = aws_mem_calloc(alloc, 1, sizeof(struct mqtt_jni_ws_handshake));
     if (!ws_handshake) {
@@ -1168,9 +1333,9 @@ void JNICALL Java_software_amazon_awssdk_crt_mqtt_MqttClientConnection_mqttClien
 
     if (jni_proxy_tls_context != 0) {
         struct aws_tls_ctx *proxy_tls_ctx = (struct aws_tls_ctx *)jni_proxy_tls_context;
-        aws_tls_connection_options_init_from_ctx(&proxy_tls_conn_options, proxy_tls_ctx);
+        aws_jni_tls_connection_options_init_from_ctx(&proxy_tls_conn_options, proxy_tls_ctx);
         aws_tls_connection_options_set_server_name(
-            &proxy_tls_conn_options, aws_jni_get_allocator(), &proxy_options.host);
+            &proxy_tls_conn_options, aws_jni_mqtt_allocator(), &proxy_options.host);
         proxy_options.tls_options = &proxy_tls_conn_options;
     }
 
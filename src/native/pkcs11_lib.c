@@ -46,7 +46,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_io_Pkcs11Lib_pkcs11LibNe
     options.initialize_finalize_behavior = jni_initialize_finalize_behavior;
 
     /* create aws_pkcs11_lib */
-    pkcs11_lib = aws_pkcs11_lib_new(aws_jni_get_allocator(), &options);
+    pkcs11_lib = aws_pkcs11_lib_new(aws_jni_io_allocator(), &options);
     if (pkcs11_lib == NULL) {
         aws_jni_throw_runtime_exception(env, "Pkcs11Lib() failed.");
         goto cleanup;
@@ -6,6 +6,18 @@
 #include "http_request_utils.h"
 #include "java_class_ids.h"
 #include "retry_utils.h"
+#include "checksums.h"
+#include "s3_part_buffers.h"
+#include "tracing.h"
+#include "tls_handshake_metrics.h"
+#include <aws/checksums/crc.h>
+#include <aws/common/atomics.h>
+#include <aws/common/clock.h>
+#include <aws/common/condition_variable.h>
+#include <aws/common/file.h>
+#include <aws/common/math.h>
+#include <aws/common/mutex.h>
+#include <aws/common/ref_count.h>
 #include <aws/common/string.h>
 #include <aws/http/request_response.h>
 #include <aws/io/channel_bootstrap.h>
@@ -16,6 +28,16 @@
 #include <aws/s3/s3_client.h>
 #include <jni.h>
 
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#    include <fcntl.h>
+#    include <unistd.h>
+#endif
+
 /* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
 #if UINTPTR_MAX == 0xffffffff
 #    if defined(_MSC_VER)
@@ -34,15 +56,241 @@ struct s3_client_callback_data {
     jobject java_s3_client;
 };
 
+/*
+ * Live counters for S3Client.getStatistics(). Owned by the Java S3Client and by every meta request made with it,
+ * so meta requests that finish shutting down after the client is closed never touch freed memory.
+ */
+struct s3_client_statistics {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+    struct aws_atomic_var active_meta_requests;
+    struct aws_atomic_var total_meta_requests;
+    struct aws_atomic_var response_body_bytes;
+};
+
+static void s_s3_client_statistics_destroy(void *user_data) {
+    struct s3_client_statistics *statistics = user_data;
+    aws_mem_release(statistics->allocator, statistics);
+}
+
+/*
+ * Destination for response bodies that are written natively instead of being delivered to Java.
+ * aws-c-s3 delivers body parts serially and in object order, so parts are appended at a running offset,
+ * which also lets a resumed download (whose ranges start mid-object) land at the right place.
+ */
+struct s3_response_file {
+#if defined(_WIN32)
+    FILE *fp;
+#else
+    int fd;
+#endif
+};
+
+static struct s3_response_file *s_s3_response_file_new(
+    struct aws_allocator *allocator,
+    const struct aws_string *path,
+    bool truncate) {
+    struct s3_response_file *file = aws_mem_calloc(allocator, 1, sizeof(struct s3_response_file));
+    AWS_FATAL_ASSERT(file);
+#if defined(_WIN32)
+    /* "r+b" keeps the parts a resumed download already wrote, but requires the file to exist */
+    file->fp = aws_fopen(aws_string_c_str(path), truncate ? "wb" : "r+b");
+    if (file->fp == NULL && !truncate) {
+        file->fp = aws_fopen(aws_string_c_str(path), "wb");
+    }
+    if (file->fp == NULL) {
+        goto error;
+    }
+#else
+    file->fd = open(aws_string_c_str(path), O_WRONLY | O_CREAT | (truncate ? O_TRUNC : 0), 0644);
+    if (file->fd < 0) {
+        aws_translate_and_raise_io_error(errno);
+        goto error;
+    }
+#endif
+    return file;
+
+error:
+    aws_mem_release(allocator, file);
+    return NULL;
+}
+
+static int s_s3_response_file_write(struct s3_response_file *file, struct aws_byte_cursor data, uint64_t offset) {
+#if defined(_WIN32)
+    if (_fseeki64(file->fp, (__int64)offset, SEEK_SET) != 0 || fwrite(data.ptr, 1, data.len, file->fp) != data.len) {
+        return aws_translate_and_raise_io_error(errno);
+    }
+#else
+    while (data.len > 0) {
+        ssize_t written = pwrite(file->fd, data.ptr, data.len, (off_t)offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return aws_translate_and_raise_io_error(errno);
+        }
+        aws_byte_cursor_advance(&data, (size_t)written);
+        offset += (uint64_t)written;
+    }
+#endif
+    return AWS_OP_SUCCESS;
+}
+
+static void s_s3_response_file_destroy(struct aws_allocator *allocator, struct s3_response_file *file) {
+    if (file == NULL) {
+        return;
+    }
+#if defined(_WIN32)
+    fclose(file->fp);
+#else
+    close(file->fd);
+#endif
+    aws_mem_release(allocator, file);
+}
+
+/*
+ * aws-c-s3 has no resume tokens for GetObject, so downloads to a response file are tracked here instead.
+ * Body parts arrive in object order, so the completed parts are always a prefix of the object, and a
+ * resumed download simply issues a ranged GET from the first missing part.
+ */
+struct s3_download_resume_state {
+    struct aws_mutex lock;
+    uint64_t part_size;
+    uint64_t object_size;
+    /* bytes written to the response file, contiguous from the start of the object */
+    uint64_t bytes_completed;
+    struct aws_string *etag;
+    /* If true, object_size and etag came from a ResumeToken rather than from this response */
+    bool resumed;
+    bool paused;
+};
+
+/*
+ * Progress from aws-c-s3 (or from download-to-file writes) is accumulated here and only delivered to Java once
+ * the configured byte or time interval has been reached, so JNI upcalls scale with time rather than part count.
+ */
+struct s3_progress_state {
+    struct aws_mutex lock;
+    uint64_t interval_bytes;
+    uint64_t interval_ns;
+    uint64_t pending_bytes;
+    uint64_t content_length;
+    uint64_t last_delivery_ns;
+    bool reuse_progress_object;
+    /* Global ref, only touched by the thread that set upcall_in_flight */
+    jobject reusable_progress_object;
+    bool upcall_in_flight;
+    /* Signalled whenever upcall_in_flight is cleared */
+    struct aws_condition_variable upcall_done;
+    /* Once set, anything still pending is delivered regardless of the intervals */
+    bool finished;
+};
+
+/* ChecksumAlgorithm.CRC64NVME, only computed by the binding */
+#define S3_CHECKSUM_ALGORITHM_CRC64NVME 5
+
+/*
+ * Timings observed by the binding itself, aws-c-s3 in this tree doesn't expose per-request metrics.
+ * Only touched from the serialized headers/body/finish callbacks, so no locking is needed.
+ */
+struct s3_meta_request_metrics {
+    bool enabled;
+    uint64_t start_ns;
+    uint64_t headers_ns;
+    uint64_t first_body_ns;
+    uint64_t bytes_received;
+    /* one s3_part_metrics per body part, in delivery order */
+    struct aws_array_list parts;
+    /*
+     * whole-body checksum, computed while each part is hot in cache, AWS_SCA_NONE if not requested.
+     * An aws_s3_checksum_algorithm, or S3_CHECKSUM_ALGORITHM_CRC64NVME which aws-c-s3 doesn't know about.
+     */
+    int checksum_algorithm;
+    uint64_t checksum;
+    uint64_t checksum_ns;
+};
+
+struct s3_part_metrics {
+    uint64_t range_start;
+    uint64_t size;
+    uint64_t arrival_ns;
+};
+
+static uint64_t s_s3_metrics_elapsed_ns(const struct s3_meta_request_metrics *metrics) {
+    uint64_t now = 0;
+    aws_high_res_clock_get_ticks(&now);
+    return now - metrics->start_ns;
+}
+
+/*
+ * A caller-provided direct ByteBuffer that receives one byte range of the object, see S3Client.makeRangedGetBatch().
+ * The Java buffer is kept alive by a global ref, and its position is advanced past what was written at finish.
+ */
+struct s3_response_buffer {
+    jobject java_buffer;
+    uint8_t *ptr;
+    jint position;
+    uint64_t object_offset;
+    size_t length;
+    size_t written;
+};
+
+static void s_s3_metrics_update_checksum(struct s3_meta_request_metrics *metrics, struct aws_byte_cursor data) {
+    uint64_t start_ns = 0;
+    aws_high_res_clock_get_ticks(&start_ns);
+    if (metrics->checksum_algorithm == S3_CHECKSUM_ALGORITHM_CRC64NVME) {
+        metrics->checksum = aws_jni_crc64nvme(data.ptr, data.len, metrics->checksum);
+    } else {
+        uint32_t (*checksum_fn)(const uint8_t *, int, uint32_t) =
+            metrics->checksum_algorithm == AWS_SCA_CRC32C ? aws_checksums_crc32c : aws_checksums_crc32;
+        uint32_t checksum = (uint32_t)metrics->checksum;
+        while (data.len > INT_MAX) {
+            checksum = checksum_fn(data.ptr, INT_MAX, checksum);
+            aws_byte_cursor_advance(&data, INT_MAX);
+        }
+        metrics->checksum = checksum_fn(data.ptr, (int)data.len, checksum);
+    }
+
+    uint64_t end_ns = 0;
+    aws_high_res_clock_get_ticks(&end_ns);
+    metrics->checksum_ns += end_ns - start_ns;
+}
+
+/* Granularity of GetObject resume tokens when the client has no part size configured, matches aws-c-s3 */
+static const uint64_t s_default_download_part_size = 8 * 1024 * 1024;
+
 struct s3_client_make_meta_request_callback_data {
     JavaVM *jvm;
     jobject java_s3_meta_request;
     jobject java_s3_meta_request_response_handler_native_adapter;
     struct aws_input_stream *input_stream;
+    /* If true, body parts are delivered to Java as direct ByteBuffers over native memory instead of byte[] copies */
+    bool zero_copy_response_body;
+    /* If set, the response body is written to this file natively and never delivered to Java */
+    struct s3_response_file *response_file;
+    /* Tracks what response_file holds, so a paused download can be resumed. Only used with response_file. */
+    struct s3_download_resume_state download_state;
+    struct s3_progress_state progress_state;
+    struct s3_meta_request_metrics metrics;
+    /* Counts towards S3Client.getStatistics(), holds a reference once the meta request has been made */
+    struct s3_client_statistics *client_statistics;
+    /* Whether this meta request still counts as active */
+    bool counted_active;
+    /* If not empty, the body is copied into these buffers (struct s3_response_buffer) instead of reaching Java */
+    struct aws_array_list response_buffers;
+    /* Object offset of the next body byte, body parts arrive in order */
+    uint64_t response_buffers_offset;
 };
 
 static void s_on_s3_client_shutdown_complete_callback(void *user_data);
 static void s_on_s3_meta_request_shutdown_complete_callback(void *user_data);
+static void s_on_s3_meta_request_progress_callback(
+    struct aws_s3_meta_request *meta_request,
+    const struct aws_s3_meta_request_progress *progress,
+    void *user_data);
+static void s_s3_meta_request_flush_progress(
+    struct aws_s3_meta_request *meta_request,
+    struct s3_client_make_meta_request_callback_data *callback_data);
 
 JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientNew(
     JNIEnv *env,
@@ -61,8 +309,9 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientNew(
     jobject jni_standard_retry_options,
     jboolean compute_content_md5) {
     (void)jni_class;
+    cache_java_class_ids_for_s3(env);
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_s3_allocator();
 
     struct aws_client_bootstrap *client_bootstrap = (struct aws_client_bootstrap *)jni_client_bootstrap;
 
@@ -128,7 +377,7 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientNew(
     if (jni_tls_ctx) {
         struct aws_tls_ctx *tls_ctx = (void *)jni_tls_ctx;
         tls_options = &tls_options_storage;
-        aws_tls_connection_options_init_from_ctx(tls_options, tls_ctx);
+        aws_jni_tls_connection_options_init_from_ctx(tls_options, tls_ctx);
         struct aws_byte_cursor endpoint = aws_jni_byte_cursor_from_jbyteArray_acquire(env, jni_endpoint);
         aws_tls_connection_options_set_server_name(tls_options, allocator, &endpoint);
         aws_jni_byte_cursor_from_jbyteArray_release(env, jni_endpoint, endpoint);
@@ -204,7 +453,7 @@ static void s_on_s3_client_shutdown_complete_callback(void *user_data) {
     aws_jni_release_thread_env(callback->jvm, env);
     /********** JNI ENV RELEASE **********/
 
-    aws_mem_release(aws_jni_get_allocator(), user_data);
+    aws_mem_release(aws_jni_s3_allocator(), user_data);
 }
 
 static int s_on_s3_meta_request_body_callback(
@@ -212,6 +461,7 @@ static int s_on_s3_meta_request_body_callback(
     const struct aws_byte_cursor *body,
     uint64_t range_start,
     void *user_data) {
+    AWS_JNI_TRACE_SPAN("s3.body", meta_request);
     (void)body;
     (void)range_start;
     int return_value = AWS_OP_ERR;
@@ -221,6 +471,91 @@ static int s_on_s3_meta_request_body_callback(
     struct s3_client_make_meta_request_callback_data *callback_data =
         (struct s3_client_make_meta_request_callback_data *)user_data;
 
+    if (callback_data->client_statistics != NULL) {
+        aws_atomic_fetch_add(&callback_data->client_statistics->response_body_bytes, body->len);
+    }
+
+    if (callback_data->metrics.enabled) {
+        struct s3_part_metrics part_metrics = {
+            .range_start = range_start,
+            .size = body->len,
+            .arrival_ns = s_s3_metrics_elapsed_ns(&callback_data->metrics),
+        };
+        if (callback_data->metrics.first_body_ns == 0) {
+            callback_data->metrics.first_body_ns = part_metrics.arrival_ns;
+        }
+        callback_data->metrics.bytes_received += body->len;
+        aws_array_list_push_back(&callback_data->metrics.parts, &part_metrics);
+
+        if (callback_data->metrics.checksum_algorithm != AWS_SCA_NONE) {
+            s_s3_metrics_update_checksum(&callback_data->metrics, *body);
+        }
+    }
+
+    const size_t num_response_buffers = aws_array_list_length(&callback_data->response_buffers);
+    if (num_response_buffers > 0) {
+        /* Ranged batch mode: copy the overlap with each destination, bytes in gaps between ranges are dropped */
+        uint64_t body_start = callback_data->response_buffers_offset;
+        uint64_t body_end = body_start + body->len;
+        for (size_t i = 0; i < num_response_buffers; ++i) {
+            struct s3_response_buffer *response_buffer = NULL;
+            aws_array_list_get_at_ptr(&callback_data->response_buffers, (void **)&response_buffer, i);
+            uint64_t destination_end = response_buffer->object_offset + response_buffer->length;
+            uint64_t copy_start = aws_max_u64(body_start, response_buffer->object_offset);
+            uint64_t copy_end = aws_min_u64(body_end, destination_end);
+            if (copy_start < copy_end) {
+                memcpy(
+                    response_buffer->ptr + (copy_start - response_buffer->object_offset),
+                    body->ptr + (copy_start - body_start),
+                    (size_t)(copy_end - copy_start));
+                response_buffer->written =
+                    aws_max_size(response_buffer->written, (size_t)(copy_end - response_buffer->object_offset));
+            }
+        }
+        callback_data->response_buffers_offset = body_end;
+        aws_s3_meta_request_increment_read_window(meta_request, body->len);
+        return AWS_OP_SUCCESS;
+    }
+
+    if (callback_data->response_file != NULL) {
+        /* Download-to-file mode: the body never crosses JNI, only progress is reported */
+        struct s3_download_resume_state *download_state = &callback_data->download_state;
+        aws_mutex_lock(&download_state->lock);
+        bool paused = download_state->paused;
+        uint64_t write_offset = download_state->bytes_completed;
+        uint64_t object_size = download_state->object_size;
+        aws_mutex_unlock(&download_state->lock);
+
+        if (paused) {
+            /* The resume token has already been handed out, don't write past what it describes */
+            return AWS_OP_SUCCESS;
+        }
+
+        if (s_s3_response_file_write(callback_data->response_file, *body, write_offset)) {
+            AWS_LOGF_ERROR(
+                AWS_LS_S3_META_REQUEST,
+                "id=%p: Failed to write response body to file, error %d (%s)",
+                (void *)meta_request,
+                aws_last_error(),
+                aws_error_str(aws_last_error()));
+            return AWS_OP_ERR;
+        }
+
+        aws_mutex_lock(&download_state->lock);
+        download_state->bytes_completed += body->len;
+        aws_mutex_unlock(&download_state->lock);
+
+        /* Nothing in Java is consuming the data, so keep the flow-control window open */
+        aws_s3_meta_request_increment_read_window(meta_request, body->len);
+
+        struct aws_s3_meta_request_progress progress = {
+            .bytes_transferred = body->len,
+            .content_length = object_size,
+        };
+        s_on_s3_meta_request_progress_callback(meta_request, &progress, user_data);
+        return AWS_OP_SUCCESS;
+    }
+
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
     if (env == NULL) {
@@ -228,7 +563,27 @@ static int s_on_s3_meta_request_body_callback(
         return AWS_OP_ERR;
     }
 
-    jobject jni_payload = aws_jni_byte_array_from_cursor(env, body);
+    /*
+     * In zero-copy mode the ByteBuffer wraps the native part buffer directly. It is only valid for the
+     * duration of the upcall, aws-c-s3 reuses the memory as soon as this callback returns.
+     */
+    jobject jni_payload = NULL;
+    jmethodID on_response_body_method_id = NULL;
+    if (callback_data->zero_copy_response_body) {
+        jni_payload = aws_jni_direct_byte_buffer_from_raw_ptr(env, body->ptr, body->len);
+        on_response_body_method_id = s3_meta_request_response_handler_native_adapter_properties.onResponseBodyDirect;
+    } else {
+        jni_payload = aws_jni_byte_array_from_cursor(env, body);
+        on_response_body_method_id = s3_meta_request_response_handler_native_adapter_properties.onResponseBody;
+    }
+
+    if (jni_payload == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        AWS_LOGF_ERROR(
+            AWS_LS_S3_META_REQUEST, "id=%p: Failed to create Java buffer for response body", (void *)meta_request);
+        aws_raise_error(AWS_ERROR_OOM);
+        goto cleanup;
+    }
 
     jint body_response_result = 0;
 
@@ -236,7 +591,7 @@ static int s_on_s3_meta_request_body_callback(
         body_response_result = (*env)->CallIntMethod(
             env,
             callback_data->java_s3_meta_request_response_handler_native_adapter,
-            s3_meta_request_response_handler_native_adapter_properties.onResponseBody,
+            on_response_body_method_id,
             jni_payload,
             range_start,
             range_end);
@@ -258,7 +613,9 @@ static int s_on_s3_meta_request_body_callback(
     return_value = AWS_OP_SUCCESS;
 
 cleanup:
-    (*env)->DeleteLocalRef(env, jni_payload);
+    if (jni_payload != NULL) {
+        (*env)->DeleteLocalRef(env, jni_payload);
+    }
 
     aws_jni_release_thread_env(callback_data->jvm, env);
     /********** JNI ENV RELEASE **********/
@@ -271,10 +628,34 @@ static int s_on_s3_meta_request_headers_callback(
     const struct aws_http_headers *headers,
     int response_status,
     void *user_data) {
+    AWS_JNI_TRACE_SPAN("s3.headers", meta_request);
     int return_value = AWS_OP_ERR;
     struct s3_client_make_meta_request_callback_data *callback_data =
         (struct s3_client_make_meta_request_callback_data *)user_data;
 
+    if (callback_data->metrics.enabled && callback_data->metrics.headers_ns == 0) {
+        callback_data->metrics.headers_ns = s_s3_metrics_elapsed_ns(&callback_data->metrics);
+    }
+
+    if (callback_data->response_file != NULL && !callback_data->download_state.resumed) {
+        /* A resumed download's ranged response only describes the remainder, the token describes the object */
+        struct s3_download_resume_state *download_state = &callback_data->download_state;
+        aws_mutex_lock(&download_state->lock);
+        struct aws_byte_cursor header_cursor;
+        if (aws_http_headers_get(headers, aws_byte_cursor_from_c_str("Content-Length"), &header_cursor) ==
+            AWS_OP_SUCCESS) {
+            uint64_t content_length = 0;
+            if (aws_byte_cursor_utf8_parse_u64(header_cursor, &content_length) == AWS_OP_SUCCESS) {
+                download_state->object_size = content_length;
+            }
+        }
+        if (download_state->etag == NULL &&
+            aws_http_headers_get(headers, aws_byte_cursor_from_c_str("ETag"), &header_cursor) == AWS_OP_SUCCESS) {
+            download_state->etag = aws_string_new_from_cursor(aws_jni_s3_allocator(), &header_cursor);
+        }
+        aws_mutex_unlock(&download_state->lock);
+    }
+
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
     if (env == NULL) {
@@ -283,7 +664,7 @@ static int s_on_s3_meta_request_headers_callback(
     }
 
     jobject java_headers_buffer = NULL;
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_s3_allocator();
     /* calculate initial header capacity */
     size_t headers_initial_capacity = 0;
     for (size_t header_index = 0; header_index < aws_http_headers_count(headers); ++header_index) {
@@ -338,16 +719,79 @@ cleanup:
     return return_value;
 }
 
+/* Packs the recorded metrics into a long[] and hands them to Java in a single upcall */
+static void s_s3_meta_request_deliver_metrics(
+    JNIEnv *env,
+    struct aws_s3_meta_request *meta_request,
+    struct s3_client_make_meta_request_callback_data *callback_data) {
+
+    struct s3_meta_request_metrics *metrics = &callback_data->metrics;
+    uint64_t duration_ns = s_s3_metrics_elapsed_ns(metrics);
+    size_t num_parts = aws_array_list_length(&metrics->parts);
+
+    jlongArray parts_jni = (*env)->NewLongArray(env, (jsize)(num_parts * 3));
+    if (parts_jni == NULL) {
+        aws_jni_check_and_clear_exception(env);
+        AWS_LOGF_ERROR(AWS_LS_S3_META_REQUEST, "id=%p: Failed to create array for metrics", (void *)meta_request);
+        return;
+    }
+
+    jlong *parts = (*env)->GetPrimitiveArrayCritical(env, parts_jni, NULL);
+    if (parts != NULL) {
+        for (size_t part_index = 0; part_index < num_parts; ++part_index) {
+            struct s3_part_metrics *part_metrics = NULL;
+            aws_array_list_get_at_ptr(&metrics->parts, (void **)&part_metrics, part_index);
+            parts[part_index * 3] = (jlong)part_metrics->range_start;
+            parts[part_index * 3 + 1] = (jlong)part_metrics->size;
+            parts[part_index * 3 + 2] = (jlong)part_metrics->arrival_ns;
+        }
+        (*env)->ReleasePrimitiveArrayCritical(env, parts_jni, parts, 0);
+    }
+
+    (*env)->CallVoidMethod(
+        env,
+        callback_data->java_s3_meta_request_response_handler_native_adapter,
+        s3_meta_request_response_handler_native_adapter_properties.onMetrics,
+        metrics->headers_ns != 0 ? (jlong)metrics->headers_ns : (jlong)-1,
+        metrics->first_body_ns != 0 ? (jlong)metrics->first_body_ns : (jlong)-1,
+        (jlong)duration_ns,
+        (jlong)metrics->bytes_received,
+        parts_jni,
+        (jint)metrics->checksum_algorithm,
+        (jlong)metrics->checksum,
+        (jlong)metrics->checksum_ns);
+
+    if (aws_jni_check_and_clear_exception(env)) {
+        AWS_LOGF_ERROR(
+            AWS_LS_S3_META_REQUEST,
+            "id=%p: Ignored Exception from S3MetaRequest.onMetrics callback",
+            (void *)meta_request);
+    }
+    (*env)->DeleteLocalRef(env, parts_jni);
+}
+
 static void s_on_s3_meta_request_finish_callback(
     struct aws_s3_meta_request *meta_request,
     const struct aws_s3_meta_request_result *meta_request_result,
     void *user_data) {
+    AWS_JNI_TRACE_SPAN("s3.finish", meta_request);
 
     (void)meta_request;
 
     struct s3_client_make_meta_request_callback_data *callback_data =
         (struct s3_client_make_meta_request_callback_data *)user_data;
 
+    if (callback_data->counted_active) {
+        aws_atomic_fetch_sub(&callback_data->client_statistics->active_meta_requests, 1);
+        callback_data->counted_active = false;
+    }
+
+    /* report progress that was still being coalesced before the request is reported finished */
+    aws_mutex_lock(&callback_data->progress_state.lock);
+    callback_data->progress_state.finished = true;
+    aws_mutex_unlock(&callback_data->progress_state.lock);
+    s_s3_meta_request_flush_progress(meta_request, callback_data);
+
     /********** JNI ENV ACQUIRE **********/
     JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
     if (env == NULL) {
@@ -355,6 +799,28 @@ static void s_on_s3_meta_request_finish_callback(
         return;
     }
 
+    int error_code = meta_request_result->error_code;
+    if (callback_data->response_file != NULL && error_code == AWS_ERROR_S3_CANCELED) {
+        /* Downloads are paused by cancelling them, report it the same way aws-c-s3 reports a paused upload */
+        aws_mutex_lock(&callback_data->download_state.lock);
+        if (callback_data->download_state.paused) {
+            error_code = AWS_ERROR_S3_PAUSED;
+        }
+        aws_mutex_unlock(&callback_data->download_state.lock);
+    }
+
+    for (size_t i = 0; i < aws_array_list_length(&callback_data->response_buffers); ++i) {
+        struct s3_response_buffer *response_buffer = NULL;
+        aws_array_list_get_at_ptr(&callback_data->response_buffers, (void **)&response_buffer, i);
+        aws_jni_byte_buffer_set_position(
+            env, response_buffer->java_buffer, response_buffer->position + (jint)response_buffer->written);
+        aws_jni_check_and_clear_exception(env);
+    }
+
+    if (callback_data->metrics.enabled && callback_data->java_s3_meta_request_response_handler_native_adapter != NULL) {
+        s_s3_meta_request_deliver_metrics(env, meta_request, callback_data);
+    }
+
     if (callback_data->java_s3_meta_request_response_handler_native_adapter != NULL) {
         struct aws_byte_buf *error_response_body = meta_request_result->error_response_body;
         struct aws_byte_cursor error_response_cursor;
@@ -367,7 +833,7 @@ static void s_on_s3_meta_request_finish_callback(
             env,
             callback_data->java_s3_meta_request_response_handler_native_adapter,
             s3_meta_request_response_handler_native_adapter_properties.onFinished,
-            meta_request_result->error_code,
+            error_code,
             meta_request_result->response_status,
             jni_payload,
             meta_request_result->validation_algorithm,
@@ -386,39 +852,61 @@ static void s_on_s3_meta_request_finish_callback(
     /********** JNI ENV RELEASE **********/
 }
 
-static void s_on_s3_meta_request_progress_callback(
-    struct aws_s3_meta_request *meta_request,
-    const struct aws_s3_meta_request_progress *progress,
-    void *user_data) {
-
-    (void)meta_request;
+static bool s_s3_progress_is_due(const struct s3_progress_state *progress_state) {
+    if (progress_state->pending_bytes == 0) {
+        return false;
+    }
+    if (progress_state->interval_bytes == 0 && progress_state->interval_ns == 0) {
+        return true;
+    }
+    if (progress_state->interval_bytes > 0 && progress_state->pending_bytes >= progress_state->interval_bytes) {
+        return true;
+    }
+    if (progress_state->interval_ns > 0) {
+        uint64_t now = 0;
+        aws_high_res_clock_get_ticks(&now);
+        return now - progress_state->last_delivery_ns >= progress_state->interval_ns;
+    }
+    return false;
+}
 
-    struct s3_client_make_meta_request_callback_data *callback_data =
-        (struct s3_client_make_meta_request_callback_data *)user_data;
+/*
+ * Makes a single onProgress upcall. If the meta request reuses one progress object, it is created on first use
+ * and kept as a global ref until the meta request is cleaned up.
+ */
+static void s_s3_meta_request_deliver_progress(
+    JNIEnv *env,
+    struct aws_s3_meta_request *meta_request,
+    struct s3_client_make_meta_request_callback_data *callback_data,
+    uint64_t bytes_transferred,
+    uint64_t content_length) {
 
-    /********** JNI ENV ACQUIRE **********/
-    JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
-    if (env == NULL) {
-        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
-        return;
-    }
+    jobject progress_object = callback_data->progress_state.reusable_progress_object;
+    if (progress_object == NULL) {
+        progress_object = (*env)->NewObject(
+            env,
+            s3_meta_request_progress_properties.s3_meta_request_progress_class,
+            s3_meta_request_progress_properties.s3_meta_request_progress_constructor_method_id);
+        if ((*env)->ExceptionCheck(env) || progress_object == NULL) {
+            /* progress object constructor failed, nothing to do */
+            aws_jni_check_and_clear_exception(env);
+            return;
+        }
 
-    jobject progress_object = (*env)->NewObject(
-        env,
-        s3_meta_request_progress_properties.s3_meta_request_progress_class,
-        s3_meta_request_progress_properties.s3_meta_request_progress_constructor_method_id);
-    if ((*env)->ExceptionCheck(env) || progress_object == NULL) {
-        /* progress object constructor failed, nothing to do */
-        goto done;
+        if (callback_data->progress_state.reuse_progress_object) {
+            callback_data->progress_state.reusable_progress_object = (*env)->NewGlobalRef(env, progress_object);
+            (*env)->DeleteLocalRef(env, progress_object);
+            progress_object = callback_data->progress_state.reusable_progress_object;
+            if (progress_object == NULL) {
+                return;
+            }
+        }
     }
 
     (*env)->SetLongField(
-        env,
-        progress_object,
-        s3_meta_request_progress_properties.bytes_transferred_field_id,
-        progress->bytes_transferred);
+        env, progress_object, s3_meta_request_progress_properties.bytes_transferred_field_id, (jlong)bytes_transferred);
     (*env)->SetLongField(
-        env, progress_object, s3_meta_request_progress_properties.content_length_field_id, progress->content_length);
+        env, progress_object, s3_meta_request_progress_properties.content_length_field_id, (jlong)content_length);
 
     if (callback_data->java_s3_meta_request_response_handler_native_adapter != NULL) {
 
@@ -436,21 +924,124 @@ static void s_on_s3_meta_request_progress_callback(
         }
     }
 
-    (*env)->DeleteLocalRef(env, progress_object);
+    if (progress_object != callback_data->progress_state.reusable_progress_object) {
+        (*env)->DeleteLocalRef(env, progress_object);
+    }
+}
 
-done:
+static bool s_s3_progress_upcall_is_idle(void *user_data) {
+    const struct s3_progress_state *progress_state = user_data;
+    return !progress_state->upcall_in_flight;
+}
+
+/*
+ * Reports whatever progress has accumulated. Only one thread delivers at a time, bytes that arrive while an upcall
+ * is in flight are picked up by that thread once it returns if they are due (or the meta request finished), so the
+ * reusable progress object is never shared and no bytes are dropped. Once the meta request has finished, the
+ * caller waits for an upcall in flight on another thread, so nothing reaches Java after onFinished.
+ */
+static void s_s3_meta_request_flush_progress(
+    struct aws_s3_meta_request *meta_request,
+    struct s3_client_make_meta_request_callback_data *callback_data) {
+
+    struct s3_progress_state *progress_state = &callback_data->progress_state;
+
+    aws_mutex_lock(&progress_state->lock);
+    if (progress_state->finished) {
+        aws_condition_variable_wait_pred(
+            &progress_state->upcall_done, &progress_state->lock, s_s3_progress_upcall_is_idle, progress_state);
+    }
+    if (progress_state->upcall_in_flight || progress_state->pending_bytes == 0) {
+        aws_mutex_unlock(&progress_state->lock);
+        return;
+    }
+    progress_state->upcall_in_flight = true;
+    aws_mutex_unlock(&progress_state->lock);
+
+    /********** JNI ENV ACQUIRE **********/
+    JNIEnv *env = aws_jni_acquire_thread_env(callback_data->jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        aws_mutex_lock(&progress_state->lock);
+        progress_state->upcall_in_flight = false;
+        aws_mutex_unlock(&progress_state->lock);
+        aws_condition_variable_notify_all(&progress_state->upcall_done);
+        return;
+    }
+
+    aws_mutex_lock(&progress_state->lock);
+    while (progress_state->pending_bytes > 0) {
+        uint64_t bytes_transferred = progress_state->pending_bytes;
+        uint64_t content_length = progress_state->content_length;
+        progress_state->pending_bytes = 0;
+        aws_high_res_clock_get_ticks(&progress_state->last_delivery_ns);
+        aws_mutex_unlock(&progress_state->lock);
+
+        s_s3_meta_request_deliver_progress(env, meta_request, callback_data, bytes_transferred, content_length);
+
+        aws_mutex_lock(&progress_state->lock);
+        if (!progress_state->finished && !s_s3_progress_is_due(progress_state)) {
+            break;
+        }
+    }
+    progress_state->upcall_in_flight = false;
+    aws_mutex_unlock(&progress_state->lock);
+    aws_condition_variable_notify_all(&progress_state->upcall_done);
 
     aws_jni_release_thread_env(callback_data->jvm, env);
     /********** JNI ENV RELEASE **********/
 }
 
+static void s_on_s3_meta_request_progress_callback(
+    struct aws_s3_meta_request *meta_request,
+    const struct aws_s3_meta_request_progress *progress,
+    void *user_data) {
+    AWS_JNI_TRACE_SPAN("s3.progress", meta_request);
+
+    struct s3_client_make_meta_request_callback_data *callback_data =
+        (struct s3_client_make_meta_request_callback_data *)user_data;
+    struct s3_progress_state *progress_state = &callback_data->progress_state;
+
+    aws_mutex_lock(&progress_state->lock);
+    progress_state->pending_bytes += progress->bytes_transferred;
+    progress_state->content_length = progress->content_length;
+    bool due = s_s3_progress_is_due(progress_state);
+    aws_mutex_unlock(&progress_state->lock);
+
+    if (due) {
+        s_s3_meta_request_flush_progress(meta_request, callback_data);
+    }
+}
 static void s_s3_meta_request_callback_cleanup(
     JNIEnv *env,
     struct s3_client_make_meta_request_callback_data *callback_data) {
     if (callback_data) {
         (*env)->DeleteGlobalRef(env, callback_data->java_s3_meta_request);
         (*env)->DeleteGlobalRef(env, callback_data->java_s3_meta_request_response_handler_native_adapter);
-        aws_mem_release(aws_jni_get_allocator(), callback_data);
+        s_s3_response_file_destroy(aws_jni_s3_allocator(), callback_data->response_file);
+        aws_string_destroy(callback_data->download_state.etag);
+        aws_mutex_clean_up(&callback_data->download_state.lock);
+        if (callback_data->progress_state.reusable_progress_object != NULL) {
+            (*env)->DeleteGlobalRef(env, callback_data->progress_state.reusable_progress_object);
+        }
+        aws_condition_variable_clean_up(&callback_data->progress_state.upcall_done);
+        aws_mutex_clean_up(&callback_data->progress_state.lock);
+        if (callback_data->metrics.enabled) {
+            aws_array_list_clean_up(&callback_data->metrics.parts);
+        }
+        for (size_t i = 0; i < aws_array_list_length(&callback_data->response_buffers); ++i) {
+            struct s3_response_buffer *response_buffer = NULL;
+            aws_array_list_get_at_ptr(&callback_data->response_buffers, (void **)&response_buffer, i);
+            (*env)->DeleteGlobalRef(env, response_buffer->java_buffer);
+        }
+        aws_array_list_clean_up(&callback_data->response_buffers);
+        if (callback_data->client_statistics != NULL) {
+            if (callback_data->counted_active) {
+                aws_atomic_fetch_sub(&callback_data->client_statistics->active_meta_requests, 1);
+            }
+            aws_ref_count_release(&callback_data->client_statistics->ref_count);
+        }
+        aws_mem_release(aws_jni_s3_allocator(), callback_data);
     }
 }
 
@@ -462,14 +1053,19 @@ static struct aws_s3_meta_request_resume_token *s_native_resume_token_from_java_
         return NULL;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_s3_allocator();
 
     jint native_type =
         (*env)->GetIntField(env, resume_token_jni, s3_meta_request_resume_token_properties.native_type_field_id);
 
+    if (native_type == AWS_S3_META_REQUEST_TYPE_GET_OBJECT) {
+        /* GetObject resume is handled by the binding, see s_s3_download_resume_from_java_token() */
+        return NULL;
+    }
+
     if (native_type != AWS_S3_META_REQUEST_TYPE_PUT_OBJECT) {
         aws_jni_throw_illegal_argument_exception(
-            env, "ResumeToken: Operations other than PutObject are not supported for resume.");
+            env, "ResumeToken: Operations other than PutObject and GetObject are not supported for resume.");
         return NULL;
     }
 
@@ -503,26 +1099,331 @@ static struct aws_s3_meta_request_resume_token *s_native_resume_token_from_java_
     return resume_token;
 }
 
-JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMakeMetaRequest(
+/*
+ * Writes the Range header value for resuming a download resume_offset bytes in. A caller's own Range is kept and
+ * narrowed, since the token's offsets are relative to the bytes that range selected. Only a single
+ * "bytes=first-last", "bytes=first-" or "bytes=-suffix" range can be narrowed this way.
+ * If this fails a java exception has been set.
+ */
+static int s_s3_download_resume_range(
+    JNIEnv *env,
+    const struct aws_http_headers *headers,
+    uint64_t resume_offset,
+    char *range_str,
+    size_t range_str_size) {
+
+    struct aws_byte_cursor range_header;
+    if (aws_http_headers_get(headers, aws_byte_cursor_from_c_str("Range"), &range_header) != AWS_OP_SUCCESS) {
+        snprintf(range_str, range_str_size, "bytes=%" PRIu64 "-", resume_offset);
+        return AWS_OP_SUCCESS;
+    }
+
+    struct aws_byte_cursor range = range_header;
+    struct aws_byte_cursor unit = aws_byte_cursor_from_c_str("bytes=");
+    struct aws_byte_cursor first = {0};
+    struct aws_byte_cursor last = {0};
+    bool parsed = false;
+    if (aws_byte_cursor_starts_with(&range, &unit)) {
+        aws_byte_cursor_advance(&range, unit.len);
+        if (memchr(range.ptr, ',', range.len) == NULL) {
+            const uint8_t *dash_ptr = memchr(range.ptr, '-', range.len);
+            if (dash_ptr != NULL) {
+                first = aws_byte_cursor_advance(&range, (size_t)(dash_ptr - range.ptr));
+                aws_byte_cursor_advance(&range, 1);
+                last = range;
+                parsed = first.len > 0 || last.len > 0;
+            }
+        }
+    }
+
+    uint64_t first_byte = 0;
+    uint64_t last_byte = 0;
+    if (parsed && first.len > 0 && aws_byte_cursor_utf8_parse_u64(first, &first_byte)) {
+        parsed = false;
+    }
+    if (parsed && last.len > 0 && aws_byte_cursor_utf8_parse_u64(last, &last_byte)) {
+        parsed = false;
+    }
+    if (!parsed) {
+        aws_jni_throw_illegal_argument_exception(
+            env,
+            "ResumeToken: can only resume a download with a single byte range, not Range: " PRInSTR,
+            AWS_BYTE_CURSOR_PRI(range_header));
+        return AWS_OP_ERR;
+    }
+
+    if (first.len == 0) {
+        /* a suffix range, the token's object size is the suffix length */
+        if (resume_offset >= last_byte) {
+            aws_jni_throw_illegal_argument_exception(env, "ResumeToken: resume point is past the end of the Range.");
+            return AWS_OP_ERR;
+        }
+        snprintf(range_str, range_str_size, "bytes=-%" PRIu64, last_byte - resume_offset);
+    } else if (last.len == 0) {
+        snprintf(range_str, range_str_size, "bytes=%" PRIu64 "-", first_byte + resume_offset);
+    } else {
+        if (last_byte < first_byte || resume_offset > last_byte - first_byte) {
+            aws_jni_throw_illegal_argument_exception(env, "ResumeToken: resume point is past the end of the Range.");
+            return AWS_OP_ERR;
+        }
+        snprintf(range_str, range_str_size, "bytes=%" PRIu64 "-%" PRIu64, first_byte + resume_offset, last_byte);
+    }
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Seeds the download state from a GetObject ResumeToken and turns the request into a ranged GET starting at the
+ * first part the token doesn't have. Completed parts past that point are downloaded again, which never happens
+ * for tokens produced by S3MetaRequest.pause() since those always describe a prefix of the object.
+ * If this fails a java exception has been set.
+ */
+static int s_s3_download_resume_from_java_token(
+    JNIEnv *env,
+    struct s3_download_resume_state *download_state,
+    struct aws_http_message *message,
+    jobject resume_token_jni) {
+
+    jlong part_size_jni =
+        (*env)->GetLongField(env, resume_token_jni, s3_meta_request_resume_token_properties.part_size_field_id);
+    jlong total_num_parts_jni =
+        (*env)->GetLongField(env, resume_token_jni, s3_meta_request_resume_token_properties.total_num_parts_field_id);
+    jlong object_size_jni =
+        (*env)->GetLongField(env, resume_token_jni, s3_meta_request_resume_token_properties.object_size_field_id);
+    if (part_size_jni <= 0 || total_num_parts_jni < 0 || object_size_jni < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "ResumeToken: invalid part size, part count or object size.");
+        return AWS_OP_ERR;
+    }
+
+    uint64_t part_size = (uint64_t)part_size_jni;
+    uint64_t object_size = (uint64_t)object_size_jni;
+
+    /* find the first part that isn't marked complete, bit i of the bitmap is part i + 1 */
+    uint64_t first_missing_part = 0;
+    jlongArray completed_parts_jni =
+        (*env)->GetObjectField(env, resume_token_jni, s3_meta_request_resume_token_properties.completed_parts_field_id);
+    if (completed_parts_jni != NULL) {
+        jsize num_words = (*env)->GetArrayLength(env, completed_parts_jni);
+        jlong *words = (*env)->GetLongArrayElements(env, completed_parts_jni, NULL);
+        if (words == NULL) {
+            aws_jni_throw_runtime_exception(env, "ResumeToken: failed to read completed parts.");
+            return AWS_OP_ERR;
+        }
+        jsize word_index = 0;
+        while (word_index < num_words && (uint64_t)words[word_index] == UINT64_MAX) {
+            ++word_index;
+        }
+        first_missing_part = (uint64_t)word_index * 64;
+        if (word_index < num_words) {
+            uint64_t word = (uint64_t)words[word_index];
+            while (word & 1) {
+                word >>= 1;
+                ++first_missing_part;
+            }
+        }
+        (*env)->ReleaseLongArrayElements(env, completed_parts_jni, words, JNI_ABORT);
+        (*env)->DeleteLocalRef(env, completed_parts_jni);
+    }
+
+    uint64_t resume_offset = first_missing_part * part_size;
+    if (first_missing_part >= (uint64_t)total_num_parts_jni || resume_offset >= object_size) {
+        /* every part is already there, fetch the last one again so the request still completes normally */
+        resume_offset = object_size > part_size ? ((object_size - 1) / part_size) * part_size : 0;
+    }
+
+    struct aws_http_headers *headers = aws_http_message_get_headers(message);
+    if (resume_offset > 0) {
+        char range_str[64];
+        if (s_s3_download_resume_range(env, headers, resume_offset, range_str, sizeof(range_str))) {
+            return AWS_OP_ERR;
+        }
+        if (aws_http_headers_set(
+                headers, aws_byte_cursor_from_c_str("Range"), aws_byte_cursor_from_c_str(range_str))) {
+            aws_jni_throw_runtime_exception(
+                env, "S3Client.aws_s3_client_make_meta_request: failed to set Range header");
+            return AWS_OP_ERR;
+        }
+    }
+
+    jstring etag_jni =
+        (*env)->GetObjectField(env, resume_token_jni, s3_meta_request_resume_token_properties.etag_field_id);
+    if (etag_jni != NULL) {
+        download_state->etag = aws_jni_new_string_from_jstring(env, etag_jni);
+        (*env)->DeleteLocalRef(env, etag_jni);
+        /* fail instead of stitching together two different versions of the object */
+        if (download_state->etag == NULL ||
+            aws_http_headers_set(
+                headers, aws_byte_cursor_from_c_str("If-Match"), aws_byte_cursor_from_string(download_state->etag))) {
+            aws_jni_throw_runtime_exception(
+                env, "S3Client.aws_s3_client_make_meta_request: failed to set If-Match header");
+            return AWS_OP_ERR;
+        }
+    }
+
+    download_state->part_size = part_size;
+    download_state->object_size = object_size;
+    download_state->bytes_completed = resume_offset;
+    download_state->resumed = true;
+    return AWS_OP_SUCCESS;
+}
+
+/*
+ * Replaces the request body with a native stream over the file at the given path, so the body is read
+ * by the event-loop threads without ever calling into Java. Content-Length is filled in from the file size
+ * if the request doesn't already specify it. If this fails a java exception has been set.
+ */
+static int s_s3_message_set_body_from_file(
+    JNIEnv *env,
+    struct aws_allocator *allocator,
+    struct aws_http_message *message,
+    jstring jni_file_path) {
+
+    struct aws_string *file_path = aws_jni_new_string_from_jstring(env, jni_file_path);
+    if (file_path == NULL) {
+        aws_jni_throw_runtime_exception(env, "S3Client.aws_s3_client_make_meta_request: invalid request file path");
+        return AWS_OP_ERR;
+    }
+
+    struct aws_input_stream *body_stream = aws_input_stream_new_from_file(allocator, aws_string_c_str(file_path));
+    aws_string_destroy(file_path);
+    if (body_stream == NULL) {
+        aws_jni_throw_runtime_exception(
+            env, "S3Client.aws_s3_client_make_meta_request: failed to open request file for reading");
+        return AWS_OP_ERR;
+    }
+
+    int result = AWS_OP_ERR;
+    struct aws_http_headers *headers = aws_http_message_get_headers(message);
+    if (!aws_http_headers_has(headers, aws_byte_cursor_from_c_str("Content-Length"))) {
+        int64_t length = 0;
+        if (aws_input_stream_get_length(body_stream, &length)) {
+            aws_jni_throw_runtime_exception(
+                env, "S3Client.aws_s3_client_make_meta_request: failed to get length of request file");
+            goto done;
+        }
+
+        char content_length_str[32];
+        snprintf(content_length_str, sizeof(content_length_str), "%" PRIi64, length);
+        if (aws_http_headers_set(
+                headers,
+                aws_byte_cursor_from_c_str("Content-Length"),
+                aws_byte_cursor_from_c_str(content_length_str))) {
+            aws_jni_throw_runtime_exception(
+                env, "S3Client.aws_s3_client_make_meta_request: failed to set Content-Length header");
+            goto done;
+        }
+    }
+
+    aws_http_message_set_body_stream(message, body_stream);
+    result = AWS_OP_SUCCESS;
+
+done:
+    /* message controls the lifetime of body stream fully */
+    aws_input_stream_release(body_stream);
+    return result;
+}
+
+/*
+ * Resolves the destinations of a ranged batch GET. If this fails a java exception has been set.
+ */
+static int s_s3_response_buffers_init(
+    JNIEnv *env,
+    struct s3_client_make_meta_request_callback_data *callback_data,
+    jobjectArray jni_response_buffers,
+    jlongArray jni_response_buffer_layout,
+    jlong jni_response_range_start) {
+
+    jsize num_buffers = (*env)->GetArrayLength(env, jni_response_buffers);
+    if (jni_response_buffer_layout == NULL ||
+        (*env)->GetArrayLength(env, jni_response_buffer_layout) != num_buffers * 3) {
+        aws_jni_throw_illegal_argument_exception(env, "S3Client.makeRangedGetBatch: invalid response buffer layout");
+        return AWS_OP_ERR;
+    }
+
+    callback_data->response_buffers_offset = (uint64_t)jni_response_range_start;
+
+    jlong *layout = (*env)->GetLongArrayElements(env, jni_response_buffer_layout, NULL);
+    if (layout == NULL) {
+        return AWS_OP_ERR;
+    }
+
+    int result = AWS_OP_ERR;
+    for (jsize i = 0; i < num_buffers; ++i) {
+        jobject java_buffer = (*env)->GetObjectArrayElement(env, jni_response_buffers, i);
+        uint8_t *address = java_buffer != NULL ? (*env)->GetDirectBufferAddress(env, java_buffer) : NULL;
+        jlong capacity = java_buffer != NULL ? (*env)->GetDirectBufferCapacity(env, java_buffer) : -1;
+        jlong position = layout[i * 3 + 1];
+        jlong length = layout[i * 3 + 2];
+        if (address == NULL || position < 0 || length < 0 || position + length > capacity) {
+            (*env)->DeleteLocalRef(env, java_buffer);
+            aws_jni_throw_illegal_argument_exception(
+                env, "S3Client.makeRangedGetBatch: destinations must be direct ByteBuffers");
+            goto done;
+        }
+
+        struct s3_response_buffer response_buffer = {
+            .java_buffer = (*env)->NewGlobalRef(env, java_buffer),
+            .ptr = address + position,
+            .position = (jint)position,
+            .object_offset = (uint64_t)layout[i * 3],
+            .length = (size_t)length,
+        };
+        (*env)->DeleteLocalRef(env, java_buffer);
+        aws_array_list_push_back(&callback_data->response_buffers, &response_buffer);
+    }
+    result = AWS_OP_SUCCESS;
+
+done:
+    (*env)->ReleaseLongArrayElements(env, jni_response_buffer_layout, layout, JNI_ABORT);
+    return result;
+}
+
+static jlong s_s3_client_make_meta_request(
     JNIEnv *env,
-    jclass jni_class,
     jlong jni_s3_client,
     jobject java_s3_meta_request_jobject,
-    jbyteArray jni_region,
-    jint meta_request_type,
-    jint checksum_location,
-    jint checksum_algorithm,
-    jboolean validate_response,
-    jintArray jni_marshalled_validate_algorithms,
-    jbyteArray jni_marshalled_message_data,
-    jobject jni_http_request_body_stream,
-    jlong jni_credentials_provider,
-    jobject java_response_handler_jobject,
-    jbyteArray jni_endpoint,
-    jobject java_resume_token_jobject) {
-    (void)jni_class;
-
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    jobject jni_options) {
+    const struct java_s3_meta_request_native_options_properties *options = &s3_meta_request_native_options_properties;
+    jbyteArray jni_region = (jbyteArray)(*env)->GetObjectField(env, jni_options, options->region_field_id);
+    jint meta_request_type = (*env)->GetIntField(env, jni_options, options->meta_request_type_field_id);
+    jint checksum_location = (*env)->GetIntField(env, jni_options, options->checksum_location_field_id);
+    jint checksum_algorithm = (*env)->GetIntField(env, jni_options, options->checksum_algorithm_field_id);
+    jboolean validate_response = (*env)->GetBooleanField(env, jni_options, options->validate_checksum_field_id);
+    jintArray jni_marshalled_validate_algorithms =
+        (jintArray)(*env)->GetObjectField(env, jni_options, options->validate_algorithms_field_id);
+    jbyteArray jni_marshalled_message_data =
+        (jbyteArray)(*env)->GetObjectField(env, jni_options, options->http_request_bytes_field_id);
+    jobject jni_http_request_body_stream =
+        (*env)->GetObjectField(env, jni_options, options->http_request_body_stream_field_id);
+    jlong jni_credentials_provider = (*env)->GetLongField(env, jni_options, options->credentials_provider_field_id);
+    jobject java_response_handler_jobject =
+        (*env)->GetObjectField(env, jni_options, options->response_handler_native_adapter_field_id);
+    jbyteArray jni_endpoint = (jbyteArray)(*env)->GetObjectField(env, jni_options, options->endpoint_field_id);
+    jobject java_resume_token_jobject = (*env)->GetObjectField(env, jni_options, options->resume_token_field_id);
+    jboolean zero_copy_response_body =
+        (*env)->GetBooleanField(env, jni_options, options->zero_copy_response_body_field_id);
+    jstring jni_response_file_path =
+        (jstring)(*env)->GetObjectField(env, jni_options, options->response_file_path_field_id);
+    jstring jni_request_file_path =
+        (jstring)(*env)->GetObjectField(env, jni_options, options->request_file_path_field_id);
+    jlong jni_request_part_buffer_queue =
+        (*env)->GetLongField(env, jni_options, options->request_part_buffer_queue_field_id);
+    jlong jni_part_size = (*env)->GetLongField(env, jni_options, options->part_size_field_id);
+    jlong jni_progress_interval_bytes =
+        (*env)->GetLongField(env, jni_options, options->progress_interval_bytes_field_id);
+    jlong jni_progress_interval_millis =
+        (*env)->GetLongField(env, jni_options, options->progress_interval_millis_field_id);
+    jboolean reuse_progress_object = (*env)->GetBooleanField(env, jni_options, options->reuse_progress_object_field_id);
+    jboolean metrics_enabled = (*env)->GetBooleanField(env, jni_options, options->metrics_enabled_field_id);
+    jlong jni_client_statistics = (*env)->GetLongField(env, jni_options, options->statistics_field_id);
+    jobjectArray jni_response_buffers =
+        (jobjectArray)(*env)->GetObjectField(env, jni_options, options->response_buffers_field_id);
+    jlongArray jni_response_buffer_layout =
+        (jlongArray)(*env)->GetObjectField(env, jni_options, options->response_buffer_layout_field_id);
+    jlong jni_response_range_start = (*env)->GetLongField(env, jni_options, options->response_range_start_field_id);
+    jint response_body_checksum_algorithm =
+        (*env)->GetIntField(env, jni_options, options->response_body_checksum_algorithm_field_id);
+
+    struct aws_allocator *allocator = aws_jni_s3_allocator();
     struct aws_s3_client *client = (struct aws_s3_client *)jni_s3_client;
     struct aws_credentials_provider *credentials_provider = (struct aws_credentials_provider *)jni_credentials_provider;
     struct aws_s3_meta_request_resume_token *resume_token =
@@ -539,6 +1440,30 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMake
     struct s3_client_make_meta_request_callback_data *callback_data =
         aws_mem_calloc(allocator, 1, sizeof(struct s3_client_make_meta_request_callback_data));
     AWS_FATAL_ASSERT(callback_data);
+    aws_mutex_init(&callback_data->download_state.lock);
+    callback_data->download_state.part_size =
+        jni_part_size > 0 ? (uint64_t)jni_part_size : s_default_download_part_size;
+    aws_mutex_init(&callback_data->progress_state.lock);
+    aws_condition_variable_init(&callback_data->progress_state.upcall_done);
+    callback_data->progress_state.interval_bytes =
+        jni_progress_interval_bytes > 0 ? (uint64_t)jni_progress_interval_bytes : 0;
+    callback_data->progress_state.interval_ns =
+        jni_progress_interval_millis > 0 ? aws_timestamp_convert(
+                                               (uint64_t)jni_progress_interval_millis,
+                                               AWS_TIMESTAMP_MILLIS,
+                                               AWS_TIMESTAMP_NANOS,
+                                               NULL)
+                                         : 0;
+    callback_data->progress_state.reuse_progress_object = reuse_progress_object;
+    aws_high_res_clock_get_ticks(&callback_data->progress_state.last_delivery_ns);
+    aws_array_list_init_dynamic(&callback_data->response_buffers, allocator, 0, sizeof(struct s3_response_buffer));
+
+    if (metrics_enabled || response_body_checksum_algorithm != AWS_SCA_NONE) {
+        callback_data->metrics.enabled = true;
+        callback_data->metrics.checksum_algorithm = response_body_checksum_algorithm;
+        callback_data->metrics.start_ns = callback_data->progress_state.last_delivery_ns;
+        aws_array_list_init_dynamic(&callback_data->metrics.parts, allocator, 16, sizeof(struct s3_part_metrics));
+    }
 
     jint jvmresult = (*env)->GetJavaVM(env, &callback_data->jvm);
     (void)jvmresult;
@@ -551,6 +1476,8 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMake
         (*env)->NewGlobalRef(env, java_response_handler_jobject);
     AWS_FATAL_ASSERT(callback_data->java_s3_meta_request_response_handler_native_adapter != NULL);
 
+    callback_data->zero_copy_response_body = zero_copy_response_body;
+
     struct aws_http_message *request_message = aws_http_message_new_request(allocator);
     AWS_FATAL_ASSERT(request_message);
 
@@ -570,6 +1497,58 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMake
         }
     }
 
+    bool resume_download =
+        java_resume_token_jobject != NULL &&
+        (*env)->GetIntField(
+            env, java_resume_token_jobject, s3_meta_request_resume_token_properties.native_type_field_id) ==
+            AWS_S3_META_REQUEST_TYPE_GET_OBJECT;
+    if (resume_download) {
+        if (jni_response_file_path == NULL) {
+            aws_jni_throw_illegal_argument_exception(
+                env, "ResumeToken: GetObject resume requires a response file path.");
+            goto done;
+        }
+        if (s_s3_download_resume_from_java_token(
+                env, &callback_data->download_state, request_message, java_resume_token_jobject)) {
+            goto done;
+        }
+    }
+
+    if (jni_response_file_path != NULL) {
+        struct aws_string *response_file_path = aws_jni_new_string_from_jstring(env, jni_response_file_path);
+        if (response_file_path == NULL) {
+            aws_jni_throw_runtime_exception(
+                env, "S3Client.aws_s3_client_make_meta_request: invalid response file path");
+            goto done;
+        }
+        /* a resumed download keeps the parts already in the file */
+        callback_data->response_file = s_s3_response_file_new(allocator, response_file_path, !resume_download);
+        aws_string_destroy(response_file_path);
+        if (callback_data->response_file == NULL) {
+            aws_jni_throw_runtime_exception(
+                env, "S3Client.aws_s3_client_make_meta_request: failed to open response file for writing");
+            goto done;
+        }
+    }
+
+    if (jni_response_buffers != NULL) {
+        if (s_s3_response_buffers_init(
+                env, callback_data, jni_response_buffers, jni_response_buffer_layout, jni_response_range_start)) {
+            goto done;
+        }
+    }
+
+    if (jni_request_file_path != NULL) {
+        if (s_s3_message_set_body_from_file(env, allocator, request_message, jni_request_file_path)) {
+            goto done;
+        }
+    }
+
+    if (jni_request_part_buffer_queue != 0) {
+        /* Body is fed from native part buffers filled by Java, see s3_part_buffers.c */
+        aws_http_message_set_body_stream(request_message, (struct aws_input_stream *)jni_request_part_buffer_queue);
+    }
+
     struct aws_s3_checksum_config checksum_config = {
         .location = checksum_location,
         .checksum_algorithm = checksum_algorithm,
@@ -604,6 +1583,15 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMake
         .resume_token = resume_token,
     };
 
+    struct s3_client_statistics *client_statistics = (struct s3_client_statistics *)jni_client_statistics;
+    if (client_statistics != NULL) {
+        /* counted before the meta request exists, since it may finish on another thread before make returns */
+        aws_ref_count_acquire(&client_statistics->ref_count);
+        callback_data->client_statistics = client_statistics;
+        aws_atomic_fetch_add(&client_statistics->active_meta_requests, 1);
+        callback_data->counted_active = true;
+    }
+
     meta_request = aws_s3_client_make_meta_request(client, &meta_request_options);
     /* We are done using the list, it can be safely cleaned up now. */
     aws_array_list_clean_up(&response_checksum_list);
@@ -614,6 +1602,19 @@ JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMake
         goto done;
     }
 
+    if (callback_data->client_statistics != NULL) {
+        aws_atomic_fetch_add(&callback_data->client_statistics->total_meta_requests, 1);
+    }
+
+    if (callback_data->response_file != NULL) {
+        /* lets S3MetaRequest.pause() produce a GetObject ResumeToken, valid until the meta request shuts down */
+        (*env)->SetLongField(
+            env,
+            java_s3_meta_request_jobject,
+            s3_meta_request_properties.download_resume_state_field_id,
+            (jlong)&callback_data->download_state);
+    }
+
     success = true;
 
 done:
@@ -631,6 +1632,27 @@ done:
     return (jlong)0;
 }
 
+JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientMakeMetaRequest(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_s3_client,
+    jobject java_s3_meta_request_jobject,
+    jobject jni_options) {
+    (void)jni_class;
+
+    /* reading the options creates a local reference per object field, give them a frame of their own */
+    if ((*env)->PushLocalFrame(env, 32) < 0) {
+        aws_jni_throw_runtime_exception(
+            env, "S3Client.aws_s3_client_make_meta_request: failed to allocate local frame");
+        return (jlong)0;
+    }
+
+    jlong meta_request = s_s3_client_make_meta_request(env, jni_s3_client, java_s3_meta_request_jobject, jni_options);
+
+    (*env)->PopLocalFrame(env, NULL);
+    return meta_request;
+}
+
 static void s_on_s3_meta_request_shutdown_complete_callback(void *user_data) {
     struct s3_client_make_meta_request_callback_data *callback_data =
         (struct s3_client_make_meta_request_callback_data *)user_data;
@@ -695,10 +1717,103 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_s3_S3MetaRequest_s3MetaRe
     aws_s3_meta_request_cancel(meta_request);
 }
 
+/*
+ * Pauses a download to a response file by cancelling it, after snapshotting how much of the object is on disk
+ */
+static jobject s_s3_meta_request_pause_download(
+    JNIEnv *env,
+    struct aws_s3_meta_request *meta_request,
+    struct s3_download_resume_state *download_state) {
+
+    aws_mutex_lock(&download_state->lock);
+    download_state->paused = true;
+    uint64_t part_size = download_state->part_size;
+    uint64_t object_size = download_state->object_size;
+    uint64_t bytes_completed = download_state->bytes_completed;
+    /* copied so no JNI call is made while the event loop may be waiting on the lock */
+    struct aws_string *etag =
+        download_state->etag != NULL ? aws_string_new_from_string(aws_jni_s3_allocator(), download_state->etag) : NULL;
+    aws_mutex_unlock(&download_state->lock);
+
+    aws_s3_meta_request_cancel(meta_request);
+
+    jstring etag_jni = NULL;
+    if (etag != NULL) {
+        etag_jni = aws_jni_string_from_string(env, etag);
+        aws_string_destroy(etag);
+    }
+
+    jobject resume_token_jni = NULL;
+    jlongArray completed_parts_jni = NULL;
+    if (object_size == 0) {
+        /* headers haven't arrived yet, there is nothing to resume from */
+        goto on_done;
+    }
+
+    uint64_t total_num_parts = (object_size + part_size - 1) / part_size;
+    /* a trailing partial part only counts once the whole object is written */
+    uint64_t num_parts_completed = bytes_completed >= object_size ? total_num_parts : bytes_completed / part_size;
+
+    size_t num_words = (size_t)((num_parts_completed + 63) / 64);
+    completed_parts_jni = (*env)->NewLongArray(env, (jsize)num_words);
+    if (completed_parts_jni == NULL) {
+        aws_jni_throw_runtime_exception(env, "S3MetaRequest.s3MetaRequestPause: Failed to create ResumeToken.");
+        goto on_done;
+    }
+    for (size_t word_index = 0; word_index < num_words; ++word_index) {
+        uint64_t bits_in_word = num_parts_completed - word_index * 64;
+        jlong word = bits_in_word >= 64 ? (jlong)UINT64_MAX : (jlong)((UINT64_C(1) << bits_in_word) - 1);
+        (*env)->SetLongArrayRegion(env, completed_parts_jni, (jsize)word_index, 1, &word);
+    }
+
+    resume_token_jni = (*env)->NewObject(
+        env,
+        s3_meta_request_resume_token_properties.s3_meta_request_resume_token_class,
+        s3_meta_request_resume_token_properties.s3_meta_request_resume_token_constructor_method_id);
+    if ((*env)->ExceptionCheck(env) || resume_token_jni == NULL) {
+        aws_jni_throw_runtime_exception(env, "S3MetaRequest.s3MetaRequestPause: Failed to create ResumeToken.");
+        resume_token_jni = NULL;
+        goto on_done;
+    }
+
+    (*env)->SetIntField(
+        env,
+        resume_token_jni,
+        s3_meta_request_resume_token_properties.native_type_field_id,
+        AWS_S3_META_REQUEST_TYPE_GET_OBJECT);
+    (*env)->SetLongField(
+        env, resume_token_jni, s3_meta_request_resume_token_properties.part_size_field_id, (jlong)part_size);
+    (*env)->SetLongField(
+        env,
+        resume_token_jni,
+        s3_meta_request_resume_token_properties.total_num_parts_field_id,
+        (jlong)total_num_parts);
+    (*env)->SetLongField(
+        env,
+        resume_token_jni,
+        s3_meta_request_resume_token_properties.num_parts_completed_field_id,
+        (jlong)num_parts_completed);
+    (*env)->SetLongField(
+        env, resume_token_jni, s3_meta_request_resume_token_properties.object_size_field_id, (jlong)object_size);
+    (*env)->SetObjectField(env, resume_token_jni, s3_meta_request_resume_token_properties.etag_field_id, etag_jni);
+    (*env)->SetObjectField(
+        env, resume_token_jni, s3_meta_request_resume_token_properties.completed_parts_field_id, completed_parts_jni);
+
+on_done:
+    if (completed_parts_jni != NULL) {
+        (*env)->DeleteLocalRef(env, completed_parts_jni);
+    }
+    if (etag_jni != NULL) {
+        (*env)->DeleteLocalRef(env, etag_jni);
+    }
+    return resume_token_jni;
+}
+
 JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_s3_S3MetaRequest_s3MetaRequestPause(
     JNIEnv *env,
     jclass jni_class,
-    jlong jni_s3_meta_request) {
+    jlong jni_s3_meta_request,
+    jlong jni_download_resume_state) {
     (void)jni_class;
 
     struct aws_s3_meta_request *meta_request = (struct aws_s3_meta_request *)jni_s3_meta_request;
@@ -708,6 +1823,11 @@ JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_s3_S3MetaRequest_s3Met
         return NULL;
     }
 
+    if (jni_download_resume_state != 0) {
+        return s_s3_meta_request_pause_download(
+            env, meta_request, (struct s3_download_resume_state *)jni_download_resume_state);
+    }
+
     struct aws_s3_meta_request_resume_token *resume_token = NULL;
 
     if (aws_s3_meta_request_pause(meta_request, &resume_token)) {
@@ -786,6 +1906,70 @@ JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_s3_S3MetaRequest_s3MetaRe
     aws_s3_meta_request_increment_read_window(meta_request, (uint64_t)increment);
 }
 
+JNIEXPORT jlong JNICALL
+    Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientStatisticsNew(JNIEnv *env, jclass jni_class) {
+    (void)jni_class;
+    cache_java_class_ids_for_s3(env);
+
+    struct aws_allocator *allocator = aws_jni_s3_allocator();
+    struct s3_client_statistics *statistics = aws_mem_calloc(allocator, 1, sizeof(struct s3_client_statistics));
+    AWS_FATAL_ASSERT(statistics);
+    statistics->allocator = allocator;
+    aws_ref_count_init(&statistics->ref_count, statistics, s_s3_client_statistics_destroy);
+    aws_atomic_init_int(&statistics->active_meta_requests, 0);
+    aws_atomic_init_int(&statistics->total_meta_requests, 0);
+    aws_atomic_init_int(&statistics->response_body_bytes, 0);
+
+    return (jlong)statistics;
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientStatisticsRelease(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_statistics) {
+    (void)env;
+    (void)jni_class;
+
+    struct s3_client_statistics *statistics = (struct s3_client_statistics *)jni_statistics;
+    if (statistics != NULL) {
+        aws_ref_count_release(&statistics->ref_count);
+    }
+}
+
+JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3ClientGetStatistics(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_statistics,
+    jlong jni_part_buffer_pool) {
+    (void)jni_class;
+    cache_java_class_ids_for_s3(env);
+
+    struct s3_client_statistics *statistics = (struct s3_client_statistics *)jni_statistics;
+    if (statistics == NULL) {
+        aws_jni_throw_illegal_argument_exception(env, "S3Client.s3ClientGetStatistics: Invalid/null statistics");
+        return NULL;
+    }
+
+    size_t part_buffer_bytes_allocated = 0;
+    size_t part_buffer_bytes_in_use = 0;
+    if (jni_part_buffer_pool != 0) {
+        aws_jni_s3_part_buffer_pool_get_stats(
+            (struct s3_part_buffer_pool *)jni_part_buffer_pool,
+            &part_buffer_bytes_allocated,
+            &part_buffer_bytes_in_use);
+    }
+
+    return (*env)->NewObject(
+        env,
+        s3_client_statistics_properties.s3_client_statistics_class,
+        s3_client_statistics_properties.constructor_method_id,
+        (jlong)aws_atomic_load_int(&statistics->active_meta_requests),
+        (jlong)aws_atomic_load_int(&statistics->total_meta_requests),
+        (jlong)aws_atomic_load_int(&statistics->response_body_bytes),
+        (jlong)part_buffer_bytes_allocated,
+        (jlong)part_buffer_bytes_in_use);
+}
+
 #if UINTPTR_MAX == 0xffffffff
 #    if defined(_MSC_VER)
 #        pragma warning(pop)
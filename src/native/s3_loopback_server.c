@@ -0,0 +1,776 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <jni.h>
+
+#include <aws/common/atomics.h>
+#include <aws/common/clock.h>
+#include <aws/common/string.h>
+#include <aws/common/thread.h>
+#include <aws/http/connection.h>
+#include <aws/http/request_response.h>
+#include <aws/http/server.h>
+#include <aws/io/channel.h>
+#include <aws/io/socket.h>
+#include <aws/io/stream.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "crt.h"
+#include "java_class_ids.h"
+#include "latency_histogram.h"
+
+/* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(push)
+#        pragma warning(disable : 4305) /* 'type cast': truncation from 'jlong' to 'jni_tls_ctx_options *' */
+#    else
+#        pragma GCC diagnostic push
+#        pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
+#        pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+#    endif
+#endif
+
+#if _MSC_VER
+#    pragma warning(disable : 4204) /* non-constant aggregate initializer */
+#endif
+
+/*
+ * An HTTP/1.1 server answering just enough of the S3 API for an S3Client to GET and PUT objects against it, for
+ * repeatable load tests without S3. Every GET serves the same synthetic object, honouring Range, whose byte at offset
+ * i is (uint8_t)i; every PUT, multipart or not, is counted, discarded and acknowledged. Nothing is authenticated.
+ *
+ * Latency and bandwidth are simulated by holding back each response until the request would have completed: the
+ * configured latency after the request arrived, plus the time its body (the request's for PUT, the response's for GET)
+ * takes at the configured bandwidth. The bytes themselves move at loopback speed, so part completion times are
+ * realistic while the server costs next to no CPU.
+ */
+
+/* Must match S3LoopbackServerMetrics.java */
+enum s3_loopback_server_metric {
+    S3_LOOPBACK_METRIC_TIMESTAMP_NS,
+    S3_LOOPBACK_METRIC_REQUESTS,
+    S3_LOOPBACK_METRIC_GET_REQUESTS,
+    S3_LOOPBACK_METRIC_PUT_REQUESTS,
+    S3_LOOPBACK_METRIC_BYTES_SENT,
+    S3_LOOPBACK_METRIC_BYTES_RECEIVED,
+    S3_LOOPBACK_METRIC_FAILED_REQUESTS,
+    S3_LOOPBACK_METRIC_REQUEST_LATENCY_HISTOGRAM,
+    S3_LOOPBACK_METRIC_VALUE_COUNT = S3_LOOPBACK_METRIC_REQUEST_LATENCY_HISTOGRAM + AWS_JNI_LATENCY_HISTOGRAM_BUCKETS,
+};
+
+struct s3_loopback_server {
+    struct aws_allocator *allocator;
+    struct aws_http_server *server;
+    JavaVM *jvm;
+    jweak java_server;
+
+    uint64_t object_size;
+    uint64_t latency_ns;
+    /* 0 for unlimited */
+    uint64_t bytes_per_second;
+
+    struct aws_atomic_var requests;
+    struct aws_atomic_var get_requests;
+    struct aws_atomic_var put_requests;
+    struct aws_atomic_var bytes_sent;
+    struct aws_atomic_var bytes_received;
+    struct aws_atomic_var failed_requests;
+    /* from the request arriving until its response is flushed */
+    struct aws_jni_latency_histogram request_latency;
+};
+
+enum s3_loopback_request_type {
+    S3_LOOPBACK_REQUEST_GET,
+    S3_LOOPBACK_REQUEST_HEAD,
+    S3_LOOPBACK_REQUEST_PUT,
+    S3_LOOPBACK_REQUEST_CREATE_MULTIPART_UPLOAD,
+    S3_LOOPBACK_REQUEST_COMPLETE_MULTIPART_UPLOAD,
+    S3_LOOPBACK_REQUEST_DELETE,
+    S3_LOOPBACK_REQUEST_UNSUPPORTED,
+};
+
+/*
+ * One request, and its response. Every field is only touched on the connection's channel thread. It's held by the
+ * stream, until the stream is destroyed, and by the response task while it's scheduled.
+ */
+struct s3_loopback_request {
+    struct s3_loopback_server *server;
+    struct aws_channel *channel;
+    struct aws_http_stream *stream;
+    struct aws_channel_task response_task;
+    int ref_count;
+    bool stream_complete;
+
+    uint64_t start_ns;
+    uint64_t start_channel_ns;
+    uint64_t bytes_received;
+
+    bool has_range;
+    uint64_t range_start;
+    /* inclusive, UINT64_MAX for the end of the object */
+    uint64_t range_end;
+
+    uint64_t response_body_length;
+    struct aws_http_message *response;
+};
+
+static const char *s_etag = "\"s3-loopback-etag\"";
+static const char *s_create_multipart_upload_result =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<InitiateMultipartUploadResult><Bucket>loopback</Bucket><Key>object</Key>"
+    "<UploadId>s3-loopback-upload</UploadId></InitiateMultipartUploadResult>";
+static const char *s_complete_multipart_upload_result =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<CompleteMultipartUploadResult><Bucket>loopback</Bucket><Key>object</Key>"
+    "<ETag>\"s3-loopback-etag\"</ETag></CompleteMultipartUploadResult>";
+
+/* The synthetic object: byte i of it is (uint8_t)i, so any range is a slice of this table */
+#define S3_LOOPBACK_PATTERN_CHUNK (64 * 1024)
+static uint8_t s_pattern[S3_LOOPBACK_PATTERN_CHUNK + 256];
+static aws_thread_once s_pattern_once = AWS_THREAD_ONCE_STATIC_INIT;
+
+static void s_init_pattern(void *user_data) {
+    (void)user_data;
+    for (size_t i = 0; i < sizeof(s_pattern); ++i) {
+        s_pattern[i] = (uint8_t)i;
+    }
+}
+
+struct s3_loopback_object_stream {
+    struct aws_input_stream base;
+    struct aws_allocator *allocator;
+    uint64_t start;
+    uint64_t length;
+    uint64_t position;
+};
+
+static int s_object_stream_seek(struct aws_input_stream *stream, int64_t offset, enum aws_stream_seek_basis basis) {
+    struct s3_loopback_object_stream *impl = AWS_CONTAINER_OF(stream, struct s3_loopback_object_stream, base);
+
+    int64_t base_position = basis == AWS_SSB_BEGIN ? 0 : (int64_t)impl->length;
+    int64_t position = base_position + offset;
+    if (position < 0 || (uint64_t)position > impl->length) {
+        return aws_raise_error(AWS_IO_STREAM_INVALID_SEEK_POSITION);
+    }
+
+    impl->position = (uint64_t)position;
+    return AWS_OP_SUCCESS;
+}
+
+static int s_object_stream_read(struct aws_input_stream *stream, struct aws_byte_buf *dest) {
+    struct s3_loopback_object_stream *impl = AWS_CONTAINER_OF(stream, struct s3_loopback_object_stream, base);
+
+    while (impl->position < impl->length && dest->len < dest->capacity) {
+        uint64_t offset = impl->start + impl->position;
+        size_t chunk = dest->capacity - dest->len;
+        if (chunk > S3_LOOPBACK_PATTERN_CHUNK) {
+            chunk = S3_LOOPBACK_PATTERN_CHUNK;
+        }
+        if (chunk > impl->length - impl->position) {
+            chunk = (size_t)(impl->length - impl->position);
+        }
+
+        struct aws_byte_cursor slice = aws_byte_cursor_from_array(s_pattern + (offset % 256), chunk);
+        aws_byte_buf_write_from_whole_cursor(dest, slice);
+        impl->position += chunk;
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_object_stream_get_status(struct aws_input_stream *stream, struct aws_stream_status *status) {
+    struct s3_loopback_object_stream *impl = AWS_CONTAINER_OF(stream, struct s3_loopback_object_stream, base);
+
+    status->is_end_of_stream = impl->position == impl->length;
+    status->is_valid = true;
+    return AWS_OP_SUCCESS;
+}
+
+static int s_object_stream_get_length(struct aws_input_stream *stream, int64_t *length) {
+    struct s3_loopback_object_stream *impl = AWS_CONTAINER_OF(stream, struct s3_loopback_object_stream, base);
+
+    *length = (int64_t)impl->length;
+    return AWS_OP_SUCCESS;
+}
+
+static void s_object_stream_destroy(struct s3_loopback_object_stream *impl) {
+    aws_mem_release(impl->allocator, impl);
+}
+
+static struct aws_input_stream_vtable s_object_stream_vtable = {
+    .seek = s_object_stream_seek,
+    .read = s_object_stream_read,
+    .get_status = s_object_stream_get_status,
+    .get_length = s_object_stream_get_length,
+};
+
+static struct aws_input_stream *s_object_stream_new(struct aws_allocator *allocator, uint64_t start, uint64_t length) {
+    struct s3_loopback_object_stream *impl = aws_mem_calloc(allocator, 1, sizeof(struct s3_loopback_object_stream));
+    impl->allocator = allocator;
+    impl->base.vtable = &s_object_stream_vtable;
+    aws_ref_count_init(&impl->base.ref_count, impl, (aws_simple_completion_callback *)s_object_stream_destroy);
+    impl->start = start;
+    impl->length = length;
+    return &impl->base;
+}
+
+static void s_request_release(struct s3_loopback_request *request) {
+    if (--request->ref_count > 0) {
+        return;
+    }
+
+    if (request->response != NULL) {
+        aws_http_message_release(request->response);
+    }
+    aws_mem_release(request->server->allocator, request);
+}
+
+static bool s_query_has_param(struct aws_byte_cursor query, const char *name) {
+    struct aws_byte_cursor param;
+    AWS_ZERO_STRUCT(param);
+    while (aws_byte_cursor_next_split(&query, '&', &param)) {
+        struct aws_byte_cursor param_name = param;
+        for (size_t i = 0; i < param.len; ++i) {
+            if (param.ptr[i] == '=') {
+                param_name.len = i;
+                break;
+            }
+        }
+        if (aws_byte_cursor_eq_c_str(&param_name, name)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static enum s3_loopback_request_type s_request_type(struct aws_http_stream *stream) {
+    struct aws_byte_cursor method;
+    struct aws_byte_cursor uri;
+    if (aws_http_stream_get_incoming_request_method(stream, &method) ||
+        aws_http_stream_get_incoming_request_uri(stream, &uri)) {
+        return S3_LOOPBACK_REQUEST_UNSUPPORTED;
+    }
+
+    struct aws_byte_cursor query;
+    AWS_ZERO_STRUCT(query);
+    for (size_t i = 0; i < uri.len; ++i) {
+        if (uri.ptr[i] == '?') {
+            query = aws_byte_cursor_from_array(uri.ptr + i + 1, uri.len - i - 1);
+            break;
+        }
+    }
+
+    if (aws_byte_cursor_eq(&method, &aws_http_method_get)) {
+        return S3_LOOPBACK_REQUEST_GET;
+    }
+    if (aws_byte_cursor_eq_c_str(&method, "HEAD")) {
+        return S3_LOOPBACK_REQUEST_HEAD;
+    }
+    if (aws_byte_cursor_eq(&method, &aws_http_method_put)) {
+        return S3_LOOPBACK_REQUEST_PUT;
+    }
+    if (aws_byte_cursor_eq(&method, &aws_http_method_post)) {
+        if (s_query_has_param(query, "uploads")) {
+            return S3_LOOPBACK_REQUEST_CREATE_MULTIPART_UPLOAD;
+        }
+        if (s_query_has_param(query, "uploadId")) {
+            return S3_LOOPBACK_REQUEST_COMPLETE_MULTIPART_UPLOAD;
+        }
+    }
+    if (aws_byte_cursor_eq_c_str(&method, "DELETE")) {
+        return S3_LOOPBACK_REQUEST_DELETE;
+    }
+    return S3_LOOPBACK_REQUEST_UNSUPPORTED;
+}
+
+/* Parses "bytes=start-end" or "bytes=start-" */
+static void s_parse_range(struct s3_loopback_request *request, struct aws_byte_cursor value) {
+    struct aws_byte_cursor prefix = aws_byte_cursor_from_c_str("bytes=");
+    if (!aws_byte_cursor_starts_with(&value, &prefix)) {
+        return;
+    }
+    aws_byte_cursor_advance(&value, prefix.len);
+
+    struct aws_byte_cursor start = value;
+    struct aws_byte_cursor end;
+    AWS_ZERO_STRUCT(end);
+    for (size_t i = 0; i < value.len; ++i) {
+        if (value.ptr[i] == '-') {
+            start.len = i;
+            end = aws_byte_cursor_from_array(value.ptr + i + 1, value.len - i - 1);
+            break;
+        }
+    }
+
+    uint64_t range_start = 0;
+    uint64_t range_end = UINT64_MAX;
+    if (aws_byte_cursor_utf8_parse_u64(start, &range_start)) {
+        return;
+    }
+    if (end.len > 0 && aws_byte_cursor_utf8_parse_u64(end, &range_end)) {
+        return;
+    }
+
+    request->has_range = true;
+    request->range_start = range_start;
+    request->range_end = range_end;
+}
+
+static int s_on_request_headers(
+    struct aws_http_stream *stream,
+    enum aws_http_header_block header_block,
+    const struct aws_http_header *header_array,
+    size_t num_headers,
+    void *user_data) {
+    (void)stream;
+    (void)header_block;
+
+    struct s3_loopback_request *request = user_data;
+    for (size_t i = 0; i < num_headers; ++i) {
+        if (aws_byte_cursor_eq_c_str_ignore_case(&header_array[i].name, "Range")) {
+            s_parse_range(request, header_array[i].value);
+        }
+    }
+    return AWS_OP_SUCCESS;
+}
+
+static int s_on_request_body(struct aws_http_stream *stream, const struct aws_byte_cursor *data, void *user_data) {
+    (void)stream;
+
+    struct s3_loopback_request *request = user_data;
+    request->bytes_received += data->len;
+    return AWS_OP_SUCCESS;
+}
+
+static void s_add_header(struct aws_http_message *message, const char *name, struct aws_byte_cursor value) {
+    struct aws_http_header header = {
+        .name = aws_byte_cursor_from_c_str(name),
+        .value = value,
+    };
+    aws_http_message_add_header(message, header);
+}
+
+static void s_add_u64_header(struct aws_http_message *message, const char *name, uint64_t value) {
+    char value_str[32];
+    snprintf(value_str, sizeof(value_str), "%" PRIu64, value);
+    s_add_header(message, name, aws_byte_cursor_from_c_str(value_str));
+}
+
+static void s_set_body(struct aws_http_message *message, struct aws_input_stream *body, uint64_t length) {
+    s_add_u64_header(message, "Content-Length", length);
+    if (body != NULL) {
+        aws_http_message_set_body_stream(message, body);
+        aws_input_stream_release(body);
+    }
+}
+
+static void s_set_xml_body(struct aws_allocator *allocator, struct aws_http_message *message, const char *xml) {
+    struct aws_byte_cursor xml_cursor = aws_byte_cursor_from_c_str(xml);
+    s_add_header(message, "Content-Type", aws_byte_cursor_from_c_str("application/xml"));
+    s_set_body(message, aws_input_stream_new_from_cursor(allocator, &xml_cursor), xml_cursor.len);
+}
+
+/* Builds the response, returning the length of its body */
+static struct aws_http_message *s_build_response(
+    struct s3_loopback_request *request,
+    enum s3_loopback_request_type type,
+    uint64_t *out_body_length) {
+
+    struct s3_loopback_server *server = request->server;
+    struct aws_allocator *allocator = server->allocator;
+    struct aws_http_message *response = aws_http_message_new_response(allocator);
+    *out_body_length = 0;
+
+    switch (type) {
+        case S3_LOOPBACK_REQUEST_GET:
+        case S3_LOOPBACK_REQUEST_HEAD: {
+            uint64_t start = 0;
+            uint64_t end = server->object_size > 0 ? server->object_size - 1 : 0;
+            int status = AWS_HTTP_STATUS_CODE_200_OK;
+            if (request->has_range) {
+                /* bytes=10-5 would underflow the length below */
+                if (request->range_start >= server->object_size || request->range_end < request->range_start) {
+                    aws_http_message_set_response_status(
+                        response, AWS_HTTP_STATUS_CODE_416_REQUESTED_RANGE_NOT_SATISFIABLE);
+                    s_set_body(response, NULL, 0);
+                    return response;
+                }
+                start = request->range_start;
+                if (request->range_end < end) {
+                    end = request->range_end;
+                }
+                status = AWS_HTTP_STATUS_CODE_206_PARTIAL_CONTENT;
+
+                char content_range[96];
+                snprintf(
+                    content_range,
+                    sizeof(content_range),
+                    "bytes %" PRIu64 "-%" PRIu64 "/%" PRIu64,
+                    start,
+                    end,
+                    server->object_size);
+                s_add_header(response, "Content-Range", aws_byte_cursor_from_c_str(content_range));
+            }
+
+            uint64_t length = server->object_size > 0 ? end - start + 1 : 0;
+            aws_http_message_set_response_status(response, status);
+            s_add_header(response, "ETag", aws_byte_cursor_from_c_str(s_etag));
+            s_add_header(response, "Content-Type", aws_byte_cursor_from_c_str("application/octet-stream"));
+            /* HEAD gets the same headers, the server knows not to expect a body */
+            struct aws_input_stream *body = NULL;
+            if (type == S3_LOOPBACK_REQUEST_GET) {
+                body = s_object_stream_new(allocator, start, length);
+                *out_body_length = length;
+            }
+            s_set_body(response, body, length);
+            break;
+        }
+        case S3_LOOPBACK_REQUEST_PUT:
+            aws_http_message_set_response_status(response, AWS_HTTP_STATUS_CODE_200_OK);
+            s_add_header(response, "ETag", aws_byte_cursor_from_c_str(s_etag));
+            s_set_body(response, NULL, 0);
+            break;
+        case S3_LOOPBACK_REQUEST_CREATE_MULTIPART_UPLOAD:
+            aws_http_message_set_response_status(response, AWS_HTTP_STATUS_CODE_200_OK);
+            s_set_xml_body(allocator, response, s_create_multipart_upload_result);
+            break;
+        case S3_LOOPBACK_REQUEST_COMPLETE_MULTIPART_UPLOAD:
+            aws_http_message_set_response_status(response, AWS_HTTP_STATUS_CODE_200_OK);
+            s_set_xml_body(allocator, response, s_complete_multipart_upload_result);
+            break;
+        case S3_LOOPBACK_REQUEST_DELETE:
+            aws_http_message_set_response_status(response, AWS_HTTP_STATUS_CODE_204_NO_CONTENT);
+            break;
+        default:
+            aws_http_message_set_response_status(response, AWS_HTTP_STATUS_CODE_405_METHOD_NOT_ALLOWED);
+            s_set_body(response, NULL, 0);
+            break;
+    }
+
+    return response;
+}
+
+static void s_send_response_task(struct aws_channel_task *task, void *arg, enum aws_task_status status) {
+    (void)task;
+
+    struct s3_loopback_request *request = arg;
+    /* a stream that completed early, with the connection shutting down, no longer takes a response */
+    if (status == AWS_TASK_STATUS_RUN_READY && !request->stream_complete) {
+        if (aws_http_stream_send_response(request->stream, request->response) == AWS_OP_SUCCESS) {
+            aws_atomic_fetch_add(&request->server->bytes_sent, (size_t)request->response_body_length);
+        }
+    }
+    s_request_release(request);
+}
+
+static int s_on_request_done(struct aws_http_stream *stream, void *user_data) {
+    struct s3_loopback_request *request = user_data;
+    struct s3_loopback_server *server = request->server;
+
+    enum s3_loopback_request_type type = s_request_type(stream);
+    if (type == S3_LOOPBACK_REQUEST_GET) {
+        aws_atomic_fetch_add(&server->get_requests, 1);
+    } else if (type == S3_LOOPBACK_REQUEST_PUT) {
+        aws_atomic_fetch_add(&server->put_requests, 1);
+    }
+    aws_atomic_fetch_add(&server->bytes_received, (size_t)request->bytes_received);
+
+    request->response = s_build_response(request, type, &request->response_body_length);
+
+    /* hold the response back until the request would have completed at the configured latency and bandwidth */
+    uint64_t delay_ns = server->latency_ns;
+    if (server->bytes_per_second > 0) {
+        uint64_t body_bytes = request->bytes_received + request->response_body_length;
+        delay_ns = aws_add_u64_saturating(
+            delay_ns, aws_mul_u64_saturating(body_bytes, AWS_TIMESTAMP_NANOS) / server->bytes_per_second);
+    }
+
+    ++request->ref_count;
+    aws_channel_task_init(&request->response_task, s_send_response_task, request, "s3_loopback_send_response");
+    aws_channel_schedule_task_future(
+        request->channel, &request->response_task, aws_add_u64_saturating(request->start_channel_ns, delay_ns));
+
+    return AWS_OP_SUCCESS;
+}
+
+static void s_on_request_complete(struct aws_http_stream *stream, int error_code, void *user_data) {
+    struct s3_loopback_request *request = user_data;
+    struct s3_loopback_server *server = request->server;
+
+    request->stream_complete = true;
+
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+    aws_jni_latency_histogram_record_ns(&server->request_latency, now_ns - request->start_ns);
+    aws_atomic_fetch_add(&server->requests, 1);
+    if (error_code != AWS_ERROR_SUCCESS) {
+        aws_atomic_fetch_add(&server->failed_requests, 1);
+    }
+
+    aws_http_stream_release(stream);
+}
+
+static void s_on_request_destroy(void *user_data) {
+    s_request_release(user_data);
+}
+
+static struct aws_http_stream *s_on_incoming_request(struct aws_http_connection *connection, void *user_data) {
+    struct s3_loopback_server *server = user_data;
+
+    struct s3_loopback_request *request = aws_mem_calloc(server->allocator, 1, sizeof(struct s3_loopback_request));
+    request->server = server;
+    request->channel = aws_http_connection_get_channel(connection);
+    request->ref_count = 1;
+    aws_high_res_clock_get_ticks(&request->start_ns);
+    aws_channel_current_clock_time(request->channel, &request->start_channel_ns);
+
+    struct aws_http_request_handler_options options = AWS_HTTP_REQUEST_HANDLER_OPTIONS_INIT;
+    options.server_connection = connection;
+    options.user_data = request;
+    options.on_request_headers = s_on_request_headers;
+    options.on_request_body = s_on_request_body;
+    options.on_request_done = s_on_request_done;
+    options.on_complete = s_on_request_complete;
+    options.on_destroy = s_on_request_destroy;
+
+    request->stream = aws_http_stream_new_server_request_handler(&options);
+    if (request->stream == NULL) {
+        aws_mem_release(server->allocator, request);
+        return NULL;
+    }
+
+    return request->stream;
+}
+
+static void s_on_connection_shutdown(struct aws_http_connection *connection, int error_code, void *user_data) {
+    (void)error_code;
+    (void)user_data;
+
+    aws_http_connection_release(connection);
+}
+
+static void s_on_incoming_connection(
+    struct aws_http_server *http_server,
+    struct aws_http_connection *connection,
+    int error_code,
+    void *user_data) {
+    (void)http_server;
+
+    if (error_code != AWS_ERROR_SUCCESS) {
+        return;
+    }
+
+    struct aws_http_server_connection_options options = {
+        .self_size = sizeof(struct aws_http_server_connection_options),
+        .connection_user_data = user_data,
+        .on_incoming_request = s_on_incoming_request,
+        .on_shutdown = s_on_connection_shutdown,
+    };
+
+    if (aws_http_connection_configure_server(connection, &options)) {
+        aws_http_connection_release(connection);
+    }
+}
+
+static void s_server_destroy(JNIEnv *env, struct s3_loopback_server *server) {
+    if (server->java_server != NULL) {
+        (*env)->DeleteWeakGlobalRef(env, server->java_server);
+    }
+    aws_mem_release(server->allocator, server);
+}
+
+/* The listener and every connection it accepted are gone */
+static void s_on_server_destroy_complete(void *user_data) {
+    struct s3_loopback_server *server = user_data;
+
+    /********** JNI ENV ACQUIRE **********/
+    JavaVM *jvm = server->jvm;
+    JNIEnv *env = aws_jni_acquire_thread_env(jvm);
+    if (env == NULL) {
+        /* If we can't get an environment, then the JVM is probably shutting down.  Don't crash. */
+        return;
+    }
+
+    jobject java_server = (*env)->NewLocalRef(env, server->java_server);
+    if (java_server != NULL) {
+        (*env)->CallVoidMethod(env, java_server, s3_loopback_server_properties.onShutdownComplete);
+        aws_jni_check_and_clear_exception(env);
+        (*env)->DeleteLocalRef(env, java_server);
+    }
+
+    s_server_destroy(env, server);
+
+    aws_jni_release_thread_env(jvm, env);
+    /********** JNI ENV RELEASE **********/
+}
+
+JNIEXPORT
+jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3LoopbackServer_s3LoopbackServerNew(
+    JNIEnv *env,
+    jclass jni_class,
+    jobject java_server,
+    jlong jni_server_bootstrap,
+    jlong jni_socket_options,
+    jstring jni_host,
+    jint port,
+    jlong object_size,
+    jlong latency_ms,
+    jlong bytes_per_second) {
+    (void)jni_class;
+    cache_java_class_ids_for_s3(env);
+
+    struct aws_server_bootstrap *server_bootstrap = (struct aws_server_bootstrap *)jni_server_bootstrap;
+    struct aws_socket_options *socket_options = (struct aws_socket_options *)jni_socket_options;
+    if (server_bootstrap == NULL) {
+        aws_jni_throw_illegal_argument_exception(env, "S3LoopbackServer: Invalid ServerBootstrap");
+        return (jlong)NULL;
+    }
+    if (socket_options == NULL) {
+        aws_jni_throw_illegal_argument_exception(env, "S3LoopbackServer: Invalid SocketOptions");
+        return (jlong)NULL;
+    }
+    if (port < 0 || port > UINT16_MAX || object_size < 0 || latency_ms < 0 || bytes_per_second < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "S3LoopbackServer: Invalid options");
+        return (jlong)NULL;
+    }
+
+    aws_thread_call_once(&s_pattern_once, s_init_pattern, NULL);
+
+    struct aws_allocator *allocator = aws_jni_s3_allocator();
+    struct s3_loopback_server *server = aws_mem_calloc(allocator, 1, sizeof(struct s3_loopback_server));
+    server->allocator = allocator;
+    server->object_size = (uint64_t)object_size;
+    server->latency_ns = aws_timestamp_convert((uint64_t)latency_ms, AWS_TIMESTAMP_MILLIS, AWS_TIMESTAMP_NANOS, NULL);
+    server->bytes_per_second = (uint64_t)bytes_per_second;
+    aws_atomic_init_int(&server->requests, 0);
+    aws_atomic_init_int(&server->get_requests, 0);
+    aws_atomic_init_int(&server->put_requests, 0);
+    aws_atomic_init_int(&server->bytes_sent, 0);
+    aws_atomic_init_int(&server->bytes_received, 0);
+    aws_atomic_init_int(&server->failed_requests, 0);
+    aws_jni_latency_histogram_init(&server->request_latency);
+
+    jint jvmresult = (*env)->GetJavaVM(env, &server->jvm);
+    AWS_FATAL_ASSERT(jvmresult == 0);
+
+    server->java_server = (*env)->NewWeakGlobalRef(env, java_server);
+    if (server->java_server == NULL) {
+        aws_jni_throw_runtime_exception(env, "S3LoopbackServer: Unable to create global weak ref");
+        goto on_error;
+    }
+
+    struct aws_socket_endpoint endpoint;
+    AWS_ZERO_STRUCT(endpoint);
+    struct aws_string *host = aws_jni_new_string_from_jstring(env, jni_host);
+    if (host == NULL) {
+        aws_jni_throw_runtime_exception(env, "S3LoopbackServer: Unable to get host string");
+        goto on_error;
+    }
+    if (host->len >= sizeof(endpoint.address)) {
+        aws_string_destroy(host);
+        aws_jni_throw_illegal_argument_exception(env, "S3LoopbackServer: host is too long");
+        goto on_error;
+    }
+    memcpy(endpoint.address, aws_string_c_str(host), host->len);
+    endpoint.port = (uint16_t)port;
+    aws_string_destroy(host);
+
+    struct aws_http_server_options options = {
+        .self_size = sizeof(struct aws_http_server_options),
+        .allocator = allocator,
+        .bootstrap = server_bootstrap,
+        .endpoint = &endpoint,
+        .socket_options = socket_options,
+        .initial_window_size = SIZE_MAX,
+        .server_user_data = server,
+        .on_incoming_connection = s_on_incoming_connection,
+        .on_destroy_complete = s_on_server_destroy_complete,
+    };
+
+    server->server = aws_http_server_new(&options);
+    if (server->server == NULL) {
+        aws_jni_throw_crt_error(env, aws_last_error());
+        goto on_error;
+    }
+
+    return (jlong)server;
+
+on_error:
+
+    s_server_destroy(env, server);
+    return (jlong)NULL;
+}
+
+JNIEXPORT
+jint JNICALL Java_software_amazon_awssdk_crt_s3_S3LoopbackServer_s3LoopbackServerGetBoundPort(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_server) {
+    (void)env;
+    (void)jni_class;
+
+    struct s3_loopback_server *server = (struct s3_loopback_server *)jni_server;
+    const struct aws_socket_endpoint *endpoint = aws_http_server_get_listener_endpoint(server->server);
+    return endpoint != NULL ? (jint)endpoint->port : -1;
+}
+
+JNIEXPORT
+jlongArray JNICALL Java_software_amazon_awssdk_crt_s3_S3LoopbackServer_s3LoopbackServerMetrics(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_server) {
+    (void)jni_class;
+
+    struct s3_loopback_server *server = (struct s3_loopback_server *)jni_server;
+
+    int64_t values[S3_LOOPBACK_METRIC_VALUE_COUNT];
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+    values[S3_LOOPBACK_METRIC_TIMESTAMP_NS] = (int64_t)now_ns;
+    values[S3_LOOPBACK_METRIC_REQUESTS] = (int64_t)aws_atomic_load_int(&server->requests);
+    values[S3_LOOPBACK_METRIC_GET_REQUESTS] = (int64_t)aws_atomic_load_int(&server->get_requests);
+    values[S3_LOOPBACK_METRIC_PUT_REQUESTS] = (int64_t)aws_atomic_load_int(&server->put_requests);
+    values[S3_LOOPBACK_METRIC_BYTES_SENT] = (int64_t)aws_atomic_load_int(&server->bytes_sent);
+    values[S3_LOOPBACK_METRIC_BYTES_RECEIVED] = (int64_t)aws_atomic_load_int(&server->bytes_received);
+    values[S3_LOOPBACK_METRIC_FAILED_REQUESTS] = (int64_t)aws_atomic_load_int(&server->failed_requests);
+    aws_jni_latency_histogram_snapshot(
+        &server->request_latency, values + S3_LOOPBACK_METRIC_REQUEST_LATENCY_HISTOGRAM);
+
+    jlongArray result = (*env)->NewLongArray(env, S3_LOOPBACK_METRIC_VALUE_COUNT);
+    if (result == NULL) {
+        /* an OutOfMemoryError is pending */
+        return NULL;
+    }
+    (*env)->SetLongArrayRegion(env, result, 0, S3_LOOPBACK_METRIC_VALUE_COUNT, (const jlong *)values);
+    return result;
+}
+
+JNIEXPORT
+void JNICALL Java_software_amazon_awssdk_crt_s3_S3LoopbackServer_s3LoopbackServerRelease(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_server) {
+    (void)env;
+    (void)jni_class;
+
+    struct s3_loopback_server *server = (struct s3_loopback_server *)jni_server;
+    if (server == NULL) {
+        return;
+    }
+
+    /* s_on_server_destroy_complete() frees the rest once every connection is gone */
+    aws_http_server_release(server->server);
+}
+
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(pop)
+#    else
+#        pragma GCC diagnostic pop
+#    endif
+#endif
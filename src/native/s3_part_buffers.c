@@ -0,0 +1,608 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+#include "crt.h"
+#include "java_class_ids.h"
+#include "s3_part_buffers.h"
+
+#include <aws/common/array_list.h>
+#include <aws/common/condition_variable.h>
+#include <aws/common/mutex.h>
+#include <aws/common/ref_count.h>
+#include <aws/common/system_info.h>
+#include <aws/common/thread.h>
+#include <aws/io/stream.h>
+
+#include <jni.h>
+#include <string.h>
+
+/* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(push)
+#        pragma warning(disable : 4305) /* 'type cast': truncation from 'jlong' to 'jni_tls_ctx_options *' */
+#    else
+#        pragma GCC diagnostic push
+#        pragma GCC diagnostic ignored "-Wpointer-to-int-cast"
+#        pragma GCC diagnostic ignored "-Wint-to-pointer-cast"
+#    endif
+#endif
+
+/* aws-c-s3 uses 8MB parts when the client is created without a part size */
+#define S3_DEFAULT_PART_BUFFER_SIZE (8 * 1024 * 1024)
+
+/*
+ * A bounded pool of part-sized native buffers that Java fills directly through direct ByteBuffers.
+ * Released buffers are kept on a free list and handed out again instead of being freed, so the steady state
+ * is allocation-free and the native memory held for uploads never exceeds buffer_size * max_buffers.
+ */
+struct s3_part_buffer_pool {
+    struct aws_allocator *allocator;
+    struct aws_ref_count ref_count;
+    size_t buffer_size;
+    size_t max_buffers;
+
+    struct aws_mutex lock;
+    /* Everything below is protected by the lock */
+    size_t num_allocated;
+    struct aws_array_list free_buffers; /* struct s3_part_buffer * */
+};
+
+struct s3_part_buffer {
+    struct s3_part_buffer_pool *pool;
+    struct aws_byte_buf buf;
+};
+
+static void s_s3_part_buffer_pool_destroy(void *user_data) {
+    struct s3_part_buffer_pool *pool = user_data;
+
+    const size_t free_count = aws_array_list_length(&pool->free_buffers);
+    for (size_t i = 0; i < free_count; ++i) {
+        struct s3_part_buffer *part_buffer = NULL;
+        aws_array_list_get_at(&pool->free_buffers, &part_buffer, i);
+        aws_byte_buf_clean_up(&part_buffer->buf);
+        aws_mem_release(pool->allocator, part_buffer);
+    }
+
+    aws_array_list_clean_up(&pool->free_buffers);
+    aws_mutex_clean_up(&pool->lock);
+    aws_mem_release(pool->allocator, pool);
+}
+
+static struct s3_part_buffer *s_s3_part_buffer_new(struct s3_part_buffer_pool *pool) {
+    struct s3_part_buffer *part_buffer = aws_mem_calloc(pool->allocator, 1, sizeof(struct s3_part_buffer));
+    AWS_FATAL_ASSERT(part_buffer);
+    AWS_FATAL_ASSERT(AWS_OP_SUCCESS == aws_byte_buf_init(&part_buffer->buf, pool->allocator, pool->buffer_size));
+    part_buffer->pool = pool;
+    return part_buffer;
+}
+
+/*
+ * Runs pinned to a cpu of the pool's cpu group. Linux places a page on the NUMA node of the thread that first writes
+ * it, so writing every buffer here, before Java or the event loops touch it, makes the whole pool node-local.
+ */
+static void s_s3_part_buffer_pool_prefault(void *user_data) {
+    struct s3_part_buffer_pool *pool = user_data;
+
+    for (size_t i = 0; i < pool->max_buffers; ++i) {
+        struct s3_part_buffer *part_buffer = s_s3_part_buffer_new(pool);
+        memset(part_buffer->buf.buffer, 0, part_buffer->buf.capacity);
+        AWS_FATAL_ASSERT(AWS_OP_SUCCESS == aws_array_list_push_back(&pool->free_buffers, &part_buffer));
+    }
+    pool->num_allocated = pool->max_buffers;
+}
+
+/*
+ * Allocates the whole pool up front from a thread pinned to cpu_group. If that thread can't be started, the pool
+ * just allocates on demand like any other.
+ */
+static void s_s3_part_buffer_pool_allocate_on_cpu_group(struct s3_part_buffer_pool *pool, uint16_t cpu_group) {
+    size_t cpu_count = aws_get_cpu_count_for_group(cpu_group);
+    if (cpu_count == 0) {
+        return;
+    }
+
+    struct aws_cpu_info *cpu_info = aws_mem_calloc(pool->allocator, cpu_count, sizeof(struct aws_cpu_info));
+    AWS_FATAL_ASSERT(cpu_info);
+    aws_get_cpu_ids_for_group(cpu_group, cpu_info, cpu_count);
+
+    struct aws_thread_options thread_options = *aws_default_thread_options();
+    thread_options.cpu_id = cpu_info[0].cpu_id;
+    thread_options.name = aws_byte_cursor_from_c_str("AwsPartBufs");
+    aws_mem_release(pool->allocator, cpu_info);
+
+    struct aws_thread prefault_thread;
+    aws_thread_init(&prefault_thread, pool->allocator);
+    /* Nothing else can see the pool yet, so it's filled without the lock */
+    if (aws_thread_launch(&prefault_thread, s_s3_part_buffer_pool_prefault, pool, &thread_options) == AWS_OP_SUCCESS) {
+        aws_thread_join(&prefault_thread);
+    }
+    aws_thread_clean_up(&prefault_thread);
+}
+
+static struct s3_part_buffer *s_s3_part_buffer_acquire(struct s3_part_buffer_pool *pool) {
+    struct s3_part_buffer *part_buffer = NULL;
+    bool allocate_new = false;
+
+    aws_mutex_lock(&pool->lock);
+    if (aws_array_list_length(&pool->free_buffers) > 0) {
+        aws_array_list_back(&pool->free_buffers, &part_buffer);
+        aws_array_list_pop_back(&pool->free_buffers);
+    } else if (pool->num_allocated < pool->max_buffers) {
+        ++pool->num_allocated;
+        allocate_new = true;
+    }
+    aws_mutex_unlock(&pool->lock);
+
+    if (allocate_new) {
+        part_buffer = s_s3_part_buffer_new(pool);
+    }
+
+    if (part_buffer != NULL) {
+        part_buffer->buf.len = 0;
+        /* Every outstanding buffer keeps the pool alive */
+        aws_ref_count_acquire(&pool->ref_count);
+    }
+
+    return part_buffer;
+}
+
+static void s_s3_part_buffer_release(struct s3_part_buffer *part_buffer) {
+    struct s3_part_buffer_pool *pool = part_buffer->pool;
+
+    aws_mutex_lock(&pool->lock);
+    AWS_FATAL_ASSERT(AWS_OP_SUCCESS == aws_array_list_push_back(&pool->free_buffers, &part_buffer));
+    aws_mutex_unlock(&pool->lock);
+
+    aws_ref_count_release(&pool->ref_count);
+}
+
+void aws_jni_s3_part_buffer_pool_get_stats(
+    struct s3_part_buffer_pool *pool,
+    size_t *out_allocated_bytes,
+    size_t *out_in_use_bytes) {
+
+    aws_mutex_lock(&pool->lock);
+    size_t num_allocated = pool->num_allocated;
+    size_t num_free = aws_array_list_length(&pool->free_buffers);
+    aws_mutex_unlock(&pool->lock);
+
+    *out_allocated_bytes = num_allocated * pool->buffer_size;
+    *out_in_use_bytes = (num_allocated - num_free) * pool->buffer_size;
+}
+
+/*
+ * Request body stream that is fed with filled part buffers from Java, in part-number order.
+ *
+ * Reads happen on aws-c-s3 threads and block until the next part has been submitted, the same way a Java
+ * HttpRequestBodyStream blocks those threads while it produces data; the pinned aws-c-s3 has no way for a body to
+ * report that it would block. Each part goes back to the pool as soon as it has been read, so an upload of any size
+ * only ever holds as many buffers as the pool has.
+ *
+ * A reader can only wait on a part Java is still able to submit: parts submitted out of order may never take the
+ * last buffer of the pool away from the part being waited on, complete() rejects a queue with a part missing, and
+ * releasing the queue before completing it wakes the reader up to fail the stream.
+ */
+struct s3_part_buffer_stream {
+    struct aws_input_stream base;
+    struct aws_allocator *allocator;
+
+    struct aws_mutex lock;
+    struct aws_condition_variable signal;
+    /* Everything below is protected by the lock */
+    struct aws_array_list parts; /* struct s3_part_buffer *, indexed by part number - 1 */
+    size_t next_part_index;
+    bool is_complete;
+    /* released by Java before being completed, the parts it was missing will never arrive */
+    bool is_abandoned;
+
+    /* Only touched by the reader */
+    size_t current_part_offset;
+};
+
+static int s_s3_part_buffer_stream_seek(
+    struct aws_input_stream *stream,
+    int64_t offset,
+    enum aws_stream_seek_basis basis) {
+    struct s3_part_buffer_stream *impl = AWS_CONTAINER_OF(stream, struct s3_part_buffer_stream, base);
+
+    /* Consumed parts are returned to the pool right away, so the only valid seek is a no-op to the start */
+    aws_mutex_lock(&impl->lock);
+    bool at_start = impl->next_part_index == 0 && impl->current_part_offset == 0;
+    aws_mutex_unlock(&impl->lock);
+
+    if (basis != AWS_SSB_BEGIN || offset != 0 || !at_start) {
+        return aws_raise_error(AWS_ERROR_STREAM_UNSEEKABLE);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static bool s_s3_part_buffer_stream_next_part_ready(void *user_data) {
+    struct s3_part_buffer_stream *impl = user_data;
+    if (impl->is_complete || impl->is_abandoned) {
+        return true;
+    }
+
+    struct s3_part_buffer *part_buffer = NULL;
+    if (impl->next_part_index < aws_array_list_length(&impl->parts)) {
+        aws_array_list_get_at(&impl->parts, &part_buffer, impl->next_part_index);
+    }
+
+    return part_buffer != NULL;
+}
+
+static int s_s3_part_buffer_stream_read(struct aws_input_stream *stream, struct aws_byte_buf *dest) {
+    struct s3_part_buffer_stream *impl = AWS_CONTAINER_OF(stream, struct s3_part_buffer_stream, base);
+
+    struct s3_part_buffer *part_buffer = NULL;
+
+    aws_mutex_lock(&impl->lock);
+    aws_condition_variable_wait_pred(&impl->signal, &impl->lock, s_s3_part_buffer_stream_next_part_ready, impl);
+    const size_t num_parts = aws_array_list_length(&impl->parts);
+    if (impl->next_part_index < num_parts) {
+        aws_array_list_get_at(&impl->parts, &part_buffer, impl->next_part_index);
+    }
+    const bool end_of_stream = impl->is_complete && impl->next_part_index >= num_parts;
+    aws_mutex_unlock(&impl->lock);
+
+    if (part_buffer == NULL) {
+        if (end_of_stream) {
+            return AWS_OP_SUCCESS;
+        }
+        /* abandoned, the part will never arrive and the body can't be finished */
+        return aws_raise_error(AWS_IO_STREAM_READ_FAILED);
+    }
+
+    struct aws_byte_cursor remaining = aws_byte_cursor_from_buf(&part_buffer->buf);
+    aws_byte_cursor_advance(&remaining, impl->current_part_offset);
+
+    size_t space = dest->capacity - dest->len;
+    struct aws_byte_cursor chunk = aws_byte_cursor_advance(&remaining, space < remaining.len ? space : remaining.len);
+    aws_byte_buf_write_from_whole_cursor(dest, chunk);
+    impl->current_part_offset += chunk.len;
+
+    if (remaining.len == 0) {
+        struct s3_part_buffer *consumed = NULL;
+
+        aws_mutex_lock(&impl->lock);
+        aws_array_list_set_at(&impl->parts, &consumed, impl->next_part_index);
+        ++impl->next_part_index;
+        aws_mutex_unlock(&impl->lock);
+
+        impl->current_part_offset = 0;
+        s_s3_part_buffer_release(part_buffer);
+    }
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_s3_part_buffer_stream_get_status(struct aws_input_stream *stream, struct aws_stream_status *status) {
+    struct s3_part_buffer_stream *impl = AWS_CONTAINER_OF(stream, struct s3_part_buffer_stream, base);
+
+    aws_mutex_lock(&impl->lock);
+    status->is_end_of_stream = impl->is_complete && impl->next_part_index >= aws_array_list_length(&impl->parts);
+    status->is_valid = !impl->is_abandoned;
+    aws_mutex_unlock(&impl->lock);
+
+    return AWS_OP_SUCCESS;
+}
+
+static int s_s3_part_buffer_stream_get_length(struct aws_input_stream *stream, int64_t *length) {
+    (void)stream;
+    (void)length;
+
+    /* Parts are still being produced, the request's Content-Length header is authoritative */
+    return aws_raise_error(AWS_ERROR_UNSUPPORTED_OPERATION);
+}
+
+static void s_s3_part_buffer_stream_destroy(void *user_data) {
+    struct s3_part_buffer_stream *impl = user_data;
+
+    const size_t num_parts = aws_array_list_length(&impl->parts);
+    for (size_t i = 0; i < num_parts; ++i) {
+        struct s3_part_buffer *part_buffer = NULL;
+        aws_array_list_get_at(&impl->parts, &part_buffer, i);
+        if (part_buffer != NULL) {
+            s_s3_part_buffer_release(part_buffer);
+        }
+    }
+
+    aws_array_list_clean_up(&impl->parts);
+    aws_condition_variable_clean_up(&impl->signal);
+    aws_mutex_clean_up(&impl->lock);
+    aws_mem_release(impl->allocator, impl);
+}
+
+static struct aws_input_stream_vtable s_s3_part_buffer_stream_vtable = {
+    .seek = s_s3_part_buffer_stream_seek,
+    .read = s_s3_part_buffer_stream_read,
+    .get_status = s_s3_part_buffer_stream_get_status,
+    .get_length = s_s3_part_buffer_stream_get_length,
+};
+
+JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3PartBufferPoolNew(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong part_size_jlong,
+    jint max_buffers,
+    jint cpu_group) {
+    (void)jni_class;
+
+    size_t part_size;
+    if (aws_size_t_from_java(env, &part_size, part_size_jlong, "Part size")) {
+        return (jlong)NULL;
+    }
+
+    if (max_buffers <= 0) {
+        aws_jni_throw_illegal_argument_exception(
+            env, "S3Client.s3PartBufferPoolNew: max part buffers must be positive");
+        return (jlong)NULL;
+    }
+
+    struct aws_allocator *allocator = aws_jni_s3_allocator();
+    struct s3_part_buffer_pool *pool = aws_mem_calloc(allocator, 1, sizeof(struct s3_part_buffer_pool));
+    AWS_FATAL_ASSERT(pool);
+
+    pool->allocator = allocator;
+    pool->buffer_size = part_size != 0 ? part_size : S3_DEFAULT_PART_BUFFER_SIZE;
+    pool->max_buffers = (size_t)max_buffers;
+    aws_ref_count_init(&pool->ref_count, pool, s_s3_part_buffer_pool_destroy);
+    AWS_FATAL_ASSERT(AWS_OP_SUCCESS == aws_mutex_init(&pool->lock));
+    AWS_FATAL_ASSERT(
+        AWS_OP_SUCCESS == aws_array_list_init_dynamic(
+                              &pool->free_buffers, allocator, pool->max_buffers, sizeof(struct s3_part_buffer *)));
+
+    if (cpu_group >= 0) {
+        s_s3_part_buffer_pool_allocate_on_cpu_group(pool, (uint16_t)cpu_group);
+    }
+
+    return (jlong)pool;
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3PartBufferPoolRelease(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_pool) {
+    (void)env;
+    (void)jni_class;
+
+    struct s3_part_buffer_pool *pool = (struct s3_part_buffer_pool *)jni_pool;
+    if (pool != NULL) {
+        aws_ref_count_release(&pool->ref_count);
+    }
+}
+
+JNIEXPORT jlong JNICALL Java_software_amazon_awssdk_crt_s3_S3Client_s3PartBufferAcquire(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_pool) {
+    (void)jni_class;
+
+    struct s3_part_buffer_pool *pool = (struct s3_part_buffer_pool *)jni_pool;
+    if (pool == NULL) {
+        aws_jni_throw_illegal_argument_exception(env, "S3Client.s3PartBufferAcquire: Invalid/null part buffer pool");
+        return (jlong)NULL;
+    }
+
+    /* NULL means the pool is at its limit, Java reports that to the caller */
+    return (jlong)s_s3_part_buffer_acquire(pool);
+}
+
+JNIEXPORT jobject JNICALL Java_software_amazon_awssdk_crt_s3_S3PartBuffer_s3PartBufferGetByteBuffer(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_part_buffer) {
+    (void)jni_class;
+
+    struct s3_part_buffer *part_buffer = (struct s3_part_buffer *)jni_part_buffer;
+    if (part_buffer == NULL) {
+        aws_jni_throw_illegal_argument_exception(env, "S3PartBuffer.getByteBuffer: Invalid/null part buffer");
+        return NULL;
+    }
+
+    return aws_jni_direct_byte_buffer_from_raw_ptr(env, part_buffer->buf.buffer, part_buffer->buf.capacity);
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_s3_S3PartBuffer_s3PartBufferRelease(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_part_buffer) {
+    (void)env;
+    (void)jni_class;
+
+    struct s3_part_buffer *part_buffer = (struct s3_part_buffer *)jni_part_buffer;
+    if (part_buffer != NULL) {
+        s_s3_part_buffer_release(part_buffer);
+    }
+}
+
+JNIEXPORT jlong JNICALL
+    Java_software_amazon_awssdk_crt_s3_S3PartBufferQueue_s3PartBufferQueueNew(JNIEnv *env, jclass jni_class) {
+    (void)env;
+    (void)jni_class;
+
+    struct aws_allocator *allocator = aws_jni_s3_allocator();
+    struct s3_part_buffer_stream *impl = aws_mem_calloc(allocator, 1, sizeof(struct s3_part_buffer_stream));
+    AWS_FATAL_ASSERT(impl);
+
+    impl->allocator = allocator;
+    impl->base.vtable = &s_s3_part_buffer_stream_vtable;
+    aws_ref_count_init(&impl->base.ref_count, impl, s_s3_part_buffer_stream_destroy);
+    AWS_FATAL_ASSERT(AWS_OP_SUCCESS == aws_mutex_init(&impl->lock));
+    AWS_FATAL_ASSERT(AWS_OP_SUCCESS == aws_condition_variable_init(&impl->signal));
+    AWS_FATAL_ASSERT(
+        AWS_OP_SUCCESS == aws_array_list_init_dynamic(&impl->parts, allocator, 16, sizeof(struct s3_part_buffer *)));
+
+    return (jlong)&impl->base;
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_s3_S3PartBufferQueue_s3PartBufferQueueRelease(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_stream) {
+    (void)env;
+    (void)jni_class;
+
+    struct aws_input_stream *stream = (struct aws_input_stream *)jni_stream;
+    if (stream == NULL) {
+        return;
+    }
+
+    /* An upload still holding the stream fails its read instead of waiting forever or ending with a truncated body */
+    struct s3_part_buffer_stream *impl = AWS_CONTAINER_OF(stream, struct s3_part_buffer_stream, base);
+    aws_mutex_lock(&impl->lock);
+    if (!impl->is_complete) {
+        impl->is_abandoned = true;
+    }
+    aws_mutex_unlock(&impl->lock);
+    aws_condition_variable_notify_all(&impl->signal);
+
+    aws_input_stream_release(stream);
+}
+
+JNIEXPORT jboolean JNICALL Java_software_amazon_awssdk_crt_s3_S3PartBufferQueue_s3PartBufferQueueSubmit(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_stream,
+    jint part_number,
+    jlong jni_part_buffer,
+    jint length) {
+    (void)jni_class;
+
+    struct aws_input_stream *stream = (struct aws_input_stream *)jni_stream;
+    struct s3_part_buffer *part_buffer = (struct s3_part_buffer *)jni_part_buffer;
+    if (stream == NULL || part_buffer == NULL) {
+        aws_jni_throw_illegal_argument_exception(env, "S3PartBufferQueue.submitPart: Invalid/null queue or buffer");
+        return false;
+    }
+
+    if (length < 0 || (size_t)length > part_buffer->buf.capacity) {
+        aws_jni_throw_illegal_argument_exception(env, "S3PartBufferQueue.submitPart: Invalid part length");
+        return false;
+    }
+
+    struct s3_part_buffer_stream *impl = AWS_CONTAINER_OF(stream, struct s3_part_buffer_stream, base);
+    const size_t part_index = (size_t)part_number - 1;
+    const char *error_message = NULL;
+    size_t blocked_part_number = 0;
+    struct s3_part_buffer *empty = NULL;
+    struct s3_part_buffer *existing = NULL;
+
+    aws_mutex_lock(&impl->lock);
+    if (impl->is_complete) {
+        error_message = "S3PartBufferQueue.submitPart: Queue has already been completed";
+        goto unlock;
+    }
+
+    if (part_number < 1 || part_index < impl->next_part_index) {
+        error_message = "S3PartBufferQueue.submitPart: Invalid part number";
+        goto unlock;
+    }
+
+    while (aws_array_list_length(&impl->parts) <= part_index) {
+        AWS_FATAL_ASSERT(AWS_OP_SUCCESS == aws_array_list_push_back(&impl->parts, &empty));
+    }
+
+    aws_array_list_get_at(&impl->parts, &existing, part_index);
+    if (existing != NULL) {
+        error_message = "S3PartBufferQueue.submitPart: Part has already been submitted";
+        goto unlock;
+    }
+
+    /*
+     * Parts queued past the first missing one can't be read until it arrives. They may hold every buffer of the pool
+     * but one, or Java could never lease a buffer for the missing part and the upload would wait on it forever.
+     */
+    const size_t num_parts = aws_array_list_length(&impl->parts);
+    size_t first_missing_index = impl->next_part_index;
+    while (first_missing_index < num_parts) {
+        struct s3_part_buffer *queued = NULL;
+        aws_array_list_get_at(&impl->parts, &queued, first_missing_index);
+        if (queued == NULL) {
+            break;
+        }
+        ++first_missing_index;
+    }
+    if (part_index > first_missing_index) {
+        size_t queued_ahead = 0;
+        for (size_t i = first_missing_index + 1; i < num_parts; ++i) {
+            struct s3_part_buffer *queued = NULL;
+            aws_array_list_get_at(&impl->parts, &queued, i);
+            queued_ahead += queued != NULL ? 1 : 0;
+        }
+        if (queued_ahead + 2 > part_buffer->pool->max_buffers) {
+            blocked_part_number = first_missing_index + 1;
+            goto unlock;
+        }
+    }
+
+    part_buffer->buf.len = (size_t)length;
+    aws_array_list_set_at(&impl->parts, &part_buffer, part_index);
+
+unlock:
+    aws_mutex_unlock(&impl->lock);
+
+    if (error_message != NULL) {
+        aws_jni_throw_illegal_argument_exception(env, error_message);
+        return false;
+    }
+
+    if (blocked_part_number != 0) {
+        aws_jni_throw_illegal_argument_exception(
+            env,
+            "S3PartBufferQueue.submitPart: Part %zu must be submitted first, the parts queued after it would leave "
+            "the pool no buffer for it",
+            blocked_part_number);
+        return false;
+    }
+
+    aws_condition_variable_notify_all(&impl->signal);
+    return true;
+}
+
+JNIEXPORT void JNICALL Java_software_amazon_awssdk_crt_s3_S3PartBufferQueue_s3PartBufferQueueComplete(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_stream) {
+    (void)jni_class;
+
+    struct aws_input_stream *stream = (struct aws_input_stream *)jni_stream;
+    if (stream == NULL) {
+        aws_jni_throw_illegal_argument_exception(env, "S3PartBufferQueue.complete: Invalid/null queue");
+        return;
+    }
+
+    struct s3_part_buffer_stream *impl = AWS_CONTAINER_OF(stream, struct s3_part_buffer_stream, base);
+    size_t missing_part_number = 0;
+
+    aws_mutex_lock(&impl->lock);
+    const size_t num_parts = aws_array_list_length(&impl->parts);
+    for (size_t i = impl->next_part_index; i < num_parts; ++i) {
+        struct s3_part_buffer *part_buffer = NULL;
+        aws_array_list_get_at(&impl->parts, &part_buffer, i);
+        if (part_buffer == NULL) {
+            missing_part_number = i + 1;
+            break;
+        }
+    }
+    if (missing_part_number == 0) {
+        impl->is_complete = true;
+    }
+    aws_mutex_unlock(&impl->lock);
+    aws_condition_variable_notify_all(&impl->signal);
+
+    if (missing_part_number != 0) {
+        aws_jni_throw_illegal_argument_exception(
+            env, "S3PartBufferQueue.complete: Part %zu has not been submitted", missing_part_number);
+    }
+}
+
+#if UINTPTR_MAX == 0xffffffff
+#    if defined(_MSC_VER)
+#        pragma warning(pop)
+#    else
+#        pragma GCC diagnostic pop
+#    endif
+#endif
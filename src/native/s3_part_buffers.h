@@ -0,0 +1,22 @@
+#ifndef AWS_JNI_S3_PART_BUFFERS_H
+#define AWS_JNI_S3_PART_BUFFERS_H
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <stddef.h>
+
+struct s3_part_buffer_pool;
+
+/*******************************************************************************
+ * Reports the native memory held by a part buffer pool: everything it has allocated, and the part of that
+ * which is currently leased to Java or queued for upload rather than sitting on the free list.
+ ******************************************************************************/
+void aws_jni_s3_part_buffer_pool_get_stats(
+    struct s3_part_buffer_pool *pool,
+    size_t *out_allocated_bytes,
+    size_t *out_in_use_bytes);
+
+#endif /* AWS_JNI_S3_PART_BUFFERS_H */
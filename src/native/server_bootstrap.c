@@ -42,7 +42,7 @@ jlong JNICALL Java_software_amazon_awssdk_crt_io_ServerBootstrap_serverBootstrap
         return (jlong)NULL;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
 
     struct aws_server_bootstrap *bootstrap = aws_server_bootstrap_new(allocator, elg);
     if (!bootstrap) {
@@ -32,7 +32,7 @@ jlong JNICALL Java_software_amazon_awssdk_crt_io_SocketOptions_socketOptionsNew(
     jint keep_alive_timeout_secs) {
     (void)env;
     (void)jni_class;
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
     struct aws_socket_options *options =
         (struct aws_socket_options *)aws_mem_calloc(allocator, 1, sizeof(struct aws_socket_options));
     AWS_FATAL_ASSERT(options);
@@ -58,7 +58,7 @@ void JNICALL Java_software_amazon_awssdk_crt_io_SocketOptions_socketOptionsDestr
         return;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
     aws_mem_release(allocator, options);
 }
 
@@ -90,3 +90,140 @@ clean_up:
     aws_byte_buf_clean_up_secure(&formatted_data);
     return return_data;
 }
+
+/* Returns the address of a slice of a direct ByteBuffer, or NULL with an exception pending */
+static uint8_t *s_direct_buffer_slice(JNIEnv *env, jobject buffer, jint position, jint length) {
+    if (buffer == NULL) {
+        aws_jni_throw_null_pointer_exception(env, "StringUtils: ByteBuffer is null");
+        return NULL;
+    }
+
+    uint8_t *address = (*env)->GetDirectBufferAddress(env, buffer);
+    jlong capacity = (*env)->GetDirectBufferCapacity(env, buffer);
+    if (address == NULL || capacity < 0) {
+        aws_jni_throw_illegal_argument_exception(env, "StringUtils: ByteBuffer is not direct");
+        return NULL;
+    }
+
+    if (position < 0 || length < 0 || (jlong)position + (jlong)length > capacity) {
+        aws_jni_throw_illegal_argument_exception(env, "StringUtils: ByteBuffer range is out of bounds");
+        return NULL;
+    }
+
+    return address + position;
+}
+
+/*
+ * Encodes a slice of one direct ByteBuffer into a slice of another, in place. aws_base64_encode() picks the AVX2
+ * kernel where the CPU has it. Returns the number of bytes written, or -1 with an exception pending.
+ */
+JNIEXPORT
+jint JNICALL Java_software_amazon_awssdk_crt_utils_StringUtils_stringUtilsBase64EncodeDirect(
+    JNIEnv *env,
+    jclass jni_class,
+    jobject jni_data,
+    jint data_position,
+    jint data_length,
+    jobject jni_output,
+    jint output_position,
+    jint output_length) {
+    (void)jni_class;
+
+    uint8_t *data = s_direct_buffer_slice(env, jni_data, data_position, data_length);
+    uint8_t *output = s_direct_buffer_slice(env, jni_output, output_position, output_length);
+    if (data == NULL || output == NULL) {
+        return -1;
+    }
+
+    size_t data_len = (size_t)data_length;
+    size_t encoded_len = (data_len + 2) / 3 * 4;
+    if (encoded_len > (size_t)output_length) {
+        aws_jni_throw_illegal_argument_exception(env, "StringUtils: output buffer is too small for base64 encode");
+        return -1;
+    }
+    if (data_len == 0) {
+        return 0;
+    }
+
+    /* Depending on the aws-c-common version, this may count a NUL terminator the caller needn't leave room for */
+    size_t required_capacity = 0;
+    if (aws_base64_compute_encoded_len(data_len, &required_capacity) != AWS_OP_SUCCESS) {
+        aws_jni_throw_runtime_exception(env, "StringUtils: Could not determine length for base64 encode");
+        return -1;
+    }
+
+    struct aws_byte_cursor data_cursor = aws_byte_cursor_from_array(data, data_len);
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output, (size_t)output_length);
+
+    if (required_capacity <= (size_t)output_length) {
+        if (aws_base64_encode(&data_cursor, &output_buf) != AWS_OP_SUCCESS) {
+            aws_jni_throw_runtime_exception(env, "StringUtils: Could not perform base64 encode");
+            return -1;
+        }
+        return (jint)encoded_len;
+    }
+
+    /*
+     * No room for the terminator: encode all but the last group in place, leaving the terminator where the last group
+     * goes, then encode the last group on the stack and copy it over.
+     */
+    size_t tail_len = data_len - (data_len - 1) / 3 * 3;
+    struct aws_byte_cursor head_cursor = aws_byte_cursor_advance(&data_cursor, data_len - tail_len);
+    uint8_t tail[8];
+    struct aws_byte_buf tail_buf = aws_byte_buf_from_empty_array(tail, sizeof(tail));
+
+    if ((head_cursor.len > 0 && aws_base64_encode(&head_cursor, &output_buf) != AWS_OP_SUCCESS) ||
+        aws_base64_encode(&data_cursor, &tail_buf) != AWS_OP_SUCCESS) {
+        aws_jni_throw_runtime_exception(env, "StringUtils: Could not perform base64 encode");
+        return -1;
+    }
+    memcpy(output + encoded_len - 4, tail, 4);
+
+    return (jint)encoded_len;
+}
+
+/*
+ * Decodes a slice of one direct ByteBuffer into a slice of another, in place. aws_base64_decode() picks the AVX2
+ * kernel where the CPU has it. Returns the number of bytes written, or -1 with an exception pending.
+ */
+JNIEXPORT
+jint JNICALL Java_software_amazon_awssdk_crt_utils_StringUtils_stringUtilsBase64DecodeDirect(
+    JNIEnv *env,
+    jclass jni_class,
+    jobject jni_data,
+    jint data_position,
+    jint data_length,
+    jobject jni_output,
+    jint output_position,
+    jint output_length) {
+    (void)jni_class;
+
+    uint8_t *data = s_direct_buffer_slice(env, jni_data, data_position, data_length);
+    uint8_t *output = s_direct_buffer_slice(env, jni_output, output_position, output_length);
+    if (data == NULL || output == NULL) {
+        return -1;
+    }
+    if (data_length == 0) {
+        return 0;
+    }
+
+    struct aws_byte_cursor data_cursor = aws_byte_cursor_from_array(data, (size_t)data_length);
+
+    size_t decoded_len = 0;
+    if (aws_base64_compute_decoded_len(&data_cursor, &decoded_len) != AWS_OP_SUCCESS) {
+        aws_jni_throw_runtime_exception(env, "StringUtils: Could not determine length for base64 decode");
+        return -1;
+    }
+    if (decoded_len > (size_t)output_length) {
+        aws_jni_throw_illegal_argument_exception(env, "StringUtils: output buffer is too small for base64 decode");
+        return -1;
+    }
+
+    struct aws_byte_buf output_buf = aws_byte_buf_from_empty_array(output, (size_t)output_length);
+    if (aws_base64_decode(&data_cursor, &output_buf) != AWS_OP_SUCCESS) {
+        aws_jni_throw_runtime_exception(env, "StringUtils: Could not perform base64 decode");
+        return -1;
+    }
+
+    return (jint)output_buf.len;
+}
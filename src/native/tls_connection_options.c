@@ -8,6 +8,7 @@
 #include <aws/io/tls_channel_handler.h>
 
 #include "crt.h"
+#include "tls_handshake_metrics.h"
 
 /* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
 #if UINTPTR_MAX == 0xffffffff
@@ -36,11 +37,11 @@ jlong JNICALL Java_software_amazon_awssdk_crt_io_TlsConnectionOptions_tlsConnect
         return (jlong)0;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
     struct aws_tls_connection_options *options =
         (struct aws_tls_connection_options *)aws_mem_calloc(allocator, 1, sizeof(struct aws_tls_connection_options));
 
-    aws_tls_connection_options_init_from_ctx(options, ctx);
+    aws_jni_tls_connection_options_init_from_ctx(options, ctx);
     if (jni_alpn) {
         const char *alpn_chars = (*env)->GetStringUTFChars(env, jni_alpn, NULL);
         if (!alpn_chars) {
@@ -86,7 +87,7 @@ void JNICALL Java_software_amazon_awssdk_crt_io_TlsConnectionOptions_tlsConnecti
 
     aws_tls_connection_options_clean_up(options);
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
     aws_mem_release(allocator, options);
 }
 
@@ -69,7 +69,7 @@ static void s_jni_tls_ctx_options_destroy(struct jni_tls_ctx_options *tls) {
     aws_custom_key_op_handler_java_release(tls->custom_key_op_handler);
     aws_tls_ctx_options_clean_up(&tls->options);
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
     aws_mem_release(allocator, tls);
 }
 
@@ -95,7 +95,7 @@ jlong JNICALL Java_software_amazon_awssdk_crt_io_TlsContextOptions_tlsContextOpt
     jstring jni_windows_cert_store_path) {
     (void)jni_class;
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
     struct jni_tls_ctx_options *tls = aws_mem_calloc(allocator, 1, sizeof(struct jni_tls_ctx_options));
     AWS_FATAL_ASSERT(tls);
     aws_tls_ctx_options_init_default_client(&tls->options, allocator);
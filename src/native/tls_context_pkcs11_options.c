@@ -53,7 +53,7 @@ void aws_tls_ctx_pkcs11_options_from_java_destroy(struct aws_tls_ctx_pkcs11_opti
     aws_string_destroy(binding->cert_file_path);
     aws_string_destroy(binding->cert_file_contents);
 
-    aws_mem_release(aws_jni_get_allocator(), binding);
+    aws_mem_release(aws_jni_io_allocator(), binding);
 }
 
 /* Helper for processing optional strings.
@@ -84,7 +84,7 @@ static bool s_read_optional_string(
 
 struct aws_tls_ctx_pkcs11_options *aws_tls_ctx_pkcs11_options_from_java_new(JNIEnv *env, jobject options_jni) {
     struct aws_tls_ctx_pkcs11_options_binding *binding =
-        aws_mem_calloc(aws_jni_get_allocator(), 1, sizeof(struct aws_tls_ctx_pkcs11_options_binding));
+        aws_mem_calloc(aws_jni_io_allocator(), 1, sizeof(struct aws_tls_ctx_pkcs11_options_binding));
 
     /* pkcs11_lib is required */
     jobject pkcs11_lib_jni = (*env)->GetObjectField(env, options_jni, tls_context_pkcs11_options_properties.pkcs11Lib);
@@ -9,6 +9,7 @@
 #include <aws/io/tls_channel_handler.h>
 
 #include "crt.h"
+#include "tls_handshake_metrics.h"
 
 /* on 32-bit platforms, casting pointers to longs throws a warning we don't need */
 #if UINTPTR_MAX == 0xffffffff
@@ -32,12 +33,13 @@ jlong JNICALL
         return (jlong)NULL;
     }
 
-    struct aws_allocator *allocator = aws_jni_get_allocator();
+    struct aws_allocator *allocator = aws_jni_io_allocator();
     struct aws_tls_ctx *tls_ctx = aws_tls_client_ctx_new(allocator, options);
     if (!tls_ctx) {
         aws_jni_throw_runtime_exception(env, "TlsContext.tls_ctx_new: Failed to create new aws_tls_ctx");
         return (jlong)NULL;
     }
+    aws_jni_tls_handshake_metrics_register(tls_ctx);
     return (jlong)tls_ctx;
 }
 
@@ -51,9 +53,25 @@ void JNICALL
         return;
     }
 
+    aws_jni_tls_handshake_metrics_unregister(tls_ctx);
     aws_tls_ctx_release(tls_ctx);
 }
 
+JNIEXPORT
+jlongArray JNICALL Java_software_amazon_awssdk_crt_io_TlsContext_tlsContextHandshakeMetrics(
+    JNIEnv *env,
+    jclass jni_class,
+    jlong jni_ctx) {
+    (void)jni_class;
+    struct aws_tls_ctx *tls_ctx = (struct aws_tls_ctx *)jni_ctx;
+    if (!tls_ctx) {
+        aws_jni_throw_null_pointer_exception(env, "TlsContext.handshakeMetrics: TlsContext is closed");
+        return NULL;
+    }
+
+    return aws_jni_tls_handshake_metrics_snapshot(env, tls_ctx);
+}
+
 #if UINTPTR_MAX == 0xffffffff
 #    if defined(_MSC_VER)
 #        pragma warning(pop)
@@ -0,0 +1,176 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "tls_handshake_metrics.h"
+
+#include <aws/common/array_list.h>
+#include <aws/common/clock.h>
+#include <aws/common/linked_list.h>
+#include <aws/common/mutex.h>
+#include <aws/common/thread.h>
+#include <aws/io/channel.h>
+#include <aws/io/statistics.h>
+
+#include "crt.h"
+#include "latency_histogram.h"
+
+struct tls_handshake_metrics {
+    struct aws_linked_list_node node;
+    struct aws_tls_ctx *ctx;
+    /* guarded by s_lock, like the list itself */
+    uint64_t handshakes_succeeded;
+    uint64_t handshakes_failed;
+    struct aws_jni_latency_histogram handshake_latency;
+};
+
+/* Must match TlsHandshakeMetrics.java */
+enum tls_handshake_metric {
+    TLS_HANDSHAKE_METRIC_TIMESTAMP_NS,
+    TLS_HANDSHAKE_METRIC_HANDSHAKES_SUCCEEDED,
+    TLS_HANDSHAKE_METRIC_HANDSHAKES_FAILED,
+    TLS_HANDSHAKE_METRIC_LATENCY_HISTOGRAM,
+    TLS_HANDSHAKE_METRIC_COUNT = TLS_HANDSHAKE_METRIC_LATENCY_HISTOGRAM + AWS_JNI_LATENCY_HISTOGRAM_BUCKETS,
+};
+
+/* Live contexts are few, a list is plenty; it is only searched once per handshake */
+static struct aws_mutex s_lock = AWS_MUTEX_INIT;
+static struct aws_linked_list s_metrics_list;
+static aws_thread_once s_metrics_list_once = AWS_THREAD_ONCE_STATIC_INIT;
+
+static void s_init_metrics_list(void *user_data) {
+    (void)user_data;
+    aws_linked_list_init(&s_metrics_list);
+}
+
+/* Call with s_lock held */
+static struct tls_handshake_metrics *s_find_metrics(const struct aws_tls_ctx *ctx) {
+    for (struct aws_linked_list_node *node = aws_linked_list_begin(&s_metrics_list);
+         node != aws_linked_list_end(&s_metrics_list);
+         node = aws_linked_list_next(node)) {
+        struct tls_handshake_metrics *metrics = AWS_CONTAINER_OF(node, struct tls_handshake_metrics, node);
+        if (metrics->ctx == ctx) {
+            return metrics;
+        }
+    }
+    return NULL;
+}
+
+void aws_jni_tls_handshake_metrics_register(struct aws_tls_ctx *ctx) {
+    aws_thread_call_once(&s_metrics_list_once, s_init_metrics_list, NULL);
+
+    struct tls_handshake_metrics *metrics =
+        aws_mem_calloc(aws_jni_io_allocator(), 1, sizeof(struct tls_handshake_metrics));
+    metrics->ctx = ctx;
+    aws_jni_latency_histogram_init(&metrics->handshake_latency);
+
+    aws_mutex_lock(&s_lock);
+    aws_linked_list_push_back(&s_metrics_list, &metrics->node);
+    aws_mutex_unlock(&s_lock);
+}
+
+void aws_jni_tls_handshake_metrics_unregister(struct aws_tls_ctx *ctx) {
+    aws_thread_call_once(&s_metrics_list_once, s_init_metrics_list, NULL);
+
+    aws_mutex_lock(&s_lock);
+    struct tls_handshake_metrics *metrics = s_find_metrics(ctx);
+    if (metrics != NULL) {
+        aws_linked_list_remove(&metrics->node);
+    }
+    aws_mutex_unlock(&s_lock);
+
+    if (metrics != NULL) {
+        aws_mem_release(aws_jni_io_allocator(), metrics);
+    }
+}
+
+/* The tls handlers of aws-c-io time their handshake in their channel statistics */
+static uint64_t s_handshake_latency_ns(struct aws_channel_handler *handler, struct aws_channel_slot *slot) {
+    if (handler == NULL || handler->vtable->gather_statistics == NULL) {
+        return 0;
+    }
+
+    struct aws_crt_statistics_base *stats_storage[1];
+    struct aws_array_list stats_list;
+    aws_array_list_init_static(&stats_list, stats_storage, 1, sizeof(struct aws_crt_statistics_base *));
+    handler->vtable->gather_statistics(handler, &stats_list);
+
+    struct aws_crt_statistics_base *stats = NULL;
+    if (aws_array_list_get_at(&stats_list, &stats, 0) || stats == NULL ||
+        stats->category != AWSCRT_STAT_CAT_TLS) {
+        return 0;
+    }
+
+    struct aws_crt_statistics_tls *tls_stats = (struct aws_crt_statistics_tls *)stats;
+    uint64_t end_ns = tls_stats->handshake_end_ns;
+    if (end_ns == 0 && slot != NULL) {
+        /* The handshake only just ended; the handler may record that after telling us */
+        aws_channel_current_clock_time(slot->channel, &end_ns);
+    }
+
+    return end_ns > tls_stats->handshake_start_ns && tls_stats->handshake_start_ns != 0
+               ? end_ns - tls_stats->handshake_start_ns
+               : 0;
+}
+
+static void s_on_negotiation_result(
+    struct aws_channel_handler *handler,
+    struct aws_channel_slot *slot,
+    int error_code,
+    void *user_data) {
+
+    const struct aws_tls_ctx *ctx = user_data;
+    uint64_t latency_ns = s_handshake_latency_ns(handler, slot);
+
+    aws_mutex_lock(&s_lock);
+    struct tls_handshake_metrics *metrics = s_find_metrics(ctx);
+    if (metrics != NULL) {
+        if (error_code == AWS_ERROR_SUCCESS) {
+            ++metrics->handshakes_succeeded;
+        } else {
+            ++metrics->handshakes_failed;
+        }
+        if (latency_ns > 0) {
+            aws_jni_latency_histogram_record_ns(&metrics->handshake_latency, latency_ns);
+        }
+    }
+    aws_mutex_unlock(&s_lock);
+}
+
+void aws_jni_tls_connection_options_init_from_ctx(
+    struct aws_tls_connection_options *conn_options,
+    struct aws_tls_ctx *ctx) {
+
+    aws_tls_connection_options_init_from_ctx(conn_options, ctx);
+    aws_tls_connection_options_set_callbacks(conn_options, s_on_negotiation_result, NULL, NULL, ctx);
+}
+
+jlongArray aws_jni_tls_handshake_metrics_snapshot(JNIEnv *env, struct aws_tls_ctx *ctx) {
+    aws_thread_call_once(&s_metrics_list_once, s_init_metrics_list, NULL);
+
+    int64_t values[TLS_HANDSHAKE_METRIC_COUNT];
+    AWS_ZERO_ARRAY(values);
+
+    uint64_t now_ns = 0;
+    aws_high_res_clock_get_ticks(&now_ns);
+    values[TLS_HANDSHAKE_METRIC_TIMESTAMP_NS] = (int64_t)now_ns;
+
+    aws_mutex_lock(&s_lock);
+    struct tls_handshake_metrics *metrics = s_find_metrics(ctx);
+    if (metrics != NULL) {
+        values[TLS_HANDSHAKE_METRIC_HANDSHAKES_SUCCEEDED] = (int64_t)metrics->handshakes_succeeded;
+        values[TLS_HANDSHAKE_METRIC_HANDSHAKES_FAILED] = (int64_t)metrics->handshakes_failed;
+        aws_jni_latency_histogram_snapshot(
+            &metrics->handshake_latency, &values[TLS_HANDSHAKE_METRIC_LATENCY_HISTOGRAM]);
+    }
+    aws_mutex_unlock(&s_lock);
+
+    jlongArray jni_values = (*env)->NewLongArray(env, TLS_HANDSHAKE_METRIC_COUNT);
+    if (jni_values == NULL) {
+        /* OutOfMemoryError is pending */
+        return NULL;
+    }
+    (*env)->SetLongArrayRegion(env, jni_values, 0, TLS_HANDSHAKE_METRIC_COUNT, (const jlong *)values);
+    return jni_values;
+}
@@ -0,0 +1,31 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#ifndef AWS_JNI_CRT_TLS_HANDSHAKE_METRICS_H
+#define AWS_JNI_CRT_TLS_HANDSHAKE_METRICS_H
+
+#include <jni.h>
+
+#include <aws/io/tls_channel_handler.h>
+
+/*
+ * Handshake counters behind TlsContext.getHandshakeMetrics(): successes, failures and a latency histogram, kept for
+ * every TlsContext from creation until it's closed.
+ *
+ * A handshake is only seen when its connection options come from aws_jni_tls_connection_options_init_from_ctx(),
+ * which every native binding uses in place of aws_tls_connection_options_init_from_ctx(). The options' negotiation
+ * callback finds the metrics by context, so a connection outliving its Java TlsContext is simply not counted.
+ */
+void aws_jni_tls_handshake_metrics_register(struct aws_tls_ctx *ctx);
+void aws_jni_tls_handshake_metrics_unregister(struct aws_tls_ctx *ctx);
+
+void aws_jni_tls_connection_options_init_from_ctx(
+    struct aws_tls_connection_options *conn_options,
+    struct aws_tls_ctx *ctx);
+
+/* Copies the metrics out in the layout TlsHandshakeMetrics reads, or returns NULL with an exception pending */
+jlongArray aws_jni_tls_handshake_metrics_snapshot(JNIEnv *env, struct aws_tls_ctx *ctx);
+
+#endif /* AWS_JNI_CRT_TLS_HANDSHAKE_METRICS_H */
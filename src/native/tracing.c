@@ -0,0 +1,13 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include "tracing.h"
+
+#if defined(AWS_JNI_USE_USDT)
+
+/* tracers find the semaphore through the probe's note and bump it while attached */
+__extension__ unsigned short aws_crt_java_span_semaphore __attribute__((unused)) __attribute__((section(".probes")));
+
+#endif /* AWS_JNI_USE_USDT */
@@ -0,0 +1,72 @@
+#ifndef AWS_JNI_CRT_TRACING_H
+#define AWS_JNI_CRT_TRACING_H
+
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+#include <aws/common/common.h>
+
+/*
+ * Tracepoints on the native paths that call into Java, so that perf, bpftrace or SystemTap can attribute where
+ * callback time goes without a special build.
+ *
+ * Where USDT is available (Linux, with sys/sdt.h at build time), AWS_JNI_TRACE_SPAN() times the rest of the
+ * enclosing scope and fires the aws_crt_java:span probe when the scope exits, with
+ *   arg0: the span's name, e.g. "s3.body"
+ *   arg1: the native object the callback is for
+ *   arg2: start time, high resolution clock nanoseconds
+ *   arg3: duration in nanoseconds
+ * e.g. bpftrace -e 'usdt:libaws-crt-jni.so:aws_crt_java:span { @[str(arg0)] = hist(arg3); }'
+ *
+ * The probe has a semaphore, which tracers set while they're attached, so until someone traces the library a span
+ * costs one load and a predictable branch. Everywhere else spans compile away.
+ */
+
+#if defined(AWS_JNI_USE_USDT)
+
+#    define _SDT_HAS_SEMAPHORES 1
+#    include <sys/sdt.h>
+
+#    include <aws/common/clock.h>
+
+/* non-zero while a tracer is attached to the span probe */
+extern unsigned short aws_crt_java_span_semaphore;
+
+struct aws_jni_trace_span {
+    const char *name;
+    const void *object;
+    uint64_t start_ns;
+};
+
+static inline struct aws_jni_trace_span aws_jni_trace_span_begin(const char *name, const void *object) {
+    struct aws_jni_trace_span span = {.name = name, .object = object, .start_ns = 0};
+    if (AWS_UNLIKELY(aws_crt_java_span_semaphore != 0)) {
+        aws_high_res_clock_get_ticks(&span.start_ns);
+    }
+    return span;
+}
+
+static inline void aws_jni_trace_span_end(struct aws_jni_trace_span *span) {
+    if (AWS_LIKELY(span->start_ns == 0)) {
+        return;
+    }
+
+    uint64_t end_ns = 0;
+    aws_high_res_clock_get_ticks(&end_ns);
+    DTRACE_PROBE4(aws_crt_java, span, span->name, span->object, span->start_ns, end_ns - span->start_ns);
+}
+
+/* at most one span per scope */
+#    define AWS_JNI_TRACE_SPAN(name, object)                                                                          \
+        struct aws_jni_trace_span aws_jni_trace_span_in_scope __attribute__((cleanup(aws_jni_trace_span_end))) =      \
+            aws_jni_trace_span_begin((name), (object))
+
+#else
+
+#    define AWS_JNI_TRACE_SPAN(name, object)
+
+#endif /* AWS_JNI_USE_USDT */
+
+#endif /* AWS_JNI_CRT_TRACING_H */
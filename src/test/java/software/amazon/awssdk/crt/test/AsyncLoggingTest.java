@@ -0,0 +1,176 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.test;
+
+import org.junit.After;
+import org.junit.Assert;
+import org.junit.Test;
+import software.amazon.awssdk.crt.Log;
+
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/* Each test replaces whatever logging was set up, and shuts its own down to flush it */
+public class AsyncLoggingTest extends CrtTestFixture {
+
+    public AsyncLoggingTest() {}
+
+    private final List<Log.LogRecord> records = Collections.synchronizedList(new ArrayList<>());
+
+    private final Log.LogSink sink = batch -> records.addAll(batch);
+
+    private List<String> messagesForSubject(Log.LogSubject subject) {
+        List<String> messages = new ArrayList<>();
+        synchronized (records) {
+            for (Log.LogRecord record : records) {
+                if (record.getSubject() == subject.getValue()) {
+                    messages.add(record.getMessage());
+                }
+            }
+        }
+        return messages;
+    }
+
+    @After
+    public void shutdownAsyncLogging() {
+        Log.shutdownLogging();
+    }
+
+    @Test
+    public void testSinkReceivesRecords() {
+        Log.shutdownLogging();
+        Log.initAsyncLoggingToSink(Log.LogLevel.Info, sink, new Log.AsyncLoggingOptions());
+
+        for (int i = 0; i < 10; ++i) {
+            Log.log(Log.LogLevel.Info, Log.LogSubject.JavaCrtS3, "sink record " + i);
+        }
+        Log.log(Log.LogLevel.Debug, Log.LogSubject.JavaCrtS3, "below the level");
+        Log.shutdownLogging();
+
+        List<String> messages = messagesForSubject(Log.LogSubject.JavaCrtS3);
+        Assert.assertEquals(10, messages.size());
+        for (int i = 0; i < 10; ++i) {
+            Assert.assertEquals("sink record " + i, messages.get(i));
+        }
+
+        Log.LogRecord first = null;
+        synchronized (records) {
+            for (Log.LogRecord record : records) {
+                if (record.getSubject() == Log.LogSubject.JavaCrtS3.getValue()) {
+                    first = record;
+                    break;
+                }
+            }
+        }
+        Assert.assertEquals(Log.LogLevel.Info, first.getLevel());
+        Assert.assertTrue(first.getTimestampNs() > 0);
+        Assert.assertFalse(first.getThread().isEmpty());
+    }
+
+    @Test
+    public void testSubjectLevelOverridesLoggerLevel() {
+        Log.shutdownLogging();
+        Log.initAsyncLoggingToSink(Log.LogLevel.Warn, sink,
+                new Log.AsyncLoggingOptions().withSubjectLevel(Log.LogSubject.JavaCrtS3, Log.LogLevel.Debug));
+
+        Log.log(Log.LogLevel.Debug, Log.LogSubject.JavaCrtS3, "s3 debug");
+        Log.log(Log.LogLevel.Debug, Log.LogSubject.JavaCrtResource, "resource debug");
+        Log.log(Log.LogLevel.Warn, Log.LogSubject.JavaCrtResource, "resource warn");
+        Log.shutdownLogging();
+
+        Assert.assertEquals(Collections.singletonList("s3 debug"), messagesForSubject(Log.LogSubject.JavaCrtS3));
+        Assert.assertEquals(Collections.singletonList("resource warn"),
+                messagesForSubject(Log.LogSubject.JavaCrtResource));
+    }
+
+    @Test
+    public void testRateLimitedRecordsAreCounted() {
+        final int logged = 50;
+        Log.shutdownLogging();
+        Log.initAsyncLoggingToSink(Log.LogLevel.Info, sink,
+                new Log.AsyncLoggingOptions().withMaxRecordsPerSubjectPerSecond(5));
+
+        for (int i = 0; i < logged; ++i) {
+            Log.log(Log.LogLevel.Info, Log.LogSubject.JavaCrtS3, "rate limited " + i);
+        }
+        Log.shutdownLogging();
+
+        int delivered = messagesForSubject(Log.LogSubject.JavaCrtS3).size();
+        /* at most two one second windows' worth */
+        Assert.assertTrue(delivered >= 5 && delivered <= 10);
+
+        Pattern dropReport = Pattern.compile("Dropped (\\d+) log records because the queue was full and (\\d+) because of rate limiting");
+        long rateLimited = 0;
+        for (String message : messagesForSubject(Log.LogSubject.JavaCrtGeneral)) {
+            Matcher matcher = dropReport.matcher(message);
+            if (matcher.matches()) {
+                Assert.assertEquals("0", matcher.group(1));
+                rateLimited += Long.parseLong(matcher.group(2));
+            }
+        }
+        Assert.assertEquals(logged - delivered, rateLimited);
+    }
+
+    @Test
+    public void testJsonEscapesControlCharacters() throws Exception {
+        Path logFile = Files.createTempFile("async_logging_json", ".log");
+        try {
+            Log.shutdownLogging();
+            Log.initAsyncLoggingToFile(Log.LogLevel.Info, logFile.toString(),
+                    new Log.AsyncLoggingOptions().withFormat(Log.LogFormat.Json));
+
+            Log.log(Log.LogLevel.Info, Log.LogSubject.JavaCrtS3, "quote\" backslash\\ newline\n tab\t bell\u0007");
+            Log.shutdownLogging();
+
+            List<String> lines = new ArrayList<>();
+            for (String line : Files.readAllLines(logFile, StandardCharsets.UTF_8)) {
+                if (line.contains("\"subject\":\"JavaCrtS3\"") || line.contains("bell")) {
+                    lines.add(line);
+                }
+            }
+            Assert.assertEquals(1, lines.size());
+            String line = lines.get(0);
+            Assert.assertTrue(line, line.contains(
+                    "\"message\":\"quote\\\" backslash\\\\ newline\\n tab\\t bell\\u0007\""));
+            Assert.assertTrue(line, line.contains("\"level\":\"INFO\""));
+            for (int i = 0; i < line.length(); ++i) {
+                Assert.assertTrue(line.charAt(i) >= 0x20);
+            }
+        } finally {
+            Files.deleteIfExists(logFile);
+        }
+    }
+
+    @Test
+    public void testFileOutputFlushedOnShutdown() throws Exception {
+        final int logged = 100;
+        Path logFile = Files.createTempFile("async_logging_text", ".log");
+        try {
+            Log.shutdownLogging();
+            Log.initAsyncLoggingToFile(Log.LogLevel.Info, logFile.toString(), new Log.AsyncLoggingOptions());
+
+            for (int i = 0; i < logged; ++i) {
+                Log.log(Log.LogLevel.Info, Log.LogSubject.JavaCrtS3, "flushed record " + i);
+            }
+            Log.shutdownLogging();
+
+            int found = 0;
+            for (String line : Files.readAllLines(logFile, StandardCharsets.UTF_8)) {
+                if (line.startsWith("[INFO]") && line.endsWith(" - flushed record " + found)) {
+                    ++found;
+                }
+            }
+            Assert.assertEquals(logged, found);
+        } finally {
+            Files.deleteIfExists(logFile);
+        }
+    }
+}
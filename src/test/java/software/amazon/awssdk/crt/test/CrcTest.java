@@ -6,6 +6,17 @@
 package software.amazon.awssdk.crt.test;
 
 import org.junit.Test;
+
+import software.amazon.awssdk.crt.checksums.CRC32;
+import software.amazon.awssdk.crt.checksums.CRC32C;
+import software.amazon.awssdk.crt.checksums.CRC64NVME;
+import software.amazon.awssdk.crt.checksums.ParallelChecksums;
+
+import java.io.File;
+import java.nio.ByteBuffer;
+import java.nio.file.Files;
+import java.util.Random;
+
 import static org.junit.Assert.*;
 
 public class CrcTest extends CrtTestFixture {
@@ -167,4 +178,169 @@ public class CrcTest extends CrtTestFixture {
         int expected = 0xfb5b991d;
         assertEquals(expected, (int) crcc.getValue());
     }
+
+    private static void fillValues(ByteBuffer buffer) {
+        for (byte i = 0; i < 32; i++) {
+            buffer.put(i);
+        }
+        buffer.flip();
+    }
+
+    @Test
+    public void testCrc32ByteBuffers() {
+        int expected = 0x91267E8A;
+
+        ByteBuffer direct = ByteBuffer.allocateDirect(32);
+        fillValues(direct);
+        software.amazon.awssdk.crt.checksums.CRC32 crcDirect = new software.amazon.awssdk.crt.checksums.CRC32();
+        crcDirect.update(direct);
+        assertEquals(expected, (int) crcDirect.getValue());
+        assertEquals(direct.limit(), direct.position());
+
+        /* slice of a larger heap array, so the array offset is non-zero */
+        ByteBuffer heap = ByteBuffer.allocate(48);
+        heap.position(16);
+        ByteBuffer slice = heap.slice();
+        fillValues(slice);
+        software.amazon.awssdk.crt.checksums.CRC32 crcHeap = new software.amazon.awssdk.crt.checksums.CRC32();
+        crcHeap.update(slice);
+        assertEquals(expected, (int) crcHeap.getValue());
+        assertEquals(slice.limit(), slice.position());
+
+        ByteBuffer readOnly = ByteBuffer.allocate(32);
+        fillValues(readOnly);
+        readOnly = readOnly.asReadOnlyBuffer();
+        software.amazon.awssdk.crt.checksums.CRC32 crcReadOnly = new software.amazon.awssdk.crt.checksums.CRC32();
+        crcReadOnly.update(readOnly);
+        assertEquals(expected, (int) crcReadOnly.getValue());
+        assertEquals(readOnly.limit(), readOnly.position());
+    }
+
+    @Test
+    public void testCrc32CByteBuffers() {
+        int expected = 0x46DD794E;
+
+        ByteBuffer direct = ByteBuffer.allocateDirect(32);
+        fillValues(direct);
+        software.amazon.awssdk.crt.checksums.CRC32C crcDirect = new software.amazon.awssdk.crt.checksums.CRC32C();
+        /* split across two updates, starting from a non-zero position */
+        direct.limit(10);
+        crcDirect.update(direct);
+        direct.limit(32);
+        crcDirect.update(direct);
+        assertEquals(expected, (int) crcDirect.getValue());
+
+        ByteBuffer heap = ByteBuffer.allocate(32);
+        fillValues(heap);
+        software.amazon.awssdk.crt.checksums.CRC32C crcHeap = new software.amazon.awssdk.crt.checksums.CRC32C();
+        crcHeap.update(heap);
+        assertEquals(expected, (int) crcHeap.getValue());
+
+        ByteBuffer readOnly = ByteBuffer.allocate(32);
+        fillValues(readOnly);
+        software.amazon.awssdk.crt.checksums.CRC32C crcReadOnly = new software.amazon.awssdk.crt.checksums.CRC32C();
+        crcReadOnly.update(readOnly.asReadOnlyBuffer());
+        assertEquals(expected, (int) crcReadOnly.getValue());
+    }
+
+    @Test
+    public void testCrcCombine() {
+        byte[] values = new byte[1000];
+        new Random(7).nextBytes(values);
+        for (int split : new int[] { 0, 1, 333, 999, 1000 }) {
+            CRC32 crc32A = new CRC32();
+            crc32A.update(values, 0, split);
+            CRC32 crc32B = new CRC32();
+            crc32B.update(values, split, values.length - split);
+            CRC32 crc32Whole = new CRC32();
+            crc32Whole.update(values);
+            assertEquals((int) crc32Whole.getValue(),
+                    CRC32.combine((int) crc32A.getValue(), (int) crc32B.getValue(), values.length - split));
+
+            CRC32C crc32cA = new CRC32C();
+            crc32cA.update(values, 0, split);
+            CRC32C crc32cB = new CRC32C();
+            crc32cB.update(values, split, values.length - split);
+            CRC32C crc32cWhole = new CRC32C();
+            crc32cWhole.update(values);
+            assertEquals((int) crc32cWhole.getValue(),
+                    CRC32C.combine((int) crc32cA.getValue(), (int) crc32cB.getValue(), values.length - split));
+        }
+    }
+
+    @Test
+    public void testCrcParallel() throws Exception {
+        /* not a multiple of the segment count, so the last segment is short */
+        byte[] values = new byte[5 * ParallelChecksums.MIN_SEGMENT_SIZE + 12345];
+        new Random(11).nextBytes(values);
+        CRC32 crc32 = new CRC32();
+        crc32.update(values);
+        CRC32C crc32c = new CRC32C();
+        crc32c.update(values);
+
+        ByteBuffer direct = ByteBuffer.allocateDirect(values.length);
+        direct.put(values);
+        direct.flip();
+        assertEquals((int) crc32.getValue(), ParallelChecksums.crc32(direct, 4));
+        assertEquals(direct.limit(), direct.position());
+        assertEquals((int) crc32c.getValue(), ParallelChecksums.crc32c(ByteBuffer.wrap(values), 4));
+
+        File file = File.createTempFile("crc_parallel", ".bin");
+        try {
+            Files.write(file.toPath(), values);
+            assertEquals((int) crc32.getValue(), ParallelChecksums.crc32(file.toPath(), 3));
+            assertEquals((int) crc32c.getValue(), ParallelChecksums.crc32c(file.toPath(), 3));
+        } finally {
+            file.delete();
+        }
+    }
+
+    @Test
+    public void testCrc64NvmeCheckValue() {
+        CRC64NVME crc = new CRC64NVME();
+        crc.update("123456789".getBytes(java.nio.charset.StandardCharsets.US_ASCII));
+        assertEquals(0xae8b14860a799888L, crc.getValue());
+    }
+
+    @Test
+    public void testCrc64NvmeZeroes() {
+        byte[] zeroes = new byte[32];
+        CRC64NVME crc = new CRC64NVME();
+        crc.update(zeroes);
+        assertEquals(0xcf3473434d4ecf3bL, crc.getValue());
+    }
+
+    @Test
+    public void testCrc64NvmeValuesIterated() {
+        byte[] values = new byte[32];
+        for (byte i = 0; i < 32; i++) {
+            values[i] = i;
+        }
+        CRC64NVME crc = new CRC64NVME();
+        for (int i = 0; i < 32; i++) {
+            crc.update(values, i, 1);
+        }
+        assertEquals(0xb9d9d4a8492cbd7fL, crc.getValue());
+
+        ByteBuffer direct = ByteBuffer.allocateDirect(32);
+        fillValues(direct);
+        CRC64NVME crcDirect = new CRC64NVME();
+        crcDirect.update(direct);
+        assertEquals(0xb9d9d4a8492cbd7fL, crcDirect.getValue());
+    }
+
+    @Test
+    public void testCrc64NvmeCombine() {
+        byte[] values = new byte[1000];
+        new Random(13).nextBytes(values);
+        CRC64NVME whole = new CRC64NVME();
+        whole.update(values);
+        for (int split : new int[] { 0, 1, 500, 1000 }) {
+            CRC64NVME crcA = new CRC64NVME();
+            crcA.update(values, 0, split);
+            CRC64NVME crcB = new CRC64NVME();
+            crcB.update(values, split, values.length - split);
+            assertEquals(whole.getValue(), CRC64NVME.combine(crcA.getValue(), crcB.getValue(), values.length - split));
+        }
+    }
 }
@@ -24,6 +24,7 @@ import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.List;
 import java.util.concurrent.*;
+import java.util.concurrent.atomic.AtomicInteger;
 
 import static org.junit.Assert.*;
 
@@ -154,6 +155,87 @@ public class CredentialsProviderTest extends CrtTestFixture {
         }
     }
 
+    @Test
+    public void testCachedRefreshAhead() throws Exception {
+        AtomicInteger fetchCount = new AtomicInteger(0);
+        DelegateCredentialsHandler credentialsHandler = new DelegateCredentialsHandler() {
+            @Override
+            public Credentials getCredentials() {
+                String accessKeyId = ACCESS_KEY_ID + fetchCount.incrementAndGet();
+                return new Credentials(accessKeyId.getBytes(), SECRET_ACCESS_KEY.getBytes(), null);
+            }
+        };
+
+        DelegateCredentialsProvider.DelegateCredentialsProviderBuilder builder = new DelegateCredentialsProvider.DelegateCredentialsProviderBuilder();
+        builder.withHandler(credentialsHandler);
+        try (DelegateCredentialsProvider provider = builder.build()) {
+            CachedCredentialsProvider.CachedCredentialsProviderBuilder cachedBuilder = new CachedCredentialsProvider.CachedCredentialsProviderBuilder();
+            /* every request after the first lands in the refresh window */
+            cachedBuilder.withCachingDurationInSeconds(900);
+            cachedBuilder.withRefreshAheadInSeconds(900);
+            cachedBuilder.withCachedProvider(provider);
+
+            try (CredentialsProvider cachedProvider = cachedBuilder.build()) {
+                assertArrayEquals((ACCESS_KEY_ID + "1").getBytes(), cachedProvider.getCredentials().get().getAccessKeyId());
+
+                /* served from the cache, while it starts a background refresh */
+                assertArrayEquals((ACCESS_KEY_ID + "1").getBytes(), cachedProvider.getCredentials().get().getAccessKeyId());
+
+                long deadline = System.currentTimeMillis() + 5000;
+                while (fetchCount.get() < 2 && System.currentTimeMillis() < deadline) {
+                    Thread.sleep(10);
+                }
+                assertEquals(2, fetchCount.get());
+                Thread.sleep(100);
+
+                assertArrayEquals((ACCESS_KEY_ID + "2").getBytes(), cachedProvider.getCredentials().get().getAccessKeyId());
+            }
+        }
+    }
+
+    @Test
+    public void testCachedRefreshAheadSharesFetch() throws Exception {
+        AtomicInteger fetchCount = new AtomicInteger(0);
+        DelegateCredentialsHandler credentialsHandler = new DelegateCredentialsHandler() {
+            @Override
+            public Credentials getCredentials() {
+                fetchCount.incrementAndGet();
+                try {
+                    Thread.sleep(200);
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                }
+                return new Credentials(ACCESS_KEY_ID.getBytes(), SECRET_ACCESS_KEY.getBytes(), null);
+            }
+        };
+
+        DelegateCredentialsProvider.DelegateCredentialsProviderBuilder builder = new DelegateCredentialsProvider.DelegateCredentialsProviderBuilder();
+        builder.withHandler(credentialsHandler);
+        try (DelegateCredentialsProvider provider = builder.build()) {
+            CachedCredentialsProvider.CachedCredentialsProviderBuilder cachedBuilder = new CachedCredentialsProvider.CachedCredentialsProviderBuilder();
+            cachedBuilder.withCachingDurationInSeconds(900);
+            cachedBuilder.withRefreshAheadInSeconds(60);
+            cachedBuilder.withCachedProvider(provider);
+
+            try (CredentialsProvider cachedProvider = cachedBuilder.build()) {
+                ExecutorService executor = Executors.newFixedThreadPool(8);
+                try {
+                    List<Future<Credentials>> results = new ArrayList<>();
+                    for (int i = 0; i < 8; ++i) {
+                        results.add(executor.submit(() -> cachedProvider.getCredentials().get()));
+                    }
+                    for (Future<Credentials> result : results) {
+                        assertArrayEquals(ACCESS_KEY_ID.getBytes(), result.get().getAccessKeyId());
+                    }
+                } finally {
+                    executor.shutdown();
+                }
+
+                assertEquals(1, fetchCount.get());
+            }
+        }
+    }
+
     @Test
     public void testDelegate() {
         DelegateCredentialsProvider.DelegateCredentialsProviderBuilder builder = new DelegateCredentialsProvider.DelegateCredentialsProviderBuilder();
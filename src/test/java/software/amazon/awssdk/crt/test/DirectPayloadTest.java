@@ -0,0 +1,241 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.test;
+
+import org.junit.Test;
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+import org.junit.Rule;
+import org.junit.rules.Timeout;
+
+import software.amazon.awssdk.crt.mqtt.MqttMessage;
+import software.amazon.awssdk.crt.mqtt.QualityOfService;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Set;
+import java.util.UUID;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.Consumer;
+
+/* Receives messages with MqttConnectionConfig.setDirectPayloadDelivery(true) */
+public class DirectPayloadTest extends MqttClientConnectionFixture {
+    @Rule
+    public Timeout testTimeout = Timeout.seconds(30);
+
+    static final String TEST_PAYLOAD = "DIRECT FROM NATIVE MEMORY";
+
+    /* unique per test so that concurrent runs against the same endpoint don't see each other's messages */
+    private final String testTopic = "test/direct/" + UUID.randomUUID().toString();
+
+    public DirectPayloadTest() {
+        setConnectionConfigTransformer(config -> config.setDirectPayloadDelivery(true));
+    }
+
+    private void subscribe(String topic, Consumer<MqttMessage> handler) throws Exception {
+        connection.subscribe(topic, QualityOfService.AT_LEAST_ONCE, handler).get();
+    }
+
+    private void publish(String topic, String payload) throws Exception {
+        connection.publish(new MqttMessage(topic, payload.getBytes(StandardCharsets.UTF_8),
+                QualityOfService.AT_LEAST_ONCE, false)).get();
+    }
+
+    @Test
+    public void testPayloadBufferContents() {
+        skipIfNetworkUnavailable();
+
+        connect();
+
+        try {
+            CompletableFuture<byte[]> fromBuffer = new CompletableFuture<>();
+            CompletableFuture<byte[]> fromPayload = new CompletableFuture<>();
+            subscribe(testTopic, (message) -> {
+                ByteBuffer buffer = message.getPayloadBuffer();
+                assertTrue(buffer.isDirect());
+                byte[] contents = new byte[buffer.remaining()];
+                buffer.duplicate().get(contents);
+                fromBuffer.complete(contents);
+                fromPayload.complete(message.getPayload());
+            });
+
+            publish(testTopic, TEST_PAYLOAD);
+
+            byte[] expected = TEST_PAYLOAD.getBytes(StandardCharsets.UTF_8);
+            assertArrayEquals(expected, fromBuffer.get());
+            assertArrayEquals(expected, fromPayload.get());
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+
+        disconnect();
+        close();
+    }
+
+    @Test
+    public void testPayloadInvalidAfterHandlerReturns() {
+        skipIfNetworkUnavailable();
+
+        connect();
+
+        try {
+            CompletableFuture<MqttMessage> received = new CompletableFuture<>();
+            subscribe(testTopic, (message) -> received.complete(message));
+
+            publish(testTopic, TEST_PAYLOAD);
+
+            MqttMessage message = received.get();
+            assertEquals(testTopic, message.getTopic());
+            try {
+                message.getPayload();
+                fail("getPayload() should throw once the handler has returned without copying");
+            } catch (IllegalStateException expected) {
+            }
+            try {
+                message.getPayloadBuffer();
+                fail("getPayloadBuffer() should throw once the handler has returned");
+            } catch (IllegalStateException expected) {
+            }
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+
+        disconnect();
+        close();
+    }
+
+    @Test
+    public void testPayloadCopiedInHandlerOutlivesIt() {
+        skipIfNetworkUnavailable();
+
+        connect();
+
+        try {
+            CompletableFuture<MqttMessage> received = new CompletableFuture<>();
+            subscribe(testTopic, (message) -> {
+                message.getPayload();
+                received.complete(message);
+            });
+
+            publish(testTopic, TEST_PAYLOAD);
+
+            MqttMessage message = received.get();
+            assertArrayEquals(TEST_PAYLOAD.getBytes(StandardCharsets.UTF_8), message.getPayload());
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+
+        disconnect();
+        close();
+    }
+
+    @Test
+    public void testThrowingHandlerLeavesConnectionAlive() {
+        skipIfNetworkUnavailable();
+
+        connect();
+
+        try {
+            AtomicInteger delivered = new AtomicInteger(0);
+            CompletableFuture<MqttMessage> second = new CompletableFuture<>();
+            subscribe(testTopic, (message) -> {
+                if (delivered.incrementAndGet() == 1) {
+                    throw new RuntimeException("handler failure under test");
+                }
+                message.getPayload();
+                second.complete(message);
+            });
+
+            publish(testTopic, "first");
+            publish(testTopic, "second");
+
+            assertArrayEquals("second".getBytes(StandardCharsets.UTF_8), second.get().getPayload());
+
+            /* the connection still does round trips after the handler threw */
+            connection.unsubscribe(testTopic).get();
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+
+        disconnect();
+        close();
+    }
+
+    @Test
+    public void testRepeatedTopicReusesString() {
+        skipIfNetworkUnavailable();
+
+        connect();
+
+        try {
+            List<String> topics = Collections.synchronizedList(new ArrayList<>());
+            CompletableFuture<Void> bothReceived = new CompletableFuture<>();
+            subscribe(testTopic, (message) -> {
+                topics.add(message.getTopic());
+                if (topics.size() == 2) {
+                    bothReceived.complete(null);
+                }
+            });
+
+            publish(testTopic, TEST_PAYLOAD);
+            publish(testTopic, TEST_PAYLOAD);
+            bothReceived.get();
+
+            assertEquals(testTopic, topics.get(0));
+            assertSame("a repeated topic is served from the topic cache", topics.get(0), topics.get(1));
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+
+        disconnect();
+        close();
+    }
+
+    @Test
+    public void testManyTopicsOnWildcardSubscription() {
+        skipIfNetworkUnavailable();
+
+        /* enough distinct topics that the cache keeps missing and is bypassed */
+        final int topicCount = 100;
+
+        connect();
+
+        try {
+            Set<String> received = Collections.synchronizedSet(new HashSet<>());
+            CompletableFuture<Void> allReceived = new CompletableFuture<>();
+            subscribe(testTopic + "/+", (message) -> {
+                String suffix = message.getTopic().substring(testTopic.length() + 1);
+                assertEquals(suffix, new String(message.getPayload(), StandardCharsets.UTF_8));
+                received.add(message.getTopic());
+                if (received.size() == topicCount) {
+                    allReceived.complete(null);
+                }
+            });
+
+            for (int i = 0; i < topicCount; ++i) {
+                publish(testTopic + "/" + i, Integer.toString(i));
+            }
+            allReceived.get();
+
+            for (int i = 0; i < topicCount; ++i) {
+                assertTrue(received.contains(testTopic + "/" + i));
+            }
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+
+        disconnect();
+        close();
+    }
+};
@@ -2,8 +2,11 @@ package software.amazon.awssdk.crt.test;
 
 import org.junit.Test;
 import software.amazon.awssdk.crt.io.DirectoryEntry;
+import software.amazon.awssdk.crt.io.DirectoryEntryBatch;
+import software.amazon.awssdk.crt.io.DirectoryEntryBatchHandler;
 import software.amazon.awssdk.crt.io.DirectoryTraversal;
 import software.amazon.awssdk.crt.io.DirectoryTraversalHandler;
+import software.amazon.awssdk.crt.io.DirectoryTraversalOptions;
 
 import java.io.File;
 import java.io.FileWriter;
@@ -252,4 +255,101 @@ public class DirectoryTraversalTest extends CrtTestFixture {
             }
         }
     }
+
+    @Test
+    public void testTraverseDirectoryParallel() throws Exception {
+
+        try (final DirectoryStructureHelper directoryStructure = new DirectoryStructureHelper()) {
+            Set<String> directoryEntries = new HashSet<>();
+            Set<String> fileEntries = new HashSet<>();
+            final long now = System.currentTimeMillis();
+
+            DirectoryTraversalOptions options = new DirectoryTraversalOptions()
+                .withThreadCount(4)
+                .withBatchSize(64)
+                .withIncludeDirectories(true);
+
+            DirectoryTraversal.traverse(directoryStructure.getRootDirectory(), options, new DirectoryEntryBatchHandler() {
+                @Override
+                public boolean onDirectoryEntries(final DirectoryEntryBatch batch) {
+                    assertTrue(batch.size() > 0 && batch.size() <= 64);
+                    for (int i = 0; i < batch.size(); i++) {
+                        assertEquals(directoryStructure.getRootDirectory() + File.separator + batch.getRelativePath(i),
+                            batch.getPath(i));
+                        if (batch.isDirectory(i)) {
+                            assertTrue(directoryEntries.add(batch.getPath(i)));
+                        } else {
+                            assertTrue(batch.isFile(i));
+                            assertTrue(fileEntries.add(batch.getPath(i)));
+                            assertEquals(FILE_CONTENT.length(), batch.getFileSize(i));
+                            assertTrue(Math.abs(now - batch.getLastModifiedTimeMillis(i)) < 10 * 60 * 1000);
+                        }
+                    }
+                    return true;
+                }
+            });
+
+            assertEquals(directoryStructure.getDirectories().size(), directoryEntries.size());
+            assertEquals(directoryStructure.getFiles(), fileEntries);
+        }
+    }
+
+    @Test
+    public void testTraverseDirectoryParallelFilters() throws Exception {
+
+        try (final DirectoryStructureHelper directoryStructure = new DirectoryStructureHelper()) {
+            Set<String> fileEntries = new HashSet<>();
+
+            DirectoryTraversalOptions options = new DirectoryTraversalOptions().withFileNameGlob("File_?5");
+
+            DirectoryTraversal.traverse(directoryStructure.getRootDirectory(), options, new DirectoryEntryBatchHandler() {
+                @Override
+                public boolean onDirectoryEntries(final DirectoryEntryBatch batch) {
+                    for (int i = 0; i < batch.size(); i++) {
+                        assertTrue(batch.isFile(i));
+                        fileEntries.add(batch.getRelativePath(i));
+                    }
+                    return true;
+                }
+            });
+
+            // File_15 to File_95 in each directory
+            assertEquals(DIRECTORY_COUNT * 9, fileEntries.size());
+
+            // every file is smaller than the minimum
+            options = new DirectoryTraversalOptions().withFileNameGlob("*").withMinFileSize(FILE_CONTENT.length() + 1);
+            DirectoryTraversal.traverse(directoryStructure.getRootDirectory(), options, new DirectoryEntryBatchHandler() {
+                @Override
+                public boolean onDirectoryEntries(final DirectoryEntryBatch batch) {
+                    fail("No file should pass the size filter");
+                    return false;
+                }
+            });
+        }
+    }
+
+    @Test
+    public void testTraverseDirectoryParallelCancellation() throws Exception {
+
+        try (final DirectoryStructureHelper directoryStructure = new DirectoryStructureHelper()) {
+            List<Integer> batchSizes = new ArrayList<>();
+
+            try {
+                DirectoryTraversalOptions options = new DirectoryTraversalOptions().withBatchSize(10);
+                DirectoryTraversal.traverse(directoryStructure.getRootDirectory(), options,
+                    new DirectoryEntryBatchHandler() {
+                        @Override
+                        public boolean onDirectoryEntries(final DirectoryEntryBatch batch) {
+                            batchSizes.add(batch.size());
+                            return false;
+                        }
+                    });
+
+                fail("Cancellation should have caused an exception");
+            } catch (final RuntimeException ex) {
+                // the handler is not invoked again once it has asked for the traversal to be cancelled
+                assertEquals(1, batchSizes.size());
+            }
+        }
+    }
 }
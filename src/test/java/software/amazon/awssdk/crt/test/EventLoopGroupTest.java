@@ -6,11 +6,16 @@
 package software.amazon.awssdk.crt.test;
 
 import org.junit.Test;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
 import static org.junit.Assert.assertNotNull;
 import static org.junit.Assert.assertTrue;
 import static org.junit.Assert.fail;
 import software.amazon.awssdk.crt.*;
 import software.amazon.awssdk.crt.io.EventLoopGroup;
+import software.amazon.awssdk.crt.io.EventLoopGroupMetrics;
+import software.amazon.awssdk.crt.io.EventLoopMetrics;
+import software.amazon.awssdk.crt.io.NumaEventLoopGroups;
 
 public class EventLoopGroupTest extends CrtTestFixture  {
     public EventLoopGroupTest() {}
@@ -34,4 +39,46 @@ public class EventLoopGroupTest extends CrtTestFixture  {
             fail(ex.getMessage());
         }
     }
+
+    @Test
+    public void testNumaEventLoopGroups() {
+        try (NumaEventLoopGroups nodes = new NumaEventLoopGroups(1)) {
+            assertEquals(Math.max(1, SystemInfo.getCpuGroupCount()), nodes.getNodeCount());
+            for (int node = 0; node < nodes.getNodeCount(); ++node) {
+                assertFalse(nodes.getEventLoopGroup(node).isNull());
+                assertFalse(nodes.getClientBootstrap(node).isNull());
+            }
+        } catch (CrtRuntimeException ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    @Test
+    public void testMetrics() throws InterruptedException {
+        try (EventLoopGroup elg = new EventLoopGroup(2)) {
+            EventLoopGroupMetrics first = elg.getMetrics();
+            assertEquals(2, first.getEventLoops().size());
+
+            Thread.sleep(500);
+
+            EventLoopGroupMetrics second = elg.getMetrics();
+            assertTrue(second.getTimestampNanos() > first.getTimestampNanos());
+            for (EventLoopMetrics loop : second.getEventLoops()) {
+                assertTrue(loop.getLatenessProbes() > 0);
+                assertEquals(loop.getLatenessProbes(), loop.getTaskLateness().getCount());
+                assertTrue(loop.getUtilization() >= 0 && loop.getUtilization() <= 1);
+            }
+        }
+    }
+
+    @Test
+    public void testNativeResourceCount() {
+        long initialCount = CrtResource.getNativeResourceCount();
+        try (EventLoopGroup elg = new EventLoopGroup(1)) {
+            assertEquals(initialCount + 1, CrtResource.getNativeResourceCount());
+        } catch (CrtRuntimeException ex) {
+            fail(ex.getMessage());
+        }
+        assertEquals(initialCount, CrtResource.getNativeResourceCount());
+    }
 };
@@ -1,12 +1,16 @@
 package software.amazon.awssdk.crt.test;
 
+import org.junit.Assume;
 import org.junit.Test;
+import software.amazon.awssdk.crt.CRT;
+import software.amazon.awssdk.crt.CallbackDispatcher;
 import software.amazon.awssdk.crt.eventstream.*;
 import software.amazon.awssdk.crt.io.ClientBootstrap;
 import software.amazon.awssdk.crt.io.EventLoopGroup;
 import software.amazon.awssdk.crt.io.ServerBootstrap;
 import software.amazon.awssdk.crt.io.SocketOptions;
 
+import java.io.File;
 import java.io.IOException;
 import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
@@ -490,6 +494,160 @@ public class EventStreamClientConnectionTest extends CrtTestFixture {
         socketOptions.close();
     }
 
+    @Test
+    public void testContinuationMessageHandlingWithCallbackDispatcher() throws ExecutionException, InterruptedException, IOException, TimeoutException {
+        SocketOptions socketOptions = new SocketOptions();
+        socketOptions.connectTimeoutMs = 3000;
+        socketOptions.domain = SocketOptions.SocketDomain.IPv4;
+        socketOptions.type = SocketOptions.SocketType.STREAM;
+
+        EventLoopGroup elGroup = new EventLoopGroup(1);
+        ServerBootstrap bootstrap = new ServerBootstrap(elGroup);
+        ClientBootstrap clientBootstrap = new ClientBootstrap(elGroup, null);
+
+        final boolean[] connectionShutdown = {false};
+        final String[] receivedOperationName = new String[]{null};
+        final String[] receivedContinuationPayload = new String[]{null};
+
+        final byte[] responsePayload = "{ \"message\": \"this is a response message\" }".getBytes(StandardCharsets.UTF_8);
+        final ServerConnection[] serverConnections = {null};
+        Lock semaphoreLock = new ReentrantLock();
+        Condition semaphore = semaphoreLock.newCondition();
+
+        ServerListener listener = new ServerListener("127.0.0.1", (short)8038, socketOptions, null, bootstrap, new ServerListenerHandler() {
+            private ServerConnectionHandler connectionHandler = null;
+
+            public ServerConnectionHandler onNewConnection(ServerConnection serverConnection, int errorCode) {
+                serverConnections[0] = serverConnection;
+                connectionHandler = new ServerConnectionHandler(serverConnection) {
+
+                    @Override
+                    protected void onProtocolMessage(List<Header> headers, byte[] payload, MessageType messageType, int messageFlags) {
+                        int responseMessageFlag = MessageFlags.ConnectionAccepted.getByteValue();
+                        MessageType acceptResponseType = MessageType.ConnectAck;
+
+                        connection.sendProtocolMessage(null, null, acceptResponseType, responseMessageFlag);
+                    }
+
+                    @Override
+                    protected ServerConnectionContinuationHandler onIncomingStream(ServerConnectionContinuation continuation, String operationName) {
+                        receivedOperationName[0] = operationName;
+
+                        return new ServerConnectionContinuationHandler(continuation) {
+                            @Override
+                            protected void onContinuationMessage(List<Header> headers, byte[] payload, MessageType messageType, int messageFlags) {
+                                receivedContinuationPayload[0] = new String(payload, StandardCharsets.UTF_8);
+
+                                continuation.sendMessage(null, responsePayload,
+                                        MessageType.ApplicationError,
+                                        MessageFlags.TerminateStream.getByteValue())
+                                        .whenComplete((res, ex) ->  {
+                                            connection.closeConnection(0);
+                                            this.close();
+                                        });
+                            }
+                        };
+                    }
+                };
+
+                semaphoreLock.lock();
+                semaphore.signal();
+                semaphoreLock.unlock();
+                return connectionHandler;
+            }
+
+            public void onConnectionShutdown(ServerConnection serverConnection, int errorCode) {
+                connectionShutdown[0] = true;
+            }
+        });
+
+        final ClientConnection[] clientConnectionArray = {null};
+        final List<Header>[] clientReceivedMessageHeaders = new List[]{null};
+        final byte[][] clientReceivedPayload = {null};
+        final MessageType[] clientReceivedMessageType = {null};
+        final int[] clientReceivedMessageFlags = {-1};
+        final boolean[] clientContinuationClosed = {false};
+        final String[] clientCallbackThreadNames = {null, null};
+        CallbackDispatcher dispatcher = new CallbackDispatcher();
+
+        CompletableFuture<Void> connectFuture = ClientConnection.connect("127.0.0.1", (short)8038, socketOptions, null, clientBootstrap, new ClientConnectionHandler() {
+            @Override
+            protected void onConnectionSetup(ClientConnection connection, int errorCode) {
+                clientConnectionArray[0] = connection;
+            }
+
+            @Override
+            protected void onProtocolMessage(List<Header> headers, byte[] payload, MessageType messageType, int messageFlags) {
+                semaphoreLock.lock();
+                semaphore.signal();
+                semaphoreLock.unlock();
+            }
+        });
+
+        final byte[] connectPayload = "test connect payload".getBytes(StandardCharsets.UTF_8);
+        connectFuture.get(1, TimeUnit.SECONDS);
+        assertNotNull(clientConnectionArray[0]);
+        semaphoreLock.lock();
+        semaphore.await(1, TimeUnit.SECONDS);
+        assertNotNull(serverConnections[0]);
+        clientConnectionArray[0].sendProtocolMessage(null, connectPayload, MessageType.Connect, 0);
+        semaphore.await(1, TimeUnit.SECONDS);
+        String operationName = "testOperation";
+
+        ClientConnectionContinuation continuation = clientConnectionArray[0].newStream(new ClientConnectionContinuationHandler() {
+            @Override
+            protected void onContinuationMessage(List<Header> headers, byte[] payload, MessageType messageType, int messageFlags) {
+                semaphoreLock.lock();
+                clientCallbackThreadNames[0] = Thread.currentThread().getName();
+                clientReceivedMessageHeaders[0] = headers;
+                clientReceivedMessageType[0] = messageType;
+                clientReceivedMessageFlags[0] = messageFlags;
+                clientReceivedPayload[0] = payload;
+                semaphoreLock.unlock();
+            }
+
+            @Override
+            protected void onContinuationClosed() {
+                semaphoreLock.lock();
+                clientCallbackThreadNames[1] = Thread.currentThread().getName();
+                clientContinuationClosed[0] = true;
+                semaphore.signal();
+                semaphoreLock.unlock();
+                super.onContinuationClosed();
+            }
+        }, dispatcher);
+        assertNotNull(continuation);
+
+        final byte[] operationPayload = "{\"message\": \"message payload\"}".getBytes(StandardCharsets.UTF_8);
+        continuation.activate(operationName, null, operationPayload, MessageType.ApplicationMessage, 0);
+        semaphore.await(1, TimeUnit.SECONDS);
+
+        assertArrayEquals(responsePayload, clientReceivedPayload[0]);
+        assertEquals(MessageType.ApplicationError, clientReceivedMessageType[0]);
+        assertEquals(MessageFlags.TerminateStream.getByteValue(), clientReceivedMessageFlags[0]);
+        assertTrue(clientContinuationClosed[0]);
+        assertEquals("AwsCrtCallbackDispatcher", clientCallbackThreadNames[0]);
+        assertEquals("AwsCrtCallbackDispatcher", clientCallbackThreadNames[1]);
+
+        clientConnectionArray[0].getClosedFuture().get(1, TimeUnit.SECONDS);
+        serverConnections[0].getClosedFuture().get(1, TimeUnit.SECONDS);
+        semaphoreLock.unlock();
+
+        assertTrue(connectionShutdown[0]);
+        assertNotNull(receivedOperationName[0]);
+        assertEquals(operationName, receivedOperationName[0]);
+        assertEquals(new String(operationPayload, StandardCharsets.UTF_8), receivedContinuationPayload[0]);
+        dispatcher.close();
+        listener.close();
+        listener.getShutdownCompleteFuture().get(1, TimeUnit.SECONDS);
+        bootstrap.close();
+        clientBootstrap.close();
+        clientBootstrap.getShutdownCompleteFuture().get(1, TimeUnit.SECONDS);
+        elGroup.close();
+        elGroup.getShutdownCompleteFuture().get(1, TimeUnit.SECONDS);
+        socketOptions.close();
+    }
+
     @Test
     public void testContinuationMessageWithExtraHeadersHandling() throws ExecutionException, InterruptedException, IOException, TimeoutException {
         SocketOptions socketOptions = new SocketOptions();
@@ -658,4 +816,96 @@ public class EventStreamClientConnectionTest extends CrtTestFixture {
         elGroup.getShutdownCompleteFuture().get(1, TimeUnit.SECONDS);
         socketOptions.close();
     }
+
+    private ServerListener newLocalListener(String socketPath, SocketOptions socketOptions, ServerBootstrap bootstrap,
+                                            byte[] responseMessage, CompletableFuture<ServerConnection> accepted) {
+        return new ServerListener(socketPath, (short)0, socketOptions, null, bootstrap, new ServerListenerHandler() {
+            public ServerConnectionHandler onNewConnection(ServerConnection serverConnection, int errorCode) {
+                accepted.complete(serverConnection);
+                return new ServerConnectionHandler(serverConnection) {
+                    @Override
+                    protected void onProtocolMessage(List<Header> headers, byte[] payload, MessageType messageType, int messageFlags) {
+                        serverConnection.sendProtocolMessage(null, responseMessage, MessageType.ConnectAck, MessageFlags.ConnectionAccepted.getByteValue());
+                    }
+
+                    @Override
+                    protected ServerConnectionContinuationHandler onIncomingStream(ServerConnectionContinuation continuation, String operationName) {
+                        return null;
+                    }
+                };
+            }
+
+            @Override
+            protected void onConnectionShutdown(ServerConnection serverConnection, int errorCode) {
+            }
+        });
+    }
+
+    @Test
+    public void testLocalSocketProtocolMessageHandling() throws ExecutionException, InterruptedException, IOException, TimeoutException {
+        /* named pipes need a \\.\pipe\ name rather than a path */
+        Assume.assumeFalse(CRT.getOSIdentifier().equals("windows"));
+
+        File socketFile = File.createTempFile("crt-event-stream", ".sock");
+        socketFile.delete();
+        String socketPath = socketFile.getAbsolutePath();
+
+        SocketOptions socketOptions = SocketOptions.createForLocalIpc();
+        EventLoopGroup elGroup = new EventLoopGroup(1);
+        ServerBootstrap bootstrap = new ServerBootstrap(elGroup);
+        ClientBootstrap clientBootstrap = new ClientBootstrap(elGroup, null);
+
+        final byte[] responseMessage = "{ \"message\": \"connect ack\" }".getBytes(StandardCharsets.UTF_8);
+        final CompletableFuture<ServerConnection> serverConnectionAccepted = new CompletableFuture<>();
+        ServerListener listener = newLocalListener(socketPath, socketOptions, bootstrap, responseMessage,
+            serverConnectionAccepted);
+
+        final ClientConnection[] clientConnectionArray = {null};
+        final byte[][] clientReceivedPayload = {null};
+        final MessageType[] clientReceivedMessageType = {null};
+        final CompletableFuture<Void> clientMessageReceived = new CompletableFuture<>();
+
+        CompletableFuture<Void> connectFuture = ClientConnection.connect(socketPath, (short)0, socketOptions, null, clientBootstrap, new ClientConnectionHandler() {
+            @Override
+            protected void onConnectionSetup(ClientConnection connection, int errorCode) {
+                clientConnectionArray[0] = connection;
+            }
+
+            @Override
+            protected void onProtocolMessage(List<Header> headers, byte[] payload, MessageType messageType, int messageFlags) {
+                clientReceivedPayload[0] = payload;
+                clientReceivedMessageType[0] = messageType;
+                clientMessageReceived.complete(null);
+            }
+        });
+
+        connectFuture.get(1, TimeUnit.SECONDS);
+        assertNotNull(clientConnectionArray[0]);
+        ServerConnection serverConnection = serverConnectionAccepted.get(1, TimeUnit.SECONDS);
+
+        clientConnectionArray[0].sendProtocolMessage(null, "test connect payload".getBytes(StandardCharsets.UTF_8), MessageType.Connect, 0);
+        clientMessageReceived.get(1, TimeUnit.SECONDS);
+        assertEquals(MessageType.ConnectAck, clientReceivedMessageType[0]);
+        assertArrayEquals(responseMessage, clientReceivedPayload[0]);
+
+        clientConnectionArray[0].closeConnection(0);
+        clientConnectionArray[0].getClosedFuture().get(1, TimeUnit.SECONDS);
+        serverConnection.getClosedFuture().get(1, TimeUnit.SECONDS);
+        listener.close();
+        listener.getShutdownCompleteFuture().get(1, TimeUnit.SECONDS);
+
+        /* a restarted server listens on the same path, whether or not the last one left its socket file behind */
+        ServerListener restartedListener = newLocalListener(socketPath, socketOptions, bootstrap, responseMessage,
+            new CompletableFuture<>());
+        restartedListener.close();
+        restartedListener.getShutdownCompleteFuture().get(1, TimeUnit.SECONDS);
+        socketFile.delete();
+
+        bootstrap.close();
+        clientBootstrap.close();
+        clientBootstrap.getShutdownCompleteFuture().get(1, TimeUnit.SECONDS);
+        elGroup.close();
+        elGroup.getShutdownCompleteFuture().get(1, TimeUnit.SECONDS);
+        socketOptions.close();
+    }
 }
@@ -0,0 +1,89 @@
+package software.amazon.awssdk.crt.test;
+
+import org.junit.Test;
+import software.amazon.awssdk.crt.eventstream.Header;
+import software.amazon.awssdk.crt.eventstream.Message;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.zip.CRC32;
+
+import static org.junit.Assert.*;
+
+public class EventStreamMessageTest extends CrtTestFixture {
+    public EventStreamMessageTest() {}
+
+    private static List<Header> createHeaders() {
+        List<Header> headers = new ArrayList<>(2);
+        headers.add(Header.createHeader(":message-type", 0));
+        headers.add(Header.createHeader("testHeader", "testValue"));
+        return headers;
+    }
+
+    private static byte[] copyMessage(Message message) {
+        ByteBuffer messageBuf = message.getMessageBuffer();
+        byte[] bytes = new byte[messageBuf.remaining()];
+        messageBuf.get(bytes);
+        return bytes;
+    }
+
+    @Test
+    public void testMessageEncoding() {
+        byte[] payload = "{\"message\": \"payload\"}".getBytes(StandardCharsets.UTF_8);
+        byte[] headers = Header.marshallHeadersForJNI(createHeaders());
+
+        try (Message message = new Message(createHeaders(), payload)) {
+            ByteBuffer encoded = ByteBuffer.wrap(copyMessage(message));
+            assertEquals(16 + headers.length + payload.length, encoded.remaining());
+            assertEquals(encoded.remaining(), encoded.getInt(0));
+            assertEquals(headers.length, encoded.getInt(4));
+
+            CRC32 preludeCrc = new CRC32();
+            preludeCrc.update(encoded.array(), 0, 8);
+            assertEquals(preludeCrc.getValue(), encoded.getInt(8) & 0xFFFFFFFFL);
+
+            CRC32 messageCrc = new CRC32();
+            messageCrc.update(encoded.array(), 0, encoded.remaining() - 4);
+            assertEquals(messageCrc.getValue(), encoded.getInt(encoded.remaining() - 4) & 0xFFFFFFFFL);
+
+            byte[] payloadRead = new byte[payload.length];
+            encoded.position(12 + headers.length);
+            encoded.get(payloadRead);
+            assertArrayEquals(payload, payloadRead);
+        }
+    }
+
+    @Test
+    public void testMessageWithoutHeadersOrPayload() {
+        try (Message message = new Message(null, (byte[]) null)) {
+            assertEquals(16, message.getMessageBuffer().remaining());
+        }
+    }
+
+    @Test
+    public void testDirectPayloadMatchesArrayPayload() {
+        byte[] payload = new byte[64 * 1024];
+        for (int i = 0; i < payload.length; ++i) {
+            payload[i] = (byte) i;
+        }
+
+        ByteBuffer directPayload = ByteBuffer.allocateDirect(payload.length + 8);
+        directPayload.position(4);
+        directPayload.put(payload);
+        directPayload.position(4);
+        directPayload.limit(4 + payload.length);
+
+        try (Message arrayMessage = new Message(createHeaders(), payload);
+             Message directMessage = new Message(createHeaders(), directPayload)) {
+            assertArrayEquals(copyMessage(arrayMessage), copyMessage(directMessage));
+        }
+        assertEquals(4, directPayload.position());
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testHeapPayloadBufferRejected() {
+        new Message(createHeaders(), ByteBuffer.allocate(16));
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.test;
+
+import org.junit.Test;
+
+import software.amazon.awssdk.crt.cal.Hash;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.security.MessageDigest;
+import java.util.Random;
+import javax.crypto.Mac;
+import javax.crypto.spec.SecretKeySpec;
+
+import static org.junit.Assert.*;
+
+public class HashTest extends CrtTestFixture {
+    public HashTest() {
+    }
+
+    private static byte[] randomBytes(int length) {
+        byte[] bytes = new byte[length];
+        new Random(42).nextBytes(bytes);
+        return bytes;
+    }
+
+    private static void assertMatchesMessageDigest(Hash hash, String algorithm, byte[] input) throws Exception {
+        try (Hash h = hash) {
+            h.update(input, 0, 100);
+            h.update(ByteBuffer.wrap(input, 100, 1000));
+            ByteBuffer direct = ByteBuffer.allocateDirect(input.length);
+            direct.put(input);
+            direct.position(1100);
+            h.update(direct);
+            assertEquals(direct.limit(), direct.position());
+
+            assertArrayEquals(MessageDigest.getInstance(algorithm).digest(input), h.digest());
+        }
+    }
+
+    @Test
+    public void testSha256() throws Exception {
+        assertMatchesMessageDigest(Hash.createSha256(), "SHA-256", randomBytes(64 * 1024 + 3));
+    }
+
+    @Test
+    public void testSha1() throws Exception {
+        assertMatchesMessageDigest(Hash.createSha1(), "SHA-1", randomBytes(64 * 1024 + 3));
+    }
+
+    @Test
+    public void testMd5() throws Exception {
+        assertMatchesMessageDigest(Hash.createMd5(), "MD5", randomBytes(64 * 1024 + 3));
+    }
+
+    @Test
+    public void testSha256Empty() throws Exception {
+        try (Hash hash = Hash.createSha256()) {
+            assertArrayEquals(MessageDigest.getInstance("SHA-256").digest(new byte[0]), hash.digest());
+        }
+    }
+
+    @Test
+    public void testSha256Hmac() throws Exception {
+        byte[] secret = "secret key".getBytes(StandardCharsets.UTF_8);
+        byte[] input = randomBytes(10000);
+
+        Mac mac = Mac.getInstance("HmacSHA256");
+        mac.init(new SecretKeySpec(secret, "HmacSHA256"));
+
+        try (Hash hmac = Hash.createSha256Hmac(secret)) {
+            hmac.update(input, 0, 5000);
+            hmac.update(ByteBuffer.wrap(input, 5000, 5000).asReadOnlyBuffer());
+            assertArrayEquals(mac.doFinal(input), hmac.digest());
+        }
+    }
+
+    @Test(expected = IllegalStateException.class)
+    public void testUpdateAfterDigest() {
+        try (Hash hash = Hash.createSha256()) {
+            hash.digest();
+            hash.update(new byte[1]);
+        }
+    }
+
+    @Test(expected = IllegalStateException.class)
+    public void testUpdateAfterClose() {
+        Hash hash = Hash.createSha1();
+        hash.close();
+        hash.update(ByteBuffer.allocateDirect(1));
+    }
+
+    @Test(expected = IllegalArgumentException.class)
+    public void testOutOfBounds() {
+        try (Hash hash = Hash.createMd5()) {
+            hash.update(new byte[4], 2, 3);
+        }
+    }
+}
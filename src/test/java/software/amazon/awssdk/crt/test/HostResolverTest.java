@@ -0,0 +1,59 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+
+package software.amazon.awssdk.crt.test;
+
+import org.junit.Test;
+import software.amazon.awssdk.crt.CrtRuntimeException;
+import software.amazon.awssdk.crt.io.EventLoopGroup;
+import software.amazon.awssdk.crt.io.HostResolver;
+import software.amazon.awssdk.crt.io.HostResolverStatistics;
+
+import java.util.Arrays;
+import java.util.List;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.Assert.*;
+
+public class HostResolverTest extends CrtTestFixture {
+    public HostResolverTest() {}
+
+    @Test
+    public void testResolveAndPrefetch() throws Exception {
+        skipIfNetworkUnavailable();
+        try (EventLoopGroup elg = new EventLoopGroup(1);
+                HostResolver resolver = new HostResolver(elg, 8, 60, 0)) {
+            resolver.prefetch(Arrays.asList("aws-crt-test-stuff.s3.amazonaws.com")).get(30, TimeUnit.SECONDS);
+            List<String> addresses = resolver.resolve("aws-crt-test-stuff.s3.amazonaws.com").get(30, TimeUnit.SECONDS);
+            assertFalse(addresses.isEmpty());
+
+            HostResolverStatistics statistics = resolver.getStatistics();
+            assertEquals(1, statistics.getCacheMisses());
+            assertEquals(1, statistics.getCacheHits());
+            assertEquals(0, statistics.getResolveFailures());
+        }
+    }
+
+    @Test
+    public void testNegativeCaching() throws Exception {
+        skipIfNetworkUnavailable();
+        try (EventLoopGroup elg = new EventLoopGroup(1);
+                HostResolver resolver = new HostResolver(elg, 8, 0, 60)) {
+            for (int i = 0; i < 2; ++i) {
+                try {
+                    resolver.resolve("host.does-not-exist.invalid").get(30, TimeUnit.SECONDS);
+                    fail("resolving an invalid host should fail");
+                } catch (ExecutionException ex) {
+                    assertTrue(ex.getCause() instanceof CrtRuntimeException);
+                }
+            }
+
+            HostResolverStatistics statistics = resolver.getStatistics();
+            assertEquals(1, statistics.getResolveFailures());
+            assertEquals(1, statistics.getNegativeCacheHits());
+        }
+    }
+}
@@ -39,6 +39,11 @@ public class Http2StreamManagerTest extends HttpClientTestFixture {
     private final String EMPTY_BODY = "";
 
     private Http2StreamManager createStreamManager(URI uri, int numConnections, int maxStreams) {
+        return createStreamManager(uri, numConnections, maxStreams, 0);
+    }
+
+    private Http2StreamManager createStreamManager(URI uri, int numConnections, int maxStreams,
+            int evictionResponseLatencyMs) {
 
         try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
                 HostResolver resolver = new HostResolver(eventLoopGroup);
@@ -46,7 +51,8 @@ public class Http2StreamManagerTest extends HttpClientTestFixture {
                 SocketOptions sockOpts = new SocketOptions();
                 TlsContextOptions tlsOpts = TlsContextOptions.createDefaultClient().withAlpnList("h2");
                 TlsContext tlsContext = createHttpClientTlsContext(tlsOpts)) {
-            Http2StreamManagerOptions options = new Http2StreamManagerOptions();
+            Http2StreamManagerOptions options = new Http2StreamManagerOptions()
+                    .withConnectionEviction(evictionResponseLatencyMs, 0);
             if (maxStreams != 0) {
                 options.withMaxConcurrentStreamsPerConnection(maxStreams)
                         .withIdealConcurrentStreamsPerConnection(maxStreams);
@@ -203,6 +209,22 @@ public class Http2StreamManagerTest extends HttpClientTestFixture {
         testParallelRequestsWithLeakCheck(NUM_THREADS, NUM_REQUESTS);
     }
 
+    @Test
+    public void testUnhealthyConnectionsAreEvicted() throws Exception {
+        skipIfNetworkUnavailable();
+        URI uri = new URI(endpoint);
+
+        // no real response comes back within 1ms, so every connection is evicted once it has enough streams.
+        // Requests must keep succeeding on the replacement connections.
+        try (Http2StreamManager streamManager = createStreamManager(uri, 1, 0, 1)) {
+            Http2Request request = createHttp2Request("GET", endpoint, path, EMPTY_BODY);
+            testParallelStreams(streamManager, request, 1, NUM_REQUESTS / 2);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
     @Test
     public void testStreamManagerMetrics() throws Exception {
         skipIfNetworkUnavailable();
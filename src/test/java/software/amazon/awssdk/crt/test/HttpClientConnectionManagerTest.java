@@ -9,6 +9,7 @@ import java.util.List;
 import java.util.concurrent.Callable;
 import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutionException;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
 import java.util.concurrent.TimeUnit;
@@ -40,8 +41,15 @@ public class HttpClientConnectionManagerTest extends HttpClientTestFixture  {
     private final static String endpoint = "https://aws-crt-test-stuff.s3.amazonaws.com";
     private final static String path = "/random_32_byte.data";
     private final String EMPTY_BODY = "";
+    // long enough for the first connection to be established, TLS handshake included
+    private final static long ACQUISITION_TIMEOUT_MS = 5000;
 
     private HttpClientConnectionManager createConnectionManager(URI uri, int numThreads, int numConnections) {
+        return createConnectionManager(uri, numThreads, numConnections, 0, 0);
+    }
+
+    private HttpClientConnectionManager createConnectionManager(URI uri, int numThreads, int numConnections,
+            int maxPendingAcquisitions, long acquisitionTimeoutMs) {
         try (EventLoopGroup eventLoopGroup = new EventLoopGroup(1);
                 HostResolver resolver = new HostResolver(eventLoopGroup);
                 ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
@@ -54,7 +62,9 @@ public class HttpClientConnectionManagerTest extends HttpClientTestFixture  {
                     .withSocketOptions(sockOpts)
                     .withTlsConnectionOptions(tlsConnectionOptions)
                     .withUri(uri)
-                    .withMaxConnections(numConnections);
+                    .withMaxConnections(numConnections)
+                    .withMaxPendingConnectionAcquisitions(maxPendingAcquisitions)
+                    .withConnectionAcquisitionTimeoutInMilliseconds(acquisitionTimeoutMs);
 
             return HttpClientConnectionManager.create(options);
         }
@@ -315,4 +325,131 @@ public class HttpClientConnectionManagerTest extends HttpClientTestFixture  {
             conn.close();
         }
     }
+
+    private static void assertAcquisitionFails(CompletableFuture<HttpClientConnection> acquisition,
+            String expectedMessage) throws Exception {
+        try {
+            acquisition.get(2 * ACQUISITION_TIMEOUT_MS, TimeUnit.MILLISECONDS).close();
+            Assert.fail("connection acquisition should have failed");
+        } catch (ExecutionException ex) {
+            Assert.assertTrue(ex.getCause() instanceof HttpException);
+            Assert.assertEquals(expectedMessage, ex.getCause().getMessage());
+        }
+    }
+
+    @Test
+    public void testBoundedPendingAcquisitions() throws Exception {
+        skipIfNetworkUnavailable();
+
+        try (HttpClientConnectionManager connectionPool = createConnectionManager(new URI(endpoint), 1, 1, 1,
+                ACQUISITION_TIMEOUT_MS)) {
+            HttpClientConnection firstConnection = connectionPool.acquireConnection().get(60, TimeUnit.SECONDS);
+
+            // the pool is exhausted, so this one waits, and the next is over the limit of 1 waiting acquisition
+            CompletableFuture<HttpClientConnection> waitingAcquisition = connectionPool.acquireConnection();
+            CompletableFuture<HttpClientConnection> rejectedAcquisition = connectionPool.acquireConnection();
+            Assert.assertTrue(rejectedAcquisition.isDone());
+            assertAcquisitionFails(rejectedAcquisition,
+                    "Too many connection acquisitions are already waiting on the connection manager");
+
+            // nothing is released, so the waiting acquisition times out
+            assertAcquisitionFails(waitingAcquisition,
+                    "Timed out waiting for a connection from the connection manager");
+
+            // the timed out acquisition is still queued in the pool, so it keeps holding the waiting slot
+            CompletableFuture<HttpClientConnection> stillRejectedAcquisition = connectionPool.acquireConnection();
+            Assert.assertTrue(stillRejectedAcquisition.isDone());
+            assertAcquisitionFails(stillRejectedAcquisition,
+                    "Too many connection acquisitions are already waiting on the connection manager");
+
+            // returning the connection hands it to the timed out acquisition, which puts it back and frees the slot
+            firstConnection.close();
+            connectionPool.acquireConnection().get(5, TimeUnit.SECONDS).close();
+
+            HttpManagerMetrics metrics = connectionPool.getManagerMetrics();
+            Assert.assertEquals(2, metrics.getAcquisitionsSucceeded());
+            Assert.assertEquals(2, metrics.getAcquisitionsRejected());
+            Assert.assertEquals(1, metrics.getAcquisitionsTimedOut());
+            Assert.assertEquals(0, metrics.getAcquisitionsFailed());
+            Assert.assertTrue(
+                    metrics.getMaxAcquisitionWaitTimeNs() >= TimeUnit.MILLISECONDS.toNanos(ACQUISITION_TIMEOUT_MS));
+
+            long[] histogram = metrics.getAcquisitionWaitTimeHistogram();
+            Assert.assertEquals(HttpManagerMetrics.getAcquisitionWaitTimeBucketBoundsMs().length + 1, histogram.length);
+            long completed = 0;
+            for (long count : histogram) {
+                completed += count;
+            }
+            Assert.assertEquals(3, completed);
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    @Test
+    public void testPrewarmConnections() throws Exception {
+        skipIfNetworkUnavailable();
+
+        try (HttpClientConnectionManager connectionPool = createConnectionManager(new URI(endpoint), 1, 2)) {
+            // asking for more than the max only warms up to the max
+            int warmed = connectionPool.prewarm(3).get(60, TimeUnit.SECONDS);
+            Assert.assertEquals(2, warmed);
+
+            HttpManagerMetrics metrics = connectionPool.getManagerMetrics();
+            Assert.assertEquals(2, metrics.getAvailableConcurrency());
+            Assert.assertEquals(0, metrics.getLeasedConcurrency());
+            Assert.assertEquals(0, metrics.getPendingConcurrencyAcquires());
+
+            // warm connections are handed out without waiting for a new one
+            connectionPool.acquireConnection().get(5, TimeUnit.SECONDS).close();
+            Assert.assertEquals(0, (int) connectionPool.prewarm(0).get());
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
+
+    @Test
+    public void testShardedConnectionManagerStealsFromOtherShards() throws Exception {
+        skipIfNetworkUnavailable();
+
+        try (EventLoopGroup eventLoopGroup = new EventLoopGroup(2);
+                HostResolver resolver = new HostResolver(eventLoopGroup);
+                ClientBootstrap bootstrap = new ClientBootstrap(eventLoopGroup, resolver);
+                SocketOptions sockOpts = new SocketOptions();
+                TlsContext tlsContext = createHttpClientTlsContext()) {
+            HttpClientConnectionManagerOptions options = new HttpClientConnectionManagerOptions()
+                    .withClientBootstrap(bootstrap)
+                    .withSocketOptions(sockOpts)
+                    .withTlsContext(tlsContext)
+                    .withUri(new URI(endpoint))
+                    .withMaxConnections(4);
+
+            try (ShardedHttpClientConnectionManager connectionPool =
+                    ShardedHttpClientConnectionManager.create(options, 2)) {
+                Assert.assertEquals(2, connectionPool.getShardCount());
+                Assert.assertEquals(4, connectionPool.getMaxConnections());
+
+                // everything comes from this thread's shard, which only holds 2, so the rest must be stolen
+                List<HttpClientConnection> connections = new ArrayList<>();
+                for (int i = 0; i < 4; i++) {
+                    connections.add(connectionPool.acquireConnection().get(60, TimeUnit.SECONDS));
+                }
+
+                HttpManagerMetrics metrics = connectionPool.getManagerMetrics();
+                Assert.assertEquals(4, metrics.getLeasedConcurrency());
+                Assert.assertEquals(0, metrics.getPendingConcurrencyAcquires());
+                Assert.assertEquals(4, metrics.getAcquisitionsSucceeded());
+
+                for (HttpClientConnection connection : connections) {
+                    connectionPool.releaseConnection(connection);
+                }
+                Assert.assertEquals(0, connectionPool.getManagerMetrics().getLeasedConcurrency());
+            }
+        }
+
+        CrtResource.logNativeResources();
+        CrtResource.waitForNoResources();
+    }
 }
@@ -9,18 +9,35 @@ import static software.amazon.awssdk.crt.utils.ByteBufferUtils.transferData;
 
 import org.junit.Assert;
 import org.junit.Test;
+import software.amazon.awssdk.crt.CRT;
 import software.amazon.awssdk.crt.CrtResource;
 import software.amazon.awssdk.crt.http.HttpClientConnection;
 import software.amazon.awssdk.crt.http.HttpClientConnectionManager;
+import software.amazon.awssdk.crt.http.HttpClientConnectionManagerOptions;
 import software.amazon.awssdk.crt.http.HttpVersion;
 import software.amazon.awssdk.crt.http.HttpHeader;
+import software.amazon.awssdk.crt.http.HttpHeaderTemplate;
+import software.amazon.awssdk.crt.http.HttpHeadersView;
 import software.amazon.awssdk.crt.http.HttpRequest;
 import software.amazon.awssdk.crt.http.HttpRequestBodyStream;
+import software.amazon.awssdk.crt.http.HttpRequestBuilder;
+import software.amazon.awssdk.crt.http.HttpStreamBase;
+import software.amazon.awssdk.crt.http.HttpStreamBaseResponseHandler;
 import software.amazon.awssdk.crt.http.HttpStreamResponseHandler;
 import software.amazon.awssdk.crt.http.HttpStream;
-
+import software.amazon.awssdk.crt.io.ClientBootstrap;
+import software.amazon.awssdk.crt.io.EventLoopGroup;
+import software.amazon.awssdk.crt.io.HostResolver;
+import software.amazon.awssdk.crt.io.ServerBootstrap;
+import software.amazon.awssdk.crt.io.SocketOptions;
+import software.amazon.awssdk.crt.s3.S3LoopbackServer;
+import software.amazon.awssdk.crt.s3.S3LoopbackServerOptions;
+
+import java.io.ByteArrayOutputStream;
 import java.net.URI;
 import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.List;
 import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.TimeUnit;
 
@@ -294,4 +311,298 @@ public class HttpRequestResponseTest extends HttpRequestResponseFixture {
         HttpRequest request = new HttpRequest("GET", "/?ሴ=bar");
         request.marshalForJni();
     }
+
+    @Test
+    public void testHttpGetFromRequestBuilder() throws Exception {
+        skipIfNetworkUnavailable();
+
+        URI uri = new URI("https://httpbin.org");
+
+        CompletableFuture<Void> shutdownComplete = null;
+        try (HttpClientConnectionManager connPool = createConnectionPoolManager(uri, HttpVersion.HTTP_1_1);
+                HttpRequestBuilder request = new HttpRequestBuilder()) {
+            shutdownComplete = connPool.getShutdownCompleteFuture();
+            request.setMethod("GET").addHeader("Host", uri.getHost());
+
+            /* the same builder is sent twice, edited in between */
+            String[] paths = { "/get", "/status/404" };
+            int[] expectedStatus = { 200, 404 };
+            for (int i = 0; i < paths.length; ++i) {
+                request.setEncodedPath(paths[i]);
+                CompletableFuture<Integer> statusFuture = new CompletableFuture<>();
+                CompletableFuture<Boolean> hasContentLengthFuture = new CompletableFuture<>();
+                HttpStreamBaseResponseHandler streamHandler = new HttpStreamBaseResponseHandler() {
+                    @Override
+                    public void onResponseHeaders(HttpStreamBase stream, int responseStatusCode, int blockType,
+                            HttpHeader[] nextHeaders) {
+                        statusFuture.completeExceptionally(new AssertionError("lazy header view should be used"));
+                    }
+
+                    @Override
+                    public void onResponseHeaders(HttpStreamBase stream, int responseStatusCode, int blockType,
+                            HttpHeadersView nextHeaders) {
+                        statusFuture.complete(responseStatusCode);
+                        if (nextHeaders.get("content-length") != null) {
+                            hasContentLengthFuture.complete(true);
+                        }
+                    }
+
+                    @Override
+                    public void onResponseComplete(HttpStreamBase stream, int errorCode) {
+                        hasContentLengthFuture.complete(false);
+                    }
+                };
+
+                try (HttpClientConnection conn = connPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                        HttpStreamBase stream = conn.makeRequest(request, streamHandler)) {
+                    stream.activate();
+                    Assert.assertTrue(hasContentLengthFuture.get(60, TimeUnit.SECONDS));
+                    if (statusFuture.get() < 500) { // if the server errored, not our fault
+                        Assert.assertEquals(expectedStatus[i], (int) statusFuture.get());
+                    }
+                }
+            }
+        }
+
+        if (shutdownComplete != null) {
+            shutdownComplete.get();
+        }
+
+        CrtResource.waitForNoResources();
+    }
+
+    @Test
+    public void testHttpGetWithHeaderTemplate() throws Exception {
+        skipIfNetworkUnavailable();
+
+        URI uri = new URI("https://httpbin.org");
+
+        CompletableFuture<Void> shutdownComplete = null;
+        try (HttpClientConnectionManager connPool = createConnectionPoolManager(uri, HttpVersion.HTTP_1_1);
+                HttpHeaderTemplate template = new HttpHeaderTemplate(new HttpHeader[] {
+                        new HttpHeader("Host", uri.getHost()), new HttpHeader("X-Crt-Template", "template") })) {
+            shutdownComplete = connPool.getShutdownCompleteFuture();
+
+            /* first request only has template headers, the second overrides one of them */
+            HttpRequest sharedRequest = new HttpRequest("GET", "/headers");
+            HttpRequest overridingRequest = new HttpRequest("GET", "/headers",
+                    new HttpHeader[] { new HttpHeader("x-crt-template", "override") }, null);
+            HttpRequest[] requests = { sharedRequest, overridingRequest };
+            String[] expectedValues = { "template", "override" };
+            for (int i = 0; i < requests.length; ++i) {
+                requests[i].setHeaderTemplate(template);
+                CompletableFuture<Integer> statusFuture = new CompletableFuture<>();
+                CompletableFuture<Void> completeFuture = new CompletableFuture<>();
+                ByteArrayOutputStream body = new ByteArrayOutputStream();
+                HttpStreamBaseResponseHandler streamHandler = new HttpStreamBaseResponseHandler() {
+                    @Override
+                    public void onResponseHeaders(HttpStreamBase stream, int responseStatusCode, int blockType,
+                            HttpHeader[] nextHeaders) {
+                        statusFuture.complete(responseStatusCode);
+                    }
+
+                    @Override
+                    public int onResponseBody(HttpStreamBase stream, byte[] bodyBytesIn) {
+                        body.write(bodyBytesIn, 0, bodyBytesIn.length);
+                        return bodyBytesIn.length;
+                    }
+
+                    @Override
+                    public void onResponseComplete(HttpStreamBase stream, int errorCode) {
+                        completeFuture.complete(null);
+                    }
+                };
+
+                try (HttpClientConnection conn = connPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                        HttpStreamBase stream = conn.makeRequest(requests[i], streamHandler)) {
+                    stream.activate();
+                    completeFuture.get(60, TimeUnit.SECONDS);
+                }
+
+                if (statusFuture.get() < 500) { // if the server errored, not our fault
+                    Assert.assertEquals(200, (int) statusFuture.get());
+                    /* httpbin echoes the request headers back as JSON */
+                    String echoed = new String(body.toByteArray(), UTF8);
+                    Assert.assertTrue(echoed, echoed.contains("\"" + expectedValues[i] + "\""));
+                    Assert.assertFalse(echoed, echoed.contains("\"" + expectedValues[1 - i] + "\""));
+                }
+            }
+        }
+
+        if (shutdownComplete != null) {
+            shutdownComplete.get();
+        }
+
+        CrtResource.waitForNoResources();
+    }
+
+    @Test
+    public void testHttpDownloadCoalescedBody() throws Exception {
+        skipIfNetworkUnavailable();
+
+        URI uri = new URI("https://aws-crt-test-stuff.s3.amazonaws.com");
+        HttpRequest request = new HttpRequest("GET", "/http_test_doc.txt",
+                new HttpHeader[] { new HttpHeader("Host", uri.getHost()) }, null);
+
+        CompletableFuture<Void> shutdownComplete = null;
+        try (HttpClientConnectionManager connPool = createConnectionPoolManager(uri, HttpVersion.HTTP_1_1)) {
+            shutdownComplete = connPool.getShutdownCompleteFuture();
+
+            CompletableFuture<Integer> completeFuture = new CompletableFuture<>();
+            ByteBuffer body = ByteBuffer.allocate(16 * 1024 * 1024);
+            int[] bodyCalls = { 0 };
+            HttpStreamBaseResponseHandler streamHandler = new HttpStreamBaseResponseHandler() {
+                @Override
+                public void onResponseHeaders(HttpStreamBase stream, int responseStatusCode, int blockType,
+                        HttpHeader[] nextHeaders) {
+                }
+
+                @Override
+                public int getMinimumResponseBodyChunkSize() {
+                    /* bigger than the whole document, so it all arrives at once when the stream completes */
+                    return 8 * 1024 * 1024;
+                }
+
+                @Override
+                public int onResponseBody(HttpStreamBase stream, byte[] bodyBytesIn) {
+                    ++bodyCalls[0];
+                    body.put(bodyBytesIn);
+                    return bodyBytesIn.length;
+                }
+
+                @Override
+                public void onResponseComplete(HttpStreamBase stream, int errorCode) {
+                    completeFuture.complete(errorCode);
+                }
+            };
+
+            try (HttpClientConnection conn = connPool.acquireConnection().get(60, TimeUnit.SECONDS);
+                    HttpStreamBase stream = conn.makeRequest(request, streamHandler)) {
+                stream.activate();
+                Assert.assertEquals(0, (int) completeFuture.get(60, TimeUnit.SECONDS));
+                if (stream.getResponseStatusCode() < 500) { // if the server errored, not our fault
+                    Assert.assertEquals(200, stream.getResponseStatusCode());
+                    Assert.assertEquals(1, bodyCalls[0]);
+                    body.flip();
+                    Assert.assertEquals(TEST_DOC_SHA256, calculateBodyHash(body));
+                }
+            }
+        }
+
+        if (shutdownComplete != null) {
+            shutdownComplete.get();
+        }
+
+        CrtResource.waitForNoResources();
+    }
+
+    @Test
+    public void testHttpRequestBuilderRejectsEditsAfterClose() {
+        HttpRequestBuilder request = new HttpRequestBuilder();
+        request.setMethod("GET").setEncodedPath("/").addHeader("Host", "localhost");
+        request.close();
+
+        Assert.assertThrows(IllegalStateException.class, () -> request.setMethod("PUT"));
+        Assert.assertThrows(IllegalStateException.class, () -> request.setEncodedPath("/other"));
+        Assert.assertThrows(IllegalStateException.class, () -> request.addHeader("a", "b"));
+        Assert.assertThrows(IllegalStateException.class, () -> request.addHeader(new HttpHeader("a", "b")));
+        Assert.assertThrows(IllegalStateException.class, () -> request.setHeader("a", "b"));
+        Assert.assertThrows(IllegalStateException.class, () -> request.removeHeader("a"));
+        Assert.assertThrows(IllegalStateException.class, () -> request.clearHeaders());
+    }
+
+    /*
+     * Stream bindings are recycled through a free list that keeps their headers buffer, so alternate responses with
+     * different headers over many streams and check that none shows another's headers, then that
+     * waitForNoResources() frees the whole list. Runs against the local S3 loopback server.
+     */
+    @Test
+    @SuppressWarnings("deprecation")
+    public void testStreamChurnKeepsHeadersPerStream() throws Exception {
+        final int streamCount = 200;
+        final long objectSize = 1024;
+
+        CrtResource.waitForNoResources();
+        long baselineAllocations = CRT.nativeAllocations(CRT.NativeMemorySubsystem.Http);
+
+        try (EventLoopGroup elGroup = new EventLoopGroup(1);
+                ServerBootstrap serverBootstrap = new ServerBootstrap(elGroup);
+                SocketOptions socketOptions = new SocketOptions();
+                HostResolver resolver = new HostResolver(elGroup);
+                ClientBootstrap clientBootstrap = new ClientBootstrap(elGroup, resolver)) {
+
+            S3LoopbackServer server = new S3LoopbackServer(serverBootstrap, socketOptions,
+                    new S3LoopbackServerOptions().withObjectSize(objectSize));
+            try {
+                HttpClientConnectionManagerOptions options = new HttpClientConnectionManagerOptions()
+                        .withClientBootstrap(clientBootstrap)
+                        .withSocketOptions(socketOptions)
+                        .withUri(server.getUri());
+
+                List<String> wholeHeaders = null;
+                List<String> rangedHeaders = null;
+                try (HttpClientConnectionManager connectionManager = HttpClientConnectionManager.create(options)) {
+                    HttpClientConnection connection = connectionManager.acquireConnection().get(60, TimeUnit.SECONDS);
+                    try {
+                        for (int i = 0; i < streamCount; ++i) {
+                            boolean ranged = (i % 2) == 1;
+                            HttpHeader host = new HttpHeader("Host", server.getHostHeader());
+                            HttpHeader[] headers = ranged
+                                    ? new HttpHeader[] { host, new HttpHeader("Range", "bytes=0-" + (i % 100)) }
+                                    : new HttpHeader[] { host };
+                            HttpRequest request = new HttpRequest("GET", "/bucket/key", headers, null);
+
+                            List<String> received = new ArrayList<>();
+                            CompletableFuture<Integer> done = new CompletableFuture<>();
+                            HttpStreamResponseHandler handler = new HttpStreamResponseHandler() {
+                                @Override
+                                public void onResponseHeaders(HttpStream stream, int responseStatusCode,
+                                        int blockType, HttpHeader[] nextHeaders) {
+                                    for (HttpHeader header : nextHeaders) {
+                                        received.add(header.getName().toLowerCase());
+                                    }
+                                }
+
+                                @Override
+                                public void onResponseComplete(HttpStream stream, int errorCode) {
+                                    done.complete(errorCode);
+                                }
+                            };
+
+                            try (HttpStream stream = connection.makeRequest(request, handler)) {
+                                stream.activate();
+                                Assert.assertEquals(0, (int) done.get(60, TimeUnit.SECONDS));
+                                Assert.assertEquals(ranged ? 206 : 200, stream.getResponseStatusCode());
+                            }
+
+                            Assert.assertEquals(ranged, received.contains("content-range"));
+                            if (ranged) {
+                                if (rangedHeaders == null) {
+                                    rangedHeaders = received;
+                                }
+                                Assert.assertEquals(rangedHeaders, received);
+                            } else {
+                                if (wholeHeaders == null) {
+                                    wholeHeaders = received;
+                                }
+                                Assert.assertEquals(wholeHeaders, received);
+                            }
+                        }
+                    } finally {
+                        connectionManager.releaseConnection(connection);
+                    }
+                }
+            } finally {
+                server.close();
+                server.getShutdownCompleteFuture().get(60, TimeUnit.SECONDS);
+            }
+        }
+
+        /* the recycled bindings are only freed here, anything left over would show up as Http allocations */
+        CrtResource.waitForNoResources();
+        for (int i = 0; i < 100 && CRT.nativeAllocations(CRT.NativeMemorySubsystem.Http) != baselineAllocations; ++i) {
+            Thread.sleep(100);
+        }
+        Assert.assertEquals(baselineAllocations, CRT.nativeAllocations(CRT.NativeMemorySubsystem.Http));
+    }
 }
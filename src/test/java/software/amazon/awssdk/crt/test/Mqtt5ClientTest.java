@@ -23,21 +23,27 @@ import software.amazon.awssdk.crt.mqtt5.Mqtt5ClientOptions.ClientSessionBehavior
 import software.amazon.awssdk.crt.mqtt5.Mqtt5ClientOptions.ExtendedValidationAndFlowControlOptions;
 import software.amazon.awssdk.crt.mqtt5.Mqtt5ClientOptions.LifecycleEvents;
 import software.amazon.awssdk.crt.mqtt5.Mqtt5ClientOptions.Mqtt5ClientOptionsBuilder;
+import software.amazon.awssdk.crt.mqtt5.Mqtt5ClientOptions.OfflineQueueOverflowPolicy;
 import software.amazon.awssdk.crt.mqtt5.Mqtt5ClientOptions.PublishEvents;
 import software.amazon.awssdk.crt.mqtt5.packets.*;
 import software.amazon.awssdk.crt.mqtt5.packets.ConnectPacket.ConnectPacketBuilder;
 import software.amazon.awssdk.crt.mqtt5.packets.DisconnectPacket.DisconnectPacketBuilder;
 import software.amazon.awssdk.crt.mqtt5.packets.DisconnectPacket.DisconnectReasonCode;
+import software.amazon.awssdk.crt.mqtt5.packets.PubAckPacket.PubAckReasonCode;
 import software.amazon.awssdk.crt.mqtt5.packets.PublishPacket.PublishPacketBuilder;
 import software.amazon.awssdk.crt.mqtt5.packets.SubscribePacket.SubscribePacketBuilder;
 import software.amazon.awssdk.crt.mqtt5.packets.UnsubscribePacket.UnsubscribePacketBuilder;
 import software.amazon.awssdk.crt.mqtt5.packets.SubscribePacket.RetainHandlingType;
 
+import java.io.File;
+import java.nio.ByteBuffer;
 import java.util.ArrayList;
+import java.util.Arrays;
 import java.util.List;
 import java.util.Random;
 import java.util.UUID;
 import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
 import java.util.concurrent.TimeUnit;
 import java.util.function.Consumer;
 
@@ -1924,6 +1930,276 @@ public class Mqtt5ClientTest extends CrtTestFixture {
         }
     }
 
+    /* Lazy publish packets: topic and payload without building the packet, the rest decoded on request */
+    @Test
+    public void Op_LazyPublishPackets() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+
+            CompletableFuture<Void> publishReceivedFuture = new CompletableFuture<>();
+            List<String> receivedTopics = new ArrayList<>();
+            List<String> receivedPayloads = new ArrayList<>();
+            List<PublishPacket> receivedPackets = new ArrayList<>();
+            List<PublishReturn> receivedReturns = new ArrayList<>();
+            builder.withPublishEvents(new PublishEvents() {
+                @Override
+                public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                    receivedTopics.add(publishReturn.getTopic());
+                    byte[] payload = new byte[publishReturn.getPayloadBuffer().remaining()];
+                    publishReturn.getPayloadBuffer().get(payload);
+                    receivedPayloads.add(new String(payload));
+                    receivedPackets.add(publishReturn.getPublishPacket());
+                    receivedReturns.add(publishReturn);
+                    publishReceivedFuture.complete(null);
+                }
+            });
+            builder.withLazyPublishPackets(true);
+
+            List<UserProperty> userProperties = new ArrayList<>();
+            userProperties.add(new UserProperty("key", "value"));
+            PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+            publishPacketBuilder.withTopic(testTopic);
+            publishPacketBuilder.withPayload("Hello World".getBytes());
+            publishPacketBuilder.withQOS(QOS.AT_LEAST_ONCE);
+            publishPacketBuilder.withContentType("text/plain");
+            publishPacketBuilder.withUserProperties(userProperties);
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic, QOS.AT_LEAST_ONCE);
+
+            try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+                client.start();
+                events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+                client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+                client.publish(publishPacketBuilder.build()).get(60, TimeUnit.SECONDS);
+                publishReceivedFuture.get(60, TimeUnit.SECONDS);
+
+                assertEquals(testTopic, receivedTopics.get(0));
+                assertEquals("Hello World", receivedPayloads.get(0));
+                PublishPacket packet = receivedPackets.get(0);
+                assertEquals(testTopic, packet.getTopic());
+                assertEquals("Hello World", new String(packet.getPayload()));
+                assertEquals(QOS.AT_LEAST_ONCE, packet.getQOS());
+                assertEquals("text/plain", packet.getContentType());
+                assertEquals(1, packet.getUserProperties().size());
+                assertEquals("key", packet.getUserProperties().get(0).key);
+                assertEquals("value", packet.getUserProperties().get(0).value);
+
+                /* already built during the callback, so still available */
+                assertEquals(packet, receivedReturns.get(0).getPublishPacket());
+
+                client.stop(new DisconnectPacketBuilder().build());
+            }
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* Publish with the payload taken from a direct ByteBuffer */
+    @Test
+    public void Op_DirectPayloadPublish() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+
+            CompletableFuture<byte[]> payloadReceivedFuture = new CompletableFuture<>();
+            builder.withPublishEvents(new PublishEvents() {
+                @Override
+                public void onMessageReceived(Mqtt5Client client, PublishReturn publishReturn) {
+                    payloadReceivedFuture.complete(publishReturn.getPublishPacket().getPayload());
+                }
+            });
+
+            byte[] expected = "Hello World".getBytes();
+            ByteBuffer payload = ByteBuffer.allocateDirect(expected.length + 4);
+            payload.putShort((short) 0);
+            payload.put(expected);
+            payload.putShort((short) 0);
+            payload.position(2);
+            payload.limit(2 + expected.length);
+
+            PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+            publishPacketBuilder.withTopic(testTopic);
+            publishPacketBuilder.withQOS(QOS.AT_LEAST_ONCE);
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic, QOS.AT_LEAST_ONCE);
+
+            try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+                client.start();
+                events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+                client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+                CompletableFuture<PublishResult> publishFuture = client.publish(publishPacketBuilder.build(), payload);
+                /* the client has its own copy, so the buffer can be reused right away */
+                assertEquals(2, payload.position());
+                payload.put(2, (byte) 0);
+                publishFuture.get(60, TimeUnit.SECONDS);
+
+                assertTrue(Arrays.equals(expected, payloadReceivedFuture.get(60, TimeUnit.SECONDS)));
+
+                client.stop(new DisconnectPacketBuilder().build());
+            }
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* Batch of publishes with one aggregate future */
+    @Test
+    public void Op_PublishBatch() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+        int messageCount = 10;
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+
+            PublishEvents_Futured_Counted publishEvents = new PublishEvents_Futured_Counted();
+            publishEvents.desiredPublishCount = messageCount;
+            builder.withPublishEvents(publishEvents);
+
+            List<PublishPacket> publishPackets = new ArrayList<>();
+            for (int i = 0; i < messageCount; ++i) {
+                PublishPacketBuilder publishPacketBuilder = new PublishPacketBuilder();
+                publishPacketBuilder.withTopic(testTopic);
+                publishPacketBuilder.withPayload(("Hello World " + i).getBytes());
+                publishPacketBuilder.withQOS(i % 2 == 0 ? QOS.AT_LEAST_ONCE : QOS.AT_MOST_ONCE);
+                publishPackets.add(publishPacketBuilder.build());
+            }
+            /* no topic, so fails on its own without failing the others */
+            publishPackets.add(new PublishPacketBuilder().withPayload("Bad".getBytes()).build());
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic, QOS.AT_LEAST_ONCE);
+
+            try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+                client.start();
+                events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+                client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+                PublishBatchResult result = client.publishBatch(publishPackets).get(60, TimeUnit.SECONDS);
+
+                assertEquals(messageCount + 1, result.size());
+                for (int i = 0; i < messageCount; ++i) {
+                    assertTrue(result.succeeded(i));
+                    assertEquals(PubAckReasonCode.SUCCESS, result.getPubAckReasonCode(i));
+                }
+                assertTrue(!result.succeeded(messageCount));
+                assertNotNull(result.getErrorName(messageCount));
+
+                publishEvents.publishReceivedFuture.get(60, TimeUnit.SECONDS);
+
+                client.stop(new DisconnectPacketBuilder().build());
+            }
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* Messages routed natively to the handlers whose topic filters they match */
+    @Test
+    public void Op_TopicHandlers() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+
+            PublishEvents_Futured unroutedEvents = new PublishEvents_Futured();
+            builder.withPublishEvents(unroutedEvents);
+
+            PublishEvents_Futured singleLevelEvents = new PublishEvents_Futured();
+            PublishEvents_Futured multiLevelEvents = new PublishEvents_Futured();
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic + "/#", QOS.AT_LEAST_ONCE);
+
+            try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+                client.addTopicHandler(testTopic + "/+/temperature", singleLevelEvents);
+                client.addTopicHandler(testTopic + "/alarms/#", multiLevelEvents);
+
+                client.start();
+                events.connectedFuture.get(60, TimeUnit.SECONDS);
+                client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+
+                client.publish(new PublishPacketBuilder().withTopic(testTopic + "/kitchen/temperature")
+                    .withQOS(QOS.AT_LEAST_ONCE).withPayload("21".getBytes()).build()).get(60, TimeUnit.SECONDS);
+                singleLevelEvents.publishReceivedFuture.get(60, TimeUnit.SECONDS);
+                assertEquals(testTopic + "/kitchen/temperature", singleLevelEvents.publishPacket.getTopic());
+
+                client.publish(new PublishPacketBuilder().withTopic(testTopic + "/alarms/kitchen/smoke")
+                    .withQOS(QOS.AT_LEAST_ONCE).withPayload("on".getBytes()).build()).get(60, TimeUnit.SECONDS);
+                multiLevelEvents.publishReceivedFuture.get(60, TimeUnit.SECONDS);
+                assertEquals(testTopic + "/alarms/kitchen/smoke", multiLevelEvents.publishPacket.getTopic());
+
+                /* matches no filter, so falls through to the client's publish events */
+                client.publish(new PublishPacketBuilder().withTopic(testTopic + "/kitchen/humidity")
+                    .withQOS(QOS.AT_LEAST_ONCE).withPayload("40".getBytes()).build()).get(60, TimeUnit.SECONDS);
+                unroutedEvents.publishReceivedFuture.get(60, TimeUnit.SECONDS);
+                assertEquals(testTopic + "/kitchen/humidity", unroutedEvents.publishPacket.getTopic());
+
+                assertTrue(client.removeTopicHandler(testTopic + "/alarms/#"));
+                assertTrue(!client.removeTopicHandler(testTopic + "/alarms/#"));
+
+                client.stop(new DisconnectPacketBuilder().build());
+            }
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* Topic filters that break the wildcard rules are rejected */
+    @Test
+    public void Op_TopicHandlersInvalidFilter() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+
+        Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+        try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+            String[] invalidFilters = { "a/#/b", "a/b#", "a+/b", "" };
+            for (String filter : invalidFilters) {
+                try {
+                    client.addTopicHandler(filter, new PublishEvents_Futured());
+                    fail("Topic filter should have been rejected: " + filter);
+                } catch (IllegalArgumentException ex) {
+                    // expected
+                }
+            }
+        }
+    }
+
     /* Sub-UnSub happy path */
     @Test
     public void Op_UC2() {
@@ -2596,4 +2872,206 @@ public class Mqtt5ClientTest extends CrtTestFixture {
             fail(ex.getMessage());
         }
     }
+
+    /* Extended statistics count publishes, received messages and connections, and record publish latencies */
+    @Test
+    public void Op_ExtendedStatistics() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+        byte[] payload = "Hello World".getBytes();
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+
+            PublishEvents_Futured publishEvents = new PublishEvents_Futured();
+            builder.withPublishEvents(publishEvents);
+
+            SubscribePacketBuilder subscribePacketBuilder = new SubscribePacketBuilder();
+            subscribePacketBuilder.withSubscription(testTopic, QOS.AT_LEAST_ONCE);
+
+            try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+                Mqtt5ClientExtendedStatistics before = client.getExtendedStatistics();
+                assertEquals(0, before.getConnectionSuccesses());
+                assertEquals(0, before.getPublishesCompleted());
+
+                client.start();
+                events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+                client.subscribe(subscribePacketBuilder.build()).get(60, TimeUnit.SECONDS);
+                client.publish(new PublishPacketBuilder().withTopic(testTopic).withQOS(QOS.AT_LEAST_ONCE).withPayload(payload).build()).get(60, TimeUnit.SECONDS);
+                client.publish(new PublishPacketBuilder().withTopic(testTopic).withQOS(QOS.AT_MOST_ONCE).withPayload(payload).build()).get(60, TimeUnit.SECONDS);
+                publishEvents.publishReceivedFuture.get(60, TimeUnit.SECONDS);
+
+                Mqtt5ClientExtendedStatistics after = client.getExtendedStatistics();
+                assertEquals(1, after.getConnectionSuccesses());
+                assertEquals(2, after.getPublishesCompleted());
+                assertEquals(0, after.getPublishesFailed());
+                assertEquals(2 * payload.length, after.getPayloadBytesPublished());
+                assertTrue(after.getMessagesReceived() >= 1);
+                assertTrue(after.getTimestampNanos() > before.getTimestampNanos());
+                assertTrue(after.getPayloadBytesPublishedPerSecondSince(before) > 0);
+
+                LatencyHistogram qos1Latency = after.getQos1PublishLatency();
+                assertEquals(1, qos1Latency.getCount());
+                assertTrue(qos1Latency.getValueAtPercentileMicros(50) > 0);
+                assertEquals(1, after.getQos0PublishLatency().getCount());
+
+                client.stop(new DisconnectPacketBuilder().build());
+                events.stopFuture.get(60, TimeUnit.SECONDS);
+                assertEquals(1, client.getExtendedStatistics().getDisconnections());
+            }
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* Publishes made before connecting are held within the offline queue limits and sent once connected */
+    @Test
+    public void Op_OfflineQueueLimits() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+
+        try {
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+            builder.withOfflineQueueMaxMessages(2L);
+            builder.withOfflineQueueOverflowPolicy(OfflineQueueOverflowPolicy.DROP_OLDEST);
+
+            try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+                List<CompletableFuture<PublishResult>> futures = new ArrayList<>();
+                for (int i = 0; i < 3; ++i) {
+                    futures.add(client.publish(new PublishPacketBuilder().withTopic(testTopic).withQOS(QOS.AT_LEAST_ONCE).withPayload(("Hello World " + i).getBytes()).build()));
+                }
+
+                /* the oldest made room for the newest */
+                assertTrue(futures.get(0).isCompletedExceptionally());
+                Mqtt5ClientExtendedStatistics queued = client.getExtendedStatistics();
+                assertEquals(2, queued.getOfflineQueueMessages());
+                assertEquals(1, queued.getOfflineQueueDropped());
+
+                client.start();
+                events.connectedFuture.get(60, TimeUnit.SECONDS);
+
+                futures.get(1).get(60, TimeUnit.SECONDS);
+                futures.get(2).get(60, TimeUnit.SECONDS);
+                assertEquals(0, client.getExtendedStatistics().getOfflineQueueMessages());
+
+                client.stop(new DisconnectPacketBuilder().build());
+            }
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        }
+    }
+
+    /* QoS 1 publishes spilled to disk by a client that never connected are sent by the next client to use the file */
+    @Test
+    public void Op_OfflineQueueSpill() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(mqtt5DirectMqttHost != null);
+        Assume.assumeTrue(mqtt5DirectMqttPort != null);
+        String testUUID = UUID.randomUUID().toString();
+        String testTopic = "test/MQTT5_Binding_Java_" + testUUID;
+
+        File spillFile = null;
+        try {
+            spillFile = File.createTempFile("mqtt5_offline_queue", ".log");
+
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder(mqtt5DirectMqttHost, mqtt5DirectMqttPort);
+            builder.withOfflineQueueSpillPath(spillFile.getAbsolutePath());
+
+            CompletableFuture<PublishResult> abandoned;
+            try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+                abandoned = client.publish(new PublishPacketBuilder().withTopic(testTopic).withQOS(QOS.AT_LEAST_ONCE).withPayload("Hello World".getBytes()).build());
+                assertEquals(1, client.getExtendedStatistics().getOfflineQueueMessages());
+            }
+            /* the client is gone, but its message is still in the file */
+            try {
+                abandoned.get(60, TimeUnit.SECONDS);
+                fail("publish from a closed client should not succeed");
+            } catch (ExecutionException expected) {
+            }
+            assertTrue(spillFile.length() > 0);
+
+            LifecycleEvents_Futured events = new LifecycleEvents_Futured();
+            builder.withLifecycleEvents(events);
+            try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+                assertEquals(1, client.getExtendedStatistics().getOfflineQueueMessages());
+
+                client.start();
+                events.connectedFuture.get(60, TimeUnit.SECONDS);
+                /* the record is read back and published off the event loop, and only leaves the file once acked */
+                long deadline = System.nanoTime() + TimeUnit.SECONDS.toNanos(60);
+                while (client.getExtendedStatistics().getOfflineQueueMessages() > 0 && System.nanoTime() < deadline) {
+                    Thread.sleep(10);
+                }
+                assertEquals(0, client.getExtendedStatistics().getOfflineQueueMessages());
+                while (spillFile.length() > 0 && System.nanoTime() < deadline) {
+                    Thread.sleep(10);
+                }
+                assertEquals(0, spillFile.length());
+
+                client.stop(new DisconnectPacketBuilder().build());
+            }
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        } finally {
+            if (spillFile != null) {
+                spillFile.delete();
+            }
+        }
+    }
+
+    /* Records recovered from a spill file count towards the new client's limits like any other */
+    @Test
+    public void Op_OfflineQueueSpillRecoveryLimits() {
+        String testTopic = "test/MQTT5_Binding_Java_" + UUID.randomUUID().toString();
+
+        File spillFile = null;
+        try {
+            spillFile = File.createTempFile("mqtt5_offline_queue", ".log");
+
+            /* the clients never connect, so any host will do */
+            Mqtt5ClientOptionsBuilder builder = new Mqtt5ClientOptionsBuilder("localhost", 1883L);
+            builder.withOfflineQueueSpillPath(spillFile.getAbsolutePath());
+            try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+                for (int i = 0; i < 3; ++i) {
+                    client.publish(new PublishPacketBuilder().withTopic(testTopic).withQOS(QOS.AT_LEAST_ONCE).withPayload(("Hello World " + i).getBytes()).build());
+                }
+                assertEquals(3, client.getExtendedStatistics().getOfflineQueueMessages());
+            }
+
+            builder.withOfflineQueueMaxMessages(2L);
+            builder.withOfflineQueueOverflowPolicy(OfflineQueueOverflowPolicy.DROP_OLDEST);
+            try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+                Mqtt5ClientExtendedStatistics recovered = client.getExtendedStatistics();
+                assertEquals(2, recovered.getOfflineQueueMessages());
+                assertEquals(1, recovered.getOfflineQueueDropped());
+            }
+
+            /* the dropped record was marked in the file, so a client without limits doesn't bring it back */
+            builder.withOfflineQueueMaxMessages(null);
+            try (Mqtt5Client client = new Mqtt5Client(builder.build())) {
+                assertEquals(2, client.getExtendedStatistics().getOfflineQueueMessages());
+            }
+
+        } catch (Exception ex) {
+            fail(ex.getMessage());
+        } finally {
+            if (spillFile != null) {
+                spillFile.delete();
+            }
+        }
+    }
 }
@@ -0,0 +1,205 @@
+/**
+ * Copyright Amazon.com, Inc. or its affiliates. All Rights Reserved.
+ * SPDX-License-Identifier: Apache-2.0.
+ */
+package software.amazon.awssdk.crt.test;
+
+import org.junit.After;
+import org.junit.Assert;
+import org.junit.Assume;
+import org.junit.Test;
+import software.amazon.awssdk.crt.CRT;
+import software.amazon.awssdk.crt.CrtResource;
+import software.amazon.awssdk.crt.Log;
+import software.amazon.awssdk.crt.auth.credentials.StaticCredentialsProvider;
+import software.amazon.awssdk.crt.io.ClientBootstrap;
+import software.amazon.awssdk.crt.io.EventLoopGroup;
+import software.amazon.awssdk.crt.io.HostResolver;
+import software.amazon.awssdk.crt.s3.S3Client;
+import software.amazon.awssdk.crt.s3.S3ClientOptions;
+import software.amazon.awssdk.crt.s3.S3PartBuffer;
+
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.function.BooleanSupplier;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/* Memory accounting and sampling are switched on for the test run by system properties in the pom */
+public class NativeMemoryTest extends CrtTestFixture {
+
+    static final String REGION = "us-west-2";
+
+    public NativeMemoryTest() {}
+
+    private final List<Log.LogRecord> records = Collections.synchronizedList(new ArrayList<>());
+
+    @After
+    public void shutdownAsyncLogging() {
+        Log.shutdownLogging();
+    }
+
+    private static boolean memoryAccountingEnabled() {
+        return System.getProperty("aws.crt.memory.accounting") != null || memorySamplingInterval() > 0;
+    }
+
+    private static long memorySamplingInterval() {
+        try {
+            return Long.parseLong(System.getProperty("aws.crt.memory.sampling"));
+        } catch (Exception ex) {
+            return 0;
+        }
+    }
+
+    private static boolean memoryTracingEnabled() {
+        try {
+            return Integer.parseInt(System.getProperty("aws.crt.memory.tracing")) > 0;
+        } catch (Exception ex) {
+            return false;
+        }
+    }
+
+    /* the part buffer pool allocates each buffer natively the first time it is acquired */
+    private static S3Client createClientWithPartBuffers(long partSize, int maxPartBuffers) {
+        try (EventLoopGroup elg = new EventLoopGroup(1);
+                HostResolver hostResolver = new HostResolver(elg);
+                ClientBootstrap clientBootstrap = new ClientBootstrap(elg, hostResolver);
+                StaticCredentialsProvider credentialsProvider = new StaticCredentialsProvider.StaticCredentialsProviderBuilder()
+                        .withAccessKeyId("access".getBytes(StandardCharsets.UTF_8))
+                        .withSecretAccessKey("secret".getBytes(StandardCharsets.UTF_8)).build()) {
+            /* nothing is sent, so the credentials are never used */
+            S3ClientOptions options = new S3ClientOptions().withRegion(REGION).withClientBootstrap(clientBootstrap)
+                    .withCredentialsProvider(credentialsProvider).withPartSize(partSize)
+                    .withMaxPartBuffers(maxPartBuffers);
+            return new S3Client(options);
+        }
+    }
+
+    /* native resources finish shutting down on other threads, so wait for the numbers to settle */
+    private static void waitUntil(BooleanSupplier settled) throws InterruptedException {
+        for (int i = 0; i < 100 && !settled.getAsBoolean(); ++i) {
+            Thread.sleep(100);
+        }
+    }
+
+    @Test
+    public void testNativeMemoryRisesAndFallsWithResource() throws Exception {
+        Assume.assumeTrue(memoryAccountingEnabled() || memoryTracingEnabled());
+
+        final long partSize = 1024 * 1024;
+        final int partBufferCount = 4;
+
+        CrtResource.waitForNoResources();
+        long baselineTraced = CRT.nativeMemory();
+        long baselineBytes = CRT.nativeMemory(CRT.NativeMemorySubsystem.S3);
+        long baselineAllocations = CRT.nativeAllocations(CRT.NativeMemorySubsystem.S3);
+
+        try (S3Client client = createClientWithPartBuffers(partSize, partBufferCount)) {
+            List<S3PartBuffer> partBuffers = new ArrayList<>();
+            try {
+                for (int i = 0; i < partBufferCount; ++i) {
+                    partBuffers.add(client.acquirePartBuffer());
+                }
+
+                if (memoryTracingEnabled()) {
+                    Assert.assertTrue(CRT.nativeMemory() >= baselineTraced + partSize * partBufferCount);
+                }
+                if (memoryAccountingEnabled()) {
+                    Assert.assertTrue(CRT.nativeMemory(CRT.NativeMemorySubsystem.S3)
+                            >= baselineBytes + partSize * partBufferCount);
+                    Assert.assertTrue(CRT.nativeAllocations(CRT.NativeMemorySubsystem.S3)
+                            >= baselineAllocations + partBufferCount);
+                }
+            } finally {
+                for (S3PartBuffer partBuffer : partBuffers) {
+                    partBuffer.close();
+                }
+            }
+        }
+
+        CrtResource.waitForNoResources();
+        if (memoryAccountingEnabled()) {
+            waitUntil(() -> CRT.nativeMemory(CRT.NativeMemorySubsystem.S3) == baselineBytes
+                    && CRT.nativeAllocations(CRT.NativeMemorySubsystem.S3) == baselineAllocations);
+            Assert.assertEquals(baselineBytes, CRT.nativeMemory(CRT.NativeMemorySubsystem.S3));
+            Assert.assertEquals(baselineAllocations, CRT.nativeAllocations(CRT.NativeMemorySubsystem.S3));
+        }
+        if (memoryTracingEnabled()) {
+            waitUntil(() -> CRT.nativeMemory() == baselineTraced);
+            Assert.assertEquals(baselineTraced, CRT.nativeMemory());
+        }
+    }
+
+    @Test
+    public void testSampledNativeMemoryEstimatesAllocatedVolume() throws Exception {
+        final long interval = memorySamplingInterval();
+        Assume.assumeTrue(interval > 0);
+
+        /* small enough that each block is sampled with a probability under 1 and stands for a whole interval */
+        final long partSize = interval / 4;
+        final int partBufferCount = 256;
+        final long allocated = partSize * partBufferCount;
+        /* the distance between samples varies by up to half an interval, so about 64 samples land within a few % */
+        final double tolerance = 0.25;
+
+        Log.shutdownLogging();
+        Log.initAsyncLoggingToSink(Log.LogLevel.Info, batch -> records.addAll(batch),
+                new Log.AsyncLoggingOptions().withQueueCapacity(10000));
+
+        long estimatedDuring;
+        try (S3Client client = createClientWithPartBuffers(partSize, partBufferCount)) {
+            long baseline = CRT.sampledNativeMemory();
+            List<S3PartBuffer> partBuffers = new ArrayList<>();
+            try {
+                for (int i = 0; i < partBufferCount; ++i) {
+                    partBuffers.add(client.acquirePartBuffer());
+                }
+
+                estimatedDuring = CRT.sampledNativeMemory();
+                long estimated = estimatedDuring - baseline;
+                Assert.assertTrue("estimated " + estimated + " of " + allocated,
+                        Math.abs(estimated - allocated) <= allocated * tolerance);
+
+                CRT.dumpNativeMemorySamples();
+            } finally {
+                for (S3PartBuffer partBuffer : partBuffers) {
+                    partBuffer.close();
+                }
+            }
+        }
+
+        CrtResource.waitForNoResources();
+        long freedEstimate = estimatedDuring - CRT.sampledNativeMemory();
+        Assert.assertTrue("released " + freedEstimate + " of " + allocated,
+                Math.abs(freedEstimate - allocated) <= allocated * tolerance);
+
+        Log.shutdownLogging();
+
+        Pattern summary = Pattern.compile("Sampled native memory: (\\d+) live samples, about (\\d+) bytes live, .*");
+        Pattern stack = Pattern.compile("About (\\d+) bytes \\((\\d+) samples\\) allocated by ([\\w-]+) from:");
+        long summaryBytes = -1;
+        long biggestS3Stack = 0;
+        synchronized (records) {
+            for (Log.LogRecord record : records) {
+                if (record.getSubject() != Log.LogSubject.JavaCrtGeneral.getValue()) {
+                    continue;
+                }
+                Matcher summaryMatcher = summary.matcher(record.getMessage());
+                if (summaryMatcher.matches()) {
+                    summaryBytes = Long.parseLong(summaryMatcher.group(2));
+                }
+                Matcher stackMatcher = stack.matcher(record.getMessage());
+                if (stackMatcher.matches() && stackMatcher.group(3).equals("s3")) {
+                    biggestS3Stack = Math.max(biggestS3Stack, Long.parseLong(stackMatcher.group(1)));
+                }
+            }
+        }
+
+        Assert.assertTrue("dump reported " + summaryBytes, summaryBytes >= allocated * (1 - tolerance));
+        /* every part buffer was allocated from the same place, so they share one stack */
+        Assert.assertTrue("biggest S3 stack " + biggestS3Stack + " of " + allocated,
+                Math.abs(biggestS3Stack - allocated) <= allocated * tolerance);
+    }
+}
@@ -15,6 +15,7 @@ import software.amazon.awssdk.crt.io.*;
 import software.amazon.awssdk.crt.s3.*;
 import software.amazon.awssdk.crt.s3.S3MetaRequestOptions.MetaRequestType;
 import software.amazon.awssdk.crt.s3.ChecksumAlgorithm;
+import software.amazon.awssdk.crt.checksums.CRC32C;
 import software.amazon.awssdk.crt.s3.ResumeToken;
 import software.amazon.awssdk.crt.s3.ChecksumConfig.ChecksumLocation;
 import software.amazon.awssdk.crt.utils.ByteBufferUtils;
@@ -26,15 +27,19 @@ import java.net.URI;
 import java.nio.BufferOverflowException;
 import java.nio.ByteBuffer;
 import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
 import java.time.Clock;
 import java.time.Duration;
 import java.time.Instant;
 import java.time.temporal.ChronoUnit;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.BitSet;
 import java.util.LinkedList;
 import java.util.List;
 import java.util.concurrent.*;
+import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicInteger;
 import java.util.concurrent.atomic.AtomicLong;
 import java.util.concurrent.atomic.AtomicReference;
@@ -226,6 +231,545 @@ public class S3ClientTest extends CrtTestFixture {
         }
     }
 
+    @Test
+    public void testS3GetZeroCopyResponseBody() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION);
+        try (S3Client client = createS3Client(clientOptions)) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            AtomicLong bodyBytesReceived = new AtomicLong(0);
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public int onResponseBody(ByteBuffer bodyBytesIn, long objectRangeStart, long objectRangeEnd) {
+                    Assert.assertTrue(bodyBytesIn.isDirect());
+                    Assert.assertTrue(bodyBytesIn.isReadOnly());
+                    Assert.assertEquals(objectRangeEnd - objectRangeStart, bodyBytesIn.remaining());
+                    bodyBytesReceived.addAndGet(bodyBytesIn.remaining());
+                    return 0;
+                }
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withZeroCopyResponseBody(true);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+                Assert.assertEquals(1024 * 1024, bodyBytesReceived.get());
+            }
+        } catch (InterruptedException | ExecutionException ex) {
+            Assert.fail(ex.getMessage());
+        }
+    }
+
+    @Test
+    public void testS3GetToResponseFile() throws Exception {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        Path responseFile = Files.createTempFile("s3_response_file_test", ".txt");
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION);
+        try (S3Client client = createS3Client(clientOptions)) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            AtomicLong bytesTransferred = new AtomicLong(0);
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public int onResponseBody(ByteBuffer bodyBytesIn, long objectRangeStart, long objectRangeEnd) {
+                    onFinishedFuture.completeExceptionally(
+                            new IllegalStateException("onResponseBody must not be invoked when writing to a file"));
+                    return 0;
+                }
+
+                @Override
+                public void onProgress(final S3MetaRequestProgress progress) {
+                    bytesTransferred.addAndGet(progress.getBytesTransferred());
+                }
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withResponseFilePath(responseFile);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+            }
+            Assert.assertEquals(1024 * 1024, bytesTransferred.get());
+            Assert.assertEquals(1024 * 1024, Files.size(responseFile));
+        } finally {
+            Files.deleteIfExists(responseFile);
+        }
+    }
+
+    @Test
+    public void testS3GetCoalescedProgress() throws Exception {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        Path responseFile = Files.createTempFile("s3_coalesced_progress_test", ".txt");
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION)
+                .withPartSize(256 * 1024);
+        try (S3Client client = createS3Client(clientOptions)) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            AtomicInteger progressCount = new AtomicInteger(0);
+            AtomicLong bytesTransferred = new AtomicLong(0);
+            AtomicReference<S3MetaRequestProgress> firstProgress = new AtomicReference<>();
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public void onProgress(final S3MetaRequestProgress progress) {
+                    firstProgress.compareAndSet(null, progress);
+                    if (firstProgress.get() != progress) {
+                        onFinishedFuture.completeExceptionally(
+                                new IllegalStateException("progress object was not reused"));
+                    }
+                    progressCount.incrementAndGet();
+                    bytesTransferred.addAndGet(progress.getBytesTransferred());
+                }
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null);
+
+            /* the interval is never reached, so everything is reported in one update when the request finishes */
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withResponseFilePath(responseFile)
+                    .withProgressIntervalBytes(Long.MAX_VALUE)
+                    .withReuseProgressObject(true);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+            }
+            Assert.assertEquals(1, progressCount.get());
+            Assert.assertEquals(1024 * 1024, bytesTransferred.get());
+        } finally {
+            Files.deleteIfExists(responseFile);
+        }
+    }
+
+    @Test
+    public void testS3GetProgressReportedBeforeFinished() throws Exception {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION)
+                .withPartSize(256 * 1024);
+        try (S3Client client = createS3Client(clientOptions)) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            AtomicBoolean finished = new AtomicBoolean(false);
+            AtomicBoolean progressAfterFinished = new AtomicBoolean(false);
+            AtomicLong bytesTransferred = new AtomicLong(0);
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public void onProgress(final S3MetaRequestProgress progress) {
+                    if (finished.get()) {
+                        progressAfterFinished.set(true);
+                    }
+                    bytesTransferred.addAndGet(progress.getBytesTransferred());
+                    /* a slow handler keeps an upcall in flight while other parts, and the finish, come in */
+                    try {
+                        Thread.sleep(50);
+                    } catch (InterruptedException ex) {
+                        Thread.currentThread().interrupt();
+                    }
+                }
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    finished.set(true);
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withProgressIntervalBytes(1);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+            }
+            Assert.assertFalse(progressAfterFinished.get());
+            Assert.assertEquals(1024 * 1024, bytesTransferred.get());
+        }
+    }
+
+    @Test
+    public void testS3GetMetrics() throws Exception {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION)
+                .withPartSize(256 * 1024);
+        try (S3Client client = createS3Client(clientOptions)) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            AtomicReference<S3MetaRequestMetrics> metricsReference = new AtomicReference<>();
+            CRC32C expectedChecksum = new CRC32C();
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public int onResponseBody(ByteBuffer bodyBytesIn, long objectRangeStart, long objectRangeEnd) {
+                    byte[] bytes = new byte[bodyBytesIn.remaining()];
+                    bodyBytesIn.get(bytes);
+                    expectedChecksum.update(bytes, 0, bytes.length);
+                    return 0;
+                }
+
+                @Override
+                public void onMetrics(final S3MetaRequestMetrics metrics) {
+                    metricsReference.set(metrics);
+                }
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withMetricsEnabled(true)
+                    .withResponseBodyChecksumAlgorithm(ChecksumAlgorithm.CRC32C);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+            }
+
+            S3MetaRequestMetrics metrics = metricsReference.get();
+            Assert.assertNotNull(metrics);
+            Assert.assertEquals(ChecksumAlgorithm.CRC32C, metrics.getResponseBodyChecksumAlgorithm());
+            Assert.assertEquals(expectedChecksum.getValue(), metrics.getResponseBodyChecksum());
+            Assert.assertTrue(metrics.getChecksumNs() > 0);
+            Assert.assertEquals(1024 * 1024, metrics.getBytesReceived());
+            Assert.assertTrue(metrics.getTimeToResponseHeadersNs() >= 0);
+            Assert.assertTrue(metrics.getTimeToFirstBodyByteNs() <= metrics.getDurationNs());
+            long partBytes = 0;
+            for (int i = 0; i < metrics.getPartCount(); ++i) {
+                partBytes += metrics.getPartSize(i);
+                Assert.assertTrue(metrics.getPartArrivalNs(i) <= metrics.getDurationNs());
+            }
+            Assert.assertEquals(1024 * 1024, partBytes);
+        }
+    }
+
+    @Test
+    public void testS3ClientStatistics() throws Exception {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION);
+        try (S3Client client = createS3Client(clientOptions)) {
+            Assert.assertEquals(0, client.getStatistics().getTotalMetaRequests());
+
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null);
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+            }
+
+            S3ClientStatistics statistics = client.getStatistics();
+            Assert.assertEquals(1, statistics.getTotalMetaRequests());
+            Assert.assertEquals(0, statistics.getActiveMetaRequests());
+            Assert.assertEquals(1024 * 1024, statistics.getResponseBodyBytesReceived());
+            Assert.assertEquals(0, statistics.getPartBufferBytesAllocated());
+        }
+    }
+
+    private S3MetaRequestResponseHandler createTestGetToFileHandler(CompletableFuture<Integer> onFinishedFuture) {
+        return new S3MetaRequestResponseHandler() {
+            @Override
+            public void onFinished(S3FinishedResponseContext context) {
+                if (context.getErrorCode() != 0) {
+                    onFinishedFuture.completeExceptionally(
+                            new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                    return;
+                }
+                onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+            }
+        };
+    }
+
+    @Test
+    public void testS3GetResumeFromToken() throws Exception {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        final int objectSize = 1024 * 1024;
+        final int partSize = 256 * 1024;
+        Path fullFile = Files.createTempFile("s3_resume_full", ".txt");
+        Path resumedFile = Files.createTempFile("s3_resume_partial", ".txt");
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION);
+        try (S3Client client = createS3Client(clientOptions)) {
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+
+            CompletableFuture<Integer> onFullFinishedFuture = new CompletableFuture<>();
+            S3MetaRequestOptions fullOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT)
+                    .withHttpRequest(new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null))
+                    .withResponseHandler(createTestGetToFileHandler(onFullFinishedFuture))
+                    .withResponseFilePath(fullFile);
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(fullOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFullFinishedFuture.get());
+            }
+            byte[] expected = Files.readAllBytes(fullFile);
+            Assert.assertEquals(objectSize, expected.length);
+
+            /* pretend the first two parts made it to disk before the download was interrupted */
+            Files.write(resumedFile, Arrays.copyOf(expected, 2 * partSize));
+            BitSet completedParts = new BitSet();
+            completedParts.set(0, 2);
+            ResumeToken resumeToken = new ResumeToken.GetResumeTokenBuilder()
+                    .withPartSize(partSize)
+                    .withTotalNumParts(objectSize / partSize)
+                    .withNumPartsCompleted(2)
+                    .withObjectSize(objectSize)
+                    .withCompletedParts(completedParts)
+                    .build();
+            Assert.assertEquals(completedParts, resumeToken.getCompletedParts());
+
+            CompletableFuture<Integer> onResumeFinishedFuture = new CompletableFuture<>();
+            S3MetaRequestOptions resumeOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT)
+                    .withHttpRequest(new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null))
+                    .withResponseHandler(createTestGetToFileHandler(onResumeFinishedFuture))
+                    .withResponseFilePath(resumedFile)
+                    .withResumeToken(resumeToken);
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(resumeOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onResumeFinishedFuture.get());
+            }
+            Assert.assertArrayEquals(expected, Files.readAllBytes(resumedFile));
+        } finally {
+            Files.deleteIfExists(fullFile);
+            Files.deleteIfExists(resumedFile);
+        }
+    }
+
+    @Test
+    public void testS3GetResumeFromTokenWithinRange() throws Exception {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        final int partSize = 256 * 1024;
+        final int rangeStart = 1000;
+        final int rangeSize = 2 * partSize;
+        final String range = "bytes=" + rangeStart + "-" + (rangeStart + rangeSize - 1);
+        Path fullFile = Files.createTempFile("s3_resume_range_full", ".txt");
+        Path resumedFile = Files.createTempFile("s3_resume_range_partial", ".txt");
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION);
+        try (S3Client client = createS3Client(clientOptions)) {
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+
+            CompletableFuture<Integer> onFullFinishedFuture = new CompletableFuture<>();
+            S3MetaRequestOptions fullOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT)
+                    .withHttpRequest(new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null))
+                    .withResponseHandler(createTestGetToFileHandler(onFullFinishedFuture))
+                    .withResponseFilePath(fullFile);
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(fullOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFullFinishedFuture.get());
+            }
+            byte[] expected = Arrays.copyOfRange(Files.readAllBytes(fullFile), rangeStart, rangeStart + rangeSize);
+
+            /* the token's offsets are relative to the range, the first part of it is already on disk */
+            Files.write(resumedFile, Arrays.copyOf(expected, partSize));
+            BitSet completedParts = new BitSet();
+            completedParts.set(0);
+            ResumeToken resumeToken = new ResumeToken.GetResumeTokenBuilder()
+                    .withPartSize(partSize)
+                    .withTotalNumParts(2)
+                    .withNumPartsCompleted(1)
+                    .withObjectSize(rangeSize)
+                    .withCompletedParts(completedParts)
+                    .build();
+
+            HttpHeader[] rangeHeaders = { new HttpHeader("Host", ENDPOINT), new HttpHeader("Range", range) };
+            CompletableFuture<Integer> onResumeFinishedFuture = new CompletableFuture<>();
+            S3MetaRequestOptions resumeOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT)
+                    .withHttpRequest(new HttpRequest("GET", "/get_object_test_1MB.txt", rangeHeaders, null))
+                    .withResponseHandler(createTestGetToFileHandler(onResumeFinishedFuture))
+                    .withResponseFilePath(resumedFile)
+                    .withResumeToken(resumeToken);
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(resumeOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onResumeFinishedFuture.get());
+            }
+            Assert.assertArrayEquals(expected, Files.readAllBytes(resumedFile));
+        } finally {
+            Files.deleteIfExists(fullFile);
+            Files.deleteIfExists(resumedFile);
+        }
+    }
+
+    @Test
+    public void testS3GetResumeRejectsMultipleRanges() throws Exception {
+        final int partSize = 256 * 1024;
+        Path resumedFile = Files.createTempFile("s3_resume_multi_range", ".txt");
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION);
+        try (S3Client client = createS3Client(clientOptions)) {
+            BitSet completedParts = new BitSet();
+            completedParts.set(0);
+            ResumeToken resumeToken = new ResumeToken.GetResumeTokenBuilder()
+                    .withPartSize(partSize)
+                    .withTotalNumParts(2)
+                    .withNumPartsCompleted(1)
+                    .withObjectSize(2 * partSize)
+                    .withCompletedParts(completedParts)
+                    .build();
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT), new HttpHeader("Range", "bytes=0-99,200-299") };
+            S3MetaRequestOptions resumeOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT)
+                    .withHttpRequest(new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null))
+                    .withResponseHandler(createTestGetToFileHandler(new CompletableFuture<>()))
+                    .withResponseFilePath(resumedFile)
+                    .withResumeToken(resumeToken);
+            Assert.assertThrows(IllegalArgumentException.class, () -> client.makeMetaRequest(resumeOptions));
+        } finally {
+            Files.deleteIfExists(resumedFile);
+        }
+    }
+
+    @Test
+    public void testS3RangedGetBatch() throws Exception {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        Path fullFile = Files.createTempFile("s3_ranged_get_batch_full", ".txt");
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION);
+        try (S3Client client = createS3Client(clientOptions)) {
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+
+            CompletableFuture<Integer> onFullFinishedFuture = new CompletableFuture<>();
+            S3MetaRequestOptions fullOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.GET_OBJECT)
+                    .withHttpRequest(new HttpRequest("GET", "/get_object_test_1MB.txt", headers, null))
+                    .withResponseHandler(createTestGetToFileHandler(onFullFinishedFuture))
+                    .withResponseFilePath(fullFile);
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(fullOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFullFinishedFuture.get());
+            }
+            byte[] expected = Files.readAllBytes(fullFile);
+
+            /* the first two ranges are adjacent and share a GET, the third is far enough away to get its own */
+            List<S3RangedGet> rangedGets = new ArrayList<>();
+            rangedGets.add(new S3RangedGet("get_object_test_1MB.txt", 500 * 1024, ByteBuffer.allocateDirect(1000)));
+            rangedGets.add(new S3RangedGet("get_object_test_1MB.txt", 0, ByteBuffer.allocateDirect(100)));
+            rangedGets.add(new S3RangedGet("get_object_test_1MB.txt", 100, ByteBuffer.allocateDirect(100)));
+
+            S3RangedGetBatchOptions batchOptions = new S3RangedGetBatchOptions()
+                    .withRangedGets(rangedGets)
+                    .withHeaders(headers);
+            try (S3RangedGetBatch batch = client.makeRangedGetBatch(batchOptions)) {
+                Assert.assertEquals(2, batch.getRequestCount());
+                batch.getFuture().get();
+            }
+
+            for (S3RangedGet rangedGet : rangedGets) {
+                ByteBuffer destination = rangedGet.getDestination();
+                Assert.assertEquals(0, destination.remaining());
+                destination.flip();
+                byte[] actual = new byte[destination.remaining()];
+                destination.get(actual);
+                int start = (int) rangedGet.getRangeStart();
+                Assert.assertArrayEquals(Arrays.copyOfRange(expected, start, start + actual.length), actual);
+            }
+        } finally {
+            Files.deleteIfExists(fullFile);
+        }
+    }
+
+    @Test
+    public void testS3RangedGetBatchRejectsEmptyRange() {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION);
+        try (S3Client client = createS3Client(clientOptions)) {
+            ByteBuffer destination = ByteBuffer.allocateDirect(100);
+            S3RangedGet rangedGet = new S3RangedGet("get_object_test_1MB.txt", 100, destination);
+            /* drained after the ranged get was made, which would ask for bytes=100-99 */
+            destination.position(destination.limit());
+
+            S3RangedGetBatchOptions batchOptions = new S3RangedGetBatchOptions()
+                    .withRangedGets(Arrays.asList(rangedGet))
+                    .withHeaders(new HttpHeader[] { new HttpHeader("Host", ENDPOINT) });
+            Assert.assertThrows(IllegalArgumentException.class, () -> client.makeRangedGetBatch(batchOptions));
+        }
+    }
+
     /**
      * Test read-backpressure by repeatedly:
      * - letting the download stall
@@ -502,6 +1046,169 @@ public class S3ClientTest extends CrtTestFixture {
         }
     }
 
+    @Test
+    public void testS3PutFromRequestFile() throws Exception {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        Path requestFile = Files.createTempFile("s3_request_file_test", ".txt");
+        Files.write(requestFile, createTestPayload(10 * 1024 * 1024));
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION);
+        try (S3Client client = createS3Client(clientOptions)) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            /* Content-Length is filled in natively from the file size */
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT) };
+            HttpRequest httpRequest = new HttpRequest("PUT", "/put_object_test_10MB.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.PUT_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withRequestFilePath(requestFile);
+
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+            }
+        } finally {
+            Files.deleteIfExists(requestFile);
+        }
+    }
+
+    @Test
+    public void testS3PartBufferPoolExhaustion() {
+        skipIfNetworkUnavailable();
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION)
+                .withPartSize(5 * 1024 * 1024).withMaxPartBuffers(2);
+        try (S3Client client = createS3Client(clientOptions)) {
+            try (S3PartBuffer first = client.acquirePartBuffer(); S3PartBuffer second = client.acquirePartBuffer()) {
+                Assert.assertNotNull(first);
+                Assert.assertNotNull(second);
+                Assert.assertTrue(first.getBuffer().isDirect());
+                Assert.assertEquals(5 * 1024 * 1024, first.getBuffer().capacity());
+                Assert.assertNull(client.acquirePartBuffer());
+                Assert.assertEquals(2 * 5 * 1024 * 1024, client.getStatistics().getPartBufferBytesInUse());
+            }
+            Assert.assertEquals(0, client.getStatistics().getPartBufferBytesInUse());
+            Assert.assertEquals(2 * 5 * 1024 * 1024, client.getStatistics().getPartBufferBytesAllocated());
+
+            /* closing unsubmitted buffers returns them to the pool */
+            try (S3PartBuffer reacquired = client.acquirePartBuffer()) {
+                Assert.assertNotNull(reacquired);
+            }
+        }
+    }
+
+    @Test
+    public void testS3PutFromPartBuffers() throws Exception {
+        skipIfNetworkUnavailable();
+        Assume.assumeTrue(hasAwsCredentials());
+
+        final int partSize = 5 * 1024 * 1024;
+        final int partCount = 4;
+        final int maxPartBuffers = 2;
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION)
+                .withPartSize(partSize).withMaxPartBuffers(maxPartBuffers);
+        try (S3Client client = createS3Client(clientOptions); S3PartBufferQueue queue = new S3PartBufferQueue()) {
+            CompletableFuture<Integer> onFinishedFuture = new CompletableFuture<>();
+            S3MetaRequestResponseHandler responseHandler = new S3MetaRequestResponseHandler() {
+
+                @Override
+                public void onFinished(S3FinishedResponseContext context) {
+                    if (context.getErrorCode() != 0) {
+                        onFinishedFuture.completeExceptionally(
+                                new CrtS3RuntimeException(context.getErrorCode(), context.getResponseStatus(), context.getErrorPayload()));
+                        return;
+                    }
+                    onFinishedFuture.complete(Integer.valueOf(context.getErrorCode()));
+                }
+            };
+
+            HttpHeader[] headers = { new HttpHeader("Host", ENDPOINT),
+                    new HttpHeader("Content-Length", Integer.valueOf(partSize * partCount).toString()) };
+            HttpRequest httpRequest = new HttpRequest("PUT", "/put_object_test_20MB.txt", headers, null);
+
+            S3MetaRequestOptions metaRequestOptions = new S3MetaRequestOptions()
+                    .withMetaRequestType(MetaRequestType.PUT_OBJECT).withHttpRequest(httpRequest)
+                    .withResponseHandler(responseHandler)
+                    .withRequestPartBufferQueue(queue);
+
+            byte[] payload = createTestPayload(partSize);
+            /* the body is twice the size of the pool, so buffers only free up as earlier parts are sent */
+            try (S3MetaRequest metaRequest = client.makeMetaRequest(metaRequestOptions)) {
+                for (int partNumber = 1; partNumber <= partCount; ++partNumber) {
+                    S3PartBuffer partBuffer = client.acquirePartBuffer();
+                    while (partBuffer == null) {
+                        Assert.assertFalse(onFinishedFuture.isDone());
+                        Thread.sleep(10);
+                        partBuffer = client.acquirePartBuffer();
+                    }
+                    try {
+                        partBuffer.getBuffer().put(payload);
+                        queue.submitPart(partNumber, partBuffer);
+                    } finally {
+                        partBuffer.close();
+                    }
+                }
+                queue.complete();
+
+                Assert.assertEquals(Integer.valueOf(0), onFinishedFuture.get());
+                Assert.assertEquals(maxPartBuffers * partSize, client.getStatistics().getPartBufferBytesAllocated());
+            }
+        }
+    }
+
+    @Test
+    public void testS3PartBufferQueueRejectsGapsAndIncompleteUploads() {
+        S3ClientOptions clientOptions = new S3ClientOptions().withEndpoint(ENDPOINT).withRegion(REGION)
+                .withPartSize(5 * 1024 * 1024).withMaxPartBuffers(3);
+        try (S3Client client = createS3Client(clientOptions); S3PartBufferQueue queue = new S3PartBufferQueue()) {
+            try (S3PartBuffer partBuffer = client.acquirePartBuffer()) {
+                partBuffer.getBuffer().put((byte) 1);
+                queue.submitPart(2, partBuffer);
+            }
+
+            try (S3PartBuffer partBuffer = client.acquirePartBuffer()) {
+                partBuffer.getBuffer().put((byte) 1);
+                /* already submitted */
+                Assert.assertThrows(IllegalArgumentException.class, () -> queue.submitPart(2, partBuffer));
+                queue.submitPart(3, partBuffer);
+            }
+
+            try (S3PartBuffer partBuffer = client.acquirePartBuffer()) {
+                partBuffer.getBuffer().put((byte) 1);
+                /* parts 2 and 3 wait on part 1, queueing part 4 as well would leave no buffer for part 1 */
+                Assert.assertThrows(IllegalArgumentException.class, () -> queue.submitPart(4, partBuffer));
+            }
+
+            /* part 1 is missing */
+            Assert.assertThrows(IllegalArgumentException.class, queue::complete);
+
+            try (S3PartBuffer partBuffer = client.acquirePartBuffer()) {
+                Assert.assertNotNull(partBuffer);
+                partBuffer.getBuffer().put((byte) 1);
+                queue.submitPart(1, partBuffer);
+            }
+            queue.complete();
+
+            try (S3PartBuffer partBuffer = client.acquirePartBuffer()) {
+                partBuffer.getBuffer().put((byte) 1);
+                Assert.assertThrows(IllegalArgumentException.class, () -> queue.submitPart(4, partBuffer));
+            }
+        }
+    }
+
     private S3MetaRequestResponseHandler createTestPutPauseResumeHandler(CompletableFuture<Integer> onFinishedFuture,
         CompletableFuture<Void> onProgressFuture) {
         return new S3MetaRequestResponseHandler() {
@@ -635,6 +1342,22 @@ public class S3ClientTest extends CrtTestFixture {
         }
     }
 
+    @Test
+    public void testChecksumConfigRejectsCrc64Nvme() {
+        ChecksumConfig config = new ChecksumConfig();
+        Assert.assertThrows(IllegalArgumentException.class,
+                () -> config.withChecksumAlgorithm(ChecksumAlgorithm.CRC64NVME));
+        Assert.assertThrows(IllegalArgumentException.class, () -> config
+                .withValidateChecksumAlgorithmList(Arrays.asList(ChecksumAlgorithm.CRC32, ChecksumAlgorithm.CRC64NVME)));
+
+        /* the list is copied, so adding CRC64NVME to it afterwards doesn't get past the check */
+        List<ChecksumAlgorithm> algorithms = new ArrayList<>(Arrays.asList(ChecksumAlgorithm.CRC32));
+        config.withValidateChecksumAlgorithmList(algorithms);
+        algorithms.add(ChecksumAlgorithm.CRC64NVME);
+        Assert.assertEquals(Arrays.asList(ChecksumAlgorithm.CRC32), config.getValidateChecksumAlgorithmList());
+        Assert.assertEquals(ChecksumAlgorithm.NONE, config.getChecksumAlgorithm());
+    }
+
     @Test
     public void testS3PutTrailerChecksums() {
         skipIfNetworkUnavailable();
@@ -0,0 +1,169 @@
+package software.amazon.awssdk.crt.test;
+
+import org.junit.Test;
+import software.amazon.awssdk.crt.CrtRuntimeException;
+import software.amazon.awssdk.crt.http.HttpClientConnection;
+import software.amazon.awssdk.crt.http.HttpClientConnectionManager;
+import software.amazon.awssdk.crt.http.HttpClientConnectionManagerOptions;
+import software.amazon.awssdk.crt.http.HttpHeader;
+import software.amazon.awssdk.crt.http.HttpRequest;
+import software.amazon.awssdk.crt.http.HttpStream;
+import software.amazon.awssdk.crt.http.HttpStreamResponseHandler;
+import software.amazon.awssdk.crt.io.ClientBootstrap;
+import software.amazon.awssdk.crt.io.EventLoopGroup;
+import software.amazon.awssdk.crt.io.HostResolver;
+import software.amazon.awssdk.crt.io.ServerBootstrap;
+import software.amazon.awssdk.crt.io.SocketOptions;
+import software.amazon.awssdk.crt.s3.S3LoopbackServer;
+import software.amazon.awssdk.crt.s3.S3LoopbackServerMetrics;
+import software.amazon.awssdk.crt.s3.S3LoopbackServerOptions;
+
+import java.io.ByteArrayOutputStream;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.TimeUnit;
+
+import static org.junit.Assert.*;
+
+@SuppressWarnings("deprecation")
+public class S3LoopbackServerTest extends CrtTestFixture {
+    private static final long OBJECT_SIZE = 1024 * 1024;
+
+    public S3LoopbackServerTest() {}
+
+    private static class Response {
+        int status;
+        String contentRange;
+        byte[] body;
+    }
+
+    private Response get(S3LoopbackServer server, String range) throws Exception {
+        try (EventLoopGroup elGroup = new EventLoopGroup(1);
+             HostResolver resolver = new HostResolver(elGroup);
+             ClientBootstrap clientBootstrap = new ClientBootstrap(elGroup, resolver);
+             SocketOptions socketOptions = new SocketOptions()) {
+
+            HttpClientConnectionManagerOptions options = new HttpClientConnectionManagerOptions()
+                .withClientBootstrap(clientBootstrap)
+                .withSocketOptions(socketOptions)
+                .withUri(server.getUri());
+
+            try (HttpClientConnectionManager connectionManager = HttpClientConnectionManager.create(options)) {
+                HttpHeader host = new HttpHeader("Host", server.getHostHeader());
+                HttpHeader[] headers = range == null
+                    ? new HttpHeader[] { host }
+                    : new HttpHeader[] { host, new HttpHeader("Range", range) };
+                HttpRequest request = new HttpRequest("GET", "/bucket/key", headers, null);
+
+                Response response = new Response();
+                ByteArrayOutputStream body = new ByteArrayOutputStream();
+                CompletableFuture<Void> done = new CompletableFuture<>();
+                HttpStreamResponseHandler handler = new HttpStreamResponseHandler() {
+                    @Override
+                    public void onResponseHeaders(HttpStream stream, int responseStatusCode, int blockType,
+                                                  HttpHeader[] nextHeaders) {
+                        response.status = responseStatusCode;
+                        for (HttpHeader header : nextHeaders) {
+                            if (header.getName().equalsIgnoreCase("Content-Range")) {
+                                response.contentRange = header.getValue();
+                            }
+                        }
+                    }
+
+                    @Override
+                    public int onResponseBody(HttpStream stream, byte[] bodyBytesIn) {
+                        body.write(bodyBytesIn, 0, bodyBytesIn.length);
+                        return bodyBytesIn.length;
+                    }
+
+                    @Override
+                    public void onResponseComplete(HttpStream stream, int errorCode) {
+                        if (errorCode != 0) {
+                            done.completeExceptionally(new CrtRuntimeException(errorCode));
+                        } else {
+                            done.complete(null);
+                        }
+                    }
+                };
+
+                HttpClientConnection connection = connectionManager.acquireConnection().get(60, TimeUnit.SECONDS);
+                try (HttpStream stream = connection.makeRequest(request, handler)) {
+                    stream.activate();
+                    done.get(60, TimeUnit.SECONDS);
+                } finally {
+                    connectionManager.releaseConnection(connection);
+                }
+
+                response.body = body.toByteArray();
+                return response;
+            }
+        }
+    }
+
+    private S3LoopbackServer newServer(ServerBootstrap bootstrap, SocketOptions socketOptions, long latencyMillis) {
+        return new S3LoopbackServer(bootstrap, socketOptions, new S3LoopbackServerOptions()
+            .withObjectSize(OBJECT_SIZE)
+            .withResponseLatencyMillis(latencyMillis));
+    }
+
+    @Test
+    public void testRangedGet() throws Exception {
+        try (EventLoopGroup elGroup = new EventLoopGroup(1);
+             ServerBootstrap bootstrap = new ServerBootstrap(elGroup);
+             SocketOptions socketOptions = new SocketOptions()) {
+
+            S3LoopbackServer server = newServer(bootstrap, socketOptions, 0);
+            try {
+                assertTrue(server.getBoundPort() > 0);
+
+                Response whole = get(server, null);
+                assertEquals(200, whole.status);
+                assertEquals(OBJECT_SIZE, whole.body.length);
+
+                Response part = get(server, "bytes=1000-1999");
+                assertEquals(206, part.status);
+                assertEquals("bytes 1000-1999/" + OBJECT_SIZE, part.contentRange);
+                assertEquals(1000, part.body.length);
+                for (int i = 0; i < part.body.length; i++) {
+                    assertEquals((byte) (1000 + i), part.body[i]);
+                }
+
+                S3LoopbackServerMetrics metrics = server.getMetrics();
+                assertEquals(2, metrics.getGetRequests());
+                assertEquals(OBJECT_SIZE + 1000, metrics.getBytesSent());
+                assertEquals(0, metrics.getFailedRequests());
+
+                // a range that ends before it starts can't be satisfied
+                assertEquals(416, get(server, "bytes=1999-1000").status);
+            } finally {
+                server.close();
+                server.getShutdownCompleteFuture().get(60, TimeUnit.SECONDS);
+            }
+        }
+    }
+
+    @Test
+    public void testSimulatedLatency() throws Exception {
+        try (EventLoopGroup elGroup = new EventLoopGroup(1);
+             ServerBootstrap bootstrap = new ServerBootstrap(elGroup);
+             SocketOptions socketOptions = new SocketOptions()) {
+
+            S3LoopbackServer server = newServer(bootstrap, socketOptions, 100);
+            try {
+                Response part = get(server, "bytes=0-99");
+                assertEquals(206, part.status);
+
+                /* the server records the latency once its write completes, which can trail the client's read */
+                S3LoopbackServerMetrics metrics = server.getMetrics();
+                for (int i = 0; i < 100 && metrics.getRequestLatency().getCount() == 0; i++) {
+                    Thread.sleep(10);
+                    metrics = server.getMetrics();
+                }
+                assertEquals(1, metrics.getRequestLatency().getCount());
+                assertTrue(metrics.getRequestLatency().getValueAtPercentileMicros(100) >= 100000);
+            } finally {
+                server.close();
+                server.getShutdownCompleteFuture().get(60, TimeUnit.SECONDS);
+            }
+        }
+    }
+}
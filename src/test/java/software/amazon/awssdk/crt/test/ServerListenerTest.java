@@ -15,6 +15,7 @@ import java.nio.ByteBuffer;
 import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
 import java.util.List;
+import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.ExecutionException;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.TimeoutException;
@@ -452,4 +453,132 @@ public class ServerListenerTest extends CrtTestFixture {
 
         socketOptions.close();
     }
+
+    @Test
+    public void testContinuationMessageBatch() throws ExecutionException, InterruptedException, IOException, TimeoutException {
+        SocketOptions socketOptions = new SocketOptions();
+        socketOptions.connectTimeoutMs = 3000;
+        socketOptions.domain = SocketOptions.SocketDomain.IPv4;
+        socketOptions.type = SocketOptions.SocketType.STREAM;
+
+        EventLoopGroup elGroup = new EventLoopGroup(1);
+        ServerBootstrap bootstrap = new ServerBootstrap(elGroup);
+        final ServerConnection[] serverConnections = {null};
+        final CompletableFuture<Void> batchFlushed = new CompletableFuture<>();
+
+        final Lock lock = new ReentrantLock();
+        final Condition testSynchronizationCVar = lock.newCondition();
+
+        ServerListener listener = new ServerListener("127.0.0.1", (short)8044, socketOptions, null, bootstrap, new ServerListenerHandler() {
+
+            public ServerConnectionHandler onNewConnection(ServerConnection serverConnection, int errorCode) {
+                lock.lock();
+                serverConnections[0] = serverConnection;
+
+                ServerConnectionHandler connectionHandler = new ServerConnectionHandler(serverConnection) {
+
+                    @Override
+                    protected void onProtocolMessage(List<Header> headers, byte[] payload, MessageType messageType, int messageFlags) {
+                        connection.sendProtocolMessage(null, null, MessageType.ConnectAck, MessageFlags.ConnectionAccepted.getByteValue()).whenComplete((res,err) -> {
+                                    lock.lock();
+                                    testSynchronizationCVar.signal();
+                                    lock.unlock();
+                                }
+                        );
+                    }
+
+                    @Override
+                    protected ServerConnectionContinuationHandler onIncomingStream(ServerConnectionContinuation continuation, String operationName) {
+                        return new ServerConnectionContinuationHandler(continuation) {
+                            @Override
+                            protected void onContinuationClosed() {
+                                this.close();
+                            }
+
+                            @Override
+                            protected void onContinuationMessage(List<Header> headers, byte[] payload, MessageType messageType, int messageFlags) {
+                                MessageBatch batch = new MessageBatch();
+                                for (int i = 0; i < 3; ++i) {
+                                    batch.addMessage(null, ("{ \"frame\": " + i + " }").getBytes(StandardCharsets.UTF_8),
+                                            MessageType.ApplicationMessage, i == 2 ? MessageFlags.TerminateStream.getByteValue() : 0);
+                                }
+
+                                continuation.sendMessages(batch).whenComplete((res, ex) -> {
+                                    if (ex != null) {
+                                        batchFlushed.completeExceptionally(ex);
+                                    } else {
+                                        batchFlushed.complete(null);
+                                    }
+                                    connection.closeConnection(0);
+                                });
+                            }
+                        };
+                    }
+                };
+
+                testSynchronizationCVar.signal();
+                lock.unlock();
+                return connectionHandler;
+            }
+
+            public void onConnectionShutdown(ServerConnection serverConnection, int errorCode) {
+            }
+        });
+
+        Socket clientSocket = new Socket();
+        SocketAddress address = new InetSocketAddress("127.0.0.1", 8044);
+        lock.lock();
+        clientSocket.connect(address, 3000);
+        testSynchronizationCVar.await(1, TimeUnit.SECONDS);
+        assertNotNull(serverConnections[0]);
+
+        List<Header> messageHeaders = new ArrayList<>(3);
+        messageHeaders.add(Header.createHeader(":message-type", (int)MessageType.Connect.getEnumValue()));
+        messageHeaders.add(Header.createHeader(":message-flags", 0));
+        messageHeaders.add(Header.createHeader(":stream-id", 0));
+
+        Message connectMessage = new Message(messageHeaders, null);
+        ByteBuffer connectMessageBuf = connectMessage.getMessageBuffer();
+        byte[] toSend = new byte[connectMessageBuf.remaining()];
+        connectMessageBuf.get(toSend);
+        clientSocket.getOutputStream().write(toSend);
+        connectMessage.close();
+
+        testSynchronizationCVar.await(1, TimeUnit.SECONDS);
+        lock.unlock();
+
+        messageHeaders = new ArrayList<>(4);
+        messageHeaders.add(Header.createHeader(":message-type", (int)MessageType.ApplicationMessage.getEnumValue()));
+        messageHeaders.add(Header.createHeader(":message-flags", 0));
+        messageHeaders.add(Header.createHeader(":stream-id", 1));
+        messageHeaders.add(Header.createHeader("operation", "testOperation"));
+        Message continuationMessage = new Message(messageHeaders, "{}".getBytes(StandardCharsets.UTF_8));
+        ByteBuffer continuationMessageBuf = continuationMessage.getMessageBuffer();
+        toSend = new byte[continuationMessageBuf.remaining()];
+        continuationMessageBuf.get(toSend);
+        clientSocket.getOutputStream().write(toSend);
+        continuationMessage.close();
+
+        batchFlushed.get(5, TimeUnit.SECONDS);
+
+        /* the connect and the continuation message in, the connect ack and the whole batch out */
+        ServerMetrics metrics = listener.getMetrics();
+        assertEquals(1, metrics.getConnectionsAccepted());
+        assertEquals(2, metrics.getMessagesReceived());
+        assertEquals(2, metrics.getPayloadBytesReceived());
+        assertEquals(4, metrics.getMessagesFlushed());
+        assertEquals(0, metrics.getMessagesFailed());
+        assertEquals(0, metrics.getPendingFlushes());
+        assertEquals(4, metrics.getFlushLatency().getCount());
+
+        serverConnections[0].getClosedFuture().get(1, TimeUnit.SECONDS);
+        clientSocket.close();
+        listener.close();
+        listener.getShutdownCompleteFuture().get(1, TimeUnit.SECONDS);
+        bootstrap.close();
+        elGroup.close();
+        elGroup.getShutdownCompleteFuture().get(1, TimeUnit.SECONDS);
+
+        socketOptions.close();
+    }
 }
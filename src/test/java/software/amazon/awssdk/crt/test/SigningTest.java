@@ -435,6 +435,119 @@ public class SigningTest extends CrtTestFixture {
         CrtResource.waitForNoResources();
     }
 
+    @Test
+    public void testFrozenSigningConfigWithHeaderLists() throws Exception {
+        Credentials credentials = new Credentials(TEST_ACCESS_KEY_ID, TEST_SECRET_ACCESS_KEY, null);
+
+        try (AwsSigningConfig config = new AwsSigningConfig()) {
+            config.setAlgorithm(AwsSigningConfig.AwsSigningAlgorithm.SIGV4);
+            config.setSignatureType(AwsSigningConfig.AwsSignatureType.HTTP_REQUEST_VIA_HEADERS);
+            config.setRegion("us-east-1");
+            config.setService("service");
+            config.setCredentials(credentials);
+            // host isn't listed, but is always signed
+            config.setSignedHeaderAllowList(Arrays.asList("SIGNMEPLEASE", "DoNotSignThis"));
+            config.setSignedHeaderDenyList(Arrays.asList("donotsignthis"));
+            config.setSignedBodyValue(AwsSigningConfig.AwsSignedBodyValue.EMPTY_SHA256);
+            config.freeze();
+            assertTrue(config.isFrozen());
+
+            for (int i = 0; i < 2; ++i) {
+                config.setTime(DATE_FORMAT.parse("2015-08-30T12:36:0" + i + "Z").getTime());
+
+                HttpRequest request = createSimpleRequest("https://www.example.com", "POST", "/derp", "<body>Hello</body>");
+                request.addHeader("SignMePlease", "yes oh yes");
+                request.addHeader("DoNotSignThis", "no oh no");
+
+                HttpRequest signedRequest = AwsSigner.signRequest(request, config).get();
+                assertTrue(hasHeaderWithValue(signedRequest, "X-Amz-Date", "20150830T12360" + i + "Z"));
+                assertTrue(isHeaderSignedByAuthHeader(signedRequest, "Host"));
+                assertTrue(isHeaderSignedByAuthHeader(signedRequest, "SignMePlease"));
+                assertTrue(!isHeaderSignedByAuthHeader(signedRequest, "DoNotSignThis"));
+                assertTrue(!isHeaderSignedByAuthHeader(signedRequest, "Content-Length"));
+            }
+
+            boolean threw = false;
+            try {
+                config.setRegion("us-west-2");
+            } catch (IllegalStateException e) {
+                threw = true;
+            }
+            assertTrue(threw);
+
+            try (AwsSigningConfig clone = config.clone()) {
+                assertTrue(!clone.isFrozen());
+                clone.setRegion("us-west-2");
+                assertEquals(Arrays.asList("donotsignthis"), clone.getSignedHeaderDenyList());
+            }
+        }
+
+        CrtResource.waitForNoResources();
+    }
+
+    @Test
+    public void testSignRequestsMatchesSignRequest() throws Exception {
+        Credentials credentials = new Credentials(TEST_ACCESS_KEY_ID, TEST_SECRET_ACCESS_KEY, null);
+
+        try (AwsSigningConfig config = new AwsSigningConfig()) {
+            config.setAlgorithm(AwsSigningConfig.AwsSigningAlgorithm.SIGV4);
+            config.setSignatureType(AwsSigningConfig.AwsSignatureType.HTTP_REQUEST_VIA_HEADERS);
+            config.setRegion("us-east-1");
+            config.setService("service");
+            config.setTime(DATE_FORMAT.parse("2015-08-30T12:36:00Z").getTime());
+            config.setCredentials(credentials);
+            config.setUseDoubleUriEncode(true);
+            config.setShouldNormalizeUriPath(true);
+            config.setSignedBodyValue(AwsSigningConfig.AwsSignedBodyValue.EMPTY_SHA256);
+
+            List<HttpRequest> requests = new ArrayList<>();
+            for (int i = 0; i < 8; ++i) {
+                requests.add(createSimpleRequest("https://www.example.com", "POST", "/path" + i, "<body>" + i + "</body>"));
+            }
+
+            List<HttpRequest> signedRequests = AwsSigner.signRequests(requests, config).get();
+            assertEquals(requests.size(), signedRequests.size());
+
+            for (int i = 0; i < requests.size(); ++i) {
+                HttpRequest expected = AwsSigner.signRequest(requests.get(i), config).get();
+                assertEquals("/path" + i, signedRequests.get(i).getEncodedPath());
+                assertTrue(hasHeaderWithValue(signedRequests.get(i), "Authorization", findHeader(expected, "Authorization").getValue()));
+            }
+
+            assertTrue(AwsSigner.signRequests(new ArrayList<>(), config).get().isEmpty());
+        }
+
+        CrtResource.waitForNoResources();
+    }
+
+    @Test
+    public void testSignRequestsSigv4aSharedCredentials() throws Exception {
+        try (StaticCredentialsProvider provider = new StaticCredentialsProvider.StaticCredentialsProviderBuilder()
+            .withAccessKeyId(TEST_ACCESS_KEY_ID)
+            .withSecretAccessKey(TEST_SECRET_ACCESS_KEY)
+            .build();
+             AwsSigningConfig config = new AwsSigningConfig()) {
+            config.setAlgorithm(AwsSigningConfig.AwsSigningAlgorithm.SIGV4_ASYMMETRIC);
+            config.setSignatureType(AwsSigningConfig.AwsSignatureType.HTTP_REQUEST_VIA_HEADERS);
+            config.setRegion("us-east-1");
+            config.setService("service");
+            config.setTime(DATE_FORMAT.parse("2015-08-30T12:36:00Z").getTime());
+            config.setCredentialsProvider(provider);
+            config.setSignedBodyValue(AwsSigningConfig.AwsSignedBodyValue.EMPTY_SHA256);
+
+            List<HttpRequest> requests = Arrays.asList(createSigv4TestSuiteRequest(), createSigv4TestSuiteRequest());
+            List<AwsSigningResult> results = AwsSigner.signAll(requests, config).get();
+            assertEquals(2, results.size());
+
+            for (AwsSigningResult result : results) {
+                assertNotNull(result.getSignature());
+                assertTrue(hasHeaderWithValuePrefix(result.getSignedRequest(), "Authorization", "AWS4-ECDSA-P256-SHA256 Credential=AKIDEXAMPLE/20150830/service/aws4_request, SignedHeaders=host;x-amz-date;x-amz-region-set, Signature="));
+            }
+        }
+
+        CrtResource.waitForNoResources();
+    }
+
     @Test(expected = CrtRuntimeException.class)
     public void testSigningFailureBadRequest() throws Exception {
         try (StaticCredentialsProvider provider = new StaticCredentialsProvider.StaticCredentialsProviderBuilder()
@@ -7,8 +7,12 @@ import static org.junit.Assert.assertTrue;
 import org.junit.Test;
 import org.junit.function.ThrowingRunnable;
 
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
 import java.util.ArrayList;
+import java.util.Base64;
 import java.util.List;
+import java.util.Random;
 
 import software.amazon.awssdk.crt.utils.StringUtils;
 
@@ -124,4 +128,67 @@ public class StringUtilsTest extends CrtTestFixture {
         data = new String(StringUtils.base64Decode(data.getBytes()));
         assertEquals("foobar", data);
     }
+
+    @Test
+    public void testBase64DirectRoundTrip() {
+        Random random = new Random(42);
+        // every tail length, with no room to spare in the output
+        for (int length = 0; length < 64; length++) {
+            byte[] data = new byte[length];
+            random.nextBytes(data);
+
+            ByteBuffer input = ByteBuffer.allocateDirect(length);
+            input.put(data).flip();
+            ByteBuffer encoded = ByteBuffer.allocateDirect(StringUtils.base64EncodedLength(length));
+            assertEquals(encoded.capacity(), StringUtils.base64Encode(input, encoded));
+            assertEquals(0, input.remaining());
+            assertEquals(0, encoded.remaining());
+
+            encoded.flip();
+            byte[] encodedBytes = new byte[encoded.remaining()];
+            encoded.duplicate().get(encodedBytes);
+            assertEquals(Base64.getEncoder().encodeToString(data), new String(encodedBytes, StandardCharsets.US_ASCII));
+
+            ByteBuffer decoded = ByteBuffer.allocateDirect(StringUtils.base64DecodedLength(encoded));
+            assertEquals(length, StringUtils.base64Decode(encoded, decoded));
+            decoded.flip();
+            assertEquals(input.flip(), decoded);
+        }
+    }
+
+    @Test
+    public void testBase64DirectAtPositions() {
+        ByteBuffer input = ByteBuffer.allocateDirect(16);
+        input.position(5);
+        input.put("foobar".getBytes(StandardCharsets.US_ASCII));
+        input.limit(11).position(5);
+
+        ByteBuffer output = ByteBuffer.allocateDirect(32);
+        output.position(3);
+        assertEquals(8, StringUtils.base64Encode(input, output));
+        assertEquals(11, output.position());
+
+        byte[] encoded = new byte[8];
+        output.position(3);
+        output.get(encoded);
+        assertEquals("Zm9vYmFy", new String(encoded, StandardCharsets.US_ASCII));
+    }
+
+    @Test
+    public void testBase64DirectOutputTooSmall() {
+        ByteBuffer input = ByteBuffer.allocateDirect(6);
+        input.put("foobar".getBytes(StandardCharsets.US_ASCII)).flip();
+        ByteBuffer output = ByteBuffer.allocateDirect(7);
+
+        assertThrows(IllegalArgumentException.class, () -> StringUtils.base64Encode(input, output));
+        assertEquals(0, output.position());
+    }
+
+    @Test
+    public void testBase64DirectRequiresDirectBuffers() {
+        ByteBuffer input = ByteBuffer.wrap("foobar".getBytes(StandardCharsets.US_ASCII));
+        ByteBuffer output = ByteBuffer.allocateDirect(8);
+
+        assertThrows(IllegalArgumentException.class, () -> StringUtils.base64Encode(input, output));
+    }
 }
@@ -18,6 +18,7 @@ import software.amazon.awssdk.crt.io.TlsCipherPreference;
 import software.amazon.awssdk.crt.io.TlsContextOptions;
 import software.amazon.awssdk.crt.io.TlsContextPkcs11Options;
 import software.amazon.awssdk.crt.io.TlsContext;
+import software.amazon.awssdk.crt.io.TlsHandshakeMetrics;
 import software.amazon.awssdk.crt.utils.PemUtils;
 
 public class TlsContextOptionsTest extends CrtTestFixture {
@@ -248,4 +249,20 @@ public class TlsContextOptionsTest extends CrtTestFixture {
             fail(ex.toString());
         }
     }
+
+    @Test
+    public void testHandshakeMetricsStartAtZero() {
+        skipIfNetworkUnavailable();
+        try (TlsContextOptions options = TlsContextOptions.createDefaultClient();
+                TlsContext tls = new TlsContext(options)) {
+            TlsHandshakeMetrics first = tls.getHandshakeMetrics();
+            assertEquals(0, first.getHandshakesSucceeded());
+            assertEquals(0, first.getHandshakesFailed());
+            assertEquals(0, first.getHandshakeLatency().getCount());
+
+            TlsHandshakeMetrics second = tls.getHandshakeMetrics();
+            assertTrue(second.getTimestampNanos() >= first.getTimestampNanos());
+            assertEquals(0.0, second.getHandshakesSucceededPerSecondSince(first), 0.0);
+        }
+    }
 }